@@ -57,6 +57,12 @@
 // found in AliCFUnfolding::CalculateCorrelatedErrors()                //
 // Author: marta.verweij@cern.ch                                       //
 //                                                                     //
+// With ::UseSparseEngine the response is converted once into a        //
+// compressed sparse row matrix and the iterations are done on flat    //
+// arrays, the random iterations being shared among several threads.   //
+// The results are copied back to the THnSparse at the end, see        //
+// AliCFUnfolding::UnfoldSparse()                                      //
+//                                                                     //
 // An optional possibility is to smooth the unfolded spectrum at the   //
 // end of each iteration, either using a fit function                  //
 // (only if #dimensions <=3)                                           //
@@ -92,6 +98,9 @@
 #include "TH2D.h"
 #include "TH3D.h"
 #include "TRandom3.h"
+#include <thread>
+#include <unordered_map>
+#include <vector>
 
 
 ClassImp(AliCFUnfolding)
@@ -130,7 +139,9 @@ AliCFUnfolding::AliCFUnfolding() :
   fDeltaUnfoldedP(0x0),
   fDeltaUnfoldedN(0x0),
   fNCalcCorrErrors(0),
-  fRandomSeed(0)
+  fRandomSeed(0),
+  fUseSparseEngine(kFALSE),
+  fNThreads(0)
 {
   //
   // default constructor
@@ -174,7 +185,9 @@ AliCFUnfolding::AliCFUnfolding(const Char_t* name, const Char_t* title, const In
   fDeltaUnfoldedP(0x0),
   fDeltaUnfoldedN(0x0),
   fNCalcCorrErrors(0),
-  fRandomSeed(randomSeed)
+  fRandomSeed(randomSeed),
+  fUseSparseEngine(kFALSE),
+  fNThreads(0)
 {
   //
   // named constructor
@@ -350,6 +363,14 @@ void AliCFUnfolding::Unfold() {
   // several iterations are performed until a reasonable chi2 or convergence criterion is reached
   //
 
+  if (fUseSparseEngine && fNCalcCorrErrors == 0) {
+    if (!fUseSmoothing) {
+      UnfoldSparse();
+      return;
+    }
+    AliWarning("Sparse engine cannot be used together with smoothing, using the THnSparse iterations");
+  }
+
   Int_t iIterBayes     = 0 ;
   Double_t convergence = 0.;
 
@@ -862,3 +883,302 @@ void AliCFUnfolding::CreateFlatPrior() {
   delete [] bin;
   delete [] bins;
 }
+
+//______________________________________________________________
+
+namespace {
+
+  struct AliCFUnfoldingCSR {
+    //
+    // conditional matrix P(M|T) in compressed sparse row format : one row per measured bin
+    //
+    Int_t                 fNM;        // number of measured bins
+    Int_t                 fNT;        // number of true bins
+    std::vector<Int_t>    fRowStart;  // first entry of each row, fNM+1 values
+    std::vector<Int_t>    fColumn;    // true bin of each entry
+    std::vector<Double_t> fCond;      // conditional probability of each entry
+  };
+
+  void BayesIteration(const AliCFUnfoldingCSR& r,
+		      const std::vector<Double_t>& prior, const std::vector<Double_t>& eff, const std::vector<Double_t>& meas,
+		      std::vector<Double_t>& pte, std::vector<Double_t>& inv, std::vector<Double_t>& est, std::vector<Double_t>& unf) {
+    //
+    // one bayes iteration, same rules as CreateEstMeasured(), CreateInvResponse() and CreateUnfolded()
+    //
+    for (Int_t t=0; t<r.fNT; t++) {
+      pte[t] = prior[t]*eff[t];
+      unf[t] = 0.;
+    }
+    for (Int_t m=0; m<r.fNM; m++) {
+      Double_t sum = 0.;
+      for (Int_t e=r.fRowStart[m]; e<r.fRowStart[m+1]; e++) {
+	Double_t fill = r.fCond[e]*pte[r.fColumn[e]];
+	if (fill>0.) sum += fill;
+      }
+      est[m] = sum;
+      for (Int_t e=r.fRowStart[m]; e<r.fRowStart[m+1]; e++) {
+	Int_t t = r.fColumn[e];
+	Double_t fill = (sum>0. ? r.fCond[e]*pte[t]/sum : 0.);
+	if (fill>0. || inv[e]>0.) inv[e] = fill;
+	fill = (eff[t]>0. ? inv[e]*meas[m]/eff[t] : 0.);
+	if (fill>0.) unf[t] += fill;
+      }
+    }
+  }
+
+  Long64_t BinKey(const THnSparse* h, Int_t firstAxis, Int_t nVar, const Int_t* coord) {
+    //
+    // linear index of a bin, including under- and overflow
+    //
+    Long64_t key = 0;
+    for (Int_t i=0; i<nVar; i++) key = key*(h->GetAxis(firstAxis+i)->GetNbins()+2) + coord[i];
+    return key;
+  }
+
+  Int_t BinIndex(std::unordered_map<Long64_t,Int_t>& map, Long64_t key, std::vector<Int_t>& coords, const Int_t* coord, Int_t nVar) {
+    //
+    // dense index of a bin, created if not yet known
+    //
+    std::unordered_map<Long64_t,Int_t>::const_iterator it = map.find(key);
+    if (it != map.end()) return it->second;
+    Int_t index = map.size();
+    map[key] = index;
+    coords.insert(coords.end(),coord,coord+nVar);
+    return index;
+  }
+}
+
+//______________________________________________________________
+
+void AliCFUnfolding::UnfoldSparse() {
+  //
+  // Same unfolding and correlated error calculation as Unfold() and CalculateCorrelatedErrors(),
+  // on flat arrays instead of THnSparse :
+  //  - the conditional matrix is converted once into a compressed sparse row matrix,
+  //    measured and true bins being mapped to dense indices
+  //  - prior, efficiency, measured spectrum, inverse response and unfolded spectrum are flat arrays
+  //  - the fNRandomIterations random unfoldings are shared among fNThreads threads,
+  //    each random unfolding having its own TRandom3 seeded from fRandom3
+  //  - fUnfolded, fUnfoldedFinal, fPrior, fMeasuredEstimate, fInverseResponse
+  //    and the delta profiles are filled at the end
+  //
+  // As in the THnSparse iterations, the randomized response is not used (the conditional matrix is not recalculated).
+  // Each random unfolding starts from the inverse response of the final iteration.
+  //
+
+  const Int_t nVar = fNVariables;
+
+  // map the bins of the conditional matrix to (measured,true) dense indices
+  std::unordered_map<Long64_t,Int_t> mapM, mapT;
+  std::vector<Int_t> coordM, coordT;
+  std::vector<Int_t> entryM, entryT;
+  std::vector<Double_t> entryCond, entryInv;
+  const Long64_t nEntries = fConditional->GetNbins();
+  entryM.reserve(nEntries); entryT.reserve(nEntries); entryCond.reserve(nEntries); entryInv.reserve(nEntries);
+
+  for (Long64_t iBin=0; iBin<nEntries; iBin++) {
+    Double_t conditionalValue = fConditional->GetBinContent(iBin,fCoordinates2N);
+    GetCoordinates();
+    entryM.push_back(BinIndex(mapM,BinKey(fConditional,0,nVar,fCoordinatesN_M),coordM,fCoordinatesN_M,nVar));
+    entryT.push_back(BinIndex(mapT,BinKey(fConditional,nVar,nVar,fCoordinatesN_T),coordT,fCoordinatesN_T,nVar));
+    entryCond.push_back(conditionalValue);
+    entryInv.push_back(fInverseResponse->GetBinContent(fCoordinates2N));
+  }
+
+  // the prior bins enter the convergence criterion
+  std::vector<Int_t> priorBinT;
+  for (Long64_t iBin=0; iBin<fPrior->GetNbins(); iBin++) {
+    fPrior->GetBinContent(iBin,fCoordinatesN_T);
+    priorBinT.push_back(BinIndex(mapT,BinKey(fConditional,nVar,nVar,fCoordinatesN_T),coordT,fCoordinatesN_T,nVar));
+  }
+
+  AliCFUnfoldingCSR r;
+  r.fNM = mapM.size();
+  r.fNT = mapT.size();
+
+  // sort the entries by measured bin
+  r.fRowStart.assign(r.fNM+1,0);
+  for (Long64_t e=0; e<nEntries; e++) r.fRowStart[entryM[e]+1]++;
+  for (Int_t m=0; m<r.fNM; m++) r.fRowStart[m+1] += r.fRowStart[m];
+  r.fColumn.resize(nEntries);
+  r.fCond  .resize(nEntries);
+  std::vector<Double_t> inv(nEntries);
+  std::vector<Long64_t> entryBin(nEntries);
+  std::vector<Int_t> next(r.fRowStart.begin(),r.fRowStart.end()-1);
+  for (Long64_t e=0; e<nEntries; e++) {
+    Int_t pos = next[entryM[e]]++;
+    r.fColumn[pos] = entryT[e];
+    r.fCond  [pos] = entryCond[e];
+    inv      [pos] = entryInv[e];
+    entryBin [pos] = e;
+  }
+
+  // flat spectra
+  std::vector<Double_t> prior(r.fNT,0.), eff(r.fNT,0.), meas(r.fNM,0.);
+  std::vector<Bool_t>   priorFilled(r.fNT,kFALSE);
+  for (Int_t t=0; t<r.fNT; t++) {
+    eff  [t] = fEfficiency->GetBinContent(&coordT[t*nVar]);
+    prior[t] = fPrior     ->GetBinContent(&coordT[t*nVar]);
+  }
+  for (UInt_t i=0; i<priorBinT.size(); i++) priorFilled[priorBinT[i]] = kTRUE;
+  for (Int_t m=0; m<r.fNM; m++) meas[m] = fMeasured->GetBinContent(&coordM[m*nVar]);
+
+  // bins and errors of efficiency and measured spectra, used as mean and sigma in the random iterations
+  std::vector<Int_t> effBinT, measBinM;
+  std::vector<Double_t> effVal, effErr, measVal, measErr;
+  for (Long64_t iBin=0; iBin<fEfficiencyOrig->GetNbins(); iBin++) {
+    Double_t val = fEfficiencyOrig->GetBinContent(iBin,fCoordinatesN_T);
+    std::unordered_map<Long64_t,Int_t>::const_iterator it = mapT.find(BinKey(fConditional,nVar,nVar,fCoordinatesN_T));
+    effBinT.push_back(it != mapT.end() ? it->second : -1);
+    effVal .push_back(val);
+    effErr .push_back(fEfficiencyOrig->GetBinError(iBin));
+  }
+  for (Long64_t iBin=0; iBin<fMeasuredOrig->GetNbins(); iBin++) {
+    Double_t val = fMeasuredOrig->GetBinContent(iBin,fCoordinatesN_M);
+    std::unordered_map<Long64_t,Int_t>::const_iterator it = mapM.find(BinKey(fConditional,0,nVar,fCoordinatesN_M));
+    measBinM.push_back(it != mapM.end() ? it->second : -1);
+    measVal .push_back(val);
+    measErr .push_back(fMeasuredOrig->GetBinError(iBin));
+  }
+  const std::vector<Double_t> priorOrig(prior);
+  const std::vector<Bool_t>   priorFilledOrig(priorFilled);
+
+  AliInfo(Form("Sparse engine : %d measured bins, %d true bins, %lld response entries",r.fNM,r.fNT,nEntries));
+
+  // bayes iterations
+  std::vector<Double_t> pte(r.fNT), est(r.fNM), unf(r.fNT);
+  Int_t iIterBayes     = 0 ;
+  Double_t convergence = 0.;
+  for (iIterBayes=0; iIterBayes<fMaxNumIterations; iIterBayes++) {
+
+    BayesIteration(r,prior,eff,meas,pte,inv,est,unf);
+
+    convergence = 0.;
+    Int_t nNotPositive = 0;
+    for (Int_t t=0; t<r.fNT; t++) {
+      if (!priorFilled[t]) continue;
+      if (prior[t] > 0.) convergence += ((prior[t]-unf[t])/prior[t])*((prior[t]-unf[t])/prior[t]);
+      else nNotPositive++;
+    }
+    if (nNotPositive) AliWarning(Form("%d bins with priorValue <= 0. Adding 0 to convergence criterion.",nNotPositive));
+    AliDebug(0,Form("convergence at iteration %d is %e",iIterBayes,convergence));
+
+    if (fMaxConvergence>0. && convergence<fMaxConvergence) {
+      fNRandomIterations = iIterBayes;
+      AliDebug(0,Form("convergence is met at iteration %d",iIterBayes));
+      break;
+    }
+
+    // update the prior distribution
+    for (Int_t t=0; t<r.fNT; t++) {
+      prior[t]       = unf[t];
+      priorFilled[t] = (unf[t]>0.);
+    }
+  }
+
+  AliInfo("\n================================================\nFinished bayes iteration, now calculating errors...\n================================================\n");
+  fNCalcCorrErrors = 1;
+
+  // random iterations : each thread accumulates delta and delta^2 for its share of the random unfoldings
+  const Int_t nRandom = TMath::Max(fNRandomIterations,0);
+  std::vector<UInt_t> seeds(nRandom);
+  for (Int_t i=0; i<nRandom; i++) seeds[i] = fRandom3->Integer(kMaxUInt-1)+1;
+
+  Int_t nThreads = (fNThreads>0 ? fNThreads : (Int_t)std::thread::hardware_concurrency());
+  nThreads = TMath::Max(1,TMath::Min(nThreads,nRandom));
+
+  std::vector< std::vector<Double_t> > sumDelta (nThreads,std::vector<Double_t>(r.fNT,0.));
+  std::vector< std::vector<Double_t> > sumDelta2(nThreads,std::vector<Double_t>(r.fNT,0.));
+  const std::vector<Double_t> invFinal(inv);
+  const Int_t maxNumIterations = fMaxNumIterations;
+
+  auto randomUnfoldings = [&](Int_t iThread) {
+    std::vector<Double_t> rPrior(r.fNT), rEff(r.fNT), rMeas(r.fNM), rInv(nEntries);
+    std::vector<Double_t> rPte(r.fNT), rEst(r.fNM), rUnf(r.fNT);
+    std::vector<Double_t>& sum  = sumDelta [iThread];
+    std::vector<Double_t>& sum2 = sumDelta2[iThread];
+    for (Int_t i=iThread; i<nRandom; i+=nThreads) {
+      TRandom3 random(seeds[i]);
+      rEff .assign(eff.size(),0.);
+      rMeas.assign(meas.size(),0.);
+      for (UInt_t k=0; k<effBinT.size(); k++) {
+	Double_t ran = random.Gaus(effVal[k],effErr[k]);
+	if (effBinT[k]>=0) rEff[effBinT[k]] = ran;
+      }
+      for (UInt_t k=0; k<measBinM.size(); k++) {
+	Double_t ran = random.Gaus(measVal[k],measErr[k]);
+	if (measBinM[k]>=0) rMeas[measBinM[k]] = ran;
+      }
+      rPrior = priorOrig;
+      rInv   = invFinal;
+      for (Int_t iIter=0; iIter<maxNumIterations; iIter++) {
+	BayesIteration(r,rPrior,rEff,rMeas,rPte,rInv,rEst,rUnf);
+	rPrior = rUnf;
+      }
+      for (Int_t t=0; t<r.fNT; t++) {
+	if (!(unf[t]>0.)) continue;
+	Double_t delta = unf[t] - rUnf[t];
+	sum [t] += delta;
+	sum2[t] += delta*delta;
+      }
+    }
+  };
+
+  if (nThreads == 1) randomUnfoldings(0);
+  else {
+    std::vector<std::thread> threads;
+    for (Int_t iThread=0; iThread<nThreads; iThread++) threads.push_back(std::thread(randomUnfoldings,iThread));
+    for (Int_t iThread=0; iThread<nThreads; iThread++) threads[iThread].join();
+  }
+
+  // copy the results back to the THnSparse
+  fUnfolded        ->Reset();
+  fMeasuredEstimate->Reset();
+  fPrior           ->Reset();
+  for (Int_t t=0; t<r.fNT; t++) {
+    const Int_t* coord = &coordT[t*nVar];
+    if (unf[t]>0.) {
+      fUnfolded->SetBinContent(coord,unf[t]);
+      fUnfolded->SetBinError  (coord,0.);
+    }
+    if (priorFilled[t]) {
+      fPrior->SetBinContent(coord,prior[t]);
+      fPrior->SetBinError  (coord,0.);
+    }
+  }
+  for (Int_t m=0; m<r.fNM; m++) {
+    if (!(est[m]>0.)) continue;
+    fMeasuredEstimate->SetBinContent(&coordM[m*nVar],est[m]);
+    fMeasuredEstimate->SetBinError  (&coordM[m*nVar],0.);
+  }
+  for (Long64_t e=0; e<nEntries; e++) {
+    fConditional->GetBinContent(entryBin[e],fCoordinates2N);
+    fInverseResponse->SetBinContent(fCoordinates2N,inv[e]);
+    fInverseResponse->SetBinError  (fCoordinates2N,0.);
+  }
+
+  if (fUnfoldedFinal) delete fUnfoldedFinal;
+  fUnfoldedFinal = (THnSparse*) fUnfolded->Clone();
+
+  // statistical errors for final unfolded spectrum, as in CalculateCorrelatedErrors()
+  Double_t entriesInBin = nRandom;
+  for (Int_t t=0; t<r.fNT; t++) {
+    if (!(unf[t]>0.) || nRandom == 0) continue;
+    Double_t mean = 0., meanx2 = 0.;
+    for (Int_t iThread=0; iThread<nThreads; iThread++) {
+      mean   += sumDelta [iThread][t];
+      meanx2 += sumDelta2[iThread][t];
+    }
+    mean   /= entriesInBin;
+    meanx2 /= entriesInBin;
+    const Int_t* coord = &coordT[t*nVar];
+    Double_t sigma = (entriesInBin > 1. ? TMath::Sqrt((entriesInBin/(entriesInBin-1.))*TMath::Abs(meanx2-mean*mean)) : 0.);
+    fUnfoldedFinal ->SetBinError  (coord,sigma);
+    fDeltaUnfoldedP->SetBinContent(coord,mean);
+    fDeltaUnfoldedP->SetBinError  (coord,meanx2);
+    fDeltaUnfoldedN->SetBinContent(coord,entriesInBin);
+  }
+
+  fNCalcCorrErrors = 2;
+  AliInfo(Form("\n\n=======================\nFinished at iteration %d : convergence is %e and you required it to be < %e\n=======================\n\n",iIterBayes,convergence,fMaxConvergence));
+}
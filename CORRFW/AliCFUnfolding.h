@@ -37,6 +37,11 @@ class AliCFUnfolding : public TNamed {
 
   void SetNRandomIterations(Int_t n = 100) {fNRandomIterations = n;};
 
+  void UseSparseEngine(Bool_t b = kTRUE, Int_t nThreads = 0) { // iterations done on a compressed sparse row copy of the response
+    fUseSparseEngine=b;                                         // and error toys run in nThreads threads (0 : number of cores)
+    fNThreads=nThreads;                                         // not used together with smoothing
+  }
+
   void UseSmoothing(TF1* fcn=0x0, Option_t* opt="iremn") { // if fcn=0x0 then smooth using neighbouring bins 
     fUseSmoothing=kTRUE;                                   // this function must NOT be used if fNVariables > 3
     fSmoothFunction=fcn;                                   // the option "opt" is used if "fcn" is specified
@@ -111,6 +116,8 @@ class AliCFUnfolding : public TNamed {
   THnSparse     *fDeltaUnfoldedN;    // Entries of the delta-unfolded distribution (count for each bin)
   Short_t        fNCalcCorrErrors;   // Book-keeping to prevend infinite loop
   UInt_t         fRandomSeed;        // Random seed
+  Bool_t         fUseSparseEngine;   // Unfold with the compressed sparse row engine, see UnfoldSparse()
+  Int_t          fNThreads;          // Number of threads for the error toys of the sparse engine (0 = number of cores)
 
 
   // functions
@@ -131,8 +138,9 @@ class AliCFUnfolding : public TNamed {
   void     CreateRandomizedDist();      // Create randomized dist from measured distribution
   void     FillDeltaUnfoldedProfile();  // Fills the fDeltaUnfoldedP profile
   void     SetMaxConvergencePerDOF (Double_t val);
+  void     UnfoldSparse();              // Unfolding and error calculation with the compressed sparse row engine
 
-  ClassDef(AliCFUnfolding,1);
+  ClassDef(AliCFUnfolding,2);
 };
 
 #endif
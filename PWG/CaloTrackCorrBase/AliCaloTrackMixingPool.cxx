@@ -0,0 +1,329 @@
+/**************************************************************************
+ * Copyright(c) 1998-1999, ALICE Experiment at CERN, All rights reserved. *
+ *                                                                        *
+ * Author: The ALICE Off-line Project.                                    *
+ * Contributors are mentioned in the code where appropriate.              *
+ *                                                                        *
+ * Permission to use, copy, modify and distribute this software and its   *
+ * documentation strictly for non-commercial purposes is hereby granted   *
+ * without fee, provided that the above copyright notice appears in all   *
+ * copies and that both the copyright notice and this permission notice   *
+ * appear in the supporting documentation. The authors make no claims     *
+ * about the suitability of this software for any purpose. It is          *
+ * provided "as is" without express or implied warranty.                  *
+ **************************************************************************/
+
+// --- ROOT system ---
+#include <TMath.h>
+#include <cstring>
+
+// --- AliRoot system ---
+#include "AliLog.h"
+
+#include "AliCaloTrackParticle.h"
+#include "AliCaloTrackMixingPool.h"
+
+/// \cond CLASSIMP
+ClassImp(AliCaloTrackMixingPool) ;
+/// \endcond
+
+namespace
+{
+  /// Number of PID selections in AliCaloTrackParticle::IsPIDOK().
+  const Int_t kNPIDSelections = 9;
+
+  //____________________________________________________________
+  /// Change the slot size of a ring buffer array from oldCap to newCap,
+  /// keeping the first n[s] entries of each slot s.
+  //____________________________________________________________
+  template <class T> void Restride(T & a, Int_t depth, Int_t oldCap, Int_t newCap, const Int_t * n)
+  {
+    a.Set(depth*newCap);
+
+    // Slots move to higher positions, start from the last one
+    for(Int_t s = depth-1; s > 0; s--)
+    {
+      if ( n[s] > 0 )
+        memmove(a.GetArray()+s*newCap, a.GetArray()+s*oldCap, n[s]*sizeof(a.GetArray()[0]));
+    }
+  }
+}
+
+//____________________________________
+/// Default constructor.
+//____________________________________
+AliCaloTrackMixingPool::AliCaloTrackMixingPool() :
+TObject(),
+fDepth(1),    fCapacity(0),    fNEvents(0),    fHead(0),
+fNParticles(1),
+fE(0),        fPt(0),          fEta(0),        fPhi(0),        fTime(0),
+fNCells(0),   fPIDBits(0),     fModule(0),     fCellAbsIdMax(0),
+fDistToBad(0),fDetector(0),    fFlags(0)
+{
+}
+
+//____________________________________
+/// Constructor.
+/// \param depth: number of events kept.
+/// \param capacity: initial number of particles per event, it grows if needed.
+//____________________________________
+AliCaloTrackMixingPool::AliCaloTrackMixingPool(Int_t depth, Int_t capacity) :
+TObject(),
+fDepth(1),    fCapacity(0),    fNEvents(0),    fHead(0),
+fNParticles(1),
+fE(0),        fPt(0),          fEta(0),        fPhi(0),        fTime(0),
+fNCells(0),   fPIDBits(0),     fModule(0),     fCellAbsIdMax(0),
+fDistToBad(0),fDetector(0),    fFlags(0)
+{
+  SetDepth(depth);
+
+  if ( capacity > 0 ) Resize(capacity);
+}
+
+//____________________________________________________________
+/// Set the number of events kept. The stored events are removed.
+//____________________________________________________________
+void AliCaloTrackMixingPool::SetDepth(Int_t depth)
+{
+  fDepth = depth < 1 ? 1 : depth;
+
+  fNParticles.Set(fDepth);
+
+  Int_t capacity = fCapacity;
+  fCapacity = 0;
+  Clear();
+  if ( capacity > 0 ) Resize(capacity);
+}
+
+//____________________________________________________________
+/// Remove all events, keep the allocated memory.
+//____________________________________________________________
+void AliCaloTrackMixingPool::Clear(Option_t *)
+{
+  fNEvents = 0;
+  fHead    = 0;
+  fNParticles.Reset();
+}
+
+//____________________________________________________________
+/// Open a new event in the ring buffer. If the buffer is full,
+/// the slot of the oldest event is reused.
+//____________________________________________________________
+void AliCaloTrackMixingPool::StartEvent()
+{
+  fHead = (fHead + 1) % fDepth;
+  fNParticles[fHead] = 0;
+
+  if ( fNEvents < fDepth ) fNEvents++;
+}
+
+//____________________________________________________________
+/// Add a particle to the most recent event, opened with StartEvent().
+/// The other quantities are set to default values, change them
+/// with the setters.
+/// \param e: energy.
+/// \param pt: transverse momentum.
+/// \param eta: pseudorapidity.
+/// \param phi: azimuthal angle, any range.
+/// \return position of the particle in the event.
+//____________________________________________________________
+Int_t AliCaloTrackMixingPool::AddParticle(Float_t e, Float_t pt, Float_t eta, Float_t phi)
+{
+  if ( fNEvents == 0 )
+  {
+    AliWarning("No event open, call StartEvent() first");
+    return -1;
+  }
+
+  Int_t n = fNParticles[fHead];
+
+  if ( n >= fCapacity ) Resize(fCapacity < 8 ? 16 : 2*fCapacity);
+
+  while ( phi <  0              ) phi += TMath::TwoPi();
+  while ( phi >= TMath::TwoPi() ) phi -= TMath::TwoPi();
+
+  Int_t i = fHead*fCapacity + n;
+
+  fE           [i] = e;
+  fPt          [i] = pt;
+  fEta         [i] = eta;
+  fPhi         [i] = phi;
+  fTime        [i] = 0;
+  fNCells      [i] = 0;
+  fPIDBits     [i] = 0;
+  fModule      [i] = -1;
+  fCellAbsIdMax[i] = -1;
+  fDistToBad   [i] = 0;
+  fDetector    [i] = -1;
+  fFlags       [i] = 0;
+
+  fNParticles[fHead] = n+1;
+
+  return n;
+}
+
+//____________________________________________________________
+/// Add a calorimeter cluster or track to the most recent event.
+/// \param p: particle, all the quantities are taken from it.
+/// \param module: super module number, from AliAnaCaloTrackCorrBaseClass::GetModuleNumber().
+/// \param pdgWanted: PID used in AliCaloTrackParticle::IsPIDOK() to set the PID bits.
+/// \return position of the particle in the event.
+//____________________________________________________________
+Int_t AliCaloTrackMixingPool::AddParticle(const AliCaloTrackParticle * p, Int_t module, Int_t pdgWanted)
+{
+  Int_t n = AddParticle(p->E(), p->Pt(), p->Eta(), p->Phi());
+  if ( n < 0 ) return n;
+
+  Int_t pid = 0;
+  for(Int_t ipid = 0; ipid < kNPIDSelections; ipid++)
+  {
+    if ( p->IsPIDOK(ipid, pdgWanted) ) pid |= (1 << ipid);
+  }
+
+  Int_t flags = 0;
+  if ( p->IsTagged()             ) flags |= kTagged;
+  if ( p->GetFiducialArea() != 0 ) flags |= kFidArea;
+
+  Int_t i = fHead*fCapacity + n;
+
+  fTime        [i] = p->GetTime();
+  fNCells      [i] = p->GetNCells();
+  fPIDBits     [i] = pid;
+  fModule      [i] = module;
+  fCellAbsIdMax[i] = p->GetCellAbsIdMax();
+  fDistToBad   [i] = p->DistToBad();
+  fDetector    [i] = p->GetDetectorTag();
+  fFlags       [i] = flags;
+
+  return n;
+}
+
+//____________________________________________________________
+/// Change the number of particles per event slot, keeping the stored events.
+//____________________________________________________________
+void AliCaloTrackMixingPool::Resize(Int_t capacity)
+{
+  if ( capacity <= fCapacity ) return;
+
+  const Int_t * n = fNParticles.GetArray();
+
+  Restride(fE           , fDepth, fCapacity, capacity, n);
+  Restride(fPt          , fDepth, fCapacity, capacity, n);
+  Restride(fEta         , fDepth, fCapacity, capacity, n);
+  Restride(fPhi         , fDepth, fCapacity, capacity, n);
+  Restride(fTime        , fDepth, fCapacity, capacity, n);
+  Restride(fNCells      , fDepth, fCapacity, capacity, n);
+  Restride(fPIDBits     , fDepth, fCapacity, capacity, n);
+  Restride(fModule      , fDepth, fCapacity, capacity, n);
+  Restride(fCellAbsIdMax, fDepth, fCapacity, capacity, n);
+  Restride(fDistToBad   , fDepth, fCapacity, capacity, n);
+  Restride(fDetector    , fDepth, fCapacity, capacity, n);
+  Restride(fFlags       , fDepth, fCapacity, capacity, n);
+
+  fCapacity = capacity;
+}
+
+//____________________________________________________________
+/// \return memory allocated by the pool, in bytes.
+//____________________________________________________________
+Long64_t AliCaloTrackMixingPool::GetMemoryUsage() const
+{
+  Long64_t size = sizeof(AliCaloTrackMixingPool);
+
+  size += fNParticles.GetSize() * sizeof(Int_t);
+
+  size += (Long64_t) fDepth * fCapacity * (5*sizeof(Float_t) + 7*sizeof(Int_t));
+
+  return size;
+}
+
+//____________________________________________________________
+/// \return memory used by the stored particles, in bytes.
+//____________________________________________________________
+Long64_t AliCaloTrackMixingPool::GetUsedMemory() const
+{
+  Long64_t nPart = 0;
+  for(Int_t ev = 0; ev < fNEvents; ev++) nPart += GetNParticles(ev);
+
+  return nPart * (5*sizeof(Float_t) + 7*sizeof(Int_t));
+}
+
+//____________________________________________________________
+/// Mass, pT and opening angle of a particle combined with all the
+/// particles of a stored event.
+/// \param ev: stored event, 0 is the most recent one.
+/// \param e1: energy of the particle.
+/// \param pt1: transverse momentum of the particle.
+/// \param eta1: pseudorapidity of the particle.
+/// \param phi1: azimuthal angle of the particle.
+/// \param mass: output pair invariant mass, resized if needed.
+/// \param pairPt: output pair transverse momentum, resized if needed.
+/// \param angle: output pair opening angle, resized if needed.
+/// \return number of particles in the stored event.
+//____________________________________________________________
+Int_t AliCaloTrackMixingPool::PairKinematics(Int_t ev, Float_t e1, Float_t pt1, Float_t eta1, Float_t phi1,
+                                             TArrayF & mass, TArrayF & pairPt, TArrayF & angle) const
+{
+  if ( ev < 0 || ev >= fNEvents ) return 0;
+
+  Int_t n = GetNParticles(ev);
+  if ( n == 0 ) return 0;
+
+  if ( mass  .GetSize() < n ) mass  .Set(fCapacity);
+  if ( pairPt.GetSize() < n ) pairPt.Set(fCapacity);
+  if ( angle .GetSize() < n ) angle .Set(fCapacity);
+
+  PairKinematics(n, e1, pt1, eta1, phi1,
+                 GetE(ev), GetPt(ev), GetEta(ev), GetPhi(ev),
+                 mass.GetArray(), pairPt.GetArray(), angle.GetArray());
+
+  return n;
+}
+
+//____________________________________________________________
+/// Mass, pT and opening angle of a particle combined with n particles,
+/// for massless particles:
+///
+///   m^2 = 2 pT1 pT2 (cosh(deta) - cos(dphi)) = 4 pT1 pT2 (sinh^2(deta/2) + sin^2(dphi/2))
+///
+///   sin(angle/2) = m / (2 sqrt(E1 E2))
+///
+/// The second form of the mass avoids the cancellation at small opening angles.
+/// No branches in the loop so that it can be vectorized.
+//____________________________________________________________
+void AliCaloTrackMixingPool::PairKinematics(Int_t n, Float_t e1, Float_t pt1, Float_t eta1, Float_t phi1,
+                                            const Float_t * e2, const Float_t * pt2,
+                                            const Float_t * eta2, const Float_t * phi2,
+                                            Float_t * mass, Float_t * pairPt, Float_t * angle)
+{
+  for(Int_t i = 0; i < n; i++)
+  {
+    Float_t shEta = TMath::SinH(0.5f*(eta1 - eta2[i]));
+    Float_t snPhi = TMath::Sin (0.5f*(phi1 - phi2[i]));
+    Float_t csPhi = 1.f - 2.f*snPhi*snPhi;
+
+    Float_t m2    = 4.f*pt1*pt2[i]*(shEta*shEta + snPhi*snPhi);
+    Float_t pt2p  = pt1*pt1 + pt2[i]*pt2[i] + 2.f*pt1*pt2[i]*csPhi;
+
+    Float_t ee    = 4.f*e1*e2[i];
+    Float_t sn    = ee > 0 ? TMath::Sqrt(m2/ee) : 0.f;
+
+    mass  [i] = TMath::Sqrt(m2);
+    pairPt[i] = TMath::Sqrt(pt2p > 0 ? pt2p : 0.f);
+    angle [i] = 2.f*TMath::ASin(sn < 1.f ? sn : 1.f);
+  }
+}
+
+//____________________________________________________________
+/// Print the pool contents.
+//____________________________________________________________
+void AliCaloTrackMixingPool::Print(const Option_t * opt) const
+{
+  if ( !opt ) return;
+
+  printf("**** Print %s %s **** \n", GetName(), GetTitle() ) ;
+  printf("Depth %d, capacity %d particles per event, stored events %d\n",fDepth,fCapacity,fNEvents);
+  for(Int_t ev = 0; ev < fNEvents; ev++)
+    printf("\t event %d: %d particles\n",ev,GetNParticles(ev));
+  printf("Memory: allocated %lld bytes, used %lld bytes\n",GetMemoryUsage(),GetUsedMemory());
+}
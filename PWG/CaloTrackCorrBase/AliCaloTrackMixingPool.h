@@ -0,0 +1,150 @@
+#ifndef ALICALOTRACKMIXINGPOOL_H
+#define ALICALOTRACKMIXINGPOOL_H
+/* Copyright(c) 1998-1999, ALICE Experiment at CERN, All rights reserved. *
+ * See cxx source for full Copyright notice     */
+
+//_________________________________________________________________________
+/// \class AliCaloTrackMixingPool
+/// \ingroup CaloTrackCorrelationsBase
+/// \brief Compact event mixing pool of clusters or tracks for one event class.
+///
+/// Ring buffer of the last GetDepth() events of one centrality, vertex and
+/// reaction plane bin. Instead of cloning the AliCaloTrackParticle arrays,
+/// only the quantities needed in the mixing loops are kept, in one contiguous
+/// array per quantity (energy, pT, eta, phi, time, number of cells, PID bits,
+/// module, highest energy cell, distance to bad channel, detector and flags).
+/// Each event slot has the same capacity, the arrays only grow when an
+/// event larger than any previous one is added, and the slots are reused
+/// when the oldest events are dropped.
+///
+/// The invariant mass, pT and opening angle of one particle combined with all
+/// the particles of a stored event are obtained with PairKinematics(),
+/// a branch free loop over contiguous arrays that the compiler can vectorize.
+/// Particles are treated as massless, as the calorimeter clusters.
+///
+/// Events are numbered from 0, the most recent one, to GetNEvents()-1,
+/// the oldest one, as in the TList pools filled with AddFirst().
+//_________________________________________________________________________
+
+// --- ROOT system ---
+#include <TObject.h>
+#include <TArrayF.h>
+#include <TArrayI.h>
+
+class AliCaloTrackParticle ;
+
+class AliCaloTrackMixingPool : public TObject {
+
+ public:
+
+  AliCaloTrackMixingPool() ;  // default ctor
+
+  AliCaloTrackMixingPool(Int_t depth, Int_t capacity = 0) ;
+
+  /// Virtual destructor.
+  virtual ~AliCaloTrackMixingPool() { ; }
+
+  /// Bits stored in the particle flags.
+  enum flags { kTagged = 1, kFidArea = 2, kPositive = 4 } ;
+
+  // Filling
+
+  void       SetDepth(Int_t depth) ;
+
+  void       Clear(Option_t * opt = "") ;
+
+  void       StartEvent() ;
+
+  Int_t      AddParticle(Float_t e, Float_t pt, Float_t eta, Float_t phi) ;
+
+  Int_t      AddParticle(const AliCaloTrackParticle * p, Int_t module, Int_t pdgWanted) ;
+
+  void       SetTime        (Int_t i, Float_t time  ) { fTime        [Offset(0)+i] = time   ; }
+  void       SetNCells      (Int_t i, Int_t   ncells) { fNCells      [Offset(0)+i] = ncells ; }
+  void       SetPIDBits     (Int_t i, Int_t   bits  ) { fPIDBits     [Offset(0)+i] = bits   ; }
+  void       SetModule      (Int_t i, Int_t   mod   ) { fModule      [Offset(0)+i] = mod    ; }
+  void       SetCellAbsIdMax(Int_t i, Int_t   absId ) { fCellAbsIdMax[Offset(0)+i] = absId  ; }
+  void       SetDistToBad   (Int_t i, Int_t   dist  ) { fDistToBad   [Offset(0)+i] = dist   ; }
+  void       SetDetectorTag (Int_t i, Int_t   det   ) { fDetector    [Offset(0)+i] = det    ; }
+  void       SetFlags       (Int_t i, Int_t   flags ) { fFlags       [Offset(0)+i] = flags  ; }
+
+  // Access, ev = 0 is the most recent event
+
+  Int_t      GetDepth()                    const { return fDepth      ; }
+  Int_t      GetCapacity()                 const { return fCapacity   ; }
+  Int_t      GetNEvents()                  const { return fNEvents    ; }
+  Int_t      GetNParticles(Int_t ev)       const { return fNParticles[Slot(ev)] ; }
+
+  const Float_t * GetE           (Int_t ev) const { return fE           .GetArray() + Offset(ev) ; }
+  const Float_t * GetPt          (Int_t ev) const { return fPt          .GetArray() + Offset(ev) ; }
+  const Float_t * GetEta         (Int_t ev) const { return fEta         .GetArray() + Offset(ev) ; }
+  const Float_t * GetPhi         (Int_t ev) const { return fPhi         .GetArray() + Offset(ev) ; }
+  const Float_t * GetTime        (Int_t ev) const { return fTime        .GetArray() + Offset(ev) ; }
+  const Int_t   * GetNCells      (Int_t ev) const { return fNCells      .GetArray() + Offset(ev) ; }
+  const Int_t   * GetPIDBits     (Int_t ev) const { return fPIDBits     .GetArray() + Offset(ev) ; }
+  const Int_t   * GetModule      (Int_t ev) const { return fModule      .GetArray() + Offset(ev) ; }
+  const Int_t   * GetCellAbsIdMax(Int_t ev) const { return fCellAbsIdMax.GetArray() + Offset(ev) ; }
+  const Int_t   * GetDistToBad   (Int_t ev) const { return fDistToBad   .GetArray() + Offset(ev) ; }
+  const Int_t   * GetDetectorTag (Int_t ev) const { return fDetector    .GetArray() + Offset(ev) ; }
+  const Int_t   * GetFlags       (Int_t ev) const { return fFlags       .GetArray() + Offset(ev) ; }
+
+  /// \return true if PID selection ipid was passed, see AliCaloTrackParticle::IsPIDOK().
+  static Bool_t IsPIDOK(Int_t bits, Int_t ipid)        { return (bits >> ipid) & 1 ; }
+
+  Long64_t   GetMemoryUsage()              const ;
+  Long64_t   GetUsedMemory()               const ;
+
+  // Pair kinematics
+
+  Int_t      PairKinematics(Int_t ev, Float_t e1, Float_t pt1, Float_t eta1, Float_t phi1,
+                            TArrayF & mass, TArrayF & pairPt, TArrayF & angle) const ;
+
+  static void PairKinematics(Int_t n, Float_t e1, Float_t pt1, Float_t eta1, Float_t phi1,
+                             const Float_t * e2, const Float_t * pt2, const Float_t * eta2, const Float_t * phi2,
+                             Float_t * mass, Float_t * pairPt, Float_t * angle) ;
+
+  void       Print(const Option_t * opt) const ;
+
+ private:
+
+  /// Ring buffer slot of event ev, 0 is the most recent.
+  Int_t      Slot(Int_t ev)                const { return (fHead - ev + fDepth) % fDepth ; }
+
+  /// Position of first particle of event ev in the arrays.
+  Int_t      Offset(Int_t ev)              const { return Slot(ev)*fCapacity ; }
+
+  void       Resize(Int_t capacity) ;
+
+  Int_t      fDepth;                //!<! Number of events kept.
+  Int_t      fCapacity;             //!<! Maximum number of particles per event slot.
+  Int_t      fNEvents;              //!<! Number of events stored, up to fDepth.
+  Int_t      fHead;                 //!<! Slot of the most recent event.
+
+  TArrayI    fNParticles;           //!<! Number of particles per slot.
+
+  TArrayF    fE;                    //!<! Particle energy.
+  TArrayF    fPt;                   //!<! Particle transverse momentum.
+  TArrayF    fEta;                  //!<! Particle pseudorapidity.
+  TArrayF    fPhi;                  //!<! Particle azimuthal angle in [0,2pi[.
+  TArrayF    fTime;                 //!<! Cluster time.
+  TArrayI    fNCells;               //!<! Cluster number of cells.
+  TArrayI    fPIDBits;              //!<! Bit ipid set if AliCaloTrackParticle::IsPIDOK(ipid,pdg) passed.
+  TArrayI    fModule;               //!<! Super module number.
+  TArrayI    fCellAbsIdMax;         //!<! Highest energy cell absolute ID.
+  TArrayI    fDistToBad;            //!<! Distance to bad channel.
+  TArrayI    fDetector;             //!<! Detector tag.
+  TArrayI    fFlags;                //!<! Bits of enum flags.
+
+  /// Copy constructor not implemented.
+  AliCaloTrackMixingPool(              const AliCaloTrackMixingPool & p) ;
+
+  /// Assignment operator not implemented.
+  AliCaloTrackMixingPool & operator = (const AliCaloTrackMixingPool & p) ;
+
+  /// \cond CLASSIMP
+  ClassDef(AliCaloTrackMixingPool,1) ;
+  /// \endcond
+
+} ;
+
+#endif //ALICALOTRACKMIXINGPOOL_H
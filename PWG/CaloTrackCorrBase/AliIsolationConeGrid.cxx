@@ -0,0 +1,621 @@
+/**************************************************************************
+ * Copyright(c) 1998-1999, ALICE Experiment at CERN, All rights reserved. *
+ *                                                                        *
+ * Author: The ALICE Off-line Project.                                    *
+ * Contributors are mentioned in the code where appropriate.              *
+ *                                                                        *
+ * Permission to use, copy, modify and distribute this software and its   *
+ * documentation strictly for non-commercial purposes is hereby granted   *
+ * without fee, provided that the above copyright notice appears in all   *
+ * copies and that both the copyright notice and this permission notice   *
+ * appear in the supporting documentation. The authors make no claims     *
+ * about the suitability of this software for any purpose. It is          *
+ * provided "as is" without express or implied warranty.                  *
+ **************************************************************************/
+
+#include <algorithm>
+
+// --- ROOT system ---
+#include <TMath.h>
+
+// --- AliRoot system ---
+#include "AliLog.h"
+
+#include "AliIsolationConeGrid.h"
+
+/// \cond CLASSIMP
+ClassImp(AliIsolationConeGrid) ;
+/// \endcond
+
+namespace
+{
+  /// Safety margin when classifying cells, particles closer than this
+  /// to a region boundary are always checked one by one.
+  const Float_t kCellEpsilon = 1.e-4;
+
+  //____________________________________________________________
+  /// Minimum and maximum of |x| for x in [lo,hi].
+  //____________________________________________________________
+  void AbsRange(Float_t lo, Float_t hi, Float_t & amin, Float_t & amax)
+  {
+    Float_t alo = TMath::Abs(lo);
+    Float_t ahi = TMath::Abs(hi);
+    amin = ( lo <= 0 && hi >= 0 ) ? 0 : TMath::Min(alo, ahi);
+    amax = TMath::Max(alo, ahi);
+  }
+}
+
+//____________________________________
+/// Default constructor.
+//____________________________________
+AliIsolationConeGrid::AliIsolationConeGrid() :
+TObject(),
+fNEta(20),           fNPhi(64),
+fCountPtMin(0.),     fCountPtMax(10000.),
+fEtaMin(-1.),        fEtaMax(1.),
+fEtaWidth(0.1),      fPhiWidth(TMath::TwoPi()/64),
+fBuilt(kFALSE),      fNEntries(0),
+fPt(0),   fEta(0),   fPhi(0),   fIndex(0),   fID(0),   fCell(0),
+fIDOrder(0),         fSortedID(0),
+fCellStart(0),       fCellSumPt(0),      fCellMaxPt(0),      fCellCount(0)
+{
+}
+
+//____________________________________
+/// Constructor.
+/// \param nEta: number of cells in eta, the range is taken from the entries.
+/// \param nPhi: number of cells in phi, covering 2 pi.
+//____________________________________
+AliIsolationConeGrid::AliIsolationConeGrid(Int_t nEta, Int_t nPhi) :
+TObject(),
+fNEta(20),           fNPhi(64),
+fCountPtMin(0.),     fCountPtMax(10000.),
+fEtaMin(-1.),        fEtaMax(1.),
+fEtaWidth(0.1),      fPhiWidth(TMath::TwoPi()/64),
+fBuilt(kFALSE),      fNEntries(0),
+fPt(0),   fEta(0),   fPhi(0),   fIndex(0),   fID(0),   fCell(0),
+fIDOrder(0),         fSortedID(0),
+fCellStart(0),       fCellSumPt(0),      fCellMaxPt(0),      fCellCount(0)
+{
+  SetNCells(nEta, nPhi);
+}
+
+//____________________________________________________________
+/// Set the number of cells. The phi cells must be smaller
+/// than pi, at least 3 cells are used.
+//____________________________________________________________
+void AliIsolationConeGrid::SetNCells(Int_t nEta, Int_t nPhi)
+{
+  fNEta     = nEta < 1 ? 1 : nEta;
+  fNPhi     = nPhi < 3 ? 3 : nPhi;
+  fPhiWidth = TMath::TwoPi() / fNPhi;
+  fBuilt    = kFALSE;
+}
+
+//____________________________________________________________
+/// Remove all particles, keep the allocated memory for next event.
+//____________________________________________________________
+void AliIsolationConeGrid::Clear(Option_t *)
+{
+  fNEntries = 0;
+  fBuilt    = kFALSE;
+}
+
+//____________________________________________________________
+/// Add a particle to the grid.
+/// \param pt: transverse momentum or energy.
+/// \param eta: pseudorapidity.
+/// \param phi: azimuthal angle, any range.
+/// \param index: position in the input array.
+/// \param id: track or cluster ID, used to exclude the candidate daughters.
+//____________________________________________________________
+void AliIsolationConeGrid::Add(Float_t pt, Float_t eta, Float_t phi, Int_t index, Int_t id)
+{
+  if ( fNEntries >= fPt.GetSize() )
+  {
+    Int_t size = fNEntries < 64 ? 128 : 2*fNEntries;
+    fPt   .Set(size);
+    fEta  .Set(size);
+    fPhi  .Set(size);
+    fIndex.Set(size);
+    fID   .Set(size);
+  }
+
+  while ( phi <  0               ) phi += TMath::TwoPi();
+  while ( phi >= TMath::TwoPi()  ) phi -= TMath::TwoPi();
+
+  fPt   [fNEntries] = pt;
+  fEta  [fNEntries] = eta;
+  fPhi  [fNEntries] = phi;
+  fIndex[fNEntries] = index;
+  fID   [fNEntries] = id;
+  fNEntries++;
+
+  fBuilt = kFALSE;
+}
+
+//____________________________________________________________
+/// Sort the particles by cell and cache the per cell sums.
+/// The eta range of the grid is set from the entries.
+//____________________________________________________________
+void AliIsolationConeGrid::Build()
+{
+  Int_t nCells = fNEta*fNPhi;
+
+  fCellStart.Set(nCells+1);
+  fCellSumPt.Set(nCells);
+  fCellMaxPt.Set(nCells);
+  fCellCount.Set(nCells);
+  fCellStart.Reset();
+  fCellSumPt.Reset();
+  fCellMaxPt.Reset();
+  fCellCount.Reset();
+
+  // Eta range from the entries
+  //
+  fEtaMin = -1;
+  fEtaMax =  1;
+  if ( fNEntries > 0 )
+  {
+    fEtaMin = TMath::MinElement(fNEntries, fEta.GetArray());
+    fEtaMax = TMath::MaxElement(fNEntries, fEta.GetArray());
+  }
+  fEtaWidth = (fEtaMax - fEtaMin) / fNEta;
+  if ( fEtaWidth <= 0 ) fEtaWidth = 1.e-3;
+  fEtaMax = fEtaMin + fEtaWidth*fNEta;
+
+  // Count particles per cell
+  //
+  fCell.Set(fNEntries);
+  for(Int_t i = 0; i < fNEntries; i++)
+  {
+    Int_t ieta = Int_t((fEta[i] - fEtaMin) / fEtaWidth);
+    Int_t iphi = Int_t( fPhi[i]            / fPhiWidth);
+    if ( ieta >= fNEta ) ieta = fNEta-1;
+    if ( ieta <  0     ) ieta = 0;
+    if ( iphi >= fNPhi ) iphi = fNPhi-1;
+
+    fCell[i] = CellIndex(ieta, iphi);
+    fCellStart[fCell[i]+1]++;
+  }
+
+  for(Int_t c = 0; c < nCells; c++) fCellStart[c+1] += fCellStart[c];
+
+  // Sort the particles by cell, keep the input order inside each cell
+  //
+  TArrayF pt (fPt);
+  TArrayF eta(fEta);
+  TArrayF phi(fPhi);
+  TArrayI idx(fIndex);
+  TArrayI id (fID);
+  TArrayI pos(nCells);
+  for(Int_t c = 0; c < nCells; c++) pos[c] = fCellStart[c];
+
+  for(Int_t i = 0; i < fNEntries; i++)
+  {
+    Int_t c = fCell[i];
+    Int_t j = pos[c]++;
+
+    fPt   [j] = pt [i];
+    fEta  [j] = eta[i];
+    fPhi  [j] = phi[i];
+    fIndex[j] = idx[i];
+    fID   [j] = id [i];
+
+    fCellSumPt[c] += pt[i];
+    if ( pt[i] > fCellMaxPt[c] ) fCellMaxPt[c] = pt[i];
+    if ( pt[i] > fCountPtMin && pt[i] < fCountPtMax ) fCellCount[c]++;
+  }
+
+  // Cell of each sorted particle
+  for(Int_t c = 0; c < nCells; c++)
+  {
+    for(Int_t j = fCellStart[c]; j < fCellStart[c+1]; j++) fCell[j] = c;
+  }
+
+  // Order by ID for the exclusion of candidate daughters
+  //
+  fIDOrder .Set(fNEntries);
+  fSortedID.Set(fNEntries);
+  if ( fNEntries > 0 )
+  {
+    TMath::Sort(fNEntries, fID.GetArray(), fIDOrder.GetArray(), kFALSE);
+    for(Int_t i = 0; i < fNEntries; i++) fSortedID[i] = fID[fIDOrder[i]];
+  }
+
+  fBuilt = kTRUE;
+}
+
+//____________________________________________________________
+/// \return phi - phiC in [-pi,pi[.
+//____________________________________________________________
+Float_t AliIsolationConeGrid::DeltaPhi(Float_t phi, Float_t phiC) const
+{
+  Float_t dPhi = phi - phiC;
+  while ( dPhi >=  TMath::Pi() ) dPhi -= TMath::TwoPi();
+  while ( dPhi <  -TMath::Pi() ) dPhi += TMath::TwoPi();
+  return dPhi;
+}
+
+//____________________________________________________________
+/// Get the cell limits relative to the candidate direction.
+/// The phi range is centred on the wrapped cell centre.
+//____________________________________________________________
+void AliIsolationConeGrid::CellRanges(Int_t ieta, Int_t iphi, Float_t etaC, Float_t phiC,
+                                      Float_t & etaLo, Float_t & etaHi,
+                                      Float_t & phiLo, Float_t & phiHi) const
+{
+  etaLo = fEtaMin + ieta*fEtaWidth - etaC;
+  etaHi = etaLo   + fEtaWidth;
+
+  Float_t dPhi = DeltaPhi((iphi+0.5)*fPhiWidth, phiC);
+  phiLo = dPhi - 0.5*fPhiWidth;
+  phiHi = dPhi + 0.5*fPhiWidth;
+}
+
+//____________________________________________________________
+/// Check if a particle at distance dEta, dPhi from the candidate
+/// belongs to the region, same conditions as in AliIsolationCut.
+//____________________________________________________________
+Bool_t AliIsolationConeGrid::InRegion(Int_t region, Float_t dEta, Float_t dPhi,
+                                      Float_t r, Float_t gap, Bool_t rectangular,
+                                      Float_t minDist) const
+{
+  Float_t rad = TMath::Sqrt(dEta*dEta + dPhi*dPhi);
+
+  if ( rad < minDist ) return kFALSE;
+
+  Float_t aEta = TMath::Abs(dEta);
+  Float_t aPhi = TMath::Abs(dPhi);
+
+  switch ( region )
+  {
+    case kCone:
+      return rad <= r;
+
+    case kPhiBand:
+      if ( rad <= r                            ) return kFALSE;
+      if ( rectangular && aPhi < r+gap         ) return kFALSE;
+      if ( aPhi > TMath::PiOver2()             ) return kFALSE;
+      return aEta < r;
+
+    case kEtaBand:
+      if ( rad <= r                            ) return kFALSE;
+      if ( rectangular && aEta < r+gap         ) return kFALSE;
+      return aPhi < r;
+  }
+
+  return kFALSE;
+}
+
+//____________________________________________________________
+/// Classify a cell with limits relative to the candidate direction.
+/// \return kCellIn if all the particles in the cell belong to the region,
+/// kCellOut if none, kCellBoundary if they must be checked one by one.
+//____________________________________________________________
+Int_t AliIsolationConeGrid::ClassifyCell(Int_t region, Float_t etaLo, Float_t etaHi,
+                                         Float_t phiLo, Float_t phiHi,
+                                         Float_t r, Float_t gap, Bool_t rectangular,
+                                         Float_t minDist) const
+{
+  const Float_t eps = kCellEpsilon;
+
+  Float_t aEtaMin = 0, aEtaMax = 0, aPhiMin = 0, aPhiMax = 0;
+  AbsRange(etaLo, etaHi, aEtaMin, aEtaMax);
+  AbsRange(phiLo, phiHi, aPhiMin, aPhiMax);
+
+  Float_t minD = TMath::Sqrt(aEtaMin*aEtaMin + aPhiMin*aPhiMin);
+  Float_t maxD = TMath::Sqrt(aEtaMax*aEtaMax + aPhiMax*aPhiMax);
+
+  Bool_t all  = kFALSE;
+  Bool_t none = kFALSE;
+
+  switch ( region )
+  {
+    case kCone:
+      none = ( minD > r + eps );
+      all  = ( maxD < r - eps );
+      break;
+
+    case kPhiBand:
+      none = ( maxD    < r - eps ) || ( aEtaMin > r + eps ) ||
+             ( aPhiMin > TMath::PiOver2() + eps ) ||
+             ( rectangular && aPhiMax < r + gap - eps );
+      all  = ( minD    > r + eps ) && ( aEtaMax < r - eps ) &&
+             ( aPhiMax < TMath::PiOver2() - eps ) &&
+             ( !rectangular || aPhiMin > r + gap + eps );
+      break;
+
+    case kEtaBand:
+      none = ( maxD    < r - eps ) || ( aPhiMin > r + eps ) ||
+             ( rectangular && aEtaMax < r + gap - eps );
+      all  = ( minD    > r + eps ) && ( aPhiMax < r - eps ) &&
+             ( !rectangular || aEtaMin > r + gap + eps );
+      break;
+  }
+
+  if ( none ) return kCellOut;
+
+  // Particles too close to the candidate are rejected
+  if ( minDist > 0 && minD < minDist + eps ) return kCellBoundary;
+
+  return all ? kCellIn : kCellBoundary;
+}
+
+//____________________________________________________________
+/// \return true if the id is in the list.
+//____________________________________________________________
+Bool_t AliIsolationConeGrid::IsExcluded(Int_t id, const Int_t * excludeIDs, Int_t nExclude) const
+{
+  for(Int_t i = 0; i < nExclude; i++)
+  {
+    if ( excludeIDs[i] == id ) return kTRUE;
+  }
+  return kFALSE;
+}
+
+//____________________________________________________________
+/// \return true if the cell is in the list.
+//____________________________________________________________
+Bool_t AliIsolationConeGrid::IsCellForced(Int_t cell, const Int_t * forced, Int_t nForced) const
+{
+  for(Int_t i = 0; i < nForced; i++)
+  {
+    if ( forced[i] == cell ) return kTRUE;
+  }
+  return kFALSE;
+}
+
+//____________________________________________________________
+/// Find the cells containing particles to exclude.
+/// \param cells: output, must hold nExclude entries.
+/// \return number of cells found.
+//____________________________________________________________
+Int_t AliIsolationConeGrid::FindExcludedCells(const Int_t * excludeIDs, Int_t nExclude, Int_t * cells) const
+{
+  Int_t nCells = 0;
+  if ( !excludeIDs || fNEntries == 0 ) return nCells;
+
+  for(Int_t i = 0; i < nExclude; i++)
+  {
+    if ( excludeIDs[i] < 0 ) continue;
+
+    Long64_t j = TMath::BinarySearch(fNEntries, fSortedID.GetArray(), excludeIDs[i]);
+    // Several particles may share the ID, find all of them
+    for( ; j >= 0 && fSortedID[j] == excludeIDs[i]; j--)
+    {
+      Int_t c = fCell[fIDOrder[j]];
+      if ( !IsCellForced(c, cells, nCells) && nCells < nExclude ) cells[nCells++] = c;
+    }
+  }
+
+  return nCells;
+}
+
+//____________________________________________________________
+/// Get the input array indices of the particles in cells
+/// intersecting the cone, to be checked by the caller.
+/// The indices are sorted in input order, so that the particles
+/// are processed as when looping over the whole input array.
+/// \return number of indices.
+//____________________________________________________________
+Int_t AliIsolationConeGrid::GetIndicesInCone(Float_t etaC, Float_t phiC, Float_t radius,
+                                             TArrayI & indices) const
+{
+  if ( !fBuilt )
+  {
+    AliWarning("Grid not built");
+    return 0;
+  }
+
+  if ( indices.GetSize() < fNEntries ) indices.Set(fNEntries);
+
+  Int_t n = 0;
+  Float_t etaLo = 0, etaHi = 0, phiLo = 0, phiHi = 0;
+  for(Int_t ieta = 0; ieta < fNEta; ieta++)
+  {
+    for(Int_t iphi = 0; iphi < fNPhi; iphi++)
+    {
+      CellRanges(ieta, iphi, etaC, phiC, etaLo, etaHi, phiLo, phiHi);
+
+      if ( ClassifyCell(kCone, etaLo, etaHi, phiLo, phiHi, radius, 0, kFALSE, -1) == kCellOut ) continue;
+
+      Int_t c = CellIndex(ieta, iphi);
+      for(Int_t j = fCellStart[c]; j < fCellStart[c+1]; j++) indices[n++] = fIndex[j];
+    }
+  }
+
+  std::sort(indices.GetArray(), indices.GetArray()+n);
+
+  return n;
+}
+
+//____________________________________________________________
+/// Sum pT, leading pT and number of particles within the
+/// count thresholds in cones of several radii around the candidate.
+/// \param etaC: candidate pseudorapidity.
+/// \param phiC: candidate azimuthal angle.
+/// \param nRadii: number of cone radii.
+/// \param radii: cone radii.
+/// \param minDist: particles closer than this to the candidate are not counted.
+/// \param excludeIDs: IDs of particles not counted, candidate daughters.
+/// \param nExclude: number of IDs.
+/// \param sumPt: output sum pT per radius, can be null.
+/// \param leadPt: output leading pT per radius, can be null.
+/// \param nPart: output number of particles within count thresholds per radius, can be null.
+//____________________________________________________________
+void AliIsolationConeGrid::ConeSums(Float_t etaC, Float_t phiC,
+                                    Int_t nRadii, const Float_t * radii,
+                                    Float_t minDist, const Int_t * excludeIDs, Int_t nExclude,
+                                    Float_t * sumPt, Float_t * leadPt, Int_t * nPart) const
+{
+  for(Int_t ir = 0; ir < nRadii; ir++)
+  {
+    if ( sumPt  ) sumPt [ir] = 0;
+    if ( leadPt ) leadPt[ir] = 0;
+    if ( nPart  ) nPart [ir] = 0;
+  }
+
+  if ( !fBuilt )
+  {
+    AliWarning("Grid not built");
+    return;
+  }
+
+  if ( nRadii <= 0 || fNEntries == 0 ) return;
+
+  Float_t rMax = TMath::MaxElement(nRadii, radii);
+
+  Int_t   forced[4];
+  Int_t   nForced = FindExcludedCells(excludeIDs, TMath::Min(nExclude, 4), forced);
+
+  Float_t etaLo = 0, etaHi = 0, phiLo = 0, phiHi = 0;
+  for(Int_t ieta = 0; ieta < fNEta; ieta++)
+  {
+    for(Int_t iphi = 0; iphi < fNPhi; iphi++)
+    {
+      CellRanges(ieta, iphi, etaC, phiC, etaLo, etaHi, phiLo, phiHi);
+
+      if ( ClassifyCell(kCone, etaLo, etaHi, phiLo, phiHi, rMax, 0, kFALSE, minDist) == kCellOut ) continue;
+
+      Int_t  c      = CellIndex(ieta, iphi);
+      Bool_t forceC = IsCellForced(c, forced, nForced);
+
+      for(Int_t ir = 0; ir < nRadii; ir++)
+      {
+        Int_t type = ClassifyCell(kCone, etaLo, etaHi, phiLo, phiHi, radii[ir], 0, kFALSE, minDist);
+
+        if ( type == kCellOut ) continue;
+
+        if ( type == kCellIn && !forceC )
+        {
+          if ( sumPt  ) sumPt[ir] += fCellSumPt[c];
+          if ( leadPt && leadPt[ir] < fCellMaxPt[c] ) leadPt[ir] = fCellMaxPt[c];
+          if ( nPart  ) nPart[ir] += fCellCount[c];
+          continue;
+        }
+
+        // Boundary cell, check particles one by one
+        for(Int_t j = fCellStart[c]; j < fCellStart[c+1]; j++)
+        {
+          if ( forceC && IsExcluded(fID[j], excludeIDs, nExclude) ) continue;
+
+          Float_t dEta = fEta[j] - etaC;
+          Float_t dPhi = DeltaPhi(fPhi[j], phiC);
+
+          if ( !InRegion(kCone, dEta, dPhi, radii[ir], 0, kFALSE, minDist) ) continue;
+
+          Float_t pt = fPt[j];
+          if ( sumPt  ) sumPt[ir] += pt;
+          if ( leadPt && leadPt[ir] < pt ) leadPt[ir] = pt;
+          if ( nPart  && pt > fCountPtMin && pt < fCountPtMax ) nPart[ir]++;
+        }
+      } // radii
+    } // phi cells
+  } // eta cells
+}
+
+//____________________________________________________________
+/// Sum pT in the eta and phi UE bands for several cone radii.
+/// The band width is the cone radius, see AliIsolationCut.
+/// \param etaC: candidate pseudorapidity.
+/// \param phiC: candidate azimuthal angle.
+/// \param nRadii: number of cone radii.
+/// \param radii: cone radii.
+/// \param gap: gap added to the cone size for the rectangular exclusion.
+/// \param rectangular: exclude the rectangle containing the cone instead of the cone.
+/// \param minDist: particles closer than this to the candidate are not counted.
+/// \param excludeIDs: IDs of particles not counted, candidate daughters.
+/// \param nExclude: number of IDs.
+/// \param etaBandSumPt: output sum pT in eta band per radius, can be null.
+/// \param phiBandSumPt: output sum pT in phi band per radius, can be null.
+//____________________________________________________________
+void AliIsolationConeGrid::BandSums(Float_t etaC, Float_t phiC,
+                                    Int_t nRadii, const Float_t * radii,
+                                    Float_t gap, Bool_t rectangular,
+                                    Float_t minDist, const Int_t * excludeIDs, Int_t nExclude,
+                                    Float_t * etaBandSumPt, Float_t * phiBandSumPt) const
+{
+  for(Int_t ir = 0; ir < nRadii; ir++)
+  {
+    if ( etaBandSumPt ) etaBandSumPt[ir] = 0;
+    if ( phiBandSumPt ) phiBandSumPt[ir] = 0;
+  }
+
+  if ( !fBuilt )
+  {
+    AliWarning("Grid not built");
+    return;
+  }
+
+  if ( nRadii <= 0 || fNEntries == 0 ) return;
+
+  Int_t   forced[4];
+  Int_t   nForced = FindExcludedCells(excludeIDs, TMath::Min(nExclude, 4), forced);
+
+  const Int_t kNRegions = 2;
+  Int_t     regions[kNRegions] = { kEtaBand    , kPhiBand     };
+  Float_t * sums   [kNRegions] = { etaBandSumPt, phiBandSumPt };
+
+  Float_t etaLo = 0, etaHi = 0, phiLo = 0, phiHi = 0;
+  for(Int_t ieta = 0; ieta < fNEta; ieta++)
+  {
+    for(Int_t iphi = 0; iphi < fNPhi; iphi++)
+    {
+      Int_t c = CellIndex(ieta, iphi);
+      if ( fCellStart[c] == fCellStart[c+1] ) continue;
+
+      CellRanges(ieta, iphi, etaC, phiC, etaLo, etaHi, phiLo, phiHi);
+
+      Bool_t forceC = IsCellForced(c, forced, nForced);
+
+      for(Int_t ireg = 0; ireg < kNRegions; ireg++)
+      {
+        if ( !sums[ireg] ) continue;
+
+        for(Int_t ir = 0; ir < nRadii; ir++)
+        {
+          Int_t type = ClassifyCell(regions[ireg], etaLo, etaHi, phiLo, phiHi,
+                                    radii[ir], gap, rectangular, minDist);
+
+          if ( type == kCellOut ) continue;
+
+          if ( type == kCellIn && !forceC )
+          {
+            sums[ireg][ir] += fCellSumPt[c];
+            continue;
+          }
+
+          // Boundary cell, check particles one by one
+          for(Int_t j = fCellStart[c]; j < fCellStart[c+1]; j++)
+          {
+            if ( forceC && IsExcluded(fID[j], excludeIDs, nExclude) ) continue;
+
+            Float_t dEta = fEta[j] - etaC;
+            Float_t dPhi = DeltaPhi(fPhi[j], phiC);
+
+            if ( InRegion(regions[ireg], dEta, dPhi, radii[ir], gap, rectangular, minDist) )
+              sums[ireg][ir] += fPt[j];
+          }
+        } // radii
+      } // regions
+    } // phi cells
+  } // eta cells
+}
+
+//_____________________________________________________
+/// Print some relevant parameters.
+//_____________________________________________________
+void AliIsolationConeGrid::Print(const Option_t * opt) const
+{
+  if(! opt)
+    return;
+
+  printf("**** Print %s **** \n", GetName() ) ;
+
+  printf("Cells eta x phi    =     %d x %d\n", fNEta, fNPhi ) ;
+  printf("Eta range          =     [%2.2f,%2.2f]\n", fEtaMin, fEtaMax ) ;
+  printf("Count pT range     =     >%2.1f;<%2.1f\n", fCountPtMin, fCountPtMax ) ;
+  printf("Entries            =     %d, built %d\n", fNEntries, fBuilt ) ;
+  printf("    \n") ;
+}
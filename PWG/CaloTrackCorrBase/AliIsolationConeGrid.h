@@ -0,0 +1,148 @@
+#ifndef ALIISOLATIONCONEGRID_H
+#define ALIISOLATIONCONEGRID_H
+/* Copyright(c) 1998-1999, ALICE Experiment at CERN, All rights reserved. *
+ * See cxx source for full Copyright notice     */
+
+//_________________________________________________________________________
+/// \class AliIsolationConeGrid
+/// \ingroup CaloTrackCorrelationsBase
+/// \brief Eta-phi grid of tracks or clusters for fast isolation cone sums.
+///
+/// The tracks or clusters of an event are binned once in an eta-phi grid,
+/// stored contiguously per cell, together with the per cell sum pT,
+/// maximum pT and number of particles within the pT thresholds.
+/// Cone and UE band sums for any list of radii are obtained from the cells
+/// intersecting the region: cells fully contained in the region contribute
+/// with their cached sums, and only the particles in cells crossing
+/// the region boundary are checked one by one. The phi wrap-around is taken
+/// into account.
+///
+/// The selection of particles in the cone and bands follows the one
+/// of AliIsolationCut::CalculateTrackSignalInCone() and
+/// AliIsolationCut::CalculateCaloSignalInCone().
+//_________________________________________________________________________
+
+// --- ROOT system ---
+#include <TObject.h>
+#include <TArrayF.h>
+#include <TArrayI.h>
+
+class AliIsolationConeGrid : public TObject {
+
+ public:
+
+  AliIsolationConeGrid() ;  // default ctor
+
+  AliIsolationConeGrid(Int_t nEta, Int_t nPhi) ;
+
+  /// Virtual destructor.
+  virtual ~AliIsolationConeGrid() { ; }
+
+  // Filling
+
+  void       SetNCells(Int_t nEta, Int_t nPhi) ;
+
+  void       SetCountPtThresholds(Float_t min, Float_t max) { fCountPtMin = min ; fCountPtMax = max ; }
+
+  void       Clear(Option_t * opt = "") ;
+
+  void       Add(Float_t pt, Float_t eta, Float_t phi, Int_t index, Int_t id = -1) ;
+
+  void       Build() ;
+
+  // Access
+
+  Int_t      GetNEntries()            const { return fNEntries     ; }
+  Int_t      GetNEtaCells()           const { return fNEta         ; }
+  Int_t      GetNPhiCells()           const { return fNPhi         ; }
+  Bool_t     IsBuilt()                const { return fBuilt        ; }
+
+  Float_t    GetPt   (Int_t i)        const { return fPt   [i]     ; }
+  Float_t    GetEta  (Int_t i)        const { return fEta  [i]     ; }
+  Float_t    GetPhi  (Int_t i)        const { return fPhi  [i]     ; }
+  Int_t      GetIndex(Int_t i)        const { return fIndex[i]     ; }
+  Int_t      GetID   (Int_t i)        const { return fID   [i]     ; }
+
+  Int_t      GetIndicesInCone(Float_t etaC, Float_t phiC, Float_t radius, TArrayI & indices) const ;
+
+  // Cone and band sums
+
+  void       ConeSums(Float_t etaC, Float_t phiC,
+                      Int_t nRadii, const Float_t * radii,
+                      Float_t minDist, const Int_t * excludeIDs, Int_t nExclude,
+                      Float_t * sumPt, Float_t * leadPt, Int_t * nPart) const ;
+
+  void       BandSums(Float_t etaC, Float_t phiC,
+                      Int_t nRadii, const Float_t * radii,
+                      Float_t gap, Bool_t rectangular,
+                      Float_t minDist, const Int_t * excludeIDs, Int_t nExclude,
+                      Float_t * etaBandSumPt, Float_t * phiBandSumPt) const ;
+
+  void       Print(const Option_t * opt) const ;
+
+ private:
+
+  /// Region predicate tested on cells and particles.
+  enum region { kCone, kEtaBand, kPhiBand } ;
+
+  /// Classification of a cell with respect to a region.
+  enum cellType { kCellOut = 0, kCellIn = 1, kCellBoundary = 2 } ;
+
+  Int_t      CellIndex(Int_t ieta, Int_t iphi) const { return ieta*fNPhi + iphi ; }
+
+  Float_t    DeltaPhi(Float_t phi, Float_t phiC) const ;
+
+  void       CellRanges(Int_t ieta, Int_t iphi, Float_t etaC, Float_t phiC,
+                        Float_t & etaLo, Float_t & etaHi, Float_t & phiLo, Float_t & phiHi) const ;
+
+  Int_t      ClassifyCell(Int_t region, Float_t etaLo, Float_t etaHi, Float_t phiLo, Float_t phiHi,
+                          Float_t r, Float_t gap, Bool_t rectangular, Float_t minDist) const ;
+
+  Bool_t     InRegion(Int_t region, Float_t dEta, Float_t dPhi,
+                      Float_t r, Float_t gap, Bool_t rectangular, Float_t minDist) const ;
+
+  Bool_t     IsCellForced(Int_t cell, const Int_t * forced, Int_t nForced) const ;
+
+  Int_t      FindExcludedCells(const Int_t * excludeIDs, Int_t nExclude, Int_t * cells) const ;
+
+  Bool_t     IsExcluded(Int_t id, const Int_t * excludeIDs, Int_t nExclude) const ;
+
+  Int_t      fNEta;                 ///< Number of cells in eta.
+  Int_t      fNPhi;                 ///< Number of cells in phi, covering 2 pi.
+  Float_t    fCountPtMin;           ///< Count particles with pT above this value.
+  Float_t    fCountPtMax;           ///< Count particles with pT below this value.
+
+  Float_t    fEtaMin;               //!<! Lower eta edge of grid, from the entries.
+  Float_t    fEtaMax;               //!<! Upper eta edge of grid, from the entries.
+  Float_t    fEtaWidth;             //!<! Eta size of cells.
+  Float_t    fPhiWidth;             //!<! Phi size of cells.
+  Bool_t     fBuilt;                //!<! Grid was built after last entry added.
+
+  Int_t      fNEntries;             //!<! Number of particles.
+  TArrayF    fPt;                   //!<! Particle pT, sorted by cell after Build().
+  TArrayF    fEta;                  //!<! Particle eta, sorted by cell after Build().
+  TArrayF    fPhi;                  //!<! Particle phi in [0,2pi[, sorted by cell after Build().
+  TArrayI    fIndex;                //!<! Particle index in input array, sorted by cell after Build().
+  TArrayI    fID;                   //!<! Particle ID (track ID, cluster ID), sorted by cell after Build().
+  TArrayI    fCell;                 //!<! Cell of each particle, work array.
+  TArrayI    fIDOrder;              //!<! Particles ordered by ID, for exclusion of candidate daughters.
+  TArrayI    fSortedID;             //!<! Particle IDs in increasing order.
+
+  TArrayI    fCellStart;            //!<! First particle of each cell, nCells+1 entries.
+  TArrayF    fCellSumPt;            //!<! Sum pT of particles in cell.
+  TArrayF    fCellMaxPt;            //!<! Maximum pT of particles in cell.
+  TArrayI    fCellCount;            //!<! Particles in cell with pT within count thresholds.
+
+  /// Copy constructor not implemented.
+  AliIsolationConeGrid(              const AliIsolationConeGrid & g) ;
+
+  /// Assignment operator not implemented.
+  AliIsolationConeGrid & operator = (const AliIsolationConeGrid & g) ;
+
+  /// \cond CLASSIMP
+  ClassDef(AliIsolationConeGrid,1) ;
+  /// \endcond
+
+} ;
+
+#endif //ALIISOLATIONCONEGRID_H
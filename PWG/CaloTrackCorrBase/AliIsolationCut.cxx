@@ -55,6 +55,10 @@ fFracIsThresh(1),    fIsTMClusterInConeRejected(1), fDistMinToTrigger(-1.),
 fDebug(0),           fMomentum(),                   fTrackVector(),
 fEMCEtaSize(-1),     fEMCPhiMin(-1),                fEMCPhiMax(-1),
 fTPCEtaSize(-1),     fTPCPhiSize(-1),
+fUseConeGrid(0),     fConeGridNEta(20),             fConeGridNPhi(64),
+fTrackGrid(),        fClusterGrid(),
+fTrackGridEvent(-1), fClusterGridEvent(-1),         fClusterGridCalo(-1),
+fGridIndices(0),
 // Histograms
 fHistoRanges(0),                            fNCentBins(0),
 fhPtInCone(0),       
@@ -202,11 +206,25 @@ void AliIsolationCut::CalculateCaloSignalInCone
   TObjArray * refclusters  = 0x0;
   Int_t       nclusterrefs = 0;
   
+  // Restrict the loop to the clusters in grid cells intersecting the cone
+  // when nothing out of the cone is needed
+  //
+  Int_t  nLoop   = plNe->GetEntries();
+  Bool_t useGrid = ( fUseConeGrid && !bgCls && !useRefs && fICMethod < kSumBkgSubIC &&
+                    !(fFillHistograms && fFillEtaPhiHistograms) );
+  if ( useGrid )
+  {
+    FillClusterGrid(reader, calorimeter, pid);
+    nLoop = fClusterGrid.GetIndicesInCone(etaC, phiC, fConeSize, fGridIndices);
+  }
+  
   // Get the clusters
   //
   //printf("Loop calo\n");
-  for(Int_t ipr = 0;ipr < plNe->GetEntries() ; ipr ++ )
+  for(Int_t iloop = 0; iloop < nLoop ; iloop ++ )
   {
+    Int_t ipr = useGrid ? fGridIndices[iloop] : iloop;
+    
     AliVCluster * calo = dynamic_cast<AliVCluster *>(plNe->At(ipr)) ;
     
     if ( calo )
@@ -580,13 +598,27 @@ void AliIsolationCut::CalculateTrackSignalInCone
   
   TObjArray * reftracks  = 0x0;
   Int_t       ntrackrefs = 0;
+  
+  // Restrict the loop to the tracks in grid cells intersecting the cone
+  // when nothing out of the cone is needed
+  //
+  Int_t  nLoop   = plCTS->GetEntries();
+  Bool_t useGrid = ( fUseConeGrid && !bgTrk && !useRefs && fICMethod < kSumBkgSubIC &&
+                    !(fFillHistograms && fFillEtaPhiHistograms) );
+  if ( useGrid )
+  {
+    FillTrackGrid(reader);
+    nLoop = fTrackGrid.GetIndicesInCone(etaTrig, phiTrig, fConeSize, fGridIndices);
+  }
     
   //-----------------------------------------------------------
   // Get the tracks in cone
   //
   //-----------------------------------------------------------
-  for(Int_t ipr = 0;ipr < plCTS->GetEntries() ; ipr ++ )
+  for(Int_t iloop = 0; iloop < nLoop ; iloop ++ )
   {
+    Int_t ipr = useGrid ? fGridIndices[iloop] : iloop;
+    
     AliVTrack* track = dynamic_cast<AliVTrack*>(plCTS->At(ipr)) ;
     
     if(track)
@@ -912,6 +944,198 @@ void AliIsolationCut::CalculateTrackSignalInCone
   if ( bFillAOD && reftracks ) pCandidate->AddObjArray(reftracks);  
 }
 
+//_________________________________________________________________________________________________________________________________
+/// Fill the eta-phi grid with the reader tracks, done once per event.
+/// The grid is used to get only the tracks close to the candidate
+/// and the cone and UE band sums for several radii.
+///
+/// \param reader: pointer to AliCaloTrackReader. Needed to access event info.
+//_________________________________________________________________________________________________________________________________
+void AliIsolationCut::FillTrackGrid(AliCaloTrackReader * reader)
+{
+  if ( fTrackGridEvent == reader->GetEventNumber() && fTrackGrid.IsBuilt() ) return ;
+  
+  fTrackGridEvent = reader->GetEventNumber();
+  
+  fTrackGrid.SetNCells(fConeGridNEta, fConeGridNPhi);
+  fTrackGrid.SetCountPtThresholds(fPtThreshold, fPtThresholdMax);
+  fTrackGrid.Clear();
+  
+  TObjArray * plCTS = reader->GetCTSTracks();
+  
+  for(Int_t ipr = 0; plCTS && ipr < plCTS->GetEntries() ; ipr ++ )
+  {
+    AliVTrack* track = dynamic_cast<AliVTrack*>(plCTS->At(ipr)) ;
+    
+    if ( !track ) continue ;
+    
+    fTrackVector.SetXYZ(track->Px(),track->Py(),track->Pz());
+    
+    fTrackGrid.Add(fTrackVector.Pt(), fTrackVector.Eta(), fTrackVector.Phi(), 
+                   ipr, reader->GetTrackID(track));
+  }
+  
+  fTrackGrid.Build();
+}
+
+//_________________________________________________________________________________________________________________________________
+/// Fill the eta-phi grid with the reader clusters, done once per event.
+/// Clusters matched with tracks are not added in case of neutral+charged analysis
+/// and the rejection is requested.
+///
+/// \param reader: pointer to AliCaloTrackReader. Needed to access event info.
+/// \param calorimeter: Which input trigger calorimeter used
+/// \param pid: pointer to AliCaloPID. Needed to reject matched clusters in isolation cone.
+//_________________________________________________________________________________________________________________________________
+void AliIsolationCut::FillClusterGrid(AliCaloTrackReader * reader, Int_t calorimeter, AliCaloPID * pid)
+{
+  if ( fClusterGridEvent == reader->GetEventNumber() && 
+       fClusterGridCalo  == calorimeter && fClusterGrid.IsBuilt() ) return ;
+  
+  fClusterGridEvent = reader->GetEventNumber();
+  fClusterGridCalo  = calorimeter;
+  
+  fClusterGrid.SetNCells(fConeGridNEta, fConeGridNPhi);
+  fClusterGrid.SetCountPtThresholds(fPtThreshold, fPtThresholdMax);
+  fClusterGrid.Clear();
+  
+  TObjArray * plNe = 0x0;
+  if      (calorimeter == AliFiducialCut::kPHOS )
+    plNe = reader->GetPHOSClusters();
+  else if (calorimeter == AliFiducialCut::kEMCAL)
+    plNe = reader->GetEMCALClusters();
+  
+  for(Int_t ipr = 0; plNe && ipr < plNe->GetEntries() ; ipr ++ )
+  {
+    AliVCluster * calo = dynamic_cast<AliVCluster *>(plNe->At(ipr)) ;
+    
+    if ( !calo ) continue ;
+    
+    // Get the index where the cluster comes, to retrieve the corresponding vertex
+    Int_t evtIndex = 0 ;
+    if ( reader->GetMixedEvent() )
+      evtIndex=reader->GetMixedEvent()->EventIndexForCaloCluster(calo->GetID()) ;
+    
+    // Skip matched clusters with tracks in case of neutral+charged analysis
+    if ( fIsTMClusterInConeRejected && fPartInCone == kNeutralAndCharged && pid )
+    {
+      Bool_t bRes = kFALSE, bEoP = kFALSE;
+      Bool_t matched = pid->IsTrackMatched(calo, reader->GetCaloUtils(), 
+                                           reader->GetInputEvent(),
+                                           bEoP,bRes);
+      if ( matched ) continue ;
+    }
+    
+    // Assume that come from vertex in straight line
+    calo->GetMomentum(fMomentum,reader->GetVertex(evtIndex)) ;
+    
+    fClusterGrid.Add(fMomentum.Pt(), fMomentum.Eta(), fMomentum.Phi(), ipr, calo->GetID());
+  }
+  
+  fClusterGrid.Build();
+}
+
+//_________________________________________________________________________________________________________________________________
+/// Get the pt sum, leading pT and number of particles above threshold of tracks and clusters
+/// in cones of several radii, and the pT sum in the UE eta and phi bands of each radius,
+/// in one pass over the eta-phi grids of the event.
+/// The candidate daughters and the particles closer than fDistMinToTrigger are not counted,
+/// as in CalculateTrackSignalInCone() and CalculateCaloSignalInCone(). No histogram is filled.
+/// Any output array can be null, otherwise it must hold nRadii entries.
+/// The grid of a particle type is not filled if none of its outputs is requested.
+///
+/// \param pCandidate: Kinematics and + of candidate particle for isolation.
+/// \param reader: pointer to AliCaloTrackReader. Needed to access event info.
+/// \param calorimeter: Which input trigger calorimeter used
+/// \param pid: pointer to AliCaloPID. Needed to reject matched clusters in isolation cone.
+/// \param nRadii: number of cone radii.
+/// \param radii: cone radii.
+/// \param coneptsumTrack: total track momentum in cone, output.
+/// \param coneptLeadTrack: momentum of leading track in cone, output.
+/// \param nPartTrack: number of tracks above threshold in cone, output.
+/// \param coneptsumClust: total cluster momentum in cone, output.
+/// \param coneptLeadCluster: momentum of leading cluster in cone, output.
+/// \param nPartCluster: number of clusters above threshold in cone, output.
+/// \param etaBandPtSumTrack: track momentum in eta band, output.
+/// \param phiBandPtSumTrack: track momentum in phi band, output.
+/// \param etaBandPtSumCluster: cluster momentum in eta band, output.
+/// \param phiBandPtSumCluster: cluster momentum in phi band, output.
+//_________________________________________________________________________________________________________________________________
+void AliIsolationCut::CalculateSignalInConeForRadii
+(
+ AliCaloTrackParticleCorrelation * pCandidate, AliCaloTrackReader * reader,
+ Int_t     calorimeter   , AliCaloPID * pid,
+ Int_t     nRadii        , const Float_t * radii,
+ Float_t * coneptsumTrack, Float_t * coneptLeadTrack  , Int_t * nPartTrack,
+ Float_t * coneptsumClust, Float_t * coneptLeadCluster, Int_t * nPartCluster,
+ Float_t * etaBandPtSumTrack  , Float_t * phiBandPtSumTrack,
+ Float_t * etaBandPtSumCluster, Float_t * phiBandPtSumCluster
+)
+{
+  Float_t phiC  = pCandidate->Phi() ;
+  if ( phiC < 0 ) phiC+=TMath::TwoPi();
+  Float_t etaC  = pCandidate->Eta() ;
+  
+  // Reset, in case one of the particle types is not used
+  for(Int_t ir = 0; ir < nRadii; ir++)
+  {
+    if ( coneptsumTrack      ) coneptsumTrack     [ir] = 0;
+    if ( coneptLeadTrack     ) coneptLeadTrack    [ir] = 0;
+    if ( nPartTrack          ) nPartTrack         [ir] = 0;
+    if ( coneptsumClust      ) coneptsumClust     [ir] = 0;
+    if ( coneptLeadCluster   ) coneptLeadCluster  [ir] = 0;
+    if ( nPartCluster        ) nPartCluster       [ir] = 0;
+    if ( etaBandPtSumTrack   ) etaBandPtSumTrack  [ir] = 0;
+    if ( phiBandPtSumTrack   ) phiBandPtSumTrack  [ir] = 0;
+    if ( etaBandPtSumCluster ) etaBandPtSumCluster[ir] = 0;
+    if ( phiBandPtSumCluster ) phiBandPtSumCluster[ir] = 0;
+  }
+  
+  // Tracks
+  //
+  if ( fPartInCone != kOnlyNeutral && 
+       ( coneptsumTrack || coneptLeadTrack || nPartTrack || etaBandPtSumTrack || phiBandPtSumTrack ) ) 
+  {
+    FillTrackGrid(reader);
+    
+    // Do not count the candidate or its daughters
+    Int_t excluded[4] = { -1, -1, -1, -1 };
+    Int_t nExcluded   = 0;
+    if ( pCandidate->GetDetectorTag() == AliFiducialCut::kCTS ) 
+    {
+      for(Int_t i = 0; i < 4; i++) excluded[i] = pCandidate->GetTrackLabel(i);
+      nExcluded = 4;
+    }
+    
+    fTrackGrid.ConeSums(etaC, phiC, nRadii, radii, fDistMinToTrigger, excluded, nExcluded,
+                        coneptsumTrack, coneptLeadTrack, nPartTrack);
+    
+    if ( etaBandPtSumTrack || phiBandPtSumTrack )
+      fTrackGrid.BandSums(etaC, phiC, nRadii, radii, fConeSizeBandGap, fUEBandRectangularExclusion,
+                          fDistMinToTrigger, excluded, nExcluded,
+                          etaBandPtSumTrack, phiBandPtSumTrack);
+  }
+  
+  // Clusters
+  //
+  if ( fPartInCone != kOnlyCharged && 
+       ( coneptsumClust || coneptLeadCluster || nPartCluster || etaBandPtSumCluster || phiBandPtSumCluster ) ) 
+  {
+    FillClusterGrid(reader, calorimeter, pid);
+    
+    // Do not count the candidate or its daughters
+    Int_t excluded[2] = { pCandidate->GetCaloLabel(0), pCandidate->GetCaloLabel(1) };
+    
+    fClusterGrid.ConeSums(etaC, phiC, nRadii, radii, fDistMinToTrigger, excluded, 2,
+                          coneptsumClust, coneptLeadCluster, nPartCluster);
+    
+    if ( etaBandPtSumCluster || phiBandPtSumCluster )
+      fClusterGrid.BandSums(etaC, phiC, nRadii, radii, fConeSizeBandGap, fUEBandRectangularExclusion,
+                            fDistMinToTrigger, excluded, 2,
+                            etaBandPtSumCluster, phiBandPtSumCluster);
+  }
+}
+
 //_________________________________________________________________________________________________________________________________
 /// Get normalization of cluster background band.
 //_________________________________________________________________________________________________________________________________
@@ -2521,6 +2745,8 @@ TString AliIsolationCut::GetICParametersList()
   parList+=onePar ;
   snprintf(onePar,buffersize,"fMakeConeExcessCorr=%d;",fMakeConeExcessCorr) ;
   parList+=onePar ;
+  snprintf(onePar,buffersize,"fUseConeGrid=%d, cells %dx%d;",fUseConeGrid,fConeGridNEta,fConeGridNPhi) ;
+  parList+=onePar ;
   snprintf(onePar,buffersize,"fNeutralOverChargedRatio={%1.2e,%1.2e,%1.2e,%1.2e};",
            fNeutralOverChargedRatio[0],fNeutralOverChargedRatio[1],fNeutralOverChargedRatio[2],fNeutralOverChargedRatio[3]) ;
   parList+=onePar ;
@@ -3128,6 +3354,7 @@ void AliIsolationCut::Print(const Option_t * opt) const
   printf("using fraction for high pt leading instead of frac ? %i\n",fFracIsThresh);
   printf("minimum distance to candidate, R>%1.2f\n",fDistMinToTrigger);
   printf("correct cone excess = %d \n",fMakeConeExcessCorr);
+  printf("eta-phi grid for cone = %d, cells %d x %d \n",fUseConeGrid,fConeGridNEta,fConeGridNPhi);
   printf("NeutralOverChargedRatio param={%1.2e,%1.2e,%1.2e,%1.2e} \n",
   fNeutralOverChargedRatio[0],fNeutralOverChargedRatio[1],fNeutralOverChargedRatio[2],fNeutralOverChargedRatio[3]) ;
   printf("    \n") ;
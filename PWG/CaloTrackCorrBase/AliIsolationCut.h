@@ -24,8 +24,11 @@ class TObjArray ;
 class TList ;
 class TH3F ;
 #include <TLorentzVector.h>
+#include <TArrayI.h>
 
 // --- ANALYSIS system ---
+#include "AliIsolationConeGrid.h"
+
 class AliCaloTrackParticleCorrelation ;
 class AliCaloTrackReader ;
 class AliCaloPID ;
@@ -100,6 +103,20 @@ class AliIsolationCut : public TObject {
                                         Float_t & etaBandPtSum, Float_t & phiBandPtSum, 
                                         Float_t & perpBandPtSum,
                                         Double_t  histoWeight=1,Float_t centrality = -1) ;
+
+  void       CalculateSignalInConeForRadii(AliCaloTrackParticleCorrelation * pCandidate, AliCaloTrackReader * reader,
+                                           Int_t     calorimeter   , AliCaloPID * pid,
+                                           Int_t     nRadii        , const Float_t * radii,
+                                           Float_t * coneptsumTrack, Float_t * coneptLeadTrack  , Int_t * nPartTrack,
+                                           Float_t * coneptsumClust, Float_t * coneptLeadCluster, Int_t * nPartCluster,
+                                           Float_t * etaBandPtSumTrack  , Float_t * phiBandPtSumTrack,
+                                           Float_t * etaBandPtSumCluster, Float_t * phiBandPtSumCluster) ;
+
+  // Eta-phi grid of tracks and clusters, filled once per event
+
+  void       FillTrackGrid  (AliCaloTrackReader * reader) ;
+
+  void       FillClusterGrid(AliCaloTrackReader * reader, Int_t calorimeter, AliCaloPID * pid) ;
   
   // Cone background studies medthods
 
@@ -199,6 +216,11 @@ class AliIsolationCut : public TObject {
   void       SwitchOnConeFillExcessCorrHisto ()                { fFillFractionExcessHistograms = kTRUE  ; }
   void       SwitchOffConeFillExcessCorrHisto()                { fFillFractionExcessHistograms = kFALSE ; }
 
+  void       SwitchOnConeGrid ()                               { fUseConeGrid = kTRUE  ; }
+  void       SwitchOffConeGrid()                               { fUseConeGrid = kFALSE ; }
+  Bool_t     IsConeGridUsed()         const { return fUseConeGrid    ; }
+  void       SetConeGridNCells(Int_t nEta, Int_t nPhi)         { fConeGridNEta = nEta ; fConeGridNPhi = nPhi ; }
+
  private:
 
   Bool_t     fFillHistograms;                          ///< Fill histograms if GetCreateOuputObjects() was called. 
@@ -252,6 +274,16 @@ class AliIsolationCut : public TObject {
   Float_t    fEMCPhiMax;                               ///< Maximum Phi limit of Calo
   Float_t    fTPCEtaSize;                              ///< Eta size of TPC
   Float_t    fTPCPhiSize;                              ///< Phi size of TPC, it is 360 degrees, but here set to half.
+
+  Bool_t     fUseConeGrid;                             ///< Get particles in cone from eta-phi grid filled once per event.
+  Int_t      fConeGridNEta;                            ///< Number of grid cells in eta.
+  Int_t      fConeGridNPhi;                            ///< Number of grid cells in phi.
+  AliIsolationConeGrid fTrackGrid;                     //!<! Eta-phi grid of tracks.
+  AliIsolationConeGrid fClusterGrid;                   //!<! Eta-phi grid of clusters.
+  Int_t      fTrackGridEvent;                          //!<! Event number of tracks in grid.
+  Int_t      fClusterGridEvent;                        //!<! Event number of clusters in grid.
+  Int_t      fClusterGridCalo;                         //!<! Calorimeter of clusters in grid.
+  TArrayI    fGridIndices;                             //!<! Indices of particles in cells intersecting the cone, temporal array.
   
   // Histograms
   
@@ -390,7 +422,7 @@ class AliIsolationCut : public TObject {
   AliIsolationCut & operator = (const AliIsolationCut & g) ; 
 
   /// \cond CLASSIMP
-  ClassDef(AliIsolationCut,17) ;
+  ClassDef(AliIsolationCut,18) ;
   /// \endcond
 
 } ;
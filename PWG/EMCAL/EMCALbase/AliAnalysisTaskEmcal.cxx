@@ -40,6 +40,7 @@
 #include <TKey.h>
 
 #include "AliAnalysisTaskEmcal.h"
+#include "AliAnalysisReentrantTask.h"
 #include "AliAnalysisUtils.h"
 #include "AliAODEvent.h"
 #include "AliAODMCHeader.h"
@@ -390,7 +391,9 @@ void AliAnalysisTaskEmcal::UserCreateOutputObjects()
       AliError("Event handler not found!");
     }
   }
-  else {
+  else if (!dynamic_cast<AliAnalysisReentrantTask *>(this)) {
+    // Re-entrant tasks also run without analysis manager in AliAnalysisThreadedEventLoop,
+    // they take the input type from the event given with SetThreadInput
     AliError("Analysis manager not found!");
   }  
 
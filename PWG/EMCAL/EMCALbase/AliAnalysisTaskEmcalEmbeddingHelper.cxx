@@ -35,6 +35,9 @@
 #include <TH1F.h>
 #include <TRandom3.h>
 #include <TList.h>
+#include <TEnv.h>
+#include <TBranch.h>
+#include <TObjArray.h>
 
 #include <AliLog.h>
 #include <AliAnalysisManager.h>
@@ -173,7 +176,17 @@ AliAnalysisTaskEmcalEmbeddingHelper::AliAnalysisTaskEmcalEmbeddingHelper() :
   fPythiaCrossSectionFromFile(0.),
   fPythiaPtHard(0.),
   fPrintTimingInfoToLog(false),
-  fTimer()
+  fTimer(),
+  fNFilesToPrefetch(1),
+  fTreeCacheSize(-1),
+  fAsyncPrefetching(false),
+  fPreselectOnMCHeader(false),
+  fLastPrefetchedFile(-1),
+  fMCHeaderBranch(nullptr),
+  fWaitTimer(),
+  fWaitTime(0.),
+  fNEventsWaited(0),
+  fNPreselectionRejected(0)
 {
   if (fgInstance != nullptr) {
     AliError("An instance of AliAnalysisTaskEmcalEmbeddingHelper already exists: it will be deleted!!!");
@@ -250,7 +263,17 @@ AliAnalysisTaskEmcalEmbeddingHelper::AliAnalysisTaskEmcalEmbeddingHelper(const c
   fPythiaCrossSectionFromFile(0.),
   fPythiaPtHard(0.),
   fPrintTimingInfoToLog(false),
-  fTimer()
+  fTimer(),
+  fNFilesToPrefetch(1),
+  fTreeCacheSize(-1),
+  fAsyncPrefetching(false),
+  fPreselectOnMCHeader(false),
+  fLastPrefetchedFile(-1),
+  fMCHeaderBranch(nullptr),
+  fWaitTimer(),
+  fWaitTime(0.),
+  fNEventsWaited(0),
+  fNPreselectionRejected(0)
 {
   if (fgInstance != 0) {
     AliError("An instance of AliAnalysisTaskEmcalEmbeddingHelper already exists: it will be deleted!!!");
@@ -336,6 +359,11 @@ void AliAnalysisTaskEmcalEmbeddingHelper::RetrieveTaskPropertiesFromYAMLConfig()
   res = fYAMLConfig.GetProperty("randomFileAccess", fRandomFileAccess, false);
   res = fYAMLConfig.GetProperty("createHisto", fCreateHisto, false);
   res = fYAMLConfig.GetProperty("printTimingInfoInLog", fPrintTimingInfoToLog, false);
+  // Prefetching of the embedded input
+  res = fYAMLConfig.GetProperty("nFilesToPrefetch", fNFilesToPrefetch, false);
+  res = fYAMLConfig.GetProperty("treeCacheSize", fTreeCacheSize, false);
+  res = fYAMLConfig.GetProperty("asyncPrefetching", fAsyncPrefetching, false);
+  res = fYAMLConfig.GetProperty("preselectOnMCHeader", fPreselectOnMCHeader, false);
   // More general embedding helper properties
   res = fYAMLConfig.GetProperty("filePattern", fFilePattern, false);
   res = fYAMLConfig.GetProperty("inputFilename", fInputFilename, false);
@@ -904,6 +932,7 @@ void AliAnalysisTaskEmcalEmbeddingHelper::DetermineFirstFileToEmbed()
 Bool_t AliAnalysisTaskEmcalEmbeddingHelper::GetNextEntry()
 {
   Int_t attempts = -1;
+  Bool_t preselected = kTRUE;
 
   do {
     // Reset to start of tree
@@ -929,10 +958,7 @@ Bool_t AliAnalysisTaskEmcalEmbeddingHelper::GetNextEntry()
 
     // Load current event
     // Can be a simple less than, because fFileNumber counts from 0.
-    if (fFileNumber < fMaxNumberOfFiles) {
-      fChain->GetEntry(fCurrentEntry);
-    }
-    else {
+    if (fFileNumber >= fMaxNumberOfFiles) {
       AliError("====================================================================================================");
       AliError("== No more files available to embed from the TChain! Restarting from the beginning of the TChain! ==");
       AliError("== Be careful to check that this is the desired action!                                           ==");
@@ -942,18 +968,22 @@ Bool_t AliAnalysisTaskEmcalEmbeddingHelper::GetNextEntry()
       // fCurrentEntry and fLowerEntry are automatically reset in InitTree()
       fFileNumber = 0;
       fUpperEntry = 0;
+      fLastPrefetchedFile = -1;
 
       // Re-init back to the start
+      // We are certain that fFileNumber is less than fMaxNumberOfFiles, so we are resetting to start
       InitTree();
+    }
 
-      // Access the relevant entry
-      // We are certain that fFileNumber is less than fMaxNumberOfFiles, so we are resetting to start
+    // Check the event on the MC header first if requested. If rejected, the full event is not read.
+    preselected = PreselectEntry(fCurrentEntry);
+    if (preselected) {
       fChain->GetEntry(fCurrentEntry);
-    }
-    AliDebug(4, TString::Format("Loading entry %i between %i-%i, starting with offset %i from the lower bound of %i", fCurrentEntry, fLowerEntry, fUpperEntry, fOffset, fLowerEntry));
+      AliDebug(4, TString::Format("Loading entry %i between %i-%i, starting with offset %i from the lower bound of %i", fCurrentEntry, fLowerEntry, fUpperEntry, fOffset, fLowerEntry));
 
-    // Set relevant event properties
-    SetEmbeddedEventProperties();
+      // Set relevant event properties
+      SetEmbeddedEventProperties();
+    }
 
     // Increment current entry
     fCurrentEntry++;
@@ -968,7 +998,7 @@ Bool_t AliAnalysisTaskEmcalEmbeddingHelper::GetNextEntry()
       RecordEmbeddedEventProperties();
     }
 
-  } while (!IsEventSelected());
+  } while (!preselected || !IsEventSelected());
 
   if (fCreateHisto) {
     fHistManager.FillTH1("fHistEventCount", "Accepted");
@@ -980,6 +1010,61 @@ Bool_t AliAnalysisTaskEmcalEmbeddingHelper::GetNextEntry()
   return kTRUE;
 }
 
+/**
+ * Apply the pt hard rejection (see IsPtHardValid() and IsPtHardOutlier()) to an entry by reading only the
+ * MC header branch. Only available for AODs, when enabled with SetPreselectOnMCHeader().
+ *
+ * @param entry Entry in the TChain. It must belong to the current tree.
+ *
+ * @return kTRUE if the entry should be read and passed to the full event selection.
+ */
+Bool_t AliAnalysisTaskEmcalEmbeddingHelper::PreselectEntry(Int_t entry)
+{
+  if (!fMCHeaderBranch) {
+    return kTRUE;
+  }
+
+  Long64_t localEntry = fChain->LoadTree(entry);
+  if (localEntry < 0 || fMCHeaderBranch->GetEntry(localEntry) <= 0) {
+    return kTRUE;
+  }
+
+  // Only the pythia properties are updated, since the rest of the event was not read
+  SetEmbeddedEventProperties();
+
+  if (IsPtHardValid() && !IsPtHardOutlier()) {
+    return kTRUE;
+  }
+
+  fNPreselectionRejected++;
+  if (fCreateHisto) {
+    fHistManager.FillTH1("fHistEventCount", "Rejected");
+  }
+  return kFALSE;
+}
+
+/**
+ * Open the next files of the TChain asynchronously, so that they are available when the TChain
+ * switches to them. TFile::Open(), which is called by the TChain, picks up the pending request
+ * for the same file.
+ */
+void AliAnalysisTaskEmcalEmbeddingHelper::PrefetchNextFiles()
+{
+  if (fNFilesToPrefetch <= 0 || !fChain) {
+    return;
+  }
+
+  TObjArray * files = fChain->GetListOfFiles();
+  Int_t currentFile = fChain->GetTreeNumber();
+  Int_t lastFile = std::min(currentFile + fNFilesToPrefetch, files->GetEntriesFast() - 1);
+  for (Int_t iFile = std::max(fLastPrefetchedFile, currentFile) + 1; iFile <= lastFile; iFile++)
+  {
+    AliDebugStream(3) << "Opening file \"" << files->At(iFile)->GetTitle() << "\" asynchronously.\n";
+    TFile::AsyncOpen(files->At(iFile)->GetTitle());
+    fLastPrefetchedFile = iFile;
+  }
+}
+
 /**
  * Set some properties of the event that are not immediately available from the external event to make them
  * available to user tasks.
@@ -1066,14 +1151,7 @@ Bool_t AliAnalysisTaskEmcalEmbeddingHelper::IsEventSelected()
 Bool_t AliAnalysisTaskEmcalEmbeddingHelper::CheckIsEmbeddedEventSelected()
 {
   // Check if pt hard bin is 0, indicating a problem with the event or the grid.
-  // In such a case, the event should be rejected.
-  // This condition should only be applied if we have a valid pythia header.
-  // (pt hard should still be set even if the production wasn't done in pt hard bins).
-  if (fPythiaPtHard == 0. && fPythiaHeader) {
-    AliDebugStream(3) << "Event rejected due to pt hard = 0, indicating a problem with the external event.\n";
-    if (fCreateHisto) {
-      fHistManager.FillTH1("fHistEmbeddedEventRejection", "PtHardIs0", 1);
-    }
+  if (!IsPtHardValid()) {
     return kFALSE;
   }
 
@@ -1136,6 +1214,41 @@ Bool_t AliAnalysisTaskEmcalEmbeddingHelper::CheckIsEmbeddedEventSelected()
   }
 
   // Check for pt hard bin outliers
+  if (IsPtHardOutlier()) {
+    return kFALSE;
+  }
+
+  return kTRUE;
+}
+
+/**
+ * Check if pt hard bin is 0, indicating a problem with the event or the grid.
+ * In such a case, the event should be rejected.
+ * This condition should only be applied if we have a valid pythia header.
+ * (pt hard should still be set even if the production wasn't done in pt hard bins).
+ *
+ * @return kFALSE if the event should be rejected.
+ */
+Bool_t AliAnalysisTaskEmcalEmbeddingHelper::IsPtHardValid()
+{
+  if (fPythiaPtHard == 0. && fPythiaHeader) {
+    AliDebugStream(3) << "Event rejected due to pt hard = 0, indicating a problem with the external event.\n";
+    if (fCreateHisto) {
+      fHistManager.FillTH1("fHistEmbeddedEventRejection", "PtHardIs0", 1);
+    }
+    return kFALSE;
+  }
+
+  return kTRUE;
+}
+
+/**
+ * Check for pt hard bin outliers, if MC outlier rejection is enabled.
+ *
+ * @return kTRUE if the event is an outlier and should be rejected.
+ */
+Bool_t AliAnalysisTaskEmcalEmbeddingHelper::IsPtHardOutlier()
+{
   if (fPythiaHeader && fMCRejectOutliers)
   {
     // Pythia jet / pT-hard > factor
@@ -1161,13 +1274,13 @@ Bool_t AliAnalysisTaskEmcalEmbeddingHelper::CheckIsEmbeddedEventSelected()
         if (jet.Pt() > fPtHardJetPtRejectionFactor * fPythiaPtHard) {
           AliDebugStream(3) << "Event rejected because of MC outlier removal. Pythia header jet with: pT Hard " << fPythiaPtHard << ", pycell jet pT " << jet.Pt() << ", rejection factor " << fPtHardJetPtRejectionFactor << "\n";
           fHistManager.FillTH1("fHistEmbeddedEventRejection", "MCOutlier", 1);
-          return kFALSE;
+          return kTRUE;
         }
       }
     }
   }
 
-  return kTRUE;
+  return kFALSE;
 }
 
 /**
@@ -1330,6 +1443,11 @@ void AliAnalysisTaskEmcalEmbeddingHelper::UserCreateOutputObjects()
     histInternalEventCutsStats->GetYaxis()->SetTitle("Number of selected events");
   }
   
+  // Time spent waiting for the embedded input
+  histName = "fHistEmbeddedInputWaitTime";
+  histTitle = "Real time to retrieve the embedded event;t (ms);Counts";
+  fHistManager.CreateTH1(histName, histTitle, 1000, 0, 1000);
+
   // Time to execute InitTree()
   if (fPrintTimingInfoToLog) {
     histName = "fInitTreeCPUtime";
@@ -1419,6 +1537,14 @@ Bool_t AliAnalysisTaskEmcalEmbeddingHelper::SetupInputFiles()
   // Keep track of the total number of files in the TChain to ensure that we don't start repeating within the chain
   fMaxNumberOfFiles = fChain->GetListOfFiles()->GetEntries();
 
+  // Setup the read cache of the embedded chain. The prefetching setting must be set before the cache is created.
+  if (fAsyncPrefetching) {
+    gEnv->SetValue("TFile.AsyncPrefetching", 1);
+  }
+  if (fTreeCacheSize >= 0) {
+    fChain->SetCacheSize(fTreeCacheSize);
+  }
+
   if (fFilenames.size() > fMaxNumberOfFiles) {
     AliErrorStream() << "Number of input files (" << fFilenames.size() << ") is larger than the number of available files (" << fMaxNumberOfFiles << "). Something went wrong when adding some of those files to the TChain!\n";
   }
@@ -1542,6 +1668,19 @@ void AliAnalysisTaskEmcalEmbeddingHelper::InitTree()
   // next tree (in the next file) since entries are indexed starting from 0.
   fChain->GetEntry(fUpperEntry);
 
+  // The MC header branch of the new tree is needed for the preselection
+  fMCHeaderBranch = nullptr;
+  if (fPreselectOnMCHeader && fChain->GetTree()) {
+    fMCHeaderBranch = fChain->GetTree()->GetBranch(AliAODMCHeader::StdBranchName());
+    // Events which are not preselected only read the MC header, so the cache cannot learn the branches from them
+    if (fMCHeaderBranch && fTreeCacheSize != 0) {
+      fChain->AddBranchToCache("*", kTRUE);
+    }
+  }
+
+  // Open the next files while this one is used
+  PrefetchNextFiles();
+
   // Determine tree size and current entry
   // Set the limits of the new tree
   fLowerEntry = fUpperEntry;
@@ -1777,12 +1916,22 @@ void AliAnalysisTaskEmcalEmbeddingHelper::UserExec(Option_t*)
     }
   }
 
+  // Measure the time the analysis waits for the embedded input
+  fWaitTimer.Start(kTRUE);
+
   if (!fInitializedNewFile) {
     InitTree();
   }
 
   Bool_t res = GetNextEntry();
 
+  fWaitTimer.Stop();
+  fWaitTime += fWaitTimer.RealTime();
+  fNEventsWaited++;
+  if (fCreateHisto) {
+    fHistManager.FillTH1("fHistEmbeddedInputWaitTime", fWaitTimer.RealTime() * 1000.);
+  }
+
   if (!res) {
     AliError("Unable to get the event to embed. Nothing will be embedded.");
     return;
@@ -1863,6 +2012,24 @@ void AliAnalysisTaskEmcalEmbeddingHelper::Terminate(Option_t*)
 {
 }
 
+/**
+ * Report the time the job spent waiting for the embedded input.
+ */
+void AliAnalysisTaskEmcalEmbeddingHelper::FinishTaskOutput()
+{
+  if (fNEventsWaited == 0) {
+    return;
+  }
+
+  std::stringstream message;
+  message << "Waited " << fWaitTime << " s (real time) for the embedded input of " << fNEventsWaited
+          << " events (" << 1000. * fWaitTime / fNEventsWaited << " ms per event)";
+  if (fPreselectOnMCHeader) {
+    message << ", " << fNPreselectionRejected << " embedded events rejected on the MC header alone";
+  }
+  AliInfoStream() << message.str() << ".\n";
+}
+
 /**
  * Remove the dummy task which had to be added by ConfigureEmcalEmbeddingHelperOnLEGOTrain()
  * from the Analysis Manager. This is the same function as in AliEmcalCorrectionTask.
@@ -2007,6 +2174,10 @@ std::string AliAnalysisTaskEmcalEmbeddingHelper::toString(bool includeFileList)
   tempSS << "File list filename: \"" << fFileListFilename << "\"\n";
   tempSS << "Tree name: " << fTreeName << "\n";
   tempSS << "Print timing info to log: " << fPrintTimingInfoToLog << "\n";
+  tempSS << "Number of files to prefetch: " << fNFilesToPrefetch << "\n";
+  tempSS << "Tree cache size: " << fTreeCacheSize << "\n";
+  tempSS << "Asynchronous prefetching: " << fAsyncPrefetching << "\n";
+  tempSS << "Preselect on MC header: " << fPreselectOnMCHeader << "\n";
   tempSS << "Random event number access: " << fRandomEventNumberAccess << "\n";
   tempSS << "Random file access: " << fRandomFileAccess << "\n";
   tempSS << "Starting file index: " << fFilenameIndex << "\n";
@@ -19,6 +19,7 @@
 class TString;
 class TChain;
 class TFile;
+class TBranch;
 class AliVEvent;
 class AliMCEvent;
 class AliVHeader;
@@ -83,6 +84,7 @@ class AliAnalysisTaskEmcalEmbeddingHelper : public AliAnalysisTaskSE {
   void      UserExec(Option_t *option)                           ;
   void      UserCreateOutputObjects()                            ;
   void      Terminate(Option_t *option)                          ;
+  void      FinishTaskOutput()                                   ;
   /* @} */
 
   static const AliAnalysisTaskEmcalEmbeddingHelper* GetInstance() { return fgInstance       ; }
@@ -211,6 +213,34 @@ class AliAnalysisTaskEmcalEmbeddingHelper : public AliAnalysisTaskSE {
   void SetMaxVertexDistance(Double_t distance)                    { fMaxVertexDist = distance; }
   /* @} */
 
+  /**
+   * @{
+   * @name Prefetching of the embedded input
+   * @brief Reduce the time the analysis waits for the embedded input when switching files.
+   *
+   * The next files of the TChain can be opened asynchronously ahead of their use (TFile::AsyncOpen(),
+   * picked up by TFile::Open() when the TChain switches file). The baskets of the current file can be
+   * read by the TTreeCache in a background thread. For AODs, the pt hard rejection (pt hard = 0 and
+   * outlier rejection) can be applied on the MC header alone, so that events which are rejected
+   * anyway are not fully read. With the preselection, these rejections are counted before the
+   * physics and vertex selection in fHistEmbeddedEventRejection. The time spent waiting for the
+   * embedded input is recorded in fHistEmbeddedInputWaitTime and printed at the end of the job.
+   */
+  Int_t GetNFilesToPrefetch()                               const { return fNFilesToPrefetch; }
+  Long64_t GetTreeCacheSize()                               const { return fTreeCacheSize; }
+  bool GetAsyncPrefetching()                                const { return fAsyncPrefetching; }
+  bool GetPreselectOnMCHeader()                             const { return fPreselectOnMCHeader; }
+
+  /// Number of upcoming files in the chain to open asynchronously (0 disables)
+  void SetNFilesToPrefetch(Int_t n)                               { fNFilesToPrefetch = n; }
+  /// Size of the TTreeCache of the embedded chain in bytes (negative keeps the ROOT default)
+  void SetTreeCacheSize(Long64_t size)                            { fTreeCacheSize = size; }
+  /// Fetch the baskets of the TTreeCache in a background thread
+  void SetAsyncPrefetching(bool b = true)                         { fAsyncPrefetching = b; }
+  /// Apply the pt hard rejection on the MC header before reading the full embedded event (AOD only)
+  void SetPreselectOnMCHeader(bool b = true)                      { fPreselectOnMCHeader = b; }
+  /* @} */
+
   /**
    * @{
    * @name Properties of the embedded event
@@ -302,10 +332,14 @@ class AliAnalysisTaskEmcalEmbeddingHelper : public AliAnalysisTaskSE {
   Bool_t          SetupInputFiles()     ;
   std::string     ConstructFullPythiaXSecFilename(std::string inputFilename, const std::string & pythiaFilename, bool testIfExists) const;
   Bool_t          GetNextEntry()        ;
+  Bool_t          PreselectEntry(Int_t entry);
+  void            PrefetchNextFiles()   ;
   void            SetEmbeddedEventProperties();
   void            RecordEmbeddedEventProperties();
   Bool_t          IsEventSelected()     ;
   virtual Bool_t  CheckIsEmbeddedEventSelected();
+  Bool_t          IsPtHardValid()       ;
+  Bool_t          IsPtHardOutlier()     ;
   Bool_t          InitEvent()           ;
   void            InitTree()            ;
   bool            PythiaInfoFromCrossSectionFile(std::string filename);
@@ -387,6 +421,17 @@ class AliAnalysisTaskEmcalEmbeddingHelper : public AliAnalysisTaskSE {
   bool                                          fPrintTimingInfoToLog; ///< Flag to print time to execute InitTree(), for logging purposes
   TStopwatch                                    fTimer            ;    //!<! Timer for the InitTree() function
 
+  Int_t                                         fNFilesToPrefetch ; ///<  Number of upcoming files in the chain opened asynchronously
+  Long64_t                                      fTreeCacheSize    ; ///<  Size of the TTreeCache of the embedded chain (negative: ROOT default)
+  bool                                          fAsyncPrefetching ; ///<  If true, the TTreeCache fetches baskets in a background thread
+  bool                                       fPreselectOnMCHeader ; ///<  If true, apply the pt hard rejection on the MC header before reading the full event
+  Int_t                                       fLastPrefetchedFile ; //!<! Index in the chain of the last file requested asynchronously
+  TBranch                                      *fMCHeaderBranch   ; //!<! MC header branch of the current tree, used for the preselection
+  TStopwatch                                    fWaitTimer        ; //!<! Timer for the time spent waiting for the embedded input
+  Double_t                                      fWaitTime         ; //!<! Total real time spent waiting for the embedded input (s)
+  Long64_t                                      fNEventsWaited    ; //!<! Number of events for which the embedded input was retrieved
+  Long64_t                                      fNPreselectionRejected; //!<! Number of events rejected on the MC header alone
+
   static AliAnalysisTaskEmcalEmbeddingHelper   *fgInstance        ; //!<! Global instance of this class
 
  private:
@@ -394,7 +439,7 @@ class AliAnalysisTaskEmcalEmbeddingHelper : public AliAnalysisTaskSE {
   AliAnalysisTaskEmcalEmbeddingHelper &operator=(const AliAnalysisTaskEmcalEmbeddingHelper&); // not implemented
 
   /// \cond CLASSIMP
-  ClassDef(AliAnalysisTaskEmcalEmbeddingHelper, 14);
+  ClassDef(AliAnalysisTaskEmcalEmbeddingHelper, 15);
   /// \endcond
 };
 #endif
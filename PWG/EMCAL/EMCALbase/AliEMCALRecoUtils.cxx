@@ -395,6 +395,66 @@ AliEMCALRecoUtils::~AliEMCALRecoUtils()
 Bool_t AliEMCALRecoUtils::AcceptCalibrateCell(Int_t absID, Int_t bc,
                                               Float_t  & amp,    Double_t & time,
                                               AliVCaloCells* cells)
+{
+  Int_t imod = -1, iphi =-1, ieta=-1;
+
+  if ( !AcceptCell(absID, imod, ieta, iphi, amp, time) )
+    return kFALSE;
+
+  Bool_t isLowGain = !(cells->GetCellHighGain(absID));//HG = false -> LG = true
+
+  amp  = cells->GetCellAmplitude(absID);
+  time = cells->GetCellTime(absID);
+
+  CalibrateCell(absID, imod, ieta, iphi, bc, amp, time, isLowGain);
+
+  return kTRUE;
+}
+
+///
+/// Reject cell if acceptance criteria not passed (correct cell number, is it bad channel)
+/// and calibrate it in energy and time. Same as above, but the cell energy and time
+/// are given instead of being looked up in the list of cells, so that cells can be
+/// calibrated from a copy of their values.
+///
+/// \param absID: absolute cell ID number
+/// \param bc: bunch crossing number
+/// \param amp: input cell energy amplitude, output calibrated amplitude
+/// \param time: input cell time, output calibrated time
+/// \param isLowGain: low gain cell
+///
+/// \return bool quality of cell, exists or not
+///
+//_______________________________________________________________________________
+Bool_t AliEMCALRecoUtils::AcceptCalibrateCell(Int_t absID, Int_t bc,
+                                              Float_t  & amp,    Double_t & time,
+                                              Bool_t isLowGain)
+{
+  Int_t imod = -1, iphi =-1, ieta=-1;
+
+  if ( !AcceptCell(absID, imod, ieta, iphi, amp, time) )
+    return kFALSE;
+
+  CalibrateCell(absID, imod, ieta, iphi, bc, amp, time, isLowGain);
+
+  return kTRUE;
+}
+
+///
+/// Reject cell if acceptance criteria not passed (correct cell number, is it bad channel).
+///
+/// \param absID: absolute cell ID number
+/// \param imod: output super module number
+/// \param ieta: output column in super module
+/// \param iphi: output row in super module
+/// \param amp: set to 0 if the cell does not exist
+/// \param time: set to 1e9 if the cell does not exist
+///
+/// \return bool quality of cell, exists or not
+///
+//_______________________________________________________________________________
+Bool_t AliEMCALRecoUtils::AcceptCell(Int_t absID, Int_t & imod, Int_t & ieta, Int_t & iphi,
+                                     Float_t & amp, Double_t & time) const
 {
   AliEMCALGeometry* geom = AliEMCALGeometry::GetInstance();
 
@@ -406,7 +466,7 @@ Bool_t AliEMCALRecoUtils::AcceptCalibrateCell(Int_t absID, Int_t bc,
   if ( absID < 0 || absID >= 24*48*geom->GetNumberOfSuperModules() )
     return kFALSE;
 
-  Int_t imod = -1, iphi =-1, ieta=-1,iTower = -1, iIphi = -1, iIeta = -1, status=0;
+  Int_t iTower = -1, iIphi = -1, iIeta = -1, status=0;
 
   if (!geom->GetCellIndex(absID,imod,iTower,iIphi,iIeta)){
     // cell absID does not exist
@@ -430,10 +490,27 @@ Bool_t AliEMCALRecoUtils::AcceptCalibrateCell(Int_t absID, Int_t bc,
 
     if ( bad ) return kFALSE;
   }
-  Bool_t isLowGain = !(cells->GetCellHighGain(absID));//HG = false -> LG = true
 
+  return kTRUE;
+}
+
+///
+/// Calibrate an accepted cell in energy and time.
+///
+/// \param absID: absolute cell ID number
+/// \param imod: super module number
+/// \param ieta: column in super module
+/// \param iphi: row in super module
+/// \param bc: bunch crossing number
+/// \param amp: input cell energy amplitude, output calibrated amplitude
+/// \param time: input cell time, output calibrated time
+/// \param isLowGain: low gain cell
+///
+//_______________________________________________________________________________
+void AliEMCALRecoUtils::CalibrateCell(Int_t absID, Int_t imod, Int_t ieta, Int_t iphi, Int_t bc,
+                                      Float_t & amp, Double_t & time, Bool_t isLowGain)
+{
   //Recalibrate energy
-  amp  = cells->GetCellAmplitude(absID);
   if (!fCellsRecalibrated && IsRecalibrationOn()){
     // take out non lin from shaper for low gain cells
     if(fUseShaperNonlin && isLowGain){
@@ -453,8 +530,6 @@ Bool_t AliEMCALRecoUtils::AcceptCalibrateCell(Int_t absID, Int_t bc,
     }
   }
   // Recalibrate time
-  time = cells->GetCellTime(absID);
-
   if (IsTimeECorrectionOn()) 
     CorrectCellTimeVsE(amp, time, isLowGain);
   time-=fConstantTimeShift*1e-9; // only in case of old Run1 simulation
@@ -464,8 +539,6 @@ Bool_t AliEMCALRecoUtils::AcceptCalibrateCell(Int_t absID, Int_t bc,
 
   // Correct for cable length and other delays
   RecalibrateCellTime(absID,bc,time,isLowGain);
-
-  return kTRUE;
 }
 
 ///
@@ -2345,7 +2418,7 @@ void AliEMCALRecoUtils::RecalibrateClusterEnergy(const AliEMCALGeometry* geom,
 //_______________________________________________________________________
 void AliEMCALRecoUtils::RecalibrateCells(AliVCaloCells * cells, Int_t bc)
 {
-  if (!IsRecalibrationOn() && !IsTimeRecalibrationOn() && !IsL1PhaseInTimeRecalibrationOn() && !IsBadChannelsRemovalSwitchedOn() && !IsSingleChannelRecalibrationOn())
+  if (!IsCellRecalibrationOn())
     return;
 
   if (!cells)
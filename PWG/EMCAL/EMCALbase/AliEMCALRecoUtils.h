@@ -169,9 +169,14 @@ public:
   //-----------------------------------------------------
   Bool_t   AcceptCalibrateCell(Int_t absId, Int_t bc,
                                Float_t & amp, Double_t & time, AliVCaloCells* cells) ; // Energy and Time
+  Bool_t   AcceptCalibrateCell(Int_t absId, Int_t bc,
+                               Float_t & amp, Double_t & time, Bool_t isLowGain) ; // Energy and Time, from given cell values
   void     RecalibrateCells(AliVCaloCells * cells, Int_t bc) ; // Energy and Time
   void     RecalibrateClusterEnergy(const AliEMCALGeometry* geom, AliVCluster* cluster, AliVCaloCells * cells, Int_t bc=-1) ; // Energy and time
   void     ResetCellsCalibrated()                        { fCellsRecalibrated = kFALSE; }
+  void     SetCellsCalibrated()                          { fCellsRecalibrated = kTRUE ; }
+  Bool_t   IsCellRecalibrationOn()                 const { return IsRecalibrationOn() || IsTimeRecalibrationOn() || IsL1PhaseInTimeRecalibrationOn() 
+                                                                  || IsBadChannelsRemovalSwitchedOn() || IsSingleChannelRecalibrationOn() ; }
 
   // Energy recalibration
   Bool_t   IsRecalibrationOn()                     const { return fRecalibration ; }
@@ -572,6 +577,13 @@ public:
   void     RecalculateCellLabelsRemoveAddedGenerator( Int_t absID, AliVCluster* clus, AliMCEvent* mc,
                                                       Float_t & amp, TArrayI & labeArr, TArrayF & eDepArr ) const;
 private:  
+
+  // Cell acceptance and calibration steps of AcceptCalibrateCell
+  Bool_t     AcceptCell(Int_t absId, Int_t & imod, Int_t & ieta, Int_t & iphi,
+                        Float_t & amp, Double_t & time) const ;
+  void       CalibrateCell(Int_t absId, Int_t imod, Int_t ieta, Int_t iphi, Int_t bc,
+                           Float_t & amp, Double_t & time, Bool_t isLowGain) ;
+  
   
   // Position recalculation
   Float_t    fMisalTransShift[15];       ///< Cluster position translation shift parameters
@@ -7,6 +7,7 @@
 #include "AliEMCALRecoUtils.h"
 #include "AliAODEvent.h"
 
+#include "AliEmcalCorrectionCellBuffer.h"
 #include "AliEmcalCorrectionCellBadChannel.h"
 
 /// \cond CLASSIMP
@@ -92,6 +93,62 @@ void AliEmcalCorrectionCellBadChannel::UserCreateOutputObjects()
  * Called for each event to process the event data.
  */
 Bool_t AliEmcalCorrectionCellBadChannel::Run()
+{
+  if (!PrepareEvent())
+    return kFALSE;
+
+  if(fCreateHisto)
+    FillCellQA(fCellEnergyDistBefore); // "before" QA
+  
+  // CELL RECALIBRATION -------------------------------------------------------
+  // update cell objects
+  UpdateCells();
+  
+  if(fCreateHisto)
+    FillCellQA(fCellEnergyDistAfter); // "after" QA
+
+  return kTRUE;
+}
+
+/**
+ * Prepare the cell kernel for the current event. Same as Run(),
+ * with the cells updated one by one in ApplyCellKernel().
+ */
+Bool_t AliEmcalCorrectionCellBadChannel::PrepareCellKernel(AliEmcalCorrectionCellBuffer & cells)
+{
+  if (!PrepareEvent())
+    return kFALSE;
+
+  PrepareUpdateCells(cells);
+  return kTRUE;
+}
+
+/**
+ * Update a single cell of the buffer.
+ */
+void AliEmcalCorrectionCellBadChannel::ApplyCellKernel(AliEmcalCorrectionCellBuffer & cells, Int_t iCell)
+{
+  if(fCreateHisto)
+    fCellEnergyDistBefore->Fill(cells.GetAmplitude(iCell)); // "before" QA
+
+  UpdateCell(cells, iCell);
+
+  if(fCreateHisto)
+    fCellEnergyDistAfter->Fill(cells.GetAmplitude(iCell)); // "after" QA
+}
+
+/**
+ * Finish the cell kernel, after all cells were updated.
+ */
+void AliEmcalCorrectionCellBadChannel::FinishCellKernel()
+{
+  FinishUpdateCells();
+}
+
+/**
+ * Per event setup, common to Run() and the cell kernel.
+ */
+Bool_t AliEmcalCorrectionCellBadChannel::PrepareEvent()
 {
   AliEmcalCorrectionComponent::Run();
   
@@ -117,16 +174,6 @@ Bool_t AliEmcalCorrectionCellBadChannel::Run()
   // mark the cells not recalibrated
   fRecoUtils->ResetCellsCalibrated();
 
-  if(fCreateHisto)
-    FillCellQA(fCellEnergyDistBefore); // "before" QA
-  
-  // CELL RECALIBRATION -------------------------------------------------------
-  // update cell objects
-  UpdateCells();
-  
-  if(fCreateHisto)
-    FillCellQA(fCellEnergyDistAfter); // "after" QA
-
   return kTRUE;
 }
 
@@ -32,12 +32,19 @@ class AliEmcalCorrectionCellBadChannel : public AliEmcalCorrectionComponent {
   void UserCreateOutputObjects();
   Bool_t Run();
   Bool_t CheckIfRunChanged();
+
+  // Cell kernel, see AliEmcalCorrectionTask
+  Bool_t HasCellKernel() const { return kTRUE; }
+  Bool_t PrepareCellKernel(AliEmcalCorrectionCellBuffer & cells);
+  void ApplyCellKernel(AliEmcalCorrectionCellBuffer & cells, Int_t iCell);
+  void FinishCellKernel();
   
 protected:
   TH1F* fCellEnergyDistBefore;              //!<! cell energy distribution, before bad channel correction
   TH1F* fCellEnergyDistAfter;               //!<! cell energy distribution, after bad channel correction
   
 private:
+  Bool_t PrepareEvent();
 
   AliEmcalCorrectionCellBadChannel(const AliEmcalCorrectionCellBadChannel &);             // Not implemented
   AliEmcalCorrectionCellBadChannel &operator=(const AliEmcalCorrectionCellBadChannel &);   // Not implemented
@@ -0,0 +1,133 @@
+// AliEmcalCorrectionCellBuffer
+//
+
+#include <algorithm>
+#include <numeric>
+
+#include <AliVCaloCells.h>
+
+#include "AliEmcalCorrectionCellBuffer.h"
+
+/// \cond CLASSIMP
+ClassImp(AliEmcalCorrectionCellBuffer);
+/// \endcond
+
+/**
+ * Default constructor
+ */
+AliEmcalCorrectionCellBuffer::AliEmcalCorrectionCellBuffer():
+  fCells(nullptr),
+  fAbsId(),
+  fAmplitude(),
+  fTime(),
+  fMCLabel(),
+  fEFraction(),
+  fFlags(),
+  fSortOnStore(kFALSE)
+{
+}
+
+/**
+ * Copy the cells of a collection into the buffer. Memory is kept between events.
+ *
+ * @param[in] cells Cells collection
+ */
+void AliEmcalCorrectionCellBuffer::Load(AliVCaloCells * cells)
+{
+  Clear();
+  fCells = cells;
+  if (!cells) return;
+
+  const Int_t nCells = cells->GetNumberOfCells() > 0 ? cells->GetNumberOfCells() : 0;
+  fAbsId.resize(nCells);
+  fAmplitude.resize(nCells);
+  fTime.resize(nCells);
+  fMCLabel.resize(nCells);
+  fEFraction.resize(nCells);
+  fFlags.resize(nCells);
+
+  Short_t  absId  =-1;
+  Double_t ecell = 0;
+  Double_t tcell = 0;
+  Double_t efrac = 0;
+  Int_t  mclabel = -1;
+  for (Int_t iCell = 0; iCell < nCells; iCell++) {
+    cells->GetCell(iCell, absId, ecell, tcell, mclabel, efrac);
+    fAbsId[iCell] = absId;
+    fAmplitude[iCell] = ecell;
+    fTime[iCell] = tcell;
+    fMCLabel[iCell] = mclabel;
+    fEFraction[iCell] = efrac;
+    // NOTE: GetCellHighGain() uses the cell position, not cell index, and thus should _NOT_ be used!
+    fFlags[iCell] = cells->GetHighGain(iCell) ? kHighGain : 0;
+  }
+}
+
+/**
+ * Write the modified cells back into the cells collection they were loaded from.
+ * If requested, the collection is sorted afterwards, and the buffer is sorted in
+ * the same way so that it stays usable in place of the collection.
+ */
+void AliEmcalCorrectionCellBuffer::Store()
+{
+  if (!fCells) return;
+
+  const Int_t nCells = GetNumberOfCells();
+  for (Int_t iCell = 0; iCell < nCells; iCell++) {
+    if (!(fFlags[iCell] & kModified)) continue;
+    fCells->SetCell(iCell, fAbsId[iCell], fAmplitude[iCell], fTime[iCell], fMCLabel[iCell], fEFraction[iCell], fFlags[iCell] & kHighGain);
+    fFlags[iCell] &= ~kModified;
+  }
+
+  if (fSortOnStore) {
+    fCells->Sort();
+    SortByAbsId();
+  }
+}
+
+/**
+ * Sort the buffer by cell ID, as AliVCaloCells::Sort() does for the collection.
+ */
+void AliEmcalCorrectionCellBuffer::SortByAbsId()
+{
+  if (std::is_sorted(fAbsId.begin(), fAbsId.end())) return;
+
+  const Int_t nCells = GetNumberOfCells();
+  std::vector<Int_t> order(nCells);
+  std::iota(order.begin(), order.end(), 0);
+  std::stable_sort(order.begin(), order.end(), [this](Int_t a, Int_t b) { return fAbsId[a] < fAbsId[b]; });
+
+  std::vector<Short_t> absId(nCells);
+  std::vector<Double_t> amplitude(nCells), time(nCells), efrac(nCells);
+  std::vector<Int_t> mclabel(nCells);
+  std::vector<UChar_t> flags(nCells);
+  for (Int_t iCell = 0; iCell < nCells; iCell++) {
+    absId[iCell] = fAbsId[order[iCell]];
+    amplitude[iCell] = fAmplitude[order[iCell]];
+    time[iCell] = fTime[order[iCell]];
+    mclabel[iCell] = fMCLabel[order[iCell]];
+    efrac[iCell] = fEFraction[order[iCell]];
+    flags[iCell] = fFlags[order[iCell]];
+  }
+  fAbsId.swap(absId);
+  fAmplitude.swap(amplitude);
+  fTime.swap(time);
+  fMCLabel.swap(mclabel);
+  fEFraction.swap(efrac);
+  fFlags.swap(flags);
+}
+
+/**
+ * Empty the buffer (memory is kept).
+ */
+void AliEmcalCorrectionCellBuffer::Clear()
+{
+  fCells = nullptr;
+  fAbsId.clear();
+  fAmplitude.clear();
+  fTime.clear();
+  fMCLabel.clear();
+  fEFraction.clear();
+  fFlags.clear();
+  fSortOnStore = kFALSE;
+}
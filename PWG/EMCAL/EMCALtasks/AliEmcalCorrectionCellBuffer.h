@@ -0,0 +1,81 @@
+#ifndef ALIEMCALCORRECTIONCELLBUFFER_H
+#define ALIEMCALCORRECTIONCELLBUFFER_H
+
+#include <vector>
+
+#include <Rtypes.h>
+
+class AliVCaloCells;
+
+/**
+ * @class AliEmcalCorrectionCellBuffer
+ * @ingroup EMCALCORRECTIONFW
+ * @brief Flat copy of a cells collection for the fused cell pass of the EMCal Correction Task
+ *
+ * The cells of an AliVCaloCells object are copied once per event into arrays of
+ * cell ID, energy, time, MC label, energy fraction and flags (structure of arrays).
+ * Cell components providing an element-wise kernel (see
+ * AliEmcalCorrectionComponent::HasCellKernel()) then correct the cells in the buffer
+ * in a single pass, and the result is written back once. As long as the cells
+ * collection is not modified afterwards, the buffer can be used in place of the
+ * collection, for example as input of the clusterizer.
+ *
+ * @date Oct 19 2026
+ */
+class AliEmcalCorrectionCellBuffer {
+ public:
+  /// Cell flags
+  enum CellFlag_t {
+    kHighGain = BIT(0),  ///< High gain cell
+    kModified = BIT(1)   ///< Cell modified in the buffer, to be written back
+  };
+
+  AliEmcalCorrectionCellBuffer();
+  virtual ~AliEmcalCorrectionCellBuffer() {}
+
+  void Load(AliVCaloCells * cells);
+  void Store();
+  void Clear();
+
+  /// Cells collection the buffer was loaded from
+  AliVCaloCells * GetCells() const { return fCells; }
+  /// Number of cells in the buffer
+  Int_t GetNumberOfCells() const { return fAbsId.size(); }
+
+  Short_t  GetAbsId(Int_t iCell)     const { return fAbsId[iCell]; }
+  Double_t GetAmplitude(Int_t iCell) const { return fAmplitude[iCell]; }
+  Double_t GetTime(Int_t iCell)      const { return fTime[iCell]; }
+  Int_t    GetMCLabel(Int_t iCell)   const { return fMCLabel[iCell]; }
+  Double_t GetEFraction(Int_t iCell) const { return fEFraction[iCell]; }
+  Bool_t   IsHighGain(Int_t iCell)   const { return fFlags[iCell] & kHighGain; }
+
+  /// Set the energy of a cell
+  void SetAmplitude(Int_t iCell, Double_t amp)            { fAmplitude[iCell] = amp; fFlags[iCell] |= kModified; }
+  /// Set the energy and time of a cell
+  void SetCell(Int_t iCell, Double_t amp, Double_t time)  { fAmplitude[iCell] = amp; fTime[iCell] = time; fFlags[iCell] |= kModified; }
+
+  /// Request the cells collection to be sorted when the buffer is written back (as done in AliEmcalCorrectionComponent::UpdateCells())
+  void SetSortOnStore(Bool_t b = kTRUE) { fSortOnStore = b; }
+
+ protected:
+  void SortByAbsId();
+
+  AliVCaloCells               *fCells;          //!<! Cells collection the buffer was loaded from
+  std::vector<Short_t>         fAbsId;          //!<! Cell absolute ID
+  std::vector<Double_t>        fAmplitude;      //!<! Cell energy
+  std::vector<Double_t>        fTime;           //!<! Cell time
+  std::vector<Int_t>           fMCLabel;        //!<! Cell MC label
+  std::vector<Double_t>        fEFraction;      //!<! Cell embedded energy fraction
+  std::vector<UChar_t>         fFlags;          //!<! Cell flags, see CellFlag_t
+  Bool_t                       fSortOnStore;    //!<! Sort the cells collection when writing back
+
+ private:
+  AliEmcalCorrectionCellBuffer(const AliEmcalCorrectionCellBuffer &);               // Not implemented
+  AliEmcalCorrectionCellBuffer &operator=(const AliEmcalCorrectionCellBuffer &);    // Not implemented
+
+  /// \cond CLASSIMP
+  ClassDef(AliEmcalCorrectionCellBuffer, 1); // EMCal correction cell buffer
+  /// \endcond
+};
+
+#endif /* ALIEMCALCORRECTIONCELLBUFFER_H */
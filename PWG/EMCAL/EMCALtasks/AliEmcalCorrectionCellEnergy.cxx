@@ -9,6 +9,7 @@
 #include "AliAODEvent.h"
 #include "AliDataFile.h"
 
+#include "AliEmcalCorrectionCellBuffer.h"
 #include "AliEmcalCorrectionCellEnergy.h"
 
 /// \cond CLASSIMP
@@ -98,6 +99,70 @@ void AliEmcalCorrectionCellEnergy::UserCreateOutputObjects()
  * Called for each event to process the event data.
  */
 Bool_t AliEmcalCorrectionCellEnergy::Run()
+{
+  if (!PrepareEvent())
+    return kFALSE;
+
+  if(fCreateHisto)
+    FillCellQA(fCellEnergyDistBefore); // "before" QA
+  
+  // CELL RECALIBRATION -------------------------------------------------------
+  // update cell objects
+  UpdateCells();
+  
+  if(fCreateHisto)
+    FillCellQA(fCellEnergyDistAfter); // "after" QA
+  
+  // switch off recalibrations so those are not done multiple times
+  // this is just for safety, the recalibrated flag of cell object
+  // should not allow for farther processing anyways
+  fRecoUtils->SwitchOffRecalibration();
+
+  return kTRUE;
+}
+
+/**
+ * Prepare the cell kernel for the current event. Same as Run(),
+ * with the cells updated one by one in ApplyCellKernel().
+ */
+Bool_t AliEmcalCorrectionCellEnergy::PrepareCellKernel(AliEmcalCorrectionCellBuffer & cells)
+{
+  if (!PrepareEvent())
+    return kFALSE;
+
+  PrepareUpdateCells(cells);
+  return kTRUE;
+}
+
+/**
+ * Update a single cell of the buffer.
+ */
+void AliEmcalCorrectionCellEnergy::ApplyCellKernel(AliEmcalCorrectionCellBuffer & cells, Int_t iCell)
+{
+  if(fCreateHisto)
+    fCellEnergyDistBefore->Fill(cells.GetAmplitude(iCell)); // "before" QA
+
+  UpdateCell(cells, iCell);
+
+  if(fCreateHisto)
+    fCellEnergyDistAfter->Fill(cells.GetAmplitude(iCell)); // "after" QA
+}
+
+/**
+ * Finish the cell kernel, after all cells were updated.
+ */
+void AliEmcalCorrectionCellEnergy::FinishCellKernel()
+{
+  FinishUpdateCells();
+
+  // switch off recalibrations so those are not done multiple times
+  fRecoUtils->SwitchOffRecalibration();
+}
+
+/**
+ * Per event setup, common to Run() and the cell kernel.
+ */
+Bool_t AliEmcalCorrectionCellEnergy::PrepareEvent()
 {
   AliEmcalCorrectionComponent::Run();
   
@@ -121,22 +186,6 @@ Bool_t AliEmcalCorrectionCellEnergy::Run()
   
   // mark the cells not recalibrated
   fRecoUtils->ResetCellsCalibrated();
-  
-  
-  if(fCreateHisto)
-    FillCellQA(fCellEnergyDistBefore); // "before" QA
-  
-  // CELL RECALIBRATION -------------------------------------------------------
-  // update cell objects
-  UpdateCells();
-  
-  if(fCreateHisto)
-    FillCellQA(fCellEnergyDistAfter); // "after" QA
-  
-  // switch off recalibrations so those are not done multiple times
-  // this is just for safety, the recalibrated flag of cell object
-  // should not allow for farther processing anyways
-  fRecoUtils->SwitchOffRecalibration();
 
   return kTRUE;
 }
@@ -32,12 +32,20 @@ class AliEmcalCorrectionCellEnergy : public AliEmcalCorrectionComponent {
   void UserCreateOutputObjects();
   Bool_t Run();
   Bool_t CheckIfRunChanged();
+
+  // Cell kernel, see AliEmcalCorrectionTask
+  Bool_t HasCellKernel() const { return kTRUE; }
+  Bool_t PrepareCellKernel(AliEmcalCorrectionCellBuffer & cells);
+  void ApplyCellKernel(AliEmcalCorrectionCellBuffer & cells, Int_t iCell);
+  void FinishCellKernel();
   
 protected:
   TH1F* fCellEnergyDistBefore;        //!<! cell energy distribution, before energy calibration
   TH1F* fCellEnergyDistAfter;         //!<! cell energy distribution, after energy calibration
 
 private:
+  Bool_t PrepareEvent();
+
   Int_t                  InitRecalib();
   Int_t                  InitRunDepRecalib();
   
@@ -4,6 +4,7 @@
 #include <TGrid.h>
 #include <TFile.h>
 
+#include "AliEmcalCorrectionCellBuffer.h"
 #include "AliEmcalCorrectionCellEnergyVariation.h"
 
 /// \cond CLASSIMP
@@ -124,6 +125,34 @@ Bool_t AliEmcalCorrectionCellEnergyVariation::Run()
   return kTRUE;
 }
 
+/**
+ * Prepare the cell kernel for the current event.
+ *
+ * @return True if the cell energies are scaled
+ */
+Bool_t AliEmcalCorrectionCellEnergyVariation::PrepareCellKernel(AliEmcalCorrectionCellBuffer & /*cells*/)
+{
+  AliEmcalCorrectionComponent::Run();
+
+  return fEnergyScaleFunction != 0;
+}
+
+/**
+ * Scale the energy of a single cell of the buffer, as done in Run().
+ */
+void AliEmcalCorrectionCellEnergyVariation::ApplyCellKernel(AliEmcalCorrectionCellBuffer & cells, Int_t iCell)
+{
+  Double_t ecell = cells.GetAmplitude(iCell);
+  if (ecell > fMinCellE && ecell < fMaxCellE) {
+    
+    ecell *= fEnergyScaleFunction->Eval(ecell);
+    
+    if (ecell > 0.) {
+      cells.SetAmplitude(iCell, ecell);
+    }
+  }
+}
+
 /**
  * Load the energy scale function TF1 from a file into the member fEnergyScaleFunction
  * @param path Path to the file containing the TF1
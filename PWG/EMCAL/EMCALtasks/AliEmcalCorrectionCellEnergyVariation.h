@@ -30,6 +30,11 @@ class AliEmcalCorrectionCellEnergyVariation : public AliEmcalCorrectionComponent
   void UserCreateOutputObjects();
   void ExecOnce();
   Bool_t Run();
+
+  // Cell kernel, see AliEmcalCorrectionTask
+  Bool_t HasCellKernel() const { return kTRUE; }
+  Bool_t PrepareCellKernel(AliEmcalCorrectionCellBuffer & cells);
+  void ApplyCellKernel(AliEmcalCorrectionCellBuffer & cells, Int_t iCell);
   
 protected:
   
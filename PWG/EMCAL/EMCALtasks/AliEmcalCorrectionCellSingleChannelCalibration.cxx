@@ -9,6 +9,7 @@
 #include "AliAODEvent.h"
 #include "AliDataFile.h"
 
+#include "AliEmcalCorrectionCellBuffer.h"
 #include "AliEmcalCorrectionCellSingleChannelCalibration.h"
 
 /// \cond CLASSIMP
@@ -79,6 +80,70 @@ void AliEmcalCorrectionCellSingleChannelCalibration::UserCreateOutputObjects()
  * Called for each event to process the event data.
  */
 Bool_t AliEmcalCorrectionCellSingleChannelCalibration::Run()
+{
+  if (!PrepareEvent())
+    return kFALSE;
+
+  if(fCreateHisto)
+    FillCellQA(fCellSingleChannelEnergyDistBefore); // "before" QA
+  
+  // CELL RECALIBRATION -------------------------------------------------------
+  // update cell objects
+  UpdateCells();
+  
+  if(fCreateHisto)
+    FillCellQA(fCellSingleChannelEnergyDistAfter); // "after" QA
+  
+  // switch off recalibrations so those are not done multiple times
+  // this is just for safety, the recalibrated flag of cell object
+  // should not allow for farther processing anyways
+  fRecoUtils->SwitchOffRecalibration();
+
+  return kTRUE;
+}
+
+/**
+ * Prepare the cell kernel for the current event. Same as Run(),
+ * with the cells updated one by one in ApplyCellKernel().
+ */
+Bool_t AliEmcalCorrectionCellSingleChannelCalibration::PrepareCellKernel(AliEmcalCorrectionCellBuffer & cells)
+{
+  if (!PrepareEvent())
+    return kFALSE;
+
+  PrepareUpdateCells(cells);
+  return kTRUE;
+}
+
+/**
+ * Update a single cell of the buffer.
+ */
+void AliEmcalCorrectionCellSingleChannelCalibration::ApplyCellKernel(AliEmcalCorrectionCellBuffer & cells, Int_t iCell)
+{
+  if(fCreateHisto)
+    fCellSingleChannelEnergyDistBefore->Fill(cells.GetAmplitude(iCell)); // "before" QA
+
+  UpdateCell(cells, iCell);
+
+  if(fCreateHisto)
+    fCellSingleChannelEnergyDistAfter->Fill(cells.GetAmplitude(iCell)); // "after" QA
+}
+
+/**
+ * Finish the cell kernel, after all cells were updated.
+ */
+void AliEmcalCorrectionCellSingleChannelCalibration::FinishCellKernel()
+{
+  FinishUpdateCells();
+
+  // switch off recalibrations so those are not done multiple times
+  fRecoUtils->SwitchOffRecalibration();
+}
+
+/**
+ * Per event setup, common to Run() and the cell kernel.
+ */
+Bool_t AliEmcalCorrectionCellSingleChannelCalibration::PrepareEvent()
 {
   AliEmcalCorrectionComponent::Run();
   
@@ -102,22 +167,6 @@ Bool_t AliEmcalCorrectionCellSingleChannelCalibration::Run()
   
   // mark the cells not recalibrated
   fRecoUtils->ResetCellsCalibrated();
-  
-  
-  if(fCreateHisto)
-    FillCellQA(fCellSingleChannelEnergyDistBefore); // "before" QA
-  
-  // CELL RECALIBRATION -------------------------------------------------------
-  // update cell objects
-  UpdateCells();
-  
-  if(fCreateHisto)
-    FillCellQA(fCellSingleChannelEnergyDistAfter); // "after" QA
-  
-  // switch off recalibrations so those are not done multiple times
-  // this is just for safety, the recalibrated flag of cell object
-  // should not allow for farther processing anyways
-  fRecoUtils->SwitchOffRecalibration();
 
   return kTRUE;
 }
@@ -33,12 +33,20 @@ class AliEmcalCorrectionCellSingleChannelCalibration : public AliEmcalCorrection
   void UserCreateOutputObjects();
   Bool_t Run();
   Bool_t CheckIfRunChanged();
+
+  // Cell kernel, see AliEmcalCorrectionTask
+  Bool_t HasCellKernel() const { return kTRUE; }
+  Bool_t PrepareCellKernel(AliEmcalCorrectionCellBuffer & cells);
+  void ApplyCellKernel(AliEmcalCorrectionCellBuffer & cells, Int_t iCell);
+  void FinishCellKernel();
   
  protected:
   TH1F* fCellSingleChannelEnergyDistBefore;        //!<! cell energy distribution, before energy calibration
   TH1F* fCellSingleChannelEnergyDistAfter;         //!<! cell energy distribution, after energy calibration
 
 private:
+  Bool_t PrepareEvent();
+
   Int_t                  InitRecalib();
   
   // Change to false if experts
@@ -12,6 +12,7 @@
 #include "AliAODEvent.h"
 #include "AliDataFile.h"
 
+#include "AliEmcalCorrectionCellBuffer.h"
 #include "AliEmcalCorrectionCellTimeCalib.h"
 
 /// \cond CLASSIMP
@@ -103,6 +104,62 @@ void AliEmcalCorrectionCellTimeCalib::UserCreateOutputObjects()
  * Called for each event to process the event data.
  */
 Bool_t AliEmcalCorrectionCellTimeCalib::Run()
+{
+  if (!PrepareEvent())
+    return kFALSE;
+
+  if(fCreateHisto)
+    FillCellQA(fCellTimeDistBefore); // "before" QA
+  
+  // CELL RECALIBRATION -------------------------------------------------------
+  // cell objects will be updated
+  UpdateCells();
+  
+  if(fCreateHisto)
+    FillCellQA(fCellTimeDistAfter); // "after" QA
+  
+  return kTRUE;
+}
+
+/**
+ * Prepare the cell kernel for the current event. Same as Run(),
+ * with the cells updated one by one in ApplyCellKernel().
+ */
+Bool_t AliEmcalCorrectionCellTimeCalib::PrepareCellKernel(AliEmcalCorrectionCellBuffer & cells)
+{
+  if (!PrepareEvent())
+    return kFALSE;
+
+  PrepareUpdateCells(cells);
+  return kTRUE;
+}
+
+/**
+ * Update a single cell of the buffer.
+ */
+void AliEmcalCorrectionCellTimeCalib::ApplyCellKernel(AliEmcalCorrectionCellBuffer & cells, Int_t iCell)
+{
+  if(fCreateHisto)
+    fCellTimeDistBefore->Fill(cells.GetTime(iCell)); // "before" QA
+
+  UpdateCell(cells, iCell);
+
+  if(fCreateHisto)
+    fCellTimeDistAfter->Fill(cells.GetTime(iCell)); // "after" QA
+}
+
+/**
+ * Finish the cell kernel, after all cells were updated.
+ */
+void AliEmcalCorrectionCellTimeCalib::FinishCellKernel()
+{
+  FinishUpdateCells();
+}
+
+/**
+ * Per event setup, common to Run() and the cell kernel.
+ */
+Bool_t AliEmcalCorrectionCellTimeCalib::PrepareEvent()
 {
   AliEmcalCorrectionComponent::Run();
   
@@ -140,17 +197,7 @@ Bool_t AliEmcalCorrectionCellTimeCalib::Run()
   
   // mark the cells not recalibrated
   fRecoUtils->ResetCellsCalibrated();
-  
-  if(fCreateHisto)
-    FillCellQA(fCellTimeDistBefore); // "before" QA
-  
-  // CELL RECALIBRATION -------------------------------------------------------
-  // cell objects will be updated
-  UpdateCells();
-  
-  if(fCreateHisto)
-    FillCellQA(fCellTimeDistAfter); // "after" QA
-  
+
   return kTRUE;
 }
 
@@ -32,12 +32,20 @@ class AliEmcalCorrectionCellTimeCalib : public AliEmcalCorrectionComponent {
   void UserCreateOutputObjects();
   Bool_t Run();
   Bool_t CheckIfRunChanged();
+
+  // Cell kernel, see AliEmcalCorrectionTask
+  Bool_t HasCellKernel() const { return kTRUE; }
+  Bool_t PrepareCellKernel(AliEmcalCorrectionCellBuffer & cells);
+  void ApplyCellKernel(AliEmcalCorrectionCellBuffer & cells, Int_t iCell);
+  void FinishCellKernel();
   
 protected:
   TH1F* fCellTimeDistBefore;            //!<! cell energy distribution, before time calibration
   TH1F* fCellTimeDistAfter;             //!<! cell energy distribution, after time calibration
 
 private:
+  Bool_t PrepareEvent();
+
   Int_t      InitEDepTimeCalibration();
   Int_t      InitTimeCalibration();
   Int_t      InitTimeCalibrationL1Phase();
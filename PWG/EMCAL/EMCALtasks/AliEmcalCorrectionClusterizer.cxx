@@ -42,6 +42,7 @@
 #include "AliAODEvent.h"
 #include "AliESDEvent.h"
 #include "AliAnalysisManager.h"
+#include "AliEmcalCorrectionCellBuffer.h"
 
 #include "AliEmcalCorrectionClusterizer.h"
 
@@ -395,14 +396,22 @@ void AliEmcalCorrectionClusterizer::FillDigitsArray()
     }
 
     Double_t avgE        = 0; // for background subtraction
-    const Int_t ncells   = fCaloCells->GetNumberOfCells();
+    const Int_t ncells   = fCellBuffer ? fCellBuffer->GetNumberOfCells() : fCaloCells->GetNumberOfCells();
     for (Int_t icell = 0, idigit = 0; icell < ncells; ++icell)
     {
       Float_t cellAmplitude=0;
       Double_t cellTime=0, amp = 0, cellEFrac = 0;
       Short_t  cellNumber=0;
       Int_t cellMCLabel=-1;
-      if (fCaloCells->GetCell(icell, cellNumber, amp, cellTime, cellMCLabel, cellEFrac) != kTRUE)
+      if (fCellBuffer) {
+        // cells already available from the fused cell pass of the correction task
+        cellNumber  = fCellBuffer->GetAbsId(icell);
+        amp         = fCellBuffer->GetAmplitude(icell);
+        cellTime    = fCellBuffer->GetTime(icell);
+        cellMCLabel = fCellBuffer->GetMCLabel(icell);
+        cellEFrac   = fCellBuffer->GetEFraction(icell);
+      }
+      else if (fCaloCells->GetCell(icell, cellNumber, amp, cellTime, cellMCLabel, cellEFrac) != kTRUE)
         break;
 
       cellAmplitude = amp; // compilation problem
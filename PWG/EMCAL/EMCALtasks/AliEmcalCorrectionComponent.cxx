@@ -10,6 +10,7 @@
 #include <AliVEvent.h>
 #include <AliEMCALRecoUtils.h>
 #include <AliOADBContainer.h>
+#include "AliEmcalCorrectionCellBuffer.h"
 #include "AliEmcalList.h"
 #include "AliClusterContainer.h"
 #include "AliTrackContainer.h"
@@ -51,6 +52,9 @@ AliEmcalCorrectionComponent::AliEmcalCorrectionComponent() :
   fCaloCells(0),
   fRecoUtils(0),
   fOutput(0),
+  fCellBuffer(0),
+  fBunchCrossNo(0),
+  fUpdateCells(kFALSE),
   fBasePath(""),
   fCustomBadChannelFilePath("")
 
@@ -87,6 +91,9 @@ AliEmcalCorrectionComponent::AliEmcalCorrectionComponent(const char * name) :
   fCaloCells(0),
   fRecoUtils(0),
   fOutput(0),
+  fCellBuffer(0),
+  fBunchCrossNo(0),
+  fUpdateCells(kFALSE),
   fBasePath(""),
   fCustomBadChannelFilePath("")
 {
@@ -206,6 +213,68 @@ void AliEmcalCorrectionComponent::UpdateCells()
   
   if (!fEventManager.InputEvent()) return ;
   
+  Int_t bunchCrossNo = SetupRecoUtilsForEvent();
+  
+  if (fRecoUtils){
+    fRecoUtils->RecalibrateCells(fCaloCells, bunchCrossNo);
+  }
+  fCaloCells->Sort();
+}
+
+/**
+ * Prepare the per cell version of UpdateCells() for the current event, used by the
+ * cell kernel of the components. The cells are sorted when the buffer is written back.
+ *
+ * @param[in] cells Buffer with the cells of the event
+ * @return True if the cells are recalibrated
+ */
+Bool_t AliEmcalCorrectionComponent::PrepareUpdateCells(AliEmcalCorrectionCellBuffer & cells)
+{
+  fUpdateCells = kFALSE;
+  if (!fEventManager.InputEvent()) return kFALSE;
+
+  cells.SetSortOnStore();
+
+  fBunchCrossNo = SetupRecoUtilsForEvent();
+  fUpdateCells = fRecoUtils && fRecoUtils->IsCellRecalibrationOn();
+  return fUpdateCells;
+}
+
+/**
+ * Update one cell of the buffer, in the same way as AliEMCALRecoUtils::RecalibrateCells().
+ *
+ * @param[in] cells Buffer with the cells of the event
+ * @param[in] iCell Index of the cell in the buffer
+ */
+void AliEmcalCorrectionComponent::UpdateCell(AliEmcalCorrectionCellBuffer & cells, Int_t iCell)
+{
+  if (!fUpdateCells) return;
+
+  Float_t  ecell = cells.GetAmplitude(iCell);
+  Double_t tcell = cells.GetTime(iCell);
+  if (!fRecoUtils->AcceptCalibrateCell(cells.GetAbsId(iCell), fBunchCrossNo, ecell, tcell, !cells.IsHighGain(iCell))) {
+    ecell = 0;
+    tcell = -1;
+  }
+  cells.SetCell(iCell, ecell, tcell);
+}
+
+/**
+ * Finish the per cell version of UpdateCells(), after all cells were updated.
+ */
+void AliEmcalCorrectionComponent::FinishUpdateCells()
+{
+  if (fUpdateCells) fRecoUtils->SetCellsCalibrated();
+  fUpdateCells = kFALSE;
+}
+
+/**
+ * Set the event dependent settings of the reco utils (PAR run).
+ *
+ * @return Bunch crossing number of the event
+ */
+Int_t AliEmcalCorrectionComponent::SetupRecoUtilsForEvent()
+{
   Int_t bunchCrossNo = fEventManager.InputEvent()->GetBunchCrossNumber();
   
   if (fRecoUtils){
@@ -221,10 +290,8 @@ void AliEmcalCorrectionComponent::UpdateCells()
       fRecoUtils->SetCurrentParNumber(currentParIndex);      
     }
     //end of PAR run settings
-
-    fRecoUtils->RecalibrateCells(fCaloCells, bunchCrossNo);
   }
-  fCaloCells->Sort();
+  return bunchCrossNo;
 }
 
 /**
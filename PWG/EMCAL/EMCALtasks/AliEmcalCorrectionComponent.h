@@ -13,6 +13,7 @@ class AliVCaloCells;
 class AliVTrack;
 class AliVCluster;
 class AliVEvent;
+class AliEmcalCorrectionCellBuffer;
 #include <AliLog.h>
 #include <AliEMCALGeometry.h>
 #include "AliYAMLConfiguration.h"
@@ -53,9 +54,18 @@ class AliEmcalCorrectionComponent : public TNamed {
   virtual Bool_t Run();
   virtual Bool_t UserNotify();
   virtual Bool_t CheckIfRunChanged();
+
+  // Element-wise cell kernel, run by AliEmcalCorrectionTask in a single pass over the cells (see there)
+  virtual Bool_t HasCellKernel() const                                               { return kFALSE; }
+  virtual Bool_t PrepareCellKernel(AliEmcalCorrectionCellBuffer & /*cells*/)         { return kFALSE; }
+  virtual void ApplyCellKernel(AliEmcalCorrectionCellBuffer & /*cells*/, Int_t /*iCell*/) {}
+  virtual void FinishCellKernel()                                                    {}
   
   void GetEtaPhiDiff(const AliVTrack *t, const AliVCluster *v, Double_t &phidiff, Double_t &etadiff);
   void UpdateCells();
+  Bool_t PrepareUpdateCells(AliEmcalCorrectionCellBuffer & cells);
+  void UpdateCell(AliEmcalCorrectionCellBuffer & cells, Int_t iCell);
+  void FinishUpdateCells();
   void GetPass();
   void FillCellQA(TH1F* h);
   Int_t InitBadChannels();
@@ -81,9 +91,12 @@ class AliEmcalCorrectionComponent : public TNamed {
   void                    RemoveClusterContainer(Int_t i=0)                      { fClusterCollArray.RemoveAt(i)                       ; }
   AliEMCALRecoUtils      *GetRecoUtils()  const { return fRecoUtils; }
   AliVCaloCells          *GetCaloCells()  const { return fCaloCells; }
+  AliEmcalCorrectionCellBuffer *GetCellBuffer() const { return fCellBuffer; }
   TList                  *GetOutputList() const { return fOutput; }
   
   void SetCaloCells(AliVCaloCells * cells) { fCaloCells = cells; }
+  /// Set the buffer holding an up to date copy of the cells (only valid for the current event)
+  void SetCellBuffer(AliEmcalCorrectionCellBuffer * buffer) { fCellBuffer = buffer; }
   void SetRecoUtils(AliEMCALRecoUtils *ru) { fRecoUtils = ru; }
 
   void SetInputEvent(AliVEvent * event) { fEventManager.SetInputEvent(event); }
@@ -110,6 +123,8 @@ class AliEmcalCorrectionComponent : public TNamed {
   /// Retrieve property
   template<typename T> bool GetProperty(std::string propertyName, T & property, bool requiredProperty = true, std::string correctionName = "");
  protected:
+  Int_t SetupRecoUtilsForEvent();
+
   PWG::Tools::AliYAMLConfiguration fYAMLConfig;           ///< Contains the %YAML configuration used to configure the component
   Bool_t                  fCreateHisto;                   ///< Flag to make some basic histograms
   Bool_t                  fLoad1DBadChMap;                ///< Flag to load 1D bad channel map
@@ -133,6 +148,9 @@ class AliEmcalCorrectionComponent : public TNamed {
   AliVCaloCells          *fCaloCells;                     //!<! Pointer to CaloCells
   AliEMCALRecoUtils      *fRecoUtils;                     ///<  Pointer to RecoUtils
   TList                  *fOutput;                        //!<! List of output histograms
+  AliEmcalCorrectionCellBuffer *fCellBuffer;              //!<! Buffer with the cells of the current event, if available
+  Int_t                   fBunchCrossNo;                  //!<! Bunch crossing number used in the cell kernel
+  Bool_t                  fUpdateCells;                   //!<! Cells are recalibrated in the cell kernel
   
   TString                fBasePath;                       ///< Base folder path to get root files
   TString                fCustomBadChannelFilePath;       ///< Custom path to bad channel map OADB file
@@ -142,7 +160,7 @@ class AliEmcalCorrectionComponent : public TNamed {
   AliEmcalCorrectionComponent &operator=(const AliEmcalCorrectionComponent &);    // Not implemented
   
   /// \cond CLASSIMP
-  ClassDef(AliEmcalCorrectionComponent, 9); // EMCal correction component
+  ClassDef(AliEmcalCorrectionComponent, 10); // EMCal correction component
   /// \endcond
 };
 
@@ -5,6 +5,7 @@
 
 #include "AliEmcalCorrectionTask.h"
 #include "AliEmcalCorrectionComponent.h"
+#include "AliEmcalCorrectionCellBuffer.h"
 
 #include <vector>
 #include <set>
@@ -61,6 +62,10 @@ AliEmcalCorrectionTask::AliEmcalCorrectionTask() :
   fForceBeamType(kNA),
   fNeedEmcalGeom(kTRUE),
   fGeom(0),
+  fFuseCellComponents(kTRUE),
+  fCellPassEnd(),
+  fActiveCellComponents(),
+  fCellBuffer(0),
   fParticleCollArray(),
   fClusterCollArray(),
   fCellCollArray(),
@@ -106,6 +111,10 @@ AliEmcalCorrectionTask::AliEmcalCorrectionTask(const char * name) :
   fForceBeamType(kNA),
   fNeedEmcalGeom(kTRUE),
   fGeom(0),
+  fFuseCellComponents(kTRUE),
+  fCellPassEnd(),
+  fActiveCellComponents(),
+  fCellBuffer(0),
   fParticleCollArray(),
   fClusterCollArray(),
   fCellCollArray(),
@@ -151,6 +160,10 @@ AliEmcalCorrectionTask::AliEmcalCorrectionTask(const AliEmcalCorrectionTask & ta
   fForceBeamType(task.fForceBeamType),
   fNeedEmcalGeom(task.fNeedEmcalGeom),
   fGeom(task.fGeom),
+  fFuseCellComponents(task.fFuseCellComponents),
+  fCellPassEnd(task.fCellPassEnd),
+  fActiveCellComponents(),
+  fCellBuffer(0),
   fParticleCollArray(*(static_cast<TObjArray *>(task.fParticleCollArray.Clone()))),
   fClusterCollArray(*(static_cast<TObjArray *>(task.fClusterCollArray.Clone()))),
   fOutput(task.fOutput)                           // TODO: More care is needed here!
@@ -214,6 +227,10 @@ void swap(AliEmcalCorrectionTask & first, AliEmcalCorrectionTask & second)
   swap(first.fForceBeamType, second.fForceBeamType);
   swap(first.fNeedEmcalGeom, second.fNeedEmcalGeom);
   swap(first.fGeom, second.fGeom);
+  swap(first.fFuseCellComponents, second.fFuseCellComponents);
+  swap(first.fCellPassEnd, second.fCellPassEnd);
+  swap(first.fActiveCellComponents, second.fActiveCellComponents);
+  swap(first.fCellBuffer, second.fCellBuffer);
   swap(first.fParticleCollArray, second.fParticleCollArray);
   swap(first.fClusterCollArray, second.fClusterCollArray);
   swap(first.fCellCollArray, second.fCellCollArray);
@@ -227,6 +244,7 @@ void swap(AliEmcalCorrectionTask & first, AliEmcalCorrectionTask & second)
 AliEmcalCorrectionTask::~AliEmcalCorrectionTask()
 {
   // Destructor
+  delete fCellBuffer;
 }
 
 void AliEmcalCorrectionTask::Initialize(bool removeDummyTask)
@@ -1204,6 +1222,36 @@ void AliEmcalCorrectionTask::ExecOnceComponents()
       AddContainersToComponent(component, AliEmcalContainerUtils::kCaloCells, true);
     }
   }
+
+  SetupCellPasses();
+}
+
+/**
+ * Group consecutive components with a cell kernel which correct the same cells into
+ * fused cell passes. Requires the cells to be set in the components.
+ */
+void AliEmcalCorrectionTask::SetupCellPasses()
+{
+  const UInt_t nComponents = fCorrectionComponents.size();
+  fCellPassEnd.assign(nComponents, 0);
+  if (!fFuseCellComponents) return;
+
+  for (UInt_t first = 0; first < nComponents; )
+  {
+    AliVCaloCells * cells = fCorrectionComponents[first]->GetCaloCells();
+    UInt_t last = first;
+    while (last < nComponents && cells && fCorrectionComponents[last]->HasCellKernel() && fCorrectionComponents[last]->GetCaloCells() == cells) {
+      last++;
+    }
+    if (last == first) {
+      first++;
+      continue;
+    }
+
+    fCellPassEnd[first] = last;
+    AliDebugStream(2) << "Fused cell pass of " << last - first << " components starting with " << fCorrectionComponents[first]->GetName() << std::endl;
+    first = last;
+  }
 }
 
 /**
@@ -1305,16 +1353,31 @@ Bool_t AliEmcalCorrectionTask::RetrieveEventObjects()
  */
 Bool_t AliEmcalCorrectionTask::Run()
 {
+  // Buffer with the cells of the last fused cell pass
+  AliEmcalCorrectionCellBuffer * cellBuffer = 0;
+
   // Run the initialization for all derived classes.
-  for (auto component : fCorrectionComponents)
+  for (UInt_t iComponent = 0; iComponent < fCorrectionComponents.size(); )
   {
-    component->SetInputEvent(InputEvent());
-    component->SetMCEvent(MCEvent());
-    component->SetCentralityBin(fCentBin);
-    component->SetCentrality(fCent);
-    component->SetVertex(fVertex);
+    if (iComponent < fCellPassEnd.size() && fCellPassEnd[iComponent] > iComponent) {
+      cellBuffer = RunCellPass(iComponent, fCellPassEnd[iComponent]);
+      iComponent = fCellPassEnd[iComponent];
+      continue;
+    }
+
+    AliEmcalCorrectionComponent * component = fCorrectionComponents[iComponent];
+    SetEventPropertiesInComponent(component);
 
+    // The buffer is only passed to the component directly following the pass,
+    // since any other component could modify the cells
+    if (cellBuffer && cellBuffer->GetCells() == component->GetCaloCells()) {
+      component->SetCellBuffer(cellBuffer);
+    }
     component->Run();
+    component->SetCellBuffer(0);
+    cellBuffer = 0;
+
+    iComponent++;
   }
 
   PostData(1, fOutput);
@@ -1322,6 +1385,57 @@ Bool_t AliEmcalCorrectionTask::Run()
   return kTRUE;
 }
 
+/**
+ * Set the event dependent properties in a component.
+ *
+ * @param[in] component Component to be run on the current event
+ */
+void AliEmcalCorrectionTask::SetEventPropertiesInComponent(AliEmcalCorrectionComponent * component)
+{
+  component->SetInputEvent(InputEvent());
+  component->SetMCEvent(MCEvent());
+  component->SetCentralityBin(fCentBin);
+  component->SetCentrality(fCent);
+  component->SetVertex(fVertex);
+}
+
+/**
+ * Run the components [first, last) in a single pass over the cells. Each component with work
+ * to do in this event applies its kernel to a cell before the next component sees it. Since
+ * the kernels are element-wise, the result is the same as running the components one after
+ * the other, while the cells are read and written only once.
+ *
+ * @param[in] first Index of the first component of the pass
+ * @param[in] last Index one past the last component of the pass
+ * @return Buffer holding the corrected cells
+ */
+AliEmcalCorrectionCellBuffer * AliEmcalCorrectionTask::RunCellPass(UInt_t first, UInt_t last)
+{
+  if (!fCellBuffer) fCellBuffer = new AliEmcalCorrectionCellBuffer;
+
+  fCellBuffer->Load(fCorrectionComponents[first]->GetCaloCells());
+
+  fActiveCellComponents.clear();
+  for (UInt_t iComponent = first; iComponent < last; iComponent++)
+  {
+    AliEmcalCorrectionComponent * component = fCorrectionComponents[iComponent];
+    SetEventPropertiesInComponent(component);
+    if (component->PrepareCellKernel(*fCellBuffer)) fActiveCellComponents.push_back(component);
+  }
+
+  const Int_t nCells = fCellBuffer->GetNumberOfCells();
+  for (Int_t iCell = 0; iCell < nCells; iCell++)
+  {
+    for (auto component : fActiveCellComponents) component->ApplyCellKernel(*fCellBuffer, iCell);
+  }
+
+  for (auto component : fActiveCellComponents) component->FinishCellKernel();
+
+  fCellBuffer->Store();
+
+  return fCellBuffer;
+}
+
 /**
  * Executed when the file is changed. Also calls UserNotify() for each component.
  */
@@ -1,6 +1,7 @@
 #ifndef ALIEMCALCORRECTIONTASK_H
 #define ALIEMCALCORRECTIONTASK_H
 
+class AliEmcalCorrectionCellBuffer;
 class AliEmcalCorrectionCellContainer;
 class AliEmcalCorrectionComponent;
 class AliEMCALGeometry;
@@ -32,6 +33,14 @@ class AliVEvent;
  * In general, this steering class handles all of the configuration of the
  * corrections, including passing the relevant EMCal containers and event objects.
  *
+ * Consecutive cell components which provide an element-wise cell kernel (see
+ * AliEmcalCorrectionComponent::HasCellKernel()) and correct the same cells are fused:
+ * the cells are copied once into an AliEmcalCorrectionCellBuffer, each cell is passed
+ * through all kernels of the pass, and the result is written back once. The results
+ * are identical to running the components one after the other. The buffer is passed on
+ * to the next component, so that for example the clusterizer can read the corrected
+ * cells from it. Fusing can be switched off with SetFuseCellComponents(kFALSE).
+ *
  * Note: %YAML does not play nicely with CINT and dictionary generation, so it is
  * hidden using conditional inclusion.
  *
@@ -100,6 +109,7 @@ class AliEmcalCorrectionTask : public AliAnalysisTaskSE {
   // Set
   void                        SetForceBeamType(BeamType f)                          { fForceBeamType     = f                              ; }
   void                        SetNeedEmcalGeometry(Bool_t b)                        { fNeedEmcalGeom     = b                              ; }
+  void                        SetFuseCellComponents(Bool_t b)                       { fFuseCellComponents = b                             ; }
   // Centrality options
   void                        SetUseNewCentralityEstimation(Bool_t b)               { fUseNewCentralityEstimation = b                     ; }
   void                        SetCentralityEstimator(const char * c)                { fCentEst           = c                              ; }
@@ -191,6 +201,9 @@ class AliEmcalCorrectionTask : public AliAnalysisTaskSE {
   // Execute component functions
   void UserCreateOutputObjectsComponents();
   void ExecOnceComponents();
+  void SetupCellPasses();
+  void SetEventPropertiesInComponent(AliEmcalCorrectionComponent * component);
+  AliEmcalCorrectionCellBuffer * RunCellPass(UInt_t first, UInt_t last);
 
   // Initialization functions
   void InitializeConfiguration();
@@ -241,6 +254,10 @@ class AliEmcalCorrectionTask : public AliAnalysisTaskSE {
   BeamType                    fForceBeamType;              ///< forced beam type
   Bool_t                      fNeedEmcalGeom;              ///< whether or not the task needs the emcal geometry
   AliEMCALGeometry           *fGeom;                       //!<! Emcal geometry
+  Bool_t                      fFuseCellComponents;         ///< Run consecutive cell components in a single pass over the cells
+  std::vector <UInt_t>        fCellPassEnd;                //!<! For each component, end (one past the last component) of the fused cell pass starting there
+  std::vector <AliEmcalCorrectionComponent *> fActiveCellComponents; //!<! Components of the current fused cell pass with work to do
+  AliEmcalCorrectionCellBuffer *fCellBuffer;               //!<! Cells buffer of the fused cell passes
 
   TObjArray                   fParticleCollArray;          ///< Particle/track collection array
   TObjArray                   fClusterCollArray;           ///< Cluster collection array
@@ -249,7 +266,7 @@ class AliEmcalCorrectionTask : public AliAnalysisTaskSE {
   TList *                     fOutput;                     //!<! Output for histograms
 
   /// \cond CLASSIMP
-  ClassDef(AliEmcalCorrectionTask, 9); // EMCal correction task
+  ClassDef(AliEmcalCorrectionTask, 10); // EMCal correction task
   /// \endcond
 };
 
@@ -36,6 +36,7 @@
 #pragma link C++ class  AliEmcalCorrectionCellContainer+;
 #pragma link C++ class  std::vector<AliEmcalCorrectionCellContainer *>+;
 #pragma link C++ class  AliEmcalCorrectionComponent+;
+#pragma link C++ class  AliEmcalCorrectionCellBuffer+;
 #pragma link C++ class  AliEmcalCorrectionCellBadChannel+;
 #pragma link C++ class  AliEmcalCorrectionCellEnergy+;
 #pragma link C++ class  AliEmcalCorrectionCellTrackMatcherAndMIPSubtraction+;
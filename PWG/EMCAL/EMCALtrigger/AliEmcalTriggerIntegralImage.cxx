@@ -0,0 +1,99 @@
+/************************************************************************************
+ * Copyright (C) 2026, Copyright Holders of the ALICE Collaboration                 *
+ * All rights reserved.                                                             *
+ *                                                                                  *
+ * Redistribution and use in source and binary forms, with or without               *
+ * modification, are permitted provided that the following conditions are met:      *
+ *     * Redistributions of source code must retain the above copyright             *
+ *       notice, this list of conditions and the following disclaimer.              *
+ *     * Redistributions in binary form must reproduce the above copyright          *
+ *       notice, this list of conditions and the following disclaimer in the        *
+ *       documentation and/or other materials provided with the distribution.       *
+ *     * Neither the name of the <organization> nor the                             *
+ *       names of its contributors may be used to endorse or promote products       *
+ *       derived from this software without specific prior written permission.      *
+ *                                                                                  *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND  *
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED    *
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE           *
+ * DISCLAIMED. IN NO EVENT SHALL ALICE COLLABORATION BE LIABLE FOR ANY              *
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES       *
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;     *
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND      *
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT       *
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS    *
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.                     *
+ ************************************************************************************/
+#include <algorithm>
+#include "AliEMCALTriggerDataGrid.h"
+#include "AliEmcalTriggerIntegralImage.h"
+
+ClassImp(PWG::EMCAL::AliEmcalTriggerIntegralImage)
+
+namespace PWG {
+
+namespace EMCAL {
+
+AliEmcalTriggerIntegralImage::AliEmcalTriggerIntegralImage():
+  fNCols(0),
+  fNRows(0),
+  fBuilt(false),
+  fSums(),
+  fNonZero()
+{
+}
+
+void AliEmcalTriggerIntegralImage::Build(const AliEMCALTriggerDataGrid<double> &grid) {
+  fNCols = grid.GetNumberOfCols();
+  fNRows = grid.GetNumberOfRows();
+  const int nentries = (fNCols + 1) * (fNRows + 1);
+  if(static_cast<int>(fSums.size()) != nentries) {
+    fSums.resize(nentries);
+    fNonZero.resize(nentries);
+  }
+
+  // Row 0 and column 0 hold the empty sums, all indices used
+  // below are inside the grid
+  std::fill(fSums.begin(), fSums.begin() + fNCols + 1, 0.);
+  std::fill(fNonZero.begin(), fNonZero.begin() + fNCols + 1, 0);
+  for(int irow = 0; irow < fNRows; irow++) {
+    double rowsum = 0.;
+    int rownonzero = 0;
+    const int below = Index(0, irow), current = Index(0, irow + 1);
+    fSums[current] = 0.;
+    fNonZero[current] = 0;
+    for(int icol = 0; icol < fNCols; icol++) {
+      const double value = grid(icol, irow);
+      rowsum += value;
+      if(value != 0.) rownonzero++;
+      fSums[current + icol + 1] = fSums[below + icol + 1] + rowsum;
+      fNonZero[current + icol + 1] = fNonZero[below + icol + 1] + rownonzero;
+    }
+  }
+  fBuilt = true;
+}
+
+bool AliEmcalTriggerIntegralImage::ClipWindow(int &colmin, int &rowmin, int &colmax, int &rowmax) const {
+  colmin = std::max(colmin, 0);
+  rowmin = std::max(rowmin, 0);
+  colmax = std::min(colmax, fNCols);
+  rowmax = std::min(rowmax, fNRows);
+  return colmin < colmax && rowmin < rowmax;
+}
+
+double AliEmcalTriggerIntegralImage::GetWindowSum(int col, int row, int ncols, int nrows) const {
+  int colmax = col + ncols, rowmax = row + nrows;
+  if(!ClipWindow(col, row, colmax, rowmax)) return 0.;
+  if(!(fNonZero[Index(colmax, rowmax)] - fNonZero[Index(col, rowmax)] - fNonZero[Index(colmax, row)] + fNonZero[Index(col, row)])) return 0.;
+  return fSums[Index(colmax, rowmax)] - fSums[Index(col, rowmax)] - fSums[Index(colmax, row)] + fSums[Index(col, row)];
+}
+
+int AliEmcalTriggerIntegralImage::GetNumberOfNonZero(int col, int row, int ncols, int nrows) const {
+  int colmax = col + ncols, rowmax = row + nrows;
+  if(!ClipWindow(col, row, colmax, rowmax)) return 0;
+  return fNonZero[Index(colmax, rowmax)] - fNonZero[Index(col, rowmax)] - fNonZero[Index(colmax, row)] + fNonZero[Index(col, row)];
+}
+
+}
+
+}
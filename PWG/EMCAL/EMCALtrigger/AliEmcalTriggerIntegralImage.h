@@ -0,0 +1,157 @@
+/************************************************************************************
+ * Copyright (C) 2026, Copyright Holders of the ALICE Collaboration                 *
+ * All rights reserved.                                                             *
+ *                                                                                  *
+ * Redistribution and use in source and binary forms, with or without               *
+ * modification, are permitted provided that the following conditions are met:      *
+ *     * Redistributions of source code must retain the above copyright             *
+ *       notice, this list of conditions and the following disclaimer.              *
+ *     * Redistributions in binary form must reproduce the above copyright          *
+ *       notice, this list of conditions and the following disclaimer in the        *
+ *       documentation and/or other materials provided with the distribution.       *
+ *     * Neither the name of the <organization> nor the                             *
+ *       names of its contributors may be used to endorse or promote products       *
+ *       derived from this software without specific prior written permission.      *
+ *                                                                                  *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND  *
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED    *
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE           *
+ * DISCLAIMED. IN NO EVENT SHALL ALICE COLLABORATION BE LIABLE FOR ANY              *
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES       *
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;     *
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND      *
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT       *
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS    *
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.                     *
+ ************************************************************************************/
+#ifndef ALIEMCALTRIGGERINTEGRALIMAGE_H
+#define ALIEMCALTRIGGERINTEGRALIMAGE_H
+
+#include <vector>
+#include <Rtypes.h>
+
+template<class T> class AliEMCALTriggerDataGrid;
+
+namespace PWG {
+
+namespace EMCAL {
+
+/**
+ * @class AliEmcalTriggerIntegralImage
+ * @brief Summed-area table of a trigger data grid
+ * @ingroup EMCALTRGFW
+ * @since Oct. 19, 2026
+ *
+ * The table is built once per event from a data grid. Afterwards the sum
+ * of any rectangular window of the grid is obtained from four lookups,
+ * independent of the window size:
+ *
+ * ~~~.{cxx}
+ * AliEmcalTriggerIntegralImage image;
+ * image.Build(adcgrid);
+ * double jetpatch = image.GetWindowSum(col, row, 16);   // 16x16 FastORs
+ * ~~~
+ *
+ * Next to the sums the number of non-zero channels is tabulated. It tells
+ * exactly whether a window is empty, which the floating point difference
+ * of the sums cannot guarantee: empty windows sum up to exactly 0. Windows
+ * extending beyond the grid are clipped to the grid.
+ */
+class AliEmcalTriggerIntegralImage {
+public:
+
+  /**
+   * @brief Constructor
+   */
+  AliEmcalTriggerIntegralImage();
+
+  /**
+   * @brief Destructor
+   */
+  ~AliEmcalTriggerIntegralImage() {}
+
+  /**
+   * @brief Build the table from a data grid
+   * @param grid Data grid (column = eta, row = phi)
+   *
+   * Memory is kept between events as long as the grid dimension
+   * does not change.
+   */
+  void Build(const AliEMCALTriggerDataGrid<double> &grid);
+
+  /**
+   * @brief Mark the table as invalid (memory is kept)
+   */
+  void Reset() { fBuilt = false; }
+
+  /**
+   * @brief Check whether the table was built
+   * @return True if Build was called since the last Reset
+   */
+  bool IsBuilt() const { return fBuilt; }
+
+  int GetNumberOfCols() const { return fNCols; }
+  int GetNumberOfRows() const { return fNRows; }
+
+  /**
+   * @brief Sum of a window of the grid
+   * @param col Starting column of the window
+   * @param row Starting row of the window
+   * @param ncols Number of columns of the window
+   * @param nrows Number of rows of the window
+   * @return Sum of the channels of the window inside the grid
+   */
+  double GetWindowSum(int col, int row, int ncols, int nrows) const;
+
+  /**
+   * @brief Sum of a square window (trigger patch) of the grid
+   * @param col Starting column of the window
+   * @param row Starting row of the window
+   * @param size Size of the window in columns and rows
+   * @return Sum of the channels of the window inside the grid
+   */
+  double GetWindowSum(int col, int row, int size) const { return GetWindowSum(col, row, size, size); }
+
+  /**
+   * @brief Number of non-zero channels in a window of the grid
+   * @param col Starting column of the window
+   * @param row Starting row of the window
+   * @param ncols Number of columns of the window
+   * @param nrows Number of rows of the window
+   * @return Number of channels with value different from 0
+   */
+  int GetNumberOfNonZero(int col, int row, int ncols, int nrows) const;
+
+  /**
+   * @brief Number of non-zero channels in a square window of the grid
+   * @param col Starting column of the window
+   * @param row Starting row of the window
+   * @param size Size of the window in columns and rows
+   * @return Number of channels with value different from 0
+   */
+  int GetNumberOfNonZero(int col, int row, int size) const { return GetNumberOfNonZero(col, row, size, size); }
+
+private:
+
+  /**
+   * @brief Clip a window to the grid
+   * @return False if the window has no overlap with the grid
+   */
+  bool ClipWindow(int &colmin, int &rowmin, int &colmax, int &rowmax) const;
+
+  int Index(int col, int row) const { return row * (fNCols + 1) + col; }
+
+  int                     fNCols;           ///< Number of columns of the grid
+  int                     fNRows;           ///< Number of rows of the grid
+  bool                    fBuilt;           ///< Table built for the current event
+  std::vector<double>     fSums;            ///< Sums of all channels below and left of (col, row), (ncols+1) x (nrows+1)
+  std::vector<int>        fNonZero;         ///< Number of non-zero channels below and left of (col, row)
+
+  ClassDef(AliEmcalTriggerIntegralImage, 1);
+};
+
+}
+
+}
+
+#endif
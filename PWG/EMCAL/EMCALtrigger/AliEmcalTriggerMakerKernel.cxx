@@ -24,6 +24,7 @@
  * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS      *
  * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.                       *
  **************************************************************************************/
+#include <algorithm>
 #include <iostream>
 #include <vector>
 #include <cstring>
@@ -39,9 +40,8 @@
 #include "AliEMCALTriggerConstants.h"
 #include "AliEMCALTriggerDataGrid.h"
 #include "AliEMCALTriggerPatchInfo.h"
-#include "AliEMCALTriggerPatchFinder.h"
-#include "AliEMCALTriggerAlgorithm.h"
 #include "AliEMCALTriggerRawPatch.h"
+#include "AliEmcalTriggerIntegralImage.h"
 #include "AliEmcalTriggerMakerKernel.h"
 #include "AliEmcalTriggerSetupInfo.h"
 #include "AliLog.h"
@@ -58,8 +58,8 @@ AliEmcalTriggerMakerKernel::AliEmcalTriggerMakerKernel():
   fOfflineBadChannels(),
   fFastORPedestal(5000),
   fTriggerBitConfig(nullptr),
-  fPatchFinder(nullptr),
-  fLevel0PatchFinder(nullptr),
+  fL1PatchAlgorithms(),
+  fLevel0PatchAlgorithm(),
   fL0MinTime(7),
   fL0MaxTime(10),
   fApplyL0TimeCut(true),
@@ -93,6 +93,10 @@ AliEmcalTriggerMakerKernel::AliEmcalTriggerMakerKernel():
   fPatchEnergySimpleSmeared(nullptr),
   fLevel0TimeMap(nullptr),
   fTriggerBitMap(nullptr),
+  fIntegralAmplitudes(nullptr),
+  fIntegralADCSimple(nullptr),
+  fIntegralADC(nullptr),
+  fIntegralEnergySmeared(nullptr),
   fADCtoGeV(1.)
 {
   memset(fThresholdConstants, 0, sizeof(Int_t) * 12);
@@ -109,8 +113,10 @@ AliEmcalTriggerMakerKernel::~AliEmcalTriggerMakerKernel() {
   delete fPatchEnergySimpleSmeared;
   delete fLevel0TimeMap;
   delete fTriggerBitMap;
-  delete fPatchFinder;
-  delete fLevel0PatchFinder;
+  delete fIntegralAmplitudes;
+  delete fIntegralADCSimple;
+  delete fIntegralADC;
+  delete fIntegralEnergySmeared;
   if(fTriggerBitConfig) delete fTriggerBitConfig;
 }
 
@@ -126,6 +132,9 @@ void AliEmcalTriggerMakerKernel::Init(){
   fPatchADC = new AliEMCALTriggerDataGrid<double>;
   fLevel0TimeMap = new AliEMCALTriggerDataGrid<char>;
   fTriggerBitMap = new AliEMCALTriggerDataGrid<int>;
+  fIntegralAmplitudes = new PWG::EMCAL::AliEmcalTriggerIntegralImage;
+  fIntegralADCSimple = new PWG::EMCAL::AliEmcalTriggerIntegralImage;
+  fIntegralADC = new PWG::EMCAL::AliEmcalTriggerIntegralImage;
 
   // Allocate containers for the ADC values
   int nrows = fGeometry->GetNTotalTRU() * 2;
@@ -140,24 +149,18 @@ void AliEmcalTriggerMakerKernel::Init(){
     // Allocate container for energy smearing (if enabled)
     fPatchEnergySimpleSmeared = new AliEMCALTriggerDataGrid<double>;
     fPatchEnergySimpleSmeared->Allocate(48, nrows);
+    fIntegralEnergySmeared = new PWG::EMCAL::AliEmcalTriggerIntegralImage;
   }
 }
 
 void AliEmcalTriggerMakerKernel::AddL1TriggerAlgorithm(Int_t rowmin, Int_t rowmax, UInt_t bitmask, Int_t patchSize, Int_t subregionSize)
 {
-  if (!fPatchFinder) fPatchFinder = new AliEMCALTriggerPatchFinder<double>;
-  AliEMCALTriggerAlgorithm<double> *trigger = new AliEMCALTriggerAlgorithm<double>(rowmin, rowmax, bitmask);
-  trigger->SetPatchSize(patchSize);
-  trigger->SetSubregionSize(subregionSize);
-  fPatchFinder->AddTriggerAlgorithm(trigger);
+  fL1PatchAlgorithms.push_back(PatchAlgorithm_t(rowmin, rowmax, bitmask, patchSize, subregionSize));
 }
 
 void AliEmcalTriggerMakerKernel::SetL0TriggerAlgorithm(Int_t rowmin, Int_t rowmax, UInt_t bitmask, Int_t patchSize, Int_t subregionSize)
 {
-  if (!fLevel0PatchFinder) delete fLevel0PatchFinder;
-  fLevel0PatchFinder = new AliEMCALTriggerAlgorithm<double>(rowmin, rowmax, bitmask);
-  fLevel0PatchFinder->SetPatchSize(patchSize);
-  fLevel0PatchFinder->SetSubregionSize(subregionSize);
+  fLevel0PatchAlgorithm = PatchAlgorithm_t(rowmin, rowmax, bitmask, patchSize, subregionSize);
 }
 
 void AliEmcalTriggerMakerKernel::ConfigureForPbPb2015()
@@ -166,8 +169,7 @@ void AliEmcalTriggerMakerKernel::ConfigureForPbPb2015()
   SetTriggerBitConfig(triggerBitConfig);
 
   // Initialize patch finder
-  if (fPatchFinder) delete fPatchFinder;
-  fPatchFinder = new AliEMCALTriggerPatchFinder<double>;
+  fL1PatchAlgorithms.clear();
 
   SetL0TriggerAlgorithm(0, 103, 1<<fTriggerBitConfig->GetLevel0Bit(), 2, 1);
   AddL1TriggerAlgorithm(0, 63, 1<<fTriggerBitConfig->GetGammaHighBit() | 1<<fTriggerBitConfig->GetGammaLowBit(), 2, 1);
@@ -184,8 +186,7 @@ void AliEmcalTriggerMakerKernel::ConfigureForPP2015()
   SetTriggerBitConfig(triggerBitConfig);
 
   // Initialize patch finder
-  if (fPatchFinder) delete fPatchFinder;
-  fPatchFinder = new AliEMCALTriggerPatchFinder<double>;
+  fL1PatchAlgorithms.clear();
 
   SetL0TriggerAlgorithm(0, 103, 1<<fTriggerBitConfig->GetLevel0Bit(), 2, 1);
   AddL1TriggerAlgorithm(0, 63, 1<<fTriggerBitConfig->GetGammaHighBit() | 1<<fTriggerBitConfig->GetGammaLowBit(), 2, 1);
@@ -201,8 +202,7 @@ void AliEmcalTriggerMakerKernel::ConfigureForPP20158x8()
   SetTriggerBitConfig(triggerBitConfig);
 
   // Initialize patch finder
-  if (fPatchFinder) delete fPatchFinder;
-  fPatchFinder = new AliEMCALTriggerPatchFinder<double>;
+  fL1PatchAlgorithms.clear();
 
   SetL0TriggerAlgorithm(0, 103, 1<<fTriggerBitConfig->GetLevel0Bit(), 2, 1);
   AddL1TriggerAlgorithm(0, 63, 1<<fTriggerBitConfig->GetGammaHighBit() | 1<<fTriggerBitConfig->GetGammaLowBit(), 2, 1);
@@ -218,8 +218,7 @@ void AliEmcalTriggerMakerKernel::ConfigureForPPb2013()
   SetTriggerBitConfig(triggerBitConfig);
 
   // Initialize patch finder
-  if (fPatchFinder) delete fPatchFinder;
-  fPatchFinder = new AliEMCALTriggerPatchFinder<double>;
+  fL1PatchAlgorithms.clear();
 
   SetL0TriggerAlgorithm(0, 63, 1<<fTriggerBitConfig->GetLevel0Bit(), 2, 1);
   AddL1TriggerAlgorithm(0, 63, 1<<fTriggerBitConfig->GetGammaHighBit() | 1<<fTriggerBitConfig->GetGammaLowBit(), 2, 1);
@@ -233,8 +232,7 @@ void AliEmcalTriggerMakerKernel::ConfigureForPP2012()
   SetTriggerBitConfig(triggerBitConfig);
 
   // Initialize patch finder
-  if (fPatchFinder) delete fPatchFinder;
-  fPatchFinder = new AliEMCALTriggerPatchFinder<double>;
+  fL1PatchAlgorithms.clear();
 
   SetL0TriggerAlgorithm(0, 63, 1<<fTriggerBitConfig->GetLevel0Bit(), 2, 1);
   AddL1TriggerAlgorithm(0, 63, 1<<fTriggerBitConfig->GetGammaHighBit(), 2, 1);
@@ -248,8 +246,7 @@ void AliEmcalTriggerMakerKernel::ConfigureForPbPb2011()
   SetTriggerBitConfig(triggerBitConfig);
 
   // Initialize patch finder
-  if (fPatchFinder) delete fPatchFinder;
-  fPatchFinder = new AliEMCALTriggerPatchFinder<double>;
+  fL1PatchAlgorithms.clear();
 
   SetL0TriggerAlgorithm(0, 63, 1<<fTriggerBitConfig->GetLevel0Bit(), 2, 1);
   AddL1TriggerAlgorithm(0, 63, 1<<fTriggerBitConfig->GetGammaHighBit(), 2, 1);
@@ -263,8 +260,7 @@ void AliEmcalTriggerMakerKernel::ConfigureForPP2011()
   SetTriggerBitConfig(triggerBitConfig);
 
   // Initialize patch finder
-  if (fPatchFinder) delete fPatchFinder;
-  fPatchFinder = new AliEMCALTriggerPatchFinder<double>;
+  fL1PatchAlgorithms.clear();
 
   SetL0TriggerAlgorithm(0, 63, 1<<fTriggerBitConfig->GetLevel0Bit(), 2, 1);
   fConfigured = true;
@@ -335,6 +331,10 @@ void AliEmcalTriggerMakerKernel::Reset(){
   fLevel0TimeMap->Reset();
   fTriggerBitMap->Reset();
   if(fPatchEnergySimpleSmeared) fPatchEnergySimpleSmeared->Reset();
+  fIntegralAmplitudes->Reset();
+  fIntegralADCSimple->Reset();
+  fIntegralADC->Reset();
+  if(fIntegralEnergySmeared) fIntegralEnergySmeared->Reset();
   memset(fL1ThresholdsOffline, 0, sizeof(ULong64_t) * 4);
 }
 
@@ -346,6 +346,10 @@ void AliEmcalTriggerMakerKernel::ReadTriggerData(AliVCaloTrigger *trigger){
     // get position in global 2x2 tower coordinates
     // A0 left bottom (0,0)
     trigger->GetPosition(globCol, globRow);
+    if(!IsInGrid(globCol, globRow)) {
+      AliErrorStream() << "Trigger maker task - filling data grids - position out-of-bounds: col " << globCol << ", row " << globRow << std::endl;
+      continue;
+    }
     Int_t absId = -1;
     fGeometry->GetAbsFastORIndexFromPositionInEMCAL(globCol, globRow, absId);
 
@@ -358,13 +362,7 @@ void AliEmcalTriggerMakerKernel::ReadTriggerData(AliVCaloTrigger *trigger){
       // protection against duplicate entries in the AliVCaloTriggers object:
       // the grid is anyhow initialized with 0, so in case of a 0 entry don't overwrite
       // existing entries
-      try {
-        (*fTriggerBitMap)(globCol, globRow) = bitmap;
-      }
-      catch (AliEMCALTriggerDataGrid<int>::OutOfBoundsException &e) {
-        std::string dirstring = e.GetDirection() == AliEMCALTriggerDataGrid<int>::OutOfBoundsException::kColDir ? "Col" : "Row";
-        AliErrorStream() << "Trigger maker task - filling trigger bit grid - index out-of-bounds in " << dirstring << ": " << e.GetIndex() << std::endl;
-      }
+      (*fTriggerBitMap)(globCol, globRow) = bitmap;
     }
 
     // also Level0 times need to be handled without masking of the fastor ...
@@ -374,16 +372,7 @@ void AliEmcalTriggerMakerKernel::ReadTriggerData(AliVCaloTrigger *trigger){
     if(nl0times){
       TArrayI l0times(nl0times);
       trigger->GetL0Times(l0times.GetArray());
-      for(int itime = 0; itime < nl0times; itime++){
-        try{
-          (*fLevel0TimeMap)(globCol,globRow) = static_cast<Char_t>(l0times[itime]);
-          break;
-        }
-        catch (AliEMCALTriggerDataGrid<char>::OutOfBoundsException &e) {
-          std::string dirstring = e.GetDirection() == AliEMCALTriggerDataGrid<char>::OutOfBoundsException::kColDir ? "Col" : "Row";
-          AliErrorStream() << "Trigger maker task - filling trigger bit grid - index out-of-bounds in " << dirstring << ": " << e.GetIndex() << std::endl;
-        }
-      }
+      (*fLevel0TimeMap)(globCol,globRow) = static_cast<Char_t>(l0times[0]);
     }
 
     // exclude channel completely if it is masked as hot channel
@@ -400,13 +389,7 @@ void AliEmcalTriggerMakerKernel::ReadTriggerData(AliVCaloTrigger *trigger){
       // protection against duplicate entries: the grid is anyhow
       // initialized with 0, so in case of an entry with negative or
       // 0 ADC time sum don't overwrite the existing one
-      try {
-        (*fPatchADC)(globCol,globRow) = adcAmp;
-      }
-      catch (AliEMCALTriggerDataGrid<double>::OutOfBoundsException &e) {
-        std::string dirstring = e.GetDirection() == AliEMCALTriggerDataGrid<double>::OutOfBoundsException::kColDir ? "Col" : "Row";
-        AliErrorStream() << "Trigger maker task - filling trigger bit grid - index out-of-bounds in " << dirstring << ": " << e.GetIndex() << std::endl;
-      }
+      (*fPatchADC)(globCol,globRow) = adcAmp;
     }
 
     // Handling for L0 triggers
@@ -424,13 +407,7 @@ void AliEmcalTriggerMakerKernel::ReadTriggerData(AliVCaloTrigger *trigger){
       // protection against duplicate entries: the grid is anyhow
       // initialized with 0, so in case of an entry with negative or
       // 0 ADC time sum don't overwrite the existing one
-      try{
-        (*fPatchAmplitudes)(globCol,globRow) = amplitude;
-      }
-      catch (AliEMCALTriggerDataGrid<int>::OutOfBoundsException &e) {
-        std::string dirstring = e.GetDirection() == AliEMCALTriggerDataGrid<int>::OutOfBoundsException::kColDir ? "Col" : "Row";
-        AliErrorStream() << "Trigger maker task - filling trigger bit grid - index out-of-bounds in " << dirstring << ": " << e.GetIndex() << std::endl;
-      }
+      (*fPatchAmplitudes)(globCol,globRow) = amplitude;
     }
   }
 
@@ -477,13 +454,10 @@ void AliEmcalTriggerMakerKernel::ReadCellData(AliVCaloCells *cells){
     }
     Int_t globCol=-1, globRow=-1;
     fGeometry->GetPositionInEMCALFromAbsFastORIndex(absId, globCol, globRow);
+    if(!IsInGrid(globCol, globRow)) continue;
     // add
     amp /= fADCtoGeV;
-    try {
-      if (amp >= fMinCellAmp) (*fPatchADCSimple)(globCol,globRow) += amp;
-    }
-    catch (AliEMCALTriggerDataGrid<double>::OutOfBoundsException &e) {
-    }
+    if (amp >= fMinCellAmp) (*fPatchADCSimple)(globCol,globRow) += amp;
   }
 
   // Apply energy smearing (if enabled)
@@ -579,15 +553,9 @@ void AliEmcalTriggerMakerKernel::CreateTriggerPatches(const AliVEvent *inputeven
   bkgPatchMask = 1 << fTriggerBitConfig->GetBkgBit();
       //l0PatchMask = 1 << fTriggerBitConfig->GetLevel0Bit();
 
-  std::vector<AliEMCALTriggerRawPatch> patches;
-  if (fPatchFinder) {
-    if (useL0amp) {
-      patches = fPatchFinder->FindPatches(*fPatchAmplitudes, *fPatchADCSimple);
-    }
-    else {
-      patches = fPatchFinder->FindPatches(*fPatchADC, *fPatchADCSimple);
-    }
-  }
+  std::vector<AliEMCALTriggerRawPatch> patches, l0patches;
+  BuildIntegralImages(useL0amp);
+  FindPatches(useL0amp, patches, l0patches);
   outputcont.clear();
   for(std::vector<AliEMCALTriggerRawPatch>::iterator patchit = patches.begin(); patchit != patches.end(); ++patchit){
     // Apply offline and recalc selection
@@ -628,21 +596,14 @@ void AliEmcalTriggerMakerKernel::CreateTriggerPatches(const AliVEvent *inputeven
     fullpatch.SetOffSet(offset);
     if(fPatchEnergySimpleSmeared){
       // Add smeared energy
-      double energysmear = 0;
-      for(int icol = 0; icol < fullpatch.GetPatchSize(); icol++){
-        for(int irow = 0; irow < fullpatch.GetPatchSize(); irow++){
-          energysmear += (*fPatchEnergySimpleSmeared)(fullpatch.GetColStart() + icol, fullpatch.GetRowStart() + irow);
-        }
-      }
+      double energysmear = fIntegralEnergySmeared->GetWindowSum(fullpatch.GetColStart(), fullpatch.GetRowStart(), fullpatch.GetPatchSize());
       AliDebugStream(1) << "Patch size(" << fullpatch.GetPatchSize() <<") energy " << fullpatch.GetPatchE() << " smeared " << energysmear << std::endl;
       fullpatch.SetSmearedEnergy(energysmear);
     }
     outputcont.push_back(fullpatch);
   }
 
-  // Find Level0 patches
-  std::vector<AliEMCALTriggerRawPatch> l0patches;
-  if (fLevel0PatchFinder) l0patches = fLevel0PatchFinder->FindPatches(*fPatchAmplitudes, *fPatchADCSimple);
+  // Level0 patches
   for(std::vector<AliEMCALTriggerRawPatch>::iterator patchit = l0patches.begin(); patchit != l0patches.end(); ++patchit){
     Int_t offlinebits = 0, onlinebits = 0;
     if(HasPHOSOverlap(*patchit)) continue;
@@ -659,12 +620,7 @@ void AliEmcalTriggerMakerKernel::CreateTriggerPatches(const AliVEvent *inputeven
     fullpatch.SetTriggerBitConfig(fTriggerBitConfig);
     if(fPatchEnergySimpleSmeared){
       // Add smeared energy
-      double energysmear = 0;
-      for(int icol = 0; icol < fullpatch.GetPatchSize(); icol++){
-        for(int irow = 0; irow < fullpatch.GetPatchSize(); irow++){
-          energysmear += (*fPatchEnergySimpleSmeared)(fullpatch.GetColStart() + icol, fullpatch.GetRowStart() + irow);
-        }
-      }
+      double energysmear = fIntegralEnergySmeared->GetWindowSum(fullpatch.GetColStart(), fullpatch.GetRowStart(), fullpatch.GetPatchSize());
       fullpatch.SetSmearedEnergy(energysmear);
     }
     outputcont.push_back(fullpatch);
@@ -674,63 +630,37 @@ void AliEmcalTriggerMakerKernel::CreateTriggerPatches(const AliVEvent *inputeven
 
 double AliEmcalTriggerMakerKernel::GetL0TriggerChannelAmplitude(Int_t col, Int_t row) const{
   double amp = 0;
-  try {
-    amp = (*fPatchAmplitudes)(col, row);
-  } catch (AliEMCALTriggerDataGrid<double>::OutOfBoundsException &e) {
-
-  }
+  if(IsInGrid(col, row)) amp = (*fPatchAmplitudes)(col, row);
   return amp;
 }
 
 double AliEmcalTriggerMakerKernel::GetTriggerChannelADC(Int_t col, Int_t row) const{
   double adc = 0;
-  try {
-    adc = (*fPatchADC)(col, row);
-  } catch (AliEMCALTriggerDataGrid<double>::OutOfBoundsException &e) {
-
-  }
+  if(IsInGrid(col, row)) adc = (*fPatchADC)(col, row);
   return adc;
 }
 
 double AliEmcalTriggerMakerKernel::GetTriggerChannelEnergyRough(Int_t col, Int_t row) const{
   double adc = 0;
-  try {
-    adc = (*fPatchADC)(col, row) * EMCALTrigger::kEMCL1ADCtoGeV;
-  } catch (AliEMCALTriggerDataGrid<double>::OutOfBoundsException &e) {
-
-  }
+  if(IsInGrid(col, row)) adc = (*fPatchADC)(col, row) * EMCALTrigger::kEMCL1ADCtoGeV;
   return adc;
 }
 
 double AliEmcalTriggerMakerKernel::GetTriggerChannelADCSimple(Int_t col, Int_t row) const{
   double adc = 0;
-  try {
-    adc = (*fPatchADCSimple)(col, row);
-  } catch (AliEMCALTriggerDataGrid<double>::OutOfBoundsException &e) {
-
-  }
+  if(IsInGrid(col, row)) adc = (*fPatchADCSimple)(col, row);
   return adc;
 }
 
 double AliEmcalTriggerMakerKernel::GetTriggerChannelEnergy(Int_t col, Int_t row) const {
   double adc = 0;
-  try {
-    adc = (*fPatchADCSimple)(col, row) * fADCtoGeV;
-  } catch (AliEMCALTriggerDataGrid<double>::OutOfBoundsException &e) {
-
-  }
+  if(IsInGrid(col, row)) adc = (*fPatchADCSimple)(col, row) * fADCtoGeV;
   return adc;
 }
 
 double AliEmcalTriggerMakerKernel::GetTriggerChannelEnergySmeared(Int_t col, Int_t row) const {
   double adc = 0;
-  if(fPatchEnergySimpleSmeared){
-	  try {
-		  adc = (*fPatchEnergySimpleSmeared)(col, row);
-	  } catch (AliEMCALTriggerDataGrid<double>::OutOfBoundsException &e) {
-
-	  }
-  }
+  if(fPatchEnergySimpleSmeared && IsInGrid(col, row)) adc = (*fPatchEnergySimpleSmeared)(col, row);
   return adc;
 }
 
@@ -738,6 +668,60 @@ double AliEmcalTriggerMakerKernel::GetDataGridDimensionRows() const{
   return fPatchADC->GetNumberOfRows();
 }
 
+Bool_t AliEmcalTriggerMakerKernel::IsInGrid(Int_t col, Int_t row) const {
+  // all data grids are allocated with the same dimension
+  return col >= 0 && row >= 0 && col < fPatchADC->GetNumberOfCols() && row < fPatchADC->GetNumberOfRows();
+}
+
+void AliEmcalTriggerMakerKernel::BuildIntegralImages(Bool_t useL0amp){
+  fIntegralADCSimple->Build(*fPatchADCSimple);
+  if(useL0amp || fLevel0PatchAlgorithm.fPatchSize > 0) fIntegralAmplitudes->Build(*fPatchAmplitudes);
+  if(!useL0amp && fL1PatchAlgorithms.size()) fIntegralADC->Build(*fPatchADC);
+  if(fPatchEnergySimpleSmeared) fIntegralEnergySmeared->Build(*fPatchEnergySimpleSmeared);
+}
+
+void AliEmcalTriggerMakerKernel::FindPatches(Bool_t useL0amp, std::vector<AliEMCALTriggerRawPatch> &l1patches, std::vector<AliEMCALTriggerRawPatch> &l0patches) const {
+  l1patches.clear();
+  l0patches.clear();
+
+  // L1 algorithms in the configured order, Level0 algorithm last
+  std::vector<const PatchAlgorithm_t *> algorithms;
+  for(std::vector<PatchAlgorithm_t>::const_iterator algit = fL1PatchAlgorithms.begin(); algit != fL1PatchAlgorithms.end(); ++algit) algorithms.push_back(&(*algit));
+  const size_t nL1 = algorithms.size();
+  if(fLevel0PatchAlgorithm.fPatchSize > 0) algorithms.push_back(&fLevel0PatchAlgorithm);
+  if(algorithms.empty()) return;
+
+  const PWG::EMCAL::AliEmcalTriggerIntegralImage &l1online = useL0amp ? *fIntegralAmplitudes : *fIntegralADC;
+  const int ncols = fPatchADCSimple->GetNumberOfCols();
+  int rowfirst = fPatchADCSimple->GetNumberOfRows(), rowlast = -1;
+  for(size_t ialg = 0; ialg < algorithms.size(); ialg++){
+    rowfirst = std::min(rowfirst, std::max(algorithms[ialg]->fRowMin, 0));
+    rowlast = std::max(rowlast, algorithms[ialg]->fRowMax - (algorithms[ialg]->fPatchSize - 1));
+  }
+
+  std::vector<std::vector<AliEMCALTriggerRawPatch> > found(algorithms.size());
+  for(int irow = rowfirst; irow <= rowlast; irow++){
+    for(int icol = 0; icol < ncols; icol++){
+      for(size_t ialg = 0; ialg < algorithms.size(); ialg++){
+        const PatchAlgorithm_t &alg = *(algorithms[ialg]);
+        if(!alg.IsStartPosition(icol, irow, ncols)) continue;
+        const PWG::EMCAL::AliEmcalTriggerIntegralImage &online = ialg < nL1 ? l1online : *fIntegralAmplitudes;
+        // All grids contain only non-negative values: the patch is found if any
+        // of its channels has a signal, in which case its sum is above 0
+        if(!online.GetNumberOfNonZero(icol, irow, alg.fPatchSize) && !fIntegralADCSimple->GetNumberOfNonZero(icol, irow, alg.fPatchSize)) continue;
+        AliEMCALTriggerRawPatch recpatch(icol, irow, alg.fPatchSize, online.GetWindowSum(icol, irow, alg.fPatchSize), fIntegralADCSimple->GetWindowSum(icol, irow, alg.fPatchSize));
+        recpatch.SetBitmask(alg.fBitMask);
+        found[ialg].push_back(recpatch);
+      }
+    }
+  }
+
+  for(size_t ialg = 0; ialg < algorithms.size(); ialg++){
+    std::vector<AliEMCALTriggerRawPatch> &target = ialg < nL1 ? l1patches : l0patches;
+    target.insert(target.end(), found[ialg].begin(), found[ialg].end());
+  }
+}
+
 AliEmcalTriggerMakerKernel::ELevel0TriggerStatus_t AliEmcalTriggerMakerKernel::CheckForL0(Int_t col, Int_t row) const {
   ELevel0TriggerStatus_t result = kLevel0Candidate;
 
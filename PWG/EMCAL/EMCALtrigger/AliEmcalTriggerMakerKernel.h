@@ -46,8 +46,8 @@ class AliVEvent;
 class AliVVZERO;
 class AliEMCALTriggerBitConfig;
 template<class T> class AliEMCALTriggerDataGrid;
-template<class T> class AliEMCALTriggerAlgorithm;
-template<class T> class AliEMCALTriggerPatchFinder;
+
+namespace PWG { namespace EMCAL { class AliEmcalTriggerIntegralImage; } }
 
 // To be moved to AliRoot in AliEMCALTriggerConstants.h at the first occasion
 namespace EMCALTrigger {
@@ -65,7 +65,9 @@ const Double_t kEMCL0ADCtoGeV_AP = 0.018970588*4;  // 0.075882352;             /
  * The trigger maker kernel contains the core functionality of
  * the trigger maker:
  * - Filling of the data grids
- * - Steering and running the patch finders
+ * - Steering and running the patch finders: window sums are obtained
+ *   from summed-area tables built once per grid and event, all configured
+ *   patch sizes are found in a single sweep over the grid
  * - Conversion of the raw patches obtained by the patch finders
  *   to full EMCAL trigger patch info objects.
  * I/O, which means interaction with the ALICE analysis system,
@@ -76,6 +78,38 @@ public:
 
   enum ELevel0TriggerStatus_t { kNotLevel0, kLevel0Candidate, kLevel0Fired };
 
+  /**
+   * @struct PatchAlgorithm_t
+   * @brief Settings of a sliding window patch finder
+   *
+   * Patches of size fPatchSize are searched for with starting rows in
+   * [fRowMin, fRowMax - fPatchSize + 1] and starting columns stepping
+   * by the sub region size.
+   */
+  struct PatchAlgorithm_t {
+    PatchAlgorithm_t(): fRowMin(0), fRowMax(-1), fBitMask(0), fPatchSize(0), fSubregionSize(1) {}
+    PatchAlgorithm_t(Int_t rowmin, Int_t rowmax, UInt_t bitmask, Int_t patchSize, Int_t subregionSize):
+      fRowMin(rowmin), fRowMax(rowmax), fBitMask(bitmask), fPatchSize(patchSize), fSubregionSize(subregionSize > 0 ? subregionSize : 1) {}
+
+    /**
+     * @brief Check whether a patch of this algorithm starts at the given position
+     * @param[in] col Column of the position
+     * @param[in] row Row of the position
+     * @param[in] ncols Number of columns of the data grid
+     * @return True if the position is a starting position of the sliding window
+     */
+    Bool_t IsStartPosition(Int_t col, Int_t row, Int_t ncols) const {
+      return row >= fRowMin && row <= fRowMax - (fPatchSize - 1) && col <= ncols - fPatchSize
+          && !((row - fRowMin) % fSubregionSize) && !(col % fSubregionSize);
+    }
+
+    Int_t  fRowMin;                   ///< Minimum row
+    Int_t  fRowMax;                   ///< Maximum row
+    UInt_t fBitMask;                  ///< Offline bit mask applied to the patches
+    Int_t  fPatchSize;                ///< Patch size (0: algorithm not set)
+    Int_t  fSubregionSize;            ///< Size of the sliding sub region
+  };
+
   /**
    * @brief Constructor
    */
@@ -114,6 +148,9 @@ public:
    * @param[out] output container for reconstructed trigger patches
    * @param[in] useL0amp if true the Level0 amplitude is used
    * @return Array of reconstructed trigger patches
+   *
+   * Patches are the same as obtained from the explicit sums of the sliding
+   * windows, patch sums agree up to floating point rounding.
    */
   void CreateTriggerPatches(const AliVEvent *inputevent, std::vector<AliEMCALTriggerPatchInfo> &outputcont, Bool_t useL0amp=kFALSE);
 
@@ -572,13 +609,39 @@ protected:
    */
   bool HasPHOSOverlap(const AliEMCALTriggerRawPatch &patch) const;
 
+  /**
+   * @brief Check whether a position is inside the data grids
+   * @param[in] col Column of the position
+   * @param[in] row Row of the position
+   * @return True if the position is a valid index of the data grids
+   */
+  Bool_t IsInGrid(Int_t col, Int_t row) const;
+
+  /**
+   * @brief Build the summed-area tables of the data grids used for the current event
+   * @param[in] useL0amp if true the Level0 amplitude is used for the L1 patches
+   */
+  void BuildIntegralImages(Bool_t useL0amp);
+
+  /**
+   * @brief Run all patch finders in one sweep over the data grid
+   *
+   * At each position the patches of all algorithms starting there are evaluated
+   * with four lookups in the summed-area tables. Patches are returned per algorithm
+   * in the configured order, each in the order of the sliding window.
+   * @param[in] useL0amp if true the Level0 amplitude is used for the L1 patches
+   * @param[out] l1patches Patches of the L1 algorithms
+   * @param[out] l0patches Patches of the Level0 algorithm
+   */
+  void FindPatches(Bool_t useL0amp, std::vector<AliEMCALTriggerRawPatch> &l1patches, std::vector<AliEMCALTriggerRawPatch> &l0patches) const;
+
   std::set<Short_t>                         fBadChannels;                 ///< Container of bad channels
   std::set<Short_t>                         fOfflineBadChannels;          ///< Abd ID of offline bad channels
   TArrayF                                   fFastORPedestal;              ///< FastOR pedestal
   const AliEMCALTriggerBitConfig           *fTriggerBitConfig;            ///< Trigger bit configuration, aliroot-dependent
 
-  AliEMCALTriggerPatchFinder<double>       *fPatchFinder;                 ///< The actual patch finder
-  AliEMCALTriggerAlgorithm<double>         *fLevel0PatchFinder;           ///< Patch finder for Level0 patches
+  std::vector<PatchAlgorithm_t>             fL1PatchAlgorithms;           ///< Patch finders for L1 patches
+  PatchAlgorithm_t                          fLevel0PatchAlgorithm;        ///< Patch finder for Level0 patches
   Int_t                                     fL0MinTime;                   ///< Minimum L0 time
   Int_t                                     fL0MaxTime;                   ///< Maximum L0 time
   Bool_t                                    fApplyL0TimeCut;              ///< Apply time cut (L0 time between fL0MinTime and fL0MaxTime) for L0 patch selection
@@ -616,11 +679,15 @@ protected:
   AliEMCALTriggerDataGrid<double>           *fPatchEnergySimpleSmeared;   //!<! Data grid for smeared energy values from cell energies
   AliEMCALTriggerDataGrid<char>             *fLevel0TimeMap;              //!<! Map needed to store the level0 times
   AliEMCALTriggerDataGrid<int>              *fTriggerBitMap;              //!<! Map of trigger bits
+  PWG::EMCAL::AliEmcalTriggerIntegralImage  *fIntegralAmplitudes;         //!<! Summed-area table of the TRU amplitudes
+  PWG::EMCAL::AliEmcalTriggerIntegralImage  *fIntegralADCSimple;          //!<! Summed-area table of the offline ADC
+  PWG::EMCAL::AliEmcalTriggerIntegralImage  *fIntegralADC;                //!<! Summed-area table of the ADC values
+  PWG::EMCAL::AliEmcalTriggerIntegralImage  *fIntegralEnergySmeared;      //!<! Summed-area table of the smeared energies
   Double_t                                  fRhoValues[kNIndRho];         //!<! Rho values for background subtraction (only online ADC)
 
   Double_t                                  fADCtoGeV;                    //!<! Conversion factor from ADC to GeV
 
-  ClassDef(AliEmcalTriggerMakerKernel, 4);
+  ClassDef(AliEmcalTriggerMakerKernel, 5);
 };
 
 #endif
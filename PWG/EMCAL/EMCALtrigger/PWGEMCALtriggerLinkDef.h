@@ -6,6 +6,8 @@
 
 #pragma link C++ class AliEmcalTriggerMaker+;
 #pragma link C++ class AliEmcalTriggerMakerKernel+;
+#pragma link C++ struct AliEmcalTriggerMakerKernel::PatchAlgorithm_t+;
+#pragma link C++ class std::vector<AliEmcalTriggerMakerKernel::PatchAlgorithm_t>+;
 #pragma link C++ class AliEmcalTriggerMakerTask+;
 #pragma link C++ class AliEmcalTriggerSetupInfo+;
 #pragma link C++ class AliEmcalTriggerQATask+;
@@ -19,6 +21,7 @@
 #pragma link C++ class PWG::EMCAL::AliEmcalTriggerAlias+;
 #pragma link C++ class PWG::EMCAL::AliEmcalTriggerDecision+;
 #pragma link C++ class PWG::EMCAL::AliEmcalTriggerDecisionContainer+;
+#pragma link C++ class PWG::EMCAL::AliEmcalTriggerIntegralImage+;
 #pragma link C++ class PWG::EMCAL::AliEmcalTriggerSelectionCuts++;
 #pragma link C++ class PWG::EMCAL::AliEmcalTriggerSelection+;
 #pragma link C++ class PWG::EMCAL::Triggerinfo+;
@@ -0,0 +1,52 @@
+#ifndef ALIANALYSISREENTRANTTASK_H
+#define ALIANALYSISREENTRANTTASK_H
+/* Copyright(c) 1998-2026, ALICE Experiment at CERN, All rights reserved. *
+ * See cxx source for full Copyright notice                               */
+
+#include <Rtypes.h>
+
+class AliVEvent;
+class AliMCEvent;
+
+/**
+ * @class AliAnalysisReentrantTask
+ * @brief Interface of the analysis tasks which can run in AliAnalysisThreadedEventLoop
+ *
+ * A task declares with this interface that independent copies of it (cloned
+ * from the configured task) can process different events at the same time:
+ * UserExec only modifies members of the task and its own output objects, and
+ * static or global objects are at most initialised by it. The event loop
+ * gives each copy its event with SetThreadInput before each call of UserExec,
+ * the copy is used instead of the input handler of the analysis manager.
+ *
+ * ~~~{.cxx}
+ * class AliAnalysisTaskMyTask : public AliAnalysisTaskSE, public AliAnalysisReentrantTask {
+ *   ...
+ *   virtual void SetThreadInput(AliVEvent *event, AliMCEvent *mcEvent) { fInputEvent = event; fMCEvent = mcEvent; }
+ * };
+ * ~~~
+ */
+class AliAnalysisReentrantTask {
+public:
+
+  /**
+   * Constructor
+   */
+  AliAnalysisReentrantTask() {}
+
+  /**
+   * Destructor
+   */
+  virtual ~AliAnalysisReentrantTask() {}
+
+  /**
+   * Set the event processed by the next call of UserExec
+   * @param event Input event
+   * @param mcEvent MC event, null if not available
+   */
+  virtual void SetThreadInput(AliVEvent *event, AliMCEvent *mcEvent) = 0;
+
+  ClassDef(AliAnalysisReentrantTask, 1);
+};
+
+#endif // ALIANALYSISREENTRANTTASK_H
@@ -0,0 +1,424 @@
+/**************************************************************************
+ * Copyright(c) 1998-2026, ALICE Experiment at CERN, All rights reserved. *
+ *                                                                        *
+ * Author: The ALICE Off-line Project.                                    *
+ * Contributors are mentioned in the code where appropriate.              *
+ *                                                                        *
+ * Permission to use, copy, modify and distribute this software and its   *
+ * documentation strictly for non-commercial purposes is hereby granted   *
+ * without fee, provided that the above copyright notice appears in all   *
+ * copies and that both the copyright notice and this permission notice   *
+ * appear in the supporting documentation. The authors make no claims     *
+ * about the suitability of this software for any purpose. It is          *
+ * provided "as is" without express or implied warranty.                  *
+ **************************************************************************/
+#include <atomic>
+#include <mutex>
+#include <thread>
+#include <TChain.h>
+#include <TClass.h>
+#include <TDirectory.h>
+#include <TFile.h>
+#include <TH1.h>
+#include <TList.h>
+#include <TMath.h>
+#include <TMethodCall.h>
+#include <TROOT.h>
+#include <TStopwatch.h>
+
+#include "AliAnalysisDataContainer.h"
+#include "AliAnalysisDataSlot.h"
+#include "AliAnalysisTaskSE.h"
+#include "AliAODEvent.h"
+#include "AliESDEvent.h"
+#include "AliLog.h"
+#include "AliVAODHeader.h"
+
+#include "AliAnalysisReentrantTask.h"
+#include "AliAnalysisThreadedEventLoop.h"
+
+/// \cond CLASSIMP
+ClassImp(AliAnalysisThreadedEventLoop)
+/// \endcond
+
+namespace {
+  std::mutex gRunInitMutex;   // serialises the first event of each run of the threads
+}
+
+/**
+ * Default constructor, needed by ROOT I/O
+ */
+AliAnalysisThreadedEventLoop::AliAnalysisThreadedEventLoop():
+  TNamed(),
+  fTasks(),
+  fNThreads(1),
+  fChunkSize(100),
+  fOutputFileName(),
+  fContainers(),
+  fOutputs(),
+  fThreads(),
+  fIsAOD(kFALSE),
+  fFirstEntry(0),
+  fLastEntry(0),
+  fNThreadsUsed(0),
+  fNEvents(0),
+  fRealTime(0.)
+{
+  fTasks.SetOwner();
+  fContainers.SetOwner();
+  fOutputs.SetOwner();
+}
+
+/**
+ * Constructor
+ * @param name Name of the event loop
+ */
+AliAnalysisThreadedEventLoop::AliAnalysisThreadedEventLoop(const char *name):
+  TNamed(name, "Thread-parallel event loop"),
+  fTasks(),
+  fNThreads(1),
+  fChunkSize(100),
+  fOutputFileName("AnalysisResults.root"),
+  fContainers(),
+  fOutputs(),
+  fThreads(),
+  fIsAOD(kFALSE),
+  fFirstEntry(0),
+  fLastEntry(0),
+  fNThreadsUsed(0),
+  fNEvents(0),
+  fRealTime(0.)
+{
+  fTasks.SetOwner();
+  fContainers.SetOwner();
+  fOutputs.SetOwner();
+}
+
+/**
+ * Destructor, deletes the configured tasks and the merged outputs
+ */
+AliAnalysisThreadedEventLoop::~AliAnalysisThreadedEventLoop()
+{
+  DeleteThreads();
+  fTasks.Delete();
+  fOutputs.Delete();
+  fContainers.Delete();
+}
+
+/**
+ * Add a task to the event loop, which takes ownership of it. Tasks are executed
+ * in the order they are added. The task must derive from AliAnalysisTaskSE,
+ * implement AliAnalysisReentrantTask and must not be connected to an analysis
+ * manager.
+ * @param task Task to be added
+ */
+void AliAnalysisThreadedEventLoop::AddTask(AliAnalysisTask *task)
+{
+  if (!task) return;
+  if (!task->InheritsFrom(AliAnalysisTaskSE::Class()) || !dynamic_cast<AliAnalysisReentrantTask *>(task)) {
+    AliError(Form("Task %s is not a re-entrant AliAnalysisTaskSE, it cannot run in the threaded event loop", task->GetName()));
+    return;
+  }
+  fTasks.Add(task);
+  ConnectOutputs(task, fContainers);
+}
+
+/**
+ * Process entries of the chain with the configured tasks
+ * @param chain Input chain (esdTree or aodTree)
+ * @param nentries Number of entries to process, all if negative
+ * @param firstentry First entry to process
+ * @return Number of processed events
+ */
+Long64_t AliAnalysisThreadedEventLoop::Run(TChain *chain, Long64_t nentries, Long64_t firstentry)
+{
+  DeleteThreads();
+  ResetOutputs();
+  fNThreadsUsed = 0;
+  fNEvents = 0;
+  fRealTime = 0.;
+
+  if (!chain || !fTasks.GetEntriesFast()) {
+    AliError("No input chain or no task");
+    return 0;
+  }
+  TString treename = chain->GetName();
+  if (treename == "aodTree") fIsAOD = kTRUE;
+  else if (treename == "esdTree") fIsAOD = kFALSE;
+  else {
+    AliError(Form("Input tree %s is neither esdTree nor aodTree", treename.Data()));
+    return 0;
+  }
+
+  fFirstEntry = TMath::Max(firstentry, 0LL);
+  fLastEntry = chain->GetEntries();
+  if (nentries >= 0) fLastEntry = TMath::Min(fLastEntry, fFirstEntry + nentries);
+  if (fFirstEntry >= fLastEntry) {
+    AliWarning("No entry to process");
+    return 0;
+  }
+  const Long64_t chunksize = TMath::Max(fChunkSize, 1);
+  const Long64_t nchunks = (fLastEntry - fFirstEntry + chunksize - 1) / chunksize;
+  fNThreadsUsed = static_cast<Int_t>(TMath::Min(static_cast<Long64_t>(TMath::Max(fNThreads, 1)), nchunks));
+
+  if (!fIsAOD) {
+    for (Int_t itask = 0; itask < fTasks.GetEntriesFast(); itask++) {
+      AliAnalysisTaskSE *task = static_cast<AliAnalysisTaskSE *>(fTasks.UncheckedAt(itask));
+      if (task->GetCollisionCandidates() && task->GetCollisionCandidates() != AliVEvent::kAny)
+        AliWarning(Form("No physics selection on ESD input, the collision candidates of task %s are not selected", task->GetName()));
+    }
+  }
+
+  if (fNThreadsUsed > 1) ROOT::EnableThreadSafety();
+
+  // inputs and task clones are created sequentially, the histograms of the clones
+  // and the merged ones are not attached to a directory
+  Bool_t addDirectory = TH1::AddDirectoryStatus();
+  TH1::AddDirectory(kFALSE);
+  Bool_t initialized = kTRUE;
+  for (Int_t ithread = 0; ithread < fNThreadsUsed && initialized; ithread++) {
+    ThreadContext *context = new ThreadContext;
+    fThreads.push_back(context);
+    initialized = InitThread(*context, chain, fFirstEntry);
+  }
+  if (!initialized) {
+    TH1::AddDirectory(addDirectory);
+    DeleteThreads();
+    return 0;
+  }
+
+  TStopwatch timer;
+  if (fNThreadsUsed > 1) {
+    std::atomic<Long64_t> nextchunk(0);
+    std::vector<std::thread> threads;
+    for (Int_t ithread = 0; ithread < fNThreadsUsed; ithread++) {
+      ThreadContext *context = fThreads[ithread];
+      threads.push_back(std::thread([this, context, nchunks, &nextchunk]() {
+        Long64_t ichunk;
+        while ((ichunk = nextchunk++) < nchunks) ProcessChunk(*context, ichunk);
+      }));
+    }
+    for (std::vector<std::thread>::iterator it = threads.begin(); it != threads.end(); ++it) it->join();
+  }
+  else {
+    for (Long64_t ichunk = 0; ichunk < nchunks; ichunk++) ProcessChunk(*fThreads[0], ichunk);
+  }
+  timer.Stop();
+  fRealTime = timer.RealTime();
+  for (std::vector<ThreadContext *>::const_iterator it = fThreads.begin(); it != fThreads.end(); ++it) fNEvents += (*it)->fNEvents;
+
+  AliInfo(Form("%lld events processed with %d thread(s) in %.2f s (%.1f events/s)", fNEvents, fNThreadsUsed, fRealTime, GetEventRate()));
+
+  MergeOutputs();
+  DeleteThreads();
+  TH1::AddDirectory(addDirectory);
+
+  for (Int_t itask = 0; itask < fTasks.GetEntriesFast(); itask++) {
+    static_cast<AliAnalysisTask *>(fTasks.UncheckedAt(itask))->Terminate();
+  }
+  WriteOutputs();
+
+  return fNEvents;
+}
+
+/**
+ * Merge objects with their Merge(TCollection*) function
+ * @param target Object into which the sources are merged
+ * @param sources Objects to be merged
+ * @return kFALSE if the class of the target cannot be merged
+ */
+Bool_t AliAnalysisThreadedEventLoop::MergeObjects(TObject *target, TCollection *sources)
+{
+  ROOT::MergeFunc_t merge = target->IsA()->GetMerge();
+  if (merge) {
+    merge(target, sources, 0);
+    return kTRUE;
+  }
+  TMethodCall call;
+  call.InitWithPrototype(target->IsA(), "Merge", "TCollection*");
+  if (!call.IsValid()) return kFALSE;
+  call.SetParam(reinterpret_cast<Long_t>(sources));
+  call.Execute(target);
+  return kTRUE;
+}
+
+/**
+ * Connect the output slots of a task to new containers
+ * @param task Task to connect
+ * @param containers Array taking the containers
+ */
+void AliAnalysisThreadedEventLoop::ConnectOutputs(AliAnalysisTask *task, TObjArray &containers) const
+{
+  for (Int_t islot = 0; islot < task->GetNoutputs(); islot++) {
+    AliAnalysisDataContainer *container = new AliAnalysisDataContainer(Form("%s_output%d", task->GetName(), islot), task->GetOutputType(islot));
+    containers.Add(container);
+    task->ConnectOutput(islot, container);
+  }
+}
+
+/**
+ * Create the input and the task clones of a thread
+ * @param context Thread to be initialised
+ * @param chain Input chain
+ * @param firstentry First entry of the range to be processed
+ * @return kFALSE if the input cannot be read
+ */
+Bool_t AliAnalysisThreadedEventLoop::InitThread(ThreadContext &context, TChain *chain, Long64_t firstentry)
+{
+  context.fChain = new TChain(chain->GetName());
+  context.fChain->Add(chain);
+  if (context.fChain->LoadTree(firstentry) < 0) {
+    AliError(Form("Cannot load entry %lld of the input chain", firstentry));
+    return kFALSE;
+  }
+  if (fIsAOD) {
+    AliAODEvent *event = new AliAODEvent;
+    event->ReadFromTree(context.fChain);
+    context.fEvent = event;
+  }
+  else {
+    AliESDEvent *event = new AliESDEvent;
+    event->ReadFromTree(context.fChain);
+    context.fEvent = event;
+  }
+
+  for (Int_t itask = 0; itask < fTasks.GetEntriesFast(); itask++) {
+    AliAnalysisTaskSE *task = static_cast<AliAnalysisTaskSE *>(fTasks.UncheckedAt(itask)->Clone());
+    context.fTasks.Add(task);
+    ConnectOutputs(task, context.fContainers);
+    task->LocalInit();
+    task->UserCreateOutputObjects();
+  }
+  return kTRUE;
+}
+
+/**
+ * Process a block of consecutive entries
+ * @param context Thread processing the entries
+ * @param ichunk Index of the block in the range to be processed
+ */
+void AliAnalysisThreadedEventLoop::ProcessChunk(ThreadContext &context, Long64_t ichunk)
+{
+  const Long64_t chunksize = TMath::Max(fChunkSize, 1);
+  const Long64_t first = fFirstEntry + ichunk * chunksize;
+  const Long64_t last = TMath::Min(first + chunksize, fLastEntry);
+  for (Long64_t ientry = first; ientry < last; ientry++) {
+    if (context.fChain->GetEntry(ientry) <= 0) continue;
+    ExecuteTasks(context);
+  }
+}
+
+/**
+ * Execute the task clones of a thread on its current event. The first event of
+ * a new run is processed under the global lock.
+ * @param context Thread processing the event
+ */
+void AliAnalysisThreadedEventLoop::ExecuteTasks(ThreadContext &context)
+{
+  AliVEvent *event = context.fEvent;
+  UInt_t offtrigger = AliVEvent::kAny;
+  if (fIsAOD) {
+    AliVAODHeader *header = static_cast<AliVAODHeader *>(static_cast<AliAODEvent *>(event)->GetHeader());
+    if (header) offtrigger = header->GetOfflineTrigger();
+  }
+  else {
+    static_cast<AliESDEvent *>(event)->ConnectTracks();
+  }
+
+  std::unique_lock<std::mutex> lock(gRunInitMutex, std::defer_lock);
+  if (event->GetRunNumber() != context.fRunNumber) {
+    lock.lock();
+    context.fRunNumber = event->GetRunNumber();
+  }
+
+  for (Int_t itask = 0; itask < context.fTasks.GetEntriesFast(); itask++) {
+    AliAnalysisTaskSE *task = static_cast<AliAnalysisTaskSE *>(context.fTasks.UncheckedAt(itask));
+    if (fIsAOD && task->GetCollisionCandidates() && !(offtrigger & task->GetCollisionCandidates())) continue;
+    dynamic_cast<AliAnalysisReentrantTask *>(task)->SetThreadInput(event, 0);
+    task->UserExec("");
+  }
+  context.fNEvents++;
+}
+
+/**
+ * Merge the outputs of the task clones and give them to the configured tasks
+ */
+void AliAnalysisThreadedEventLoop::MergeOutputs()
+{
+  for (Int_t itask = 0; itask < fTasks.GetEntriesFast(); itask++) {
+    AliAnalysisTask *task = static_cast<AliAnalysisTask *>(fTasks.UncheckedAt(itask));
+    for (Int_t islot = 0; islot < task->GetNoutputs(); islot++) {
+      TObject *merged = 0;
+      TList sources;
+      for (std::vector<ThreadContext *>::const_iterator it = fThreads.begin(); it != fThreads.end(); ++it) {
+        TObject *data = static_cast<AliAnalysisTask *>((*it)->fTasks.UncheckedAt(itask))->GetOutputData(islot);
+        if (!data) continue;
+        if (!merged) merged = data->Clone();
+        else sources.Add(data);
+      }
+      if (!merged) continue;
+      if (sources.GetEntries() && !MergeObjects(merged, &sources))
+        AliError(Form("Output %s of task %s cannot be merged, only the output of the first thread is kept", merged->GetName(), task->GetName()));
+      fOutputs.Add(merged);
+      task->GetOutputSlot(islot)->GetContainer()->SetData(merged);
+    }
+  }
+}
+
+/**
+ * Delete the merged outputs of the previous run. The output containers of the
+ * configured tasks still point to them, so they are replaced by new ones first.
+ */
+void AliAnalysisThreadedEventLoop::ResetOutputs()
+{
+  fContainers.Delete();
+  for (Int_t itask = 0; itask < fTasks.GetEntriesFast(); itask++) {
+    ConnectOutputs(static_cast<AliAnalysisTask *>(fTasks.UncheckedAt(itask)), fContainers);
+  }
+  fOutputs.Delete();
+}
+
+/**
+ * Write the merged outputs to the output file, in one directory per task
+ */
+void AliAnalysisThreadedEventLoop::WriteOutputs() const
+{
+  if (fOutputFileName.IsNull()) return;
+  TDirectory *current = gDirectory;
+  TFile *file = TFile::Open(fOutputFileName, "RECREATE");
+  if (!file || file->IsZombie()) {
+    AliError(Form("Cannot open output file %s", fOutputFileName.Data()));
+    delete file;
+    if (current) current->cd();
+    return;
+  }
+  for (Int_t itask = 0; itask < fTasks.GetEntriesFast(); itask++) {
+    AliAnalysisTask *task = static_cast<AliAnalysisTask *>(fTasks.UncheckedAt(itask));
+    TDirectory *dir = file->GetDirectory(task->GetName());
+    if (!dir) dir = file->mkdir(task->GetName());
+    dir->cd();
+    for (Int_t islot = 0; islot < task->GetNoutputs(); islot++) {
+      TObject *data = task->GetOutputData(islot);
+      if (data) data->Write(data->GetName(), TObject::kSingleKey);
+    }
+  }
+  file->Close();
+  delete file;
+  if (current) current->cd();
+}
+
+/**
+ * Delete the inputs and the task clones of the threads
+ */
+void AliAnalysisThreadedEventLoop::DeleteThreads()
+{
+  for (std::vector<ThreadContext *>::iterator it = fThreads.begin(); it != fThreads.end(); ++it) {
+    ThreadContext *context = *it;
+    context->fTasks.Delete();
+    context->fContainers.Delete();
+    delete context->fChain;
+    delete context->fEvent;
+    delete context;
+  }
+  fThreads.clear();
+}
@@ -0,0 +1,114 @@
+#ifndef ALIANALYSISTHREADEDEVENTLOOP_H
+#define ALIANALYSISTHREADEDEVENTLOOP_H
+/* Copyright(c) 1998-2026, ALICE Experiment at CERN, All rights reserved. *
+ * See cxx source for full Copyright notice                               */
+
+#include <vector>
+#include <TNamed.h>
+#include <TObjArray.h>
+#include <TString.h>
+
+class TChain;
+class TCollection;
+class AliAnalysisTask;
+class AliVEvent;
+
+/**
+ * @class AliAnalysisThreadedEventLoop
+ * @brief Thread-parallel event loop for re-entrant analysis tasks
+ *
+ * Runs a set of analysis tasks implementing AliAnalysisReentrantTask over the
+ * entries of an ESD or AOD chain with several threads. Each thread reads its
+ * own copy of the chain into its own event and runs its own clones of the
+ * tasks; the threads take blocks of consecutive entries until the requested
+ * range is done. At the end the outputs of the clones are merged (Merge(TCollection*)
+ * of the output objects, as for the merging of the outputs of grid jobs), the
+ * clones are deleted and the merged outputs are given to the configured tasks
+ * (GetOutputData), whose Terminate is then called. The merged outputs belong to
+ * the event loop, they are written to the output file (one directory per task)
+ * and kept until the next run.
+ *
+ * The configured tasks must not be connected to an analysis manager: their
+ * output slots are connected here to private containers. The first event of
+ * each run processed by a thread is executed under a global lock, so that the
+ * lazy initialisation of the tasks (geometry, OADB, ...) is serialised. The
+ * loop does not run the physics selection: for AOD input the offline trigger
+ * of the event header is compared to the collision candidates selected by the
+ * task, for ESD input the selection is not applied.
+ *
+ * ~~~{.cxx}
+ * AliAnalysisThreadedEventLoop loop("loop");
+ * loop.AddTask(new AliAnalysisTaskHistogram("histogram"));
+ * loop.SetNThreads(8);
+ * loop.Run(chain);
+ * ~~~
+ */
+class AliAnalysisThreadedEventLoop : public TNamed {
+public:
+  AliAnalysisThreadedEventLoop();
+  AliAnalysisThreadedEventLoop(const char *name);
+  virtual ~AliAnalysisThreadedEventLoop();
+
+  void                 AddTask(AliAnalysisTask *task);
+  void                 SetNThreads(Int_t nthreads)             { fNThreads = nthreads; }
+  void                 SetChunkSize(Int_t nentries)            { fChunkSize = nentries; }
+  void                 SetOutputFileName(const char *filename) { fOutputFileName = filename; }
+
+  Long64_t             Run(TChain *chain, Long64_t nentries = -1, Long64_t firstentry = 0);
+
+  const TObjArray     *GetTasks() const                        { return &fTasks; }
+  Int_t                GetNThreads() const                     { return fNThreads; }
+  Int_t                GetNThreadsUsed() const                 { return fNThreadsUsed; }
+  Long64_t             GetNEvents() const                      { return fNEvents; }
+  Double_t             GetRealTime() const                     { return fRealTime; }
+  Double_t             GetEventRate() const                    { return fRealTime > 0 ? fNEvents/fRealTime : 0.; }
+
+  static Bool_t        MergeObjects(TObject *target, TCollection *sources);
+
+protected:
+  /**
+   * @struct ThreadContext
+   * @brief Input and task clones of one thread
+   */
+  struct ThreadContext {
+    ThreadContext(): fChain(0), fEvent(0), fTasks(), fContainers(), fRunNumber(-1), fNEvents(0) {}
+
+    TChain                 *fChain;        ///< Copy of the input chain
+    AliVEvent              *fEvent;        ///< Event read from the chain
+    TObjArray               fTasks;        ///< Clones of the configured tasks
+    TObjArray               fContainers;   ///< Output containers of the clones
+    Int_t                   fRunNumber;    ///< Run of the last event
+    Long64_t                fNEvents;      ///< Number of events processed
+  };
+
+  void                 ConnectOutputs(AliAnalysisTask *task, TObjArray &containers) const;
+  Bool_t               InitThread(ThreadContext &context, TChain *chain, Long64_t firstentry);
+  void                 ProcessChunk(ThreadContext &context, Long64_t ichunk);
+  void                 ExecuteTasks(ThreadContext &context);
+  void                 MergeOutputs();
+  void                 ResetOutputs();
+  void                 WriteOutputs() const;
+  void                 DeleteThreads();
+
+  TObjArray                       fTasks;          ///< Configured tasks, receive the merged outputs
+  Int_t                           fNThreads;       ///< Number of threads
+  Int_t                           fChunkSize;      ///< Number of consecutive entries taken by a thread at once
+  TString                         fOutputFileName; ///< Output file, outputs are not written if empty
+  TObjArray                       fContainers;     //!<! Output containers of the configured tasks
+  TObjArray                       fOutputs;        //!<! Merged outputs of the last run
+  std::vector<ThreadContext*>     fThreads;        //!<! Inputs and task clones per thread
+  Bool_t                          fIsAOD;          //!<! Input are AOD events
+  Long64_t                        fFirstEntry;     //!<! First entry of the range in process
+  Long64_t                        fLastEntry;      //!<! Entry after the range in process
+  Int_t                           fNThreadsUsed;   //!<! Number of threads of the last run
+  Long64_t                        fNEvents;        //!<! Number of events processed in the last run
+  Double_t                        fRealTime;       //!<! Real time of the event loop of the last run
+
+private:
+  AliAnalysisThreadedEventLoop(const AliAnalysisThreadedEventLoop &);
+  AliAnalysisThreadedEventLoop &operator=(const AliAnalysisThreadedEventLoop &);
+
+  ClassDef(AliAnalysisThreadedEventLoop, 1);
+};
+
+#endif // ALIANALYSISTHREADEDEVENTLOOP_H
@@ -30,6 +30,8 @@
 #pragma link C++ class AliJSONBool+;
 #pragma link C++ class AliJSONString+;
 #pragma link C++ class AliAnalysisTaskDummy+;
+#pragma link C++ class AliAnalysisReentrantTask+;
+#pragma link C++ class AliAnalysisThreadedEventLoop+;
 #pragma link C++ class AliTLorentzVector+;
 #if ROOT_VERSION_CODE > ROOT_VERSION(6,4,0)
 #pragma link C++ namespace YAML+;
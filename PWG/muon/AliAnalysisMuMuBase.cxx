@@ -31,6 +31,11 @@
  * - \ref Event to access the current event
  * - \ref MCEvent to access to current MC event (if available)
  *
+ * In the filling methods, which are called for each event, track or pair, histograms should
+ * rather be accessed by handle : \ref PathId gives the id of a directory of the histogram
+ * collection, \ref HistoId the id of a histogram name (to be registered once, outside the
+ * loops) and \ref Histo(Int_t,Int_t) / \ref Prof(Int_t,Int_t) the histogram itself.
+ *
  * A few trivial cut methods (\ref AlwaysTrue and \ref AlwaysFalse) are defined as well and
  * can be used to register some control cut combinations (see \ref AliAnalysisMuMuCutCombination)
  *
@@ -58,6 +63,39 @@
 
 ClassImp(AliAnalysisMuMuBase)
 
+namespace
+{
+  /// FNV-1a hash of the path /piece[0]/piece[1]/.../piece[n-1]/, fed piece by piece
+  ULong64_t HashPath(const char* const* pieces, Int_t n)
+  {
+    ULong64_t h = 14695981039346656037ULL;
+    for ( Int_t i = 0; i < n; ++i )
+    {
+      h = ( h ^ '/' ) * 1099511628211ULL;
+      for ( const char* c = pieces[i]; *c; ++c )
+      {
+        h = ( h ^ static_cast<UChar_t>(*c) ) * 1099511628211ULL;
+      }
+    }
+    return ( h ^ '/' ) * 1099511628211ULL;
+  }
+
+  /// whether path is /piece[0]/piece[1]/.../piece[n-1]/
+  Bool_t MatchPath(const std::string& path, const char* const* pieces, Int_t n)
+  {
+    const char* p = path.c_str();
+    for ( Int_t i = 0; i < n; ++i )
+    {
+      if ( *p++ != '/' ) return kFALSE;
+      for ( const char* c = pieces[i]; *c; ++c, ++p )
+      {
+        if ( *p != *c ) return kFALSE;
+      }
+    }
+    return ( p[0] == '/' && p[1] == '\0' );
+  }
+}
+
 //_____________________________________________________________________________
 AliAnalysisMuMuBase::AliAnalysisMuMuBase()
 :
@@ -69,7 +107,13 @@ fCutRegistry(0x0),
 fEvent(0x0),
 fMCEvent(0x0),
 fHistogramToDisable(0x0),
-fHasMC(kFALSE)
+fHasMC(kFALSE),
+fPathIndex(),
+fPaths(),
+fHistoIndex(),
+fHistoNames(),
+fHistoDisabled(),
+fHandles()
 {
  /// default ctor
 }
@@ -407,6 +451,8 @@ void AliAnalysisMuMuBase::DisableHistograms(const char* pattern)
   }
 
   fHistogramToDisable->Add(new TObjString(spattern));
+
+  fHistoDisabled.clear();
 }
 
 //_____________________________________________________________________________
@@ -518,6 +564,8 @@ void AliAnalysisMuMuBase::Init(AliCounterCollection& cc,
   fHistogramCollection = &hc;
   fBinning             = &binning;
   fCutRegistry         = &registry;
+
+  ResetHistogramHandles();
 }
 
 //_____________________________________________________________________________
@@ -638,6 +686,129 @@ TProfile* AliAnalysisMuMuBase::MCProf(const char* eventSelection,
 	return fHistogramCollection ? static_cast<TProfile*>(fHistogramCollection->GetObject(Form("/%s/%s/%s/%s/%s",MCInputPrefix(),eventSelection,triggerClassName,cent,what),histoname)) : 0x0;
 }
 
+//_____________________________________________________________________________
+Int_t AliAnalysisMuMuBase::PathId(const char* eventSelection, const char* triggerClassName,
+                                  const char* centrality, const char* cut, Bool_t mc)
+{
+  /// Get the id of the path BuildPath(eventSelection,triggerClassName,centrality,cut)
+  /// (or BuildMCPath if mc is true), registering it the first time.
+
+  const char* pieces[5];
+  Int_t n(0);
+
+  if ( mc ) pieces[n++] = MCInputPrefix();
+  pieces[n++] = eventSelection;
+  pieces[n++] = triggerClassName;
+  pieces[n++] = centrality;
+  if ( cut && cut[0] != '\0' ) pieces[n++] = cut;
+
+  ULong64_t hash = HashPath(pieces,n);
+
+  std::pair<std::multimap<ULong64_t,Int_t>::const_iterator,std::multimap<ULong64_t,Int_t>::const_iterator> range = fPathIndex.equal_range(hash);
+
+  for ( std::multimap<ULong64_t,Int_t>::const_iterator it = range.first; it != range.second; ++it )
+  {
+    if ( MatchPath(fPaths[it->second],pieces,n) ) return it->second;
+  }
+
+  TString path = mc ? BuildMCPath(eventSelection,triggerClassName,centrality,cut ? cut : "")
+                    : BuildPath(eventSelection,triggerClassName,centrality,cut ? cut : "");
+
+  Int_t id = fPaths.size();
+
+  fPaths.push_back(path.Data());
+  fHandles.push_back(std::vector<TObject*>(fHistoNames.size(),0x0));
+  fPathIndex.insert(std::make_pair(hash,id));
+
+  return id;
+}
+
+//_____________________________________________________________________________
+Int_t AliAnalysisMuMuBase::HistoId(const char* histoname)
+{
+  /// Get the id of a histogram name, registering it the first time
+
+  std::map<std::string,Int_t>::const_iterator it = fHistoIndex.find(histoname);
+
+  if ( it != fHistoIndex.end() ) return it->second;
+
+  Int_t id = fHistoNames.size();
+
+  fHistoNames.push_back(histoname);
+  fHistoIndex[histoname] = id;
+
+  return id;
+}
+
+//_____________________________________________________________________________
+TObject* AliAnalysisMuMuBase::ResolveHandle(Int_t pathId, Int_t histoId)
+{
+  /// Look up the object histoId of the path pathId in the histogram collection.
+  /// Objects not found are not remembered, so they are searched for again on the next
+  /// request (they might be created later on).
+
+  std::vector<TObject*>& row = fHandles[pathId];
+
+  if ( histoId >= static_cast<Int_t>(row.size()) )
+  {
+    row.resize(fHistoNames.size(),0x0);
+  }
+
+  if ( !fHistogramCollection ) return 0x0;
+
+  row[histoId] = fHistogramCollection->GetObject(fPaths[pathId].c_str(),fHistoNames[histoId].c_str());
+
+  return row[histoId];
+}
+
+//_____________________________________________________________________________
+Bool_t AliAnalysisMuMuBase::AdoptObject(Int_t pathId, Int_t histoId, TObject* o)
+{
+  /// Adopt o (which must be named HistoName(histoId)) in the path pathId of the histogram collection
+
+  if ( !fHistogramCollection || !o ) return kFALSE;
+
+  if ( !fHistogramCollection->Adopt(fPaths[pathId].c_str(),o) ) return kFALSE;
+
+  std::vector<TObject*>& row = fHandles[pathId];
+
+  if ( histoId >= static_cast<Int_t>(row.size()) )
+  {
+    row.resize(fHistoNames.size(),0x0);
+  }
+
+  row[histoId] = o;
+
+  return kTRUE;
+}
+
+//_____________________________________________________________________________
+Bool_t AliAnalysisMuMuBase::UpdateHistogramDisabled(Int_t histoId)
+{
+  /// Compute (and cache) IsHistogramDisabled(HistoName(histoId))
+
+  if ( histoId >= static_cast<Int_t>(fHistoDisabled.size()) )
+  {
+    fHistoDisabled.resize(fHistoNames.size(),-1);
+  }
+
+  fHistoDisabled[histoId] = IsHistogramDisabled(fHistoNames[histoId].c_str()) ? 1 : 0;
+
+  return fHistoDisabled[histoId];
+}
+
+//_____________________________________________________________________________
+void AliAnalysisMuMuBase::ResetHistogramHandles()
+{
+  /// Forget the objects resolved so far (e.g. because the histogram collection changed).
+  /// The path and histogram ids stay valid.
+
+  for ( std::vector< std::vector<TObject*> >::iterator it = fHandles.begin(); it != fHandles.end(); ++it )
+  {
+    it->assign(it->size(),0x0);
+  }
+}
+
 //_____________________________________________________________________________
 void AliAnalysisMuMuBase::SetEvent(AliVEvent* event, AliMCEvent* mcEvent)
 {
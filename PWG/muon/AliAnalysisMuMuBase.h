@@ -13,6 +13,9 @@
 #include "TObject.h"
 #include "TString.h"
 #include "TProfile.h"
+#include <map>
+#include <string>
+#include <vector>
 
 class AliCounterCollection;
 class AliAnalysisMuMuBinning;
@@ -101,7 +104,7 @@ public:
   Bool_t AlwaysFalse(const AliVParticle& /*particle*/, const AliVParticle& /*particle*/) const { return kFALSE; }
   void NameOfAlwaysFalse(TString& name) const { name = "NONE"; }
 
-  void SetHistogramCollection(AliMergeableCollection* h) { fHistogramCollection = h; }
+  void SetHistogramCollection(AliMergeableCollection* h) { fHistogramCollection = h; ResetHistogramHandles(); }
 
 protected:
 
@@ -192,6 +195,45 @@ protected:
   TProfile* MCProf(const char* eventSelection, const char* triggerClassName, const char* cent,
                  const char* what, const char* histoname);
 
+  /** Handle based access to the histograms, for the filling methods.
+   *
+   * A path id identifies one (eventSelection,triggerClassName,centrality[,cut]) directory of the
+   * histogram collection (under MCInputPrefix() if mc is true), a histogram id identifies one
+   * histogram name. Histogram ids are meant to be registered once (e.g. when the binning is known),
+   * path ids are obtained by hashing the strings, without formatting any path.
+   * The object of a (path id,histogram id) pair is looked up in the collection the first time
+   * it is requested, and then served by array indexing.
+   */
+  Int_t PathId(const char* eventSelection, const char* triggerClassName, const char* centrality,
+               const char* cut="", Bool_t mc=kFALSE);
+
+  Int_t HistoId(const char* histoname);
+
+  const char* HistoName(Int_t histoId) const { return fHistoNames[histoId].c_str(); }
+
+  const char* PathName(Int_t pathId) const { return fPaths[pathId].c_str(); }
+
+  TObject* Object(Int_t pathId, Int_t histoId)
+  {
+    const std::vector<TObject*>& row = fHandles[pathId];
+    if ( histoId < static_cast<Int_t>(row.size()) && row[histoId] ) return row[histoId];
+    return ResolveHandle(pathId,histoId);
+  }
+
+  TH1* Histo(Int_t pathId, Int_t histoId) { return static_cast<TH1*>(Object(pathId,histoId)); }
+
+  TProfile* Prof(Int_t pathId, Int_t histoId) { return static_cast<TProfile*>(Object(pathId,histoId)); }
+
+  Bool_t AdoptObject(Int_t pathId, Int_t histoId, TObject* o);
+
+  Bool_t IsHistogramDisabled(Int_t histoId)
+  {
+    if ( histoId >= static_cast<Int_t>(fHistoDisabled.size()) || fHistoDisabled[histoId] < 0 ) return UpdateHistogramDisabled(histoId);
+    return fHistoDisabled[histoId];
+  }
+
+  void ResetHistogramHandles();
+
   Int_t GetNbins(Double_t xmin, Double_t xmax, Double_t xstep);
 
   AliCounterCollection* CounterCollection() const { return fEventCounters; }
@@ -206,6 +248,10 @@ private:
   /// not implemented on purpose
   AliAnalysisMuMuBase(const AliAnalysisMuMuBase& rhs);
 
+  TObject* ResolveHandle(Int_t pathId, Int_t histoId);
+
+  Bool_t UpdateHistogramDisabled(Int_t histoId);
+
   AliCounterCollection* fEventCounters; //! event counters
   AliMergeableCollection* fHistogramCollection; //! collection of histograms
   const AliAnalysisMuMuBinning* fBinning; //! binning for particles
@@ -214,8 +260,14 @@ private:
   AliMCEvent* fMCEvent; //! current MC event
   TList* fHistogramToDisable; // list of regexp of histo name to disable
   Bool_t fHasMC; // whether or not we're dealing with MC data
-
-  ClassDef(AliAnalysisMuMuBase,1) // base class for a companion class to AliAnalysisMuMu
+  std::multimap<ULong64_t,Int_t> fPathIndex; //! path hash -> path id
+  std::vector<std::string> fPaths; //! path of each path id
+  std::map<std::string,Int_t> fHistoIndex; //! histogram name -> histogram id
+  std::vector<std::string> fHistoNames; //! name of each histogram id
+  std::vector<Int_t> fHistoDisabled; //! IsHistogramDisabled(name) per histogram id (-1 = not yet known)
+  std::vector< std::vector<TObject*> > fHandles; //! resolved objects, per path id and histogram id
+
+  ClassDef(AliAnalysisMuMuBase,2) // base class for a companion class to AliAnalysisMuMu
 };
 
 #endif
@@ -31,6 +31,28 @@ ClassImp(AliAnalysisMuMuGlobal)
 AliAnalysisMuMuGlobal::AliAnalysisMuMuGlobal() : AliAnalysisMuMuBase()
 {
   /// ctor
+  RegisterEventHistoIds();
+}
+
+//_____________________________________________________________________________
+void AliAnalysisMuMuGlobal::RegisterEventHistoIds()
+{
+  /// Register the ids of the histograms filled in FillHistosForEvent and FillHistosForMCEvent
+
+  const char* names[kNofEventHistos] = {
+    "BCX", "Nevents", "EventsWOL0inputs", "Xvertex", "Yvertex", "Zvertex", "ZvertexMinusZvertexSPD",
+    "SPDXvertex", "SPDYvertex", "SPDZvertex", "SPDZvertexNContributors",
+    "ZvertexMinusSPDZvertexNContributors", "SPDZvertexResolutionNContributors", "SPDVertexType",
+    "VertexType", "VertexClass", "ZvertexNContributors", "T0Zvertex", "V0AMult", "V0CMult", "V0TotMult",
+    "V02D", "V02DwT0BG", "V02DwT0PU", "PileUpEstimators", "V02DwT0SAT", "V02DwT0BB", "RecZvertexVsMCZvertex",
+    "RecSPDZvertexVsMCZvertex", "NofEvWSPDZvertexVsMCZvertex", "NofEvWSPDZvertexAndNoVtexerZVsMCZvertex",
+    "NofEvPassingVtxQAVsMCZvertex", "NofEvNotPassingVtxResCutVsMCZvertex",
+    "NofEvWSPDZvertexAndVtexerZVsMCZvertex", "NofEvWOSPDZvertexVsMCZvertex" };
+
+  for ( Int_t i = 0; i < kNofEventHistos; ++i )
+  {
+    fEventHistoId[i] = HistoId(names[i]);
+  }
 }
 
 //_____________________________________________________________________________
@@ -45,24 +67,24 @@ Bool_t AliAnalysisMuMuGlobal::SelectAnyTriggerClass(const TString& firedTriggerC
 }
 
 //_____________________________________________________________________________
-void AliAnalysisMuMuGlobal::FillHistosForEvent(AliMergeableCollectionProxy& p)
+void AliAnalysisMuMuGlobal::FillHistosForEvent(Int_t pathId)
 {
-  // Fill event-wise histograms
+  // Fill event-wise histograms, in the path pathId
   
-  if (!IsHistogramDisabled("BCX"))
+  if (!IsHistogramDisabled(fEventHistoId[kBCX]))
   {
-    p.Histo("BCX")->Fill(1.0*Event()->GetBunchCrossNumber());
+    Histo(pathId,fEventHistoId[kBCX])->Fill(1.0*Event()->GetBunchCrossNumber());
   }
-  if (!IsHistogramDisabled("Nevents"))
+  if (!IsHistogramDisabled(fEventHistoId[kNevents]))
   {
-    p.Histo("Nevents")->Fill(1.0);
+    Histo(pathId,fEventHistoId[kNevents])->Fill(1.0);
   }
   
-  if (!IsHistogramDisabled("EventsWOL0inputs"))
+  if (!IsHistogramDisabled(fEventHistoId[kEventsWOL0inputs]))
   {
     UInt_t l0 = Event()->GetHeader()->GetL0TriggerInputs();
     
-    if ( l0 == 0 ) p.Histo("EventsWOL0inputs")->Fill(1.);
+    if ( l0 == 0 ) Histo(pathId,fEventHistoId[kEventsWOL0inputs])->Fill(1.);
   }
   
   const AliVVertex* vertex = Event()->GetPrimaryVertex();
@@ -72,69 +94,69 @@ void AliAnalysisMuMuGlobal::FillHistosForEvent(AliMergeableCollectionProxy& p)
   {
     if ( vertex->GetNContributors() > 0 )
     {
-      if (!IsHistogramDisabled("Xvertex"))
+      if (!IsHistogramDisabled(fEventHistoId[kXvertex]))
       {
-        p.Histo("Xvertex")->Fill(vertex->GetX());
+        Histo(pathId,fEventHistoId[kXvertex])->Fill(vertex->GetX());
       }
-      if (!IsHistogramDisabled("Yvertex"))
+      if (!IsHistogramDisabled(fEventHistoId[kYvertex]))
       {
-        p.Histo("Yvertex")->Fill(vertex->GetY());
+        Histo(pathId,fEventHistoId[kYvertex])->Fill(vertex->GetY());
       }
-      if (!IsHistogramDisabled("Zvertex"))
+      if (!IsHistogramDisabled(fEventHistoId[kZvertex]))
       {
-        p.Histo("Zvertex")->Fill(vertex->GetZ());
+        Histo(pathId,fEventHistoId[kZvertex])->Fill(vertex->GetZ());
       }
       if ( vertexFromSPD )
       {
-        if (!IsHistogramDisabled("ZvertexMinusZvertexSPD"))
+        if (!IsHistogramDisabled(fEventHistoId[kZvertexMinusZvertexSPD]))
         {
-          p.Histo("ZvertexMinusZvertexSPD")->Fill(vertexFromSPD->GetZ()-vertex->GetZ());
+          Histo(pathId,fEventHistoId[kZvertexMinusZvertexSPD])->Fill(vertexFromSPD->GetZ()-vertex->GetZ());
         }
-        if (!IsHistogramDisabled("SPDXvertex"))
+        if (!IsHistogramDisabled(fEventHistoId[kSPDXvertex]))
         {
-          p.Histo("SPDXvertex")->Fill(vertexFromSPD->GetX());
+          Histo(pathId,fEventHistoId[kSPDXvertex])->Fill(vertexFromSPD->GetX());
         }
-        if (!IsHistogramDisabled("SPDYvertex"))
+        if (!IsHistogramDisabled(fEventHistoId[kSPDYvertex]))
         {
-          p.Histo("SPDYvertex")->Fill(vertexFromSPD->GetY());
+          Histo(pathId,fEventHistoId[kSPDYvertex])->Fill(vertexFromSPD->GetY());
         }
-        if (!IsHistogramDisabled("SPDZvertex"))
+        if (!IsHistogramDisabled(fEventHistoId[kSPDZvertex]))
         {
-          p.Histo("SPDZvertex")->Fill(vertexFromSPD->GetZ());
+          Histo(pathId,fEventHistoId[kSPDZvertex])->Fill(vertexFromSPD->GetZ());
         }
-        if (!IsHistogramDisabled("SPDZvertexNContributors"))
+        if (!IsHistogramDisabled(fEventHistoId[kSPDZvertexNContributors]))
         {
-          p.Histo("SPDZvertexNContributors")->Fill(vertexFromSPD->GetNContributors());
+          Histo(pathId,fEventHistoId[kSPDZvertexNContributors])->Fill(vertexFromSPD->GetNContributors());
         }
-        if (!IsHistogramDisabled("ZvertexMinusSPDZvertexNContributors"))
+        if (!IsHistogramDisabled(fEventHistoId[kZvertexMinusSPDZvertexNContributors]))
         {
-          p.Histo("ZvertexMinusSPDZvertexNContributors")->Fill(vertexFromSPD->GetNContributors(),vertex->GetZ() - vertexFromSPD->GetZ());
+          Histo(pathId,fEventHistoId[kZvertexMinusSPDZvertexNContributors])->Fill(vertexFromSPD->GetNContributors(),vertex->GetZ() - vertexFromSPD->GetZ());
         }
-        if (!IsHistogramDisabled("SPDZvertexResolutionNContributors"))
+        if (!IsHistogramDisabled(fEventHistoId[kSPDZvertexResolutionNContributors]))
         {
           Double_t cov[6]={0};
           static_cast<const AliAODVertex*>(vertexFromSPD)->GetCovarianceMatrix(cov);
           
-          p.Histo("SPDZvertexResolutionNContributors")->Fill(vertexFromSPD->GetNContributors(),TMath::Sqrt(cov[5]));
+          Histo(pathId,fEventHistoId[kSPDZvertexResolutionNContributors])->Fill(vertexFromSPD->GetNContributors(),TMath::Sqrt(cov[5]));
         }
-        if (!IsHistogramDisabled("SPDVertexType"))
+        if (!IsHistogramDisabled(fEventHistoId[kSPDVertexType]))
         {
-          p.Histo("SPDVertexType")->Fill(vertexFromSPD->GetTitle(),1.0);
+          Histo(pathId,fEventHistoId[kSPDVertexType])->Fill(vertexFromSPD->GetTitle(),1.0);
         }
         
       }
-      if (!IsHistogramDisabled("VertexType"))
+      if (!IsHistogramDisabled(fEventHistoId[kVertexType]))
       {
-        p.Histo("VertexType")->Fill(vertex->GetTitle(),1.0);
+        Histo(pathId,fEventHistoId[kVertexType])->Fill(vertex->GetTitle(),1.0);
       }
-      if (!IsHistogramDisabled("VertexClass"))
+      if (!IsHistogramDisabled(fEventHistoId[kVertexClass]))
       {
-        p.Histo("VertexClass")->Fill(static_cast<const AliAODVertex*>(vertex)->GetType(),1.0);
+        Histo(pathId,fEventHistoId[kVertexClass])->Fill(static_cast<const AliAODVertex*>(vertex)->GetType(),1.0);
       }
     }
-    if (!IsHistogramDisabled("ZvertexNContributors"))
+    if (!IsHistogramDisabled(fEventHistoId[kZvertexNContributors]))
     {
-      p.Histo("ZvertexNContributors")->Fill(vertex->GetNContributors());
+      Histo(pathId,fEventHistoId[kZvertexNContributors])->Fill(vertex->GetNContributors());
     }
   }
   
@@ -142,18 +164,18 @@ void AliAnalysisMuMuGlobal::FillHistosForEvent(AliMergeableCollectionProxy& p)
   {
     const AliAODTZERO* tzero = static_cast<const AliAODEvent*>(Event())->GetTZEROData();
     
-    if (tzero && !IsHistogramDisabled("T0Zvertex"))
+    if (tzero && !IsHistogramDisabled(fEventHistoId[kT0Zvertex]))
     {
-      p.Histo("T0Zvertex")->Fill(tzero->GetT0VertexRaw());
+      Histo(pathId,fEventHistoId[kT0Zvertex])->Fill(tzero->GetT0VertexRaw());
     }
   }
   else
   {
     const AliESDTZERO* tzero = static_cast<const AliESDEvent*>(Event())->GetESDTZERO();
     
-    if (tzero && !IsHistogramDisabled("T0Zvertex"))
+    if (tzero && !IsHistogramDisabled(fEventHistoId[kT0Zvertex]))
     {
-      p.Histo("T0Zvertex")->Fill(tzero->GetT0zVertex());
+      Histo(pathId,fEventHistoId[kT0Zvertex])->Fill(tzero->GetT0zVertex());
     }
   }
   
@@ -176,24 +198,24 @@ void AliAnalysisMuMuGlobal::FillHistosForEvent(AliMergeableCollectionProxy& p)
       Float_t v0aMult = AliESDUtils::GetCorrV0A(multV0A,vertexFromSPD->GetZ());
       Float_t v0cMult = AliESDUtils::GetCorrV0C(multV0C,vertexFromSPD->GetZ());
       
-      if (!IsHistogramDisabled("V0AMult"))
+      if (!IsHistogramDisabled(fEventHistoId[kV0AMult]))
       {
-        p.Histo("V0AMult")->Fill(v0aMult);
+        Histo(pathId,fEventHistoId[kV0AMult])->Fill(v0aMult);
       }
-      if (!IsHistogramDisabled("V0CMult"))
+      if (!IsHistogramDisabled(fEventHistoId[kV0CMult]))
       {
-        p.Histo("V0CMult")->Fill(v0cMult);
+        Histo(pathId,fEventHistoId[kV0CMult])->Fill(v0cMult);
       }
-      if (!IsHistogramDisabled("V0TotMult"))
+      if (!IsHistogramDisabled(fEventHistoId[kV0TotMult]))
       {
-        p.Histo("V0TotMult")->Fill(multV0);
+        Histo(pathId,fEventHistoId[kV0TotMult])->Fill(multV0);
       }
     }
     
     
-    if (!IsHistogramDisabled("V02D"))
+    if (!IsHistogramDisabled(fEventHistoId[kV02D]))
     {
-      p.Histo("V02D")->Fill(x,y);
+      Histo(pathId,fEventHistoId[kV02D])->Fill(x,y);
     }
     
     Bool_t background,pileup,satellite;
@@ -204,38 +226,38 @@ void AliAnalysisMuMuGlobal::FillHistosForEvent(AliMergeableCollectionProxy& p)
     {
       if ( background )
       {
-        if (!IsHistogramDisabled("V02DwT0BG"))
+        if (!IsHistogramDisabled(fEventHistoId[kV02DwT0BG]))
         {
-          p.Histo("V02DwT0BG")->Fill(x,y);
+          Histo(pathId,fEventHistoId[kV02DwT0BG])->Fill(x,y);
         }
       }
       
       if ( pileup )
       {
-        if (!IsHistogramDisabled("V02DwT0PU"))
+        if (!IsHistogramDisabled(fEventHistoId[kV02DwT0PU]))
         {
-          p.Histo("V02DwT0PU")->Fill(x,y);
+          Histo(pathId,fEventHistoId[kV02DwT0PU])->Fill(x,y);
         }
         
-        if ( !IsHistogramDisabled("PileUpEstimators") )
+        if ( !IsHistogramDisabled(fEventHistoId[kPileUpEstimators]) )
         {
-          p.Histo("PileUpEstimators")->Fill("TZERO",1.0);
+          Histo(pathId,fEventHistoId[kPileUpEstimators])->Fill("TZERO",1.0);
         }
       }
       
       if ( satellite )
       {
-        if (!IsHistogramDisabled("V02DwT0SAT"))
+        if (!IsHistogramDisabled(fEventHistoId[kV02DwT0SAT]))
         {
-          p.Histo("V02DwT0SAT")->Fill(x,y);
+          Histo(pathId,fEventHistoId[kV02DwT0SAT])->Fill(x,y);
         }
       }
       
       if ( !background && !pileup && !satellite )
       {
-        if (!IsHistogramDisabled("V02DwT0BB"))
+        if (!IsHistogramDisabled(fEventHistoId[kV02DwT0BB]))
         {
-          p.Histo("V02DwT0BB")->Fill(x,y);
+          Histo(pathId,fEventHistoId[kV02DwT0BB])->Fill(x,y);
         }
       }
     }
@@ -244,7 +266,7 @@ void AliAnalysisMuMuGlobal::FillHistosForEvent(AliMergeableCollectionProxy& p)
   //  /* FIXME : how to properly get multiplicity from AOD and ESD consistently ?
   //   is is doable at all ?
   
-  TH1* hpileup = p.Histo("PileUpEstimators");
+  TH1* hpileup = Histo(pathId,fEventHistoId[kPileUpEstimators]);
   
   
   //  virtual Bool_t  IsPileupFromSPD(Int_t minContributors=3, Double_t minZdist=0.8, Double_t nSigmaZdist=3., Double_t nSigmaDiamXY=2., Double_t nSigmaDiamZ=5.) const;
@@ -266,34 +288,34 @@ void AliAnalysisMuMuGlobal::FillHistosForEvent(AliMergeableCollectionProxy& p)
 }
 
 //_____________________________________________________________________________
-void AliAnalysisMuMuGlobal::FillHistosForMCEvent(AliMergeableCollectionProxy& p)
+void AliAnalysisMuMuGlobal::FillHistosForMCEvent(Int_t pathId)
 {
-  // Fill MCEvent-wise histograms
+  // Fill MCEvent-wise histograms, in the path pathId
   
   Double_t Zvertex = AliAnalysisMuonUtility::GetMCVertexZ(Event(),MCEvent());
   
-  if (!IsHistogramDisabled("Zvertex"))
+  if (!IsHistogramDisabled(fEventHistoId[kZvertex]))
   {
-    p.Histo("Zvertex")->Fill(Zvertex);
+    Histo(pathId,fEventHistoId[kZvertex])->Fill(Zvertex);
   }
   
-  if (!IsHistogramDisabled("RecZvertexVsMCZvertex"))
+  if (!IsHistogramDisabled(fEventHistoId[kRecZvertexVsMCZvertex]))
   {
     const AliVVertex* vertex = Event()->GetPrimaryVertex();
     if  (vertex && vertex->GetNContributors()>0)
     {
-      p.Histo("RecZvertexVsMCZvertex")->Fill(Zvertex,vertex->GetZ());
+      Histo(pathId,fEventHistoId[kRecZvertexVsMCZvertex])->Fill(Zvertex,vertex->GetZ());
     }
     
     const AliVVertex* vertexFromSPD = Event()->GetPrimaryVertexSPD();
     if  (vertexFromSPD && vertexFromSPD->GetNContributors()>0)
     {
-      p.Histo("RecSPDZvertexVsMCZvertex")->Fill(Zvertex,vertexFromSPD->GetZ());
-      p.Histo("NofEvWSPDZvertexVsMCZvertex")->Fill(Zvertex,1);
+      Histo(pathId,fEventHistoId[kRecSPDZvertexVsMCZvertex])->Fill(Zvertex,vertexFromSPD->GetZ());
+      Histo(pathId,fEventHistoId[kNofEvWSPDZvertexVsMCZvertex])->Fill(Zvertex,1);
       
       if ( !vertexFromSPD->IsFromVertexerZ() )
       {
-        p.Histo("NofEvWSPDZvertexAndNoVtexerZVsMCZvertex")->Fill(Zvertex,1);
+        Histo(pathId,fEventHistoId[kNofEvWSPDZvertexAndNoVtexerZVsMCZvertex])->Fill(Zvertex,1);
         
         Double_t cov[6]={0};
         vertexFromSPD->GetCovarianceMatrix(cov);
@@ -301,13 +323,13 @@ void AliAnalysisMuMuGlobal::FillHistosForMCEvent(AliMergeableCollectionProxy& p)
         Double_t zvertex = vertexFromSPD->GetZ();
         if ( (zRes <= 0.25) && TMath::Abs(zvertex - vertex->GetZ()) <= 0.5 ) //These events are those passing AliAnalysisMuMuEventCutter::IsSPDzQA()
         {
-          p.Histo("NofEvPassingVtxQAVsMCZvertex")->Fill(Zvertex,1);
+          Histo(pathId,fEventHistoId[kNofEvPassingVtxQAVsMCZvertex])->Fill(Zvertex,1);
         }
-        else p.Histo("NofEvNotPassingVtxResCutVsMCZvertex")->Fill(Zvertex,1);
+        else Histo(pathId,fEventHistoId[kNofEvNotPassingVtxResCutVsMCZvertex])->Fill(Zvertex,1);
       }
-      else p.Histo("NofEvWSPDZvertexAndVtexerZVsMCZvertex")->Fill(Zvertex,1);
+      else Histo(pathId,fEventHistoId[kNofEvWSPDZvertexAndVtexerZVsMCZvertex])->Fill(Zvertex,1);
     }
-    else p.Histo("NofEvWOSPDZvertexVsMCZvertex")->Fill(Zvertex,1);
+    else Histo(pathId,fEventHistoId[kNofEvWOSPDZvertexVsMCZvertex])->Fill(Zvertex,1);
   }
 }
 
@@ -318,11 +340,7 @@ void AliAnalysisMuMuGlobal::FillHistosForEvent(const char* eventSelection,
 {
   // Fill event-wise histograms
   
-  AliMergeableCollectionProxy* proxy = HistogramCollection()->CreateProxy(BuildPath(eventSelection,triggerClassName,centrality));
-
-  FillHistosForEvent(*proxy);
-  
-  delete proxy;
+  FillHistosForEvent(PathId(eventSelection,triggerClassName,centrality));
 }
 
 //_____________________________________________________________________________
@@ -332,11 +350,7 @@ void AliAnalysisMuMuGlobal::FillHistosForMCEvent(const char* eventSelection,
 {
   // Fill MCEvent-wise histograms
 
-  AliMergeableCollectionProxy* proxy = HistogramCollection()->CreateProxy(BuildPath(eventSelection,triggerClassName,centrality));
-
-  FillHistosForMCEvent(*proxy);
-  
-  delete proxy;
+  FillHistosForMCEvent(PathId(eventSelection,triggerClassName,centrality));
 }
 
 //_____________________________________________________________________________
@@ -9,8 +9,6 @@
 
 #include "AliAnalysisMuMuBase.h"
 
-class AliMergeableCollectionProxy;
-
 class AliAnalysisMuMuGlobal : public AliAnalysisMuMuBase
 {
 public:
@@ -31,10 +29,55 @@ public:
 
 private:
   
-  void FillHistosForEvent(AliMergeableCollectionProxy& p);
-  void FillHistosForMCEvent(AliMergeableCollectionProxy& p);
+  /// histograms filled for each event
+  enum EEventHisto
+  {
+    kBCX,
+    kNevents,
+    kEventsWOL0inputs,
+    kXvertex,
+    kYvertex,
+    kZvertex,
+    kZvertexMinusZvertexSPD,
+    kSPDXvertex,
+    kSPDYvertex,
+    kSPDZvertex,
+    kSPDZvertexNContributors,
+    kZvertexMinusSPDZvertexNContributors,
+    kSPDZvertexResolutionNContributors,
+    kSPDVertexType,
+    kVertexType,
+    kVertexClass,
+    kZvertexNContributors,
+    kT0Zvertex,
+    kV0AMult,
+    kV0CMult,
+    kV0TotMult,
+    kV02D,
+    kV02DwT0BG,
+    kV02DwT0PU,
+    kPileUpEstimators,
+    kV02DwT0SAT,
+    kV02DwT0BB,
+    kRecZvertexVsMCZvertex,
+    kRecSPDZvertexVsMCZvertex,
+    kNofEvWSPDZvertexVsMCZvertex,
+    kNofEvWSPDZvertexAndNoVtexerZVsMCZvertex,
+    kNofEvPassingVtxQAVsMCZvertex,
+    kNofEvNotPassingVtxResCutVsMCZvertex,
+    kNofEvWSPDZvertexAndVtexerZVsMCZvertex,
+    kNofEvWOSPDZvertexVsMCZvertex,
+    kNofEventHistos
+  };
+
+  void RegisterEventHistoIds();
+
+  void FillHistosForEvent(Int_t pathId);
+  void FillHistosForMCEvent(Int_t pathId);
   
-  ClassDef(AliAnalysisMuMuGlobal,1) // implementation of AliAnalysisMuMuBase for global event properties
+  Int_t fEventHistoId[kNofEventHistos]; //! histogram ids
+
+  ClassDef(AliAnalysisMuMuGlobal,2) // implementation of AliAnalysisMuMuBase for global event properties
 };
 
 #endif
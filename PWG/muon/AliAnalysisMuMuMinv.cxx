@@ -49,7 +49,8 @@ fMinvBinSize(0.025),
 fMinvMin(0.0),
 fMinvMax(16.0),
 fmcptcutmin(0.0),
-fmcptcutmax(12.0)
+fmcptcutmax(12.0),
+fHistoIds()
 {
   // FIXME ? find the AccxEff histogram from HistogramCollection()->Histo("/EXCHANGE/JpsiAccEff")
 
@@ -77,14 +78,17 @@ AliAnalysisMuMuMinv::DefineHistogramCollection(const char* eventSelection,
 {
   /// Define the histograms this analysis will use
 
+  // no bins defined by the external steering macro, use our own defaults
+  if (!fBinsToFill) SetBinsToFill("psi","integrated,ptvsy,yvspt,pt,y,phi,ntrcorr,ntr,nch,v0a,v0acorr,v0ccorr,v0mcorr");
+
+  // ids of the histograms filled for each pair
+  if ( fHistoIds.empty() ) RegisterHistoIds();
+
   // Check if histo is not already here
   if ( ExistSemaphoreHistogram(eventSelection,triggerClassName,centrality) ) return;
 
   CreateSemaphoreHistogram(eventSelection,triggerClassName,centrality);
 
-  // no bins defined by the external steering macro, use our own defaults
-  if (!fBinsToFill) SetBinsToFill("psi","integrated,ptvsy,yvspt,pt,y,phi,ntrcorr,ntr,nch,v0a,v0acorr,v0ccorr,v0mcorr");
-
   // mass range
   Double_t minvMin = fMinvMin;
   Double_t minvMax = fMinvMax;
@@ -328,11 +332,14 @@ void AliAnalysisMuMuMinv::FillHistosForPair(const char* eventSelection,
   // Usual cuts
   if (!AliAnalysisMuonUtility::IsMuonTrack(&tracki) || !AliAnalysisMuonUtility::IsMuonTrack(&trackj) ) return;
 
-  // Get total charge in order to get the correct histo name
+  if ( fHistoIds.empty() ) RegisterHistoIds();
+
+  // Get total charge in order to get the correct histo
   Double_t PairCharge = tracki.Charge() + trackj.Charge();
-  TString scharge  = "";
-  if( PairCharge == +2 )      scharge = "PP";
-  else if( PairCharge == -2 ) scharge = "MM";
+  Int_t charge(0);
+  if( PairCharge == +2 )      charge = 1;
+  else if( PairCharge == -2 ) charge = 2;
+  Int_t mix = IsMixedHisto ? 1 : 0;
 
   // Pointers in case running on MC
   Int_t labeli               = 0;
@@ -342,12 +349,9 @@ void AliAnalysisMuMuMinv::FillHistosForPair(const char* eventSelection,
   TLorentzVector             * pair4MomentumMC(0x0);
   Double_t inputWeightMC(1.);
 
-  // Usefull string :)
-  TString smix = IsMixedHisto ? "Mix" : "";
-
-  // Create proxy in AliMergeableCollection
-  AliMergeableCollectionProxy* proxy = HistogramCollection()->CreateProxy(BuildPath(eventSelection,triggerClassName,centrality,pairCutName));
-  AliMergeableCollectionProxy* mcProxy(0x0); // to be set later maybe
+  // Histogram paths
+  Int_t pathId = PathId(eventSelection,triggerClassName,centrality,pairCutName);
+  Int_t mcPathId(-1); // to be set later maybe
 
   // Construct dimuons vector
   TLorentzVector pi(tracki.Px(),tracki.Py(),tracki.Pz(),
@@ -374,8 +378,6 @@ void AliAnalysisMuMuMinv::FillHistosForPair(const char* eventSelection,
     mcTracki = MCEvent()->GetTrack(labeli);
     if(!mcTracki) return;
     if ( TMath::Abs(mcTracki->PdgCode()) != 13 ) {
-      delete proxy;
-      delete mcProxy;
       return;
     }
 
@@ -383,8 +385,6 @@ void AliAnalysisMuMuMinv::FillHistosForPair(const char* eventSelection,
     mcTrackj = MCEvent()->GetTrack(labelj);
     if(!mcTrackj) return;
     if ( TMath::Abs(mcTrackj->PdgCode()) != 13 ) {
-      delete proxy;
-      delete mcProxy;
       return;
     }
 
@@ -392,26 +392,18 @@ void AliAnalysisMuMuMinv::FillHistosForPair(const char* eventSelection,
     Int_t currMotheri = mcTracki->GetMother();
     Int_t currMotherj = mcTrackj->GetMother();
     if( currMotheri!=currMotherj ) {
-      delete proxy;
-      delete mcProxy;
       return;
     }
     if( currMotheri<0 ) {
-      delete proxy;
-      delete mcProxy;
       return;
     }
 
     // Check if mother is J/psi
     AliMCParticle* mother = static_cast<AliMCParticle*>(MCEvent()->GetTrack(currMotheri));
     if(!mother){
-      delete proxy;
-      delete mcProxy;
       return;
     }
     if(mother->PdgCode() !=443) {
-      delete proxy;
-      delete mcProxy;
       return;
     }
 
@@ -423,13 +415,11 @@ void AliAnalysisMuMuMinv::FillHistosForPair(const char* eventSelection,
 
     if(!mcTracki || !mcTrackj){
       AliError("Miss one or several MC track");
-      delete proxy;
-      delete mcProxy;
       return;
     }
 
-    // Create proxy for MC
-    mcProxy = HistogramCollection()->CreateProxy(BuildMCPath(eventSelection,triggerClassName,centrality,pairCutName));
+    // MC path
+    mcPathId = PathId(eventSelection,triggerClassName,centrality,pairCutName,kTRUE);
     TLorentzVector mcpi(mcTracki->Px(),mcTracki->Py(),mcTracki->Pz(),TMath::Sqrt(AliAnalysisMuonUtility::MuonMass2()+mcTracki->P()*mcTracki->P()));
     TLorentzVector mcpj(mcTrackj->Px(),mcTrackj->Py(),mcTrackj->Pz(),TMath::Sqrt(AliAnalysisMuonUtility::MuonMass2()+mcTrackj->P()*mcTrackj->P()));
     mcpj+=mcpi;
@@ -441,25 +431,26 @@ void AliAnalysisMuMuMinv::FillHistosForPair(const char* eventSelection,
   else if(fWeightMuon)  inputWeight = WeightMuonDistribution(tracki.Pt()) * WeightMuonDistribution(trackj.Pt());
 
   // Fill some distribution histos
-  if ( !IsHistogramDisabled("Pt")  ) {
+  if ( !IsHistogramDisabled(fHistoIds[kPt])  ) {
     Double_t x[2] = {pair4Momentum.Pt(),pair4Momentum.M()};
-    if(proxy->GetObject(Form("Pt%s%s",smix.Data(),scharge.Data())))
-      static_cast<THnSparse*>(proxy->GetObject(Form("Pt%s%s",smix.Data(),scharge.Data())))->Fill(x,inputWeight);
+    THnSparse* h = static_cast<THnSparse*>(Object(pathId,fHistoIds[PairKinematicsIndex(0,mix,charge)]));
+    if(h) h->Fill(x,inputWeight);
   }
-  if ( !IsHistogramDisabled("Y")   ){
+  if ( !IsHistogramDisabled(fHistoIds[kY])   ){
     Double_t x[2] = {pair4Momentum.Rapidity(),pair4Momentum.M()};
-    if(proxy->GetObject(Form("Y%s%s",smix.Data(),scharge.Data())))
-      static_cast<THnSparse*>(proxy->GetObject(Form("Y%s%s",smix.Data(),scharge.Data())))->Fill(x,inputWeight);
+    THnSparse* h = static_cast<THnSparse*>(Object(pathId,fHistoIds[PairKinematicsIndex(1,mix,charge)]));
+    if(h) h->Fill(x,inputWeight);
   }
-  if ( !IsHistogramDisabled("Eta") ){
+  if ( !IsHistogramDisabled(fHistoIds[kEta]) ){
     Double_t x[2] = {pair4Momentum.Eta(),pair4Momentum.M()};
-    if(proxy->GetObject(Form("Eta%s%s",smix.Data(),scharge.Data())))
-      static_cast<THnSparse*>(proxy->GetObject(Form("Eta%s%s",smix.Data(),scharge.Data())))->Fill(x,inputWeight);
+    THnSparse* h = static_cast<THnSparse*>(Object(pathId,fHistoIds[PairKinematicsIndex(2,mix,charge)]));
+    if(h) h->Fill(x,inputWeight);
   }
 
-  if ( !IsHistogramDisabled("PtPaireVsPtTrack") && !IsMixedHisto &&  static_cast<int>(PairCharge) == 0) {
-    static_cast<TH2*>( proxy->Histo("PtPaireVsPtTrack"))->Fill(pair4Momentum.Pt(),tracki.Pt(),inputWeight);
-    static_cast<TH2*>( proxy->Histo("PtPaireVsPtTrack"))->Fill(pair4Momentum.Pt(),trackj.Pt(),inputWeight);
+  if ( !IsHistogramDisabled(fHistoIds[kPtPaireVsPtTrack]) && !IsMixedHisto &&  static_cast<int>(PairCharge) == 0) {
+    TH1* h = Histo(pathId,fHistoIds[kPtPaireVsPtTrack]);
+    h->Fill(pair4Momentum.Pt(),tracki.Pt(),inputWeight);
+    h->Fill(pair4Momentum.Pt(),trackj.Pt(),inputWeight);
   }
 
   // Fill histos with MC stack info (only opposite charge muons)
@@ -472,10 +463,11 @@ void AliAnalysisMuMuMinv::FillHistosForPair(const char* eventSelection,
 
 
     // Fill histo
-    if ( proxy->Histo("PtRecVsSim") )  proxy->Histo("PtRecVsSim")->Fill(mcpj.Pt(),pair4Momentum.Pt());
-    if ( mcProxy->Histo("Pt"))  mcProxy->Histo("Pt")->Fill(mcpj.Pt(),inputWeightMC);
-    if ( mcProxy->Histo("Y"))   mcProxy->Histo("Y")->Fill(mcpj.Rapidity(),inputWeightMC);
-    if ( mcProxy->Histo("Eta")) mcProxy->Histo("Eta")->Fill(mcpj.Eta());
+    TH1* h(0x0);
+    if ( ( h = Histo(pathId,fHistoIds[kPtRecVsSim]) ) ) h->Fill(mcpj.Pt(),pair4Momentum.Pt());
+    if ( ( h = Histo(mcPathId,fHistoIds[kPt]) ) )     h->Fill(mcpj.Pt(),inputWeightMC);
+    if ( ( h = Histo(mcPathId,fHistoIds[kY]) ) )      h->Fill(mcpj.Rapidity(),inputWeightMC);
+    if ( ( h = Histo(mcPathId,fHistoIds[kEta]) ) )    h->Fill(mcpj.Eta());
 
     // set pair4MomentumMC for the rest of the function
     pair4MomentumMC = &mcpj;
@@ -484,29 +476,27 @@ void AliAnalysisMuMuMinv::FillHistosForPair(const char* eventSelection,
   TIter nextBin(fBinsToFill);
   nextBin.Reset();
   AliAnalysisMuMuBinning::Range* r;
+  Int_t ib(-1);
 
   // Loop over all bin ranges
   while ( ( r = static_cast<AliAnalysisMuMuBinning::Range*>(nextBin()) ) ){
 
+    ++ib;
+
     // --- In this loop we first check if the pairs pass some tests and we fill histo accordingly. ---
 
     // Flag for cuts and ranges
     Bool_t ok(kFALSE);
     Bool_t okMC(kFALSE);
 
-    ok = CheckBinRangeCut(r,&pair4Momentum,proxy);
-    if( pair4MomentumMC ) okMC = CheckBinRangeCut(r,pair4MomentumMC,proxy);
+    ok = CheckBinRangeCut(r,&pair4Momentum,pathId);
+    if( pair4MomentumMC ) okMC = CheckBinRangeCut(r,pair4MomentumMC,pathId);
 
     // Check if pair pass all conditions, either MC or not, and fill Minv Histogrames
     if ( ok )
     {
-      // Get Minv histo name associated to the bin
-      TString minvName       = GetMinvHistoName(*r,kFALSE,PairCharge,IsMixedHisto);
-      TString hprofName      = Form("MeanPtVs%s",minvName.Data());
-      TString hprofNameSquare= Form("MeanPtSquareVs%s",minvName.Data());
-      TProfile* hprof        = Prof(eventSelection,triggerClassName,centrality,pairCutName,hprofName.Data());
-      TProfile* hprofsquare  = Prof(eventSelection,triggerClassName,centrality,pairCutName,hprofNameSquare.Data());
-      FillMinvHisto(&minvName,hprof,hprofsquare,proxy,&pair4Momentum,inputWeight);
+      // Minv histo associated to the bin
+      FillMinvHisto(pathId,&fHistoIds[MinvIndex(ib,0,charge,mix)],&pair4Momentum,inputWeight);
 
       // Create, fill and store Minv histo already corrected with accxeff
       if ( ShouldCorrectDimuonForAccEff() )
@@ -519,23 +509,13 @@ void AliAnalysisMuMuMinv::FillHistosForPair(const char* eventSelection,
         if ( AccxEff <= 0.0 ) AliError(Form("AccxEff < 0 for pt = %f & y = %f ",pair4Momentum.Pt(),pair4Momentum.Rapidity()));
         else okAccEff = kTRUE;
 
-        minvName        = GetMinvHistoName(*r,kTRUE,PairCharge,IsMixedHisto);
-        hprofName       = Form("MeanPtVs%s",minvName.Data());
-        hprofNameSquare = Form("MeanPtSquareVs%s",minvName.Data());
-        hprof           = Prof(eventSelection,triggerClassName,centrality,pairCutName,hprofName.Data());
-        hprofsquare     = Prof(eventSelection,triggerClassName,centrality,pairCutName,hprofNameSquare.Data());
-        if( okAccEff ) FillMinvHisto(&minvName,hprof,hprofsquare,proxy,&pair4Momentum,inputWeight/AccxEff);
+        if( okAccEff ) FillMinvHisto(pathId,&fHistoIds[MinvIndex(ib,1,charge,mix)],&pair4Momentum,inputWeight/AccxEff);
       }
     }
 
     if ( okMC ) {
 
-      TString minvName       = GetMinvHistoName(*r,kFALSE,PairCharge,IsMixedHisto);
-      TString hprofName      = Form("MeanPtVs%s",minvName.Data());
-      TString hprofNameSquare= Form("MeanPtSquareVs%s",minvName.Data());
-      TProfile* hprof        = MCProf(eventSelection,triggerClassName,centrality,pairCutName,hprofName.Data());
-      TProfile* hprofsquare  = MCProf(eventSelection,triggerClassName,centrality,pairCutName,hprofNameSquare.Data());
-      FillMinvHisto(&minvName,hprof,hprofsquare,mcProxy,&pair4Momentum,inputWeight);
+      FillMinvHisto(mcPathId,&fHistoIds[MinvIndex(ib,0,charge,mix)],&pair4Momentum,inputWeight);
 
       // Create, fill and store Minv histo already corrected with accxeff
       if ( ShouldCorrectDimuonForAccEff() ){
@@ -548,18 +528,11 @@ void AliAnalysisMuMuMinv::FillHistosForPair(const char* eventSelection,
         if ( AccxEff <= 0.0 ) AliError(Form("AccxEff < 0 for pt = %f & y = %f ",pair4MomentumMC->Pt(),pair4MomentumMC->Rapidity()));
         else okAccEff = kTRUE;
 
-        minvName        = GetMinvHistoName(*r,kTRUE,PairCharge,IsMixedHisto);
-        hprofName       = Form("MeanPtVs%s",minvName.Data());
-        hprofNameSquare = Form("MeanPtSquareVs%s",minvName.Data());
-        hprof           = MCProf(eventSelection,triggerClassName,centrality,pairCutName,hprofName.Data());
-        hprofsquare     = MCProf(eventSelection,triggerClassName,centrality,pairCutName,hprofNameSquare.Data());
-        if( okAccEff ) FillMinvHisto(&minvName,hprof,hprofsquare,mcProxy,&pair4Momentum,inputWeight/AccxEff);
+        if( okAccEff ) FillMinvHisto(mcPathId,&fHistoIds[MinvIndex(ib,1,charge,mix)],&pair4Momentum,inputWeight/AccxEff);
 
       }
     }
   }
-  delete proxy;
-  delete mcProxy;
 }
 
 
@@ -687,26 +660,83 @@ void AliAnalysisMuMuMinv::FillHistosForMCEvent(const char* eventSelection,const
 }
 
 //_____________________________________________________________________________
-void AliAnalysisMuMuMinv::FillMinvHisto(TString* minvName,TProfile* hprof,TProfile* hprof2,AliMergeableCollectionProxy* proxy, TLorentzVector* pair4Momentum, Double_t inputWeight)
+void AliAnalysisMuMuMinv::FillMinvHisto(Int_t pathId, const Int_t* histoIds, TLorentzVector* pair4Momentum, Double_t inputWeight)
 {
-  /// Create, fill and store Minv histo
-  if (!IsHistogramDisabled(minvName->Data())){
+  /// Fill Minv histo histoIds[0] and its mean pt profiles histoIds[1] and histoIds[2] (see RegisterHistoIds)
+  if (!IsHistogramDisabled(histoIds[0])){
 
     TH1* h(0x0);
 
-    h = proxy->Histo(minvName->Data());
+    h = Histo(pathId,histoIds[0]);
     if (h) h->Fill(pair4Momentum->M(),inputWeight);
 
     // Fill Mean pT
     if ( fComputeMeanPt ){
-      if ( !hprof ) AliError(Form("Could not get hprofile for %s",minvName->Data()));
+      TProfile* hprof  = Prof(pathId,histoIds[1]);
+      TProfile* hprof2 = Prof(pathId,histoIds[2]);
+      if ( !hprof ) AliError(Form("Could not get hprofile for %s",HistoName(histoIds[0])));
       else hprof->Fill(pair4Momentum->M(),pair4Momentum->Pt(),inputWeight);
-      if ( !hprof2 ) AliError(Form("Could not get hprofile for %s",minvName->Data()));
+      if ( !hprof2 ) AliError(Form("Could not get hprofile for %s",HistoName(histoIds[0])));
       else hprof2->Fill(pair4Momentum->M(),pair4Momentum->Pt()*pair4Momentum->Pt(),inputWeight);
     }
   }
 }
 
+//_____________________________________________________________________________
+void AliAnalysisMuMuMinv::RegisterHistoIds()
+{
+  /// Register the ids of the histograms filled for each pair (see EHistoIdIndex),
+  /// so that FillHistosForPair does not have to build any histogram name
+
+  Int_t nbins = fBinsToFill ? fBinsToFill->GetEntriesFast() : 0;
+
+  fHistoIds.assign(MinvIndex(nbins,0,0,0),-1);
+
+  fHistoIds[kPtRecVsSim]       = HistoId("PtRecVsSim");
+  fHistoIds[kPtPaireVsPtTrack] = HistoId("PtPaireVsPtTrack");
+  fHistoIds[kNchForJpsi]       = HistoId("NchForJpsi");
+  fHistoIds[kNchForPsiP]       = HistoId("NchForPsiP");
+  fHistoIds[kPt]               = HistoId("Pt");
+  fHistoIds[kY]                = HistoId("Y");
+  fHistoIds[kEta]              = HistoId("Eta");
+
+  const char* vars[3]    = { "Pt", "Y", "Eta" };
+  const char* mixes[2]   = { "", "Mix" };
+  const char* charges[3] = { "", "PP", "MM" };
+  const Double_t pairCharges[3] = { 0, 2, -2 };
+
+  for ( Int_t v = 0; v < 3; ++v )
+  {
+    for ( Int_t m = 0; m < 2; ++m )
+    {
+      for ( Int_t c = 0; c < 3; ++c )
+      {
+        fHistoIds[PairKinematicsIndex(v,m,c)] = HistoId(Form("%s%s%s",vars[v],mixes[m],charges[c]));
+      }
+    }
+  }
+
+  for ( Int_t ib = 0; ib < nbins; ++ib )
+  {
+    const AliAnalysisMuMuBinning::Range* r = static_cast<const AliAnalysisMuMuBinning::Range*>(fBinsToFill->At(ib));
+
+    for ( Int_t a = 0; a < 2; ++a )
+    {
+      for ( Int_t c = 0; c < 3; ++c )
+      {
+        for ( Int_t m = 0; m < 2; ++m )
+        {
+          TString minvName = GetMinvHistoName(*r,a,pairCharges[c],m);
+          Int_t i = MinvIndex(ib,a,c,m);
+          fHistoIds[i]   = HistoId(minvName.Data());
+          fHistoIds[i+1] = HistoId(Form("MeanPtVs%s",minvName.Data()));
+          fHistoIds[i+2] = HistoId(Form("MeanPtSquareVs%s",minvName.Data()));
+        }
+      }
+    }
+  }
+}
+
 //_____________________________________________________________________________
 TString AliAnalysisMuMuMinv::GetMinvHistoName(const AliAnalysisMuMuBinning::Range& r, Bool_t accEffCorrected, Double_t PairCharge, Bool_t mix) const
 {
@@ -818,7 +848,7 @@ Bool_t AliAnalysisMuMuMinv::IsPtInRange(const AliVParticle& t1, const AliVPartic
 }
 
 //_____________________________________________________________________________
-Bool_t AliAnalysisMuMuMinv::CheckBinRangeCut(AliAnalysisMuMuBinning::Range* r, TLorentzVector* pair4Momentum, AliMergeableCollectionProxy* proxy)
+Bool_t AliAnalysisMuMuMinv::CheckBinRangeCut(AliAnalysisMuMuBinning::Range* r, TLorentzVector* pair4Momentum, Int_t pathId)
 {
   /// Check if our pairs match conditions from the binning range
 
@@ -835,7 +865,7 @@ Bool_t AliAnalysisMuMuMinv::CheckBinRangeCut(AliAnalysisMuMuBinning::Range* r, T
     // Fill NchForJpsi histo according to pair4Momentum.M()
     if ( pair4Momentum->M() >= 2.9 && pair4Momentum->M() <= 3.3 ){
 
-      h = proxy->Histo("NchForJpsi");
+      h = Histo(pathId,fHistoIds[kNchForJpsi]);
 
       Double_t ntrcorr = (-1.);
       TList* list = static_cast<TList*>(Event()->FindListObject("NCH"));
@@ -859,7 +889,7 @@ Bool_t AliAnalysisMuMuMinv::CheckBinRangeCut(AliAnalysisMuMuBinning::Range* r, T
     }
     else if ( pair4Momentum->M() >= 3.6 && pair4Momentum->M() <= 3.9){
 
-      h = proxy->Histo("NchForPsiP");
+      h = Histo(pathId,fHistoIds[kNchForPsiP]);
       Double_t ntrcorr = (-1.);
 
       TList* list = static_cast<TList*>(Event()->FindListObject("NCH"));
@@ -1110,6 +1140,7 @@ void AliAnalysisMuMuMinv::SetBinsToFill(const char* particle, const char* bins)
 {
   delete fBinsToFill;
   fBinsToFill = Binning()->CreateBinObjArray(particle,bins,"");
+  fHistoIds.clear();
 }
 
 //________________________________________________________________________
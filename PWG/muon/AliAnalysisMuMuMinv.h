@@ -14,6 +14,7 @@
 #include "TString.h"
 #include "TLorentzVector.h"
 #include "TH2.h"
+#include <vector>
 
 class TH2F;
 class AliVParticle;
@@ -43,7 +44,7 @@ public:
 
   void SetMuonWeight() { fWeightMuon=kTRUE; }
 
-  void SetLegacyBinNaming() { fMinvBinSeparator = ""; }
+  void SetLegacyBinNaming() { fMinvBinSeparator = ""; fHistoIds.clear(); }
 
   void SetBinsToFill(const char* particle, const char* bins);
 
@@ -72,10 +73,31 @@ protected:
 
   void FillHistosForMCEvent(const char* eventSelection,const char* triggerClassName,const char* centrality);
 
-  void FillMinvHisto(TString* minvName,TProfile* hprof,TProfile* hprof2,AliMergeableCollectionProxy* proxy, TLorentzVector* pair4Momentum, Double_t inputWeight);
+  void FillMinvHisto(Int_t pathId, const Int_t* histoIds, TLorentzVector* pair4Momentum, Double_t inputWeight);
 
 private:
 
+  /// layout of fHistoIds : fixed histograms, then the pair kinematics ones (per variable, mix and charge),
+  /// then the minv ones (per bin, acc x eff correction, charge and mix : minv, mean pt, mean pt square)
+  enum EHistoIdIndex
+  {
+    kPtRecVsSim,
+    kPtPaireVsPtTrack,
+    kNchForJpsi,
+    kNchForPsiP,
+    kPt,
+    kY,
+    kEta,
+    kPairKinematics,
+    kMinvHistos = kPairKinematics + 3*2*3
+  };
+
+  void RegisterHistoIds();
+
+  Int_t PairKinematicsIndex(Int_t var, Int_t mix, Int_t charge) const { return kPairKinematics + ( var*2 + mix )*3 + charge; }
+
+  Int_t MinvIndex(Int_t bin, Int_t accEffCorrected, Int_t charge, Int_t mix) const { return kMinvHistos + ( ( bin*2 + accEffCorrected )*3 + charge )*2*3 + mix*3; }
+
   void CreateMinvHistograms(const char* eventSelection, const char* triggerClassName, const char* centrality);
 
   // normalize the function to its integral in the given range
@@ -91,7 +113,7 @@ private:
 
   Double_t TriggerLptApt(Double_t *x, Double_t *par);
 
-  Bool_t  CheckBinRangeCut(AliAnalysisMuMuBinning::Range* r, TLorentzVector* pair4Momentum, AliMergeableCollectionProxy* proxy);
+  Bool_t  CheckBinRangeCut(AliAnalysisMuMuBinning::Range* r, TLorentzVector* pair4Momentum, Int_t pathId);
 
   Bool_t CheckMCTracksMatchingStackAndMother(Int_t labeli, Int_t labelj, AliVParticle* mcTracki, AliVParticle* mcTrackj, Double_t inputWeightMC);
 
@@ -111,8 +133,9 @@ private:
   Double_t fMinvMax;
   Double_t fmcptcutmin;
   Double_t fmcptcutmax;
+  std::vector<Int_t> fHistoIds; //! histogram ids used in FillHistosForPair (see EHistoIdIndex)
 
-  ClassDef(AliAnalysisMuMuMinv,8) // implementation of AliAnalysisMuMuBase for muon pairs
+  ClassDef(AliAnalysisMuMuMinv,9) // implementation of AliAnalysisMuMuBase for muon pairs
 };
 
 #endif
@@ -39,6 +39,7 @@ fPtEtaSpectraPerBCX(kFALSE),
 fDCAHistos(kFALSE)
 {
   /// ctor
+  RegisterMuonHistoIds();
 }
 
 //_____________________________________________________________________________
@@ -265,10 +266,31 @@ void AliAnalysisMuMuSingle::DefineHistogramCollection(const char* eventSelection
 
 
 //_____________________________________________________________________________
-void AliAnalysisMuMuSingle::FillHistosForMuonTrack(AliMergeableCollectionProxy& proxy,
+void AliAnalysisMuMuSingle::RegisterMuonHistoIds()
+{
+  /// Register the ids of the histograms filled in FillHistosForMuonTrack
+
+  const char* names[kNofMuonHistos] = { "Chi2MatchTrigger", "BCX", "EtaRapidityMu", "PtEtaMu", "PtRapidityMu",
+    "PEtaMu", "PtPhiMu", "Chi2Mu", "dcaP23Mu", "dcaPwPtCut23Mu", "dcaP310Mu", "dcaPwPtCut310Mu" };
+  const char* charges[3] = { "", "Plus", "Minus" };
+
+  for ( Int_t i = 0; i < kNofMuonHistos; ++i )
+  {
+    Bool_t perCharge = ( i != kChi2MatchTrigger && i != kBCX );
+
+    for ( Int_t c = 0; c < 3; ++c )
+    {
+      fMuonHistoId[i][c] = HistoId(Form("%s%s",names[i],perCharge ? charges[c] : ""));
+    }
+    fMuonHistoPatternId[i] = HistoId(Form("%s%s",names[i],perCharge ? "*" : ""));
+  }
+}
+
+//_____________________________________________________________________________
+void AliAnalysisMuMuSingle::FillHistosForMuonTrack(Int_t pathId,
                                                    const AliVParticle& track)
 {
-  /// Fill histograms for one track
+  /// Fill histograms for one track, in the path pathId
 
   AliCodeTimerAuto("",0);
 
@@ -281,17 +303,17 @@ void AliAnalysisMuMuSingle::FillHistosForMuonTrack(AliMergeableCollectionProxy&
                    TMath::Sqrt(AliAnalysisMuonUtility::MuonMass2()+track.P()*track.P()));
 
 
-  TString charge("");
+  Int_t charge(0);
 
   if ( ShouldSeparatePlusAndMinus() )
   {
     if ( track.Charge() < 0 )
     {
-      charge = "Minus";
+      charge = 2;
     }
     else
     {
-      charge = "Plus";
+      charge = 1;
     }
   }
 
@@ -299,60 +321,61 @@ void AliAnalysisMuMuSingle::FillHistosForMuonTrack(AliMergeableCollectionProxy&
 
   Double_t theta = AliAnalysisMuonUtility::GetThetaAbsDeg(&track);
 
-  if (!IsHistogramDisabled("BCX"))
+  if (!IsHistogramDisabled(fMuonHistoPatternId[kBCX]))
   {
-    proxy.Histo("BCX")->Fill(1.0*Event()->GetBunchCrossNumber());
+    Histo(pathId,fMuonHistoId[kBCX][0])->Fill(1.0*Event()->GetBunchCrossNumber());
   }
 
-  if (!IsHistogramDisabled("Chi2MatchTrigger"))
+  if (!IsHistogramDisabled(fMuonHistoPatternId[kChi2MatchTrigger]))
   {
-    proxy.Histo("Chi2MatchTrigger")->Fill(AliAnalysisMuonUtility::GetChi2MatchTrigger(&track));
+    Histo(pathId,fMuonHistoId[kChi2MatchTrigger][0])->Fill(AliAnalysisMuonUtility::GetChi2MatchTrigger(&track));
   }
 
-  if (!IsHistogramDisabled("EtaRapidityMu*"))
+  if (!IsHistogramDisabled(fMuonHistoPatternId[kEtaRapidityMu]))
   {
-    proxy.Histo(Form("EtaRapidityMu%s",charge.Data()))->Fill(p.Rapidity(),p.Eta());
+    Histo(pathId,fMuonHistoId[kEtaRapidityMu][charge])->Fill(p.Rapidity(),p.Eta());
   }
 
-  if (!IsHistogramDisabled("PtEtaMu*"))
+  if (!IsHistogramDisabled(fMuonHistoPatternId[kPtEtaMu]))
   {
-    TH1* h = proxy.Histo(Form("PtEtaMu%s",charge.Data()));
+    TH1* h = Histo(pathId,fMuonHistoId[kPtEtaMu][charge]);
 
     h->Fill(p.Eta(),p.Pt());
 
     if  ( fPtEtaSpectraPerBCX )
     {
-      if (!IsHistogramDisabled("BCX"))
+      if (!IsHistogramDisabled(fMuonHistoPatternId[kBCX]))
       {
-        TH1* hbcx = proxy.Histo(Form("PtEtaMu%sBCX%d",charge.Data(),Event()->GetBunchCrossNumber()));
+        Int_t bcxId = HistoId(Form("%sBCX%d",h->GetName(),Event()->GetBunchCrossNumber()));
+        TH1* hbcx = Histo(pathId,bcxId);
 
         if (!hbcx)
         {
-          hbcx = static_cast<TH1*>(h->Clone(Form("PtEtaMu%sBCX%d",charge.Data(),Event()->GetBunchCrossNumber())));
-          proxy.Adopt(hbcx);
+          hbcx = static_cast<TH1*>(h->Clone(HistoName(bcxId)));
+          AdoptObject(pathId,bcxId,hbcx);
         }
       }
     }
   }
 
-  if (!IsHistogramDisabled("PtRapidityMu*"))
+  if (!IsHistogramDisabled(fMuonHistoPatternId[kPtRapidityMu]))
   {
-    proxy.Histo(Form("PtRapidityMu%s",charge.Data()))->Fill(p.Rapidity(),p.Pt());
+    Histo(pathId,fMuonHistoId[kPtRapidityMu][charge])->Fill(p.Rapidity(),p.Pt());
   }
 
-  if (!IsHistogramDisabled("PEtaMu*"))
+  if (!IsHistogramDisabled(fMuonHistoPatternId[kPEtaMu]))
   {
-    proxy.Histo(Form("PEtaMu%s",charge.Data()))->Fill(p.Eta(),p.P());
+    Histo(pathId,fMuonHistoId[kPEtaMu][charge])->Fill(p.Eta(),p.P());
   }
 
-  if (!IsHistogramDisabled("PtPhiMu*"))
+  if (!IsHistogramDisabled(fMuonHistoPatternId[kPtPhiMu]))
   {
-    proxy.Histo(Form("PtPhiMu%s",charge.Data()))->Fill(p.Phi(),p.Pt());
+    Histo(pathId,fMuonHistoId[kPtPhiMu][charge])->Fill(p.Phi(),p.Pt());
   }
 
-  if (!IsHistogramDisabled("Chi2Mu*"))
+  if (!IsHistogramDisabled(fMuonHistoPatternId[kChi2Mu]))
   {
-    proxy.Histo(Form("Chi2Mu%s",charge.Data()))->Fill(AliAnalysisMuonUtility::GetChi2perNDFtracker(&track));
+    Histo(pathId,fMuonHistoId[kChi2Mu][charge])->Fill(AliAnalysisMuonUtility::GetChi2perNDFtracker(&track));
   }
 
   // if (!IsHistogramDisabled("HitperTriggerLocalBoardMu*"))
@@ -373,30 +396,30 @@ void AliAnalysisMuMuSingle::FillHistosForMuonTrack(AliMergeableCollectionProxy&
   if ( theta >= 2.0 && theta < 3.0 )
   {
 
-    if (!IsHistogramDisabled("dcaP23Mu*"))
+    if (!IsHistogramDisabled(fMuonHistoPatternId[kdcaP23Mu]))
     {
-      proxy.Histo(Form("dcaP23Mu%s",charge.Data()))->Fill(p.P(),dca);
+      Histo(pathId,fMuonHistoId[kdcaP23Mu][charge])->Fill(p.P(),dca);
     }
 
     if ( p.Pt() > 2 )
     {
-      if (!IsHistogramDisabled("dcaPwPtCut23Mu*"))
+      if (!IsHistogramDisabled(fMuonHistoPatternId[kdcaPwPtCut23Mu]))
       {
-        proxy.Histo(Form("dcaPwPtCut23Mu%s",charge.Data()))->Fill(p.P(),dca);
+        Histo(pathId,fMuonHistoId[kdcaPwPtCut23Mu][charge])->Fill(p.P(),dca);
       }
     }
   }
   else if ( theta >= 3.0 && theta < 10.0 )
   {
-    if (!IsHistogramDisabled("dcaP310Mu*"))
+    if (!IsHistogramDisabled(fMuonHistoPatternId[kdcaP310Mu]))
     {
-      proxy.Histo(Form("dcaP310Mu%s",charge.Data()))->Fill(p.P(),dca);
+      Histo(pathId,fMuonHistoId[kdcaP310Mu][charge])->Fill(p.P(),dca);
     }
     if ( p.Pt() > 2 )
     {
-      if (!IsHistogramDisabled("dcaPwPtCut310Mu*"))
+      if (!IsHistogramDisabled(fMuonHistoPatternId[kdcaPwPtCut310Mu]))
       {
-        proxy.Histo(Form("dcaPwPtCut310Mu%s",charge.Data()))->Fill(p.P(),dca);
+        Histo(pathId,fMuonHistoId[kdcaPwPtCut310Mu][charge])->Fill(p.P(),dca);
       }
     }
   }
@@ -413,11 +436,7 @@ void AliAnalysisMuMuSingle::FillHistosForTrack(const char* eventSelection,
 
   if (!AliAnalysisMuonUtility::IsMuonTrack(&track) ) return;
 
-  AliMergeableCollectionProxy* proxy = HistogramCollection()->CreateProxy(BuildPath(eventSelection,triggerClassName,centrality,trackCutName));
-
-  FillHistosForMuonTrack(*proxy,track);
-
-  delete proxy;
+  FillHistosForMuonTrack(PathId(eventSelection,triggerClassName,centrality,trackCutName),track);
 }
 
 //_____________________________________________________________________________
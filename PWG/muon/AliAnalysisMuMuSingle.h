@@ -15,7 +15,6 @@
 
 #include "AliAnalysisMuonUtility.h"
 
-class AliMergeableCollectionProxy;
 class AliMuonTrackCuts;
 class TH2F;
 class TObjArray;
@@ -71,11 +70,31 @@ protected:
                                   const char* trackCutName,
                                   const AliVParticle& part);
 
-  void FillHistosForMuonTrack(AliMergeableCollectionProxy& proxy, const AliVParticle& track);
+  void FillHistosForMuonTrack(Int_t pathId, const AliVParticle& track);
 
 
 private:
 
+  /// histograms filled for each muon track
+  enum EMuonHisto
+  {
+    kChi2MatchTrigger,
+    kBCX,
+    kEtaRapidityMu,
+    kPtEtaMu,
+    kPtRapidityMu,
+    kPEtaMu,
+    kPtPhiMu,
+    kChi2Mu,
+    kdcaP23Mu,
+    kdcaPwPtCut23Mu,
+    kdcaP310Mu,
+    kdcaPwPtCut310Mu,
+    kNofMuonHistos
+  };
+
+  void RegisterMuonHistoIds();
+
   void CreateTrackHisto(const char* eventSelection,
                         const char* triggerClassName,
                         const char* centrality,
@@ -118,7 +137,10 @@ private:
   Bool_t fPtEtaSpectraPerBCX; // make pt vs eta spectra bunch by bunch (caution : much slower !)
   Bool_t fDCAHistos; // make DCA histograms
 
-  ClassDef(AliAnalysisMuMuSingle,3) // implementation of AliAnalysisMuMuBase for single mu analysis
+  Int_t fMuonHistoId[kNofMuonHistos][3]; //! histogram ids, for no charge separation, mu+ and mu-
+  Int_t fMuonHistoPatternId[kNofMuonHistos]; //! ids of the names used to test whether the histograms are disabled
+
+  ClassDef(AliAnalysisMuMuSingle,4) // implementation of AliAnalysisMuMuBase for single mu analysis
 };
 
 #endif
@@ -0,0 +1,390 @@
+/**************************************************************************
+ * Copyright(c) 1998-1999, ALICE Experiment at CERN, All rights reserved. *
+ *                                                                        *
+ * Author: The ALICE Off-line Project.                                    *
+ * Contributors are mentioned in the code where appropriate.              *
+ *                                                                        *
+ * Permission to use, copy, modify and distribute this software and its   *
+ * documentation strictly for non-commercial purposes is hereby granted   *
+ * without fee, provided that the above copyright notice appears in all   *
+ * copies and that both the copyright notice and this permission notice   *
+ * appear in the supporting documentation. The authors make no claims     *
+ * about the suitability of this software for any purpose. It is          *
+ * provided "as is" without express or implied warranty.                  *
+ **************************************************************************/
+
+#include "AliAnalysisMuMuFitScan.h"
+
+ClassImp(AliAnalysisMuMuFitScan)
+
+#include "AliAnalysisMuMuJpsiResult.h"
+#include "AliLog.h"
+#include "TF1.h"
+#include "TH1.h"
+#include "TMath.h"
+#include "TObjArray.h"
+#include "TObjString.h"
+#include "TROOT.h"
+#include "Math/MinimizerOptions.h"
+#include <atomic>
+#include <iostream>
+#include <map>
+#include <string>
+#include <thread>
+#include <utility>
+
+//_____________________________________________________________________________
+AliAnalysisMuMuFitScan::AliAnalysisMuMuFitScan()
+: TObject(),
+fNofThreads(1),
+fWarmStart(kTRUE),
+fMinimizer("Minuit2"),
+fJobs()
+{
+  /// ctor
+}
+
+//_____________________________________________________________________________
+AliAnalysisMuMuFitScan::~AliAnalysisMuMuFitScan()
+{
+  /// dtor
+  Clear();
+}
+
+//_____________________________________________________________________________
+Int_t AliAnalysisMuMuFitScan::AddJob(AliAnalysisMuMuJpsiResult* mother, const char* fitType)
+{
+  /// Add the fit fitType of the result mother to the scan.
+  /// Returns the number of jobs added (0 or 1)
+
+  if (!mother || !fitType || !strlen(fitType))
+  {
+    AliError("Need a mother result and a fit type");
+    return 0;
+  }
+
+  Job job;
+
+  job.fMother = mother;
+  job.fFitType = fitType;
+  SplitRange(job.fFitType,job.fChainKey,job.fRangeLow,job.fRangeHigh);
+  job.fResult = 0x0;
+  job.fExecuted = kFALSE;
+
+  fJobs.push_back(job);
+
+  return 1;
+}
+
+//_____________________________________________________________________________
+Int_t AliAnalysisMuMuFitScan::AddJobs(AliAnalysisMuMuJpsiResult* mother, const char* fitTypeMatrix)
+{
+  /// Add all the fit types of the matrix (see ExpandFitTypes) for the result mother.
+  /// Returns the number of jobs added
+
+  TObjArray* fitTypes = ExpandFitTypes(fitTypeMatrix);
+
+  Int_t n(0);
+
+  TIter next(fitTypes);
+  TObjString* fitType;
+
+  while ( ( fitType = static_cast<TObjString*>(next()) ) )
+  {
+    n += AddJob(mother,fitType->String().Data());
+  }
+
+  delete fitTypes;
+
+  return n;
+}
+
+//_____________________________________________________________________________
+void AliAnalysisMuMuFitScan::Clear(Option_t* /*opt*/)
+{
+  /// Remove all the jobs (results not adopted yet are deleted)
+
+  for ( std::vector<Job>::iterator it = fJobs.begin(); it != fJobs.end(); ++it )
+  {
+    delete it->fResult;
+  }
+  fJobs.clear();
+}
+
+//_____________________________________________________________________________
+TObjArray* AliAnalysisMuMuFitScan::ExpandFitTypes(const char* fitTypeMatrix)
+{
+  /// Expand a fit type matrix into the list of all its fit types.
+  /// The matrix is a fit type where each value can be a list of values separated by '|'.
+  /// The first key varies the slowest. The returned array (owner) must be deleted by the caller.
+
+  TObjArray* fitTypes = new TObjArray;
+  fitTypes->SetOwner(kTRUE);
+
+  fitTypes->Add(new TObjString(""));
+
+  TObjArray* parts = TString(fitTypeMatrix).Tokenize(":");
+  TIter next(parts);
+  TObjString* part;
+
+  while ( ( part = static_cast<TObjString*>(next()) ) )
+  {
+    TString key(part->String());
+    TString values;
+
+    Int_t index = key.Index('=');
+    if ( index >= 0 )
+    {
+      values = key(index+1,key.Length()-index-1);
+      key.Remove(index+1);
+    }
+
+    TObjArray* valueArray = values.Tokenize("|");
+    if ( !valueArray->GetEntries() ) valueArray->Add(new TObjString(""));
+    valueArray->SetOwner(kTRUE);
+
+    TObjArray* expanded = new TObjArray;
+    expanded->SetOwner(kTRUE);
+
+    for ( Int_t i = 0; i <= fitTypes->GetLast(); ++i )
+    {
+      const TString& prefix = static_cast<TObjString*>(fitTypes->At(i))->String();
+
+      for ( Int_t j = 0; j <= valueArray->GetLast(); ++j )
+      {
+        TString fitType(prefix);
+        if ( fitType.Length() ) fitType += ":";
+        fitType += key;
+        fitType += static_cast<TObjString*>(valueArray->At(j))->String();
+        expanded->Add(new TObjString(fitType));
+      }
+    }
+
+    delete valueArray;
+    delete fitTypes;
+    fitTypes = expanded;
+  }
+
+  delete parts;
+
+  return fitTypes;
+}
+
+//_____________________________________________________________________________
+Bool_t AliAnalysisMuMuFitScan::IsConverged(const AliAnalysisMuMuJpsiResult& r)
+{
+  /// Whether r holds a converged fit (usable as a starting point for its neighbours)
+
+  if ( !r.IsValid() || !r.HasValue("FitResult") ) return kFALSE;
+
+  Int_t fitResult = TMath::Nint(r.GetValue("FitResult"));
+
+  if ( fitResult != 0 && fitResult != 4000 ) return kFALSE;
+
+  return ( !r.HasValue("CovMatrixStatus") || TMath::Nint(r.GetValue("CovMatrixStatus")) == 3 );
+}
+
+//_____________________________________________________________________________
+void AliAnalysisMuMuFitScan::Print(Option_t* /*opt*/) const
+{
+  /// Print the jobs
+
+  std::cout << Form("%lu jobs, %d threads, minimizer %s, warm start %s",
+                    fJobs.size(),fNofThreads,fMinimizer.Data(),fWarmStart ? "on" : "off") << std::endl;
+
+  for ( std::vector<Job>::const_iterator it = fJobs.begin(); it != fJobs.end(); ++it )
+  {
+    std::cout << Form("  %s : %s",it->fMother->GetName(),it->fFitType.Data()) << std::endl;
+  }
+}
+
+//_____________________________________________________________________________
+Int_t AliAnalysisMuMuFitScan::Run()
+{
+  /// Run all the jobs, and adopt the successful fits in their mother results.
+  /// Returns the number of fits adopted.
+
+  if ( fJobs.empty() ) return 0;
+
+  // the sub-results (histogram clones, decoding of the fit types) are created here,
+  // and grouped in chains of jobs only differing by their fit range
+  std::vector<std::vector<Int_t> > chains;
+  std::map<std::pair<const void*,std::string>,Int_t> chainIndex;
+
+  for ( std::vector<Job>::size_type i = 0; i < fJobs.size(); ++i )
+  {
+    Job& job = fJobs[i];
+
+    delete job.fResult;
+    job.fResult = job.fMother->PrepareFit(job.fFitType.Data());
+    job.fExecuted = kFALSE;
+
+    if (!job.fResult) continue;
+
+    std::pair<const void*,std::string> key(job.fMother,job.fChainKey.Data());
+    std::map<std::pair<const void*,std::string>,Int_t>::const_iterator it = chainIndex.find(key);
+
+    if ( it == chainIndex.end() )
+    {
+      chainIndex[key] = chains.size();
+      chains.push_back(std::vector<Int_t>(1,i));
+    }
+    else
+    {
+      chains[it->second].push_back(i);
+    }
+  }
+
+  Int_t nofThreads = TMath::Min(fNofThreads,static_cast<Int_t>(chains.size()));
+
+  AliInfo(Form("Running %lu fits (%lu chains) on %d thread(s)",fJobs.size(),chains.size(),nofThreads));
+
+  // the same (thread safe) minimizer is used whatever the number of threads, so that
+  // the results do not depend on it
+  std::string minimizerType = ROOT::Math::MinimizerOptions::DefaultMinimizerType();
+  std::string minimizerAlgo = ROOT::Math::MinimizerOptions::DefaultMinimizerAlgo();
+  ROOT::Math::MinimizerOptions::SetDefaultMinimizer(fMinimizer.Data());
+
+  Bool_t addDirectory = TH1::AddDirectoryStatus();
+  TH1::AddDirectory(kFALSE);
+  Bool_t addToGlobalList = TF1::DefaultAddToGlobalList(kFALSE);
+
+  if ( nofThreads > 1 )
+  {
+    ROOT::EnableThreadSafety();
+    AliAnalysisMuMuJpsiResult::SetThreadedFits(kTRUE);
+
+    std::atomic<Int_t> nextChain(0);
+    std::vector<std::thread> threads;
+
+    for ( Int_t i = 0; i < nofThreads; ++i )
+    {
+      threads.push_back(std::thread([this,&chains,&nextChain]()
+      {
+        Int_t ichain;
+        while ( ( ichain = nextChain++ ) < static_cast<Int_t>(chains.size()) )
+        {
+          RunChain(chains[ichain]);
+        }
+      }));
+    }
+
+    for ( std::vector<std::thread>::iterator it = threads.begin(); it != threads.end(); ++it )
+    {
+      it->join();
+    }
+
+    AliAnalysisMuMuJpsiResult::SetThreadedFits(kFALSE);
+  }
+  else
+  {
+    for ( std::vector<std::vector<Int_t> >::const_iterator it = chains.begin(); it != chains.end(); ++it )
+    {
+      RunChain(*it);
+    }
+  }
+
+  TF1::DefaultAddToGlobalList(addToGlobalList);
+  TH1::AddDirectory(addDirectory);
+  ROOT::Math::MinimizerOptions::SetDefaultMinimizer(minimizerType.c_str(),minimizerAlgo.c_str());
+
+  // adoption in the order the jobs were added
+  Int_t nofAdopted(0);
+
+  for ( std::vector<Job>::iterator it = fJobs.begin(); it != fJobs.end(); ++it )
+  {
+    if ( !it->fResult ) continue;
+
+    if ( it->fExecuted ) nofAdopted += ( it->fMother->AdoptFit(it->fResult) == kTRUE );
+    else delete it->fResult;
+
+    it->fResult = 0x0;
+  }
+
+  fJobs.clear();
+
+  AliInfo(Form("%d fits adopted",nofAdopted));
+
+  return nofAdopted;
+}
+
+//_____________________________________________________________________________
+void AliAnalysisMuMuFitScan::RunChain(const std::vector<Int_t>& chain)
+{
+  /// Run sequentially the jobs of one chain, each one starting from the converged
+  /// fit of the chain with the nearest range (if warm start is on)
+
+  for ( std::vector<Int_t>::size_type i = 0; i < chain.size(); ++i )
+  {
+    Job& job = fJobs[chain[i]];
+
+    if ( fWarmStart )
+    {
+      const AliAnalysisMuMuJpsiResult* neighbour(0x0);
+      Double_t distance(TMath::Limits<Double_t>::Max());
+
+      for ( std::vector<Int_t>::size_type k = 0; k < i; ++k )
+      {
+        const Job& done = fJobs[chain[k]];
+
+        if ( !done.fExecuted || !IsConverged(*done.fResult) ) continue;
+
+        Double_t d = TMath::Abs(done.fRangeLow-job.fRangeLow) + TMath::Abs(done.fRangeHigh-job.fRangeHigh);
+
+        if ( d <= distance ) // on ties the latest one wins
+        {
+          distance = d;
+          neighbour = done.fResult;
+        }
+      }
+
+      job.fResult->SetWarmStart(neighbour);
+    }
+
+    job.fExecuted = job.fResult->ExecuteFit();
+  }
+
+  // the neighbours might not be adopted, do not keep pointers to them
+  for ( std::vector<Int_t>::size_type i = 0; i < chain.size(); ++i )
+  {
+    fJobs[chain[i]].fResult->SetWarmStart(0x0);
+  }
+}
+
+//_____________________________________________________________________________
+void AliAnalysisMuMuFitScan::SplitRange(const TString& fitType, TString& chainKey,
+                                        Double_t& low, Double_t& high)
+{
+  /// Split fitType into its range (defaults as in AliAnalysisMuMuJpsiResult) and the
+  /// rest of the fit type (chainKey)
+
+  chainKey = "";
+  low = 2.0;
+  high = 5.0;
+
+  TObjArray* parts = fitType.Tokenize(":");
+  TIter next(parts);
+  TObjString* part;
+
+  while ( ( part = static_cast<TObjString*>(next()) ) )
+  {
+    const TString& s = part->String();
+
+    if ( s.BeginsWith("range=",TString::kIgnoreCase) )
+    {
+      TString range(s(6,s.Length()-6));
+      Int_t index = range.Index(';');
+      if ( index > 0 )
+      {
+        low = TString(range(0,index)).Atof();
+        high = TString(range(index+1,range.Length()-index-1)).Atof();
+        continue;
+      }
+    }
+
+    if ( chainKey.Length() ) chainKey += ":";
+    chainKey += s;
+  }
+
+  delete parts;
+}
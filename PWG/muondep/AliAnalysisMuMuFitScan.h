@@ -0,0 +1,110 @@
+#ifndef ALIANALYSISMUMUFITSCAN_H
+#define ALIANALYSISMUMUFITSCAN_H
+
+/* Copyright(c) 1998-1999, ALICE Experiment at CERN, All rights reserved. *
+ * See cxx source for full Copyright notice                               */
+
+/**
+
+@ingroup pwg_muondep_mumu
+
+@class AliAnalysisMuMuFitScan
+
+@brief Run a set of AliAnalysisMuMuJpsiResult fits (e.g. a systematic scan) in parallel
+
+Each job is a (mother result, fitType) pair, i.e. what AliAnalysisMuMuJpsiResult::AddFit(fitType)
+would do for the mother. A fit type matrix can be expanded in jobs with ExpandFitTypes : each
+key can be given several values separated by '|', all the combinations are generated, e.g.
+
+func=PSIPSIPRIMECB2VWG|PSIPSIPRIMENA60NEWVWG:rebin=1:histoType=minv:range=2.0;5.0|2.2;4.5|2.4;4.7
+
+gives 6 fit types.
+
+Jobs of the same mother differing only by their fit range form a chain. Chains are run
+concurrently, jobs of a chain sequentially, each one warm-started (see
+AliAnalysisMuMuJpsiResult::SetWarmStart) from the converged fit of the chain with the
+nearest range. Results are adopted by their mothers in the order the jobs were added,
+so the content of the result hierarchy does not depend on the number of threads.
+
+Usage :
+
+  AliAnalysisMuMuFitScan scan;
+  scan.SetNofThreads(8);
+  scan.AddJobs(r,"func=PSIPSIPRIMECB2VWG|PSIPSIPRIMECB2POL2EXP:rebin=2:range=2.2;4.5|2.4;4.7|2.0;5.0");
+  scan.Run();
+*/
+
+#include "TObject.h"
+#include <TString.h>
+#include <vector>
+
+class TObjArray;
+class AliAnalysisMuMuJpsiResult;
+
+class AliAnalysisMuMuFitScan : public TObject
+{
+public:
+
+  AliAnalysisMuMuFitScan();
+  virtual ~AliAnalysisMuMuFitScan();
+
+  /// Number of threads used to run the fits (1 = run in the calling thread)
+  void SetNofThreads(Int_t n) { fNofThreads = ( n > 0 ? n : 1 ); }
+
+  Int_t NofThreads() const { return fNofThreads; }
+
+  /// Whether to initialise each fit from the nearest converged fit of its chain
+  void SetWarmStart(Bool_t value=kTRUE) { fWarmStart = value; }
+
+  Bool_t WarmStart() const { return fWarmStart; }
+
+  /// Minimizer used during the scan (the TMinuit based default is not thread safe)
+  void SetMinimizer(const char* minimizer) { fMinimizer = minimizer; }
+
+  const char* Minimizer() const { return fMinimizer.Data(); }
+
+  Int_t AddJob(AliAnalysisMuMuJpsiResult* mother, const char* fitType);
+
+  Int_t AddJobs(AliAnalysisMuMuJpsiResult* mother, const char* fitTypeMatrix);
+
+  Int_t NofJobs() const { return fJobs.size(); }
+
+  Int_t Run();
+
+  virtual void Clear(Option_t* opt="");
+
+  void Print(Option_t* opt="") const;
+
+  static TObjArray* ExpandFitTypes(const char* fitTypeMatrix);
+
+private:
+
+  AliAnalysisMuMuFitScan(const AliAnalysisMuMuFitScan& rhs); // not implemented on purpose
+  AliAnalysisMuMuFitScan& operator=(const AliAnalysisMuMuFitScan& rhs); // not implemented on purpose
+
+  struct Job
+  {
+    AliAnalysisMuMuJpsiResult* fMother; // result the fit will be added to (not owner)
+    TString fFitType; // fit type as given to AliAnalysisMuMuJpsiResult::AddFit
+    TString fChainKey; // fit type without its range
+    Double_t fRangeLow; // fit range
+    Double_t fRangeHigh; // fit range
+    AliAnalysisMuMuJpsiResult* fResult; // fit result (owner until adopted)
+    Bool_t fExecuted; // whether the fit method could be run
+  };
+
+  void RunChain(const std::vector<Int_t>& chain);
+
+  static Bool_t IsConverged(const AliAnalysisMuMuJpsiResult& r);
+
+  static void SplitRange(const TString& fitType, TString& chainKey, Double_t& low, Double_t& high);
+
+  Int_t fNofThreads; // number of threads
+  Bool_t fWarmStart; // whether to warm-start the fits
+  TString fMinimizer; // minimizer used during the scan
+  std::vector<Job> fJobs; //! jobs to be run
+
+  ClassDef(AliAnalysisMuMuFitScan,1) // run AliAnalysisMuMuJpsiResult fits in parallel
+};
+
+#endif
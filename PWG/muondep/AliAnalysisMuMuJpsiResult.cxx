@@ -35,6 +35,8 @@ ClassImp(AliAnalysisMuMuJpsiResult)
 #include "AliLog.h"
 #include <map>
 #include <iostream>
+#include <mutex>
+#include <condition_variable>
 
 #include "Fit/Fitter.h"
 #include "Fit/BinData.h"
@@ -88,7 +90,136 @@ namespace {
   const TString kKeySPsiP     = "FSigmaPsiP"; //Factor to fix the psi' sigma to sigmaJPsi*SigmaPsiP (Usually factor SigmaPsiP = 1, 0.9 and 1.1)
   const TString kKeyMinvRS    = "MinvRS"; // FIXME: not very correct since "MinvRS" is in AliAnalysisMuMu::GetParametersFromResult
 
-}
+  //____________________________________________________________________________
+  /// Guard of the (global) TF1::RejectPoint flag when fits run in several threads.
+  ///
+  /// The flag is raised by the background functions inside the reject range and read
+  /// back by the data filling of every TH1::Fit, so a fit with a reject range set owns
+  /// the lock exclusively while all the other fits share it.
+  class RejectPointLock
+  {
+  public:
+    RejectPointLock() : fMutex(), fCondition(), fNofShared(0), fNofWaiting(0), fExclusive(kFALSE) {}
+
+    void LockShared()
+    {
+      std::unique_lock<std::mutex> lock(fMutex);
+      fCondition.wait(lock,[this]{ return !fExclusive && !fNofWaiting; });
+      ++fNofShared;
+    }
+
+    void UnlockShared()
+    {
+      std::lock_guard<std::mutex> lock(fMutex);
+      --fNofShared;
+      fCondition.notify_all();
+    }
+
+    void Lock()
+    {
+      std::unique_lock<std::mutex> lock(fMutex);
+      ++fNofWaiting;
+      fCondition.wait(lock,[this]{ return !fExclusive && !fNofShared; });
+      --fNofWaiting;
+      fExclusive = kTRUE;
+    }
+
+    void Unlock()
+    {
+      std::lock_guard<std::mutex> lock(fMutex);
+      fExclusive = kFALSE;
+      fCondition.notify_all();
+    }
+
+  private:
+    std::mutex fMutex;
+    std::condition_variable fCondition;
+    Int_t fNofShared; // number of fits sharing the lock
+    Int_t fNofWaiting; // number of fits waiting for the exclusive lock
+    Bool_t fExclusive; // whether one fit owns the lock
+  };
+
+  RejectPointLock& GetRejectPointLock()
+  {
+    static RejectPointLock rejectPointLock;
+    return rejectPointLock;
+  }
+
+  enum EFitLockState { kNoFitLock=0, kSharedFitLock=1, kExclusiveFitLock=2 };
+
+  //____________________________________________________________________________
+  typedef void (AliAnalysisMuMuJpsiResult::*FitMethod)();
+
+  /// Compiled table of the fit methods, so fits do not go through the interpreter
+  const std::map<std::string,FitMethod>& FitMethodMap()
+  {
+    static std::map<std::string,FitMethod> fitMethodMap;
+    static std::once_flag once;
+    std::call_once(once,[]{
+      std::map<std::string,FitMethod>& m = fitMethodMap;
+      m["FitPSICOUNT"] = &AliAnalysisMuMuJpsiResult::FitPSICOUNT;
+      m["FitPSICB2"] = &AliAnalysisMuMuJpsiResult::FitPSICB2;
+      m["FitPSINA60NEW"] = &AliAnalysisMuMuJpsiResult::FitPSINA60NEW;
+      m["FitPSIPSIPRIMECB2VWG"] = &AliAnalysisMuMuJpsiResult::FitPSIPSIPRIMECB2VWG;
+      m["FitPSIPSIPRIMECB2VWG2"] = &AliAnalysisMuMuJpsiResult::FitPSIPSIPRIMECB2VWG2;
+      m["FitPSIPSIPRIMECB2POL1POL2"] = &AliAnalysisMuMuJpsiResult::FitPSIPSIPRIMECB2POL1POL2;
+      m["FitPSIPSIPRIMECB2POL2POL3"] = &AliAnalysisMuMuJpsiResult::FitPSIPSIPRIMECB2POL2POL3;
+      m["FitPSIPSIPRIMECB2POL2POL3V2"] = &AliAnalysisMuMuJpsiResult::FitPSIPSIPRIMECB2POL2POL3V2;
+      m["FitPSIPSIPRIMECB2VWGINDEPTAILS"] = &AliAnalysisMuMuJpsiResult::FitPSIPSIPRIMECB2VWGINDEPTAILS;
+      m["FitPSIPSIPRIMECB2POL2EXP"] = &AliAnalysisMuMuJpsiResult::FitPSIPSIPRIMECB2POL2EXP;
+      m["FitPSIPSIPRIMECB2POL4EXP"] = &AliAnalysisMuMuJpsiResult::FitPSIPSIPRIMECB2POL4EXP;
+      m["FitPSIPSIPRIMENA60NEWVWG"] = &AliAnalysisMuMuJpsiResult::FitPSIPSIPRIMENA60NEWVWG;
+      m["FitPSIPSIPRIMENA60NEWVWG2"] = &AliAnalysisMuMuJpsiResult::FitPSIPSIPRIMENA60NEWVWG2;
+      m["FitPSIPSIPRIMENA60NEWPOL1POL2"] = &AliAnalysisMuMuJpsiResult::FitPSIPSIPRIMENA60NEWPOL1POL2;
+      m["FitPSIPSIPRIMENA60NEWPOL2POL3"] = &AliAnalysisMuMuJpsiResult::FitPSIPSIPRIMENA60NEWPOL2POL3;
+      m["FitPSIPSIPRIMENA60NEWPOL2EXP"] = &AliAnalysisMuMuJpsiResult::FitPSIPSIPRIMENA60NEWPOL2EXP;
+      m["FitPSIPSIPRIMENA60NEWPOL4EXP"] = &AliAnalysisMuMuJpsiResult::FitPSIPSIPRIMENA60NEWPOL4EXP;
+      m["FitMPTPSIPSIPRIMECB2VWG_BKGMPTPOL2"] = &AliAnalysisMuMuJpsiResult::FitMPTPSIPSIPRIMECB2VWG_BKGMPTPOL2;
+      m["FitMPTPSIPSIPRIMECB2POL1POL2_BKGMPTPOL2"] = &AliAnalysisMuMuJpsiResult::FitMPTPSIPSIPRIMECB2POL1POL2_BKGMPTPOL2;
+      m["FitMPTPSIPSIPRIMECB2VWG_BKGMPTPOL2EXP"] = &AliAnalysisMuMuJpsiResult::FitMPTPSIPSIPRIMECB2VWG_BKGMPTPOL2EXP;
+      m["FitMPTPSIPSIPRIMECB2POL1POL2_BKGMPTPOL2EXP"] = &AliAnalysisMuMuJpsiResult::FitMPTPSIPSIPRIMECB2POL1POL2_BKGMPTPOL2EXP;
+      m["FitMPTPSIPSIPRIMECB2POL2EXP_BKGMPTPOL2"] = &AliAnalysisMuMuJpsiResult::FitMPTPSIPSIPRIMECB2POL2EXP_BKGMPTPOL2;
+      m["FitMPTPSIPSIPRIMECB2POL2EXP_BKGMPTPOL2EXP"] = &AliAnalysisMuMuJpsiResult::FitMPTPSIPSIPRIMECB2POL2EXP_BKGMPTPOL2EXP;
+      m["FitMPTPSIPSIPRIMENA60NEWVWG_BKGMPTPOL2"] = &AliAnalysisMuMuJpsiResult::FitMPTPSIPSIPRIMENA60NEWVWG_BKGMPTPOL2;
+      m["FitMPTPSIPSIPRIMENA60NEWPOL1POL2_BKGMPTPOL2"] = &AliAnalysisMuMuJpsiResult::FitMPTPSIPSIPRIMENA60NEWPOL1POL2_BKGMPTPOL2;
+      m["FitMPTPSIPSIPRIMENA60NEWVWG_BKGMPTPOL2EXP"] = &AliAnalysisMuMuJpsiResult::FitMPTPSIPSIPRIMENA60NEWVWG_BKGMPTPOL2EXP;
+      m["FitMPTPSIPSIPRIMENA60NEWPOL1POL2_BKGMPTPOL2EXP"] = &AliAnalysisMuMuJpsiResult::FitMPTPSIPSIPRIMENA60NEWPOL1POL2_BKGMPTPOL2EXP;
+      m["FitMPTPSIPSIPRIMENA60NEWPOL2EXP_BKGMPTPOL2"] = &AliAnalysisMuMuJpsiResult::FitMPTPSIPSIPRIMENA60NEWPOL2EXP_BKGMPTPOL2;
+      m["FitMPTPSIPSIPRIMENA60NEWPOL2EXP_BKGMPTPOL2EXP"] = &AliAnalysisMuMuJpsiResult::FitMPTPSIPSIPRIMENA60NEWPOL2EXP_BKGMPTPOL2EXP;
+      m["FitMPTPSIPSIPRIMECB2VWG_BKGMPTPOL3"] = &AliAnalysisMuMuJpsiResult::FitMPTPSIPSIPRIMECB2VWG_BKGMPTPOL3;
+      m["FitMPTPSIPSIPRIMECB2VWG_BKGMPTLIN"] = &AliAnalysisMuMuJpsiResult::FitMPTPSIPSIPRIMECB2VWG_BKGMPTLIN;
+      m["FitMPTPSIPSIPRIMECB2VWGINDEPTAILS_BKGMPTPOL2"] = &AliAnalysisMuMuJpsiResult::FitMPTPSIPSIPRIMECB2VWGINDEPTAILS_BKGMPTPOL2;
+      m["FitMPTPSIPSIPRIMECB2VWG_BKGMPTPOL4"] = &AliAnalysisMuMuJpsiResult::FitMPTPSIPSIPRIMECB2VWG_BKGMPTPOL4;
+      m["FitMV2PSIPSIPRIMECB2VWG_BKGMV2POL2"] = &AliAnalysisMuMuJpsiResult::FitMV2PSIPSIPRIMECB2VWG_BKGMV2POL2;
+      m["FitMV2PSIPSIPRIMECB2VWG_BKGMV2POL2EXP"] = &AliAnalysisMuMuJpsiResult::FitMV2PSIPSIPRIMECB2VWG_BKGMV2POL2EXP;
+      m["FitMV2PSIPSIPRIMECB2VWG_BKGMV2POL3"] = &AliAnalysisMuMuJpsiResult::FitMV2PSIPSIPRIMECB2VWG_BKGMV2POL3;
+      m["FitMV2PSIPSIPRIMECB2VWG_BKGMV2POL4"] = &AliAnalysisMuMuJpsiResult::FitMV2PSIPSIPRIMECB2VWG_BKGMV2POL4;
+      m["FitMPTPSI_HFUNCTION"] = &AliAnalysisMuMuJpsiResult::FitMPTPSI_HFUNCTION;
+      m["FitMV2PSIPSIPRIMECB2VWG2_BKGMV2POLEXP"] = &AliAnalysisMuMuJpsiResult::FitMV2PSIPSIPRIMECB2VWG2_BKGMV2POLEXP;
+      m["FitMV2PSIPSIPRIMECB2VWG2_BKGMV2POL2EXP"] = &AliAnalysisMuMuJpsiResult::FitMV2PSIPSIPRIMECB2VWG2_BKGMV2POL2EXP;
+      m["FitMV2PSIPSIPRIMECB2VWG2_BKGMV2POL4"] = &AliAnalysisMuMuJpsiResult::FitMV2PSIPSIPRIMECB2VWG2_BKGMV2POL4;
+      m["FitMV2PSIPSIPRIMECB2VWG2_BKGMV2POL4Cheb"] = &AliAnalysisMuMuJpsiResult::FitMV2PSIPSIPRIMECB2VWG2_BKGMV2POL4Cheb;
+      m["FitMV2PSIPSIPRIMECB2POL2POL3_BKGMV2POL2"] = &AliAnalysisMuMuJpsiResult::FitMV2PSIPSIPRIMECB2POL2POL3_BKGMV2POL2;
+      m["FitMV2PSIPSIPRIMECB2POL2POL3_BKGMV2POLEXP"] = &AliAnalysisMuMuJpsiResult::FitMV2PSIPSIPRIMECB2POL2POL3_BKGMV2POLEXP;
+      m["FitMV2PSIPSIPRIMECB2POL2POL3_BKGMV2POL2EXP"] = &AliAnalysisMuMuJpsiResult::FitMV2PSIPSIPRIMECB2POL2POL3_BKGMV2POL2EXP;
+      m["FitMV2PSIPSIPRIMECB2POL2POL3_BKGMV2POL4Cheb"] = &AliAnalysisMuMuJpsiResult::FitMV2PSIPSIPRIMECB2POL2POL3_BKGMV2POL4Cheb;
+      m["FitMV2PSIPSIPRIMECB2POL2POL3_BKGMV2POL4"] = &AliAnalysisMuMuJpsiResult::FitMV2PSIPSIPRIMECB2POL2POL3_BKGMV2POL4;
+      m["FitMV2PSIPSIPRIMENA60NEWVWG2_BKGMV2POL2"] = &AliAnalysisMuMuJpsiResult::FitMV2PSIPSIPRIMENA60NEWVWG2_BKGMV2POL2;
+      m["FitMV2PSIPSIPRIMENA60NEWVWG2_BKGMV2POLEXP"] = &AliAnalysisMuMuJpsiResult::FitMV2PSIPSIPRIMENA60NEWVWG2_BKGMV2POLEXP;
+      m["FitMV2PSIPSIPRIMENA60NEWVWG2_BKGMV2POL2EXP"] = &AliAnalysisMuMuJpsiResult::FitMV2PSIPSIPRIMENA60NEWVWG2_BKGMV2POL2EXP;
+      m["FitMV2PSIPSIPRIMENA60NEWVWG2_BKGMV2POL4"] = &AliAnalysisMuMuJpsiResult::FitMV2PSIPSIPRIMENA60NEWVWG2_BKGMV2POL4;
+      m["FitMV2PSIPSIPRIMENA60NEWVWG2_BKGMV2POL4Cheb"] = &AliAnalysisMuMuJpsiResult::FitMV2PSIPSIPRIMENA60NEWVWG2_BKGMV2POL4Cheb;
+      m["FitMV2PSIPSIPRIMENA60NEWPOL2POL3_BKGMV2POL2"] = &AliAnalysisMuMuJpsiResult::FitMV2PSIPSIPRIMENA60NEWPOL2POL3_BKGMV2POL2;
+      m["FitMV2PSIPSIPRIMENA60NEWPOL2POL3_BKGMV2POLEXP"] = &AliAnalysisMuMuJpsiResult::FitMV2PSIPSIPRIMENA60NEWPOL2POL3_BKGMV2POLEXP;
+      m["FitMV2PSIPSIPRIMENA60NEWPOL2POL3_BKGMV2POL2EXP"] = &AliAnalysisMuMuJpsiResult::FitMV2PSIPSIPRIMENA60NEWPOL2POL3_BKGMV2POL2EXP;
+      m["FitMV2PSIPSIPRIMENA60NEWPOL2POL3_BKGMV2POL4"] = &AliAnalysisMuMuJpsiResult::FitMV2PSIPSIPRIMENA60NEWPOL2POL3_BKGMV2POL4;
+      m["FitMV2PSIPSIPRIMENA60NEWPOL2POL3_BKGMV2POL4Cheb"] = &AliAnalysisMuMuJpsiResult::FitMV2PSIPSIPRIMENA60NEWPOL2POL3_BKGMV2POL4Cheb;
+    });
+    return fitMethodMap;
+  }
+}
+
+Bool_t AliAnalysisMuMuJpsiResult::fgThreadedFits = kFALSE;
 
 //_____________________________________________________________________________
 AliAnalysisMuMuJpsiResult::AliAnalysisMuMuJpsiResult(TRootIOCtor* /*io*/) :
@@ -106,7 +237,9 @@ fFitRejectRangeLow(TMath::Limits<Double_t>::Max()),
 fFitRejectRangeHigh(TMath::Limits<Double_t>::Max()),
 fRejectFitPoints(kFALSE),
 fParticle(""),
-fMinvRS("")
+fMinvRS(""),
+fWarmStart(0x0),
+fFitLockState(kNoFitLock)
 {
 }
 
@@ -129,7 +262,9 @@ fFitRejectRangeLow(TMath::Limits<Double_t>::Max()),
 fFitRejectRangeHigh(TMath::Limits<Double_t>::Max()),
 fRejectFitPoints(kFALSE),
 fParticle(particle),
-fMinvRS("")
+fMinvRS(""),
+fWarmStart(0x0),
+fFitLockState(kNoFitLock)
 {
   SetHisto(h);
 
@@ -208,7 +343,9 @@ fFitRejectRangeLow(TMath::Limits<Double_t>::Max()),
 fFitRejectRangeHigh(TMath::Limits<Double_t>::Max()),
 fRejectFitPoints(kFALSE),
 fParticle(particle),
-fMinvRS("")
+fMinvRS(""),
+fWarmStart(0x0),
+fFitLockState(kNoFitLock)
 {
   SetHisto(h);
 }
@@ -230,7 +367,9 @@ fFitRejectRangeLow(rhs.fFitRejectRangeLow),
 fFitRejectRangeHigh(rhs.fFitRejectRangeHigh),
 fRejectFitPoints(rhs.fRejectFitPoints),
 fParticle(rhs.fParticle),
-fMinvRS(rhs.fMinvRS)
+fMinvRS(rhs.fMinvRS),
+fWarmStart(0x0),
+fFitLockState(kNoFitLock)
 {
   /// copy ctor
   /// Note that the mother is lost
@@ -280,6 +419,7 @@ AliAnalysisMuMuJpsiResult& AliAnalysisMuMuJpsiResult::operator=(const AliAnalysi
 AliAnalysisMuMuJpsiResult::~AliAnalysisMuMuJpsiResult()
 {
   // dtor
+  ReleaseFitLock();
   delete fHisto;
 }
 
@@ -473,7 +613,7 @@ Double_t AliAnalysisMuMuJpsiResult::FitFunctionBackgroundPol1Pol2(Double_t *x, D
     TF1::RejectPoint();
     return 0.;
   }
-  else TF1::RejectPoint(kFALSE);
+  else if (fRejectFitPoints) TF1::RejectPoint(kFALSE);
   return (par[0]*x[0] + par[1] )/(par[2]*x[0]*x[0] + par[3]*x[0] + par[4]) ;
 }
 
@@ -487,7 +627,7 @@ Double_t AliAnalysisMuMuJpsiResult::FitFunctionBackgroundPol2Pol3(Double_t *x, D
     TF1::RejectPoint();
     return 0.;
   }
-  else TF1::RejectPoint(kFALSE);
+  else if (fRejectFitPoints) TF1::RejectPoint(kFALSE);
   return (  par[0]*x[0]*x[0] + x[0]*par[1] + par[2]  )/( par[3]*x[0]*x[0]*x[0]+ par[4]*x[0]*x[0] + par[5]*x[0] + par[6]) ;
 }
 
@@ -501,7 +641,7 @@ Double_t AliAnalysisMuMuJpsiResult::FitFunctionBackgroundPol2Pol3V2(Double_t *x,
     TF1::RejectPoint();
     return 0.;
   }
-  else TF1::RejectPoint(kFALSE);
+  else if (fRejectFitPoints) TF1::RejectPoint(kFALSE);
   return (  par[0]*x[0]*x[0] + x[0]*par[1] + par[2]  )/( (par[3] + x[0])*(par[4] + x[0])*(par[5] + x[0])) ;
 }
 
@@ -623,7 +763,7 @@ Double_t AliAnalysisMuMuJpsiResult::FitFunctionBackgroundVWG(Double_t *x, Double
     TF1::RejectPoint();
     return 0.;
   }
-  else TF1::RejectPoint(kFALSE);
+  else if (fRejectFitPoints) TF1::RejectPoint(kFALSE);
   Double_t sigma = par[2]+par[3]*((x[0]-par[1])/par[1]);
   return par[0]*TMath::Exp(-(x[0]-par[1])*(x[0]-par[1])/(2.*sigma*sigma));
 }
@@ -638,7 +778,7 @@ Double_t AliAnalysisMuMuJpsiResult::FitFunctionBackgroundVWG2(Double_t *x, Doubl
     TF1::RejectPoint();
     return 0.;
   }
-  else TF1::RejectPoint(kFALSE);
+  else if (fRejectFitPoints) TF1::RejectPoint(kFALSE);
   Double_t sigma = par[2] + par[3]*((x[0]-par[1])/par[1]) + par[4]*((x[0]-par[1])/par[1])*((x[0]-par[1])/par[1]);
   return par[0]*TMath::Exp(-(x[0]-par[1])*(x[0]-par[1])/(2.*sigma*sigma));
 }
@@ -1799,6 +1939,8 @@ void AliAnalysisMuMuJpsiResult::FitPSICB2()
 //  fitTotal->FixParameter(5, alphaUp);
 //  fitTotal->FixParameter(6, nUp);
 
+  ApplyWarmStart(fitTotal);
+
   TFitResultPtr fitResult = fHisto->Fit(fitTotal,"SERL","");
 
   // Check parameters...
@@ -1973,6 +2115,8 @@ void AliAnalysisMuMuJpsiResult::FitPSINA60NEW()
 //  SetParameter(fitTotal,9,alphaLeft,1.,-1.E8,1.E5);
 //  SetParameter(fitTotal,10,alphaRight,1.0,-1.E5,1.E5);
 
+  ApplyWarmStart(fitTotal);
+
   TFitResultPtr fitResult = fHisto->Fit(fitTotal,"SERL","");
 
   // Check parameters...
@@ -2478,6 +2622,8 @@ void AliAnalysisMuMuJpsiResult::FitPSIPSIPRIMECB2VWG()
 
 
   //_____________First fit attempt
+  ApplyWarmStart(fitTotal);
+
   TFitResultPtr fitResult = fHisto->Fit(fitTotal,fitOption,"");
 
   std::cout << "FitResult = " << static_cast<int>(fitResult) << std::endl;
@@ -2761,6 +2907,8 @@ void AliAnalysisMuMuJpsiResult::FitPSIPSIPRIMECB2VWG2()
 
 
   //_____________First fit attempt
+  ApplyWarmStart(fitTotal);
+
   TFitResultPtr fitResult = fHisto->Fit(fitTotal,fitOption,"");
 
   std::cout << "FitResult = " << static_cast<int>(fitResult) << std::endl;
@@ -3092,6 +3240,8 @@ void AliAnalysisMuMuJpsiResult::FitPSIPSIPRIMECB2POL1POL2()
 
 
   //_____________First fit attempt
+  ApplyWarmStart(fitTotal);
+
   TFitResultPtr fitResult = fHisto->Fit(fitTotal,fitOption,"");
   // CheckRoots(fitResult,fitTotal,2,fitTotal->GetParameter(2),fitTotal->GetParameter(3),fitTotal->GetParameter(4),0.,fitOption);
 
@@ -3385,6 +3535,8 @@ void AliAnalysisMuMuJpsiResult::FitPSIPSIPRIMECB2POL2POL3()
   //______________
 
   //_____________Fit attempt
+  ApplyWarmStart(fitTotal);
+
   TFitResultPtr fitResult = fHisto->Fit(fitTotal,fitOption,"");
   std::cout << "FitResult = " << static_cast<int>(fitResult) << std::endl;
   std::cout << "CovMatrixStatus = " << fitResult->CovMatrixStatus() << std::endl;
@@ -3616,6 +3768,8 @@ void AliAnalysisMuMuJpsiResult::FitPSIPSIPRIMECB2POL2POL3V2()
   //______________
 
   //_____________Fit attempt
+  ApplyWarmStart(fitTotal);
+
   TFitResultPtr fitResult = fHisto->Fit(fitTotal,fitOption,"");
   std::cout << "FitResult = " << static_cast<int>(fitResult) << std::endl;
   std::cout << "CovMatrixStatus = " << fitResult->CovMatrixStatus() << std::endl;
@@ -3951,6 +4105,8 @@ void AliAnalysisMuMuJpsiResult::FitPSIPSIPRIMECB2VWGINDEPTAILS()
 
   //  SetFitRejectRange();
 
+  ApplyWarmStart(fitTotal);
+
   TFitResultPtr fitResult = fHisto->Fit(fitTotal,fitOption,"");
 
   std::cout << "FitResult = " << static_cast<int>(fitResult) << std::endl;
@@ -4234,6 +4390,8 @@ void AliAnalysisMuMuJpsiResult::FitPSIPSIPRIMECB2POL2EXP()
 
 
   //_____________First fit attempt
+  ApplyWarmStart(fitTotal);
+
   TFitResultPtr fitResult = fHisto->Fit(fitTotal,fitOption,"");
 
   std::cout << "FitResult = " << static_cast<int>(fitResult) << std::endl;
@@ -4510,6 +4668,8 @@ void AliAnalysisMuMuJpsiResult::FitPSIPSIPRIMECB2POL4EXP()
   const char* fitOption = "SER";
 
   //_____________First fit attempt
+  ApplyWarmStart(fitTotal);
+
   TFitResultPtr fitResult = fHisto->Fit(fitTotal,fitOption,"");
 
   std::cout << "FitResult = " << static_cast<int>(fitResult) << std::endl;
@@ -4792,6 +4952,8 @@ void AliAnalysisMuMuJpsiResult::FitPSIPSIPRIMENA60NEWVWG()
   // fitTotal->SetParLimits(15, 0.,fHisto->GetBinContent(bin));
 
   //_____________First fit attempt
+  ApplyWarmStart(fitTotal);
+
   TFitResultPtr fitResult = fHisto->Fit(fitTotal,fitOption,"");
 
   std::cout << "FitResult = " << static_cast<int>(fitResult) << std::endl;
@@ -5086,6 +5248,8 @@ void AliAnalysisMuMuJpsiResult::FitPSIPSIPRIMENA60NEWVWG2()
   // fitTotal->SetParLimits(16, 0.,1.1*fHisto->GetBinContent(bin));
 
   //_____________First fit attempt
+  ApplyWarmStart(fitTotal);
+
   TFitResultPtr fitResult = fHisto->Fit(fitTotal,fitOption,"");
 
   std::cout << "FitResult = " << static_cast<int>(fitResult) << std::endl;
@@ -5373,6 +5537,8 @@ void AliAnalysisMuMuJpsiResult::FitPSIPSIPRIMENA60NEWPOL1POL2()
   // fitTotal->SetParLimits(16, 0.,fHisto->GetBinContent(bin));
 
   //_____________First fit attempt
+  ApplyWarmStart(fitTotal);
+
   TFitResultPtr fitResult = fHisto->Fit(fitTotal,fitOption,"");
 
   std::cout << "FitResult = " << static_cast<int>(fitResult) << std::endl;
@@ -5679,6 +5845,8 @@ void AliAnalysisMuMuJpsiResult::FitPSIPSIPRIMENA60NEWPOL2POL3()
   // fitTotal->SetParLimits(18, fHisto->GetBinContent(bin)*0.1,fHisto->GetBinContent(bin)*1.5);
 
   //_____________First fit attempt
+  ApplyWarmStart(fitTotal);
+
   TFitResultPtr fitResult = fHisto->Fit(fitTotal,fitOption,"");
   std::cout << "FitResult = " << static_cast<int>(fitResult) << std::endl;
   std::cout << "CovMatrixStatus = " << fitResult->CovMatrixStatus() << std::endl;
@@ -5961,6 +6129,8 @@ void AliAnalysisMuMuJpsiResult::FitPSIPSIPRIMENA60NEWPOL2EXP()
   fitTotal->SetParLimits(15, fHisto->GetBinContent(bin)*0.01,fHisto->GetBinContent(bin));
 
   //_____________First fit attempt
+  ApplyWarmStart(fitTotal);
+
   TFitResultPtr fitResult = fHisto->Fit(fitTotal,fitOption,"");
 
   std::cout << "FitResult = " << static_cast<int>(fitResult) << std::endl;
@@ -6246,6 +6416,8 @@ void AliAnalysisMuMuJpsiResult::FitPSIPSIPRIMENA60NEWPOL4EXP()
   const char* fitOption = "SER";
 
   //_____________First fit attempt
+  ApplyWarmStart(fitTotal);
+
   TFitResultPtr fitResult = fHisto->Fit(fitTotal,fitOption,"");
 
   std::cout << "FitResult = " << static_cast<int>(fitResult) << std::endl;
@@ -12510,38 +12682,96 @@ Bool_t AliAnalysisMuMuJpsiResult::AddFit(const char* fitType)
 {
   // Add a fit to this result
 
-  if ( !fHisto ) return kFALSE;
+  AliAnalysisMuMuJpsiResult* r = PrepareFit(fitType);
+
+  if (!r) return kFALSE;
+
+  if ( !r->ExecuteFit() )
+  {
+    delete r;
+    return kFALSE;
+  }
+
+  return AdoptFit(r);
+}
+
+//_____________________________________________________________________________
+AliAnalysisMuMuJpsiResult* AliAnalysisMuMuJpsiResult::PrepareFit(const char* fitType) const
+{
+  /// Create the sub-result (not adopted yet) holding the fit described by fitType.
+  /// Returns 0x0 if the fit cannot be done (no histo, not enough statistics, invalid fitType)
+
+  if ( !fHisto ) return 0x0;
 
   TH1* histo = static_cast<TH1*>(fHisto->Clone(fitType));
 
-  AliAnalysisMuMuJpsiResult* r = new AliAnalysisMuMuJpsiResult(GetParticle(),*histo,fitType);
+  AliAnalysisMuMuJpsiResult* r = new AliAnalysisMuMuJpsiResult(fParticle.Data(),*histo,fitType);
+
+  delete histo;
 
   if ( !r->IsValid() )
   {
     delete r;
-    return kFALSE;
+    return 0x0;
   }
 
-  TMethodCall callEnv;
+  return r;
+}
+
+//_____________________________________________________________________________
+Bool_t AliAnalysisMuMuJpsiResult::ExecuteFit()
+{
+  /// Run the fit method corresponding to the fit function of this result.
+  /// Returns kFALSE if there is no such method, the outcome of the fit itself
+  /// is given by IsValid()
 
-  TString fittingMethod(r->GetFitFunctionMethodName().Data());
+  TString fittingMethod(GetFitFunctionMethodName().Data());
 
   std::cout << "+Using fitting method " << fittingMethod.Data() << "..." << std::endl;
   std::cout << "" << std::endl;
 
-  callEnv.InitWithPrototype(IsA(),fittingMethod.Data(),"");
+  std::map<std::string,FitMethod>::const_iterator it = FitMethodMap().find(fittingMethod.Data());
 
-  if (callEnv.IsValid())
+  if ( it != FitMethodMap().end() )
   {
-    callEnv.Execute(r);// here fit Method ("fit<SOMETHING>") is called and the fit is proceed.
+    if ( fgThreadedFits )
+    {
+      GetRejectPointLock().LockShared();
+      fFitLockState = kSharedFitLock;
+    }
+
+    (this->*(it->second))(); // here fit Method ("fit<SOMETHING>") is called and the fit is proceed.
+
+    ReleaseFitLock();
+    return kTRUE;
   }
-  else
+
+  if ( !fgThreadedFits )
   {
-    AliError(Form("Could not get the method %s",fittingMethod.Data()));
-    delete r;
-    return kFALSE;
+    // not in the table of compiled methods, try the interpreter
+    TMethodCall callEnv;
+
+    callEnv.InitWithPrototype(IsA(),fittingMethod.Data(),"");
+
+    if (callEnv.IsValid())
+    {
+      callEnv.Execute(this);
+      return kTRUE;
+    }
   }
 
+  AliError(Form("Could not get the method %s",fittingMethod.Data()));
+  return kFALSE;
+}
+
+//_____________________________________________________________________________
+Bool_t AliAnalysisMuMuJpsiResult::AdoptFit(AliAnalysisMuMuJpsiResult* r)
+{
+  /// Adopt the (executed) fit r as a sub-result of this one.
+  /// r is deleted if the fit is not valid.
+
+  if (!r) return kFALSE;
+
   if ( r->IsValid() )
   {
     StdoutToAliDebug(1,r->Print(););
@@ -12567,6 +12797,66 @@ Bool_t AliAnalysisMuMuJpsiResult::AddFit(const char* fitType)
   return (r!=0x0);
 }
 
+//_____________________________________________________________________________
+void AliAnalysisMuMuJpsiResult::ApplyWarmStart(TF1* fitFunction) const
+{
+  /// Initialise the free parameters of fitFunction with the values of the warm start
+  /// result (if any) for the same parameter names.
+  /// Fixed parameters and values outside of the parameter limits are left untouched.
+
+  if ( !fWarmStart || !fitFunction ) return;
+
+  Int_t nofSet(0);
+
+  for ( Int_t i = 0; i < fitFunction->GetNpar(); ++i )
+  {
+    const char* parName = fitFunction->GetParName(i);
+
+    if ( !fWarmStart->HasValue(parName) ) continue;
+
+    Double_t value = fWarmStart->GetValue(parName);
+
+    if ( !IsValidValue(value) ) continue;
+
+    Double_t min(0.0),max(0.0);
+    fitFunction->GetParLimits(i,min,max);
+
+    if ( min*max != 0 && min >= max ) continue; // fixed parameter
+
+    if ( min < max && ( value < min || value > max ) ) continue;
+
+    fitFunction->SetParameter(i,value);
+    ++nofSet;
+  }
+
+  AliDebug(1,Form("%d parameters of %s initialised from %s",nofSet,fitFunction->GetName(),fWarmStart->GetName()));
+}
+
+//_____________________________________________________________________________
+void AliAnalysisMuMuJpsiResult::ReleaseFitLock()
+{
+  /// Release the lock on the TF1::RejectPoint flag held by this result (threaded fits only)
+
+  if ( fFitLockState == kSharedFitLock ) GetRejectPointLock().UnlockShared();
+  else if ( fFitLockState == kExclusiveFitLock )
+  {
+    TF1::RejectPoint(kFALSE);
+    GetRejectPointLock().Unlock();
+  }
+  fFitLockState = kNoFitLock;
+}
+
+//_____________________________________________________________________________
+void AliAnalysisMuMuJpsiResult::SetThreadedFits(Bool_t value)
+{
+  /// To be set (after ROOT::EnableThreadSafety()) before calling ExecuteFit of
+  /// different results concurrently. The parts of the fits done with a reject range
+  /// (background pre-fits) are then serialised, as they rely on the global
+  /// TF1::RejectPoint flag. Only the compiled fit methods are available in this mode.
+
+  fgThreadedFits = value;
+}
+
 //_____________________________________________________________________________
 void AliAnalysisMuMuJpsiResult::DecodeFitType(const char* fitType)
 {
@@ -13391,10 +13681,27 @@ void AliAnalysisMuMuJpsiResult::SetFitRejectRange(Double_t a, Double_t b)
 
   fFitRejectRangeLow = a;
   fFitRejectRangeHigh = b;
-  if ( a <= TMath::Limits<Double_t>::Max() && b <= TMath::Limits<Double_t>::Max() )
+  if ( a < TMath::Limits<Double_t>::Max() && b < TMath::Limits<Double_t>::Max() )
   {
     fRejectFitPoints = kTRUE;
   }
+
+  if ( fFitLockState == kNoFitLock ) return;
+
+  // threaded fits : the TF1::RejectPoint flag can only be used by one fit at a time
+  if ( fRejectFitPoints && fFitLockState == kSharedFitLock )
+  {
+    GetRejectPointLock().UnlockShared();
+    GetRejectPointLock().Lock();
+    fFitLockState = kExclusiveFitLock;
+  }
+  else if ( !fRejectFitPoints && fFitLockState == kExclusiveFitLock )
+  {
+    TF1::RejectPoint(kFALSE);
+    GetRejectPointLock().Unlock();
+    GetRejectPointLock().LockShared();
+    fFitLockState = kSharedFitLock;
+  }
 }
 
 //_____________________________________________________________________________
@@ -13632,10 +13939,18 @@ Bool_t AliAnalysisMuMuJpsiResult::CheckFitStatus(TFitResultPtr &fitResult)
     isok =kFALSE;
     AliDebug(1,Form("Fit rejected because of covariant matrix : %d",fitResult->CovMatrixStatus()));
   }
-  TString minuitStatus = gMinuit->fCstatu;
-  if(!minuitStatus.Contains("SUCCESSFUL") && !minuitStatus.Contains("OK") && !minuitStatus.Contains("PROBLEMS")){
+  TString minimizer(fitResult->MinimizerType());
+  if ( minimizer.BeginsWith("Minuit") && !minimizer.BeginsWith("Minuit2") ) {
+    TString minuitStatus = gMinuit ? gMinuit->fCstatu : "";
+    if(!minuitStatus.Contains("SUCCESSFUL") && !minuitStatus.Contains("OK") && !minuitStatus.Contains("PROBLEMS")){
+      isok =kFALSE;
+      AliDebug(1,"Minuit status is not ok !");
+    }
+  }
+  else if ( !fitResult->IsValid() ) {
+    // the TMinuit status string is only available with TMinuit (threaded fits use Minuit2)
     isok =kFALSE;
-    AliDebug(1,"Minuit status is not ok !");
+    AliDebug(1,"Minimizer status is not ok !");
   }
   return isok;
 }
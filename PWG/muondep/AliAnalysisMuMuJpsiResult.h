@@ -80,6 +80,30 @@ public:
 
   Bool_t AddFit(const char* fitType);
 
+  /** AddFit split in its three steps, to be used by drivers running several fits
+   (e.g. AliAnalysisMuMuFitScan) :
+   PrepareFit creates the (not yet adopted) sub-result for the fitType,
+   ExecuteFit runs its fit method and AdoptFit attaches it to this result (or deletes it
+   if the fit did not succeed). AddFit(fitType) is PrepareFit+ExecuteFit+AdoptFit.
+   */
+  AliAnalysisMuMuJpsiResult* PrepareFit(const char* fitType) const;
+
+  Bool_t ExecuteFit();
+
+  Bool_t AdoptFit(AliAnalysisMuMuJpsiResult* r);
+
+  /// Result (typically a converged fit of a neighbouring configuration) used to initialise
+  /// the free parameters of the total minv fit. Not owner.
+  void SetWarmStart(const AliAnalysisMuMuResult* r) { fWarmStart = r; }
+
+  const AliAnalysisMuMuResult* WarmStart() const { return fWarmStart; }
+
+  /// Whether ExecuteFit may be called concurrently from several threads
+  /// (serialises the use of the global TF1::RejectPoint flag)
+  static void SetThreadedFits(Bool_t value);
+
+  static Bool_t ThreadedFits() { return fgThreadedFits; }
+
   /** All the fit functions should have a prototype starting like :
 
    AliAnalysisMuMuJpsiResult* FitXXX();
@@ -377,6 +401,11 @@ private:
   Bool_t StrongCorrelation(TFitResultPtr& fitResult, TF1* fitFunction, Int_t npar1, Int_t npar2, Double_t fixValueIfWrong);
 
   Bool_t CheckFitStatus(TFitResultPtr &fitResult);
+
+  void ApplyWarmStart(TF1* fitFunction) const;
+
+  void ReleaseFitLock();
+
 private:
   Int_t fNofRuns; // number of runs used to get this result
   Int_t fNofTriggers; // number of trigger analyzed
@@ -396,7 +425,12 @@ private:
   TString fParticle;
   TString fMinvRS; // minv spectra range and sigmaPsiP factor for the mpt fits
 
-  ClassDef(AliAnalysisMuMuJpsiResult,8) // a class to hold invariant mass analysis results (counts, yields, AccxEff, R_AB, etc...)
+  const AliAnalysisMuMuResult* fWarmStart; //! result to take the initial fit parameters from (not owner)
+  Int_t fFitLockState; //! lock held on the TF1::RejectPoint flag in threaded mode (0 none, 1 shared, 2 exclusive)
+
+  static Bool_t fgThreadedFits; // whether fits can run concurrently
+
+  ClassDef(AliAnalysisMuMuJpsiResult,9) // a class to hold invariant mass analysis results (counts, yields, AccxEff, R_AB, etc...)
 };
 
 #endif
@@ -12,12 +12,238 @@
 #include "TMath.h"
 #include "TParameter.h"
 #include "TTree.h"
+#include <algorithm>
+#include <atomic>
 #include <cassert>
 #include <iostream>
+#include <thread>
+
+namespace
+{
+    /// Station requirement of the track validation : at least one cluster
+    /// per station, and 2 chambers hit in the same station (4 or 5)
+    class StationCounter
+    {
+        public:
+            StationCounter() : mPresentStationMask(0), mPreviousCh(-1), mNChHitInSt4(0), mNChHitInSt5(0) {}
+
+            void Add(Int_t currentCh)
+            {
+                Int_t currentSt = currentCh/2;
+
+                // build present station mask
+                mPresentStationMask |= ( 1 << currentSt );
+
+                // count the number of chambers hit in station 4 that contain cluster(s)
+                if (currentSt == 3 && currentCh != mPreviousCh) {
+                    ++mNChHitInSt4;
+                    mPreviousCh = currentCh;
+                }
+
+                // count the number of chambers hit in station 5 that contain cluster(s)
+                if (currentSt == 4 && currentCh != mPreviousCh) {
+                    ++mNChHitInSt5;
+                    mPreviousCh = currentCh;
+                }
+            }
+
+            Bool_t IsOK() const
+            {
+                const UInt_t requestedStationMask = 0x1F;
+                const Bool_t request2ChInSameSt45 = kTRUE;
+
+                // at least one cluster per requested station
+                if ((requestedStationMask & mPresentStationMask) != requestedStationMask) 
+                {
+                    return kFALSE;
+                }
+
+                if (request2ChInSameSt45) 
+                {
+                    // 2 chambers hit in the same station (4 or 5)
+                    return (mNChHitInSt4 == 2 || mNChHitInSt5 == 2);
+                }
+                else 
+                {
+                    // or 2 chambers hit in station 4 & 5 together
+                    return (mNChHitInSt4+mNChHitInSt5 >= 2);
+                }
+            }
+
+        private:
+            UInt_t mPresentStationMask;
+            Int_t mPreviousCh;
+            Int_t mNChHitInSt4;
+            Int_t mNChHitInSt5;
+    };
+
+    /// A cluster of the flattened events
+    struct FlatCluster
+    {
+        int mBendingManuIx;
+        int mNonBendingManuIx;
+        int mChamber;
+        bool mStation12;
+    };
+
+    /// The compact events flattened once for all the runs
+    struct FlatEvents
+    {
+        std::vector<FlatCluster> mClusters; /// clusters of all the tracks
+        std::vector<UInt_t> mFirstCluster; /// index of the first cluster of each track (plus the end)
+        std::vector<std::pair<UInt_t,UInt_t> > mPairs; /// track pairs within the rapidity range
+    };
+
+    /// Map the clusters of the events to their manu indices once, and list the
+    /// track pairs within the rapidity range (those do not depend on the manu status)
+    void FlattenEvents(const std::vector<AliMuonCompactEvent>& events, ULong64_t maxevents, FlatEvents& flat)
+    {
+        const double m2 = 0.1056584*0.1056584;
+
+        flat.mClusters.clear();
+        flat.mFirstCluster.clear();
+        flat.mPairs.clear();
+
+        for ( std::vector<AliMuonCompactEvent>::size_type i = 0; i < maxevents; ++i )
+        {
+            const AliMuonCompactEvent& e = events[i];
+
+            UInt_t firstTrack = flat.mFirstCluster.size();
+
+            for ( std::vector<AliMuonCompactTrack>::size_type j = 0; j < e.mTracks.size(); ++j )
+            {
+                const AliMuonCompactTrack& t = e.mTracks[j];
+
+                flat.mFirstCluster.push_back(flat.mClusters.size());
+
+                for ( std::vector<AliMuonCompactCluster>::size_type c = 0; c < t.mClusters.size(); ++c )
+                {
+                    const AliMuonCompactCluster& cl = t.mClusters[c];
+                    FlatCluster fc;
+                    fc.mBendingManuIx = cl.BendingManuIndex();
+                    fc.mNonBendingManuIx = cl.NonBendingManuIndex();
+                    fc.mChamber = cl.DetElemId()/100 - 1;
+                    fc.mStation12 = ( fc.mBendingManuIx >=0 && fc.mBendingManuIx < 7152 ) ||
+                        ( fc.mNonBendingManuIx >=0 && fc.mNonBendingManuIx < 7152 );
+                    flat.mClusters.push_back(fc);
+                }
+            }
+
+            for ( std::vector<AliMuonCompactTrack>::size_type j = 0; j < e.mTracks.size(); ++j )
+            {
+                const AliMuonCompactTrack& t1 = e.mTracks[j];
+
+                for ( std::vector<AliMuonCompactTrack>::size_type k = j+1; k < e.mTracks.size(); ++k )
+                {
+                    const AliMuonCompactTrack& t2 = e.mTracks[k];
+
+                    double p1square = t1.mPx*t1.mPx + t1.mPy*t1.mPy + t1.mPz*t1.mPz;
+                    double p2square = t2.mPx*t2.mPx + t2.mPy*t2.mPy + t2.mPz*t2.mPz;
+
+                    double energy = sqrt(m2+p1square+p2square+2.0*sqrt(p1square)*sqrt(p2square));
+                    double pz = t1.mPz+t2.mPz;
+
+                    double y = 0.5*log( (energy+pz) / (energy-pz) );
+
+                    if (y >= -4 && y <= -2.5 )
+                    {
+                        flat.mPairs.push_back(std::make_pair(firstTrack+j,firstTrack+k));
+                    }
+                }
+            }
+        }
+        flat.mFirstCluster.push_back(flat.mClusters.size());
+    }
+
+    /// Whether the manu is bad, i.e. its bit is set in the bitset
+    inline bool IsBadManu(const std::vector<ULong64_t>& badManus, int manuIndex)
+    {
+        if ( manuIndex < 0 ) return false;
+        UInt_t word = manuIndex / 64;
+        return word < badManus.size() && ( ( badManus[word] >> ( manuIndex % 64 ) ) & 1 );
+    }
+
+    /// Result of the validation of the flattened events for one (run,cause)
+    struct EvolutionPoint
+    {
+        EvolutionPoint() : mFound(false), mNofBadManus(0), mNofTracks(0), mNofValidatedTracks(0), mNofPairs(0) {}
+        bool mFound;
+        Long64_t mNofBadManus;
+        Int_t mNofTracks;
+        Int_t mNofValidatedTracks;
+        Int_t mNofPairs;
+    };
+
+    /// Same as AliMuonCompactQuickAccEff::ComputeMinv (without the histogram), for the flattened events
+    void ComputeEvolutionPoint(const FlatEvents& flat,
+            const std::vector<UInt_t>& manustatus,
+            UInt_t causeMask,
+            bool rejectMonoCathodeClusters,
+            EvolutionPoint& point)
+    {
+        // bitset of the manus that are bad for this cause
+        std::vector<ULong64_t> badManus((manustatus.size()+63)/64,0);
+
+        for ( std::vector<UInt_t>::size_type i = 0; i < manustatus.size(); ++i )
+        {
+            if ( manustatus[i] & causeMask )
+            {
+                badManus[i/64] |= ( 1ULL << ( i % 64 ) );
+                ++point.mNofBadManus;
+            }
+        }
+
+        bool allValid = ( manustatus.empty() || causeMask == 0 );
+
+        UInt_t ntracks = flat.mFirstCluster.size()-1;
+        std::vector<char> validTracks(ntracks,0);
+
+        for ( UInt_t t = 0; t < ntracks; ++t )
+        {
+            bool valid = allValid;
+
+            if (!valid)
+            {
+                StationCounter stations;
+
+                for ( UInt_t c = flat.mFirstCluster[t]; c < flat.mFirstCluster[t+1]; ++c )
+                {
+                    const FlatCluster& cl = flat.mClusters[c];
+
+                    bool bendingIsOK = !IsBadManu(badManus,cl.mBendingManuIx);
+                    bool nonBendingIsOK = !IsBadManu(badManus,cl.mNonBendingManuIx);
+
+                    // see AliMuonCompactQuickAccEff::ValidateCluster
+                    bool clusterIsOK = ( rejectMonoCathodeClusters && !cl.mStation12 ) ?
+                        ( bendingIsOK && nonBendingIsOK ) : ( bendingIsOK || nonBendingIsOK );
+
+                    if ( clusterIsOK )
+                    {
+                        stations.Add(cl.mChamber);
+                    }
+                }
+                valid = stations.IsOK();
+            }
+
+            validTracks[t] = valid;
+            point.mNofValidatedTracks += valid;
+        }
+
+        point.mNofTracks = ntracks;
+
+        for ( std::vector<std::pair<UInt_t,UInt_t> >::size_type i = 0; i < flat.mPairs.size(); ++i )
+        {
+            if ( validTracks[flat.mPairs[i].first] && validTracks[flat.mPairs[i].second] )
+            {
+                ++point.mNofPairs;
+            }
+        }
+    }
+}
 
 /// \ingroup compact
 AliMuonCompactQuickAccEff::AliMuonCompactQuickAccEff(int maxevents, bool rejectMonoCathodeClusters)
-    : fMaxEvents(maxevents), fRejectMonoCathodeClusters(rejectMonoCathodeClusters)
+    : fMaxEvents(maxevents), fRejectMonoCathodeClusters(rejectMonoCathodeClusters), fNofThreads(0)
 {
 }
 
@@ -112,14 +338,7 @@ Bool_t AliMuonCompactQuickAccEff::ValidateTrack(const AliMuonCompactTrack& track
 
     if ( manuStatus.empty() || causeMask == 0 ) return kTRUE;
 
-    Int_t currentCh;
-    Int_t currentSt;
-    Int_t previousCh = -1;
-    Int_t nChHitInSt4 = 0;
-    Int_t nChHitInSt5 = 0;
-    UInt_t presentStationMask = 0;
-    const UInt_t requestedStationMask = 0x1F;
-    const Bool_t request2ChInSameSt45 = kTRUE;
+    StationCounter stations;
 
     /* CompactMapping* cm = GetCompactMapping(); */
 
@@ -133,44 +352,10 @@ Bool_t AliMuonCompactQuickAccEff::ValidateTrack(const AliMuonCompactTrack& track
             continue;
         }
 
-        currentCh = cl.DetElemId()/100 - 1; 
-        currentSt = currentCh/2;
-
-        // build present station mask
-        presentStationMask |= ( 1 << currentSt );
-
-        // count the number of chambers hit in station 4 that contain cluster(s)
-        if (currentSt == 3 && currentCh != previousCh) {
-            ++nChHitInSt4;
-            previousCh = currentCh;
-        }
-
-        // count the number of chambers hit in station 5 that contain cluster(s)
-        if (currentSt == 4 && currentCh != previousCh) {
-            ++nChHitInSt5;
-            previousCh = currentCh;
-        }
-
-    }
-
-    // at least one cluster per requested station
-    if ((requestedStationMask & presentStationMask) != requestedStationMask) 
-    {
-        return kFALSE;
-    }
-
-    if (request2ChInSameSt45) 
-    {
-        // 2 chambers hit in the same station (4 or 5)
-        return (nChHitInSt4 == 2 || nChHitInSt5 == 2);
-    }
-    else 
-    {
-        // or 2 chambers hit in station 4 & 5 together
-        return (nChHitInSt4+nChHitInSt5 >= 2);
+        stations.Add(cl.DetElemId()/100 - 1);
     }
 
-    return kTRUE;
+    return stations.IsOK();
 }
 TH1* AliMuonCompactQuickAccEff::ComputeMinv(const std::vector<AliMuonCompactEvent>& events,
         const std::vector<UInt_t>& manustatus,
@@ -320,42 +505,75 @@ void AliMuonCompactQuickAccEff::ComputeEvolution(const std::vector<AliMuonCompac
         g->SetMarkerSize(1.5);
     }
 
+    // the events are flattened once, then each (run,cause) combination
+    // is an independent task
+
+    ULong64_t maxevents = fMaxEvents;
+
+    if (!maxevents || maxevents > events.size())
+    {
+        maxevents = events.size();
+    }
+
+    FlatEvents flat;
+    FlattenEvents(events,maxevents,flat);
+
+    std::vector<EvolutionPoint> points(vrunlist.size()*causes.size());
+
+    std::atomic<size_t> nextTask(0);
+
+    auto worker = [&]()
+    {
+        size_t task;
+        while ( ( task = nextTask++ ) < points.size() )
+        {
+            Int_t runNumber = vrunlist[task/causes.size()];
+            std::map<int, std::vector<UInt_t> >::const_iterator it = manuStatusForRuns.find(runNumber);
+            if ( it == manuStatusForRuns.end() ) continue;
+            points[task].mFound = true;
+            ComputeEvolutionPoint(flat,it->second,causes[task%causes.size()],fRejectMonoCathodeClusters,points[task]);
+        }
+    };
+
+    size_t nthreads = fNofThreads > 0 ? fNofThreads : std::thread::hardware_concurrency();
+    nthreads = std::max<size_t>(1,std::min(nthreads,points.size()));
+
+    std::vector<std::thread> threads;
+    for ( size_t t = 1; t < nthreads; ++t )
+    {
+        threads.push_back(std::thread(worker));
+    }
+    worker();
+    for ( size_t t = 0; t < threads.size(); ++t )
+    {
+        threads[t].join();
+    }
+
     for ( std::vector<int>::size_type i = 0; i < vrunlist.size(); ++i )
     {
         Int_t runNumber = vrunlist[i];
 
         std::cout << Form("---- RUN %6d",runNumber) << std::endl;
 
-        std::map<int, std::vector<UInt_t> >::const_iterator it = manuStatusForRuns.find(runNumber);
-
-        const std::vector<UInt_t>& manustatus = it->second; 
-
         for ( std::vector<UInt_t>::size_type icause = 0; icause < causes.size(); ++icause )
         {
-            auto nbad =std::count_if(manustatus.begin(),
-                    manustatus.end(),
-                    [&](int n) { return (n & causes[icause]); }); 
-            std::cout << Form("RUN %6d %30s rejected manus = %6ld => ",
+            const EvolutionPoint& point = points[i*causes.size()+icause];
+
+            if (!point.mFound)
+            {
+                std::cout << Form("RUN %6d no manu status found",runNumber) << std::endl;
+                break;
+            }
+
+            std::cout << Form("RUN %6d %30s rejected manus = %6lld => ",
                 runNumber,
                 AliMuonCompactManuStatus::CauseAsString(causes[icause]).c_str(),
-                nbad
+                point.mNofBadManus
                 );
-            Int_t npairs(0);
-            TH1* h = ComputeMinv(events,manustatus,causes[icause],npairs);
-            if (h)
-            {
-                h->SetName(Form("hminv%6d%s",runNumber,AliMuonCompactManuStatus::CauseAsString(causes[icause]).c_str()));
-                hminv.push_back(h); 
-            }
-            Double_t drop = 0.0;
-            if ( h) 
-            {
-                drop = 100.0*(1.0-h->Integral(b1,b2)/referenceNofJpsi);
-            }
-            else
-            {
-                drop = 100.0*(1.0 - npairs*1.0/referenceNofJpsi);
-            }
+            std::cout << Form("nTracks %d nValidated %d npairs %d",point.mNofTracks,
+                    point.mNofValidatedTracks,point.mNofPairs) << std::endl;
+            Int_t npairs = point.mNofPairs;
+            Double_t drop = 100.0*(1.0 - npairs*1.0/referenceNofJpsi);
             Double_t relativeError = TMath::Sqrt(1.0/npairs + 1.0/referenceNofJpsi);
             Double_t dropError = drop*relativeError;
             std::cout << Form("RUN %6d %30s AccxEff drop %7.2f %% +- %5.2f %%",
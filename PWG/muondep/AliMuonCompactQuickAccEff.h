@@ -22,6 +22,13 @@ class TTree;
   This class is meant to get a quick computation of
   the evolution of the Acc x Eff for some runs.
 
+  In ComputeEvolution the events are flattened once (each cluster
+  mapped to its manu indices and chamber in a flat array, the track
+  pairs within the rapidity range listed), then each (run,cause)
+  combination only has to test the clusters against the bitset of the
+  manus that are bad for that run and cause. The (run,cause)
+  combinations are processed in parallel (see SetNofThreads).
+
 */
 
 
@@ -31,6 +38,9 @@ class AliMuonCompactQuickAccEff
 
         AliMuonCompactQuickAccEff(int maxevents=0, bool rejectMonoCathodeClusters=false);
 
+        /// number of threads used by ComputeEvolution (0 = number of cores)
+        void SetNofThreads(int n) { fNofThreads = n; }
+
         void ComputeEvolution(const std::vector<AliMuonCompactEvent>& events, 
                 std::vector<int>& vrunlist,
                 const std::map<int,std::vector<UInt_t> >& manuStatusForRuns,
@@ -64,6 +74,7 @@ class AliMuonCompactQuickAccEff
     private:
         ULong64_t fMaxEvents;
         bool fRejectMonoCathodeClusters;
+        int fNofThreads;
 };
 
 #endif
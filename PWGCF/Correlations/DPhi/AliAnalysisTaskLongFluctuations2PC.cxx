@@ -159,8 +159,8 @@ void AliAnalysisTaskLongFluctuations2PC::UserExec(Option_t *)
     Double_t pvzbins[17] = {-8.,-7.,-6.,-5.,-4.,-3.,-2.,-1.,0.,1.,2.,3.,4.,5.,6.,7.,8.};
     Float_t mPVz, mCent;
     Double_t eta1, eta2, phi1, phi2;
-    TAxis *centaxis = new TAxis(8, centbins);
-    TAxis *pvzaxis = new TAxis(16, pvzbins);
+    TAxis centaxis(8, centbins);
+    TAxis pvzaxis(16, pvzbins);
 
     fAOD = dynamic_cast<AliAODEvent*>(InputEvent());
     if(!fAOD) return;
@@ -180,8 +180,8 @@ void AliAnalysisTaskLongFluctuations2PC::UserExec(Option_t *)
     
     fAllCentQA->Fill(MultSelection->GetMultiplicityPercentile("V0M"),MultSelection->GetMultiplicityPercentile("CL0"),MultSelection->GetMultiplicityPercentile("CL1"));
     fPVzCentNevents->Fill(mPVz,mCent);
-    Int_t bCent(centaxis->FindBin(mCent)-1);
-    Int_t bPVz(pvzaxis->FindBin(mPVz)-1);
+    Int_t bCent(centaxis.FindBin(mCent)-1);
+    Int_t bPVz(pvzaxis.FindBin(mPVz)-1);
     Int_t nTracks(fAOD->GetNumberOfTracks());           // see how many tracks there are in the event
     
     Double_t nAcc = 0.0;
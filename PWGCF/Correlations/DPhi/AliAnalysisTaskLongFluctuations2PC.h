@@ -2,16 +2,18 @@
 // AliAnalysisTaskLongFluctuations2PC:
 // Description: Analysis task for 2PC for eta1, eta2
 // Author: Raquel Quishpe (raquel.quishpe@cern.ch)
+// The task is re-entrant and can run in AliAnalysisThreadedEventLoop
 ////////////////////////////////////////////////////////
 
 #ifndef AliAnalysisTaskLongFluctuations2PC_H
 #define AliAnalysisTaskLongFluctuations2PC_H
 
 #include "AliAnalysisTaskSE.h"
+#include "AliAnalysisReentrantTask.h"
 
 #define PI 3.1415927
 
-class AliAnalysisTaskLongFluctuations2PC : public AliAnalysisTaskSE
+class AliAnalysisTaskLongFluctuations2PC : public AliAnalysisTaskSE, public AliAnalysisReentrantTask
 {
     public:
                         AliAnalysisTaskLongFluctuations2PC();
@@ -21,6 +23,7 @@ class AliAnalysisTaskLongFluctuations2PC : public AliAnalysisTaskSE
         virtual void    UserCreateOutputObjects();
         virtual void    UserExec(Option_t* option);
         virtual void    Terminate(Option_t* option);
+        virtual void    SetThreadInput(AliVEvent *event, AliMCEvent *mcEvent) { fInputEvent = event; fMCEvent = mcEvent; }
         void            SetMCRead(Bool_t bs);
         void            SetCentrality(TString Cent);
         void            SetChi2DoF(Double_t Chi2DoF);
@@ -58,7 +61,7 @@ class AliAnalysisTaskLongFluctuations2PC : public AliAnalysisTaskSE
         AliAnalysisTaskLongFluctuations2PC(const AliAnalysisTaskLongFluctuations2PC&); // not implemented
         AliAnalysisTaskLongFluctuations2PC& operator=(const AliAnalysisTaskLongFluctuations2PC&); // not implemented
 
-        ClassDef(AliAnalysisTaskLongFluctuations2PC, 3);
+        ClassDef(AliAnalysisTaskLongFluctuations2PC, 4);
 };
 
 #endif
@@ -8,6 +8,8 @@
 #include <AliFemtoDreamHigherPairMath.h>
 #include "TMath.h"
 #include "TDatabasePDG.h"
+#include "TVector2.h"
+#include <cmath>
 static const float piHi = TMath::Pi();
 
 AliFemtoDreamHigherPairMath::AliFemtoDreamHigherPairMath(
@@ -83,6 +85,42 @@ bool AliFemtoDreamHigherPairMath::PassesPairSelection(
   return pass;
 }
 
+void AliFemtoDreamHigherPairMath::PassesPairSelection(
+    int iHC, PairArrays &arr1, unsigned int iPart1, PairArrays &arr2,
+    unsigned int begin, unsigned int end, const float *RelativeK, bool SEorME,
+    char *pass) {
+  //Same as above for particle iPart1 of arr1 against the particles [begin, end)
+  //of arr2. The histograms at the radii can only be filled pair by pair, in
+  //that case and for the particles without a complete phi* table we fall back
+  //to the single pair method.
+  bool CPR = fRejPairs.at(iHC) && fDoDeltaEtaDeltaPhiCut;
+  bool plots = fHists->GetEtaPhiPlots();
+  if (!CPR && !plots) {
+    for (unsigned int i = begin; i < end; ++i) {
+      pass[i] = true;
+    }
+    return;
+  }
+  unsigned int DoThisPair = fWhichPairs.at(iHC);
+  unsigned int nDaug1 = DoThisPair / 10;
+  unsigned int nDaug2 = DoThisPair % 10;
+  bool bulk = !plots && nDaug1 <= 9;
+  if (bulk) {
+    arr1.FillPhiStar(nDaug1);
+    arr2.FillPhiStar(nDaug2);
+    bulk = arr1.HasPhiStar(iPart1);
+  }
+  AliFemtoDreamBasePart &part1 = arr1.fParts->at(iPart1);
+  for (unsigned int i = begin; i < end; ++i) {
+    if (bulk && arr2.HasPhiStar(i)) {
+      pass[i] = DeltaEtaDeltaPhi(arr1, iPart1, arr2, i);
+    } else {
+      pass[i] = PassesPairSelection(iHC, part1, arr2.fParts->at(i),
+                                    RelativeK[i], SEorME, false);
+    }
+  }
+}
+
 bool AliFemtoDreamHigherPairMath::CommonAncestors(AliFemtoDreamBasePart& part1, AliFemtoDreamBasePart& part2) {
     bool IsCommon = false;
     if(part1.GetMotherID() == part2.GetMotherID()){
@@ -141,7 +179,6 @@ float AliFemtoDreamHigherPairMath::FillSameEvent(int iHC, int Mult, float cent,
   if (PDGPart1 == 0 || PDGPart2 == 0) {
     AliError("Invalid PDG Code");
   }
-  bool fillHists = fWhichPairs.at(iHC);
   TLorentzVector PartOne, PartTwo;
   TVector3 Part1Momentum = part1.GetMomentum();
   TVector3 Part2Momentum = part2.GetMomentum();
@@ -154,6 +191,20 @@ float AliFemtoDreamHigherPairMath::FillSameEvent(int iHC, int Mult, float cent,
                   TDatabasePDG::Instance()->GetParticle(PDGPart2)->Mass());
 
   float RelativeK = RelativePairMomentum(PartOne, PartTwo);
+  FillSameEvent(iHC, Mult, cent, part1, part2, RelativeK,
+                RelativePairkT(PartOne, PartTwo),
+                RelativePairmT(PartOne, PartTwo));
+  return RelativeK;
+}
+
+void AliFemtoDreamHigherPairMath::FillSameEvent(int iHC, int Mult, float cent,
+                                                AliFemtoDreamBasePart &part1,
+                                                AliFemtoDreamBasePart &part2,
+                                                float RelativeK, float kT,
+                                                float mT) {
+  //Same as above with the k*, kT and mT of the pair already computed, e.g.
+  //by RelativePairKinematics
+  bool fillHists = fWhichPairs.at(iHC);
   fHists->FillSameEventDist(iHC, RelativeK);
   if (fHists->GetDoMultBinning()) {
     fHists->FillSameEventMultDist(iHC, Mult + 1, RelativeK);
@@ -162,29 +213,27 @@ float AliFemtoDreamHigherPairMath::FillSameEvent(int iHC, int Mult, float cent,
     fHists->FillSameEventCentDist(iHC, cent, RelativeK);
   }
   if (fillHists && fHists->GetDokTBinning()) {
-    fHists->FillSameEventkTDist(iHC, RelativePairkT(PartOne, PartTwo),
-                                RelativeK, cent);
+    fHists->FillSameEventkTDist(iHC, kT, RelativeK, cent);
   }
   if (fillHists && fHists->GetDomTBinning()) {
-    fHists->FillSameEventmTDist(iHC, RelativePairmT(PartOne, PartTwo),
-                                RelativeK);
+    fHists->FillSameEventmTDist(iHC, mT, RelativeK);
   }
   if (fillHists && fHists->GetDokTandMultBinning()) {
-    fHists->FillSameEventkTandMultDist(iHC, RelativePairkT(PartOne, PartTwo),
-                                       RelativeK, Mult + 1);
+    fHists->FillSameEventkTandMultDist(iHC, kT, RelativeK, Mult + 1);
   }
   if (fillHists && fHists->GetDomTMultPlots()) {
-    fHists->FillSameEventmTMultDist(iHC, RelativePairmT(PartOne, PartTwo), Mult + 1, 
+    fHists->FillSameEventmTMultDist(iHC, mT, Mult + 1, 
 				   RelativeK); 
   }   
   if (fillHists && fHists->GetDoPtQA()) {
-    fHists->FillPtQADist(iHC, RelativeK, Part1Momentum.Pt(),
-                         Part2Momentum.Pt());
-    fHists->FillPtSEOneQADist(iHC, Part1Momentum.Pt(), Mult + 1);
-    fHists->FillPtSETwoQADist(iHC, Part2Momentum.Pt(), Mult + 1);
+    const float pt1 = part1.GetMomentum().Pt();
+    const float pt2 = part2.GetMomentum().Pt();
+    fHists->FillPtQADist(iHC, RelativeK, pt1, pt2);
+    fHists->FillPtSEOneQADist(iHC, pt1, Mult + 1);
+    fHists->FillPtSETwoQADist(iHC, pt2, Mult + 1);
     
-    fHists->FillKstarPtSEOneQADist(iHC, RelativeK, Part1Momentum.Pt());
-    fHists->FillKstarPtSETwoQADist(iHC, RelativeK, Part2Momentum.Pt());
+    fHists->FillKstarPtSEOneQADist(iHC, RelativeK, pt1);
+    fHists->FillKstarPtSETwoQADist(iHC, RelativeK, pt2);
   }
   if (fillHists && fHists->GetDoAncestorsPlots()) {
     bool isAlabama = CommonAncestors(part1,part2);
@@ -194,7 +243,7 @@ float AliFemtoDreamHigherPairMath::FillSameEvent(int iHC, int Mult, float cent,
 	fHists->FillSameEventMultDistCommon(iHC, Mult + 1, RelativeK);
       }
       if (fHists->GetDomTBinning()) {
-	fHists->FillSameEventmTDistCommon(iHC, RelativePairmT(PartOne, PartTwo), RelativeK);
+	fHists->FillSameEventmTDistCommon(iHC, mT, RelativeK);
       }
     } else {
       fHists->FillSameEventDistNonCommon(iHC, RelativeK);
@@ -202,11 +251,10 @@ float AliFemtoDreamHigherPairMath::FillSameEvent(int iHC, int Mult, float cent,
 	fHists->FillSameEventMultDistNonCommon(iHC, Mult + 1, RelativeK);
       }
       if (fHists->GetDomTBinning()) {
-	fHists->FillSameEventmTDistNonCommon(iHC, RelativePairmT(PartOne, PartTwo), RelativeK);
+	fHists->FillSameEventmTDistNonCommon(iHC, mT, RelativeK);
       }
     }
   }
-  return RelativeK;
 }
 
 void AliFemtoDreamHigherPairMath::MassQA(int iHC, float RelK,
@@ -243,7 +291,6 @@ float AliFemtoDreamHigherPairMath::FillMixedEvent(
   if (PDGPart1 == 0 || PDGPart2 == 0) {
     AliError("Invalid PDG Code");
   }
-  bool fillHists = fWhichPairs.at(iHC);
   TLorentzVector PartOne, PartTwo;
   TVector3 Part1Momentum = part1.GetMomentum();
   TVector3 Part2Momentum = part2.GetMomentum();
@@ -266,6 +313,20 @@ float AliFemtoDreamHigherPairMath::FillMixedEvent(
     PartTwo.SetPhi(PartTwo.Phi() + fRandom.Uniform(2 * fPi));
   }
   float RelativeK = RelativePairMomentum(PartOne, PartTwo);
+  FillMixedEvent(iHC, Mult, cent, part1, part2, RelativeK,
+                 RelativePairkT(PartOne, PartTwo),
+                 RelativePairmT(PartOne, PartTwo));
+  return RelativeK;
+}
+
+void AliFemtoDreamHigherPairMath::FillMixedEvent(int iHC, int Mult, float cent,
+                                                 AliFemtoDreamBasePart &part1,
+                                                 AliFemtoDreamBasePart &part2,
+                                                 float RelativeK, float kT,
+                                                 float mT) {
+  //Same as above with the k*, kT and mT of the pair already computed, with
+  //the randomisation of the pair (if any) applied
+  bool fillHists = fWhichPairs.at(iHC);
   fHists->FillMixedEventDist(iHC, RelativeK);
   if (fHists->GetDoMultBinning()) {
     fHists->FillMixedEventMultDist(iHC, Mult + 1, RelativeK);
@@ -274,29 +335,27 @@ float AliFemtoDreamHigherPairMath::FillMixedEvent(
     fHists->FillMixedEventCentDist(iHC, cent, RelativeK);
   }
   if (fillHists && fHists->GetDokTBinning()) {
-    fHists->FillMixedEventkTDist(iHC, RelativePairkT(PartOne, PartTwo),
-                                 RelativeK, cent);
+    fHists->FillMixedEventkTDist(iHC, kT, RelativeK, cent);
   }
   if (fillHists && fHists->GetDomTBinning()) {
-    fHists->FillMixedEventmTDist(iHC, RelativePairmT(PartOne, PartTwo),
-                                 RelativeK);
+    fHists->FillMixedEventmTDist(iHC, mT, RelativeK);
   }
   if (fillHists && fHists->GetDokTandMultBinning()) {
-    fHists->FillMixedEventkTandMultDist(iHC, RelativePairkT(PartOne, PartTwo),
-                                        RelativeK, Mult + 1);
+    fHists->FillMixedEventkTandMultDist(iHC, kT, RelativeK, Mult + 1);
   }
   if (fillHists && fHists->GetDomTMultPlots()) {
-    fHists->FillMixedEventmTMultDist(iHC, RelativePairmT(PartOne, PartTwo), Mult + 1, 
+    fHists->FillMixedEventmTMultDist(iHC, mT, Mult + 1, 
 				   RelativeK); 
   }   
   if (fillHists && fHists->GetDoPtQA()) {
-    fHists->FillPtMEOneQADist(iHC, Part1Momentum.Pt(), Mult + 1);
-    fHists->FillPtMETwoQADist(iHC, Part2Momentum.Pt(), Mult + 1);
+    const float pt1 = part1.GetMomentum().Pt();
+    const float pt2 = part2.GetMomentum().Pt();
+    fHists->FillPtMEOneQADist(iHC, pt1, Mult + 1);
+    fHists->FillPtMETwoQADist(iHC, pt2, Mult + 1);
     
-    fHists->FillKstarPtMEOneQADist(iHC, RelativeK, Part1Momentum.Pt());
-    fHists->FillKstarPtMETwoQADist(iHC, RelativeK, Part2Momentum.Pt());
+    fHists->FillKstarPtMEOneQADist(iHC, RelativeK, pt1);
+    fHists->FillKstarPtMETwoQADist(iHC, RelativeK, pt2);
   }
-  return RelativeK;
 }
 
 void AliFemtoDreamHigherPairMath::SEDetaDPhiPlots(int iHC,
@@ -511,6 +570,150 @@ float AliFemtoDreamHigherPairMath::RelativePairmT(TLorentzVector &PartOne,
   return results;
 }
 
+void AliFemtoDreamHigherPairMath::RelativePairKinematics(
+    const PairArrays &arr1, unsigned int iPart1, const PairArrays &arr2,
+    unsigned int begin, unsigned int end, float *relK, float *kT, float *mT) {
+  //Closed form of the boost in RelativePairMomentum: with q = p1 - p2 and
+  //P = p1 + p2, k*^2 = ((q.P)^2 / P^2 - q^2) / 4, where q.P = m1^2 - m2^2.
+  //The loops are branch free over contiguous arrays, so that the compiler
+  //can vectorise them.
+  const double px1 = arr1.fPx[iPart1];
+  const double py1 = arr1.fPy[iPart1];
+  const double pz1 = arr1.fPz[iPart1];
+  const double m1 = arr1.fMass[iPart1];
+  const double e1 = std::sqrt(px1 * px1 + py1 * py1 + pz1 * pz1 + m1 * m1);
+  const float *px2 = arr2.fPx.data();
+  const float *py2 = arr2.fPy.data();
+  const float *pz2 = arr2.fPz.data();
+  const float *m2 = arr2.fMass.data();
+  for (unsigned int i = begin; i < end; ++i) {
+    const double e2 = std::sqrt(
+        (double) px2[i] * px2[i] + (double) py2[i] * py2[i]
+            + (double) pz2[i] * pz2[i] + (double) m2[i] * m2[i]);
+    const double qx = px1 - px2[i];
+    const double qy = py1 - py2[i];
+    const double qz = pz1 - pz2[i];
+    const double q0 = e1 - e2;
+    const double sx = px1 + px2[i];
+    const double sy = py1 + py2[i];
+    const double sz = pz1 + pz2[i];
+    const double s0 = e1 + e2;
+    const double qP = m1 * m1 - (double) m2[i] * m2[i];
+    const double s = s0 * s0 - sx * sx - sy * sy - sz * sz;
+    const double k2 = 0.25
+        * (qP * qP / s - q0 * q0 + qx * qx + qy * qy + qz * qz);
+    relK[i] = std::sqrt(k2 > 0. ? k2 : 0.);
+  }
+  if (kT || mT) {
+    for (unsigned int i = begin; i < end; ++i) {
+      const double sx = px1 + px2[i];
+      const double sy = py1 + py2[i];
+      const double pairKT = 0.5 * std::sqrt(sx * sx + sy * sy);
+      const double averageMass = 0.5 * (m1 + m2[i]);
+      if (kT) {
+        kT[i] = pairKT;
+      }
+      if (mT) {
+        mT[i] = std::sqrt(pairKT * pairKT + averageMass * averageMass);
+      }
+    }
+  }
+}
+
+bool AliFemtoDreamHigherPairMath::DeltaEtaDeltaPhi(const PairArrays &arr1,
+                                                   unsigned int iPart1,
+                                                   const PairArrays &arr2,
+                                                   unsigned int iPart2) {
+  //Same cut as below on the phi* tables, without the histograms
+  unsigned int nDaug1 = arr1.fNDaug;
+  unsigned int nDaug2 = arr2.fNDaug;
+  const float nRad = (float) PairArrays::kNRadii;
+  for (unsigned int iDaug1 = 0; iDaug1 < nDaug1; ++iDaug1) {
+    const float *phiAtRad1 = arr1.GetPhiStar(iPart1, iDaug1);
+    float etaPar1 = arr1.GetEta(iPart1, iDaug1);
+    for (unsigned int iDaug2 = 0; iDaug2 < nDaug2; ++iDaug2) {
+      const float *phiAtRad2 = arr2.GetPhiStar(iPart2, iDaug2);
+      float deta = etaPar1 - arr2.GetEta(iPart2, iDaug2);
+      float dphiAvg = 0;
+      for (unsigned int iRad = 0; iRad < PairArrays::kNRadii; ++iRad) {
+        float dphi = phiAtRad1[iRad] - phiAtRad2[iRad];
+        if (dphi > piHi) {
+          dphi += -piHi * 2;
+        } else if (dphi < -piHi) {
+          dphi += piHi * 2;
+        }
+        dphiAvg += TVector2::Phi_mpi_pi(dphi);
+      }
+      if ((dphiAvg / nRad) * (dphiAvg / nRad) / fDeltaPhiSqMax
+          + deta * deta / fDeltaEtaSqMax < 1.) {
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+AliFemtoDreamHigherPairMath::PairArrays::PairArrays()
+    : fParts(nullptr),
+      fN(0),
+      fPx(),
+      fPy(),
+      fPz(),
+      fMass(),
+      fNDaug(0),
+      fPhiStarFilled(false),
+      fHasPhiStar(),
+      fEta(),
+      fPhiStar() {
+}
+
+void AliFemtoDreamHigherPairMath::PairArrays::Fill(
+    std::vector<AliFemtoDreamBasePart> &parts, float mass) {
+  fParts = &parts;
+  fN = parts.size();
+  fPx.resize(fN);
+  fPy.resize(fN);
+  fPz.resize(fN);
+  fMass.assign(fN, mass);
+  for (unsigned int i = 0; i < fN; ++i) {
+    TVector3 mom = parts[i].GetMomentum();
+    fPx[i] = mom.X();
+    fPy[i] = mom.Y();
+    fPz[i] = mom.Z();
+  }
+  fPhiStarFilled = false;
+}
+
+void AliFemtoDreamHigherPairMath::PairArrays::FillPhiStar(unsigned int nDaug) {
+  //The eta of the daughters is taken as in DeltaEtaDeltaPhi: the eta of the
+  //particle itself for a single track, the one of the daughters otherwise
+  if (fPhiStarFilled && fNDaug == nDaug) {
+    return;
+  }
+  fPhiStarFilled = true;
+  fNDaug = nDaug;
+  fHasPhiStar.assign(fN, false);
+  fEta.resize(fN * nDaug);
+  fPhiStar.resize(fN * nDaug * kNRadii);
+  for (unsigned int i = 0; i < fN; ++i) {
+    std::vector<std::vector<float>> phiAtRad = (*fParts)[i].GetPhiAtRaidius();
+    std::vector<float> eta = (*fParts)[i].GetEta();
+    bool complete = nDaug <= phiAtRad.size()
+        && (nDaug == 1 ? eta.size() > 0 : eta.size() > nDaug);
+    for (unsigned int iDaug = 0; complete && iDaug < nDaug; ++iDaug) {
+      if (phiAtRad[iDaug].size() != kNRadii) {
+        complete = false;
+        break;
+      }
+      fEta[i * nDaug + iDaug] = (nDaug == 1) ? eta[0] : eta[iDaug + 1];
+      for (unsigned int iRad = 0; iRad < kNRadii; ++iRad) {
+        fPhiStar[(i * nDaug + iDaug) * kNRadii + iRad] = phiAtRad[iDaug][iRad];
+      }
+    }
+    fHasPhiStar[i] = complete;
+  }
+}
+
 bool AliFemtoDreamHigherPairMath::DeltaEtaDeltaPhi(int Hist,
                                                    AliFemtoDreamBasePart &part1,
                                                    AliFemtoDreamBasePart &part2,
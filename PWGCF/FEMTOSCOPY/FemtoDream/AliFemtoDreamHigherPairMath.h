@@ -16,6 +16,40 @@
 #include <vector>
 class AliFemtoDreamHigherPairMath {
  public:
+  // Particles of one species (of one event) stored as structure of arrays
+  // for the bulk pair methods. The kinematics are filled once per event and
+  // species, the phi* table is only built on demand for a given number of
+  // daughters (see fWhichPairs) and invalidated by the next Fill.
+  class PairArrays {
+   public:
+    PairArrays();
+    void Fill(std::vector<AliFemtoDreamBasePart> &parts, float mass);
+    void FillPhiStar(unsigned int nDaug);
+    unsigned int GetN() const {
+      return fN;
+    }
+    bool HasPhiStar(unsigned int i) const {
+      return fHasPhiStar[i];
+    }
+    const float *GetPhiStar(unsigned int i, unsigned int iDaug) const {
+      return &fPhiStar[(i * fNDaug + iDaug) * kNRadii];
+    }
+    float GetEta(unsigned int i, unsigned int iDaug) const {
+      return fEta[i * fNDaug + iDaug];
+    }
+    static const unsigned int kNRadii = 9;
+    std::vector<AliFemtoDreamBasePart> *fParts;  // not owned
+    unsigned int fN;
+    std::vector<float> fPx;
+    std::vector<float> fPy;
+    std::vector<float> fPz;
+    std::vector<float> fMass;
+    unsigned int fNDaug;          // daughters in the phi* table
+    bool fPhiStarFilled;          // whether the phi* table was built
+    std::vector<char> fHasPhiStar;  // false if the particle has no complete table
+    std::vector<float> fEta;      // [i * fNDaug + iDaug]
+    std::vector<float> fPhiStar;  // [(i * fNDaug + iDaug) * kNRadii + iRad]
+  };
   AliFemtoDreamHigherPairMath(AliFemtoDreamCollConfig *conf, bool minBooking =
                                   true);
   virtual ~AliFemtoDreamHigherPairMath();
@@ -34,10 +68,18 @@ class AliFemtoDreamHigherPairMath {
   bool PassesPairSelection(int iHC, AliFemtoDreamBasePart& part1,
                            AliFemtoDreamBasePart& part2, float RelativeK,
                            bool SEorME, bool Recalculate);
+  void PassesPairSelection(int iHC, PairArrays &arr1, unsigned int iPart1,
+                           PairArrays &arr2, unsigned int begin,
+                           unsigned int end, const float *RelativeK,
+                           bool SEorME, char *pass);
   bool CommonAncestors(AliFemtoDreamBasePart& part1, AliFemtoDreamBasePart& part2);
   void RecalculatePhiStar(AliFemtoDreamBasePart &part);
   float FillSameEvent(int iHC, int Mult, float cent, AliFemtoDreamBasePart& part1,
                       int PDGPart1, AliFemtoDreamBasePart& part2, int PDGPart2);
+  // Same with the k*, kT and mT of the pair already computed
+  void FillSameEvent(int iHC, int Mult, float cent,
+                     AliFemtoDreamBasePart& part1, AliFemtoDreamBasePart& part2,
+                     float RelativeK, float kT, float mT);
   void MassQA(int iHC, float RelK, AliFemtoDreamBasePart &part1, int PDGPart1,
               AliFemtoDreamBasePart &part2, int PDGPart2);
   void MEMassQA(int iHC, float RelK, AliFemtoDreamBasePart &part1, int PDGPart1,
@@ -55,6 +97,11 @@ class AliFemtoDreamHigherPairMath {
   float FillMixedEvent(int iHC, int Mult, float cent, AliFemtoDreamBasePart& part1,
                        int PDGPart1, AliFemtoDreamBasePart& part2, int PDGPart2,
                        AliFemtoDreamCollConfig::UncorrelatedMode mode);
+  // Same with the k*, kT and mT of the pair already computed, with the
+  // randomisation of the pair (if any) applied
+  void FillMixedEvent(int iHC, int Mult, float cent,
+                      AliFemtoDreamBasePart& part1, AliFemtoDreamBasePart& part2,
+                      float RelativeK, float kT, float mT);
   void MEMomentumResolution(int iHC, AliFemtoDreamBasePart* part1, int PDGPart1,
                             AliFemtoDreamBasePart* part2, int PDGPart2,
                             float RelativeK);
@@ -91,10 +138,20 @@ class AliFemtoDreamHigherPairMath {
   static float RelativePairmT(AliFemtoDreamBasePart *PartOne, const int pdg1,
                               AliFemtoDreamBasePart *PartTwo, const int pdg2);
   static float RelativePairmT(TLorentzVector &PartOne, TLorentzVector &PartTwo);
+  // Bulk k*, kT and mT of one particle against the partners [begin, end),
+  // the results are written to out[begin, end), kT and mT may be nullptr
+  static void RelativePairKinematics(const PairArrays &arr1,
+                                     unsigned int iPart1,
+                                     const PairArrays &arr2,
+                                     unsigned int begin, unsigned int end,
+                                     float *relK, float *kT = nullptr,
+                                     float *mT = nullptr);
 
  private:
   bool DeltaEtaDeltaPhi(int Hist, AliFemtoDreamBasePart &part1,
                         AliFemtoDreamBasePart &part2, bool SEorME, float relk);
+  bool DeltaEtaDeltaPhi(const PairArrays &arr1, unsigned int iPart1,
+                        const PairArrays &arr2, unsigned int iPart2);
   AliFemtoDreamCorrHists *fHists;
   std::vector<unsigned int> fWhichPairs;
   float fBField;
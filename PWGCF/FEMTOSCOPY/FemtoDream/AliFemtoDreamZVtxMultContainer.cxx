@@ -15,7 +15,8 @@ ClassImp(AliFemtoDreamPartContainer)
 AliFemtoDreamZVtxMultContainer::AliFemtoDreamZVtxMultContainer()
     : fPartContainer(0),
       fPDGParticleSpecies(0),
-      fWhichPairs(){
+      fWhichPairs(),
+      fMasses(){
 }
 
 AliFemtoDreamZVtxMultContainer::AliFemtoDreamZVtxMultContainer(
@@ -23,7 +24,8 @@ AliFemtoDreamZVtxMultContainer::AliFemtoDreamZVtxMultContainer(
     : fPartContainer(conf->GetNParticles(),
                      AliFemtoDreamPartContainer(conf->GetMixingDepth())),
       fPDGParticleSpecies(conf->GetPDGCodes()),
-      fWhichPairs(conf->GetWhichPairs()){
+      fWhichPairs(conf->GetWhichPairs()),
+      fMasses(){
   TDatabasePDG::Instance()->AddParticle("deuteron", "deuteron", 1.8756134,
                                         kTRUE, 0.0, 1, "Nucleus", 1000010020);
   TDatabasePDG::Instance()->AddAntiParticle("anti-deuteron", -1000010020);
@@ -56,10 +58,33 @@ void AliFemtoDreamZVtxMultContainer::SetEvent(
   }
   //  }
 }
+void AliFemtoDreamZVtxMultContainer::FillMasses() {
+  //Transient, filled on first use
+  if (fMasses.size() == fPDGParticleSpecies.size()) {
+    return;
+  }
+  fMasses.clear();
+  for (auto pdg : fPDGParticleSpecies) {
+    fMasses.push_back(TDatabasePDG::Instance()->GetParticle(pdg)->Mass());
+  }
+}
+
 void AliFemtoDreamZVtxMultContainer::PairParticlesSE(
     std::vector<std::vector<AliFemtoDreamBasePart>> &Particles,
     AliFemtoDreamHigherPairMath *HigherMath, int iMult, float cent) {
   int HistCounter = 0;
+  //The kinematics of each species are stored once per event as arrays, the
+  //relative momentum and the pair selection of one particle are then obtained
+  //in bulk for all its partners
+  FillMasses();
+  std::vector<AliFemtoDreamHigherPairMath::PairArrays> arrays(Particles.size());
+  for (unsigned int iSpec = 0; iSpec < Particles.size(); ++iSpec) {
+    arrays[iSpec].Fill(Particles[iSpec], fMasses[iSpec]);
+  }
+  std::vector<float> RelativeK;
+  std::vector<float> kT;
+  std::vector<float> mT;
+  std::vector<char> pass;
   //First loop over all the different Species
   auto itPDGPar1 = fPDGParticleSpecies.begin();
   for (auto itSpec1 = Particles.begin(); itSpec1 != Particles.end();
@@ -69,45 +94,42 @@ void AliFemtoDreamZVtxMultContainer::PairParticlesSE(
     for (auto itSpec2 = itSpec1; itSpec2 != Particles.end(); ++itSpec2) {
       HigherMath->FillPairCounterSE(HistCounter, itSpec1->size(),
                                     itSpec2->size());
+      AliFemtoDreamHigherPairMath::PairArrays &arr1 = arrays[itSpec1
+          - Particles.begin()];
+      AliFemtoDreamHigherPairMath::PairArrays &arr2 = arrays[itSpec2
+          - Particles.begin()];
+      RelativeK.resize(itSpec2->size());
+      kT.resize(itSpec2->size());
+      mT.resize(itSpec2->size());
+      pass.resize(itSpec2->size());
       //Now loop over the actual Particles and correlate them
       for (auto itPart1 = itSpec1->begin(); itPart1 != itSpec1->end();
           ++itPart1) {
-        AliFemtoDreamBasePart part1 = *itPart1;
-        std::vector<AliFemtoDreamBasePart>::iterator itPart2;
-        if (itSpec1 == itSpec2) {
-          itPart2 = itPart1 + 1;
-        } else {
-          itPart2 = itSpec2->begin();
-        }
-        while (itPart2 != itSpec2->end()) {
-          AliFemtoDreamBasePart part2 = *itPart2;
-          TLorentzVector PartOne, PartTwo;
-          PartOne.SetXYZM(
-              itPart1->GetMomentum().X(), itPart1->GetMomentum().Y(),
-              itPart1->GetMomentum().Z(),
-              TDatabasePDG::Instance()->GetParticle(*itPDGPar1)->Mass());
-          PartTwo.SetXYZM(
-              itPart2->GetMomentum().X(), itPart2->GetMomentum().Y(),
-              itPart2->GetMomentum().Z(),
-              TDatabasePDG::Instance()->GetParticle(*itPDGPar2)->Mass());
-          float RelativeK = HigherMath->RelativePairMomentum(PartOne, PartTwo);
-          if (!HigherMath->PassesPairSelection(HistCounter, *itPart1, *itPart2,
-                                               RelativeK, true, false)) {
-            ++itPart2;
+        unsigned int iPart1 = itPart1 - itSpec1->begin();
+        unsigned int begin = (itSpec1 == itSpec2) ? iPart1 + 1 : 0;
+        unsigned int end = itSpec2->size();
+        AliFemtoDreamHigherPairMath::RelativePairKinematics(arr1, iPart1, arr2,
+                                                            begin, end,
+                                                            RelativeK.data(),
+                                                            kT.data(),
+                                                            mT.data());
+        HigherMath->PassesPairSelection(HistCounter, arr1, iPart1, arr2, begin,
+                                        end, RelativeK.data(), true,
+                                        pass.data());
+        for (unsigned int iPart2 = begin; iPart2 < end; ++iPart2) {
+          if (!pass[iPart2]) {
             continue;
           }
-          RelativeK = HigherMath->FillSameEvent(HistCounter, iMult, cent,
-                                                part1,
-                                                *itPDGPar1,
-                                                part2,
-                                                *itPDGPar2);
-          HigherMath->MassQA(HistCounter, RelativeK, *itPart1, *itPDGPar1,
-                                                     *itPart2, *itPDGPar2);
+          auto itPart2 = itSpec2->begin() + iPart2;
+          float RelK = RelativeK[iPart2];
+          HigherMath->FillSameEvent(HistCounter, iMult, cent, *itPart1, *itPart2,
+                                    RelK, kT[iPart2], mT[iPart2]);
+          HigherMath->MassQA(HistCounter, RelK, *itPart1, *itPDGPar1,
+                                                *itPart2, *itPDGPar2);
           HigherMath->SEDetaDPhiPlots(HistCounter, *itPart1, *itPDGPar1,
-                                      *itPart2, *itPDGPar2, RelativeK, false);
+                                      *itPart2, *itPDGPar2, RelK, false);
           HigherMath->SEMomentumResolution(HistCounter, &(*itPart1), *itPDGPar1,
-                                           &(*itPart2), *itPDGPar2, RelativeK);
-          ++itPart2;
+                                           &(*itPart2), *itPDGPar2, RelK);
         }
       }
       ++HistCounter;
@@ -121,6 +143,16 @@ void AliFemtoDreamZVtxMultContainer::PairParticlesME(
     std::vector<std::vector<AliFemtoDreamBasePart>> &Particles,
     AliFemtoDreamHigherPairMath *HigherMath, int iMult, float cent) {
   int HistCounter = 0;
+  FillMasses();
+  std::vector<AliFemtoDreamHigherPairMath::PairArrays> arrays(Particles.size());
+  for (unsigned int iSpec = 0; iSpec < Particles.size(); ++iSpec) {
+    arrays[iSpec].Fill(Particles[iSpec], fMasses[iSpec]);
+  }
+  AliFemtoDreamHigherPairMath::PairArrays arr2;
+  std::vector<float> RelativeK;
+  std::vector<float> kT;
+  std::vector<float> mT;
+  std::vector<char> pass;
   auto itPDGPar1 = fPDGParticleSpecies.begin();
   //First loop over all the different Species
   for (auto itSpec1 = Particles.begin(); itSpec1 != Particles.end();
@@ -128,6 +160,7 @@ void AliFemtoDreamZVtxMultContainer::PairParticlesME(
     //We dont want to correlate the particles twice. Mixed Event Dist. of
     //Particle1 + Particle2 == Particle2 + Particle 1
     int SkipPart = itSpec1 - Particles.begin();
+    AliFemtoDreamHigherPairMath::PairArrays &arr1 = arrays[SkipPart];
     auto itPDGPar2 = fPDGParticleSpecies.begin() + SkipPart;
     for (auto itSpec2 = fPartContainer.begin() + SkipPart;
         itSpec2 != fPartContainer.end(); ++itSpec2) {
@@ -136,41 +169,46 @@ void AliFemtoDreamZVtxMultContainer::PairParticlesME(
                                              (int) itSpec2->GetMixingDepth());
       }
       for (int iDepth = 0; iDepth < (int) itSpec2->GetMixingDepth(); ++iDepth) {
-        std::vector<AliFemtoDreamBasePart> ParticlesOfEvent = itSpec2->GetEvent(
+        std::vector<AliFemtoDreamBasePart> &ParticlesOfEvent = itSpec2->GetEvent(
             iDepth);
         HigherMath->FillPairCounterME(HistCounter, itSpec1->size(),
                                       ParticlesOfEvent.size());
+        if (itSpec1->size() == 0) {
+          continue;
+        }
+        arr2.Fill(ParticlesOfEvent, fMasses[itSpec2 - fPartContainer.begin()]);
+        unsigned int end = ParticlesOfEvent.size();
+        RelativeK.resize(end);
+        kT.resize(end);
+        mT.resize(end);
+        pass.resize(end);
         for (auto itPart1 = itSpec1->begin(); itPart1 != itSpec1->end();
             ++itPart1) {
-          for (auto itPart2 = ParticlesOfEvent.begin();
-              itPart2 != ParticlesOfEvent.end(); ++itPart2) {
-
-            TLorentzVector PartOne, PartTwo;
-            PartOne.SetXYZM(
-                itPart1->GetMomentum().X(), itPart1->GetMomentum().Y(),
-                itPart1->GetMomentum().Z(),
-                TDatabasePDG::Instance()->GetParticle(*itPDGPar1)->Mass());
-            PartTwo.SetXYZM(
-                itPart2->GetMomentum().X(), itPart2->GetMomentum().Y(),
-                itPart2->GetMomentum().Z(),
-                TDatabasePDG::Instance()->GetParticle(*itPDGPar2)->Mass());
-            float RelativeK = HigherMath->RelativePairMomentum(PartOne, PartTwo);
-            if (!HigherMath->PassesPairSelection(HistCounter, *itPart1, *itPart2,
-                                                 RelativeK, false, false)) {
+          unsigned int iPart1 = itPart1 - itSpec1->begin();
+          AliFemtoDreamHigherPairMath::RelativePairKinematics(arr1, iPart1,
+                                                              arr2, 0, end,
+                                                              RelativeK.data(),
+                                                              kT.data(),
+                                                              mT.data());
+          HigherMath->PassesPairSelection(HistCounter, arr1, iPart1, arr2, 0,
+                                          end, RelativeK.data(), false,
+                                          pass.data());
+          for (unsigned int iPart2 = 0; iPart2 < end; ++iPart2) {
+            if (!pass[iPart2]) {
               continue;
             }
-            RelativeK = HigherMath->FillMixedEvent(
-                HistCounter, iMult, cent, *itPart1, *itPDGPar1,
-                *itPart2, *itPDGPar2,
-                AliFemtoDreamCollConfig::kNone);
+            auto itPart2 = ParticlesOfEvent.begin() + iPart2;
+            float RelK = RelativeK[iPart2];
+            HigherMath->FillMixedEvent(HistCounter, iMult, cent, *itPart1,
+                                       *itPart2, RelK, kT[iPart2], mT[iPart2]);
 
-            HigherMath->MEMassQA(HistCounter, RelativeK, *itPart1, *itPDGPar1,
-                                                         *itPart2, *itPDGPar2);
+            HigherMath->MEMassQA(HistCounter, RelK, *itPart1, *itPDGPar1,
+                                                    *itPart2, *itPDGPar2);
             HigherMath->MEDetaDPhiPlots(HistCounter, *itPart1, *itPDGPar1,
-                                        *itPart2, *itPDGPar2, RelativeK, false);
+                                        *itPart2, *itPDGPar2, RelK, false);
             HigherMath->MEMomentumResolution(HistCounter, &(*itPart1),
                                              *itPDGPar1, &(*itPart2),
-                                             *itPDGPar2, RelativeK);
+                                             *itPDGPar2, RelK);
           }
         }
       }
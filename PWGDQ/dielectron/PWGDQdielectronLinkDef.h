@@ -37,6 +37,7 @@
 #pragma link C++ class AliDielectronSpectrum+;
 #pragma link C++ class AliDielectronDebugTree+;
 #pragma link C++ class AliDielectronTrackRotator+;
+#pragma link C++ class AliDielectronTrackCache+;
 #pragma link C++ class AliDielectronPID+;
 #pragma link C++ class AliDielectronCutGroup+;
 #pragma link C++ class AliDielectronCutQA+;
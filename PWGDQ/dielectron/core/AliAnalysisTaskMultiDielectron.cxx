@@ -38,6 +38,7 @@
 #include "AliDielectronCF.h"
 #include "AliDielectronMC.h"
 #include "AliDielectronMixingHandler.h"
+#include "AliDielectronTrackCache.h"
 #include "AliAnalysisTaskMultiDielectron.h"
 
 ClassImp(AliAnalysisTaskMultiDielectron)
@@ -66,6 +67,9 @@ AliAnalysisTaskMultiDielectron::AliAnalysisTaskMultiDielectron() :
   fEvtVsTrkHistExists(kFALSE),
   fTRDTriggerClass(AliDielectronEventCuts::kSEorQU),
   fEventFilter(0x0),
+  fShareTrackCache(kTRUE),
+  fPrintTrackCacheStats(kFALSE),
+  fTrackCache(0x0),
   fEventStat(0x0),
   fEventStatTRDTrigger(0x0)
 {
@@ -98,6 +102,9 @@ AliAnalysisTaskMultiDielectron::AliAnalysisTaskMultiDielectron(const char *name)
   fEvtVsTrkHistExists(kFALSE),
   fTRDTriggerClass(AliDielectronEventCuts::kSEorQU),
   fEventFilter(0x0),
+  fShareTrackCache(kTRUE),
+  fPrintTrackCacheStats(kFALSE),
+  fTrackCache(0x0),
   fEventStat(0x0),
   fEventStatTRDTrigger(0x0)
 {
@@ -136,6 +143,7 @@ AliAnalysisTaskMultiDielectron::~AliAnalysisTaskMultiDielectron()
   if(fEventStat)       { delete fEventStat;       fEventStat=0; }
   if(fEventStatTRDTrigger){ delete fEventStatTRDTrigger;fEventStatTRDTrigger=0; }
   if(fTriggerAnalysis) { delete fTriggerAnalysis; fTriggerAnalysis=0; }
+  if(fTrackCache)      { delete fTrackCache;      fTrackCache=0; }
 }
 //_________________________________________________________________________________
 void AliAnalysisTaskMultiDielectron::UserCreateOutputObjects()
@@ -156,9 +164,13 @@ void AliAnalysisTaskMultiDielectron::UserCreateOutputObjects()
 //   Bool_t isESD=man->GetInputEventHandler()->IsA()==AliESDInputHandler::Class();
 //   Bool_t isAOD=man->GetInputEventHandler()->IsA()==AliAODInputHandler::Class();
 
+  // one track cache for all instances processing events
+  if (fShareTrackCache && fListDielectron.GetEntries()>1 && !fTrackCache) fTrackCache=new AliDielectronTrackCache;
+
   TIter nextDie(&fListDielectron);
   AliDielectron *die=0;
   while ( (die=static_cast<AliDielectron*>(nextDie())) ){
+    if (fTrackCache && die->DoEventProcess()) die->SetTrackCache(fTrackCache);
     die->Init();
     if (die->GetHistogramList())    fListHistos.Add(const_cast<THashList*>(die->GetHistogramList()));
     if (die->GetHistogramArray())   fListHistos.Add(const_cast<TObjArray*>(die->GetHistogramArray()));
@@ -367,6 +379,8 @@ void AliAnalysisTaskMultiDielectron::UserExec(Option_t *)
   AliDielectronPair::SetBeamEnergy(InputEvent(), fBeamEnergy);
   AliDielectronPair::SetRandomizeDaughters(fRandomizeDaughters);
 
+  if (fTrackCache) fTrackCache->NewEvent();
+
   //Process event in all AliDielectron instances
   //   TIter nextDie(&fListDielectron);
   //   AliDielectron *die=0;
@@ -455,6 +469,8 @@ void AliAnalysisTaskMultiDielectron::FinishTaskOutput()
 
   }
 
+  if (fTrackCache && fPrintTrackCacheStats) fTrackCache->Print();
+
   PostData(1, &fListHistos);
   PostData(2, &fListCF);
 }
@@ -26,6 +26,7 @@ class AliDielectron;
 class TH1D;
 class AliAnalysisCuts;
 class AliTriggerAnalysis;
+class AliDielectronTrackCache;
 
 class AliAnalysisTaskMultiDielectron : public AliAnalysisTaskSE {
 
@@ -71,6 +72,12 @@ public:
 
   void SetEvtVsTrkHistoExists( Bool_t exists = kTRUE ) {fEvtVsTrkHistExists = exists;}
 
+  // compute the track values and equal track cuts once per event for all instances
+  void SetShareTrackCache(Bool_t share=kTRUE) { fShareTrackCache=share; }
+  Bool_t GetShareTrackCache() const { return fShareTrackCache; }
+  // print the track cache statistics in FinishTaskOutput
+  void SetPrintTrackCacheStats(Bool_t print=kTRUE) { fPrintTrackCacheStats=print; }
+
 protected:
   enum {kAllEvents=0, kSelectedEvents, kV0andEvents,  kTrdTriggeredEvents, kTrdTriggeredEventsMatched, kFilteredEvents, kPileupEvents, kNbinsEvent};
   TObjArray *fPairArray;             //! output array
@@ -104,12 +111,16 @@ protected:
 
   AliAnalysisCuts *fEventFilter;     // event filter
 
+  Bool_t fShareTrackCache;           // share track values and cut results between the instances
+  Bool_t fPrintTrackCacheStats;      // print the track cache statistics at the end of the job
+  AliDielectronTrackCache *fTrackCache; //! per event track cache shared by the instances
+
   TH1D *fEventStat;                  //! Histogram with event statistics
   TH1D *fEventStatTRDTrigger;           //! Histogram with TRD trigger statistics
 
   AliAnalysisTaskMultiDielectron(const AliAnalysisTaskMultiDielectron &c);
   AliAnalysisTaskMultiDielectron& operator= (const AliAnalysisTaskMultiDielectron &c);
 
-  ClassDef(AliAnalysisTaskMultiDielectron, 4); //Analysis Task handling multiple instances of AliDielectron
+  ClassDef(AliAnalysisTaskMultiDielectron, 5); //Analysis Task handling multiple instances of AliDielectron
 };
 #endif
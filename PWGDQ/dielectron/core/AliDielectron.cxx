@@ -47,6 +47,7 @@ The names are available via the function PairClassName(Int_t i)
 #include <TString.h>
 #include <TList.h>
 #include <TMath.h>
+#include <TDatabasePDG.h>
 #include <TObject.h>
 #include <TGrid.h>
 #include <TSystem.h>
@@ -74,6 +75,8 @@ The names are available via the function PairClassName(Int_t i)
 #include "AliDielectronV0Cuts.h"
 #include "AliDielectronPID.h"
 #include "AliDielectronHistos.h"
+#include "AliDielectronVarCuts.h"
+#include "AliDielectronTrackCache.h"
 
 #include "AliDielectron.h"
 
@@ -142,6 +145,18 @@ AliDielectron::AliDielectron() :
   fHistoArray(0x0),
   fHistos(0x0),
   fUsedVars(new TBits(AliDielectronVarManager::kNMaxValues)),
+  fUseValueCache(kTRUE),
+  fValueCacheVars(0x0),
+  fUsePairPreselection(kFALSE),
+  fPreselectionMargin(0.05),
+  fPreselectionAbsMargin(0.01),
+  fPreselectionAngleMargin(0.05),
+  fRecyclePairs(kTRUE),
+  fPreselectionCuts(),
+  fPreselectionPhiv(kFALSE),
+  fPairPool(0x0),
+  fTrackCache(0x0),
+  fTrackCutSignatures(),
   fPairCandidates(new TObjArray(13)),
   fCfManagerPair(0x0),
   fTrackRotator(0x0),
@@ -237,6 +252,18 @@ AliDielectron::AliDielectron(const char* name, const char* title) :
   fHistoArray(0x0),
   fHistos(0x0),
   fUsedVars(new TBits(AliDielectronVarManager::kNMaxValues)),
+  fUseValueCache(kTRUE),
+  fValueCacheVars(0x0),
+  fUsePairPreselection(kFALSE),
+  fPreselectionMargin(0.05),
+  fPreselectionAbsMargin(0.01),
+  fPreselectionAngleMargin(0.05),
+  fRecyclePairs(kTRUE),
+  fPreselectionCuts(),
+  fPreselectionPhiv(kFALSE),
+  fPairPool(0x0),
+  fTrackCache(0x0),
+  fTrackCutSignatures(),
   fPairCandidates(new TObjArray(13)),
   fCfManagerPair(0x0),
   fTrackRotator(0x0),
@@ -309,6 +336,8 @@ AliDielectron::~AliDielectron()
   if (fPairEffMap) delete fPairEffMap;
   if (fHistos) delete fHistos;
   if (fUsedVars) delete fUsedVars;
+  if (fValueCacheVars) delete fValueCacheVars;
+  if (fPairPool) delete fPairPool;
   if (fPairCandidates && fEventProcess) delete fPairCandidates;
   if (fDebugTree) delete fDebugTree;
   if (fMixing) delete fMixing;
@@ -398,6 +427,13 @@ void AliDielectron::Init()
       fEvtVsTrkHist->SetHistogramList(fHistos);
     }
   }
+
+  if (fEventProcess && fRecyclePairs && !fPairPool) {
+    fPairPool=new TObjArray;
+    fPairPool->SetOwner();
+  }
+  InitPairPreselection();
+  if (fTrackCache) InitTrackCache();
 }
 
 //________________________________________________________________
@@ -478,6 +514,13 @@ Bool_t AliDielectron::Process(AliVEvent *ev1, AliVEvent *ev2)
 
 	AliDielectronPID::SetPIDCalibinPU(fPIDCalibinPU);
 
+  // compute the tracks and pairs only once for all cuts and histograms,
+  // the variables used by this instance are collected in fValueCacheVars
+  if (fUseValueCache) {
+    if (!fValueCacheVars) fValueCacheVars=new TBits(AliDielectronVarManager::kNMaxValues);
+    AliDielectronVarManager::SetValueCache(fValueCacheVars);
+  }
+
   // set event
   AliDielectronVarManager::SetFillMap(fUsedVars);
   AliDielectronVarManager::SetEvent(ev1);
@@ -513,7 +556,10 @@ Bool_t AliDielectron::Process(AliVEvent *ev1, AliVEvent *ev2)
   if(fCutQA) fQAmonitor->FillAll(ev1);
   if(fCutQA) fQAmonitor->Fill(cutmask,ev1);
   if ((ev1&&cutmask!=selectedMask) ||
-      (ev2&&fEventFilter.IsSelected(ev2)!=selectedMask)) return 0;
+      (ev2&&fEventFilter.IsSelected(ev2)!=selectedMask)) {
+    AliDielectronVarManager::SetValueCache(0x0);
+    return 0;
+  }
 
   if(fEvtVsTrkHist){
     fEvtVsTrkHist->SetPIDResponse(AliDielectronVarManager::GetPIDResponse());
@@ -616,6 +662,7 @@ Bool_t AliDielectron::Process(AliVEvent *ev1, AliVEvent *ev2)
     fTrackRotator->ClearRotatedTrackPool();
   }
 
+  AliDielectronVarManager::SetValueCache(0x0);
   return 1;
 
 }
@@ -950,6 +997,12 @@ void AliDielectron::FillTrackArrays(AliVEvent * const ev, Int_t eventNr)
   // eventNr = 1: Second event, use track arrays 2 and 3
   //
 
+  // per track values and cut results shared with the other instances
+  if (fTrackCache && eventNr==0 && !fCutQA) {
+    FillTrackArraysShared(ev);
+    return;
+  }
+
   Int_t ntracks=ev->GetNumberOfTracks();
 
   UInt_t selectedMask=(1<<fTrackFilter.GetCuts()->GetEntries())-1;
@@ -974,6 +1027,79 @@ void AliDielectron::FillTrackArrays(AliVEvent * const ev, Int_t eventNr)
   }
 }
 
+//________________________________________________________________
+void AliDielectron::InitTrackCache()
+{
+  //
+  // signatures of the track cuts, equal cuts of other instances share their results
+  //
+  fTrackCutSignatures.clear();
+  TIter nextCut(fTrackFilter.GetCuts());
+  while (AliAnalysisCuts *cut=static_cast<AliAnalysisCuts*>(nextCut())) {
+    fTrackCutSignatures.push_back(AliDielectronTrackCache::GetCutSignature(cut));
+  }
+}
+
+//________________________________________________________________
+void AliDielectron::FillTrackArraysShared(AliVEvent * const ev)
+{
+  //
+  // select tracks and fill the track candidate arrays of the first event,
+  // the track values and the results of equal cuts are taken from the shared track cache.
+  // Same selection as AliAnalysisFilter::IsSelected
+  //
+  TList *cuts=fTrackFilter.GetCuts();
+  const Int_t ncuts=cuts->GetEntries();
+  if ((Int_t)fTrackCutSignatures.size()!=ncuts) InitTrackCache();
+
+  // values depend on the PID corrections and the efficiency map of this instance
+  TString config=AliDielectronPID::GetCorrectionKey();
+  config+=Form(" %p",(void*)fLegEffMap);
+  const Int_t store=fTrackCache->GetStore(config);
+  std::vector<Int_t> slots(ncuts);
+  for (Int_t iCut=0; iCut<ncuts; ++iCut) {
+    slots[iCut]=fTrackCache->GetCutSlot(config+"|"+fTrackCutSignatures[iCut]);
+  }
+
+  AliDielectronVarManager::SetTrackCache(fTrackCache);
+
+  Int_t ntracks=ev->GetNumberOfTracks();
+  UInt_t selectedMask=(1<<ncuts)-1;
+  for (Int_t itrack=0; itrack<ntracks; ++itrack){
+    //get particle
+    AliVParticle *particle=ev->GetTrack(itrack);
+    fTrackCache->SetCurrentTrack(store, particle, itrack);
+
+    //apply track cuts
+    UInt_t cutmask=0;
+    Int_t iCutB=1;
+    for (Int_t iCut=0; iCut<ncuts; ++iCut) {
+      AliAnalysisCuts *cut=static_cast<AliAnalysisCuts*>(cuts->At(iCut));
+      Int_t result=fTrackCache->GetCutResult(slots[iCut]);
+      if (result<0) {
+        result=cut->IsSelected(particle);
+        fTrackCache->SetCutResult(slots[iCut], result);
+      }
+      Bool_t acc=result;
+      UInt_t filterMask=cut->GetFilterMask();
+      if (filterMask>0) acc=(acc && (filterMask==cutmask));
+      cut->SetSelected(acc);
+      if (acc) cutmask|=iCutB & 0x00ffffff;
+      iCutB*=2;
+    }
+
+    if (cutmask!=selectedMask) continue;
+
+    //fill selected particle into the corresponding track arrays
+    Short_t charge=particle->Charge();
+    if (charge>0)      fTracks[0].Add(particle);
+    else if (charge<0) fTracks[1].Add(particle);
+  }
+
+  fTrackCache->ResetCurrentTrack();
+  AliDielectronVarManager::SetTrackCache(0x0);
+}
+
 //________________________________________________________________
 void AliDielectron::EventPlanePreFilter(Int_t arr1, Int_t arr2, TObjArray arrTracks1, TObjArray arrTracks2, const AliVEvent *ev)
 {
@@ -1359,6 +1485,7 @@ void AliDielectron::PairPreFilter(Int_t arr1, Int_t arr2, TObjArray &arrTracks1,
           //       if (AliDielectronVarManager::GetKFVertex()) candidate.SetProductionVertex(*AliDielectronVarManager::GetKFVertex());
 
           //pair cuts
+          AliDielectronVarManager::ResetValueCache();
           UInt_t cutMask=pairPreFilter->IsSelected(&candidate);
 
           //apply cut
@@ -1411,6 +1538,7 @@ void AliDielectron::PairPreFilter(Int_t arr1, Int_t arr2, TObjArray &arrTracks1,
           //       if (AliDielectronVarManager::GetKFVertex()) candidate.SetProductionVertex(*AliDielectronVarManager::GetKFVertex());
 
           //pair cuts
+          AliDielectronVarManager::ResetValueCache();
           UInt_t cutMask=pairPreFilter->IsSelected(&candidate);
 
           //apply cut
@@ -1491,21 +1619,40 @@ void AliDielectron::FillPairArrays(Int_t arr1, Int_t arr2, const AliVEvent *ev)
   // select pairs and fill pair candidate arrays
   //
 
-  TObjArray arrTracks1=fTracks[arr1];
-  TObjArray arrTracks2=fTracks[arr2];
+  Bool_t preFilter1=(!fPreFilterAllSigns1) && (!fPreFilterUnlikeOnly1) && (!fPreFilterLikeOnly1) && ( fPairPreFilter1.GetCuts()->GetEntries()>0 );
+  Bool_t preFilter2=(!fPreFilterAllSigns2) && (!fPreFilterUnlikeOnly2) && (!fPreFilterLikeOnly2) && ( fPairPreFilter2.GetCuts()->GetEntries()>0 );
+
+  // the pre filter removes tracks, it works on copies of the track arrays
+  TObjArray arrCopy1, arrCopy2;
+  if (preFilter1 || preFilter2) {
+    arrCopy1=fTracks[arr1];
+    arrCopy2=fTracks[arr2];
+  }
+  TObjArray &arrTracks1 = (preFilter1 || preFilter2) ? arrCopy1 : fTracks[arr1];
+  TObjArray &arrTracks2 = (preFilter1 || preFilter2) ? arrCopy2 : fTracks[arr2];
 
   //process pre filter if set
-  if ((!fPreFilterAllSigns1) && (!fPreFilterUnlikeOnly1) && (!fPreFilterLikeOnly1) && ( fPairPreFilter1.GetCuts()->GetEntries()>0 ))  PairPreFilter(arr1, arr2, arrTracks1, arrTracks2, ev, 1);
+  if (preFilter1) PairPreFilter(arr1, arr2, arrTracks1, arrTracks2, ev, 1);
 
-  if ((!fPreFilterAllSigns2) && (!fPreFilterUnlikeOnly2) && (!fPreFilterLikeOnly2) && ( fPairPreFilter2.GetCuts()->GetEntries()>0 ))  PairPreFilter(arr1, arr2, arrTracks1, arrTracks2, ev, 2);
+  if (preFilter2) PairPreFilter(arr1, arr2, arrTracks1, arrTracks2, ev, 2);
 
   Int_t pairIndex=GetPairIndex(arr1,arr2);
 
   Int_t ntrack1=arrTracks1.GetEntriesFast();
   Int_t ntrack2=arrTracks2.GetEntriesFast();
 
-  AliDielectronPair *candidate=new AliDielectronPair;
-  candidate->SetKFUsage(fUseKF);
+  // leg kinematics for the preselection of the candidates
+  Bool_t preselect=!fPreselectionCuts.empty();
+  Double_t magField=0.;
+  if (preselect) {
+    FillLegKinematics(arrTracks1, fPdgLeg1, fLegKinematics[0]);
+    FillLegKinematics(arrTracks2, fPdgLeg2, fLegKinematics[1]);
+    // same event as used by the variable manager for phiv, no event: phiv not filled
+    const AliVEvent *evMag=AliDielectronVarManager::GetCurrentEvent();
+    magField=evMag ? evMag->GetMagneticField() : -999.;
+  }
+
+  AliDielectronPair *candidate=GetPairCandidate();
 
   UInt_t selectedMask=(1<<fPairFilter.GetCuts()->GetEntries())-1;
 
@@ -1513,6 +1660,9 @@ void AliDielectron::FillPairArrays(Int_t arr1, Int_t arr2, const AliVEvent *ev)
     Int_t end=ntrack2;
     if (arr1==arr2) end=itrack1;
     for (Int_t itrack2=0; itrack2<end; ++itrack2){
+      // reject candidates which can not pass the pair cuts
+      if (preselect && !PassPairPreselection(itrack1, itrack2, magField)) continue;
+
       //create the pair (direct pointer to the memory by this daughter reference are kept also for ME)
       candidate->SetTracks(&(*static_cast<AliVTrack*>(arrTracks1.UncheckedAt(itrack1))), fPdgLeg1,
                            &(*static_cast<AliVTrack*>(arrTracks2.UncheckedAt(itrack2))), fPdgLeg2);
@@ -1532,6 +1682,7 @@ void AliDielectron::FillPairArrays(Int_t arr1, Int_t arr2, const AliVEvent *ev)
       }
 
       //pair cuts
+      AliDielectronVarManager::ResetValueCache();
       UInt_t cutMask=fPairFilter.IsSelected(candidate);
 
       //CF manager for the pair
@@ -1552,12 +1703,191 @@ void AliDielectron::FillPairArrays(Int_t arr1, Int_t arr2, const AliVEvent *ev)
       //add the candidate to the candidate array
       PairArray(pairIndex)->Add(candidate);
       //get a new candidate
-      candidate=new AliDielectronPair;
-      candidate->SetKFUsage(fUseKF);
+      candidate=GetPairCandidate();
+    }
+  }
+  //release the surplus candidate
+  AliDielectronVarManager::ResetValueCache();
+  ReleasePairCandidate(candidate);
+}
+
+//________________________________________________________________
+AliDielectronPair* AliDielectron::GetPairCandidate()
+{
+  //
+  // new pair candidate, taken from the pool of the previous events if any
+  //
+  AliDielectronPair *pair=0x0;
+  if (fPairPool && fPairPool->GetEntriesFast()>0) pair=static_cast<AliDielectronPair*>(fPairPool->RemoveLast());
+  if (!pair) pair=new AliDielectronPair;
+  pair->SetKFUsage(fUseKF);
+  return pair;
+}
+
+//________________________________________________________________
+void AliDielectron::ReleasePairCandidate(TObject *pair)
+{
+  //
+  // give back a pair candidate to the pool
+  // pairs referenced elsewhere (TRef) are not reused
+  //
+  if (!pair) return;
+  if (!fPairPool || pair->TestBit(kIsReferenced)) {
+    delete pair;
+    return;
+  }
+  fPairPool->AddLast(pair);
+}
+
+//________________________________________________________________
+void AliDielectron::InitPairPreselection()
+{
+  //
+  // collect the range cuts on mass, pt, opening angle and phiv of the pair filter.
+  // They are applied on the leg kinematics before the pair is built.
+  // Only cuts which have to be passed by all candidates are used,
+  // i.e. no CF manager or cut QA filled with all candidates.
+  //
+  fPreselectionCuts.clear();
+  fPreselectionPhiv=kFALSE;
+  if (!fUsePairPreselection) return;
+  if (fCfManagerPair || fCutQA || fUseGammaTracks) {
+    AliWarning("Pair preselection not possible with CF manager, cut QA or gamma tracks, switched off");
+    return;
+  }
+
+  TIter nextCut(fPairFilter.GetCuts());
+  while (TObject *obj=nextCut()) {
+    if (obj->IsA()!=AliDielectronVarCuts::Class()) continue;
+    AliDielectronVarCuts *cuts=static_cast<AliDielectronVarCuts*>(obj);
+    if (cuts->GetCutType()!=AliDielectronVarCuts::kAll || cuts->GetCutOnMCtruth()) continue;
+    for (Int_t iCut=0; iCut<cuts->GetNCuts(); ++iCut) {
+      PreselectionCut cut;
+      if (!cuts->GetRangeCut(iCut, cut.fVar, cut.fMin, cut.fMax, cut.fExclude)) continue;
+      if (cut.fVar!=AliDielectronVarManager::kM && cut.fVar!=AliDielectronVarManager::kPt &&
+          cut.fVar!=AliDielectronVarManager::kOpeningAngle && cut.fVar!=AliDielectronVarManager::kPhivPair) continue;
+      if (cut.fVar==AliDielectronVarManager::kPhivPair) fPreselectionPhiv=kTRUE;
+      fPreselectionCuts.push_back(cut);
+    }
+  }
+  AliInfo(Form("Pair preselection with %d cuts",(Int_t)fPreselectionCuts.size()));
+}
+
+//________________________________________________________________
+void AliDielectron::FillLegKinematics(const TObjArray &arrTracks, Int_t pdg, LegKinematics &legs) const
+{
+  //
+  // four-vectors and charges of the tracks for the pair preselection
+  //
+  const Int_t ntracks=arrTracks.GetEntriesFast();
+  legs.fPx.resize(ntracks);
+  legs.fPy.resize(ntracks);
+  legs.fPz.resize(ntracks);
+  legs.fE.resize(ntracks);
+  legs.fPt.resize(ntracks);
+  legs.fCharge.resize(ntracks);
+
+  TParticlePDG *part=TDatabasePDG::Instance()->GetParticle(pdg);
+  const Double_t mass=part ? part->Mass() : 0.;
+  for (Int_t itrack=0; itrack<ntracks; ++itrack) {
+    const AliVTrack *track=static_cast<const AliVTrack*>(arrTracks.UncheckedAt(itrack));
+    Double_t p[3]={0.,0.,0.};
+    if (track) track->PxPyPz(p);
+    legs.fPx[itrack]=p[0];
+    legs.fPy[itrack]=p[1];
+    legs.fPz[itrack]=p[2];
+    legs.fE[itrack]=TMath::Sqrt(p[0]*p[0]+p[1]*p[1]+p[2]*p[2]+mass*mass);
+    legs.fPt[itrack]=track ? track->Pt() : 0.;
+    legs.fCharge[itrack]=track ? track->Charge() : 0;
+  }
+}
+
+//________________________________________________________________
+Bool_t AliDielectron::PassPairPreselection(Int_t itrack1, Int_t itrack2, Double_t magField) const
+{
+  //
+  // check if the pair of legs itrack1, itrack2 can pass the preselection cuts
+  // The pair is built from the track momenta while the pair filter uses the KF pair,
+  // mass and pt get a relative and an absolute margin, the angles an absolute one.
+  // Values which can not be computed (nan) never reject a candidate.
+  //
+  const LegKinematics &l1=fLegKinematics[0];
+  const LegKinematics &l2=fLegKinematics[1];
+
+  const Double_t px=l1.fPx[itrack1]+l2.fPx[itrack2];
+  const Double_t py=l1.fPy[itrack1]+l2.fPy[itrack2];
+  const Double_t pz=l1.fPz[itrack1]+l2.fPz[itrack2];
+  const Double_t e =l1.fE[itrack1]+l2.fE[itrack2];
+  const Double_t pt=TMath::Sqrt(px*px+py*py);
+  const Double_t m2=e*e-px*px-py*py-pz*pz;
+  const Double_t m =m2>0. ? TMath::Sqrt(m2) : 0.;
+
+  const Double_t p1=TMath::Sqrt(l1.fPx[itrack1]*l1.fPx[itrack1]+l1.fPy[itrack1]*l1.fPy[itrack1]+l1.fPz[itrack1]*l1.fPz[itrack1]);
+  const Double_t p2=TMath::Sqrt(l2.fPx[itrack2]*l2.fPx[itrack2]+l2.fPy[itrack2]*l2.fPy[itrack2]+l2.fPz[itrack2]*l2.fPz[itrack2]);
+  const Double_t pp=p1*p2;
+  Double_t cosOpen=pp>0. ? (l1.fPx[itrack1]*l2.fPx[itrack2]+l1.fPy[itrack1]*l2.fPy[itrack2]+l1.fPz[itrack1]*l2.fPz[itrack2])/pp : 1.;
+  if (cosOpen>1.) cosOpen=1.;
+  if (cosOpen<-1.) cosOpen=-1.;
+  const Double_t openingAngle=TMath::ACos(cosOpen);
+
+  Double_t phiv=-5.;
+  if (fPreselectionPhiv && magField>-999.) {
+    // same leg ordering as AliDielectronPair: first daughter with the larger pt
+    Bool_t firstIsLeg1=l1.fPt[itrack1]>l2.fPt[itrack2];
+    Short_t q1=firstIsLeg1 ? l1.fCharge[itrack1] : l2.fCharge[itrack2];
+    Short_t q2=firstIsLeg1 ? l2.fCharge[itrack2] : l1.fCharge[itrack1];
+    Bool_t likeSign=q1*q2>0;
+    if (likeSign && AliDielectronPair::GetRandomizeDaughters()) {
+      phiv=TMath::QuietNaN();
+    } else {
+      // see AliDielectronPair::PhivPair
+      Bool_t takeFirst = likeSign ? ((magField<0)==(q1>0)) : ((magField>0)==(q1>0));
+      Bool_t leg1First = (takeFirst==firstIsLeg1);
+      const Double_t ax1=leg1First ? l1.fPx[itrack1] : l2.fPx[itrack2];
+      const Double_t ay1=leg1First ? l1.fPy[itrack1] : l2.fPy[itrack2];
+      const Double_t az1=leg1First ? l1.fPz[itrack1] : l2.fPz[itrack2];
+      const Double_t ax2=leg1First ? l2.fPx[itrack2] : l1.fPx[itrack1];
+      const Double_t ay2=leg1First ? l2.fPy[itrack2] : l1.fPy[itrack1];
+      const Double_t az2=leg1First ? l2.fPz[itrack2] : l1.fPz[itrack1];
+
+      const Double_t pl=TMath::Sqrt(px*px+py*py+pz*pz);
+      const Double_t ux=px/pl, uy=py/pl, uz=pz/pl;
+      const Double_t ax=uy/TMath::Sqrt(ux*ux+uy*uy);
+      const Double_t ay=-ux/TMath::Sqrt(ux*ux+uy*uy);
+      const Double_t vpx=ay1*az2-az1*ay2;
+      const Double_t vpy=az1*ax2-ax1*az2;
+      const Double_t vpz=ax1*ay2-ay1*ax2;
+      const Double_t vp=TMath::Sqrt(vpx*vpx+vpy*vpy+vpz*vpz);
+      const Double_t vx=vpx/vp, vy=vpy/vp, vz=vpz/vp;
+      const Double_t wx=uy*vz-uz*vy;
+      const Double_t wy=uz*vx-ux*vz;
+      phiv=TMath::ACos(wx*ax+wy*ay);
+    }
+  }
+
+  for (std::vector<PreselectionCut>::const_iterator cut=fPreselectionCuts.begin(); cut!=fPreselectionCuts.end(); ++cut) {
+    Double_t lo=0., hi=0.;
+    switch (cut->fVar) {
+      case AliDielectronVarManager::kM:
+        lo=m*(1.-fPreselectionMargin)-fPreselectionAbsMargin;  hi=m*(1.+fPreselectionMargin)+fPreselectionAbsMargin;  break;
+      case AliDielectronVarManager::kPt:
+        lo=pt*(1.-fPreselectionMargin)-fPreselectionAbsMargin; hi=pt*(1.+fPreselectionMargin)+fPreselectionAbsMargin; break;
+      case AliDielectronVarManager::kOpeningAngle:
+        lo=openingAngle-fPreselectionAngleMargin; hi=openingAngle+fPreselectionAngleMargin; break;
+      case AliDielectronVarManager::kPhivPair:
+        if (magField<=-999.) { lo=hi=phiv; break; }
+        lo=phiv-fPreselectionAngleMargin; hi=phiv+fPreselectionAngleMargin; break;
+      default:
+        continue;
+    }
+    // [lo,hi] is the range the value of the pair filter can take
+    if (!cut->fExclude) {
+      if (hi<cut->fMin || lo>cut->fMax) return kFALSE;
+    } else {
+      if (lo>=cut->fMin && hi<=cut->fMax) return kFALSE;
     }
   }
-  //delete the surplus candidate
-  delete candidate;
+  return kTRUE;
 }
 
 //________________________________________________________________
@@ -1599,6 +1929,7 @@ void AliDielectron::FillPairArrayTR()
     
 
     //pair cuts
+    AliDielectronVarManager::ResetValueCache();
     UInt_t cutMask=fPairFilter.IsSelected(&candidate);
 
     //CF manager for the pair
@@ -21,6 +21,8 @@
 #include <THnBase.h>
 #include <TSpline.h>
 
+#include <vector>
+
 #include <AliAnalysisFilter.h>
 #include <AliKFParticle.h>
 
@@ -39,6 +41,7 @@ class AliDielectronTrackRotator;
 class AliDielectronPair;
 class AliDielectronSignalMC;
 class AliDielectronMixingHandler;
+class AliDielectronTrackCache;
 
 //________________________________________________________________
 class AliDielectron : public TNamed {
@@ -149,6 +152,15 @@ public:
 
   void SetStoreRotatedPairs(Bool_t storeTR) {fStoreRotatedPairs = storeTR;}
   void SetDontClearArrays(Bool_t dontClearArrays=kTRUE) { fDontClearArrays=dontClearArrays; }
+  void SetUseValueCache(Bool_t useCache=kTRUE) { fUseValueCache=useCache; }
+  Bool_t GetUseValueCache() const { return fUseValueCache; }
+  void SetUsePairPreselection(Bool_t use=kTRUE, Double_t relMargin=0.05, Double_t absMargin=0.01, Double_t angleMargin=0.05)
+    { fUsePairPreselection=use; fPreselectionMargin=relMargin; fPreselectionAbsMargin=absMargin; fPreselectionAngleMargin=angleMargin; }
+  Bool_t GetUsePairPreselection() const { return fUsePairPreselection; }
+  void SetRecyclePairs(Bool_t recycle=kTRUE) { fRecyclePairs=recycle; }
+  Bool_t GetRecyclePairs() const { return fRecyclePairs; }
+  void SetTrackCache(AliDielectronTrackCache *cache) { fTrackCache=cache; fTrackCutSignatures.clear(); }
+  AliDielectronTrackCache* GetTrackCache() const { return fTrackCache; }
   Bool_t DontClearArrays() const { return fDontClearArrays; }
 
   void AddSignalMC(AliDielectronSignalMC* signal);
@@ -266,6 +278,30 @@ private:
                                   //  Streaming and merging should be handled
                                   //  by the analysis framework
   TBits *fUsedVars;               // used variables
+  Bool_t fUseValueCache;          // compute each track and pair once for all cuts and histograms
+  TBits *fValueCacheVars;         //! variables used by all cuts and histograms (value cache)
+  Bool_t fUsePairPreselection;    // reject pair candidates from the leg kinematics before building the pair
+  Double_t fPreselectionMargin;   // relative margin on mass and pt of the pair preselection
+  Double_t fPreselectionAbsMargin; // absolute margin (GeV) on mass and pt of the pair preselection
+  Double_t fPreselectionAngleMargin; // margin (rad) on the angles of the pair preselection
+  Bool_t fRecyclePairs;           // reuse the pair objects of the previous events instead of new/delete
+
+  struct PreselectionCut {
+    Int_t    fVar;                // AliDielectronVarManager variable
+    Double_t fMin;                // lower limit
+    Double_t fMax;                // upper limit
+    Bool_t   fExclude;            // inverse cut logic
+  };
+  struct LegKinematics {
+    std::vector<Double_t> fPx, fPy, fPz, fE, fPt;
+    std::vector<Short_t>  fCharge;
+  };
+  std::vector<PreselectionCut> fPreselectionCuts; //! range cuts of the pair filter used by the preselection
+  Bool_t fPreselectionPhiv;       //! preselection needs phiv
+  LegKinematics fLegKinematics[2];//! leg kinematics (SoA) of the pairing in progress
+  TObjArray *fPairPool;           //! recycled pair candidates (owner)
+  AliDielectronTrackCache *fTrackCache; //! track values and cut results shared with other instances (not owner)
+  std::vector<TString> fTrackCutSignatures; //! signatures of the track cuts for the shared cache
 
   TObjArray fTracks[6];           //! Selected track candidates
                                   //  0: Event1, positive particles
@@ -312,10 +348,17 @@ private:
   Bool_t fUseGammaTracks;       // use function SetGammaTracks for MCtruth photons
 
   void FillTrackArrays(AliVEvent * const ev, Int_t eventNr=0);
+  void FillTrackArraysShared(AliVEvent * const ev);
+  void InitTrackCache();
   void EventPlanePreFilter(Int_t arr1, Int_t arr2, TObjArray arrTracks1, TObjArray arrTracks2, const AliVEvent *ev);
   void PairPreFilter(Int_t arr1, Int_t arr2, TObjArray &arrTracks1, TObjArray &arrTracks2, const AliVEvent *ev, Int_t prefilterN);
   void FillPairArrays(Int_t arr1, Int_t arr2, const AliVEvent *ev = 0x0);
   void FillPairArrayTR();
+  void InitPairPreselection();
+  void FillLegKinematics(const TObjArray &arrTracks, Int_t pdg, LegKinematics &legs) const;
+  Bool_t PassPairPreselection(Int_t itrack1, Int_t itrack2, Double_t magField) const;
+  AliDielectronPair* GetPairCandidate();
+  void ReleasePairCandidate(TObject *pair);
 
   Int_t GetPairIndex(Int_t arr1, Int_t arr2) const {return arr1>=arr2?arr1*(arr1+1)/2+arr2:arr2*(arr2+1)/2+arr1;}
 
@@ -353,7 +396,7 @@ private:
   AliDielectron(const AliDielectron &c);
   AliDielectron &operator=(const AliDielectron &c);
 
-  ClassDef(AliDielectron,19);
+  ClassDef(AliDielectron,21);
 };
 
 inline void AliDielectron::InitPairCandidateArrays()
@@ -386,7 +429,21 @@ inline void AliDielectron::ClearArrays()
     fTracks[i].Clear();
   }
   for (Int_t i=0;i<13;++i){
-    if (PairArray(i)) PairArray(i)->Delete();
+    TObjArray *arr=PairArray(i);
+    if (!arr) continue;
+    if (!fPairPool) {
+      arr->Delete();
+      continue;
+    }
+    // keep the pairs for the next event
+    for (Int_t ipair=0; ipair<arr->GetEntriesFast(); ++ipair){
+      TObject *pair=arr->UncheckedAt(ipair);
+      if (pair) ReleasePairCandidate(pair);
+    }
+    // the pairs are owned by the pool now
+    arr->SetOwner(kFALSE);
+    arr->Clear();
+    arr->SetOwner(kTRUE);
   }
 }
 
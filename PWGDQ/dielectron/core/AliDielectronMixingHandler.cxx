@@ -339,6 +339,8 @@ void AliDielectronMixingHandler::DoMixing(TClonesArray &pool, AliDielectron *die
 
       ev2P.Reset();
       ev2N.Reset();
+      // the moved tracks have to be recomputed
+      AliDielectronVarManager::ResetValueCache();
     }
 
     //mixing of ev1- ev2+ (pair type4). This is common for all mixing types
@@ -825,6 +825,25 @@ void AliDielectronPID::SetCorrVal(Double_t run)
   }
 }
 
+//______________________________________________
+TString AliDielectronPID::GetCorrectionKey()
+{
+  //
+  // key identifying the set of corrections currently applied to the PID values,
+  // tracks with the same key have the same PID values
+  //
+  TString key=Form("%p %p %g %g %p %p %p %p %p %p %p %d", (void*)fgFitCorr, (void*)fgdEdxRunCorr, fgCorr, fgCorrdEdx,
+                   (void*)fgFunEtaCorr, (void*)fgFunCntrdCorr, (void*)fgFunWdthCorr, (void*)fgFunCntrdCorrITS,
+                   (void*)fgFunWdthCorrITS, (void*)fgFunCntrdCorrTOF, (void*)fgFunWdthCorrTOF, fgPIDCalibinPU);
+  for (Int_t id=0; id<15; ++id) {
+    for (Int_t ip=0; ip<15; ++ip) {
+      if (fgFunCntrdCorrPU[id][ip]) key+=Form(" c%d.%d:%p", id, ip, (void*)fgFunCntrdCorrPU[id][ip]);
+      if (fgFunWdthCorrPU[id][ip])  key+=Form(" w%d.%d:%p", id, ip, (void*)fgFunWdthCorrPU[id][ip]);
+    }
+  }
+  return key;
+}
+
 //______________________________________________
 Double_t AliDielectronPID::GetEtaCorr(const AliVTrack *track)
 {
@@ -97,6 +97,7 @@ public:
   static void SetCentroidCorrFunctionPU(Int_t id,Int_t ip,THnBase *fun) { fgFunCntrdCorrPU[id][ip]=fun; }
   static void SetWidthCorrFunctionPU(Int_t id,Int_t ip,THnBase *fun) { fgFunWdthCorrPU[id][ip]=fun; }
 	static void SetPIDCalibinPU(Bool_t flag) {fgPIDCalibinPU = flag;}
+  static TString GetCorrectionKey();
 
   static Double_t GetEtaCorr(const AliVTrack *track);
 
@@ -0,0 +1,256 @@
+/*************************************************************************
+ * Copyright(c) 1998-2009, ALICE Experiment at CERN, All rights reserved. *
+ *                                                                        *
+ * Author: The ALICE Off-line Project.                                    *
+ * Contributors are mentioned in the code where appropriate.              *
+ *                                                                        *
+ * Permission to use, copy, modify and distribute this software and its   *
+ * documentation strictly for non-commercial purposes is hereby granted   *
+ * without fee, provided that the above copyright notice appears in all   *
+ * copies and that both the copyright notice and this permission notice   *
+ * appear in the supporting documentation. The authors make no claims     *
+ * about the suitability of this software for any purpose. It is          *
+ * provided "as is" without express or implied warranty.                  *
+ **************************************************************************/
+
+//////////////////////////////////////////////////////////////////////////
+//                           TrackCache                                 //
+//                                                                      //
+/*
+   Several AliDielectron instances running on the same event (e.g. in
+   AliAnalysisTaskMultiDielectron) select their tracks from the same
+   event tracks. The cache keeps for the current event
+
+   - the values of each track, filled by AliDielectronVarManager with the
+     union of the variables used by all instances,
+   - the result of each track cut, cut objects with the same configuration
+     (same class and streamed content) share their results.
+
+   Track values depend on the PID post calibration and efficiency maps
+   set by the instance, the instance gives a configuration key and gets
+   a store for it. Instances with the same key share the store.
+
+   The task enables it with
+
+   task->SetShareTrackCache();
+
+*/
+//                                                                      //
+//////////////////////////////////////////////////////////////////////////
+
+#include "AliDielectronTrackCache.h"
+
+#include <cstring>
+
+#include <TBufferFile.h>
+#include <TClass.h>
+#include <TMD5.h>
+#include <TMath.h>
+
+#include <AliAnalysisCuts.h>
+
+#include "AliDielectronVarManager.h"
+
+ClassImp(AliDielectronTrackCache)
+
+//_____________________________________________________________________
+AliDielectronTrackCache::AliDielectronTrackCache() :
+  TObject(),
+  fVars(AliDielectronVarManager::kNMaxValues),
+  fVersion(0),
+  fEvent(0),
+  fStoreIds(),
+  fCutSlots(),
+  fValues(),
+  fStamps(),
+  fResults(),
+  fCurrentStore(-1),
+  fCurrentTrack(0x0),
+  fCurrentIndex(-1),
+  fNComputed(0),
+  fNReused(0),
+  fNCutsEvaluated(0),
+  fNCutsReused(0)
+{
+  //
+  // Default constructor
+  //
+}
+
+//_____________________________________________________________________
+AliDielectronTrackCache::~AliDielectronTrackCache()
+{
+  //
+  // Default destructor
+  //
+}
+
+//_____________________________________________________________________
+void AliDielectronTrackCache::NewEvent()
+{
+  //
+  // Invalidate all values and cut results. Stores and slots are
+  // reassigned, their memory is kept for the next event
+  //
+  ++fEvent;
+  fStoreIds.clear();
+  fCutSlots.clear();
+  fCurrentStore=-1;
+  fCurrentTrack=0x0;
+  fCurrentIndex=-1;
+}
+
+//_____________________________________________________________________
+Int_t AliDielectronTrackCache::GetStore(const char *configKey)
+{
+  //
+  // Store for the track values of the configuration 'configKey'
+  //
+  std::map<TString,Int_t>::const_iterator it=fStoreIds.find(configKey);
+  if (it!=fStoreIds.end()) return it->second;
+  const Int_t store=fStoreIds.size();
+  fStoreIds[configKey]=store;
+  if (store>=(Int_t)fValues.size()) {
+    fValues.resize(store+1);
+    fStamps.resize(store+1);
+  }
+  return store;
+}
+
+//_____________________________________________________________________
+Int_t AliDielectronTrackCache::GetCutSlot(const char *cutKey)
+{
+  //
+  // Result slot of the cut 'cutKey' (signature and configuration)
+  //
+  std::map<TString,Int_t>::const_iterator it=fCutSlots.find(cutKey);
+  if (it!=fCutSlots.end()) return it->second;
+  const Int_t slot=fCutSlots.size();
+  fCutSlots[cutKey]=slot;
+  if (slot>=(Int_t)fResults.size()) fResults.resize(slot+1);
+  return slot;
+}
+
+//_____________________________________________________________________
+TString AliDielectronTrackCache::GetCutSignature(const AliAnalysisCuts *cut)
+{
+  //
+  // Class name and checksum of the streamed cut object.
+  // Cuts with the same signature are assumed to take the same decision
+  //
+  if (!cut) return "";
+  TBufferFile buf(TBuffer::kWrite);
+  buf.WriteObjectAny(cut, cut->IsA());
+  TMD5 md5;
+  md5.Update(reinterpret_cast<UChar_t*>(buf.Buffer()), buf.Length());
+  md5.Final();
+  return TString::Format("%s/%s", cut->ClassName(), md5.AsString());
+}
+
+//_____________________________________________________________________
+void AliDielectronTrackCache::SetCurrentTrack(Int_t store, const TObject *track, Int_t index)
+{
+  //
+  // Track for which values and cut results are taken from the cache
+  //
+  fCurrentStore=store;
+  fCurrentTrack=track;
+  fCurrentIndex=index;
+  if (store<0 || index<0) {
+    fCurrentTrack=0x0;
+    return;
+  }
+  std::vector<ULong64_t> &stamps=fStamps[store];
+  if (index>=(Int_t)stamps.size()) {
+    stamps.resize(index+1, 0);
+    fValues[store].resize((index+1)*AliDielectronVarManager::kPairMax);
+  }
+}
+
+//_____________________________________________________________________
+void AliDielectronTrackCache::AddVariables(const TBits *map)
+{
+  //
+  // Add the variables of a fill map, cached values are recomputed
+  // if a new variable is needed
+  //
+  if (!map) return;
+  const UInt_t nbits=TMath::Min(map->GetNbits(), (UInt_t)AliDielectronVarManager::kNMaxValues);
+  for (UInt_t var=map->FirstSetBit(); var<nbits; var=map->FirstSetBit(var+1)) {
+    if (fVars.TestBitNumber(var)) continue;
+    fVars.SetBitNumber(var);
+    ++fVersion;
+  }
+}
+
+//_____________________________________________________________________
+Bool_t AliDielectronTrackCache::HasValues() const
+{
+  //
+  // Are the values of the current track in the cache
+  //
+  if (!fCurrentTrack) return kFALSE;
+  return fStamps[fCurrentStore][fCurrentIndex]==((((ULong64_t)fEvent)<<32)|fVersion);
+}
+
+//_____________________________________________________________________
+const Double_t* AliDielectronTrackCache::GetValues() const
+{
+  //
+  // Values (up to kPairMax) of the current track
+  //
+  ++fNReused;
+  return &fValues[fCurrentStore][fCurrentIndex*AliDielectronVarManager::kPairMax];
+}
+
+//_____________________________________________________________________
+void AliDielectronTrackCache::StoreValues(const Double_t *values)
+{
+  //
+  // Keep the values of the current track
+  //
+  if (!fCurrentTrack) return;
+  memcpy(&fValues[fCurrentStore][fCurrentIndex*AliDielectronVarManager::kPairMax], values,
+         sizeof(Double_t)*AliDielectronVarManager::kPairMax);
+  fStamps[fCurrentStore][fCurrentIndex]=(((ULong64_t)fEvent)<<32)|fVersion;
+  ++fNComputed;
+}
+
+//_____________________________________________________________________
+Int_t AliDielectronTrackCache::GetCutResult(Int_t slot) const
+{
+  //
+  // Result of the cut in 'slot' for the current track, -1 if not known
+  //
+  if (!fCurrentTrack || slot<0) return -1;
+  const std::vector<UInt_t> &results=fResults[slot];
+  if (fCurrentIndex>=(Int_t)results.size()) return -1;
+  const UInt_t result=results[fCurrentIndex];
+  if ((result>>1)!=fEvent) return -1;
+  ++fNCutsReused;
+  return result&1;
+}
+
+//_____________________________________________________________________
+void AliDielectronTrackCache::SetCutResult(Int_t slot, Bool_t accepted)
+{
+  //
+  // Keep the result of the cut in 'slot' for the current track
+  //
+  ++fNCutsEvaluated;
+  if (!fCurrentTrack || slot<0) return;
+  std::vector<UInt_t> &results=fResults[slot];
+  if (fCurrentIndex>=(Int_t)results.size()) results.resize(fCurrentIndex+1, 0);
+  results[fCurrentIndex]=2*fEvent+(accepted?1:0);
+}
+
+//_____________________________________________________________________
+void AliDielectronTrackCache::Print(const Option_t* /*option*/) const
+{
+  //
+  // Print the cache statistics
+  //
+  printf("AliDielectronTrackCache: %u events, %u variables\n", fEvent, fVars.CountBits());
+  printf("  track values: %llu computed, %llu reused\n", fNComputed, fNReused);
+  printf("  cut results:  %llu evaluated, %llu reused\n", fNCutsEvaluated, fNCutsReused);
+}
@@ -0,0 +1,81 @@
+#ifndef ALIDIELECTRONTRACKCACHE_H
+#define ALIDIELECTRONTRACKCACHE_H
+
+/* Copyright(c) 1998-2009, ALICE Experiment at CERN, All rights reserved. *
+ * See cxx source for full Copyright notice                               */
+
+//#################################################################
+//#                                                               #
+//#             Class AliDielectronTrackCache                     #
+//#      Per event track values and cut results shared by         #
+//#      several AliDielectron instances                          #
+//#                                                               #
+//#################################################################
+
+#include <vector>
+#include <map>
+
+#include <TObject.h>
+#include <TBits.h>
+#include <TString.h>
+
+class AliAnalysisCuts;
+
+class AliDielectronTrackCache : public TObject {
+
+public:
+  AliDielectronTrackCache();
+  virtual ~AliDielectronTrackCache();
+
+  void   NewEvent();
+
+  // stores and result slots are valid for the current event only
+  Int_t  GetStore(const char *configKey);
+  Int_t  GetCutSlot(const char *cutKey);
+  static TString GetCutSignature(const AliAnalysisCuts *cut);
+
+  // track in process
+  void   SetCurrentTrack(Int_t store, const TObject *track, Int_t index);
+  void   ResetCurrentTrack() { fCurrentTrack=0x0; }
+  const TObject* GetCurrentTrack() const { return fCurrentTrack; }
+
+  // values of the current track, computed with all variables used so far
+  TBits* GetVarMap() { return &fVars; }
+  void   AddVariables(const TBits *map);
+  Bool_t HasValues() const;
+  const Double_t* GetValues() const;
+  void   StoreValues(const Double_t *values);
+
+  // cut results of the current track: -1 unknown, 0 rejected, 1 accepted
+  Int_t  GetCutResult(Int_t slot) const;
+  void   SetCutResult(Int_t slot, Bool_t accepted);
+
+  virtual void Print(const Option_t* option = "") const;
+
+private:
+  TBits fVars;                                  // variables computed for each track (union of all fill maps)
+  UInt_t fVersion;                              // incremented when fVars gets a new variable
+  UInt_t fEvent;                                // event counter
+
+  std::map<TString,Int_t> fStoreIds;            //! store per configuration, current event
+  std::map<TString,Int_t> fCutSlots;            //! result slot per cut, current event
+  std::vector<std::vector<Double_t> > fValues;  //! track values per store
+  std::vector<std::vector<ULong64_t> > fStamps; //! event and version the values were computed with
+  std::vector<std::vector<UInt_t> > fResults;   //! 2*event+result per cut slot and track
+
+  Int_t fCurrentStore;                          //! store of the current track
+  const TObject *fCurrentTrack;                 //! current track
+  Int_t fCurrentIndex;                          //! index of the current track in the event
+
+  ULong64_t fNComputed;                         // number of computed tracks
+  mutable ULong64_t fNReused;                   // number of tracks taken from the cache
+  ULong64_t fNCutsEvaluated;                    // number of evaluated cuts
+  mutable ULong64_t fNCutsReused;               // number of cut results taken from the cache
+
+  AliDielectronTrackCache(const AliDielectronTrackCache &c);
+  AliDielectronTrackCache &operator=(const AliDielectronTrackCache &c);
+
+  ClassDef(AliDielectronTrackCache,1)         // per event track values and cut results shared by AliDielectron instances
+};
+
+#endif
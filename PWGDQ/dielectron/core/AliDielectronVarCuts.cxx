@@ -469,3 +469,23 @@ Int_t AliDielectronVarCuts::GetCutLimits(Int_t iCut, Double_t &cutMin, Double_t
 
   return iCut;
 }
+
+//________________________________________________________________________
+Bool_t AliDielectronVarCuts::GetRangeCut(Int_t iCut, Int_t &var, Double_t &cutMin, Double_t &cutMax, Bool_t &exclude) const
+{
+  //
+  // Return variable, limits and inverse logic of the cut at position iCut
+  // if it is a plain range cut on a single variable (no bit, object or operation cut)
+  //
+  if (iCut<0 || iCut > fNActiveCuts-1) return kFALSE;
+  if (fBitCut[iCut] || fUpperCut[iCut]) return kFALSE;
+  if (fVarOperation[iCut]!=kNone) return kFALSE;
+  // second variable of an operation cut
+  if (iCut>0 && fVarOperation[iCut-1]!=kNone) return kFALSE;
+
+  var     = fActiveCuts[iCut];
+  cutMin  = fCutMin[iCut];
+  cutMax  = fCutMax[iCut];
+  exclude = fCutExclude[iCut];
+  return kTRUE;
+}
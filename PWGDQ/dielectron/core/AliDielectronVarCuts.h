@@ -79,6 +79,7 @@ public:
   const char*  GetCutName(Int_t iCut) const;
   Bool_t       IsCutOnVariableX(Int_t iCut, Int_t varNumber) const;
   Int_t        GetCutLimits(Int_t iCut, Double_t &cutMin, Double_t &cutMax) const;
+  Bool_t       GetRangeCut(Int_t iCut, Int_t &var, Double_t &cutMin, Double_t &cutMax, Bool_t &exclude) const;
 
 
  private:
@@ -22,6 +22,8 @@
 //                                                                       //
 ///////////////////////////////////////////////////////////////////////////
 
+#include <TStopwatch.h>
+
 #include "AliDielectronVarManager.h"
 
 ClassImp(AliDielectronVarManager)
@@ -757,6 +759,17 @@ TH3D*           AliDielectronVarManager::fgTRDpidEff[10][4] = {{0x0}};
 TObject*        AliDielectronVarManager::fgLegEffMap           = 0x0;
 TObject*        AliDielectronVarManager::fgPairEffMap          = 0x0;
 TBits*          AliDielectronVarManager::fgFillMap          = 0x0;
+TBits*          AliDielectronVarManager::fgCacheMap         = 0x0;
+Int_t           AliDielectronVarManager::fgCacheVersion     = 0;
+const TObject*  AliDielectronVarManager::fgCacheObject[AliDielectronVarManager::kNCacheSlots] = {0x0};
+Int_t           AliDielectronVarManager::fgCacheObjectVersion[AliDielectronVarManager::kNCacheSlots] = {0};
+Int_t           AliDielectronVarManager::fgCacheNextSlot    = 0;
+Double_t        AliDielectronVarManager::fgCacheValues[AliDielectronVarManager::kNCacheSlots][AliDielectronVarManager::kNMaxValues] = {{0.}};
+AliDielectronTrackCache* AliDielectronVarManager::fgTrackCache = 0x0;
+Bool_t          AliDielectronVarManager::fgUsageReport      = kFALSE;
+ULong64_t       AliDielectronVarManager::fgNRequested[AliDielectronVarManager::kNMaxValues] = {0};
+ULong64_t       AliDielectronVarManager::fgNComputed[AliDielectronVarManager::kNMaxValues]  = {0};
+Double_t        AliDielectronVarManager::fgCost[AliDielectronVarManager::kNMaxValues]       = {0.};
 Double_t        AliDielectronVarManager::fgTRDpidEffCentRanges[10][4] = {{0.0}};
 TString         AliDielectronVarManager::fgQnCalibrationFilePath = "";
 Bool_t          AliDielectronVarManager::fgDoQnV0GainEqualization = kFALSE;
@@ -860,3 +873,178 @@ UInt_t AliDielectronVarManager::GetValueType(const char* valname) {
   }
   return -1;
 }
+
+//________________________________________________________________
+namespace {
+  // variables which are computed from other variables of the same 'values' array
+  // (event variables are copied from the event buffer into the track and pair values)
+  const struct { AliDielectronVarManager::ValueTypes var, prerequisite; } kDependencies[] = {
+    { AliDielectronVarManager::kNFclsTPCfCross,            AliDielectronVarManager::kNFclsTPC           },
+    { AliDielectronVarManager::kNFclsTPCfCross,            AliDielectronVarManager::kNFclsTPCr          },
+    { AliDielectronVarManager::kDistPrimToSecVtxXYMC,      AliDielectronVarManager::kXvPrim             },
+    { AliDielectronVarManager::kDistPrimToSecVtxXYMC,      AliDielectronVarManager::kYvPrim             },
+    { AliDielectronVarManager::kDistPrimToSecVtxXYMC,      AliDielectronVarManager::kXvPrimMCtruth      },
+    { AliDielectronVarManager::kDistPrimToSecVtxXYMC,      AliDielectronVarManager::kYvPrimMCtruth      },
+    { AliDielectronVarManager::kDistPrimToSecVtxZMC,       AliDielectronVarManager::kZvPrim             },
+    { AliDielectronVarManager::kDistPrimToSecVtxZMC,       AliDielectronVarManager::kZvPrimMCtruth      },
+    { AliDielectronVarManager::kOpeningAngleCorr,          AliDielectronVarManager::kOpeningAngle       },
+    { AliDielectronVarManager::kOpeningAngleCorr,          AliDielectronVarManager::kPairDCAabsXY       },
+    { AliDielectronVarManager::kMCorr,                     AliDielectronVarManager::kPairDCAabsXY       },
+    { AliDielectronVarManager::kQnDeltaPhiTrackTPCrpH2,    AliDielectronVarManager::kQnTPCrpH2          },
+    { AliDielectronVarManager::kQnDeltaPhiTrackV0CrpH2,    AliDielectronVarManager::kQnV0CrpH2          },
+    { AliDielectronVarManager::kQnTPCrpH2FlowV2,           AliDielectronVarManager::kQnDeltaPhiTPCrpH2  },
+    { AliDielectronVarManager::kQnV0ArpH2FlowV2,           AliDielectronVarManager::kQnDeltaPhiV0ArpH2  },
+    { AliDielectronVarManager::kQnV0CrpH2FlowV2,           AliDielectronVarManager::kQnDeltaPhiV0CrpH2  },
+    { AliDielectronVarManager::kQnV0rpH2FlowV2,            AliDielectronVarManager::kQnDeltaPhiV0rpH2   },
+    { AliDielectronVarManager::kQnSPDrpH2FlowV2,           AliDielectronVarManager::kQnDeltaPhiSPDrpH2  },
+    { AliDielectronVarManager::kQnDeltaPhiTPCrpH2,         AliDielectronVarManager::kQnTPCrpH2          },
+    { AliDielectronVarManager::kQnDeltaPhiV0ArpH2,         AliDielectronVarManager::kQnV0ArpH2          },
+    { AliDielectronVarManager::kQnDeltaPhiV0CrpH2,         AliDielectronVarManager::kQnV0CrpH2          },
+    { AliDielectronVarManager::kQnDeltaPhiV0rpH2,          AliDielectronVarManager::kQnV0rpH2           },
+    { AliDielectronVarManager::kQnDeltaPhiSPDrpH2,         AliDielectronVarManager::kQnSPDrpH2          },
+    { AliDielectronVarManager::kQnTPCrpH2FlowSPV2,         AliDielectronVarManager::kQnTPCrpH2          },
+    { AliDielectronVarManager::kQnV0ArpH2FlowSPV2,         AliDielectronVarManager::kQnV0AxH2           },
+    { AliDielectronVarManager::kQnV0ArpH2FlowSPV2,         AliDielectronVarManager::kQnV0AyH2           },
+    { AliDielectronVarManager::kQnV0CrpH2FlowSPV2,         AliDielectronVarManager::kQnV0CxH2           },
+    { AliDielectronVarManager::kQnV0CrpH2FlowSPV2,         AliDielectronVarManager::kQnV0CyH2           },
+    { AliDielectronVarManager::kQnV0rpH2FlowSPV2,          AliDielectronVarManager::kQnV0xH2            },
+    { AliDielectronVarManager::kQnV0rpH2FlowSPV2,          AliDielectronVarManager::kQnV0yH2            },
+    { AliDielectronVarManager::kQnSPDrpH2FlowSPV2,         AliDielectronVarManager::kQnSPDxH2           },
+    { AliDielectronVarManager::kQnSPDrpH2FlowSPV2,         AliDielectronVarManager::kQnSPDyH2           },
+    { AliDielectronVarManager::kPairPlaneMagInProZDC,      AliDielectronVarManager::kQnZDCCrpH1         }
+  };
+  const Int_t kNDependencies = sizeof(kDependencies)/sizeof(kDependencies[0]);
+}
+
+//________________________________________________________________
+void AliDielectronVarManager::SetFillMap(TBits *map)
+{
+  //
+  // Set the variables to be filled, the prerequisites of the requested variables are added to the map.
+  // With a value cache or a shared track cache the variables are also added to their maps
+  //
+  fgFillMap=map;
+  if (!map) return;
+  ResolveDependencies(map);
+  if (fgTrackCache) fgTrackCache->AddVariables(map);
+  if (!fgCacheMap || map==fgCacheMap) return;
+  const UInt_t nbits=TMath::Min(map->GetNbits(), (UInt_t)kNMaxValues);
+  for (UInt_t var=map->FirstSetBit(); var<nbits; var=map->FirstSetBit(var+1)) {
+    if (fgCacheMap->TestBitNumber(var)) continue;
+    fgCacheMap->SetBitNumber(var);
+    ++fgCacheVersion;
+  }
+}
+
+//________________________________________________________________
+void AliDielectronVarManager::ResolveDependencies(TBits *map)
+{
+  //
+  // Add the prerequisites of the requested variables to the map
+  //
+  if (!map) return;
+  Bool_t added=kTRUE;
+  while (added) {
+    added=kFALSE;
+    for (Int_t i=0; i<kNDependencies; ++i) {
+      if (!map->TestBitNumber(kDependencies[i].var) || map->TestBitNumber(kDependencies[i].prerequisite)) continue;
+      map->SetBitNumber(kDependencies[i].prerequisite);
+      added=kTRUE;
+    }
+  }
+}
+
+//________________________________________________________________
+void AliDielectronVarManager::SetValueCache(TBits *map)
+{
+  //
+  // Enable the value cache for tracks and pairs (0x0 disables it).
+  // Each object is computed once with the variables of all fill maps seen so far,
+  // which are accumulated in 'map'. The caller resets the cache (ResetValueCache)
+  // whenever a track or pair object is modified; it is reset automatically with a new event.
+  //
+  fgCacheMap=map;
+  ++fgCacheVersion;
+  ResetValueCache();
+  if (map) ResolveDependencies(map);
+}
+
+//________________________________________________________________
+void AliDielectronVarManager::SetUsageReport(Bool_t report)
+{
+  //
+  // Count how often each variable is requested and computed, see PrintUsageReport
+  //
+  fgUsageReport=report;
+  for (Int_t i=0; i<kNMaxValues; ++i) {
+    fgNRequested[i]=0;
+    fgNComputed[i]=0;
+  }
+}
+
+//________________________________________________________________
+void AliDielectronVarManager::CountUsage(const TBits *map, ULong64_t *counter)
+{
+  const UInt_t nbits=TMath::Min(map->GetNbits(), (UInt_t)kNMaxValues);
+  for (UInt_t var=map->FirstSetBit(); var<nbits; var=map->FirstSetBit(var+1)) ++counter[var];
+}
+
+//________________________________________________________________
+Double_t AliDielectronVarManager::TimeFill(const TObject* object, Double_t * const values, Int_t nRepetitions)
+{
+  TStopwatch watch;
+  watch.Start();
+  for (Int_t i=0; i<nRepetitions; ++i) FillObject(object, values);
+  watch.Stop();
+  return watch.RealTime()/nRepetitions;
+}
+
+//________________________________________________________________
+void AliDielectronVarManager::MeasureCost(const TObject *object, Int_t nRepetitions)
+{
+  //
+  // Measure the cost of the variables requested so far (see SetUsageReport) for 'object':
+  // time of a fill with only the variable and its prerequisites requested,
+  // minus the time of a fill without requested variables
+  //
+  if (!object || nRepetitions<1) return;
+  TBits *fillMap=fgFillMap;
+  TBits *cacheMap=fgCacheMap;
+  fgCacheMap=0x0;
+  AliDielectronTrackCache *trackCache=fgTrackCache;
+  fgTrackCache=0x0;
+
+  Double_t values[kNMaxValues]={0.};
+  TBits map(kNMaxValues);
+  fgFillMap=&map;
+  const Double_t base=TimeFill(object, values, nRepetitions);
+  for (Int_t var=0; var<kNMaxValues; ++var) {
+    if (!fgNRequested[var]) continue;
+    map.ResetAllBits();
+    map.SetBitNumber(var);
+    ResolveDependencies(&map);
+    fgCost[var]=TMath::Max(0., TimeFill(object, values, nRepetitions)-base);
+  }
+
+  fgFillMap=fillMap;
+  fgCacheMap=cacheMap;
+  fgTrackCache=trackCache;
+}
+
+//________________________________________________________________
+void AliDielectronVarManager::PrintUsageReport()
+{
+  //
+  // Print for each used variable how often it was requested, how often it
+  // was computed and its cost (if measured with MeasureCost)
+  //
+  printf("%-40s %14s %14s %12s\n","variable","requested","computed","cost (us)");
+  ULong64_t nRequested=0, nComputed=0;
+  for (Int_t var=0; var<kNMaxValues; ++var) {
+    if (!fgNRequested[var] && !fgNComputed[var]) continue;
+    printf("%-40s %14llu %14llu %12.3f\n", fgkParticleNames[var][0], fgNRequested[var], fgNComputed[var], fgCost[var]*1e6);
+    nRequested+=fgNRequested[var];
+    nComputed+=fgNComputed[var];
+  }
+  printf("%-40s %14llu %14llu\n","total",nRequested,nComputed);
+}
@@ -75,6 +75,7 @@
 #include "AliDielectronPID.h"
 #include "AliDielectronHelper.h"
 #include "AliDielectronQnEPcorrection.h"
+#include "AliDielectronTrackCache.h"
 
 #include "AliAnalysisDataContainer.h"
 #include "AliAnalysisManager.h"
@@ -92,6 +93,7 @@
 #include "AliAODMCHeader.h"
 #include "AliTRDgeometry.h"
 #include "assert.h"
+#include <cstring>
 
 class AliVEvent;
 
@@ -806,7 +808,18 @@ public:
   static void InitTRDpidEffHistograms(const Char_t* filename);
   static void SetLegEffMap( TObject *map) { fgLegEffMap=map; }
   static void SetPairEffMap(TObject *map) { fgPairEffMap=map; }
-  static void SetFillMap(   TBits   *map) { fgFillMap=map; }
+  static void SetFillMap(   TBits   *map);
+  static void ResolveDependencies(TBits *map);
+  // value cache: tracks and pairs are computed once with the union of all fill maps
+  static void SetValueCache(TBits *map);
+  static void ResetValueCache() { for (Int_t i=0; i<kNCacheSlots; ++i) fgCacheObject[i]=0x0; }
+  // per event track cache shared by several AliDielectron instances (values of its current track)
+  static void SetTrackCache(AliDielectronTrackCache *cache) { fgTrackCache=cache; if (cache && fgFillMap) cache->AddVariables(fgFillMap); }
+  static AliDielectronTrackCache* GetTrackCache() { return fgTrackCache; }
+  // per variable usage and cost report
+  static void SetUsageReport(Bool_t report=kTRUE);
+  static void MeasureCost(const TObject *object, Int_t nRepetitions=100);
+  static void PrintUsageReport();
   static void SetQnCalibrationFilePath(const Char_t* filename, const Bool_t doV0GainEq, const Bool_t doV0recenter, const Bool_t doTPCrecenter) {
     fgQnCalibrationFilePath = filename;
     fgDoQnV0GainEqualization = doV0GainEq;
@@ -845,7 +858,7 @@ public:
   static AliVEvent* GetCurrentEvent() {return fgEvent;}
 
   static Double_t GetValue(ValueTypes var) {return fgData[var];}
-  static void SetValue(ValueTypes var, Double_t val) { fgData[var]=val; }
+  static void SetValue(ValueTypes var, Double_t val) { fgData[var]=val; ResetValueCache(); }
 
 
 private:
@@ -854,6 +867,11 @@ private:
 
   static Bool_t Req(ValueTypes var) { if(fgFillMap->GetNbits()>kNMaxValues) return kFALSE; // needed for unknown crashes (TBits with high number of bits after calling GetPrimaryVertex in FillVarESDEvent)
     return (fgFillMap ? fgFillMap->TestBitNumber(var) : kTRUE); }
+  static void FillObject(const TObject* object, Double_t * const values);
+  static void FillCached(const TObject* object, Double_t * const values);
+  static void FillFromTrackCache(const TObject* object, Double_t * const values);
+  static void CountUsage(const TBits *map, ULong64_t *counter);
+  static Double_t TimeFill(const TObject* object, Double_t * const values, Int_t nRepetitions);
   static void FillVarESDtrack(const AliESDtrack *particle,           Double_t * const values);
   static void FillVarAODTrack(const AliAODTrack *particle,           Double_t * const values);
   static void FillVarVTrdTrack(const AliVParticle *particle,         Double_t * const values);
@@ -885,6 +903,19 @@ private:
   static TObject         *fgLegEffMap;             // single electron efficiencies
   static TObject         *fgPairEffMap;             // pair efficiencies
   static TBits           *fgFillMap;             // map for requested variable filling
+
+  enum { kNCacheSlots=4 };
+  static TBits           *fgCacheMap;            // variables computed for cached objects (union of the fill maps), 0x0: no cache
+  static Int_t            fgCacheVersion;        // incremented when fgCacheMap gets a new variable
+  static const TObject   *fgCacheObject[kNCacheSlots];   // cached objects
+  static Int_t            fgCacheObjectVersion[kNCacheSlots]; // fgCacheVersion the objects were computed with
+  static Int_t            fgCacheNextSlot;       // next slot to be replaced
+  static Double_t         fgCacheValues[kNCacheSlots][kNMaxValues]; //! values of the cached objects
+  static AliDielectronTrackCache *fgTrackCache;  // shared track cache, 0x0: not used
+  static Bool_t           fgUsageReport;         // count requested and computed variables
+  static ULong64_t        fgNRequested[kNMaxValues];  // number of fills requesting the variable
+  static ULong64_t        fgNComputed[kNMaxValues];   // number of times the variable was computed
+  static Double_t         fgCost[kNMaxValues];        // measured cost per fill (s), see MeasureCost
   static TString          fgQnCalibrationFilePath;  // file path to VZERO/TPC Qn calibrations
   static Bool_t           fgDoQnV0GainEqualization;  // flag for gain equalization of V0 for Qn vector
   static Bool_t           fgDoQnV0Recentering;  // flag for recentering of V0 for Qn vector
@@ -922,8 +953,72 @@ inline void AliDielectronVarManager::Fill(const TObject* object, Double_t * cons
 {
   //
   // Main function to fill all available variables according to the type of particle
+  // with a value cache (SetValueCache) tracks and pairs are computed only once
   //
   if (!object) return;
+  if (fgUsageReport && fgFillMap) CountUsage(fgFillMap, fgNRequested);
+  if (fgTrackCache && fgFillMap && object==fgTrackCache->GetCurrentTrack()) {
+    FillFromTrackCache(object, values);
+    return;
+  }
+  if (fgCacheMap && fgFillMap &&
+      (object->IsA() == AliESDtrack::Class() || object->IsA() == AliAODTrack::Class() || object->IsA() == AliDielectronPair::Class())) {
+    FillCached(object, values);
+    return;
+  }
+  FillObject(object, values);
+  if (fgUsageReport && fgFillMap) CountUsage(fgFillMap, fgNComputed);
+}
+
+inline void AliDielectronVarManager::FillCached(const TObject* object, Double_t * const values)
+{
+  //
+  // Fill the values of a track or pair from the cache, compute them with all variables
+  // used so far (fgCacheMap) if the object is not cached yet
+  //
+  for (Int_t i=0; i<kNCacheSlots; ++i) {
+    if (fgCacheObject[i]!=object || fgCacheObjectVersion[i]!=fgCacheVersion) continue;
+    memcpy(values, fgCacheValues[i], sizeof(Double_t)*kNMaxValues);
+    return;
+  }
+  TBits *fillMap=fgFillMap;
+  fgFillMap=fgCacheMap;
+  FillObject(object, values);   // might fill the legs of a pair through the cache
+  fgFillMap=fillMap;
+  if (fgUsageReport) CountUsage(fgCacheMap, fgNComputed);
+
+  const Int_t slot=fgCacheNextSlot;
+  fgCacheNextSlot=(fgCacheNextSlot+1)%kNCacheSlots;
+  memcpy(fgCacheValues[slot], values, sizeof(Double_t)*kNMaxValues);
+  fgCacheObject[slot]=object;
+  fgCacheObjectVersion[slot]=fgCacheVersion;
+}
+
+inline void AliDielectronVarManager::FillFromTrackCache(const TObject* object, Double_t * const values)
+{
+  //
+  // Fill the values of the current track of the shared track cache, compute them with
+  // all variables used so far by any instance if the track is not cached yet.
+  // Only the track values are shared, the event values are those of the current instance
+  //
+  if (fgTrackCache->HasValues()) {
+    memcpy(values, fgTrackCache->GetValues(), sizeof(Double_t)*kPairMax);
+    for (Int_t i=kPairMax; i<kNMaxValues; ++i) values[i]=fgData[i];
+    return;
+  }
+  TBits *fillMap=fgFillMap;
+  fgFillMap=fgTrackCache->GetVarMap();
+  FillObject(object, values);
+  fgFillMap=fillMap;
+  if (fgUsageReport) CountUsage(fgTrackCache->GetVarMap(), fgNComputed);
+  fgTrackCache->StoreValues(values);
+}
+
+inline void AliDielectronVarManager::FillObject(const TObject* object, Double_t * const values)
+{
+  //
+  // Fill the variables according to the type of particle or event
+  //
   if      (object->IsA() == AliESDtrack::Class())       FillVarESDtrack(static_cast<const AliESDtrack*>(object), values);
   else if (object->IsA() == AliAODTrack::Class())       FillVarAODTrack(static_cast<const AliAODTrack*>(object), values);
   else if (object->IsA() == AliMCParticle::Class())     FillVarMCParticle(static_cast<const AliMCParticle*>(object), values);
@@ -4037,6 +4132,7 @@ inline Double_t AliDielectronVarManager::GetTRDpidEfficiency(Int_t runNo, Double
 inline void AliDielectronVarManager::SetEvent(AliVEvent * const ev)
 {
   fgEvent = ev;
+  ResetValueCache();
   if (fgKFVertex) delete fgKFVertex;
   fgKFVertex=0x0;
   if (!ev) return;
@@ -4047,6 +4143,7 @@ inline void AliDielectronVarManager::SetEvent(AliVEvent * const ev)
 
 inline void AliDielectronVarManager::SetEventData(const Double_t data[AliDielectronVarManager::kNMaxValues])
 {
+  ResetValueCache();
   for (Int_t i=0; i<kNMaxValues;++i) fgData[i]=0.;
   for (Int_t i=kPairMax; i<kNMaxValues;++i) fgData[i]=data[i];
 }
@@ -4088,6 +4185,7 @@ inline void AliDielectronVarManager::SetTPCEventPlane(AliEventplane *const evpla
 {
 
   fgTPCEventPlane = evplane;
+  ResetValueCache();
   FillVarTPCEventPlane(evplane,fgData);
   //  for (Int_t i=0; i<AliDielectronVarManager::kNMaxValues;++i) fgData[i]=0.;
   //  AliDielectronVarManager::Fill(fgEvent, fgData);
@@ -21,6 +21,7 @@
 #include <TDatabasePDG.h>
 #include <TClonesArray.h>
 #include <TList.h>
+#include <TObjArray.h>
 #include <TObjString.h>
 
 //---- ANALYSIS system ----
@@ -28,6 +29,7 @@
 #include "AliAnaParticleHadronCorrelation.h"
 #include "AliCaloTrackReader.h"
 #include "AliCaloTrackParticleCorrelation.h"
+#include "AliCaloTrackMixingPool.h"
 #include "AliFiducialCut.h"
 #include "AliVTrack.h"
 #include "AliVCluster.h"
@@ -73,6 +75,7 @@ fNTrigPtBins(0),                fTrigPtBinLimit(),
 fCorrelVzBin(0),
 fListMixTrackEvents(),          fListMixCaloEvents(),
 fUseMixStoredInReader(0),       fFillNeutralEventMixPool(0),
+fUseCompactMixPool(0),          fMixTrackPools(0),         fMixCaloPools(0),
 fM02MaxCut(0),                  fM02MinCut(0),
 fSelectLeadingHadronAngle(0),   fFillLeadHadOppositeHisto(0),
 fMinLeadHadPhi(0),              fMaxLeadHadPhi(0),
@@ -185,6 +188,7 @@ fhMCPtHbpZTUeLeftCharged(),
 fhMCPtTrigPout(),               fhMCPtAssocDeltaPhi(),
 // Mixing
 fhNEventsTrigger(0),            fhNtracksMB(0),                 fhNclustersMB(0),
+fhMixTrackPoolMemory(0),        fhMixCaloPoolMemory(0),
 fhMixDeltaPhiCharged(0),        fhMixDeltaPhiDeltaEtaCharged(0),
 fhMixXECharged(0),              fhMixXEUeCharged(0),            fhMixHbpXECharged(0),
 fhMixDeltaPhiChargedAssocPtBin(),
@@ -284,6 +288,18 @@ AliAnaParticleHadronCorrelation::~AliAnaParticleHadronCorrelation()
     }
     
     delete[] fListMixCaloEvents;
+    
+    if ( fMixTrackPools )
+    {
+      fMixTrackPools->Delete();
+      delete fMixTrackPools;
+    }
+    
+    if ( fMixCaloPools )
+    {
+      fMixCaloPools->Delete();
+      delete fMixCaloPools;
+    }
   }
 }
 
@@ -1402,6 +1418,37 @@ void AliAnaParticleHadronCorrelation::FillChargedEventMixPool()
   
   fhEventMBBin->Fill(eventBin, GetEventWeight());
   
+  // Compact pool, only the track kinematics are kept
+  if ( fMixTrackPools )
+  {
+    AliCaloTrackMixingPool * mixPool = static_cast<AliCaloTrackMixingPool*>(fMixTrackPools->At(eventBin));
+    
+    mixPool->StartEvent();
+    
+    for(Int_t ipr = 0;ipr < GetCTSTracks()->GetEntriesFast() ; ipr ++ )
+    {
+      AliVTrack * track = (AliVTrack *) (GetCTSTracks()->At(ipr)) ;
+      
+      fTrackVector.SetXYZ(track->Px(),track->Py(),track->Pz());
+      Float_t pt   = fTrackVector.Pt();
+      
+      // Select only hadrons in pt range
+      if ( pt < fMinAssocPt || pt > fMaxAssocPt ) continue ;
+      
+      Int_t i = mixPool->AddParticle(fTrackVector.Mag(), pt, fTrackVector.Eta(), fTrackVector.Phi());
+      mixPool->SetDetectorTag(i, kCTS);
+      if ( track->Charge() > 0 ) mixPool->SetFlags(i, AliCaloTrackMixingPool::kPositive);
+    }
+    
+    fhNtracksMB->Fill(mixPool->GetNParticles(0), eventBin, GetEventWeight());
+    fhMixTrackPoolMemory->Fill(eventBin, mixPool->GetMemoryUsage()/1024.);
+    
+    // Set the event number where the last event was added, to avoid double pool filling
+    GetReader()->SetLastTracksMixedEvent(GetEventNumber());
+    
+    return;
+  }
+  
   TObjArray * mixEventTracks = new TObjArray;
   
   if ( fUseMixStoredInReader )
@@ -1483,6 +1530,49 @@ void AliAnaParticleHadronCorrelation::FillNeutralEventMixPool()
   // Check that the bin exists, if not (bad determination of RP, centrality or vz bin) do nothing
   if ( eventBin < 0 ) return;
   
+  // Compact pool, only the cluster kinematics are kept
+  if ( fMixCaloPools )
+  {
+    AliCaloTrackMixingPool * mixPool = static_cast<AliCaloTrackMixingPool*>(fMixCaloPools->At(eventBin));
+    
+    mixPool->StartEvent();
+    
+    for(Int_t ipr = 0;ipr <  pl->GetEntriesFast() ; ipr ++ )
+    {
+      AliVCluster * calo = (AliVCluster *) (pl->At(ipr)) ;
+      
+      // Remove matched clusters
+      if ( IsTrackMatched( calo, GetReader()->GetInputEvent() ) ) continue ;
+      
+      // Cluster momentum calculation
+      if ( GetReader()->GetDataType() != AliCaloTrackReader::kMC )
+      {
+        calo->GetMomentum(fMomentum,GetVertex(0)) ;
+      }// Assume that come from vertex in straight line
+      else
+      {
+        Double_t vertex[]={0,0,0};
+        calo->GetMomentum(fMomentum,vertex) ;
+      }
+      
+      Float_t pt = fMomentum.Pt();
+      
+      // Select only clusters in pt range
+      if ( pt < fMinAssocPt || pt > fMaxAssocPt ) continue ;
+      
+      Int_t i = mixPool->AddParticle(fMomentum.E(), pt, fMomentum.Eta(), fMomentum.Phi());
+      mixPool->SetDetectorTag(i, kEMCAL);
+    }
+    
+    fhNclustersMB->Fill(mixPool->GetNParticles(0), eventBin, GetEventWeight());
+    fhMixCaloPoolMemory->Fill(eventBin, mixPool->GetMemoryUsage()/1024.);
+    
+    // Set the event number where the last event was added, to avoid double pool filling
+    GetReader()->SetLastCaloMixedEvent(GetEventNumber());
+    
+    return;
+  }
+  
   TObjArray * mixEventCalo = new TObjArray;
   
   if ( fUseMixStoredInReader )
@@ -3752,6 +3842,32 @@ TList *  AliAnaParticleHadronCorrelation::GetCreateOutputObjects()
       }
     }
     
+    // Compact pools, not possible when the pools are shared via the reader
+    // or when the trigger is isolated in the mixed event with the stored objects
+    if ( fUseCompactMixPool && (fUseMixStoredInReader || OnlyIsolated()) )
+    {
+      AliWarning("Compact mixing pool not available with pools stored in reader or isolation, use TList pools");
+      fUseCompactMixPool = kFALSE;
+    }
+    
+    if ( fUseCompactMixPool )
+    {
+      Int_t nbins = GetNCentrBin()*GetNZvertBin()*GetNRPBin();
+      
+      fMixTrackPools = new TObjArray(nbins);
+      fMixTrackPools->SetOwner(kTRUE);
+      for(Int_t bin = 0; bin < nbins; bin++)
+        fMixTrackPools->AddAt(new AliCaloTrackMixingPool(GetNMaxEvMix()), bin);
+      
+      if ( neutralMix )
+      {
+        fMixCaloPools = new TObjArray(nbins);
+        fMixCaloPools->SetOwner(kTRUE);
+        for(Int_t bin = 0; bin < nbins; bin++)
+          fMixCaloPools->AddAt(new AliCaloTrackMixingPool(GetNMaxEvMix()), bin);
+      }
+    }
+    
     // Init the list in the reader if not done previously
     if ( fUseMixStoredInReader )
     {
@@ -3809,6 +3925,32 @@ TList *  AliAnaParticleHadronCorrelation::GetCreateOutputObjects()
       outputContainer->Add(fhNclustersMB);
     }
     
+    if ( fUseCompactMixPool )
+    {
+      fhMixTrackPoolMemory = new TH2F
+      ("hMixTrackPoolMemory",
+       "Allocated memory of track mixing pool per event bin",
+       GetNCentrBin()*GetNZvertBin()*GetNRPBin()+1,0,
+       GetNCentrBin()*GetNZvertBin()*GetNRPBin()+1,
+       200,0,2000) ;
+      fhMixTrackPoolMemory->SetXTitle("event bin");
+      fhMixTrackPoolMemory->SetYTitle("memory (kB)");
+      outputContainer->Add(fhMixTrackPoolMemory);
+      
+      if ( neutralMix )
+      {
+        fhMixCaloPoolMemory = new TH2F
+        ("hMixCaloPoolMemory",
+         "Allocated memory of cluster mixing pool per event bin",
+         GetNCentrBin()*GetNZvertBin()*GetNRPBin()+1,0,
+         GetNCentrBin()*GetNZvertBin()*GetNRPBin()+1,
+         200,0,2000) ;
+        fhMixCaloPoolMemory->SetXTitle("event bin");
+        fhMixCaloPoolMemory->SetYTitle("memory (kB)");
+        outputContainer->Add(fhMixCaloPoolMemory);
+      }
+    }
+    
     if ( ! fFillDeltaPhiDeltaEtaAssocPt )
     {
       fhMixDeltaPhiCharged  = new TH2F
@@ -5123,7 +5265,14 @@ void AliAnaParticleHadronCorrelation::MakeChargedMixCorrelation(AliCaloTrackPart
   
   TList * pool     = 0;
   TList * poolCalo = 0;
-  if ( fUseMixStoredInReader )
+  AliCaloTrackMixingPool * trackPool = 0;
+  AliCaloTrackMixingPool * caloPool  = 0;
+  if ( fMixTrackPools )
+  {
+    trackPool = static_cast<AliCaloTrackMixingPool*>(fMixTrackPools->At(eventBin));
+    if ( neutralMix && fMixCaloPools ) caloPool = static_cast<AliCaloTrackMixingPool*>(fMixCaloPools->At(eventBin));
+  }
+  else if ( fUseMixStoredInReader )
   {
     pool     = GetReader()->GetListWithMixedEventsForTracks(eventBin);
     if ( neutralMix ) poolCalo = GetReader()->GetListWithMixedEventsForCalo  (eventBin);
@@ -5134,18 +5283,23 @@ void AliAnaParticleHadronCorrelation::MakeChargedMixCorrelation(AliCaloTrackPart
     if ( neutralMix ) poolCalo = fListMixCaloEvents [eventBin];
   }
   
-  if ( !pool ) return ;
+  if ( !pool && !trackPool ) return ;
   
-  if ( neutralMix && !poolCalo )
+  if ( neutralMix && !poolCalo && !caloPool )
     AliWarning("Careful, cluster pool not available");
   
+  Int_t nEvents     = trackPool ? trackPool->GetNEvents() : pool->GetSize();
+  Int_t nEventsCalo = 0;
+  if      ( caloPool ) nEventsCalo = caloPool->GetNEvents();
+  else if ( poolCalo ) nEventsCalo = poolCalo->GetSize();
+  
   Double_t ptTrig  = aodParticle->Pt();
   Double_t etaTrig = aodParticle->Eta();
   Double_t phiTrig = aodParticle->Phi();
   if ( phiTrig < 0. ) phiTrig+=TMath::TwoPi();
   
   AliDebug(1,Form("Pool bin %d size %d, trigger trigger pt=%f, phi=%f, eta=%f",
-                  eventBin,pool->GetSize(), ptTrig,phiTrig,etaTrig));
+                  eventBin,nEvents, ptTrig,phiTrig,etaTrig));
   
   Double_t ptAssoc  = -999.;
   Double_t phiAssoc = -999.;
@@ -5158,23 +5312,28 @@ void AliAnaParticleHadronCorrelation::MakeChargedMixCorrelation(AliCaloTrackPart
   Int_t ev0 = 0;
   if ( GetReader()->GetLastTracksMixedEvent() == GetEventNumber() ) ev0 = 1;
   
-  for(Int_t ev=ev0; ev < pool->GetSize(); ev++)
+  for(Int_t ev=ev0; ev < nEvents; ev++)
   {
     //
     // Recover the lists of tracks or clusters
     //
-    TObjArray* bgTracks = static_cast<TObjArray*>(pool->At(ev));
+    TObjArray* bgTracks = 0;
     TObjArray* bgCalo   = 0;
+    Bool_t     caloEvent = kFALSE;
+    
+    if ( pool ) bgTracks = static_cast<TObjArray*>(pool->At(ev));
     
     // Recover the clusters list if requested
-    if ( neutralMix && poolCalo )
+    if ( neutralMix && (poolCalo || caloPool) )
     {
-      if ( pool->GetSize()!=poolCalo->GetSize() )
+      if ( nEvents!=nEventsCalo )
         AliWarning("Different size of calo and track pools");
       
-      bgCalo = static_cast<TObjArray*>(poolCalo->At(ev));
+      if ( poolCalo ) bgCalo = static_cast<TObjArray*>(poolCalo->At(ev));
+      
+      caloEvent = bgCalo || (caloPool && ev < nEventsCalo);
       
-      if ( !bgCalo ) AliDebug(1,Form("Event %d in calo pool not available?",ev));
+      if ( !caloEvent ) AliDebug(1,Form("Event %d in calo pool not available?",ev));
     }
     
     //
@@ -5203,17 +5362,25 @@ void AliAnaParticleHadronCorrelation::MakeChargedMixCorrelation(AliCaloTrackPart
     //
     // Check if the trigger is leading of mixed event
     //
-    Int_t nTracks=bgTracks->GetEntriesFast();
+    Int_t nTracks = trackPool ? trackPool->GetNParticles(ev) : bgTracks->GetEntriesFast();
     
     if ( fMakeNearSideLeading || fMakeAbsoluteLeading )
     {
       Bool_t leading = kTRUE;
       for(Int_t jlead = 0;jlead < nTracks; jlead++ )
       {
-        AliCaloTrackParticle *track = (AliCaloTrackParticle*) bgTracks->At(jlead) ;
-        
-        ptAssoc  = track->Pt();
-        phiAssoc = track->Phi() ;
+        if ( trackPool )
+        {
+          ptAssoc  = trackPool->GetPt (ev)[jlead];
+          phiAssoc = trackPool->GetPhi(ev)[jlead];
+        }
+        else
+        {
+          AliCaloTrackParticle *track = (AliCaloTrackParticle*) bgTracks->At(jlead) ;
+          
+          ptAssoc  = track->Pt();
+          phiAssoc = track->Phi() ;
+        }
         if ( phiAssoc < 0 ) phiAssoc+=TMath::TwoPi();
         
         if ( fMakeNearSideLeading )
@@ -5242,15 +5409,23 @@ void AliAnaParticleHadronCorrelation::MakeChargedMixCorrelation(AliCaloTrackPart
       if ( !neutralMix && fCheckLeadingWithNeutralClusters )
         AliWarning("Leading of clusters requested but no clusters in mixed event");
       
-      if ( neutralMix && fCheckLeadingWithNeutralClusters && bgCalo )
+      if ( neutralMix && fCheckLeadingWithNeutralClusters && caloEvent )
       {
-        Int_t nClusters=bgCalo->GetEntriesFast();
+        Int_t nClusters = caloPool ? caloPool->GetNParticles(ev) : bgCalo->GetEntriesFast();
         for(Int_t jlead = 0;jlead <nClusters; jlead++ )
         {
-          AliCaloTrackParticle *cluster= (AliCaloTrackParticle*) bgCalo->At(jlead) ;
-          
-          ptAssoc  = cluster->Pt();
-          phiAssoc = cluster->Phi() ;
+          if ( caloPool )
+          {
+            ptAssoc  = caloPool->GetPt (ev)[jlead];
+            phiAssoc = caloPool->GetPhi(ev)[jlead];
+          }
+          else
+          {
+            AliCaloTrackParticle *cluster= (AliCaloTrackParticle*) bgCalo->At(jlead) ;
+            
+            ptAssoc  = cluster->Pt();
+            phiAssoc = cluster->Phi() ;
+          }
           if ( phiAssoc < 0 ) phiAssoc+=TMath::TwoPi();
           
           if ( fMakeNearSideLeading )
@@ -5300,13 +5475,22 @@ void AliAnaParticleHadronCorrelation::MakeChargedMixCorrelation(AliCaloTrackPart
     //
     for(Int_t j1 = 0;j1 <nTracks; j1++ )
     {
-      AliCaloTrackParticle *track = (AliCaloTrackParticle*) bgTracks->At(j1) ;
-      
-      if ( !track ) continue;
-      
-      ptAssoc  = track->Pt();
-      etaAssoc = track->Eta();
-      phiAssoc = track->Phi() ;
+      if ( trackPool )
+      {
+        ptAssoc  = trackPool->GetPt (ev)[j1];
+        etaAssoc = trackPool->GetEta(ev)[j1];
+        phiAssoc = trackPool->GetPhi(ev)[j1];
+      }
+      else
+      {
+        AliCaloTrackParticle *track = (AliCaloTrackParticle*) bgTracks->At(j1) ;
+        
+        if ( !track ) continue;
+        
+        ptAssoc  = track->Pt();
+        etaAssoc = track->Eta();
+        phiAssoc = track->Phi() ;
+      }
       if ( phiAssoc < 0 ) phiAssoc+=TMath::TwoPi();
       
       deltaPhi = phiTrig-phiAssoc;
@@ -227,6 +227,9 @@ public:
   void         SwitchOnUseMixStoredInReader()    { fUseMixStoredInReader = kTRUE ; }
   void         SwitchOffUseMixStoredInReader()   { fUseMixStoredInReader = kFALSE; }
   
+  void         SwitchOnCompactMixPool()          { fUseCompactMixPool = kTRUE  ; }
+  void         SwitchOffCompactMixPool()         { fUseCompactMixPool = kFALSE ; }
+  
   void         SwitchOnFillNeutralInMixedEvent() { fFillNeutralEventMixPool = kTRUE  ; }
   void         SwitchOffFillNeutralInMixedEvent(){ fFillNeutralEventMixPool = kFALSE ; }
   
@@ -331,6 +334,14 @@ private:
   
   Bool_t       fFillNeutralEventMixPool;                 ///<  Add clusters to pool if requested.
   
+  Bool_t       fUseCompactMixPool;                       ///<  Store mixed events in AliCaloTrackMixingPool, not with pools in reader or isolation.
+  
+  /// Compact pools of tracks, AliCaloTrackMixingPool, one per event bin.
+  TObjArray *  fMixTrackPools ;                          //!<! [GetNCentrBin()*GetNZvertBin()*GetNRPBin()]
+  
+  /// Compact pools of calo clusters, AliCaloTrackMixingPool, one per event bin.
+  TObjArray *  fMixCaloPools ;                           //!<! [GetNCentrBin()*GetNZvertBin()*GetNRPBin()]
+  
   Float_t      fM02MaxCut   ;                            ///<  Study photon clusters with l0 smaller than cut.
   Float_t      fM02MinCut   ;                            ///<  Study photon clusters with l0 larger than cut.
   
@@ -635,6 +646,8 @@ private:
   TH1I *       fhNEventsTrigger;                         //!<! Number of analyzed triggered events.
   TH2F *       fhNtracksMB;                              //!<! Total number of tracks in MB events.
   TH2F *       fhNclustersMB;                            //!<! Total number of clusters in MB events.
+  TH2F *       fhMixTrackPoolMemory;                     //!<! Allocated memory of compact track mixing pool per event bin.
+  TH2F *       fhMixCaloPoolMemory;                      //!<! Allocated memory of compact cluster mixing pool per event bin.
   TH2F *       fhMixDeltaPhiCharged;                     //!<! Difference of charged particle phi and trigger particle  phi as function of  trigger particle pT.
   TH2F *       fhMixDeltaPhiDeltaEtaCharged;             //!<! Difference of charged particle phi and trigger particle  phi as function eta difference
   TH2F *       fhMixXECharged;                           //!<! xE for mixed event.
@@ -705,7 +718,7 @@ private:
   AliAnaParticleHadronCorrelation & operator = (const AliAnaParticleHadronCorrelation & ph) ;
   
   /// \cond CLASSIMP
-  ClassDef(AliAnaParticleHadronCorrelation,38) ;
+  ClassDef(AliAnaParticleHadronCorrelation,39) ;
   /// \endcond
   
 } ;
@@ -6050,7 +6050,23 @@ void AliAnaParticleIsolation::StudyClustersInCone(AliCaloTrackParticleCorrelatio
     }
   }
   
-  if ( fStudyRCutInCone )
+  // With the cone grid, get the sum for all the R cuts in one pass over the grid cells,
+  // with R limited to the isolation cone size as for the clusters in the reference array
+  Bool_t rCutSumFromGrid = ( fStudyRCutInCone && GetIsolationCut()->IsConeGridUsed() );
+  
+  if ( rCutSumFromGrid )
+  {
+    Float_t rCut[10];
+    for(Int_t icut = 0; icut < fNRCutsInCone; icut++) 
+      rCut[icut] = TMath::Min(fRCutInCone[icut], GetIsolationCut()->GetConeSize());
+    
+    GetIsolationCut()->CalculateSignalInConeForRadii(aodParticle, GetReader(), GetCalorimeter(), GetCaloPID(),
+                                                     fNRCutsInCone, rCut,
+                                                     0x0, 0x0, 0x0,
+                                                     coneptsumClusterPerRCut, 0x0, 0x0,
+                                                     0x0, 0x0, 0x0, 0x0);
+  }
+  else if ( fStudyRCutInCone )
   {
     for(Int_t icut = 0; icut < fNRCutsInCone; icut++) 
     {
@@ -6139,7 +6155,7 @@ void AliAnaParticleIsolation::StudyClustersInCone(AliCaloTrackParticleCorrelatio
       {
         if ( distance < fRCutInCone[icut] ) 
         {
-          coneptsumClusterPerRCut[icut]+=ptcone;
+          if ( !rCutSumFromGrid ) coneptsumClusterPerRCut[icut]+=ptcone;
           fhPtClusterInConePerRCut->Fill(icut+1, ptcone, GetEventWeight()*weightTrig);
         }
       }
@@ -6580,7 +6596,23 @@ void AliAnaParticleIsolation::StudyTracksInCone(AliCaloTrackParticleCorrelation
     }
   }
   
-  if ( fStudyRCutInCone )
+  // With the cone grid, get the sum for all the R cuts in one pass over the grid cells,
+  // with R limited to the isolation cone size as for the tracks in the reference array
+  Bool_t rCutSumFromGrid = ( fStudyRCutInCone && GetIsolationCut()->IsConeGridUsed() );
+  
+  if ( rCutSumFromGrid )
+  {
+    Float_t rCut[10];
+    for(Int_t icut = 0; icut < fNRCutsInCone; icut++) 
+      rCut[icut] = TMath::Min(fRCutInCone[icut], GetIsolationCut()->GetConeSize());
+    
+    GetIsolationCut()->CalculateSignalInConeForRadii(aodParticle, GetReader(), GetCalorimeter(), GetCaloPID(),
+                                                     fNRCutsInCone, rCut,
+                                                     coneptsumTrackPerRCut, 0x0, 0x0,
+                                                     0x0, 0x0, 0x0,
+                                                     0x0, 0x0, 0x0, 0x0);
+  }
+  else if ( fStudyRCutInCone )
   {
     for(Int_t icut = 0; icut < fNRCutsInCone; icut++) 
     {
@@ -6690,7 +6722,7 @@ void AliAnaParticleIsolation::StudyTracksInCone(AliCaloTrackParticleCorrelation
       {
         if ( distance < fRCutInCone[icut] ) 
         {
-          coneptsumTrackPerRCut[icut]+=pTtrack;
+          if ( !rCutSumFromGrid ) coneptsumTrackPerRCut[icut]+=pTtrack;
           fhPtTrackInConePerRCut->Fill(icut+1, pTtrack, GetEventWeight()*weightTrig);
         }
       }
@@ -22,12 +22,14 @@
 #include <TROOT.h>
 #include <TClonesArray.h>
 #include <TObjString.h>
+#include <TObjArray.h>
 #include <TDatabasePDG.h>
 
 //---- AliRoot system ----
 #include "AliAnaPi0.h"
 #include "AliCaloTrackReader.h"
 #include "AliCaloPID.h"
+#include "AliCaloTrackMixingPool.h"
 #include "AliMCEvent.h"
 #include "AliFiducialCut.h"
 #include "AliVEvent.h"
@@ -51,7 +53,8 @@ ClassImp(AliAnaPi0) ;
 /// Default Constructor. Initialized parameters with default values.
 //______________________________________________________
 AliAnaPi0::AliAnaPi0() : AliAnaCaloTrackCorrBaseClass(),
-fEventsList(0x0),
+fEventsList(0x0),            fMixPools(0x0),               fUseCompactMixPool(kFALSE),
+fMixPairMass(0),             fMixPairPt(0),                fMixPairAngle(0),
 fUseAngleCut(kFALSE),        fUseAngleEDepCut(kFALSE),     fAngleCut(0),                 fAngleMaxCut(0.),   fUseOneCellSeparation(kFALSE),
 fMultiCutAna(kFALSE),        fMultiCutAnaSim(kFALSE),      fMultiCutAnaAcc(kFALSE),
 fNPtCuts(0),                 fNAsymCuts(0),                fNCellNCuts(0),               fNPIDBits(0), fNAngleCutBins(0),
@@ -79,7 +82,7 @@ fhRePtNCellAsymCuts(0x0),    fhMiPtNCellAsymCuts(0x0),     fhRePtNCellAsymCutsSM
 fhRePtNCellAsymCutsOpAngle(0x0),    fhMiPtNCellAsymCutsOpAngle(0x0),                     
 fhRePtAsym(0x0),             fhRePtAsymPi0(0x0),           fhRePtAsymEta(0x0),
 fhMiPtAsym(0x0),             fhMiPtAsymPi0(0x0),           fhMiPtAsymEta(0x0),
-fhEventBin(0),               fhEventMixBin(0),
+fhEventBin(0),               fhEventMixBin(0),             fhMixPoolMemory(0),
 fhCentrality(0x0),           fhCentralityNoPair(0x0),
 fhEventPlaneResolution(0x0),
 fhRealOpeningAngle(0x0),     fhRealCosOpeningAngle(0x0),   fhMixedOpeningAngle(0x0),     fhMixedCosOpeningAngle(0x0),
@@ -262,6 +265,12 @@ AliAnaPi0::~AliAnaPi0()
     }
     delete[] fEventsList;
   }
+  
+  if ( fMixPools )
+  {
+    fMixPools->Delete();
+    delete fMixPools;
+  }
 }
 
 //______________________________
@@ -336,6 +345,8 @@ TObjString * AliAnaPi0::GetAnalysisCuts()
   parList+=onePar ;
   snprintf(onePar,buffersize,"Depth of event buffer: %d;",GetNMaxEvMix()) ;
   parList+=onePar ;
+  snprintf(onePar,buffersize,"Compact mixing pool: %d;",fUseCompactMixPool) ;
+  parList+=onePar ;
   snprintf(onePar,buffersize,"Select pairs with their angle: %d, edep %d, min angle %2.3f, max angle %2.3f, 1cell separation %d;",fUseAngleCut, fUseAngleEDepCut,fAngleCut,fAngleMaxCut,fUseOneCellSeparation) ;
   parList+=onePar ;
   snprintf(onePar,buffersize," Asymmetry cuts: n = %d, asymmetry < ",fNAsymCuts) ;
@@ -878,6 +889,17 @@ TList * AliAnaPi0::GetCreateOutputObjects()
       }
     }
   }
+  
+  // Compact pools, same number of events kept as in the TList
+  // buffers, where the last event is removed when reaching GetNMaxEvMix()
+  if ( fUseCompactMixPool )
+  {
+    Int_t nbins = GetNCentrBin()*GetNZvertBin()*GetNRPBin();
+    fMixPools = new TObjArray(nbins);
+    fMixPools->SetOwner(kTRUE);
+    for(Int_t bin = 0; bin < nbins; bin++)
+      fMixPools->AddAt(new AliCaloTrackMixingPool(TMath::Max(1,GetNMaxEvMix()-1)), bin);
+  }
       
   fhRe1 = new TH2F*[GetNCentrBin()*fNPIDBits*fNAsymCuts] ;
   fhMi1 = new TH2F*[GetNCentrBin()*fNPIDBits*fNAsymCuts] ;
@@ -1340,6 +1362,17 @@ TList * AliAnaPi0::GetCreateOutputObjects()
                            GetNCentrBin()*GetNZvertBin()*GetNRPBin()+1) ;
     fhEventMixBin->SetXTitle("bin");
     outputContainer->Add(fhEventMixBin) ;
+    
+    if ( fUseCompactMixPool )
+    {
+      fhMixPoolMemory=new TH2F("hMixPoolMemory","Allocated memory of mixing pool per bin(cen,vz,rp)",
+                               GetNCentrBin()*GetNZvertBin()*GetNRPBin()+1,0,
+                               GetNCentrBin()*GetNZvertBin()*GetNRPBin()+1,
+                               200,0,2000) ;
+      fhMixPoolMemory->SetXTitle("bin");
+      fhMixPoolMemory->SetYTitle("memory (kB)");
+      outputContainer->Add(fhMixPoolMemory) ;
+    }
   }
   
   if ( IsHighMultiplicityAnalysisOn() )
@@ -2768,6 +2801,7 @@ void AliAnaPi0::Print(const Option_t * /*opt*/) const
   printf("Number of bins in Z vert. pos: %d \n",GetNZvertBin()) ;
   printf("Number of bins in Reac. Plain: %d \n",GetNRPBin()) ;
   printf("Depth of event buffer: %d \n",GetNMaxEvMix()) ;
+  printf("Compact mixing pool: %d \n",fUseCompactMixPool) ;
   printf("Pair in same Module: %d \n",fSameSM) ;
   printf("Cuts: \n") ;
   // printf("Z vertex position: -%2.3f < z < %2.3f \n",GetZvertexCut(),GetZvertexCut()) ; //It crashes here, why?
@@ -4805,17 +4839,30 @@ void AliAnaPi0::MakeAnalysisFillHistograms()
     
     TList * evMixList=fEventsList[eventbin] ;
     
-    if ( !evMixList )
+    AliCaloTrackMixingPool * mixPool = 0;
+    if ( fUseCompactMixPool && fMixPools )
+      mixPool = static_cast<AliCaloTrackMixingPool*>(fMixPools->At(eventbin)) ;
+    
+    if ( !evMixList && !mixPool )
     {
       AliWarning(Form("Mix event list not available, bin %d",eventbin));
       return;
     }
     
-    Int_t nMixed = evMixList->GetSize() ;
+    Int_t nMixed = mixPool ? mixPool->GetNEvents() : evMixList->GetSize() ;
     for(Int_t ii=0; ii<nMixed; ii++)
     {
-      TClonesArray* ev2= (TClonesArray*) (evMixList->At(ii));
-      Int_t nPhot2=ev2->GetEntriesFast() ;
+      TClonesArray* ev2 = 0 ;
+      Int_t nPhot2 = 0 ;
+      if ( mixPool )
+      {
+        nPhot2 = mixPool->GetNParticles(ii) ;
+      }
+      else
+      {
+        ev2    = (TClonesArray*) (evMixList->At(ii));
+        nPhot2 = ev2->GetEntriesFast() ;
+      }
       Double_t m = -999;
       AliDebug(1,Form("Mixed event %d photon entries %d, centrality bin %d",ii, nPhot2, GetEventCentralityBin()));
       
@@ -4838,28 +4885,80 @@ void AliAnaPi0::MakeAnalysisFillHistograms()
         fPhotonMom1.SetPxPyPzE(p1->Px(),p1->Py(),p1->Pz(),p1->E());
         module1 = GetModuleNumber(p1);
         
+        // Pair kinematics with all the clusters of the compact mixed event at once
+        if ( mixPool && nPhot2 > 0 )
+          mixPool->PairKinematics(ii, p1->E(), p1->Pt(), p1->Eta(), GetPhi(p1->Phi()),
+                                  fMixPairMass, fMixPairPt, fMixPairAngle);
+        
         //---------------------------------
         // Second loop on other mixed event photons/clusters
         //---------------------------------
         for(Int_t i2 = 0; i2 < nPhot2; i2++)
         {
-          AliCaloTrackParticle * p2 = (AliCaloTrackParticle*) (ev2->At(i2)) ;
+          AliCaloTrackParticle * p2 = 0 ;
           
-          // Select photons within a pT range
-          if ( p2->Pt() < GetMinPt() || p2->Pt()  > GetMaxPt() ) continue ;
+          Double_t pt2  = 0, e2  = 0, pt = 0, angle = 0;
+          Float_t  eta2 = 0, phi2 = 0, time2 = 0;
+          Int_t    absIdMax2 = -1, detector2 = -1, distBad2 = 0, pidBits2 = 0;
+          Bool_t   tagged2 = kFALSE, fidArea2 = kFALSE;
           
-          // Get kinematics of second cluster and calculate those of the pair
-          fPhotonMom2.SetPxPyPzE(p2->Px(),p2->Py(),p2->Pz(),p2->E());
-          m           = (fPhotonMom1+fPhotonMom2).M() ;
-          Double_t pt = (fPhotonMom1 + fPhotonMom2).Pt();
-          Double_t a  = TMath::Abs(p1->E()-p2->E())/(p1->E()+p2->E()) ;
+          if ( mixPool )
+          {
+            // Select photons within a pT range
+            pt2 = mixPool->GetPt(ii)[i2];
+            if ( pt2 < GetMinPt() || pt2  > GetMaxPt() ) continue ;
+            
+            e2        = mixPool->GetE           (ii)[i2];
+            eta2      = mixPool->GetEta         (ii)[i2];
+            phi2      = mixPool->GetPhi         (ii)[i2];
+            time2     = mixPool->GetTime        (ii)[i2];
+            absIdMax2 = mixPool->GetCellAbsIdMax(ii)[i2];
+            detector2 = mixPool->GetDetectorTag (ii)[i2];
+            distBad2  = mixPool->GetDistToBad   (ii)[i2];
+            pidBits2  = mixPool->GetPIDBits     (ii)[i2];
+            tagged2   = mixPool->GetFlags(ii)[i2] & AliCaloTrackMixingPool::kTagged;
+            fidArea2  = mixPool->GetFlags(ii)[i2] & AliCaloTrackMixingPool::kFidArea;
+            module2   = mixPool->GetModule      (ii)[i2];
+            
+            m         = fMixPairMass [i2];
+            pt        = fMixPairPt   [i2];
+            angle     = fMixPairAngle[i2];
+          }
+          else
+          {
+            p2 = (AliCaloTrackParticle*) (ev2->At(i2)) ;
+            
+            // Select photons within a pT range
+            if ( p2->Pt() < GetMinPt() || p2->Pt()  > GetMaxPt() ) continue ;
+            
+            // Get kinematics of second cluster and calculate those of the pair
+            fPhotonMom2.SetPxPyPzE(p2->Px(),p2->Py(),p2->Pz(),p2->E());
+            m         = (fPhotonMom1+fPhotonMom2).M() ;
+            pt        = (fPhotonMom1 + fPhotonMom2).Pt();
+            angle     = fPhotonMom1.Angle(fPhotonMom2.Vect());
+            
+            pt2       = p2->Pt();
+            e2        = p2->E();
+            eta2      = fPhotonMom2.Eta();
+            phi2      = GetPhi(fPhotonMom2.Phi());
+            time2     = p2->GetTime();
+            absIdMax2 = p2->GetCellAbsIdMax();
+            detector2 = p2->GetDetectorTag();
+            distBad2  = p2->DistToBad();
+            tagged2   = p2->IsTagged();
+            fidArea2  = p2->GetFiducialArea() != 0;
+            
+            // In case we want only pairs in same (super) module, check their origin.
+            module2   = GetModuleNumber(p2);
+          }
+          
+          Double_t a  = TMath::Abs(p1->E()-e2)/(p1->E()+e2) ;
           
           // Check if opening angle is too large or too small compared to what is expected
-          Double_t angle   = fPhotonMom1.Angle(fPhotonMom2.Vect());
           if ( fUseAngleEDepCut && 
-              !GetNeutralMesonSelection()->IsAngleInWindow((fPhotonMom1+fPhotonMom2).E(),angle+0.05) )
+              !GetNeutralMesonSelection()->IsAngleInWindow(fPhotonMom1.E()+e2,angle+0.05) )
           {
-            AliDebug(2,Form("Mix pair angle %f (deg) not in E %f window",RadToDeg(angle), (fPhotonMom1+fPhotonMom2).E()));
+            AliDebug(2,Form("Mix pair angle %f (deg) not in E %f window",RadToDeg(angle), fPhotonMom1.E()+e2));
             continue;
           }
           
@@ -4871,7 +4970,7 @@ void AliAnaPi0::MakeAnalysisFillHistograms()
 
           if ( fUseOneCellSeparation )
           {
-            Bool_t separation = CheckSeparation(p1->GetCellAbsIdMax() ,p2->GetCellAbsIdMax());
+            Bool_t separation = CheckSeparation(p1->GetCellAbsIdMax() ,absIdMax2);
             if ( !separation )
             {
               AliDebug(2,Form("Mix pair one cell separation required and Yes/No %d", separation));
@@ -4879,10 +4978,7 @@ void AliAnaPi0::MakeAnalysisFillHistograms()
             }
           }
           
-          AliDebug(2,Form("Mixed Event: pT: fPhotonMom1 %2.2f, fPhotonMom2 %2.2f; Pair: pT %2.2f, mass %2.3f, a %2.3f",p1->Pt(), p2->Pt(), pt,m,a));
-          
-          // In case we want only pairs in same (super) module, check their origin.
-          module2 = GetModuleNumber(p2);
+          AliDebug(2,Form("Mixed Event: pT: fPhotonMom1 %2.2f, fPhotonMom2 %2.2f; Pair: pT %2.2f, mass %2.3f, a %2.3f",p1->Pt(), pt2, pt,m,a));
                     
           //-------------------------------------------------------------------------------------------------
           // Fill module dependent histograms, put a cut on assymmetry on the first available cut in the array
@@ -4939,10 +5035,9 @@ void AliAnaPi0::MakeAnalysisFillHistograms()
             else
             {
               Float_t phi1 = GetPhi(fPhotonMom1.Phi());
-              Float_t phi2 = GetPhi(fPhotonMom2.Phi());
               Bool_t etaside = 0;
               if (   (p1->GetDetectorTag()==kEMCAL && fPhotonMom1.Eta() < 0) 
-                  || (p2->GetDetectorTag()==kEMCAL && fPhotonMom2.Eta() < 0)) etaside = 1;
+                  || (detector2           ==kEMCAL && eta2             < 0)) etaside = 1;
               
               if      (    phi1 > DegToRad(260) && phi2 > DegToRad(260) && phi1 < DegToRad(280) && phi2 < DegToRad(280))  fhMiSameSectorDCALPHOSMod[0+etaside]->Fill(pt, m, GetEventWeight());
               else if (    phi1 > DegToRad(280) && phi2 > DegToRad(280) && phi1 < DegToRad(300) && phi2 < DegToRad(300))  fhMiSameSectorDCALPHOSMod[2+etaside]->Fill(pt, m, GetEventWeight());
@@ -4967,7 +5062,6 @@ void AliAnaPi0::MakeAnalysisFillHistograms()
             else // PHOS and DCal in same sector
             {
               Float_t phi1 = GetPhi(fPhotonMom1.Phi());
-              Float_t phi2 = GetPhi(fPhotonMom2.Phi());
               ok=kFALSE;
               if      ( phi1 > DegToRad(260) && phi2 > DegToRad(260) && phi1 < DegToRad(280) && phi2 < DegToRad(280)) ok = kTRUE;
               else if ( phi1 > DegToRad(280) && phi2 > DegToRad(280) && phi1 < DegToRad(300) && phi2 < DegToRad(300)) ok = kTRUE;
@@ -4984,8 +5078,8 @@ void AliAnaPi0::MakeAnalysisFillHistograms()
           // Check if one of the clusters comes from a conversion
           if ( fCheckConversion )
           {
-            if     (p1->IsTagged() && p2->IsTagged()) fhMiConv2->Fill(pt, m, GetEventWeight());
-            else if(p1->IsTagged() || p2->IsTagged()) fhMiConv ->Fill(pt, m, GetEventWeight());
+            if     (p1->IsTagged() && tagged2) fhMiConv2->Fill(pt, m, GetEventWeight());
+            else if(p1->IsTagged() || tagged2) fhMiConv ->Fill(pt, m, GetEventWeight());
           }
           
           //
@@ -4994,7 +5088,9 @@ void AliAnaPi0::MakeAnalysisFillHistograms()
           //
           for(Int_t ipid=0; ipid<fNPIDBits; ipid++)
           {
-            if ( (p1->IsPIDOK(ipid,AliCaloPID::kPhoton)) && (p2->IsPIDOK(ipid,AliCaloPID::kPhoton)) )
+            Bool_t pidOK2 = p2 ? p2->IsPIDOK(ipid,AliCaloPID::kPhoton) : AliCaloTrackMixingPool::IsPIDOK(pidBits2,ipid);
+            
+            if ( (p1->IsPIDOK(ipid,AliCaloPID::kPhoton)) && pidOK2 )
             {
               for(Int_t iasym=0; iasym < fNAsymCuts; iasym++)
               {
@@ -5011,13 +5107,13 @@ void AliAnaPi0::MakeAnalysisFillHistograms()
                   
                   if ( fFillBadDistHisto )
                   {
-                    if ( p1->DistToBad()>0 && p2->DistToBad()>0 )
+                    if ( p1->DistToBad()>0 && distBad2>0 )
                     {
                       fhMi2[index]->Fill(pt, m, GetEventWeight()) ;
                       if ( fMakeInvPtPlots )
                         fhMiInvPt2[index]->Fill(pt, m, 1./pt * GetEventWeight()) ;
                       
-                      if ( p1->DistToBad()>1 && p2->DistToBad()>1 )
+                      if ( p1->DistToBad()>1 && distBad2>1 )
                       {
                         fhMi3[index]->Fill(pt, m, GetEventWeight()) ;
                         if ( fMakeInvPtPlots )
@@ -5048,8 +5144,8 @@ void AliAnaPi0::MakeAnalysisFillHistograms()
                 {
                   Int_t index = ((ipt*fNCellNCuts)+icell)*fNAsymCuts + iasym;
                   
-                  if(p1->Pt() >   fPtCuts[ipt]      && p2->Pt() > fPtCuts[ipt]      &&
-                     p1->Pt() <   fPtCutsMax[ipt]   && p2->Pt() < fPtCutsMax[ipt]   &&
+                  if(p1->Pt() >   fPtCuts[ipt]      && pt2      > fPtCuts[ipt]      &&
+                     p1->Pt() <   fPtCutsMax[ipt]   && pt2      < fPtCutsMax[ipt]   &&
                      a        <   fAsymCuts[iasym]                                  &&
                      ncell1   >=  fCellNCuts[icell] && ncell2   >= fCellNCuts[icell] 
                      )
@@ -5089,24 +5185,24 @@ void AliAnaPi0::MakeAnalysisFillHistograms()
             
             if ( angleBin >= 0 && angleBin < fNAngleCutBins )
             {
-              Float_t e1   = fPhotonMom1.E();
-              Float_t e2   = fPhotonMom2.E();
+              Float_t eMax   = fPhotonMom1.E();
+              Float_t eMin   = e2;
               
-              Float_t t1   = p1->GetTime();
-              Float_t t2   = p2->GetTime();
+              Float_t tMax   = p1->GetTime();
+              Float_t tMin   = time2;
               
-              Int_t nc1    = ncell1;
-              Int_t nc2    = ncell2;
+              Int_t   ncMax  = ncell1;
+              Int_t   ncMin  = ncell2;
               
-              Float_t eta1 = fPhotonMom1.Eta(); 
-              Float_t eta2 = fPhotonMom2.Eta(); 
+              Float_t etaMax = fPhotonMom1.Eta(); 
+              Float_t etaMin = eta2; 
               
-              Float_t phi1 = GetPhi(fPhotonMom1.Phi());
-              Float_t phi2 = GetPhi(fPhotonMom2.Phi());
-              
-              Int_t   mod1 = module1;
-              Int_t   mod2 = module2;
+              Float_t phiMax = GetPhi(fPhotonMom1.Phi());
+              Float_t phiMin = phi2;
               
+              Int_t   modMax = module1;
+              Int_t   modMin = module2;
+
               //              // Recover original cluster
               //              Int_t iclus1 = -1, iclus2 = -1 ;
               //              AliVCluster * cluster1 = FindCluster(GetEMCALClusters(),p1->GetCaloLabel(0),iclus1);
@@ -5116,49 +5212,49 @@ void AliAnaPi0::MakeAnalysisFillHistograms()
               //              Int_t absIdMax1 = GetCaloUtils()->GetMaxEnergyCell(GetEMCALCells(),cluster1,maxCellFraction1);
               //              Int_t absIdMax2 = GetCaloUtils()->GetMaxEnergyCell(GetEMCALCells(),cluster2,maxCellFraction2);
               
-              if ( e2 > e1 )
+              if ( eMin > eMax )
               {
-                e1   = fPhotonMom2.E();
-                e2   = fPhotonMom1.E();
+                eMax   = e2;
+                eMin   = fPhotonMom1.E();
                 
-                t1   = p2->GetTime();
-                t2   = p1->GetTime();
+                tMax   = time2;
+                tMin   = p1->GetTime();
                 
-                nc1  = ncell2;
-                nc2  = ncell1;
+                ncMax  = ncell2;
+                ncMin  = ncell1;
                 
-                eta1 = fPhotonMom2.Eta(); 
-                eta2 = fPhotonMom1.Eta(); 
+                etaMax = eta2; 
+                etaMin = fPhotonMom1.Eta(); 
                 
-                phi1 = GetPhi(fPhotonMom2.Phi());
-                phi2 = GetPhi(fPhotonMom1.Phi());
+                phiMax = phi2;
+                phiMin = GetPhi(fPhotonMom1.Phi());
                 
-                mod1 = module2;
-                mod2 = module1;
+                modMax = module2;
+                modMin = module1;
                 
                 //                Int_t tmp = absIdMax2;
                 //                absIdMax2 = absIdMax1;
                 //                absIdMax1 = tmp;
               }
               
-              fhMiOpAngleBinMinClusterEPerSM[angleBin]->Fill(e2,mod2,GetEventWeight()) ; 
-              fhMiOpAngleBinMaxClusterEPerSM[angleBin]->Fill(e1,mod1,GetEventWeight()) ; 
+              fhMiOpAngleBinMinClusterEPerSM[angleBin]->Fill(eMin,modMin,GetEventWeight()) ; 
+              fhMiOpAngleBinMaxClusterEPerSM[angleBin]->Fill(eMax,modMax,GetEventWeight()) ; 
               
-              fhMiOpAngleBinMinClusterTimePerSM[angleBin]->Fill(t2,mod2,GetEventWeight()) ; 
-              fhMiOpAngleBinMaxClusterTimePerSM[angleBin]->Fill(t1,mod1,GetEventWeight()) ; 
+              fhMiOpAngleBinMinClusterTimePerSM[angleBin]->Fill(tMin,modMin,GetEventWeight()) ; 
+              fhMiOpAngleBinMaxClusterTimePerSM[angleBin]->Fill(tMax,modMax,GetEventWeight()) ; 
               
-              fhMiOpAngleBinMinClusterNCellPerSM[angleBin]->Fill(nc2,mod2,GetEventWeight()) ; 
-              fhMiOpAngleBinMaxClusterNCellPerSM[angleBin]->Fill(nc1,mod1,GetEventWeight()) ; 
+              fhMiOpAngleBinMinClusterNCellPerSM[angleBin]->Fill(ncMin,modMin,GetEventWeight()) ; 
+              fhMiOpAngleBinMaxClusterNCellPerSM[angleBin]->Fill(ncMax,modMax,GetEventWeight()) ; 
               
               fhMiOpAngleBinPairClusterMass[angleBin]->Fill(pt,m,GetEventWeight()) ;
-              if ( mod2 == mod1 )
-                fhMiOpAngleBinPairClusterMassPerSM[angleBin]->Fill(m,mod1,GetEventWeight()) ;
+              if ( modMin == modMax )
+                fhMiOpAngleBinPairClusterMassPerSM[angleBin]->Fill(m,modMax,GetEventWeight()) ;
               
-              if ( e1 > 0.01 )
-                fhMiOpAngleBinPairClusterRatioPerSM[angleBin]->Fill(e2/e1,mod1,GetEventWeight()) ;  
+              if ( eMax > 0.01 )
+                fhMiOpAngleBinPairClusterRatioPerSM[angleBin]->Fill(eMin/eMax,modMax,GetEventWeight()) ;  
               
-              fhMiOpAngleBinMinClusterEtaPhi[angleBin]->Fill(eta2,phi2,GetEventWeight()) ;
-              fhMiOpAngleBinMaxClusterEtaPhi[angleBin]->Fill(eta1,phi1,GetEventWeight()) ;
+              fhMiOpAngleBinMinClusterEtaPhi[angleBin]->Fill(etaMin,phiMin,GetEventWeight()) ;
+              fhMiOpAngleBinMaxClusterEtaPhi[angleBin]->Fill(etaMax,phiMax,GetEventWeight()) ;
               
               //              Int_t   icol1 = -1, icol2 = -1, icolAbs1 = -1, icolAbs2 = -1;
               //              Int_t   irow1 = -1, irow2 = -1, irowAbs1 = -1, irowAbs2 = -1;
@@ -5184,10 +5280,10 @@ void AliAnaPi0::MakeAnalysisFillHistograms()
           // Check cell time content in cluster
           if ( fFillSecondaryCellTiming )
           {
-            if      ( p1->GetFiducialArea() == 0 && p2->GetFiducialArea() == 0 )
+            if      ( p1->GetFiducialArea() == 0 && !fidArea2 )
               fhMiSecondaryCellInTimeWindow ->Fill(pt, m, GetEventWeight());
             
-            else if ( p1->GetFiducialArea() != 0 && p2->GetFiducialArea() != 0 )
+            else if ( p1->GetFiducialArea() != 0 &&  fidArea2 )
               fhMiSecondaryCellOutTimeWindow->Fill(pt, m, GetEventWeight());
           }
                   
@@ -5199,25 +5295,48 @@ void AliAnaPi0::MakeAnalysisFillHistograms()
     // Add the current event to the list of events for mixing
     //--------------------------------------------------------
     
-    //TClonesArray *currentEvent = new TClonesArray(*GetInputAODBranch());
-    TClonesArray *currentEvent = new TClonesArray(*secondLoopInputData);
-    
-    // Add current event to buffer and Remove redundant events
-    if ( currentEvent->GetEntriesFast() > 0 )
+    if ( mixPool )
     {
-      evMixList->AddFirst(currentEvent) ;
-      currentEvent = 0 ; //Now list of particles belongs to buffer and it will be deleted with buffer
-      if ( evMixList->GetSize() >= GetNMaxEvMix() )
+      // Only the particles in the pT range are stored, the others are not mixed.
+      // Empty events are not stored, as with the TList buffer.
+      if ( secondLoopInputData->GetEntriesFast() > 0 )
       {
-        TClonesArray * tmp = (TClonesArray*) (evMixList->Last()) ;
-        evMixList->RemoveLast() ;
-        delete tmp ;
+        mixPool->StartEvent();
+        
+        for(Int_t i2 = 0; i2 < secondLoopInputData->GetEntriesFast(); i2++)
+        {
+          AliCaloTrackParticle * p2 = (AliCaloTrackParticle*) (secondLoopInputData->At(i2)) ;
+          
+          if ( p2->Pt() < GetMinPt() || p2->Pt()  > GetMaxPt() ) continue ;
+          
+          mixPool->AddParticle(p2, GetModuleNumber(p2), AliCaloPID::kPhoton);
+        }
+        
+        fhMixPoolMemory->Fill(eventbin, mixPool->GetMemoryUsage()/1024.);
       }
     }
     else
-    { // empty event
-      delete currentEvent ;
-      currentEvent=0 ;
+    {
+      //TClonesArray *currentEvent = new TClonesArray(*GetInputAODBranch());
+      TClonesArray *currentEvent = new TClonesArray(*secondLoopInputData);
+      
+      // Add current event to buffer and Remove redundant events
+      if ( currentEvent->GetEntriesFast() > 0 )
+      {
+        evMixList->AddFirst(currentEvent) ;
+        currentEvent = 0 ; //Now list of particles belongs to buffer and it will be deleted with buffer
+        if ( evMixList->GetSize() >= GetNMaxEvMix() )
+        {
+          TClonesArray * tmp = (TClonesArray*) (evMixList->Last()) ;
+          evMixList->RemoveLast() ;
+          delete tmp ;
+        }
+      }
+      else
+      { // empty event
+        delete currentEvent ;
+        currentEvent=0 ;
+      }
     }
   }// DoOwnMix
   
@@ -29,6 +29,8 @@ class TList;
 class TH3F ;
 class TH2F ;
 class TObjString;
+class TObjArray;
+#include <TArrayF.h>
 
 // Analysis
 #include "AliAnaCaloTrackCorrBaseClass.h"
@@ -160,6 +162,13 @@ class AliAnaPi0 : public AliAnaCaloTrackCorrBaseClass {
   void         SetOtherDetectorInputName(TString name)
   { fOtherDetectorInputName = name ;   if(name != "") SwitchOnPairWithOtherDetector() ; }
 
+  //-------------------------------------------
+  // Mixed event pool storage
+  //-------------------------------------------
+
+  void         SwitchOnCompactMixPool()         { fUseCompactMixPool   = kTRUE  ; }
+  void         SwitchOffCompactMixPool()        { fUseCompactMixPool   = kFALSE ; }
+
   // MC analysis related methods
     
   void         SwitchOnConversionChecker()      { fCheckConversion     = kTRUE  ; }
@@ -191,6 +200,15 @@ class AliAnaPi0 : public AliAnaCaloTrackCorrBaseClass {
 
   /// Containers for photons in stored events
   TList ** fEventsList ;               //![GetNCentrBin()*GetNZvertBin()*GetNRPBin()]
+
+  /// Compact pools of AliCaloTrackMixingPool, one per event bin, used instead of fEventsList
+  TObjArray * fMixPools ;              //!<! [GetNCentrBin()*GetNZvertBin()*GetNRPBin()]
+
+  Bool_t   fUseCompactMixPool ;        ///<  Store mixed events in AliCaloTrackMixingPool instead of TClonesArray copies
+
+  TArrayF  fMixPairMass ;              //!<! Work array, mass of pairs with a mixed event
+  TArrayF  fMixPairPt ;                //!<! Work array, pT of pairs with a mixed event
+  TArrayF  fMixPairAngle ;             //!<! Work array, opening angle of pairs with a mixed event
   
   Bool_t   fUseAngleCut ;              ///<  Select pairs depending on their opening angle
   Bool_t   fUseAngleEDepCut ;          ///<  Select pairs depending on their opening angle
@@ -372,6 +390,7 @@ class AliAnaPi0 : public AliAnaCaloTrackCorrBaseClass {
     
   TH1I *   fhEventBin;                 //!<! Number of real  pairs in a particular bin (cen,vz,rp)
   TH1I *   fhEventMixBin;              //!<! Number of mixed pairs in a particular bin (cen,vz,rp)
+  TH2F *   fhMixPoolMemory;            //!<! Allocated memory of compact mixing pool vs event bin (cen,vz,rp)
   TH1F *   fhCentrality;               //!<! Histogram with centrality bins with at least one pare
   TH1F *   fhCentralityNoPair;         //!<! Histogram with centrality bins with no pair
 
@@ -618,7 +637,7 @@ class AliAnaPi0 : public AliAnaCaloTrackCorrBaseClass {
   AliAnaPi0 & operator = (const AliAnaPi0 & api0) ;
   
   /// \cond CLASSIMP
-  ClassDef(AliAnaPi0,37) ;
+  ClassDef(AliAnaPi0,38) ;
   /// \endcond
   
 } ;
@@ -5200,11 +5200,16 @@ void AliAnalysisTaskGammaConvV1::CalculateBackgroundRP(){
 
   } else {
     // Do Event Mixing
+    // The candidates are first pre-selected in bulk on the photon momenta stored in the pool,
+    // only the remaining ones are built, the (M, pT) histogram is filled in one go at the end
+    std::vector<UChar_t> preSelected;
+    std::vector<Double_t> backMass, backPt, backWeight;
     for(Int_t nEventsInBG=0;nEventsInBG <fBGHandlerRP[fiCut]->GetNBGEvents(fGammaCandidates,fInputEvent);nEventsInBG++){
 
-      AliGammaConversionPhotonVector *previousEventGammas = fBGHandlerRP[fiCut]->GetBGGoodGammas(fGammaCandidates,fInputEvent,nEventsInBG);
+      const AliConversionAODBGHandlerRP::BGEvent *previousEvent = fBGHandlerRP[fiCut]->GetBGEvent(fGammaCandidates,fInputEvent,nEventsInBG);
 
-      if(previousEventGammas){
+      if(previousEvent){
+        const AliGammaConversionPhotonVector *previousEventGammas = &(previousEvent->fPointers);
         // test weighted background
         Double_t weight=1.0;
         // Correct for the number of eventmixing:
@@ -5212,18 +5217,24 @@ void AliAnalysisTaskGammaConvV1::CalculateBackgroundRP(){
         // real combinations (since you cannot combine a photon with its own)
         // but BG leads to N_{a}*N_{b} combinations
         weight*=0.5*(Double_t(fGammaCandidates->GetEntries()-1))/Double_t(previousEventGammas->size());
+        preSelected.resize(previousEvent->GetN());
 
         for(Int_t iCurrent=0;iCurrent<fGammaCandidates->GetEntries();iCurrent++){
 
           AliAODConversionPhoton *gamma0 = (AliAODConversionPhoton*)(fGammaCandidates->At(iCurrent));
+          fiMesonCut->MesonsArePreSelected(gamma0,previousEvent->GetN(),previousEvent->fE.data(),previousEvent->fPx.data(),
+                                           previousEvent->fPy.data(),previousEvent->fPz.data(),fiEventCut->GetEtaShift(),preSelected.data());
 
           for(UInt_t iPrevious=0;iPrevious<previousEventGammas->size();iPrevious++){
+            if(!preSelected[iPrevious]) continue;
             AliAODConversionPhoton *gamma1 = (AliAODConversionPhoton*)(previousEventGammas->at(iPrevious));
             AliAODConversionMother backgroundCandidate(gamma0,gamma1);
             backgroundCandidate.CalculateDistanceOfClossetApproachToPrimVtx(fInputEvent->GetPrimaryVertex());
             if(fiMesonCut->MesonIsSelected(&backgroundCandidate,kFALSE,fiEventCut->GetEtaShift())){
-              if(fDoCentralityFlat > 0) fHistoMotherBackInvMassPt[fiCut]->Fill(backgroundCandidate.M(),backgroundCandidate.Pt(), fWeightCentrality[fiCut]*fWeightJetJetMC);
-              else fHistoMotherBackInvMassPt[fiCut]->Fill(backgroundCandidate.M(),backgroundCandidate.Pt(),fWeightJetJetMC);
+              backMass.push_back(backgroundCandidate.M());
+              backPt.push_back(backgroundCandidate.Pt());
+              if(fDoCentralityFlat > 0) backWeight.push_back(fWeightCentrality[fiCut]*fWeightJetJetMC);
+              else backWeight.push_back(fWeightJetJetMC);
               if(fDoTHnSparse){
 //                              Double_t sparesFill[4] = {backgroundCandidate.M(),backgroundCandidate.Pt(),(Double_t)zbin,(Double_t)mbin};
                   Double_t sparesFill[4] = {backgroundCandidate.M(),backgroundCandidate.Pt(),(Double_t)zbin,(Double_t)psibin};
@@ -5235,6 +5246,7 @@ void AliAnalysisTaskGammaConvV1::CalculateBackgroundRP(){
         }
       }
     }
+    if(backMass.size() > 0) fHistoMotherBackInvMassPt[fiCut]->FillN(backMass.size(),backMass.data(),backPt.data(),backWeight.data());
   }
 }
 
@@ -29,6 +29,7 @@
 #include "AliESDtrackCuts.h"
 #include "AliInputEventHandler.h"
 #include "AliTrackerBase.h"
+#include "AliVHeader.h"
 #include "AliV0ReaderV1.h"
 
 #include "TAxis.h"
@@ -36,6 +37,7 @@
 #include "TH1F.h"
 #include "TF1.h"
 
+#include <algorithm>
 #include <vector>
 #include <map>
 #include <utility>
@@ -44,6 +46,110 @@ class iostream;
 
 using namespace std;
 
+//
+// Tracks of one event propagated to the calorimeter surface, shared by all matchers
+// of the analysis manager with the same cluster type, running mode and mass hypothesis
+//
+struct AliCaloTrackMatcherSurfaceTracks {
+  AliCaloTrackMatcherSurfaceTracks(Int_t clusterType, Int_t runningMode, Double_t mass) :
+    fClusterType(clusterType), fRunningMode(runningMode), fMass(mass),
+    fEntry(-1), fEventID(0), fRunNumber(-1), fNTracks(-1) {}
+
+  Bool_t IsConfig(Int_t clusterType, Int_t runningMode, Double_t mass) const {
+    return fClusterType == clusterType && fRunningMode == runningMode && fMass == mass;
+  }
+
+  static ULong64_t EventID(AliVEvent* event){
+    return event->GetHeader() ? event->GetHeader()->GetEventIdAsLong() : 0;
+  }
+
+  Bool_t IsEvent(AliVEvent* event) const {
+    AliAnalysisManager* man = AliAnalysisManager::GetAnalysisManager();
+    return fEntry == (man ? man->GetCurrentEntry() : -1) && fRunNumber == event->GetRunNumber() &&
+           fNTracks == event->GetNumberOfTracks() && fEventID == EventID(event) && fEntry >= 0;
+  }
+
+  void Reset(AliVEvent* event, Bool_t isAOD){
+    AliAnalysisManager* man = AliAnalysisManager::GetAnalysisManager();
+    fEntry     = man ? man->GetCurrentEntry() : -1;
+    fEventID   = EventID(event);
+    fRunNumber = event->GetRunNumber();
+    fNTracks   = event->GetNumberOfTracks();
+    fPt.clear(); fStatus.clear();
+    fKey.clear(); fID.clear(); fPropPt.clear(); fPos.clear(); fParam.clear();
+    fIDToPos.clear();
+    if(isAOD){
+      for (Int_t iTrack = 0; iTrack < fNTracks; iTrack++){
+        AliVTrack* track = dynamic_cast<AliVTrack*>(event->GetTrack(iTrack));
+        if(track) fIDToPos.push_back(make_pair(track->GetID(),iTrack));
+      }
+      sort(fIDToPos.begin(),fIDToPos.end());
+    }
+  }
+
+  void AddTrack(Float_t pt, Int_t status){
+    fPt.push_back(pt);
+    fStatus.push_back(status);
+  }
+
+  void AddPropagatedTrack(Int_t key, Int_t id, Float_t pt, const AliExternalTrackParam& param, const Double_t* pos){
+    AddTrack(pt,-1);
+    fKey.push_back(key);
+    fID.push_back(id);
+    fPropPt.push_back(pt);
+    fParam.push_back(param);
+    fPos.insert(fPos.end(),pos,pos+3);
+  }
+
+  Int_t     fClusterType;            // cluster type of the matchers
+  Int_t     fRunningMode;            // running mode of the matchers
+  Double_t  fMass;                   // mass hypothesis of the matchers
+  Long64_t  fEntry;                  // entry of the event in the analysis manager
+  ULong64_t fEventID;                // event ID from header
+  Int_t     fRunNumber;              // run number of the event
+  Int_t     fNTracks;                // number of tracks in the event
+
+  vector<Float_t>  fPt;              // pT of all tracks entering the matching, for the control histogram
+  vector<Int_t>    fStatus;          // control histogram bin of rejected tracks, -1 if propagated
+  vector<Int_t>    fKey;             // propagated tracks: position in event (AOD) or ID (ESD), as used in the match tables
+  vector<Int_t>    fID;              // propagated tracks: track ID
+  vector<Float_t>  fPropPt;          // propagated tracks: pT
+  vector<Double_t> fPos;             // propagated tracks: position at calorimeter surface, 3 per track
+  vector<AliExternalTrackParam> fParam; // propagated tracks: parameters at calorimeter surface
+  vector< pair<Int_t,Int_t> > fIDToPos; // AOD only: (track ID, position in event) of all tracks, sorted
+};
+
+namespace {
+  //
+  // Sorts matches by row (cluster ID or track), keeping the matching order within a row
+  //
+  void BuildRows(const vector<Int_t>& rowOfMatch, vector<Int_t>& order, vector<Int_t>& rowID, vector<Int_t>& rowStart){
+    order.resize(rowOfMatch.size());
+    for (UInt_t i = 0; i < order.size(); i++) order[i] = i;
+    stable_sort(order.begin(),order.end(),[&rowOfMatch](Int_t a, Int_t b){ return rowOfMatch[a] < rowOfMatch[b]; });
+    rowID.clear();
+    rowStart.clear();
+    for (UInt_t i = 0; i < order.size(); i++){
+      if(rowID.empty() || rowID.back() != rowOfMatch[order[i]]){
+        rowID.push_back(rowOfMatch[order[i]]);
+        rowStart.push_back(i);
+      }
+    }
+    rowStart.push_back(order.size());
+  }
+
+  //
+  // Grid cells of size cellSize in x, y and z
+  //
+  Long64_t GridIndex(Double_t x, Double_t cellSize){
+    return (Long64_t)TMath::Floor(x/cellSize) + (1 << 20);
+  }
+
+  Long64_t GridCell(Long64_t ix, Long64_t iy, Long64_t iz){
+    return (ix << 42) | (iy << 21) | iz;
+  }
+}
+
 
 ClassImp(AliCaloTrackMatcher)
 
@@ -60,11 +166,28 @@ AliCaloTrackMatcher::AliCaloTrackMatcher(const char *name, Int_t clusterType, In
   fGeomEMCAL(NULL),
   fGeomPHOS(NULL),
   fArrClusters(NULL),
-  fMapTrackToCluster(),
-  fMapClusterToTrack(),
-  fNEntries(1),
+  fSurfaceTracks(0x0),
+  fOwnSurfaceTracks(kFALSE),
+  fClusters(),
+  fClusterPos(),
+  fClusterCells(),
+  fClusterCandidates(),
+  fMatchTrack(),
+  fMatchTrackID(),
+  fMatchCluster(),
   fVectorDeltaEtaDeltaPhi(0),
-  fMap_TrID_ClID_ToIndex(),
+  fMatchOrder(),
+  fClusterRowID(),
+  fClusterRowStart(),
+  fClusterToTrack(),
+  fClusterToTrackID(),
+  fClusterToTrackDEta(),
+  fClusterToTrackDPhi(),
+  fTrackRowID(),
+  fTrackRowStart(),
+  fTrackToCluster(),
+  fTrackToClusterDEta(),
+  fTrackToClusterDPhi(),
   fSecMapTrackToCluster(),
   fSecMapClusterToTrack(),
   fSecNEntries(1),
@@ -87,10 +210,7 @@ AliCaloTrackMatcher::AliCaloTrackMatcher(const char *name, Int_t clusterType, In
 //________________________________________________________________________
 AliCaloTrackMatcher::~AliCaloTrackMatcher(){
     // default deconstructor
-    fMapTrackToCluster.clear();
-    fMapClusterToTrack.clear();
-    fVectorDeltaEtaDeltaPhi.clear();
-    fMap_TrID_ClID_ToIndex.clear();
+    ClearMatches();
 
     fSecMapTrackToCluster.clear();
     fSecMapClusterToTrack.clear();
@@ -98,6 +218,8 @@ AliCaloTrackMatcher::~AliCaloTrackMatcher(){
     fSecMap_TrID_ClID_ToIndex.clear();
     fSecMap_TrID_ClID_AlreadyTried.clear();
 
+    if(fOwnSurfaceTracks) delete fSurfaceTracks;
+
     if(fHistControlMatches) delete fHistControlMatches;
     if(fSecHistControlMatches) delete fSecHistControlMatches;
     if(fAnalysisTrainMode.EqualTo("Grid")){
@@ -109,10 +231,7 @@ AliCaloTrackMatcher::~AliCaloTrackMatcher(){
 
 //________________________________________________________________________
 void AliCaloTrackMatcher::Terminate(Option_t *){
-  fMapTrackToCluster.clear();
-  fMapClusterToTrack.clear();
-  fVectorDeltaEtaDeltaPhi.clear();
-  fMap_TrID_ClID_ToIndex.clear();
+  ClearMatches();
 
   fSecMapTrackToCluster.clear();
   fSecMapClusterToTrack.clear();
@@ -168,11 +287,7 @@ void AliCaloTrackMatcher::UserCreateOutputObjects(){
 //________________________________________________________________________
 void AliCaloTrackMatcher::Initialize(Int_t runNumber){
   // Initialize function to be called once before analysis
-  fMapTrackToCluster.clear();
-  fMapClusterToTrack.clear();
-  fNEntries = 1;
-  fVectorDeltaEtaDeltaPhi.clear();
-  fMap_TrID_ClID_ToIndex.clear();
+  ClearMatches();
 
   fSecMapTrackToCluster.clear();
   fSecMapClusterToTrack.clear();
@@ -211,6 +326,26 @@ void AliCaloTrackMatcher::UserExec(Option_t *){
   return;
 }
 
+//________________________________________________________________________
+AliCaloTrackMatcherSurfaceTracks* AliCaloTrackMatcher::GetSurfaceTracks(){
+  // tracks propagated to the calorimeter surface: owned by the first matcher of the analysis manager
+  // with this cluster type, running mode and mass hypothesis, the other ones use the same object
+  if(fSurfaceTracks) return fSurfaceTracks;
+  AliAnalysisManager* man = AliAnalysisManager::GetAnalysisManager();
+  TObjArray* tasks = man ? man->GetTasks() : 0x0;
+  for (Int_t i = 0; tasks && i < tasks->GetEntriesFast(); i++){
+    AliCaloTrackMatcher* matcher = dynamic_cast<AliCaloTrackMatcher*>(tasks->At(i));
+    if(!matcher || matcher == this || !matcher->fOwnSurfaceTracks) continue;
+    if(matcher->fSurfaceTracks->IsConfig(fClusterType,fRunningMode,fMassHypothesis)){
+      fSurfaceTracks = matcher->fSurfaceTracks;
+      return fSurfaceTracks;
+    }
+  }
+  fSurfaceTracks = new AliCaloTrackMatcherSurfaceTracks(fClusterType,fRunningMode,fMassHypothesis);
+  fOwnSurfaceTracks = kTRUE;
+  return fSurfaceTracks;
+}
+
 //________________________________________________________________________
 void AliCaloTrackMatcher::ProcessEvent(AliVEvent *event){
   Int_t nClus = 0;
@@ -288,199 +423,190 @@ void AliCaloTrackMatcher::ProcessEvent(AliVEvent *event){
     }
   }
 
-  for (Int_t itr=0;itr<event->GetNumberOfTracks();itr++){
-    AliExternalTrackParam *trackParam = 0;
-    AliVTrack *inTrack = 0x0;
-    if(esdev){
-      inTrack = esdev->GetTrack(itr);
-      if(!inTrack) continue;
-      FillfHistControlMatches(0.,inTrack->Pt());
-      AliESDtrack *esdt = dynamic_cast<AliESDtrack*>(inTrack);
-
-      if(fRunningMode == 0){
-        if(TMath::Abs(inTrack->Eta())>0.8 && (fClusterType == 1 || fClusterType == 3  || fClusterType == 4)){FillfHistControlMatches(1.,inTrack->Pt()); continue;}
-        if(TMath::Abs(inTrack->Eta())>0.3 &&  fClusterType == 2 ){FillfHistControlMatches(1.,inTrack->Pt()); continue;}
-        if(inTrack->Pt()<0.5){FillfHistControlMatches(1.,inTrack->Pt()); continue;}
-        if(!EsdTrackCuts->AcceptTrack(esdt)) {FillfHistControlMatches(1.,inTrack->Pt()); continue;}
-      }else if(fRunningMode == 5 || fRunningMode == 6){
-        if(TMath::Abs(inTrack->Eta())>0.8 && (fClusterType == 1 || fClusterType == 3  || fClusterType == 4)){FillfHistControlMatches(1.,inTrack->Pt()); continue;}
-        if(TMath::Abs(inTrack->Eta())>0.3 &&  fClusterType == 2 ){FillfHistControlMatches(1.,inTrack->Pt()); continue;}
-        if(inTrack->Pt()<0.3){FillfHistControlMatches(1.,inTrack->Pt()); continue;}
-
-        if(fRunningMode == 6){
-          if(!EsdTrackCuts->AcceptTrack(esdt)) {FillfHistControlMatches(1.,inTrack->Pt()); continue;}
+  // propagation of the tracks to the calorimeter surface, done once per event for all matchers
+  // with the same cluster type, running mode and mass hypothesis (i.e. differing only in the cluster cut setting)
+  AliCaloTrackMatcherSurfaceTracks& tracks = *GetSurfaceTracks();
+  if(!tracks.IsEvent(event)){
+    tracks.Reset(event, aodev != 0);
+    for (Int_t itr=0;itr<event->GetNumberOfTracks();itr++){
+      AliExternalTrackParam *trackParam = 0;
+      AliVTrack *inTrack = 0x0;
+      if(esdev){
+        inTrack = esdev->GetTrack(itr);
+        if(!inTrack) continue;
+        AliESDtrack *esdt = dynamic_cast<AliESDtrack*>(inTrack);
+
+        if(fRunningMode == 0){
+          if(TMath::Abs(inTrack->Eta())>0.8 && (fClusterType == 1 || fClusterType == 3  || fClusterType == 4)){tracks.AddTrack(inTrack->Pt(),1); continue;}
+          if(TMath::Abs(inTrack->Eta())>0.3 &&  fClusterType == 2 ){tracks.AddTrack(inTrack->Pt(),1); continue;}
+          if(inTrack->Pt()<0.5){tracks.AddTrack(inTrack->Pt(),1); continue;}
+          if(!EsdTrackCuts->AcceptTrack(esdt)) {tracks.AddTrack(inTrack->Pt(),1); continue;}
+        }else if(fRunningMode == 5 || fRunningMode == 6){
+          if(TMath::Abs(inTrack->Eta())>0.8 && (fClusterType == 1 || fClusterType == 3  || fClusterType == 4)){tracks.AddTrack(inTrack->Pt(),1); continue;}
+          if(TMath::Abs(inTrack->Eta())>0.3 &&  fClusterType == 2 ){tracks.AddTrack(inTrack->Pt(),1); continue;}
+          if(inTrack->Pt()<0.3){tracks.AddTrack(inTrack->Pt(),1); continue;}
+
+          if(fRunningMode == 6){
+            if(!EsdTrackCuts->AcceptTrack(esdt)) {tracks.AddTrack(inTrack->Pt(),1); continue;}
+          }
         }
-      }
 
-      const AliExternalTrackParam *in = esdt->GetInnerParam();
-      if (!in){AliDebug(2, "Could not get InnerParam of Track, continue"); FillfHistControlMatches(1.,inTrack->Pt()); continue;}
-      trackParam = new AliExternalTrackParam(*in);
-    } else if(aodev) {
-      inTrack = dynamic_cast<AliVTrack*>(aodev->GetTrack(itr));
-      if(!inTrack) continue;
-      FillfHistControlMatches(0.,inTrack->Pt());
-      AliAODTrack *aodt = dynamic_cast<AliAODTrack*>(inTrack);
-
-      if(fRunningMode == 0){
-        if(inTrack->GetID()<0){FillfHistControlMatches(1.,inTrack->Pt()); continue;} // Avoid double counting of tracks
-        if(TMath::Abs(inTrack->Eta())>0.8 && (fClusterType == 1 || fClusterType == 3  || fClusterType == 4)){FillfHistControlMatches(1.,inTrack->Pt()); continue;}
-        if(TMath::Abs(inTrack->Eta())>0.3 &&  fClusterType == 2 ){FillfHistControlMatches(1.,inTrack->Pt()); continue;}
-        if(inTrack->Pt()<0.5){FillfHistControlMatches(1.,inTrack->Pt()); continue;}
-        if(!aodt->IsHybridGlobalConstrainedGlobal()){FillfHistControlMatches(1.,inTrack->Pt()); continue;}
-      }else if(fRunningMode == 5 || fRunningMode == 6){
-        if(inTrack->GetID()<0){FillfHistControlMatches(1.,inTrack->Pt()); continue;} // Avoid double counting of tracks
-        if(TMath::Abs(inTrack->Eta())>0.8 && (fClusterType == 1 || fClusterType == 3  || fClusterType == 4)){FillfHistControlMatches(1.,inTrack->Pt()); continue;}
-        if(TMath::Abs(inTrack->Eta())>0.3 &&  fClusterType == 2 ){FillfHistControlMatches(1.,inTrack->Pt()); continue;}
-        if(inTrack->Pt()<0.3){FillfHistControlMatches(1.,inTrack->Pt()); continue;}
-
-        if(fRunningMode == 6){
-          if(!aodt->IsHybridGlobalConstrainedGlobal()){FillfHistControlMatches(1.,inTrack->Pt()); continue;}
+        const AliExternalTrackParam *in = esdt->GetInnerParam();
+        if (!in){AliDebug(2, "Could not get InnerParam of Track, continue"); tracks.AddTrack(inTrack->Pt(),1); continue;}
+        trackParam = new AliExternalTrackParam(*in);
+      } else if(aodev) {
+        inTrack = dynamic_cast<AliVTrack*>(aodev->GetTrack(itr));
+        if(!inTrack) continue;
+        AliAODTrack *aodt = dynamic_cast<AliAODTrack*>(inTrack);
+
+        if(fRunningMode == 0){
+          if(inTrack->GetID()<0){tracks.AddTrack(inTrack->Pt(),1); continue;} // Avoid double counting of tracks
+          if(TMath::Abs(inTrack->Eta())>0.8 && (fClusterType == 1 || fClusterType == 3  || fClusterType == 4)){tracks.AddTrack(inTrack->Pt(),1); continue;}
+          if(TMath::Abs(inTrack->Eta())>0.3 &&  fClusterType == 2 ){tracks.AddTrack(inTrack->Pt(),1); continue;}
+          if(inTrack->Pt()<0.5){tracks.AddTrack(inTrack->Pt(),1); continue;}
+          if(!aodt->IsHybridGlobalConstrainedGlobal()){tracks.AddTrack(inTrack->Pt(),1); continue;}
+        }else if(fRunningMode == 5 || fRunningMode == 6){
+          if(inTrack->GetID()<0){tracks.AddTrack(inTrack->Pt(),1); continue;} // Avoid double counting of tracks
+          if(TMath::Abs(inTrack->Eta())>0.8 && (fClusterType == 1 || fClusterType == 3  || fClusterType == 4)){tracks.AddTrack(inTrack->Pt(),1); continue;}
+          if(TMath::Abs(inTrack->Eta())>0.3 &&  fClusterType == 2 ){tracks.AddTrack(inTrack->Pt(),1); continue;}
+          if(inTrack->Pt()<0.3){tracks.AddTrack(inTrack->Pt(),1); continue;}
+
+          if(fRunningMode == 6){
+            if(!aodt->IsHybridGlobalConstrainedGlobal()){tracks.AddTrack(inTrack->Pt(),1); continue;}
+          }
         }
-      }
 
-      Double_t xyz[3] = {0}, pxpypz[3] = {0}, cv[21] = {0};
-      aodt->GetPxPyPz(pxpypz);
-      aodt->GetXYZ(xyz);
-      aodt->GetCovarianceXYZPxPyPz(cv);
+        Double_t xyz[3] = {0}, pxpypz[3] = {0}, cv[21] = {0};
+        aodt->GetPxPyPz(pxpypz);
+        aodt->GetXYZ(xyz);
+        aodt->GetCovarianceXYZPxPyPz(cv);
 
-      // check for EMC tracks already propagated tracks are out of bounds
-      if (fClusterType == 1 || fClusterType == 3 || fClusterType == 4){
-        if( TMath::Abs(aodt->GetTrackEtaOnEMCal()) > 0.75 ){FillfHistControlMatches(1.,inTrack->Pt()); continue;}
+        // check for EMC tracks already propagated tracks are out of bounds
+        if (fClusterType == 1 || fClusterType == 3 || fClusterType == 4){
+          if( TMath::Abs(aodt->GetTrackEtaOnEMCal()) > 0.75 ){tracks.AddTrack(inTrack->Pt(),1); continue;}
 
-        // conditions for run1
-        if( fClusterType == 1 && nModules < 13 && ( aodt->GetTrackPhiOnEMCal() < 70*TMath::DegToRad() || aodt->GetTrackPhiOnEMCal() > 190*TMath::DegToRad())){FillfHistControlMatches(1.,inTrack->Pt()); continue;}
+          // conditions for run1
+          if( fClusterType == 1 && nModules < 13 && ( aodt->GetTrackPhiOnEMCal() < 70*TMath::DegToRad() || aodt->GetTrackPhiOnEMCal() > 190*TMath::DegToRad())){tracks.AddTrack(inTrack->Pt(),1); continue;}
 
-        // conditions for run2
-        if( nModules > 12 ){
-          if( fClusterType == 3 && ( aodt->GetTrackPhiOnEMCal() < 250*TMath::DegToRad() || aodt->GetTrackPhiOnEMCal() > 340*TMath::DegToRad()) ){FillfHistControlMatches(1.,inTrack->Pt()); continue;}
-          if( fClusterType == 1 && ( aodt->GetTrackPhiOnEMCal() < 70*TMath::DegToRad() || aodt->GetTrackPhiOnEMCal() > 190*TMath::DegToRad()) ){FillfHistControlMatches(1.,inTrack->Pt()); continue;}
-          if( fClusterType == 4 && ( aodt->GetTrackPhiOnEMCal() < 70*TMath::DegToRad() || aodt->GetTrackPhiOnEMCal() > 190*TMath::DegToRad()) && ( aodt->GetTrackPhiOnEMCal() < 250*TMath::DegToRad() || aodt->GetTrackPhiOnEMCal() > 340*TMath::DegToRad()) ){FillfHistControlMatches(1.,inTrack->Pt()); continue;}
+          // conditions for run2
+          if( nModules > 12 ){
+            if( fClusterType == 3 && ( aodt->GetTrackPhiOnEMCal() < 250*TMath::DegToRad() || aodt->GetTrackPhiOnEMCal() > 340*TMath::DegToRad()) ){tracks.AddTrack(inTrack->Pt(),1); continue;}
+            if( fClusterType == 1 && ( aodt->GetTrackPhiOnEMCal() < 70*TMath::DegToRad() || aodt->GetTrackPhiOnEMCal() > 190*TMath::DegToRad()) ){tracks.AddTrack(inTrack->Pt(),1); continue;}
+            if( fClusterType == 4 && ( aodt->GetTrackPhiOnEMCal() < 70*TMath::DegToRad() || aodt->GetTrackPhiOnEMCal() > 190*TMath::DegToRad()) && ( aodt->GetTrackPhiOnEMCal() < 250*TMath::DegToRad() || aodt->GetTrackPhiOnEMCal() > 340*TMath::DegToRad()) ){tracks.AddTrack(inTrack->Pt(),1); continue;}
+          }
         }
+        trackParam = new AliExternalTrackParam(xyz,pxpypz,cv,aodt->Charge());
       }
-      trackParam = new AliExternalTrackParam(xyz,pxpypz,cv,aodt->Charge());
-    }
 
-    if (!trackParam) {AliError("Could not get TrackParameters, continue"); FillfHistControlMatches(1.,inTrack->Pt()); continue;}
-    AliExternalTrackParam emcParam(*trackParam);
-    Float_t eta, phi, pt;
+      if (!trackParam) {AliError("Could not get TrackParameters, continue"); tracks.AddTrack(inTrack->Pt(),1); continue;}
+      AliExternalTrackParam emcParam(*trackParam);
+      Float_t eta, phi, pt;
 
-    //propagate tracks to emc surfaces
-    if(fClusterType == 1 || fClusterType == 3 || fClusterType == 4){
-      if (!AliEMCALRecoUtils::ExtrapolateTrackToEMCalSurface(&emcParam, 440., fMassHypothesis , 20., eta, phi, pt)) {
-        delete trackParam;
-        FillfHistControlMatches(2.,inTrack->Pt());
-        continue;
-      }
-      if( TMath::Abs(eta) > 0.75 ) {
-        delete trackParam;
-        FillfHistControlMatches(3.,inTrack->Pt());
-        continue;
-      }
-      // Save some time and memory in case of no DCal present
-      if( fClusterType == 1 && nModules < 13 && ( phi < 70*TMath::DegToRad() || phi > 190*TMath::DegToRad())){
-        delete trackParam;
-        FillfHistControlMatches(3.,inTrack->Pt());
-        continue;
-      }
-      // Save some time and memory in case of run2
-      if( nModules > 12 ){
-        if (fClusterType == 3 && ( phi < 250*TMath::DegToRad() || phi > 340*TMath::DegToRad())){
+      //propagate tracks to emc surfaces
+      if(fClusterType == 1 || fClusterType == 3 || fClusterType == 4){
+        if (!AliEMCALRecoUtils::ExtrapolateTrackToEMCalSurface(&emcParam, 440., fMassHypothesis , 20., eta, phi, pt)) {
           delete trackParam;
-          FillfHistControlMatches(3.,inTrack->Pt());
+          tracks.AddTrack(inTrack->Pt(),2);
           continue;
         }
-        if( fClusterType == 1 && ( phi < 70*TMath::DegToRad() || phi > 190*TMath::DegToRad())){
+        if( TMath::Abs(eta) > 0.75 ) {
           delete trackParam;
-          FillfHistControlMatches(3.,inTrack->Pt());
+          tracks.AddTrack(inTrack->Pt(),3);
           continue;
         }
-        if( fClusterType == 4 && ( phi < 70*TMath::DegToRad() || phi > 190*TMath::DegToRad())
-                              && ( phi < 250*TMath::DegToRad() || phi > 340*TMath::DegToRad())){
+        // Save some time and memory in case of no DCal present
+        if( fClusterType == 1 && nModules < 13 && ( phi < 70*TMath::DegToRad() || phi > 190*TMath::DegToRad())){
           delete trackParam;
-          FillfHistControlMatches(3.,inTrack->Pt());
+          tracks.AddTrack(inTrack->Pt(),3);
           continue;
         }
-      }
-    }else if(fClusterType == 2){
-      if( !AliTrackerBase::PropagateTrackToBxByBz(&emcParam, 460., fMassHypothesis, 20, kTRUE, 0.8, -1)){
-        delete trackParam;
-        FillfHistControlMatches(2.,inTrack->Pt());
-        continue;
-      }
-      Double_t trkPos[3] = {0,0,0};
-      if(emcParam.GetXYZ(trkPos)){
-        TVector3 trkPosVec(trkPos[0],trkPos[1],trkPos[2]);
-        if (TMath::Abs(trkPosVec.Eta()) > 0.25 ){
-          delete trackParam;
-          FillfHistControlMatches(3.,inTrack->Pt());
-          continue;
+        // Save some time and memory in case of run2
+        if( nModules > 12 ){
+          if (fClusterType == 3 && ( phi < 250*TMath::DegToRad() || phi > 340*TMath::DegToRad())){
+            delete trackParam;
+            tracks.AddTrack(inTrack->Pt(),3);
+            continue;
+          }
+          if( fClusterType == 1 && ( phi < 70*TMath::DegToRad() || phi > 190*TMath::DegToRad())){
+            delete trackParam;
+            tracks.AddTrack(inTrack->Pt(),3);
+            continue;
+          }
+          if( fClusterType == 4 && ( phi < 70*TMath::DegToRad() || phi > 190*TMath::DegToRad())
+                                && ( phi < 250*TMath::DegToRad() || phi > 340*TMath::DegToRad())){
+            delete trackParam;
+            tracks.AddTrack(inTrack->Pt(),3);
+            continue;
+          }
         }
-        if (trkPosVec.Phi() < 230*TMath::DegToRad() || trkPosVec.Phi() > 350*TMath::DegToRad() ){
+      }else if(fClusterType == 2){
+        if( !AliTrackerBase::PropagateTrackToBxByBz(&emcParam, 460., fMassHypothesis, 20, kTRUE, 0.8, -1)){
           delete trackParam;
-          FillfHistControlMatches(3.,inTrack->Pt());
+          tracks.AddTrack(inTrack->Pt(),2);
           continue;
         }
+        Double_t trkPos[3] = {0,0,0};
+        if(emcParam.GetXYZ(trkPos)){
+          TVector3 trkPosVec(trkPos[0],trkPos[1],trkPos[2]);
+          if (TMath::Abs(trkPosVec.Eta()) > 0.25 ){
+            delete trackParam;
+            tracks.AddTrack(inTrack->Pt(),3);
+            continue;
+          }
+          if (trkPosVec.Phi() < 230*TMath::DegToRad() || trkPosVec.Phi() > 350*TMath::DegToRad() ){
+            delete trackParam;
+            tracks.AddTrack(inTrack->Pt(),3);
+            continue;
+          }
+        }
       }
-    }
 
-    Float_t dEta=-999, dPhi=-999;
-    Float_t clsPos[3] = {0.,0.,0.};
-    Double_t exPos[3] = {0.,0.,0.};
-    if (!emcParam.GetXYZ(exPos)){
+      Double_t exPos[3] = {0.,0.,0.};
+      if (!emcParam.GetXYZ(exPos)){
+        delete trackParam;
+        tracks.AddTrack(inTrack->Pt(),2);
+        continue;
+      }
+      tracks.AddPropagatedTrack(aodev ? itr : inTrack->GetID(), inTrack->GetID(), inTrack->Pt(), emcParam, exPos);
       delete trackParam;
-      FillfHistControlMatches(2.,inTrack->Pt());
-      continue;
     }
+  }
+  // clusters of the event, indexed in a grid of cells of size fMatchingWindow
+  IndexClusters(event, nClus);
+
+  // replay the propagation bookkeeping in the control histogram of this matcher
+  if(fHistControlMatches){
+    for (UInt_t i = 0; i < tracks.fPt.size(); i++){
+      FillfHistControlMatches(0.,tracks.fPt[i]);
+      if(tracks.fStatus[i] > 0) FillfHistControlMatches(tracks.fStatus[i],tracks.fPt[i]);
+    }
+  }
+
+  Float_t dEta=-999, dPhi=-999;
+  for (UInt_t itr = 0; itr < tracks.fKey.size(); itr++){
+    const Double_t* exPos = &tracks.fPos[3*itr];
+    Float_t trackPt = tracks.fPropPt[itr];
 
-    // cout << inTrack->GetID() << " - " << trackParam << endl;
-    // cout << "eta/phi: " << eta << ", " << phi << endl;
-    // cout << "nClus: " << nClus << endl;
     Int_t nClusterMatchesToTrack = 0;
-    for(Int_t iclus=0;iclus < nClus;iclus++){
-      AliVCluster* cluster = NULL;
-      if(fArrClusters){
-        if(esdev){
-          if(fArrClusters)
-            cluster = new AliESDCaloCluster(*(AliESDCaloCluster*)fArrClusters->At(iclus));
-        } else if(aodev){
-          if(fArrClusters)
-            cluster = new AliAODCaloCluster(*(AliAODCaloCluster*)fArrClusters->At(iclus));
-        }
-      }
-      else
-        cluster = event->GetCaloCluster(iclus);
-      if (!cluster){
-        if(fArrClusters) delete cluster;
-        continue;
-      }
-      // cout << "-------------------------LOOPING: " << iclus << ", " << cluster->GetID() << endl;
-      cluster->GetPosition(clsPos);
+    Int_t nCandidates = FindClusterCandidates(exPos);
+    for(Int_t iCand = 0; iCand < nCandidates; iCand++){
+      Int_t iclus = fClusterCandidates[iCand];
+      AliVCluster* cluster = fClusters[iclus];
+      const Float_t* clsPos = &fClusterPos[3*iclus];
       Double_t dR = TMath::Sqrt(TMath::Power(exPos[0]-clsPos[0],2)+TMath::Power(exPos[1]-clsPos[1],2)+TMath::Power(exPos[2]-clsPos[2],2));
-      //cout << "dR: " << dR << endl;
-      if (dR > fMatchingWindow){
-        if(fArrClusters) delete cluster;
-        continue;
-      }
+      if (dR > fMatchingWindow) continue;
       Double_t clusterR = TMath::Sqrt( clsPos[0]*clsPos[0] + clsPos[1]*clsPos[1] );
-      AliExternalTrackParam trackParamTmp(emcParam);//Retrieve the starting point every time before the extrapolation
+      AliExternalTrackParam trackParamTmp(tracks.fParam[itr]);//Retrieve the starting point every time before the extrapolation
       if(fClusterType == 1 || fClusterType == 3 || fClusterType == 4){
-        if (!cluster->IsEMCAL()){
-          if(fArrClusters) delete cluster;
-          continue;
-        }
+        if (!cluster->IsEMCAL()) continue;
         if(!AliEMCALRecoUtils::ExtrapolateTrackToCluster(&trackParamTmp, cluster, fMassHypothesis, 5., dEta, dPhi)){
-          FillfHistControlMatches(4.,inTrack->Pt());
-          if(fArrClusters) delete cluster;
+          FillfHistControlMatches(4.,trackPt);
           continue;
         }
       }else if(fClusterType == 2){
-        if (!cluster->IsPHOS()){
-          if(fArrClusters) delete cluster;
-          continue;
-        }
+        if (!cluster->IsPHOS()) continue;
         if(!AliTrackerBase::PropagateTrackToBxByBz(&trackParamTmp, clusterR, fMassHypothesis, 5., kTRUE, 0.8, -1)){
-          FillfHistControlMatches(4.,inTrack->Pt());
-          if(fArrClusters) delete cluster;
+          FillfHistControlMatches(4.,trackPt);
           continue;
         }
         Double_t trkPos[3] = {0,0,0};
@@ -492,33 +618,112 @@ void AliCaloTrackMatcher::ProcessEvent(AliVEvent *event){
       }
 
       Float_t dR2 = dPhi*dPhi + dEta*dEta;
-
-      //cout << dEta << " - " << dPhi << " - " << dR2 << endl;
-      if(dR2 > fMatchingResidual){
-        if(fArrClusters) delete cluster;
-        continue;
-      }
+      if(dR2 > fMatchingResidual) continue;
       nClusterMatchesToTrack++;
-      if(aodev){
-        fMapTrackToCluster.insert(make_pair(itr,cluster->GetID()));
-        fMapClusterToTrack.insert(make_pair(cluster->GetID(),itr));
-      }else{
-        fMapTrackToCluster.insert(make_pair(inTrack->GetID(),cluster->GetID()));
-        fMapClusterToTrack.insert(make_pair(cluster->GetID(),inTrack->GetID()));
-      }
+      fMatchTrack.push_back(tracks.fKey[itr]);
+      fMatchTrackID.push_back(tracks.fID[itr]);
+      fMatchCluster.push_back(cluster->GetID());
       fVectorDeltaEtaDeltaPhi.push_back(make_pair(dEta,dPhi));
-      fMap_TrID_ClID_ToIndex[make_pair(inTrack->GetID(),cluster->GetID())] = fNEntries++;
-      if( (Int_t)fVectorDeltaEtaDeltaPhi.size() != (fNEntries-1)) AliFatal("Fatal error in AliCaloTrackMatcher, vector and map are not in sync!");
-      if(fArrClusters) delete cluster;
     }
-    if(nClusterMatchesToTrack == 0) FillfHistControlMatches(5.,inTrack->Pt());
-    else FillfHistControlMatches(6.,inTrack->Pt());
-    delete trackParam;
+    if(nClusterMatchesToTrack == 0) FillfHistControlMatches(5.,trackPt);
+    else FillfHistControlMatches(6.,trackPt);
   }
 
+  BuildMatchTables();
   return;
 }
 
+
+//________________________________________________________________________
+void AliCaloTrackMatcher::ClearMatches(){
+  fMatchTrack.clear();
+  fMatchTrackID.clear();
+  fMatchCluster.clear();
+  fVectorDeltaEtaDeltaPhi.clear();
+  fClusterRowID.clear();
+  fClusterRowStart.clear();
+  fTrackRowID.clear();
+  fTrackRowStart.clear();
+}
+
+//________________________________________________________________________
+void AliCaloTrackMatcher::IndexClusters(AliVEvent *event, Int_t nClus){
+  // keeps pointer and position of the clusters and sorts them in cells of size fMatchingWindow,
+  // so that only the clusters in the cells around a track are tested against the matching window
+  fClusters.resize(nClus);
+  fClusterPos.resize(3*nClus);
+  fClusterCells.clear();
+  Double_t cellSize = TMath::Max(fMatchingWindow,1.);
+  for(Int_t iclus=0;iclus < nClus;iclus++){
+    AliVCluster* cluster = NULL;
+    if(fArrClusters) cluster = dynamic_cast<AliVCluster*>(fArrClusters->At(iclus));
+    else cluster = event->GetCaloCluster(iclus);
+    fClusters[iclus] = cluster;
+    if(!cluster) continue;
+    Float_t* clsPos = &fClusterPos[3*iclus];
+    cluster->GetPosition(clsPos);
+    fClusterCells.push_back(make_pair(GridCell(GridIndex(clsPos[0],cellSize),GridIndex(clsPos[1],cellSize),GridIndex(clsPos[2],cellSize)),iclus));
+  }
+  sort(fClusterCells.begin(),fClusterCells.end());
+}
+
+//________________________________________________________________________
+Int_t AliCaloTrackMatcher::FindClusterCandidates(const Double_t* pos){
+  // clusters in the 27 cells around pos, in increasing cluster index as in the loop over all clusters
+  fClusterCandidates.clear();
+  if(fMatchingWindow < 0) return 0;
+  Double_t cellSize = TMath::Max(fMatchingWindow,1.);
+  Long64_t ix = GridIndex(pos[0],cellSize), iy = GridIndex(pos[1],cellSize), iz = GridIndex(pos[2],cellSize);
+  for (Int_t dx = -1; dx <= 1; dx++){
+    for (Int_t dy = -1; dy <= 1; dy++){
+      for (Int_t dz = -1; dz <= 1; dz++){
+        Long64_t cell = GridCell(ix+dx,iy+dy,iz+dz);
+        vector< pair<Long64_t,Int_t> >::const_iterator it = lower_bound(fClusterCells.begin(),fClusterCells.end(),make_pair(cell,-1));
+        for (; it != fClusterCells.end() && it->first == cell; ++it) fClusterCandidates.push_back(it->second);
+      }
+    }
+  }
+  sort(fClusterCandidates.begin(),fClusterCandidates.end());
+  return fClusterCandidates.size();
+}
+
+//________________________________________________________________________
+void AliCaloTrackMatcher::BuildMatchTables(){
+  // cluster -> tracks and track -> clusters tables of the matches, in compressed sparse row format
+  Int_t nMatches = fMatchTrack.size();
+
+  BuildRows(fMatchCluster,fMatchOrder,fClusterRowID,fClusterRowStart);
+  fClusterToTrack.resize(nMatches);
+  fClusterToTrackID.resize(nMatches);
+  fClusterToTrackDEta.resize(nMatches);
+  fClusterToTrackDPhi.resize(nMatches);
+  for (Int_t i = 0; i < nMatches; i++){
+    Int_t iMatch = fMatchOrder[i];
+    fClusterToTrack[i]     = fMatchTrack[iMatch];
+    fClusterToTrackID[i]   = fMatchTrackID[iMatch];
+    fClusterToTrackDEta[i] = fVectorDeltaEtaDeltaPhi[iMatch].first;
+    fClusterToTrackDPhi[i] = fVectorDeltaEtaDeltaPhi[iMatch].second;
+  }
+
+  BuildRows(fMatchTrack,fMatchOrder,fTrackRowID,fTrackRowStart);
+  fTrackToCluster.resize(nMatches);
+  fTrackToClusterDEta.resize(nMatches);
+  fTrackToClusterDPhi.resize(nMatches);
+  for (Int_t i = 0; i < nMatches; i++){
+    Int_t iMatch = fMatchOrder[i];
+    fTrackToCluster[i]     = fMatchCluster[iMatch];
+    fTrackToClusterDEta[i] = fVectorDeltaEtaDeltaPhi[iMatch].first;
+    fTrackToClusterDPhi[i] = fVectorDeltaEtaDeltaPhi[iMatch].second;
+  }
+}
+
+//________________________________________________________________________
+Int_t AliCaloTrackMatcher::FindRow(const vector<Int_t>& rowID, Int_t id){
+  vector<Int_t>::const_iterator it = lower_bound(rowID.begin(),rowID.end(),id);
+  if(it == rowID.end() || *it != id) return -1;
+  return it - rowID.begin();
+}
+
 //________________________________________________________________________
 Bool_t AliCaloTrackMatcher::PropagateV0TrackToClusterAndGetMatchingResidual(AliVTrack* inSecTrack, AliVCluster* cluster, AliVEvent* event, Float_t &dEta, Float_t &dPhi){
 
@@ -748,32 +953,78 @@ Bool_t AliCaloTrackMatcher::PropagateV0TrackToClusterAndGetMatchingResidual(AliV
 //________________________________________________________________________
 //________________________________________________________________________
 Bool_t AliCaloTrackMatcher::GetTrackClusterMatchingResidual(Int_t trackID, Int_t clusterID, Float_t &dEta, Float_t &dPhi){
-  Int_t position = fMap_TrID_ClID_ToIndex[make_pair(trackID,clusterID)];
-  if(position == 0) return kFALSE;
+  Int_t row = FindRow(fClusterRowID,clusterID);
+  if(row < 0) return kFALSE;
+  for (Int_t i = fClusterRowStart[row]; i < fClusterRowStart[row+1]; i++){
+    if(fClusterToTrackID[i] != trackID) continue;
+    dEta = fClusterToTrackDEta[i];
+    dPhi = fClusterToTrackDPhi[i];
+    return kTRUE;
+  }
+  return kFALSE;
+}
 
-  pairFloat tempEtaPhi = fVectorDeltaEtaDeltaPhi.at(position-1);
-  dEta = tempEtaPhi.first;
-  dPhi = tempEtaPhi.second;
-  return kTRUE;
+//________________________________________________________________________
+Int_t AliCaloTrackMatcher::GetMatchedTracksForCluster(Int_t clusterID, const Int_t* &tracks, const Float_t* &dEta, const Float_t* &dPhi) const {
+  Int_t row = FindRow(fClusterRowID,clusterID);
+  if(row < 0){
+    tracks = 0; dEta = 0; dPhi = 0;
+    return 0;
+  }
+  Int_t first = fClusterRowStart[row];
+  tracks = &fClusterToTrack[first];
+  dEta   = &fClusterToTrackDEta[first];
+  dPhi   = &fClusterToTrackDPhi[first];
+  return fClusterRowStart[row+1] - first;
+}
+
+//________________________________________________________________________
+Int_t AliCaloTrackMatcher::GetMatchedClustersForTrack(Int_t trackPos, const Int_t* &clusters, const Float_t* &dEta, const Float_t* &dPhi) const {
+  Int_t row = FindRow(fTrackRowID,trackPos);
+  if(row < 0){
+    clusters = 0; dEta = 0; dPhi = 0;
+    return 0;
+  }
+  Int_t first = fTrackRowStart[row];
+  clusters = &fTrackToCluster[first];
+  dEta     = &fTrackToClusterDEta[first];
+  dPhi     = &fTrackToClusterDPhi[first];
+  return fTrackRowStart[row+1] - first;
 }
+
+//________________________________________________________________________
+Int_t AliCaloTrackMatcher::GetTrackPosition(AliVEvent *event, Int_t trackID){
+  if(event->IsA()!=AliAODEvent::Class()) return trackID; // for ESD just take trackID
+
+  // for AOD, we have to look for position of track in the event
+  if(fSurfaceTracks && fSurfaceTracks->IsEvent(event)){
+    const vector< pair<Int_t,Int_t> >& idToPos = fSurfaceTracks->fIDToPos;
+    vector< pair<Int_t,Int_t> >::const_iterator it = lower_bound(idToPos.begin(),idToPos.end(),make_pair(trackID,-1));
+    if(it != idToPos.end() && it->first == trackID) return it->second;
+  } else {
+    for (Int_t iTrack = 0; iTrack < event->GetNumberOfTracks(); iTrack++){
+      AliVTrack* currTrack  = dynamic_cast<AliVTrack*>(event->GetTrack(iTrack));
+      if(currTrack->GetID() == trackID) return iTrack;
+    }
+  }
+  AliFatal(Form("AliCaloTrackMatcher: GetNMatchedClusterIDsForTrack - track (ID: '%i') cannot be retrieved from event, should be impossible as it has been used in maim task before!",trackID));
+  return -1;
+}
+
 //________________________________________________________________________
 Int_t AliCaloTrackMatcher::GetNMatchedTrackIDsForCluster(AliVEvent *event, Int_t clusterID, Float_t dEtaMax, Float_t dEtaMin, Float_t dPhiMax, Float_t dPhiMin){
   Int_t matched = 0;
-  multimap<Int_t,Int_t>::iterator it;
-  for (it=fMapClusterToTrack.begin(); it!=fMapClusterToTrack.end(); ++it){
-    if(it->first == clusterID){
-      Float_t tempDEta, tempDPhi;
-      AliVTrack* tempTrack  = dynamic_cast<AliVTrack*>(event->GetTrack(it->second));
-      if(!tempTrack) continue;
-      if(GetTrackClusterMatchingResidual(tempTrack->GetID(),it->first,tempDEta,tempDPhi)){
-        if(tempTrack->Charge()>0){
-          if( (dEtaMin < tempDEta) && (tempDEta < dEtaMax) && (dPhiMin < tempDPhi) && (tempDPhi < dPhiMax) ) matched++;
-        }else if(tempTrack->Charge()<0){
-          dPhiMin*=-1;
-          dPhiMax*=-1;
-          if( (dEtaMin < tempDEta) && (tempDEta < dEtaMax) && (dPhiMin > tempDPhi) && (tempDPhi > dPhiMax) ) matched++;
-        }
-      }
+  const Int_t *tracks; const Float_t *tempDEta, *tempDPhi;
+  Int_t nTracks = GetMatchedTracksForCluster(clusterID,tracks,tempDEta,tempDPhi);
+  for (Int_t i = 0; i < nTracks; i++){
+    AliVTrack* tempTrack  = dynamic_cast<AliVTrack*>(event->GetTrack(tracks[i]));
+    if(!tempTrack) continue;
+    if(tempTrack->Charge()>0){
+      if( (dEtaMin < tempDEta[i]) && (tempDEta[i] < dEtaMax) && (dPhiMin < tempDPhi[i]) && (tempDPhi[i] < dPhiMax) ) matched++;
+    }else if(tempTrack->Charge()<0){
+      dPhiMin*=-1;
+      dPhiMax*=-1;
+      if( (dEtaMin < tempDEta[i]) && (tempDEta[i] < dEtaMax) && (dPhiMin > tempDPhi[i]) && (tempDPhi[i] > dPhiMax) ) matched++;
     }
   }
 
@@ -783,24 +1034,14 @@ Int_t AliCaloTrackMatcher::GetNMatchedTrackIDsForCluster(AliVEvent *event, Int_t
 //________________________________________________________________________
 Int_t AliCaloTrackMatcher::GetNMatchedTrackIDsForCluster(AliVEvent *event, Int_t clusterID, TF1* fFuncPtDepEta, TF1* fFuncPtDepPhi){
   Int_t matched = 0;
-  multimap<Int_t,Int_t>::iterator it;
-  for (it=fMapClusterToTrack.begin(); it!=fMapClusterToTrack.end(); ++it){
-    if(it->first == clusterID){
-      Float_t tempDEta, tempDPhi;
-      AliVTrack* tempTrack  = dynamic_cast<AliVTrack*>(event->GetTrack(it->second));
-      if(!tempTrack) continue;
-      if(GetTrackClusterMatchingResidual(tempTrack->GetID(),it->first,tempDEta,tempDPhi)){
-        Bool_t match_dEta = kFALSE;
-        Bool_t match_dPhi = kFALSE;
-        if( TMath::Abs(tempDEta) < fFuncPtDepEta->Eval(tempTrack->Pt())) match_dEta = kTRUE;
-        else match_dEta = kFALSE;
-
-        if( TMath::Abs(tempDPhi) < fFuncPtDepPhi->Eval(tempTrack->Pt())) match_dPhi = kTRUE;
-        else match_dPhi = kFALSE;
-
-        if (match_dPhi && match_dEta )matched++;
-      }
-    }
+  const Int_t *tracks; const Float_t *tempDEta, *tempDPhi;
+  Int_t nTracks = GetMatchedTracksForCluster(clusterID,tracks,tempDEta,tempDPhi);
+  for (Int_t i = 0; i < nTracks; i++){
+    AliVTrack* tempTrack  = dynamic_cast<AliVTrack*>(event->GetTrack(tracks[i]));
+    if(!tempTrack) continue;
+    Bool_t match_dEta = ( TMath::Abs(tempDEta[i]) < fFuncPtDepEta->Eval(tempTrack->Pt()));
+    Bool_t match_dPhi = ( TMath::Abs(tempDPhi[i]) < fFuncPtDepPhi->Eval(tempTrack->Pt()));
+    if (match_dPhi && match_dEta )matched++;
   }
   return matched;
 }
@@ -808,51 +1049,32 @@ Int_t AliCaloTrackMatcher::GetNMatchedTrackIDsForCluster(AliVEvent *event, Int_t
 //________________________________________________________________________
 Int_t AliCaloTrackMatcher::GetNMatchedTrackIDsForCluster(AliVEvent *event, Int_t clusterID, Float_t dR){
   Int_t matched = 0;
-  multimap<Int_t,Int_t>::iterator it;
-  for (it=fMapClusterToTrack.begin(); it!=fMapClusterToTrack.end(); ++it){
-    if(it->first == clusterID){
-      Float_t tempDEta, tempDPhi;
-      AliVTrack* tempTrack  = dynamic_cast<AliVTrack*>(event->GetTrack(it->second));
-      if(!tempTrack) continue;
-      if(GetTrackClusterMatchingResidual(tempTrack->GetID(),it->first,tempDEta,tempDPhi)){
-        if (TMath::Sqrt(tempDEta*tempDEta + tempDPhi*tempDPhi) < dR ) matched++;
-      }
-    }
+  const Int_t *tracks; const Float_t *tempDEta, *tempDPhi;
+  Int_t nTracks = GetMatchedTracksForCluster(clusterID,tracks,tempDEta,tempDPhi);
+  for (Int_t i = 0; i < nTracks; i++){
+    AliVTrack* tempTrack  = dynamic_cast<AliVTrack*>(event->GetTrack(tracks[i]));
+    if(!tempTrack) continue;
+    if (TMath::Sqrt(tempDEta[i]*tempDEta[i] + tempDPhi[i]*tempDPhi[i]) < dR ) matched++;
   }
   return matched;
 }
 
 //________________________________________________________________________
 Int_t AliCaloTrackMatcher::GetNMatchedClusterIDsForTrack(AliVEvent *event, Int_t trackID, Float_t dEtaMax, Float_t dEtaMin, Float_t dPhiMax, Float_t dPhiMin){
-
-  Int_t TrackPos = -1;
-  if(event->IsA()==AliAODEvent::Class()){ // for AOD, we have to look for position of track in the event
-    for (Int_t iTrack = 0; iTrack < event->GetNumberOfTracks(); iTrack++){
-      AliVTrack* currTrack  = dynamic_cast<AliVTrack*>(event->GetTrack(iTrack));
-      if(currTrack->GetID() == trackID){
-        TrackPos = iTrack;
-        break;
-      }
-    }
-    if(TrackPos == -1) AliFatal(Form("AliCaloTrackMatcher: GetNMatchedClusterIDsForTrack - track (ID: '%i') cannot be retrieved from event, should be impossible as it has been used in maim task before!",trackID));
-  }else TrackPos = trackID; // for ESD just take trackID
+  Int_t TrackPos = GetTrackPosition(event,trackID);
 
   Int_t matched = 0;
-  multimap<Int_t,Int_t>::iterator it;
   AliVTrack* tempTrack  = dynamic_cast<AliVTrack*>(event->GetTrack(TrackPos));
   if(!tempTrack) return matched;
-  for (it=fMapTrackToCluster.begin(); it!=fMapTrackToCluster.end(); ++it){
-    if(it->first == TrackPos){
-      Float_t tempDEta, tempDPhi;
-      if(GetTrackClusterMatchingResidual(tempTrack->GetID(),it->second,tempDEta,tempDPhi)){
-        if(tempTrack->Charge()>0){
-          if( (dEtaMin < tempDEta) && (tempDEta < dEtaMax) && (dPhiMin < tempDPhi) && (tempDPhi < dPhiMax) ) matched++;
-        }else if(tempTrack->Charge()<0){
-          dPhiMin*=-1;
-          dPhiMax*=-1;
-          if( (dEtaMin < tempDEta) && (tempDEta < dEtaMax) && (dPhiMin > tempDPhi) && (tempDPhi > dPhiMax) ) matched++;
-        }
-      }
+  const Int_t *clusters; const Float_t *tempDEta, *tempDPhi;
+  Int_t nClusters = GetMatchedClustersForTrack(TrackPos,clusters,tempDEta,tempDPhi);
+  for (Int_t i = 0; i < nClusters; i++){
+    if(tempTrack->Charge()>0){
+      if( (dEtaMin < tempDEta[i]) && (tempDEta[i] < dEtaMax) && (dPhiMin < tempDPhi[i]) && (tempDPhi[i] < dPhiMax) ) matched++;
+    }else if(tempTrack->Charge()<0){
+      dPhiMin*=-1;
+      dPhiMax*=-1;
+      if( (dEtaMin < tempDEta[i]) && (tempDEta[i] < dEtaMax) && (dPhiMin > tempDPhi[i]) && (tempDPhi[i] > dPhiMax) ) matched++;
     }
   }
   return matched;
@@ -860,67 +1082,32 @@ Int_t AliCaloTrackMatcher::GetNMatchedClusterIDsForTrack(AliVEvent *event, Int_t
 
 //________________________________________________________________________
 Int_t AliCaloTrackMatcher::GetNMatchedClusterIDsForTrack(AliVEvent *event, Int_t trackID, TF1* fFuncPtDepEta, TF1* fFuncPtDepPhi){
-  Int_t TrackPos = -1;
-  if(event->IsA()==AliAODEvent::Class()){ // for AOD, we have to look for position of track in the event
-    for (Int_t iTrack = 0; iTrack < event->GetNumberOfTracks(); iTrack++){
-      AliVTrack* currTrack  = dynamic_cast<AliVTrack*>(event->GetTrack(iTrack));
-      if(currTrack->GetID() == trackID){
-        TrackPos = iTrack;
-        break;
-      }
-    }
-    if(TrackPos == -1) AliFatal(Form("AliCaloTrackMatcher: GetNMatchedClusterIDsForTrack - track (ID: '%i') cannot be retrieved from event, should be impossible as it has been used in maim task before!",trackID));
-  }else TrackPos = trackID; // for ESD just take trackID
+  Int_t TrackPos = GetTrackPosition(event,trackID);
 
   Int_t matched = 0;
-  multimap<Int_t,Int_t>::iterator it;
   AliVTrack* tempTrack  = dynamic_cast<AliVTrack*>(event->GetTrack(TrackPos));
   if(!tempTrack) return matched;
-  for (it=fMapTrackToCluster.begin(); it!=fMapTrackToCluster.end(); ++it){
-    if(it->first == TrackPos){
-      Float_t tempDEta, tempDPhi;
-      if(GetTrackClusterMatchingResidual(tempTrack->GetID(),it->second,tempDEta,tempDPhi)){
-        Bool_t match_dEta = kFALSE;
-        Bool_t match_dPhi = kFALSE;
-        if( TMath::Abs(tempDEta) < fFuncPtDepEta->Eval(tempTrack->Pt())) match_dEta = kTRUE;
-        else match_dEta = kFALSE;
-
-        if( TMath::Abs(tempDPhi) < fFuncPtDepPhi->Eval(tempTrack->Pt())) match_dPhi = kTRUE;
-        else match_dPhi = kFALSE;
-
-        if (match_dPhi && match_dEta )matched++;
-
-      }
-    }
+  const Int_t *clusters; const Float_t *tempDEta, *tempDPhi;
+  Int_t nClusters = GetMatchedClustersForTrack(TrackPos,clusters,tempDEta,tempDPhi);
+  for (Int_t i = 0; i < nClusters; i++){
+    Bool_t match_dEta = ( TMath::Abs(tempDEta[i]) < fFuncPtDepEta->Eval(tempTrack->Pt()));
+    Bool_t match_dPhi = ( TMath::Abs(tempDPhi[i]) < fFuncPtDepPhi->Eval(tempTrack->Pt()));
+    if (match_dPhi && match_dEta )matched++;
   }
   return matched;
 }
 
 //________________________________________________________________________
 Int_t AliCaloTrackMatcher::GetNMatchedClusterIDsForTrack(AliVEvent *event, Int_t trackID, Float_t dR){
-  Int_t TrackPos = -1;
-  if(event->IsA()==AliAODEvent::Class()){ // for AOD, we have to look for position of track in the event
-    for (Int_t iTrack = 0; iTrack < event->GetNumberOfTracks(); iTrack++){
-      AliVTrack* currTrack  = dynamic_cast<AliVTrack*>(event->GetTrack(iTrack));
-      if(currTrack->GetID() == trackID){
-        TrackPos = iTrack;
-        break;
-      }
-    }
-    if(TrackPos == -1) AliFatal(Form("AliCaloTrackMatcher: GetNMatchedClusterIDsForTrack - track (ID: '%i') cannot be retrieved from event, should be impossible as it has been used in maim task before!",trackID));
-  }else TrackPos = trackID; // for ESD just take trackID
+  Int_t TrackPos = GetTrackPosition(event,trackID);
 
   Int_t matched = 0;
-  multimap<Int_t,Int_t>::iterator it;
   AliVTrack* tempTrack  = dynamic_cast<AliVTrack*>(event->GetTrack(TrackPos));
   if(!tempTrack) return matched;
-  for (it=fMapTrackToCluster.begin(); it!=fMapTrackToCluster.end(); ++it){
-    if(it->first == TrackPos){
-      Float_t tempDEta, tempDPhi;
-      if(GetTrackClusterMatchingResidual(tempTrack->GetID(),it->second,tempDEta,tempDPhi)){
-        if (TMath::Sqrt(tempDEta*tempDEta + tempDPhi*tempDPhi) < dR ) matched++;
-      }
-    }
+  const Int_t *clusters; const Float_t *tempDEta, *tempDPhi;
+  Int_t nClusters = GetMatchedClustersForTrack(TrackPos,clusters,tempDEta,tempDPhi);
+  for (Int_t i = 0; i < nClusters; i++){
+    if (TMath::Sqrt(tempDEta[i]*tempDEta[i] + tempDPhi[i]*tempDPhi[i]) < dR ) matched++;
   }
   return matched;
 }
@@ -928,21 +1115,17 @@ Int_t AliCaloTrackMatcher::GetNMatchedClusterIDsForTrack(AliVEvent *event, Int_t
 //________________________________________________________________________
 vector<Int_t> AliCaloTrackMatcher::GetMatchedTrackIDsForCluster(AliVEvent *event, Int_t clusterID, Float_t dEtaMax, Float_t dEtaMin, Float_t dPhiMax, Float_t dPhiMin){
   vector<Int_t> tempMatchedTracks;
-  multimap<Int_t,Int_t>::iterator it;
-  for (it=fMapClusterToTrack.begin(); it!=fMapClusterToTrack.end(); ++it){
-    if(it->first == clusterID){
-      Float_t tempDEta, tempDPhi;
-      AliVTrack* tempTrack  = dynamic_cast<AliVTrack*>(event->GetTrack(it->second));
-      if(!tempTrack) continue;
-      if(GetTrackClusterMatchingResidual(tempTrack->GetID(),it->first,tempDEta,tempDPhi)){
-        if(tempTrack->Charge()>0){
-          if( (dEtaMin < tempDEta) && (tempDEta < dEtaMax) && (dPhiMin < tempDPhi) && (tempDPhi < dPhiMax) ) tempMatchedTracks.push_back(it->second);
-        }else if(tempTrack->Charge()<0){
-          dPhiMin*=-1;
-          dPhiMax*=-1;
-          if( (dEtaMin < tempDEta) && (tempDEta < dEtaMax) && (dPhiMin > tempDPhi) && (tempDPhi > dPhiMax) ) tempMatchedTracks.push_back(it->second);
-        }
-      }
+  const Int_t *tracks; const Float_t *tempDEta, *tempDPhi;
+  Int_t nTracks = GetMatchedTracksForCluster(clusterID,tracks,tempDEta,tempDPhi);
+  for (Int_t i = 0; i < nTracks; i++){
+    AliVTrack* tempTrack  = dynamic_cast<AliVTrack*>(event->GetTrack(tracks[i]));
+    if(!tempTrack) continue;
+    if(tempTrack->Charge()>0){
+      if( (dEtaMin < tempDEta[i]) && (tempDEta[i] < dEtaMax) && (dPhiMin < tempDPhi[i]) && (tempDPhi[i] < dPhiMax) ) tempMatchedTracks.push_back(tracks[i]);
+    }else if(tempTrack->Charge()<0){
+      dPhiMin*=-1;
+      dPhiMax*=-1;
+      if( (dEtaMin < tempDEta[i]) && (tempDEta[i] < dEtaMax) && (dPhiMin > tempDPhi[i]) && (tempDPhi[i] > dPhiMax) ) tempMatchedTracks.push_back(tracks[i]);
     }
   }
   return tempMatchedTracks;
@@ -951,25 +1134,14 @@ vector<Int_t> AliCaloTrackMatcher::GetMatchedTrackIDsForCluster(AliVEvent *event
 //________________________________________________________________________
 vector<Int_t> AliCaloTrackMatcher::GetMatchedTrackIDsForCluster(AliVEvent *event, Int_t clusterID,  TF1* fFuncPtDepEta, TF1* fFuncPtDepPhi){
   vector<Int_t> tempMatchedTracks;
-  multimap<Int_t,Int_t>::iterator it;
-  for (it=fMapClusterToTrack.begin(); it!=fMapClusterToTrack.end(); ++it){
-    if(it->first == clusterID){
-      Float_t tempDEta, tempDPhi;
-      AliVTrack* tempTrack  = dynamic_cast<AliVTrack*>(event->GetTrack(it->second));
-      if(!tempTrack) continue;
-      if(GetTrackClusterMatchingResidual(tempTrack->GetID(),it->first,tempDEta,tempDPhi)){
-        Bool_t match_dEta = kFALSE;
-        Bool_t match_dPhi = kFALSE;
-        if( TMath::Abs(tempDEta) < fFuncPtDepEta->Eval(tempTrack->Pt())) match_dEta = kTRUE;
-        else match_dEta = kFALSE;
-
-        if( TMath::Abs(tempDPhi) < fFuncPtDepPhi->Eval(tempTrack->Pt())) match_dPhi = kTRUE;
-        else match_dPhi = kFALSE;
-
-        if (match_dPhi && match_dEta )tempMatchedTracks.push_back(it->second);
-
-      }
-    }
+  const Int_t *tracks; const Float_t *tempDEta, *tempDPhi;
+  Int_t nTracks = GetMatchedTracksForCluster(clusterID,tracks,tempDEta,tempDPhi);
+  for (Int_t i = 0; i < nTracks; i++){
+    AliVTrack* tempTrack  = dynamic_cast<AliVTrack*>(event->GetTrack(tracks[i]));
+    if(!tempTrack) continue;
+    Bool_t match_dEta = ( TMath::Abs(tempDEta[i]) < fFuncPtDepEta->Eval(tempTrack->Pt()));
+    Bool_t match_dPhi = ( TMath::Abs(tempDPhi[i]) < fFuncPtDepPhi->Eval(tempTrack->Pt()));
+    if (match_dPhi && match_dEta )tempMatchedTracks.push_back(tracks[i]);
   }
   return tempMatchedTracks;
 }
@@ -977,50 +1149,32 @@ vector<Int_t> AliCaloTrackMatcher::GetMatchedTrackIDsForCluster(AliVEvent *event
 //________________________________________________________________________
 vector<Int_t> AliCaloTrackMatcher::GetMatchedTrackIDsForCluster(AliVEvent *event, Int_t clusterID,  Float_t dR){
   vector<Int_t> tempMatchedTracks;
-  multimap<Int_t,Int_t>::iterator it;
-  for (it=fMapClusterToTrack.begin(); it!=fMapClusterToTrack.end(); ++it){
-    if(it->first == clusterID){
-      Float_t tempDEta, tempDPhi;
-      AliVTrack* tempTrack  = dynamic_cast<AliVTrack*>(event->GetTrack(it->second));
-      if(!tempTrack) continue;
-      if(GetTrackClusterMatchingResidual(tempTrack->GetID(),it->first,tempDEta,tempDPhi)){
-        if (TMath::Sqrt(tempDEta*tempDEta + tempDPhi*tempDPhi) < dR ) tempMatchedTracks.push_back(it->second);
-      }
-    }
+  const Int_t *tracks; const Float_t *tempDEta, *tempDPhi;
+  Int_t nTracks = GetMatchedTracksForCluster(clusterID,tracks,tempDEta,tempDPhi);
+  for (Int_t i = 0; i < nTracks; i++){
+    AliVTrack* tempTrack  = dynamic_cast<AliVTrack*>(event->GetTrack(tracks[i]));
+    if(!tempTrack) continue;
+    if (TMath::Sqrt(tempDEta[i]*tempDEta[i] + tempDPhi[i]*tempDPhi[i]) < dR ) tempMatchedTracks.push_back(tracks[i]);
   }
   return tempMatchedTracks;
 }
 
 //________________________________________________________________________
 vector<Int_t> AliCaloTrackMatcher::GetMatchedClusterIDsForTrack(AliVEvent *event, Int_t trackID, Float_t dEtaMax, Float_t dEtaMin, Float_t dPhiMax, Float_t dPhiMin){
-  Int_t TrackPos = -1;
-  if(event->IsA()==AliAODEvent::Class()){ // for AOD, we have to look for position of track in the event
-    for (Int_t iTrack = 0; iTrack < event->GetNumberOfTracks(); iTrack++){
-      AliVTrack* currTrack  = dynamic_cast<AliVTrack*>(event->GetTrack(iTrack));
-      if(currTrack->GetID() == trackID){
-        TrackPos = iTrack;
-        break;
-      }
-    }
-    if(TrackPos == -1) AliFatal(Form("AliCaloTrackMatcher: GetNMatchedClusterIDsForTrack - track (ID: '%i') cannot be retrieved from event, should be impossible as it has been used in maim task before!",trackID));
-  }else TrackPos = trackID; // for ESD just take trackID
+  Int_t TrackPos = GetTrackPosition(event,trackID);
 
   vector<Int_t> tempMatchedClusters;
-  multimap<Int_t,Int_t>::iterator it;
   AliVTrack* tempTrack  = dynamic_cast<AliVTrack*>(event->GetTrack(TrackPos));
   if(!tempTrack) return tempMatchedClusters;
-  for (it=fMapTrackToCluster.begin(); it!=fMapTrackToCluster.end(); ++it){
-    if(it->first == TrackPos){
-      Float_t tempDEta, tempDPhi;
-      if(GetTrackClusterMatchingResidual(tempTrack->GetID(),it->second,tempDEta,tempDPhi)){
-        if(tempTrack->Charge()>0){
-          if( (dEtaMin < tempDEta) && (tempDEta < dEtaMax) && (dPhiMin < tempDPhi) && (tempDPhi < dPhiMax) ) tempMatchedClusters.push_back(it->second);
-        }else if(tempTrack->Charge()<0){
-          dPhiMin*=-1;
-          dPhiMax*=-1;
-          if( (dEtaMin < tempDEta) && (tempDEta < dEtaMax) && (dPhiMin > tempDPhi) && (tempDPhi > dPhiMax) ) tempMatchedClusters.push_back(it->second);
-        }
-      }
+  const Int_t *clusters; const Float_t *tempDEta, *tempDPhi;
+  Int_t nClusters = GetMatchedClustersForTrack(TrackPos,clusters,tempDEta,tempDPhi);
+  for (Int_t i = 0; i < nClusters; i++){
+    if(tempTrack->Charge()>0){
+      if( (dEtaMin < tempDEta[i]) && (tempDEta[i] < dEtaMax) && (dPhiMin < tempDPhi[i]) && (tempDPhi[i] < dPhiMax) ) tempMatchedClusters.push_back(clusters[i]);
+    }else if(tempTrack->Charge()<0){
+      dPhiMin*=-1;
+      dPhiMax*=-1;
+      if( (dEtaMin < tempDEta[i]) && (tempDEta[i] < dEtaMax) && (dPhiMin > tempDPhi[i]) && (tempDPhi[i] > dPhiMax) ) tempMatchedClusters.push_back(clusters[i]);
     }
   }
 
@@ -1029,66 +1183,32 @@ vector<Int_t> AliCaloTrackMatcher::GetMatchedClusterIDsForTrack(AliVEvent *event
 
 //________________________________________________________________________
 vector<Int_t> AliCaloTrackMatcher::GetMatchedClusterIDsForTrack(AliVEvent *event, Int_t trackID, TF1* fFuncPtDepEta, TF1* fFuncPtDepPhi){
-  Int_t TrackPos = -1;
-  if(event->IsA()==AliAODEvent::Class()){ // for AOD, we have to look for position of track in the event
-    for (Int_t iTrack = 0; iTrack < event->GetNumberOfTracks(); iTrack++){
-      AliVTrack* currTrack  = dynamic_cast<AliVTrack*>(event->GetTrack(iTrack));
-      if(currTrack->GetID() == trackID){
-        TrackPos = iTrack;
-        break;
-      }
-    }
-    if(TrackPos == -1) AliFatal(Form("AliCaloTrackMatcher: GetNMatchedClusterIDsForTrack - track (ID: '%i') cannot be retrieved from event, should be impossible as it has been used in maim task before!",trackID));
-  }else TrackPos = trackID; // for ESD just take trackID
+  Int_t TrackPos = GetTrackPosition(event,trackID);
 
   vector<Int_t> tempMatchedClusters;
-  multimap<Int_t,Int_t>::iterator it;
   AliVTrack* tempTrack  = dynamic_cast<AliVTrack*>(event->GetTrack(TrackPos));
   if(!tempTrack) return tempMatchedClusters;
-  for (it=fMapTrackToCluster.begin(); it!=fMapTrackToCluster.end(); ++it){
-    if(it->first == TrackPos){
-      Float_t tempDEta, tempDPhi;
-      if(GetTrackClusterMatchingResidual(tempTrack->GetID(),it->second,tempDEta,tempDPhi)){
-        Bool_t match_dEta = kFALSE;
-        Bool_t match_dPhi = kFALSE;
-        if( TMath::Abs(tempDEta) < fFuncPtDepEta->Eval(tempTrack->Pt())) match_dEta = kTRUE;
-        else match_dEta = kFALSE;
-
-        if( TMath::Abs(tempDPhi) < fFuncPtDepPhi->Eval(tempTrack->Pt())) match_dPhi = kTRUE;
-        else match_dPhi = kFALSE;
-
-        if (match_dPhi && match_dEta )tempMatchedClusters.push_back(it->second);
-      }
-    }
+  const Int_t *clusters; const Float_t *tempDEta, *tempDPhi;
+  Int_t nClusters = GetMatchedClustersForTrack(TrackPos,clusters,tempDEta,tempDPhi);
+  for (Int_t i = 0; i < nClusters; i++){
+    Bool_t match_dEta = ( TMath::Abs(tempDEta[i]) < fFuncPtDepEta->Eval(tempTrack->Pt()));
+    Bool_t match_dPhi = ( TMath::Abs(tempDPhi[i]) < fFuncPtDepPhi->Eval(tempTrack->Pt()));
+    if (match_dPhi && match_dEta )tempMatchedClusters.push_back(clusters[i]);
   }
   return tempMatchedClusters;
 }
 
 //________________________________________________________________________
 vector<Int_t> AliCaloTrackMatcher::GetMatchedClusterIDsForTrack(AliVEvent *event, Int_t trackID, Float_t dR){
-  Int_t TrackPos = -1;
-  if(event->IsA()==AliAODEvent::Class()){ // for AOD, we have to look for position of track in the event
-    for (Int_t iTrack = 0; iTrack < event->GetNumberOfTracks(); iTrack++){
-      AliVTrack* currTrack  = dynamic_cast<AliVTrack*>(event->GetTrack(iTrack));
-      if(currTrack->GetID() == trackID){
-        TrackPos = iTrack;
-        break;
-      }
-    }
-    if(TrackPos == -1) AliFatal(Form("AliCaloTrackMatcher: GetNMatchedClusterIDsForTrack - track (ID: '%i') cannot be retrieved from event, should be impossible as it has been used in maim task before!",trackID));
-  }else TrackPos = trackID; // for ESD just take trackID
+  Int_t TrackPos = GetTrackPosition(event,trackID);
 
   vector<Int_t> tempMatchedClusters;
-  multimap<Int_t,Int_t>::iterator it;
   AliVTrack* tempTrack  = dynamic_cast<AliVTrack*>(event->GetTrack(TrackPos));
   if(!tempTrack) return tempMatchedClusters;
-  for (it=fMapTrackToCluster.begin(); it!=fMapTrackToCluster.end(); ++it){
-    if(it->first == TrackPos){
-      Float_t tempDEta, tempDPhi;
-      if(GetTrackClusterMatchingResidual(tempTrack->GetID(),it->second,tempDEta,tempDPhi)){
-        if (TMath::Sqrt(tempDEta*tempDEta + tempDPhi*tempDPhi) < dR ) tempMatchedClusters.push_back(it->second);
-      }
-    }
+  const Int_t *clusters; const Float_t *tempDEta, *tempDPhi;
+  Int_t nClusters = GetMatchedClustersForTrack(TrackPos,clusters,tempDEta,tempDPhi);
+  for (Int_t i = 0; i < nClusters; i++){
+    if (TMath::Sqrt(tempDEta[i]*tempDEta[i] + tempDPhi[i]*tempDPhi[i]) < dR ) tempMatchedClusters.push_back(clusters[i]);
   }
   return tempMatchedClusters;
 }
@@ -1461,12 +1581,13 @@ vector<Int_t> AliCaloTrackMatcher::GetMatchedClusterIDsForSecTrack(AliVEvent *ev
 //________________________________________________________________________
 Float_t AliCaloTrackMatcher::SumTrackEtAroundCluster(AliVEvent* event, Int_t clusterID, Float_t dR){
   Float_t sumTrackEt = 0.;
-  vector<Int_t> labelsMatched = GetMatchedTrackIDsForCluster(event, clusterID, dR);
-  if((Int_t) labelsMatched.size()<1) return sumTrackEt;
+  const Int_t *tracks; const Float_t *dEta, *dPhi;
+  Int_t nTracks = GetMatchedTracksForCluster(clusterID,tracks,dEta,dPhi);
 
   TLorentzVector vecTrack;
-  for (UInt_t i = 0; i < labelsMatched.size(); i++){
-    AliVTrack* currTrack  = dynamic_cast<AliVTrack*>(event->GetTrack(labelsMatched.at(i)));
+  for (Int_t i = 0; i < nTracks; i++){
+    if (TMath::Sqrt(dEta[i]*dEta[i] + dPhi[i]*dPhi[i]) >= dR ) continue;
+    AliVTrack* currTrack  = dynamic_cast<AliVTrack*>(event->GetTrack(tracks[i]));
     if(!currTrack) continue;
     vecTrack.SetPxPyPzE(currTrack->Px(),currTrack->Py(),currTrack->Pz(),currTrack->E());
     sumTrackEt += vecTrack.Et();
@@ -1537,12 +1658,9 @@ void AliCaloTrackMatcher::DebugMatching(){
     cout << "NEW EVENT !" << endl;
     cout << "vector etaphi:" << endl;
     cout << fVectorDeltaEtaDeltaPhi.size() << endl;
-    cout << "multimap" << endl;
-    mapT::iterator iter = fMap_TrID_ClID_ToIndex.begin();
-    for (iter = fMap_TrID_ClID_ToIndex.begin(); iter != fMap_TrID_ClID_ToIndex.end(); ++iter){
-      Float_t dEta, dPhi = 0;
-      if(!GetTrackClusterMatchingResidual(iter->first.first,iter->first.second,dEta,dPhi)) continue;
-      cout << "  [" << iter->first.first << "/" << iter->first.second << ", " << iter->second << "] - (" << dEta << "/" << dPhi << ")" << endl;
+    cout << "matches" << endl;
+    for (UInt_t i = 0; i < fMatchTrackID.size(); i++){
+      cout << "  [" << fMatchTrackID[i] << "/" << fMatchCluster[i] << ", " << i+1 << "] - (" << fVectorDeltaEtaDeltaPhi[i].first << "/" << fVectorDeltaEtaDeltaPhi[i].second << ")" << endl;
     }
     cout << "mapTrackToCluster" << endl;
     AliESDEvent *esdev = dynamic_cast<AliESDEvent*>(fInputEvent);
@@ -1555,11 +1673,12 @@ void AliCaloTrackMatcher::DebugMatching(){
       cout << itr << " (" << tCharge << ") - " << GetNMatchedClusterIDsForTrack(fInputEvent,inTrack->GetID(),5,-5,0.2,-0.4) << "\t\t";
     }
     cout << endl;
-    multimap<Int_t,Int_t>::iterator it;
-    for (it=fMapTrackToCluster.begin(); it!=fMapTrackToCluster.end(); ++it) cout << it->first << " => " << it->second << '\n';
+    for (UInt_t iRow = 0; iRow < fTrackRowID.size(); iRow++)
+      for (Int_t i = fTrackRowStart[iRow]; i < fTrackRowStart[iRow+1]; i++) cout << fTrackRowID[iRow] << " => " << fTrackToCluster[i] << '\n';
     cout << "mapClusterToTrack" << endl;
-    Int_t tempClus = it->second;
-    for (it=fMapClusterToTrack.begin(); it!=fMapClusterToTrack.end(); ++it) cout << it->first << " => " << it->second << '\n';
+    Int_t tempClus = fClusterRowID.back();
+    for (UInt_t iRow = 0; iRow < fClusterRowID.size(); iRow++)
+      for (Int_t i = fClusterRowStart[iRow]; i < fClusterRowStart[iRow+1]; i++) cout << fClusterRowID[iRow] << " => " << fClusterToTrack[i] << '\n';
     vector<Int_t> tempTracks = GetMatchedTrackIDsForCluster(fInputEvent,tempClus, 5, -5, 0.2, -0.4);
     for(UInt_t iJ=0; iJ<tempTracks.size();iJ++){
       cout << tempClus << " - " << tempTracks.at(iJ) << endl;
@@ -9,6 +9,7 @@
 #include <utility>
 
 class TF1;
+struct AliCaloTrackMatcherSurfaceTracks;
 
 using namespace std;
 
@@ -51,6 +52,12 @@ class AliCaloTrackMatcher : public AliAnalysisTaskSE {
     vector<Int_t> GetMatchedClusterIDsForTrack(AliVEvent *event, Int_t trackID, Float_t dEtaMax, Float_t dEtaMin, Float_t dPhiMax, Float_t dPhiMin);
     vector<Int_t> GetMatchedClusterIDsForTrack(AliVEvent *event, Int_t trackID, Float_t dR);
 
+    // non-owning access to the matches of the current event, valid until the next event is processed
+    // tracks are given by their position in the event (AOD) or their ID (ESD), returns the number of matches
+    Int_t GetMatchedTracksForCluster(Int_t clusterID, const Int_t* &tracks, const Float_t* &dEta, const Float_t* &dPhi) const;
+    Int_t GetMatchedClustersForTrack(Int_t trackPos, const Int_t* &clusters, const Float_t* &dEta, const Float_t* &dPhi) const;
+    Int_t GetTrackPosition(AliVEvent *event, Int_t trackID);
+
     // for cluster <-> V0-track matching
     Bool_t PropagateV0TrackToClusterAndGetMatchingResidual(AliVTrack* inSecTrack, AliVCluster* cluster, AliVEvent* event, Float_t &dEta, Float_t &dPhi);
     Bool_t IsSecTrackClusterAlreadyTried(Int_t trackID, Int_t clusterID);
@@ -90,6 +97,12 @@ class AliCaloTrackMatcher : public AliAnalysisTaskSE {
     // private methods
     void Initialize(Int_t runNumber);
     void ProcessEvent(AliVEvent *event);
+    void ClearMatches();
+    void IndexClusters(AliVEvent *event, Int_t nClus);
+    AliCaloTrackMatcherSurfaceTracks* GetSurfaceTracks();
+    Int_t FindClusterCandidates(const Double_t* pos);
+    void BuildMatchTables();
+    static Int_t FindRow(const vector<Int_t>& rowID, Int_t id);
     void SetLogBinningYTH2(TH2* histoRebin);
 
     // debug methods
@@ -118,12 +131,36 @@ class AliCaloTrackMatcher : public AliAnalysisTaskSE {
 
     TClonesArray*         fArrClusters;            //! array with clusters
 
-    multimap<Int_t,Int_t> fMapTrackToCluster;      //! connects a given track ID with all associated cluster IDs
-    multimap<Int_t,Int_t> fMapClusterToTrack;      //! connects a given cluster ID with all associated track IDs
-
-    Int_t                 fNEntries;               //! number of current TrackID/ClusterID -> Eta/Phi connections
-    vector<pairFloat>     fVectorDeltaEtaDeltaPhi; //! vector of all matching residuals for a specific TrackID/ClusterID
-    mapT                  fMap_TrID_ClID_ToIndex;  //! map tuple of (trackID,clusterID) to index in vector fVectorDeltaEtaDeltaPhi
+    // tracks propagated to the calorimeter surface, shared with the matchers of the same configuration
+    // in the analysis manager (see GetSurfaceTracks)
+    AliCaloTrackMatcherSurfaceTracks* fSurfaceTracks; //! tracks of the current event at the calorimeter surface
+    Bool_t                fOwnSurfaceTracks;       //! fSurfaceTracks created (and deleted) by this matcher
+
+    // clusters of the current event, sorted in cells of size fMatchingWindow
+    vector<AliVCluster*>  fClusters;               //! cluster pointers
+    vector<Float_t>       fClusterPos;             //! cluster positions, 3 per cluster
+    vector< pair<Long64_t,Int_t> > fClusterCells;  //! (cell, cluster index), sorted by cell
+    vector<Int_t>         fClusterCandidates;      //! clusters in the cells around a track
+
+    // matches of the current event, in matching order
+    vector<Int_t>         fMatchTrack;             //! track position (AOD) or ID (ESD)
+    vector<Int_t>         fMatchTrackID;           //! track ID
+    vector<Int_t>         fMatchCluster;           //! cluster ID
+    vector<pairFloat>     fVectorDeltaEtaDeltaPhi; //! matching residuals
+    vector<Int_t>         fMatchOrder;             //! work array for sorting the matches
+
+    // matches of the current event in compressed sparse row format, one row per cluster ID / track
+    vector<Int_t>         fClusterRowID;           //! sorted IDs of matched clusters
+    vector<Int_t>         fClusterRowStart;        //! first match of each cluster, one more entry than fClusterRowID
+    vector<Int_t>         fClusterToTrack;         //! track position (AOD) or ID (ESD) of matches per cluster
+    vector<Int_t>         fClusterToTrackID;       //! track ID of matches per cluster
+    vector<Float_t>       fClusterToTrackDEta;     //! dEta of matches per cluster
+    vector<Float_t>       fClusterToTrackDPhi;     //! dPhi of matches per cluster
+    vector<Int_t>         fTrackRowID;             //! sorted position (AOD) or ID (ESD) of matched tracks
+    vector<Int_t>         fTrackRowStart;          //! first match of each track, one more entry than fTrackRowID
+    vector<Int_t>         fTrackToCluster;         //! cluster ID of matches per track
+    vector<Float_t>       fTrackToClusterDEta;     //! dEta of matches per track
+    vector<Float_t>       fTrackToClusterDPhi;     //! dPhi of matches per track
 
     // for cluster <-> V0-track matching (running with different mass hypthesis)
     multimap<Int_t,Int_t> fSecMapTrackToCluster;      //! connects a given secondary track ID with all associated cluster IDs
@@ -142,7 +179,7 @@ class AliCaloTrackMatcher : public AliAnalysisTaskSE {
     Bool_t                fDoLightOutput;          // switch for running light output, kFALSE -> normal mode, kTRUE -> light mode
 
     Double_t              fMassHypothesis;          // mass used for track propagation to calorimeter surface
-    ClassDef(AliCaloTrackMatcher,9)
+    ClassDef(AliCaloTrackMatcher,11)
 };
 
 #endif
@@ -22,6 +22,7 @@
 ////////////////////////////////////////////////
 
 #include "AliConvEventCuts.h"
+#include "AliConvEventSharedCache.h"
 
 #include <memory>
 #include <TSystem.h>
@@ -773,7 +774,7 @@ Bool_t AliConvEventCuts::EventIsSelected(AliVEvent *event, AliMCEvent *mcEvent){
       }
     }
   } else if(fRemovePileUpSPD){
-    if(event->IsPileupFromSPD(3,0.8,3.,2.,5.) ){
+    if(IsPileupFromSPD(event) ){
       if(fHistoEventCuts)fHistoEventCuts->Fill(cutindex);
       if (hPileupVertexToPrimZSPDPileup) hPileupVertexToPrimZSPDPileup->Fill(distZMax);
       fEventQuality = 6;
@@ -2908,8 +2909,34 @@ Bool_t AliConvEventCuts::GetUseNewMultiplicityFramework(){
   return kFALSE;
 }
 
+//-------------------------------------------------------------
+Bool_t AliConvEventCuts::IsPileupFromSPD(AliVEvent *event)
+{   // SPD pile-up with the default settings, shared by all event cut instances
+  AliConvEventSharedCache &cache = AliConvEventSharedCache::Instance();
+  Double_t isPileup = 0;
+  if (!cache.Find(event, AliConvEventSharedCache::kPileupFromSPD, isPileup)){
+    isPileup = event->IsPileupFromSPD(3,0.8,3.,2.,5.) ? 1 : 0;
+    cache.Store(event, AliConvEventSharedCache::kPileupFromSPD, isPileup);
+  }
+  return isPileup > 0;
+}
+
 //-------------------------------------------------------------
 Float_t AliConvEventCuts::GetCentrality(AliVEvent *event)
+{   // Get Event Centrality, computed once per event and estimator
+  // the estimator only depends on the detector, the collision system and the framework
+  AliConvEventSharedCache &cache = AliConvEventSharedCache::Instance();
+  Int_t quantity = AliConvEventSharedCache::kCentrality + 4*(fDetectorCentrality+1) + 2*(fIsHeavyIon==2) + (GetUseNewMultiplicityFramework() ? 1 : 0);
+  Double_t centrality = -1;
+  if (!cache.Find(event, quantity, centrality)){
+    centrality = ComputeCentrality(event);
+    cache.Store(event, quantity, centrality);
+  }
+  return centrality;
+}
+
+//-------------------------------------------------------------
+Float_t AliConvEventCuts::ComputeCentrality(AliVEvent *event)
 {   // Get Event Centrality
 
   AliESDEvent *esdEvent=dynamic_cast<AliESDEvent*>(event);
@@ -5508,7 +5535,7 @@ Bool_t AliConvEventCuts::IsTriggerSelected(AliVEvent *event, Bool_t isMC)
   if (fInputHandler==NULL) return kFALSE;
   if( fInputHandler->GetEventSelection() || event->IsA()==AliAODEvent::Class()) {
 
-    TString firedTrigClass = event->GetFiredTriggerClasses();
+    const TString &firedTrigClass = AliConvEventSharedCache::Instance().GetFiredTriggerClasses(event);
     // if no trigger has been selected manually, select kAny in case of presel (also important for AOD filtering!)
     // in other cases select standards depending on system
     if (!fTriggerSelectedManually){
@@ -6086,9 +6113,69 @@ TString AliConvEventCuts::GetCutNumber(){
   return fCutStringRead;
 }
 
-// todo: refactoring seems worthwhile
 //________________________________________________________________________
 void AliConvEventCuts::GetNotRejectedParticles(Int_t rejection, TList *HeaderList, AliVEvent *event){
+  // The accepted header ranges only depend on the event, the rejection mode, the header list,
+  // the period and the added signal, they are shared between the event cut instances
+  if(rejection == 0 || fDebugLevel > 0){
+    FindNotRejectedParticles(rejection, HeaderList, event);
+    return;
+  }
+
+  TString key = Form("%d|%d|%d", rejection, (Int_t)fPeriodEnum, fAddedSignalPDGCode);
+  if(HeaderList){
+    for(Int_t j = 0; j<HeaderList->GetEntries();j++) key += Form("|%s", ((TObjString*)HeaderList->At(j))->GetString().Data());
+  }
+
+  AliConvEventSharedCache &cache = AliConvEventSharedCache::Instance();
+  const AliConvEventSharedCache::HeaderRanges *cached = cache.FindHeaderRanges(event, key);
+  if(cached){
+    if(fNotRejectedStart){
+      delete[] fNotRejectedStart;
+      fNotRejectedStart         = NULL;
+    }
+    if(fNotRejectedEnd){
+      delete[] fNotRejectedEnd;
+      fNotRejectedEnd           = NULL;
+    }
+    if(fGeneratorNames){
+      delete[] fGeneratorNames;
+      fGeneratorNames           = NULL;
+    }
+    if(cached->fDisableRejection){
+      SetRejectExtraSignalsCut(0);
+      return;
+    }
+    fnHeaders                   = cached->fNHeaders;
+    fNotRejectedStart           = new Int_t[fnHeaders];
+    fNotRejectedEnd             = new Int_t[fnHeaders];
+    fGeneratorNames             = new TString[fnHeaders];
+    for(Int_t i = 0; i < fnHeaders; i++){
+      fNotRejectedStart[i]      = cached->fStart[i];
+      fNotRejectedEnd[i]        = cached->fEnd[i];
+      fGeneratorNames[i]        = cached->fNames[i];
+    }
+    return;
+  }
+
+  Int_t rejectExtraSignals      = fRejectExtraSignals;
+  FindNotRejectedParticles(rejection, HeaderList, event);
+
+  AliConvEventSharedCache::HeaderRanges *ranges = cache.AddHeaderRanges(event, key);
+  if(!ranges) return;
+  if(!fNotRejectedStart){
+    ranges->fDisableRejection   = (rejectExtraSignals != 0 && fRejectExtraSignals == 0);
+    return;
+  }
+  ranges->fNHeaders             = fnHeaders;
+  ranges->fStart.assign(fNotRejectedStart, fNotRejectedStart+fnHeaders);
+  ranges->fEnd.assign(fNotRejectedEnd, fNotRejectedEnd+fnHeaders);
+  ranges->fNames.assign(fGeneratorNames, fGeneratorNames+fnHeaders);
+}
+
+// todo: refactoring seems worthwhile
+//________________________________________________________________________
+void AliConvEventCuts::FindNotRejectedParticles(Int_t rejection, TList *HeaderList, AliVEvent *event){
 
   if(fNotRejectedStart){
     delete[] fNotRejectedStart;
@@ -6582,70 +6669,81 @@ Int_t AliConvEventCuts::IsEventAcceptedByCut(AliConvEventCuts *ReaderCuts, AliVE
   // Special EMCAL checks due to hardware issues in LHC11a or LHC12x or LHC16rs
   if (isEMCALAnalysis || IsSpecialTrigger() == 5 || IsSpecialTrigger() == 8 || IsSpecialTrigger() == 9 ){
     Int_t runnumber = event->GetRunNumber();
+    // the LED event flags only depend on the EMCal cells, they are shared by all event cut instances
+    AliConvEventSharedCache &cache = AliConvEventSharedCache::Instance();
     if ((runnumber>=144871) && (runnumber<=146860)) {
+      Double_t isLedEvent = 0;
+      if (!cache.Find(event, AliConvEventSharedCache::kLEDEventLHC11a, isLedEvent)){
+        AliVCaloCells *cells   = event->GetEMCALCells();
+        const Short_t nCells   = cells->GetNumberOfCells();
+
+        if (event->IsA()==AliESDEvent::Class()) AliAnalysisManager::GetAnalysisManager()->LoadBranch("EMCALCells.");
+
+        AliInputEventHandler *fInputHandler=(AliInputEventHandler*)(AliAnalysisManager::GetAnalysisManager()->GetInputEventHandler());
+        if (!fInputHandler) return 3;
+
+        // count cells above threshold
+        Int_t nCellCount[12] = {0,0,0,0,0,0,0,0,0,0,0,0};
+        for(Int_t iCell=0; iCell<nCells; ++iCell) {
+          Short_t cellId = cells->GetCellNumber(iCell);
+          Double_t cellE = cells->GetCellAmplitude(cellId);
+          Int_t sm       = cellId / (24*48);
+          if (cellE>0.1) ++nCellCount[sm];
+        }
 
-      AliVCaloCells *cells   = event->GetEMCALCells();
-      const Short_t nCells   = cells->GetNumberOfCells();
-
-      if (event->IsA()==AliESDEvent::Class()) AliAnalysisManager::GetAnalysisManager()->LoadBranch("EMCALCells.");
-
-      AliInputEventHandler *fInputHandler=(AliInputEventHandler*)(AliAnalysisManager::GetAnalysisManager()->GetInputEventHandler());
-      if (!fInputHandler) return 3;
-
-      // count cells above threshold
-      Int_t nCellCount[12] = {0,0,0,0,0,0,0,0,0,0,0,0};
-      for(Int_t iCell=0; iCell<nCells; ++iCell) {
-        Short_t cellId = cells->GetCellNumber(iCell);
-        Double_t cellE = cells->GetCellAmplitude(cellId);
-        Int_t sm       = cellId / (24*48);
-        if (cellE>0.1) ++nCellCount[sm];
-      }
-
-      Bool_t fIsLedEvent = kFALSE;
-      if (nCellCount[4] > 100) {
-        fIsLedEvent = kTRUE;
-      } else {
-        if ((runnumber>=146858) && (runnumber<=146860)) {
-          if ((fInputHandler->IsEventSelected() & AliVEvent::kMB) && (nCellCount[3]>=21))
-            fIsLedEvent = kTRUE;
-          else if ((fInputHandler->IsEventSelected() & AliVEvent::kEMC1) && (nCellCount[3]>=35))
-            fIsLedEvent = kTRUE;
+        Bool_t fIsLedEvent = kFALSE;
+        if (nCellCount[4] > 100) {
+          fIsLedEvent = kTRUE;
+        } else {
+          if ((runnumber>=146858) && (runnumber<=146860)) {
+            if ((fInputHandler->IsEventSelected() & AliVEvent::kMB) && (nCellCount[3]>=21))
+              fIsLedEvent = kTRUE;
+            else if ((fInputHandler->IsEventSelected() & AliVEvent::kEMC1) && (nCellCount[3]>=35))
+              fIsLedEvent = kTRUE;
+          }
         }
+        isLedEvent = fIsLedEvent ? 1 : 0;
+        cache.Store(event, AliConvEventSharedCache::kLEDEventLHC11a, isLedEvent);
       }
-      if (fIsLedEvent) {
+      if (isLedEvent > 0) {
         return 9;
       }
     }
     Bool_t fRejectEMCalLEDevents = kTRUE;
     if (fRejectEMCalLEDevents && (fPeriodEnum == kLHC12 || fPeriodEnum == kLHC16NomB || fPeriodEnum == kLHC17NomB || fPeriodEnum == kLHC18NomB)) {
-      AliVCaloCells *cells   = event->GetEMCALCells();
-      const Short_t nCells   = cells->GetNumberOfCells();
-
-      if(!fGeomEMCAL) fGeomEMCAL = AliEMCALGeometry::GetInstance();
-      if(!fGeomEMCAL){ AliFatal("EMCal geometry not initialized!");}
-
-      // count cells above threshold
-      Int_t nStripsLED = 0;
-      Int_t nCellCountInStrip[480] = {0};
-
-      Int_t nSupMod=0, nModule=0, nIphi=0, nIeta=0, row=0, column=0;
-      for(Int_t iCell=0; iCell<nCells; ++iCell) {
-        // Get SM number and relative row/column for SM
-        fGeomEMCAL->GetCellIndex(cells->GetCellNumber(iCell), nSupMod,nModule,nIphi,nIeta);
-        fGeomEMCAL->GetCellPhiEtaIndexInSModule(nSupMod,nModule,nIphi,nIeta, row,column);
-
-        Short_t cellId = cells->GetCellNumber(iCell);
-        Double_t cellE = cells->GetCellAmplitude(cellId);
-        Int_t strip       = nSupMod*24 + column/2;
-        if (cellE>0.1) nCellCountInStrip[strip]++;
-      }
+      Double_t isLedEvent = 0;
+      if (!cache.Find(event, AliConvEventSharedCache::kLEDEventStrips, isLedEvent)){
+        AliVCaloCells *cells   = event->GetEMCALCells();
+        const Short_t nCells   = cells->GetNumberOfCells();
+
+        if(!fGeomEMCAL) fGeomEMCAL = AliEMCALGeometry::GetInstance();
+        if(!fGeomEMCAL){ AliFatal("EMCal geometry not initialized!");}
+
+        // count cells above threshold
+        Int_t nStripsLED = 0;
+        Int_t nCellCountInStrip[480] = {0};
+
+        Int_t nSupMod=0, nModule=0, nIphi=0, nIeta=0, row=0, column=0;
+        for(Int_t iCell=0; iCell<nCells; ++iCell) {
+          // Get SM number and relative row/column for SM
+          fGeomEMCAL->GetCellIndex(cells->GetCellNumber(iCell), nSupMod,nModule,nIphi,nIeta);
+          fGeomEMCAL->GetCellPhiEtaIndexInSModule(nSupMod,nModule,nIphi,nIeta, row,column);
+
+          Short_t cellId = cells->GetCellNumber(iCell);
+          Double_t cellE = cells->GetCellAmplitude(cellId);
+          Int_t strip       = nSupMod*24 + column/2;
+          if (cellE>0.1) nCellCountInStrip[strip]++;
+        }
 
-      Bool_t fIsLedEvent = kFALSE;
-      for(Int_t istrip=0; istrip<480; istrip++) {
-        if(nCellCountInStrip[istrip]>40) nStripsLED++;
+        Bool_t fIsLedEvent = kFALSE;
+        for(Int_t istrip=0; istrip<480; istrip++) {
+          if(nCellCountInStrip[istrip]>40) nStripsLED++;
+        }
+        if(nStripsLED>=3) fIsLedEvent = kTRUE;
+        isLedEvent = fIsLedEvent ? 1 : 0;
+        cache.Store(event, AliConvEventSharedCache::kLEDEventStrips, isLedEvent);
       }
-      if(nStripsLED>=3) fIsLedEvent = kTRUE;
-      if (fIsLedEvent) {
+      if (isLedEvent > 0) {
         return 9;
       }
     }
@@ -6684,7 +6782,7 @@ Int_t AliConvEventCuts::IsEventAcceptedByCut(AliConvEventCuts *ReaderCuts, AliVE
   }
 
   if( isHeavyIon != 2 && GetIsFromPileupSPD()){
-    if(event->IsPileupFromSPD(3,0.8,3.,2.,5.) ){
+    if(IsPileupFromSPD(event) ){
       if (hPileupVertexToPrimZSPDPileup) hPileupVertexToPrimZSPDPileup->Fill(distZMax);
       return 6; // Check Pileup --> Not Accepted => eventQuality = 6
     }
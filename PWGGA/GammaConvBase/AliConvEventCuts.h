@@ -796,6 +796,10 @@ class AliConvEventCuts : public AliAnalysisCuts {
       Int_t                       fDebugLevel;                            ///< debug level for interactive debugging
   private:
 
+      Bool_t    IsPileupFromSPD(AliVEvent *event);
+      Float_t   ComputeCentrality(AliVEvent *event);
+      void      FindNotRejectedParticles(Int_t rejection, TList *HeaderList, AliVEvent *event);
+
       /// \cond CLASSIMP
       ClassDef(AliConvEventCuts,83)
       /// \endcond
@@ -0,0 +1,127 @@
+/**************************************************************************
+* Copyright(c) 1998-1999, ALICE Experiment at CERN, All rights reserved.  *
+*                                                                         *
+* Permission to use, copy, modify and distribute this software and its    *
+* documentation strictly for non-commercial purposes is hereby granted    *
+* without fee, provided that the above copyright notice appears in all    *
+* copies and that both the copyright notice and this permission notice    *
+* appear in the supporting documentation. The authors make no claims      *
+* about the suitability of this software for any purpose. It is           *
+* provided "as is" without express or implied warranty.                   *
+**************************************************************************/
+
+////////////////////////////////////////////////
+//---------------------------------------------
+// Per-event results shared by all AliConvEventCuts
+// instances of a train
+//---------------------------------------------
+////////////////////////////////////////////////
+
+#include "AliConvEventSharedCache.h"
+#include "AliVEvent.h"
+#include "AliMCEvent.h"
+#include "AliAnalysisManager.h"
+
+//________________________________________________________________________
+AliConvEventSharedCache& AliConvEventSharedCache::Instance()
+{
+  static AliConvEventSharedCache instance;
+  return instance;
+}
+
+//________________________________________________________________________
+AliConvEventSharedCache::AliConvEventSharedCache() :
+  fEntry(-1),
+  fRun(-1),
+  fValues(),
+  fTriggerEvent(NULL),
+  fFiredTriggerClasses(),
+  fHeaderRanges(),
+  fNHeaderRanges(0)
+{
+}
+
+//________________________________________________________________________
+Bool_t AliConvEventSharedCache::Update(AliVEvent *event)
+{
+  // Clear the cache when a new entry or run is processed,
+  // returns kFALSE if the event cannot be identified
+  AliAnalysisManager *mgr = AliAnalysisManager::GetAnalysisManager();
+  if (!mgr || !event) return kFALSE;
+  Long64_t entry = mgr->GetCurrentEntry();
+  if (entry < 0) return kFALSE;
+  // the MC event does not carry the run number
+  Int_t run = (event->IsA() == AliMCEvent::Class()) ? fRun : event->GetRunNumber();
+  if (entry != fEntry || run != fRun){
+    fEntry          = entry;
+    fRun            = run;
+    fValues.clear();
+    fTriggerEvent   = NULL;
+    fNHeaderRanges  = 0;
+  }
+  return kTRUE;
+}
+
+//________________________________________________________________________
+Bool_t AliConvEventSharedCache::Find(AliVEvent *event, Int_t quantity, Double_t &value)
+{
+  if (!Update(event)) return kFALSE;
+  for (UInt_t i = 0; i < fValues.size(); i++){
+    if (fValues[i].fQuantity == quantity && fValues[i].fEvent == event){
+      value = fValues[i].fValue;
+      return kTRUE;
+    }
+  }
+  return kFALSE;
+}
+
+//________________________________________________________________________
+void AliConvEventSharedCache::Store(AliVEvent *event, Int_t quantity, Double_t value)
+{
+  if (!Update(event)) return;
+  Value v = {event, quantity, value};
+  fValues.push_back(v);
+}
+
+//________________________________________________________________________
+const TString& AliConvEventSharedCache::GetFiredTriggerClasses(AliVEvent *event)
+{
+  // For ESDs the string is built from the trigger mask at each call
+  if (!Update(event)){
+    fTriggerEvent         = NULL;
+    fFiredTriggerClasses  = event->GetFiredTriggerClasses();
+    return fFiredTriggerClasses;
+  }
+  if (fTriggerEvent != event){
+    fTriggerEvent         = event;
+    fFiredTriggerClasses  = event->GetFiredTriggerClasses();
+  }
+  return fFiredTriggerClasses;
+}
+
+//________________________________________________________________________
+const AliConvEventSharedCache::HeaderRanges* AliConvEventSharedCache::FindHeaderRanges(AliVEvent *event, const TString &key)
+{
+  if (!Update(event)) return NULL;
+  for (UInt_t i = 0; i < fNHeaderRanges; i++){
+    if (fHeaderRanges[i].fEvent == event && fHeaderRanges[i].fKey == key) return &fHeaderRanges[i];
+  }
+  return NULL;
+}
+
+//________________________________________________________________________
+AliConvEventSharedCache::HeaderRanges* AliConvEventSharedCache::AddHeaderRanges(AliVEvent *event, const TString &key)
+{
+  // The entries are reused from event to event
+  if (!Update(event)) return NULL;
+  if (fNHeaderRanges == fHeaderRanges.size()) fHeaderRanges.push_back(HeaderRanges());
+  HeaderRanges &ranges      = fHeaderRanges[fNHeaderRanges++];
+  ranges.fEvent             = event;
+  ranges.fKey               = key;
+  ranges.fDisableRejection  = kFALSE;
+  ranges.fNHeaders          = 0;
+  ranges.fStart.clear();
+  ranges.fEnd.clear();
+  ranges.fNames.clear();
+  return &ranges;
+}
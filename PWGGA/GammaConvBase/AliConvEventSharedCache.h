@@ -0,0 +1,86 @@
+#ifndef ALICONVEVENTSHAREDCACHE_H
+#define ALICONVEVENTSHAREDCACHE_H
+
+// Per-event results shared by all AliConvEventCuts instances of a train
+#include "Rtypes.h"
+#include "TString.h"
+#include <vector>
+
+class AliVEvent;
+
+/**
+ * @class AliConvEventSharedCache
+ * @brief Cache of the configuration independent per-event quantities of AliConvEventCuts
+ *
+ * GammaConv trains run many AliConvEventCuts instances (one per cut configuration) on the
+ * same event. The quantities which do not depend on the configuration, or only on a few
+ * of its settings which are then part of the key, are computed by the first instance
+ * asking for them and served from here to the others:
+ *  - centrality per estimator
+ *  - SPD pile-up and EMCal LED event flags
+ *  - fired trigger classes
+ *  - accepted MC header ranges (AliConvEventCuts::GetNotRejectedParticles)
+ *
+ * The cache is tied to the entry of the analysis manager and to the run number, it is
+ * cleared when either changes. Each value also remembers the event object it was
+ * computed for. Without analysis manager nothing is cached.
+ */
+class AliConvEventSharedCache {
+
+  public:
+
+    /// Quantities stored as numbers, see Find/Store
+    enum EQuantity {
+      kPileupFromSPD    = 0,        ///< AliVEvent::IsPileupFromSPD(3,0.8,3.,2.,5.)
+      kLEDEventLHC11a   = 1,        ///< LED event from the cell count per SM (LHC11a)
+      kLEDEventStrips   = 2,        ///< LED event from the cell count per strip
+      kCentrality       = 16        ///< first centrality, + estimator key of AliConvEventCuts
+    };
+
+    /// Accepted MC header ranges, see AliConvEventCuts::GetNotRejectedParticles
+    struct HeaderRanges {
+      const AliVEvent*        fEvent;               ///< event the ranges were obtained for
+      TString                 fKey;                 ///< rejection mode, header list and period
+      Bool_t                  fDisableRejection;    ///< single cocktail header: the rejection is switched off
+      Int_t                   fNHeaders;            ///< number of accepted headers
+      std::vector<Int_t>      fStart;               ///< first particle of the header
+      std::vector<Int_t>      fEnd;                 ///< last particle of the header
+      std::vector<TString>    fNames;               ///< name of the header
+    };
+
+    static AliConvEventSharedCache& Instance();
+
+    Bool_t              Find(AliVEvent *event, Int_t quantity, Double_t &value);
+    void                Store(AliVEvent *event, Int_t quantity, Double_t value);
+
+    const TString&      GetFiredTriggerClasses(AliVEvent *event);
+
+    const HeaderRanges* FindHeaderRanges(AliVEvent *event, const TString &key);
+    HeaderRanges*       AddHeaderRanges(AliVEvent *event, const TString &key);
+
+    Int_t               GetRunNumber() const { return fRun; }
+
+  private:
+
+    struct Value {
+      const AliVEvent*  fEvent;             ///< event the value was obtained for
+      Int_t             fQuantity;          ///< EQuantity
+      Double_t          fValue;             ///< value
+    };
+
+    AliConvEventSharedCache();
+    AliConvEventSharedCache(const AliConvEventSharedCache&);              // not implemented
+    AliConvEventSharedCache& operator=(const AliConvEventSharedCache&);   // not implemented
+
+    Bool_t              Update(AliVEvent *event);
+
+    Long64_t                      fEntry;                 ///< current entry of the analysis manager
+    Int_t                         fRun;                   ///< current run
+    std::vector<Value>            fValues;                ///< numbers of the current event
+    const AliVEvent*              fTriggerEvent;          ///< event of fFiredTriggerClasses
+    TString                       fFiredTriggerClasses;   ///< fired trigger classes of the current event
+    std::vector<HeaderRanges>     fHeaderRanges;          ///< header ranges of the current event
+    UInt_t                        fNHeaderRanges;         ///< number of valid entries in fHeaderRanges
+};
+
+#endif
@@ -39,8 +39,7 @@ AliConversionAODBGHandlerRP::AliConversionAODBGHandlerRP(Bool_t IsHeavyIon,Bool_
   fBinLimitsArrayRP(NULL),
   fBinLimitsArrayZ(NULL),
   fBinLimitsArrayMultiplicity(NULL),
-  fBGEvents(fNBinsRP,AliGammaConversionVertexPositionVector(fNBinsZ,AliGammaConversionBGEventVector(fNEvents)))
-//   fBGPool(fNBinsZ,AliGammaConversionMultiplicityVector(fNBinsMultiplicity,AliGammaConversionBGEventVector(fNEvents)))
+  fBGPool(fNBinsRP*fNBinsZ*fNEvents)
 {
   
   // RP angle Binning  
@@ -126,20 +125,6 @@ AliConversionAODBGHandlerRP::~AliConversionAODBGHandlerRP()
     fBGEventCounter = NULL;
   }
 
-  // Delete pool
-
-  for(Int_t psi = 0; psi < fNBinsRP; psi++){
-    for(Int_t z = 0; z < fNBinsZ; z++){
-      for(Int_t eventCounter=0; eventCounter < fNBGEvents[psi][z] && eventCounter<fNEvents; eventCounter++){
-
-          for(UInt_t d=0; d < fBGEvents[psi][z][eventCounter].size(); d++){
-            delete (AliAODConversionPhoton*)(fBGEvents[psi][z][eventCounter][d]);
-
-          }
-      }   
-    }
-  }
-
   if(fNBGEvents){
     for(Int_t psi = 0; psi < fNBinsRP; psi++){
       delete[] fNBGEvents[psi];
@@ -179,6 +164,12 @@ void AliConversionAODBGHandlerRP::Initialize(){
       fNBGEvents[psi][z] = 0;
     }
   }
+
+  // Pool
+  for(UInt_t i = 0; i < fBGPool.size(); i++){
+    fBGPool[i].fPhotons.clear();
+    fBGPool[i].fPointers.clear();
+  }
 }
 
 //-------------------------------------------------------------
@@ -277,6 +268,42 @@ Bool_t AliConversionAODBGHandlerRP::FindBins(TList * const eventGammas,AliVEvent
 }
 
 
+//-------------------------------------------------------------
+AliConversionAODBGHandlerRP::BGEvent* AliConversionAODBGHandlerRP::NextPoolEvent(Int_t psi, Int_t z){
+
+  // If Event Stack is full, replace the first entry (First in first out)
+  if(fBGEventCounter[psi][z] >= fNEvents){
+    fBGEventCounter[psi][z] = 0;
+  }
+
+  // Update number of Events stored
+  if(fNBGEvents[psi][z] < fNEvents){
+    fNBGEvents[psi][z]++;
+  }
+
+  BGEvent &bgEvent = GetPoolEvent(psi,z,fBGEventCounter[psi][z]);
+  fBGEventCounter[psi][z]++;
+
+  // clear the old gammas, the capacity is kept
+  bgEvent.fPhotons.clear();
+  bgEvent.fPointers.clear();
+  bgEvent.fE.clear();
+  bgEvent.fPx.clear();
+  bgEvent.fPy.clear();
+  bgEvent.fPz.clear();
+  return &bgEvent;
+}
+
+//-------------------------------------------------------------
+void AliConversionAODBGHandlerRP::AddPhoton(BGEvent &bgEvent, const AliAODConversionPhoton &photon){
+  // The pointers are set once the slot is filled, fPhotons can be reallocated while adding
+  bgEvent.fPhotons.push_back(photon);
+  bgEvent.fE.push_back(photon.E());
+  bgEvent.fPx.push_back(photon.Px());
+  bgEvent.fPy.push_back(photon.Py());
+  bgEvent.fPz.push_back(photon.Pz());
+}
+
 //-------------------------------------------------------------
 void AliConversionAODBGHandlerRP::AddEvent(TObjArray * const eventGammas,AliVEvent *fInputEvent){
 
@@ -286,31 +313,15 @@ void AliConversionAODBGHandlerRP::AddEvent(TObjArray * const eventGammas,AliVEve
   Int_t z;
 
   if(FindBins(eventGammas,fInputEvent,psi,z)){
-    // If Event Stack is full, replace the first entry (First in first out)
-    if(fBGEventCounter[psi][z] >= fNEvents){
-      fBGEventCounter[psi][z] = 0;
-    }
-
-    // Update number of Events stored
-    if(fNBGEvents[psi][z] < fNEvents){
-      fNBGEvents[psi][z]++;
-    }
-
-    Int_t eventCounter = fBGEventCounter[psi][z];
-
-    //clear the vector for old gammas
-    for(UInt_t d = 0; d < fBGEvents[psi][z][eventCounter].size(); d++){
-      delete (AliAODConversionPhoton*)(fBGEvents[psi][z][eventCounter][d]);
-    }
-
-    fBGEvents[psi][z][eventCounter].clear();
+    BGEvent *bgEvent = NextPoolEvent(psi,z);
 
     // add the gammas to the vector
     for(Int_t i = 0; i < eventGammas->GetEntriesFast(); i++){
-      fBGEvents[psi][z][eventCounter].push_back(new AliAODConversionPhoton(*(AliAODConversionPhoton*)(eventGammas->At(i))));
+      AddPhoton(*bgEvent,*(AliAODConversionPhoton*)(eventGammas->At(i)));
+    }
+    for(UInt_t i = 0; i < bgEvent->fPhotons.size(); i++){
+      bgEvent->fPointers.push_back(&(bgEvent->fPhotons[i]));
     }
-
-    fBGEventCounter[psi][z]++;
   }
 }
 //-------------------------------------------------------------
@@ -321,31 +332,15 @@ void AliConversionAODBGHandlerRP::AddEvent(TList * const eventGammas,AliVEvent *
   Int_t z;
 
   if(FindBins(eventGammas,fInputEvent,psi,z)){
-    // If Event Stack is full, replace the first entry (First in first out)
-    if(fBGEventCounter[psi][z] >= fNEvents){
-        fBGEventCounter[psi][z]=0;
-    }
-
-    // Update number of Events stored
-    if(fNBGEvents[psi][z] < fNEvents){
-      fNBGEvents[psi][z]++;
-    }
-
-    Int_t eventCounter = fBGEventCounter[psi][z];
-
-    //clear the vector for old gammas
-    for(UInt_t d = 0; d < fBGEvents[psi][z][eventCounter].size(); d++){
-      delete (AliAODConversionPhoton*)(fBGEvents[psi][z][eventCounter][d]);
-    }
-
-    fBGEvents[psi][z][eventCounter].clear();
+    BGEvent *bgEvent = NextPoolEvent(psi,z);
 
     // add the gammas to the vector
     for(Int_t i = 0; i < eventGammas->GetEntries(); i++){
-      fBGEvents[psi][z][eventCounter].push_back(new AliAODConversionPhoton(*(AliAODConversionPhoton*)(eventGammas->At(i))));
+      AddPhoton(*bgEvent,*(AliAODConversionPhoton*)(eventGammas->At(i)));
+    }
+    for(UInt_t i = 0; i < bgEvent->fPhotons.size(); i++){
+      bgEvent->fPointers.push_back(&(bgEvent->fPhotons[i]));
     }
-
-    fBGEventCounter[psi][z]++;
   }
 }
 
@@ -355,7 +350,7 @@ AliGammaConversionPhotonVector* AliConversionAODBGHandlerRP::GetBGGoodGammas(TOb
   Int_t zbin;
 
   if(FindBins(eventGammas,fInputEvent,psibin,zbin)){
-    return &(fBGEvents[psibin][zbin][event]);
+    return &(GetPoolEvent(psibin,zbin,event).fPointers);
   }
   return NULL;
 }
@@ -365,7 +360,18 @@ AliGammaConversionPhotonVector* AliConversionAODBGHandlerRP::GetBGGoodGammas(TLi
   Int_t zbin;
 
   if(FindBins(eventGammas,fInputEvent,psibin,zbin)){
-    return &(fBGEvents[psibin][zbin][event]);
+    return &(GetPoolEvent(psibin,zbin,event).fPointers);
+  }
+  return NULL;
+}
+
+//-------------------------------------------------------------
+const AliConversionAODBGHandlerRP::BGEvent* AliConversionAODBGHandlerRP::GetBGEvent(TList * const eventGammas,AliVEvent *fInputEvent,Int_t event){
+  Int_t psibin;
+  Int_t zbin;
+
+  if(FindBins(eventGammas,fInputEvent,psibin,zbin)){
+    return &(GetPoolEvent(psibin,zbin,event));
   }
   return NULL;
 }
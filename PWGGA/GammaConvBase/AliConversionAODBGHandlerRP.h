@@ -25,6 +25,20 @@ class AliConversionAODBGHandlerRP: public TObject{
 
   public:
 
+    // One slot of the ring buffer of a (RP angle, z vertex) bin. The photons are stored by value and
+    // the vectors keep their capacity when the slot is reused, so that no allocation is needed once
+    // the pool is warm. The kinematics are also kept as arrays for the pair kernels, see
+    // AliConversionMesonCuts::MesonsArePreSelected.
+    struct BGEvent {
+      std::vector<AliAODConversionPhoton>   fPhotons;           // copies of the photons of the event
+      AliGammaConversionPhotonVector        fPointers;          // pointers to fPhotons, as returned by GetBGGoodGammas
+      std::vector<Double_t>                 fE;                 // energy
+      std::vector<Double_t>                 fPx;                // momentum x
+      std::vector<Double_t>                 fPy;                // momentum y
+      std::vector<Double_t>                 fPz;                // momentum z
+      Int_t GetN() const { return fPointers.size(); }
+    };
+
     AliConversionAODBGHandlerRP                     ( Bool_t IsHeavyIon=kFALSE,
                                                       Bool_t UseChargedTrackMult=kTRUE,
                                                       Int_t NEvents=10 );
@@ -51,6 +65,9 @@ class AliConversionAODBGHandlerRP: public TObject{
     AliGammaConversionPhotonVector* GetBGGoodGammas ( TList * const eventGammas, 
                                                       AliVEvent *fInputEvent,
                                                       Int_t event );
+    const BGEvent* GetBGEvent                       ( TList * const eventGammas,
+                                                      AliVEvent *fInputEvent,
+                                                      Int_t event );
     void AddEvent                                   ( TObjArray * const eventGammas,
                                                       AliVEvent *fInputEvent );
     void AddEvent                                   ( TList * const eventGammas, 
@@ -76,13 +93,17 @@ class AliConversionAODBGHandlerRP: public TObject{
     Double_t*                   fBinLimitsArrayRP;                //! bin limits RP array    
     Double_t*                   fBinLimitsArrayZ;                 //! bin limits z array
     Double_t*                   fBinLimitsArrayMultiplicity;      //! bin limit multiplicity array
-    AliGammaConversionBGVector  fBGEvents;                        //background events
-//     AliGammaConversionBGVector  fBGPool;                          //background events
+    std::vector<BGEvent>        fBGPool;                          //! background events, [(psi*fNBinsZ+z)*fNEvents+event]
+
+    BGEvent& GetPoolEvent                           ( Int_t psi, Int_t z, Int_t event )             { return fBGPool[(psi*fNBinsZ+z)*fNEvents+event] ;}
+    BGEvent* NextPoolEvent                          ( Int_t psi, Int_t z );
+    void AddPhoton                                  ( BGEvent &bgEvent,
+                                                      const AliAODConversionPhoton &photon );
 
     AliConversionAODBGHandlerRP(AliConversionAODBGHandlerRP &original);
     AliConversionAODBGHandlerRP &operator=(const AliConversionAODBGHandlerRP &ref);
 
-  ClassDef(AliConversionAODBGHandlerRP,1);
+  ClassDef(AliConversionAODBGHandlerRP,2);
 
 };
 #endif
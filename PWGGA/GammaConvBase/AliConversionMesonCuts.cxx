@@ -1647,6 +1647,86 @@ Bool_t AliConversionMesonCuts::MesonIsSelected(AliAODConversionMother *pi0,Bool_
 
 
 
+//________________________________________________________________________
+void AliConversionMesonCuts::MesonsArePreSelected(const AliAODConversionPhoton *gamma0, Int_t n, const Double_t *e, const Double_t *px, const Double_t *py, const Double_t *pz, Double_t fRapidityShift, UChar_t *selected)
+{
+  // Pre-selection of the background candidates of gamma0 with the n photons given as
+  // arrays (e.g. AliConversionAODBGHandlerRP::BGEvent). Applies the cuts of MesonIsSelected
+  // which only depend on the photon momenta (rapidity, opening angle, alpha) in the same
+  // order, without building the candidates. The rejected candidates are counted in the
+  // background cut histogram as MesonIsSelected would do, the selected ones still have to
+  // go through MesonIsSelected. Only for conversion photons, otherwise all are selected.
+
+  if (fIsMergedClusterCut != 0){
+    for (Int_t i = 0; i < n; i++) selected[i] = 1;
+    return;
+  }
+
+  const Double_t e0  = gamma0->E();
+  const Double_t px0 = gamma0->Px();
+  const Double_t py0 = gamma0->Py();
+  const Double_t pz0 = gamma0->Pz();
+  const Double_t mag20 = px0*px0 + py0*py0 + pz0*pz0;
+
+  for (Int_t i = 0; i < n; i++){
+    selected[i] = 0;
+    const Double_t eSum  = e0 + e[i];
+    const Double_t pxSum = px0 + px[i];
+    const Double_t pySum = py0 + py[i];
+    const Double_t pzSum = pz0 + pz[i];
+    const Double_t pt = TMath::Sqrt(pxSum*pxSum + pySum*pySum);
+
+    // Undefined Rapidity
+    if(eSum==pzSum || (eSum+pzSum)/(eSum-pzSum)<=0){
+      if(fHistoMesonBGCuts){
+        fHistoMesonBGCuts->Fill(0., pt);
+        fHistoMesonBGCuts->Fill(1., pt);
+      }
+      cout << "undefined rapidity" << endl;
+      continue;
+    }
+
+    Int_t cutIndex = -1;
+    const Double_t rapidity = 0.5*TMath::Log((eSum+pzSum)/(eSum-pzSum));
+    if( (rapidity-fRapidityShift)<fRapidityCutMesonMin || (rapidity-fRapidityShift)>fRapidityCutMesonMax){
+      cutIndex = 2;
+    } else {
+      // Opening Angle, as TVector3::Angle
+      Double_t openingAngle = 0.;
+      const Double_t ptot2 = mag20*(px[i]*px[i] + py[i]*py[i] + pz[i]*pz[i]);
+      if (ptot2 > 0){
+        Double_t arg = (px0*px[i] + py0*py[i] + pz0*pz[i])/TMath::Sqrt(ptot2);
+        if (arg > 1.0) arg = 1.0;
+        if (arg < -1.0) arg = -1.0;
+        openingAngle = TMath::ACos(arg);
+      }
+      if (fMinOpanPtDepCut == kTRUE) fMinOpanCutMeson = fFMinOpanCut->Eval(pt);
+      if (fMaxOpanPtDepCut == kTRUE) fMaxOpanCutMeson = fFMaxOpanCut->Eval(pt);
+      if( (fEnableMinOpeningAngleCut && openingAngle < fOpeningAngle) || openingAngle < fMinOpanCutMeson || openingAngle > fMaxOpanCutMeson){
+        cutIndex = 3;
+      } else {
+        // Alpha
+        const Double_t alpha = (eSum != 0) ? (e0-e[i])/eSum : -1;
+        if (fAlphaPtDepCut == kTRUE) fAlphaCutMeson = fFAlphaCut->Eval(pt);
+        if(TMath::Abs(alpha)>fAlphaCutMeson){
+          cutIndex = 4;
+        } else if(TMath::Abs(alpha)<fAlphaMinCutMeson){
+          cutIndex = 5;
+        }
+      }
+    }
+
+    if (cutIndex >= 0){
+      if(fHistoMesonBGCuts){
+        fHistoMesonBGCuts->Fill(0., pt);
+        fHistoMesonBGCuts->Fill(cutIndex, pt);
+      }
+      continue;
+    }
+    selected[i] = 1;
+  }
+}
+
 //________________________________________________________________________
 //________________________________________________________________________
 Bool_t AliConversionMesonCuts::UpdateCutString() {
@@ -291,6 +291,9 @@ fMinJetPt(0.0),
 fSoftDropZCut(0.1),
 fSoftDropBeta(0.0),
 fTrackingEfficiency(1.0),
+fJetStreaming(false),
+fHFJetFinder(nullptr),
+fHFGenJetFinder(nullptr),
 fGoodTrackFilterBit(-1),
 fGoodTrackEtaRange(999.),
 fGoodTrackMinPt(0.),
@@ -342,6 +345,14 @@ fApplyPhysicsSelOnline(false),
 fEnableEventDownsampling(false),
 fFracToKeepEventDownsampling(1.1),
 fSeedEventDownsampling(0),
+fTreeOutputLayout(AliHFTreeHandler::kStandardLayout),
+fTreeEntriesPerCluster(50000),
+fTreeCompressionSettings(-1),
+fTreeTruncationPatterns(),
+fTreeTruncationBits(),
+fCandDownsamplingPtLims(),
+fCandDownsamplingFracToKeep(),
+fSeedCandDownsampling(0),
 fCdbEntry(nullptr)
 {
   fParticleCollArray.SetOwner(kTRUE);
@@ -516,6 +527,10 @@ AliAnalysisTaskSEHFTreeCreator::~AliAnalysisTaskSEHFTreeCreator()
   delete fTreeHandlerGenLc2V0bachelor;
   delete fTreeHandlerGenLb;
   delete fTreeHandlerGenParticle;
+#ifdef HAVE_FASTJET
+  delete fHFJetFinder;
+  delete fHFGenJetFinder;
+#endif
   delete fTreeEvChar;
 }
 
@@ -688,11 +703,14 @@ void AliAnalysisTaskSEHFTreeCreator::UserCreateOutputObjects()
   fTreeEvChar->Branch("trials", &fTrials);
   fTreeEvChar->Branch("pthard", &fpthard);
   fTreeEvChar->SetMaxVirtualSize(1.e+8/nEnabledTrees);
+
+  if(fFillJets && fJetStreaming) CreateStreamingJetFinders();
   
   if(fWriteVariableTreeD0){
     OpenFile(6);
     TString nameoutput = "tree_D0";
     fTreeHandlerD0 = new AliHFTreeHandlerD0toKpi(fPIDoptD0);
+    ConfigureTreeHandlerOutput(fTreeHandlerD0,false);
     fTreeHandlerD0->SetOptSingleTrackVars(fTreeSingleTrackVarsOpt);
     if(fReadMC && fWriteOnlySignal) fTreeHandlerD0->SetFillOnlySignal(fWriteOnlySignal);
     if(fEnableNsigmaTPCDataCorr) fTreeHandlerD0->EnableNsigmaTPCDataDrivenCorrection(fSystemForNsigmaTPCDataCorr);
@@ -709,6 +727,7 @@ void AliAnalysisTaskSEHFTreeCreator::UserCreateOutputObjects()
       OpenFile(7);
       TString nameoutput = "tree_D0_gen";
       fTreeHandlerGenD0 = new AliHFTreeHandlerD0toKpi(0);
+      ConfigureTreeHandlerOutput(fTreeHandlerGenD0,true);
       fTreeHandlerGenD0->SetFillJets(fFillJets);
       fTreeHandlerGenD0->SetDoJetSubstructure(fDoJetSubstructure);
       fTreeHandlerGenD0->SetJetProperties(fJetRadius,fJetAlgorithm,fMinJetPt);
@@ -722,6 +741,7 @@ void AliAnalysisTaskSEHFTreeCreator::UserCreateOutputObjects()
     OpenFile(8);
     TString nameoutput = "tree_Ds";
     fTreeHandlerDs = new AliHFTreeHandlerDstoKKpi(fPIDoptDs);
+    ConfigureTreeHandlerOutput(fTreeHandlerDs,false);
     fTreeHandlerDs->SetOptSingleTrackVars(fTreeSingleTrackVarsOpt);
     if(fReadMC && fWriteOnlySignal) fTreeHandlerDs->SetFillOnlySignal(fWriteOnlySignal);
     if(fEnableNsigmaTPCDataCorr) fTreeHandlerDs->EnableNsigmaTPCDataDrivenCorrection(fSystemForNsigmaTPCDataCorr);
@@ -739,6 +759,7 @@ void AliAnalysisTaskSEHFTreeCreator::UserCreateOutputObjects()
       OpenFile(9);
       TString nameoutput = "tree_Ds_gen";
       fTreeHandlerGenDs = new AliHFTreeHandlerDstoKKpi(0);
+      ConfigureTreeHandlerOutput(fTreeHandlerGenDs,true);
       fTreeHandlerGenDs->SetFillJets(fFillJets);
       fTreeHandlerGenDs->SetDoJetSubstructure(fDoJetSubstructure);
       fTreeHandlerGenDs->SetJetProperties(fJetRadius,fJetAlgorithm,fMinJetPt);
@@ -752,6 +773,7 @@ void AliAnalysisTaskSEHFTreeCreator::UserCreateOutputObjects()
     OpenFile(10);
     TString nameoutput = "tree_Dplus";
     fTreeHandlerDplus = new AliHFTreeHandlerDplustoKpipi(fPIDoptDplus);
+    ConfigureTreeHandlerOutput(fTreeHandlerDplus,false);
     fTreeHandlerDplus->SetOptSingleTrackVars(fTreeSingleTrackVarsOpt);
     if(fReadMC && fWriteOnlySignal) fTreeHandlerDplus->SetFillOnlySignal(fWriteOnlySignal);
     if(fEnableNsigmaTPCDataCorr) fTreeHandlerDplus->EnableNsigmaTPCDataDrivenCorrection(fSystemForNsigmaTPCDataCorr);
@@ -767,6 +789,7 @@ void AliAnalysisTaskSEHFTreeCreator::UserCreateOutputObjects()
       OpenFile(11);
       TString nameoutput = "tree_Dplus_gen";
       fTreeHandlerGenDplus = new AliHFTreeHandlerDplustoKpipi(0);
+      ConfigureTreeHandlerOutput(fTreeHandlerGenDplus,true);
       fTreeHandlerGenDplus->SetFillJets(fFillJets);
       fTreeHandlerGenDplus->SetDoJetSubstructure(fDoJetSubstructure);
       fTreeHandlerGenDplus->SetJetProperties(fJetRadius,fJetAlgorithm,fMinJetPt);
@@ -780,6 +803,7 @@ void AliAnalysisTaskSEHFTreeCreator::UserCreateOutputObjects()
     OpenFile(12);
     TString nameoutput = "tree_LctopKpi";
     fTreeHandlerLctopKpi = new AliHFTreeHandlerLctopKpi(fPIDoptLctopKpi);
+    ConfigureTreeHandlerOutput(fTreeHandlerLctopKpi,false);
     fTreeHandlerLctopKpi->SetOptSingleTrackVars(fTreeSingleTrackVarsOpt);
     if(fReadMC && fWriteOnlySignal) fTreeHandlerLctopKpi->SetFillOnlySignal(fWriteOnlySignal);
     if(fEnableNsigmaTPCDataCorr) fTreeHandlerLctopKpi->EnableNsigmaTPCDataDrivenCorrection(fSystemForNsigmaTPCDataCorr);
@@ -795,6 +819,7 @@ void AliAnalysisTaskSEHFTreeCreator::UserCreateOutputObjects()
       OpenFile(13);
       TString nameoutput = "tree_LctopKpi_gen";
       fTreeHandlerGenLctopKpi = new AliHFTreeHandlerLctopKpi(0);
+      ConfigureTreeHandlerOutput(fTreeHandlerGenLctopKpi,true);
       fTreeHandlerGenLctopKpi->SetFillJets(fFillJets);
       fTreeHandlerGenLctopKpi->SetDoJetSubstructure(fDoJetSubstructure);
       fTreeHandlerGenLctopKpi->SetJetProperties(fJetRadius,fJetAlgorithm,fMinJetPt);
@@ -809,6 +834,7 @@ void AliAnalysisTaskSEHFTreeCreator::UserCreateOutputObjects()
     OpenFile(14);
     TString nameoutput = "tree_Bplus";
     fTreeHandlerBplus = new AliHFTreeHandlerBplustoD0pi(fPIDoptBplus);
+    ConfigureTreeHandlerOutput(fTreeHandlerBplus,false);
     fTreeHandlerBplus->SetOptSingleTrackVars(fTreeSingleTrackVarsOpt);
     if(fReadMC && fWriteOnlySignal) fTreeHandlerBplus->SetFillOnlySignal(fWriteOnlySignal);
     if(fEnableNsigmaTPCDataCorr) fTreeHandlerBplus->EnableNsigmaTPCDataDrivenCorrection(fSystemForNsigmaTPCDataCorr);
@@ -824,6 +850,7 @@ void AliAnalysisTaskSEHFTreeCreator::UserCreateOutputObjects()
       OpenFile(15);
       TString nameoutput = "tree_Bplus_gen";
       fTreeHandlerGenBplus = new AliHFTreeHandlerBplustoD0pi(0);
+      ConfigureTreeHandlerOutput(fTreeHandlerGenBplus,true);
       fTreeHandlerGenBplus->SetFillJets(fFillJets);
       fTreeHandlerGenBplus->SetDoJetSubstructure(fDoJetSubstructure);
       fTreeHandlerGenBplus->SetJetProperties(fJetRadius,fJetAlgorithm,fMinJetPt);
@@ -837,6 +864,7 @@ void AliAnalysisTaskSEHFTreeCreator::UserCreateOutputObjects()
     OpenFile(16);
     TString nameoutput = "tree_Dstar";
     fTreeHandlerDstar = new AliHFTreeHandlerDstartoKpipi(fPIDoptDstar);
+    ConfigureTreeHandlerOutput(fTreeHandlerDstar,false);
     fTreeHandlerDstar->SetOptSingleTrackVars(fTreeSingleTrackVarsOpt);
     if(fReadMC && fWriteOnlySignal) fTreeHandlerDstar->SetFillOnlySignal(fWriteOnlySignal);
     if(fEnableNsigmaTPCDataCorr) fTreeHandlerDstar->EnableNsigmaTPCDataDrivenCorrection(fSystemForNsigmaTPCDataCorr);
@@ -852,6 +880,7 @@ void AliAnalysisTaskSEHFTreeCreator::UserCreateOutputObjects()
       OpenFile(17);
       TString nameoutput = "tree_Dstar_gen";
       fTreeHandlerGenDstar = new AliHFTreeHandlerDstartoKpipi(0);
+      ConfigureTreeHandlerOutput(fTreeHandlerGenDstar,true);
       fTreeHandlerGenDstar->SetFillJets(fFillJets);
       fTreeHandlerGenDstar->SetDoJetSubstructure(fDoJetSubstructure);
       fTreeHandlerGenDstar->SetJetProperties(fJetRadius,fJetAlgorithm,fMinJetPt);
@@ -865,6 +894,7 @@ void AliAnalysisTaskSEHFTreeCreator::UserCreateOutputObjects()
     OpenFile(18);
     TString nameoutput = "tree_Lc2V0bachelor";
     fTreeHandlerLc2V0bachelor = new AliHFTreeHandlerLc2V0bachelor(fPIDoptLc2V0bachelor);
+    ConfigureTreeHandlerOutput(fTreeHandlerLc2V0bachelor,false);
     fTreeHandlerLc2V0bachelor->SetOptSingleTrackVars(fTreeSingleTrackVarsOpt);
     if(fReadMC && fWriteOnlySignal) fTreeHandlerLc2V0bachelor->SetFillOnlySignal(fWriteOnlySignal);
     if(fEnableNsigmaTPCDataCorr) fTreeHandlerLc2V0bachelor->EnableNsigmaTPCDataDrivenCorrection(fSystemForNsigmaTPCDataCorr);
@@ -881,6 +911,7 @@ void AliAnalysisTaskSEHFTreeCreator::UserCreateOutputObjects()
       OpenFile(19);
       TString nameoutput = "tree_Lc2V0bachelor_gen";
       fTreeHandlerGenLc2V0bachelor = new AliHFTreeHandlerLc2V0bachelor(0);
+      ConfigureTreeHandlerOutput(fTreeHandlerGenLc2V0bachelor,true);
       fTreeHandlerGenLc2V0bachelor->SetFillJets(fFillJets);
       fTreeHandlerGenLc2V0bachelor->SetDoJetSubstructure(fDoJetSubstructure);
       fTreeHandlerGenLc2V0bachelor->SetJetProperties(fJetRadius,fJetAlgorithm,fMinJetPt);
@@ -894,6 +925,7 @@ void AliAnalysisTaskSEHFTreeCreator::UserCreateOutputObjects()
     OpenFile(20);
     TString nameoutput = "tree_Bs";
     fTreeHandlerBs = new AliHFTreeHandlerBstoDspi(fPIDoptBs);
+    ConfigureTreeHandlerOutput(fTreeHandlerBs,false);
     fTreeHandlerBs->SetOptSingleTrackVars(fTreeSingleTrackVarsOpt);
     if(fReadMC && fWriteOnlySignal) fTreeHandlerBs->SetFillOnlySignal(fWriteOnlySignal);
     if(fEnableNsigmaTPCDataCorr) fTreeHandlerBs->EnableNsigmaTPCDataDrivenCorrection(fSystemForNsigmaTPCDataCorr);
@@ -910,6 +942,7 @@ void AliAnalysisTaskSEHFTreeCreator::UserCreateOutputObjects()
       OpenFile(21);
       TString nameoutput = "tree_Bs_gen";
       fTreeHandlerGenBs = new AliHFTreeHandlerBstoDspi(0);
+      ConfigureTreeHandlerOutput(fTreeHandlerGenBs,true);
       fTreeHandlerGenBs->SetFillJets(fFillJets);
       fTreeHandlerGenBs->SetDoJetSubstructure(fDoJetSubstructure);
       fTreeHandlerGenBs->SetJetProperties(fJetRadius,fJetAlgorithm,fMinJetPt);
@@ -923,6 +956,7 @@ void AliAnalysisTaskSEHFTreeCreator::UserCreateOutputObjects()
     OpenFile(22);
     TString nameoutput = "tree_Lb";
     fTreeHandlerLb = new AliHFTreeHandlerLbtoLcpi(fPIDoptLb);
+    ConfigureTreeHandlerOutput(fTreeHandlerLb,false);
     fTreeHandlerLb->SetOptSingleTrackVars(fTreeSingleTrackVarsOpt);
     if(fReadMC && fWriteOnlySignal) fTreeHandlerLb->SetFillOnlySignal(fWriteOnlySignal);
     if(fEnableNsigmaTPCDataCorr) fTreeHandlerLb->EnableNsigmaTPCDataDrivenCorrection(fSystemForNsigmaTPCDataCorr);
@@ -939,6 +973,7 @@ void AliAnalysisTaskSEHFTreeCreator::UserCreateOutputObjects()
       OpenFile(23);
       TString nameoutput = "tree_Lb_gen";
       fTreeHandlerGenLb = new AliHFTreeHandlerLbtoLcpi(0);
+      ConfigureTreeHandlerOutput(fTreeHandlerGenLb,true);
       fTreeHandlerGenLb->SetFillJets(fFillJets);
       fTreeHandlerGenLb->SetDoJetSubstructure(fDoJetSubstructure);
       fTreeHandlerGenLb->SetJetProperties(fJetRadius,fJetAlgorithm,fMinJetPt);
@@ -954,6 +989,7 @@ void AliAnalysisTaskSEHFTreeCreator::UserCreateOutputObjects()
     OpenFile(24);
     TString nameoutput = "tree_InclusiveJet";
     fTreeHandlerInclusiveJet = new AliHFTreeHandlerInclusiveJet();
+    ConfigureTreeHandlerOutput(fTreeHandlerInclusiveJet,false);
     fTreeHandlerInclusiveJet->SetFillJets(fFillJets);
     fTreeHandlerInclusiveJet->SetDoJetSubstructure(fDoJetSubstructure);
     fTreeHandlerInclusiveJet->SetTrackingEfficiency(fTrackingEfficiency);
@@ -967,6 +1003,7 @@ void AliAnalysisTaskSEHFTreeCreator::UserCreateOutputObjects()
       OpenFile(25);
       TString nameoutput = "tree_InclusiveJet_gen";
       fTreeHandlerGenInclusiveJet = new AliHFTreeHandlerInclusiveJet();
+      ConfigureTreeHandlerOutput(fTreeHandlerGenInclusiveJet,true);
       fTreeHandlerGenInclusiveJet->SetFillJets(fFillJets);
       fTreeHandlerGenInclusiveJet->SetDoJetSubstructure(fDoJetSubstructure);
       fTreeHandlerGenInclusiveJet->SetJetProperties(fJetRadius,fJetAlgorithm,fMinJetPt);
@@ -1044,6 +1081,7 @@ void AliAnalysisTaskSEHFTreeCreator::UserCreateOutputObjects()
   
   //Set seed of gRandom
   if(fEnableEventDownsampling) gRandom->SetSeed(fSeedEventDownsampling);
+  else if(!fCandDownsamplingPtLims.empty()) gRandom->SetSeed(fSeedCandDownsampling);
 
   // Post the data
   PostData(1,fNentries);
@@ -1591,6 +1629,12 @@ void AliAnalysisTaskSEHFTreeCreator::UserExec(Option_t */*option*/)
   fTreeEvChar->Fill(); 
   //get PID response
   if(!fPIDresp) fPIDresp = ((AliInputEventHandler*)(AliAnalysisManager::GetAnalysisManager()->GetInputEventHandler()))->GetPIDResponse();
+
+#ifdef HAVE_FASTJET
+  //the event is clustered at the first candidate (streaming mode)
+  if(fHFJetFinder) fHFJetFinder->SetEvent(aod->GetTracks());
+  if(fHFGenJetFinder) fHFGenJetFinder->SetMCEvent(mcArray);
+#endif
   
   if(fWriteVariableTreeD0) Process2Prong(array2prong,aod,mcArray,aod->GetMagneticField(),mcHeader);
   if(fWriteVariableTreeDs || fWriteVariableTreeDplus || fWriteVariableTreeLctopKpi) Process3Prong(array3Prong,aod,mcArray,aod->GetMagneticField(),mcHeader);
@@ -4252,6 +4296,53 @@ AliAODVertex* AliAnalysisTaskSEHFTreeCreator::ReconstructDisplVertex(const AliVV
   return vertexAOD;
 }
 
+//________________________________________________________________
+void AliAnalysisTaskSEHFTreeCreator::ConfigureTreeHandlerOutput(AliHFTreeHandler* handler, bool isgen) {
+  //
+  // Output layout, float truncation and (for reconstructed candidates) downsampling of a candidate tree
+  //
+
+  handler->SetOutputLayout(fTreeOutputLayout,fTreeEntriesPerCluster,fTreeCompressionSettings);
+  for(size_t iPattern=0; iPattern<fTreeTruncationPatterns.size(); iPattern++)
+    handler->SetFloatTruncation(fTreeTruncationPatterns[iPattern],fTreeTruncationBits[iPattern]);
+  if(!isgen && !fCandDownsamplingPtLims.empty())
+    handler->SetCandidateDownsampling(fCandDownsamplingFracToKeep.size(),fCandDownsamplingPtLims.data(),fCandDownsamplingFracToKeep.data());
+  handler->SetJetFinders(isgen ? nullptr : fHFJetFinder,fHFGenJetFinder);
+}
+
+//________________________________________________________________
+void AliAnalysisTaskSEHFTreeCreator::CreateStreamingJetFinders() {
+  //
+  // Jet finders shared by the tree handlers: the event is clustered once and, for each candidate,
+  // only the jets close to it are reclustered with the daughters replaced by the candidate
+  //
+
+#ifdef HAVE_FASTJET
+  fHFJetFinder = new AliHFJetFinder();
+  fHFJetFinder->SetJetRadius(fJetRadius);
+  fHFJetFinder->SetJetAlgorithm(fJetAlgorithm);
+  fHFJetFinder->SetMinJetPt(fMinJetPt);
+  fHFJetFinder->SetSubJetRadius(fSubJetRadius);
+  fHFJetFinder->SetSubJetAlgorithm(fSubJetAlgorithm);
+  fHFJetFinder->SetDoJetSubstructure(fDoJetSubstructure);
+  fHFJetFinder->SetSoftDropParams(fSoftDropZCut,fSoftDropBeta);
+  fHFJetFinder->SetTrackingEfficiency(fTrackingEfficiency);
+
+  if(fReadMC) {
+    fHFGenJetFinder = new AliHFJetFinder();
+    fHFGenJetFinder->SetJetRadius(fJetRadius);
+    fHFGenJetFinder->SetJetAlgorithm(fJetAlgorithm);
+    fHFGenJetFinder->SetMinJetPt(fMinJetPt);
+    fHFGenJetFinder->SetSubJetRadius(fSubJetRadius);
+    fHFGenJetFinder->SetSubJetAlgorithm(fSubJetAlgorithm);
+    fHFGenJetFinder->SetDoJetSubstructure(fDoJetSubstructure);
+    fHFGenJetFinder->SetSoftDropParams(fSoftDropZCut,fSoftDropBeta);
+  }
+#else
+  AliWarning("Jet streaming mode needs fastjet, jets are found for each candidate");
+#endif
+}
+
 //________________________________________________________________
 unsigned int AliAnalysisTaskSEHFTreeCreator::GetEvID() {
   TString currentfilename = ((AliAnalysisManager::GetAnalysisManager()->GetInputEventHandler()->GetTree()->GetCurrentFile()))->GetName();
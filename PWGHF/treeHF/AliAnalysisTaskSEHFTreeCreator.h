@@ -158,6 +158,7 @@ public:
     void SetSoftDropZCut(Double_t d) {fSoftDropZCut = d; }
     void SetSoftDropBeta(Double_t d) {fSoftDropBeta = d; }
     void SetTrackingEfficiency(Double_t d) {fTrackingEfficiency = d;}
+    void SetJetStreaming(bool b) {fJetStreaming = b; }
     void SetDoPtHard(bool b) {fDoPtHard = b;}
   
     void SetGoodTrackFilterBit(Int_t i) { fGoodTrackFilterBit = i; }
@@ -201,6 +202,8 @@ public:
     
     void SelectGoodTrackForReconstruction(AliAODEvent *aod, Int_t trkEntries, Int_t &nSeleTrks,Bool_t *seleFlags);
     AliAODVertex* ReconstructDisplVertex(const AliVVertex *primary, TObjArray *tracks, Double_t bField, Double_t dispersion);
+    void ConfigureTreeHandlerOutput(AliHFTreeHandler* handler, bool isgen);
+    void CreateStreamingJetFinders();
   
     void SetNsigmaTPCDataDrivenCorrection(Int_t syst) {
         fEnableNsigmaTPCDataCorr=true; 
@@ -215,6 +218,22 @@ public:
         fSeedEventDownsampling = seed;
     }
 
+    // Output layout of the candidate trees (see AliHFTreeHandler::SetOutputLayout)
+    void SetTreeOutputLayout(int layout, Long64_t entriesPerCluster=50000, int compression=-1) {
+        fTreeOutputLayout = layout;
+        fTreeEntriesPerCluster = entriesPerCluster;
+        fTreeCompressionSettings = compression;
+    }
+    void SetTreeFloatTruncation(TString branchpattern, int nMantissaBits) {
+        fTreeTruncationPatterns.push_back(branchpattern);
+        fTreeTruncationBits.push_back(nMantissaBits);
+    }
+    void EnableCandidateDownsampling(int nPtBins, const float* ptlims, const float* fractokeep, unsigned long seed) {
+        fCandDownsamplingPtLims.assign(ptlims,ptlims+nPtBins+1);
+        fCandDownsamplingFracToKeep.assign(fractokeep,fractokeep+nPtBins);
+        fSeedCandDownsampling = seed;
+    }
+
     // Particles (tracks or MC particles)
     //-----------------------------------------------------------------------------------------------
     void                        SetFillParticleTree(Bool_t b) {fFillParticleTree = b;}
@@ -444,6 +463,9 @@ private:
     Double_t                fSoftDropZCut;                         /// setting the soft drop z parameter
     Double_t                fSoftDropBeta;                         /// setting the soft drop beta parameter
     Double_t                fTrackingEfficiency;                   /// Setting the jet finding tracking efficiency
+    bool                    fJetStreaming;                         /// cluster the event once and recluster only the jets close to each candidate
+    AliHFJetFinder*         fHFJetFinder;                          //!<! jet finder shared by the tree handlers in streaming mode
+    AliHFJetFinder*         fHFGenJetFinder;                       //!<! jet finder for generated jets shared by the tree handlers in streaming mode
   
     Int_t                   fGoodTrackFilterBit;                   /// Setting filter bit for bachelor on-the-fly reconstruction candidate
     Double_t                fGoodTrackEtaRange;                    /// Setting eta-range for bachelor on-the-fly reconstruction candidate
@@ -526,10 +548,19 @@ private:
     float fFracToKeepEventDownsampling;                            /// fraction of events to be kept by event downsampling
     unsigned long fSeedEventDownsampling;                          /// seed for event downsampling
 
+    int fTreeOutputLayout;                                         /// output layout of the candidate trees
+    Long64_t fTreeEntriesPerCluster;                               /// entries per cluster for the column-chunked layout
+    int fTreeCompressionSettings;                                  /// compression settings of the candidate tree branches (-1: output file ones)
+    std::vector<TString> fTreeTruncationPatterns;                  /// wildcard patterns of the float branches to be truncated
+    std::vector<int> fTreeTruncationBits;                          /// mantissa bits kept for each pattern
+    std::vector<float> fCandDownsamplingPtLims;                    /// pt limits of the candidate downsampling
+    std::vector<float> fCandDownsamplingFracToKeep;                /// fraction of background candidates kept in each pt bin
+    unsigned long fSeedCandDownsampling;                           /// seed for candidate downsampling
+
     AliCDBEntry *fCdbEntry;
 
     /// \cond CLASSIMP
-    ClassDef(AliAnalysisTaskSEHFTreeCreator,30);
+    ClassDef(AliAnalysisTaskSEHFTreeCreator,32);
     /// \endcond
 };
 
@@ -12,6 +12,7 @@
 
 #include <cmath>
 #include <limits>
+#include <algorithm>
 #include "AliHFJetFinder.h"
 #include "TMath.h"
 #include "TRandom3.h"
@@ -47,7 +48,26 @@ AliHFJetFinder::AliHFJetFinder():
   fCharged(Charge::charged),
   fTrackingEfficiency(1.0),
   fDoJetSubstructure(false),
-  fFastJetWrapper(0x0)
+  fFastJetWrapper(0x0),
+  fRandom(0),
+  fEventArray(nullptr),
+  fEventIsMC(kFALSE),
+  fEventClustered(kFALSE),
+  fNJetsReclustered(0),
+  fEventInputs(),
+  fEventJets(),
+  fLocalInputs(),
+  fLocalJets(),
+  fConstituents(),
+  fEventInputIDs(),
+  fEventJetOfInput(),
+  fEventJetFirstInput(),
+  fEventJetInputs(),
+  fEventJetBoxes(),
+  fJetInRegion(),
+  fInputRemoved(),
+  fHFJet(),
+  fHFJets()
 {
   //
   // Default constructor
@@ -80,7 +100,26 @@ AliHFJetFinder::AliHFJetFinder(char *name):
   fCharged(Charge::charged),
   fTrackingEfficiency(1.0),
   fDoJetSubstructure(false),
-  fFastJetWrapper(0x0)
+  fFastJetWrapper(0x0),
+  fRandom(0),
+  fEventArray(nullptr),
+  fEventIsMC(kFALSE),
+  fEventClustered(kFALSE),
+  fNJetsReclustered(0),
+  fEventInputs(),
+  fEventJets(),
+  fLocalInputs(),
+  fLocalJets(),
+  fConstituents(),
+  fEventInputIDs(),
+  fEventJetOfInput(),
+  fEventJetFirstInput(),
+  fEventJetInputs(),
+  fEventJetBoxes(),
+  fJetInRegion(),
+  fInputRemoved(),
+  fHFJet(),
+  fHFJets()
 {
 }
 
@@ -100,7 +139,7 @@ void AliHFJetFinder::SetFJWrapper()
 {
 
   
-  fFastJetWrapper = new AliFJWrapper("fFastJetWrapper","fFastJetWrapper");
+  if (!fFastJetWrapper) fFastJetWrapper = new AliFJWrapper("fFastJetWrapper","fFastJetWrapper");
 
   fFastJetWrapper->Clear();
 
@@ -351,6 +390,249 @@ void AliHFJetFinder::FindMCJets(TClonesArray *array, AliAODMCParticle *mcpart) {
 }
 
 
+//________________________________________________________________
+//Set the tracks of the event for the streaming mode, the event is clustered at the first request
+void AliHFJetFinder::SetEvent(TClonesArray *array) {
+  fEventArray=array;
+  fEventIsMC=kFALSE;
+  fEventClustered=kFALSE;
+}
+
+
+//________________________________________________________________
+//Set the particles of the event for the streaming mode (MC), the event is clustered at the first request
+void AliHFJetFinder::SetMCEvent(TClonesArray *array) {
+  fEventArray=array;
+  fEventIsMC=kTRUE;
+  fEventClustered=kFALSE;
+}
+
+
+//________________________________________________________________
+//Select the tracks (particles) and cluster the event once. The event jets are stored with their
+//inputs and their extent in rapidity and phi, which is used to find the jets a candidate can affect
+void AliHFJetFinder::ClusterEvent() {
+
+  fEventClustered=kTRUE;
+  fEventInputs.clear();
+  fEventInputIDs.clear();
+  fEventJets.clear();
+  fEventJetOfInput.clear();
+  fEventJetFirstInput.clear();
+  fEventJetInputs.clear();
+  fEventJetBoxes.clear();
+  if (!fEventArray) return;
+
+  for (Int_t i=0; i<fEventArray->GetEntriesFast(); i++) {
+    if (fEventIsMC){
+      AliAODMCParticle *particle=dynamic_cast<AliAODMCParticle*>(fEventArray->At(i));
+      if(!CheckParticle(particle)) continue;
+      fEventInputIDs.push_back(std::make_pair(particle->GetLabel(),(Int_t)fEventInputs.size()));
+      fEventInputs.push_back(fastjet::PseudoJet(particle->Px(), particle->Py(), particle->Pz(), particle->E()));
+    }
+    else{
+      AliAODTrack *track=dynamic_cast<AliAODTrack*>(fEventArray->At(i));
+      if(!CheckTrack(track)) continue;
+      fEventInputIDs.push_back(std::make_pair(track->GetID(),(Int_t)fEventInputs.size()));
+      fEventInputs.push_back(fastjet::PseudoJet(track->Px(), track->Py(), track->Pz(), track->E()));
+    }
+    fEventInputs.back().set_user_index(fEventInputs.size()-1+100);
+  }
+  std::sort(fEventInputIDs.begin(),fEventInputIDs.end());
+  if (fEventInputs.empty()) return;
+
+  fastjet::JetDefinition jet_definition(JetAlgorithm(fJetAlgorithm), fJetRadius, RecombinationScheme(fJetRecombScheme), fastjet::Best);
+  fastjet::ClusterSequence cluster_sequence(fEventInputs, jet_definition);
+  fEventJets=cluster_sequence.inclusive_jets(0.0);
+
+  fEventJetOfInput.assign(fEventInputs.size(),-1);
+  fEventJetFirstInput.push_back(0);
+  for (UInt_t i=0; i<fEventJets.size(); i++){
+    std::vector<fastjet::PseudoJet> constituents(cluster_sequence.constituents(fEventJets[i]));
+    Double_t box[4]={0.,0.,0.,0.};
+    for (UInt_t j=0; j<constituents.size(); j++){
+      Int_t input=constituents[j].user_index()-100;
+      fEventJetOfInput[input]=i;
+      fEventJetInputs.push_back(input);
+      Double_t dy=constituents[j].rap()-fEventJets[i].rap();
+      Double_t dphi=fEventJets[i].delta_phi_to(constituents[j]);
+      box[0]=TMath::Min(box[0],dy);
+      box[1]=TMath::Max(box[1],dy);
+      box[2]=TMath::Min(box[2],dphi);
+      box[3]=TMath::Max(box[3],dphi);
+    }
+    fEventJetFirstInput.push_back(fEventJetInputs.size());
+    fEventJetBoxes.insert(fEventJetBoxes.end(),box,box+4);
+  }
+}
+
+
+//________________________________________________________________
+//Squared distance in rapidity-phi between the extents of two jets (or of a jet and a particle, with zero extent).
+//Pseudojets formed during the clustering lie inside the extent of their final jet, two groups of jets with extents
+//further apart than R are therefore clustered independently
+namespace {
+  Double_t ExtentDistance2(const fastjet::PseudoJet& jet1, const Double_t *box1, const fastjet::PseudoJet& jet2, const Double_t *box2) {
+    Double_t dy=TMath::Max(0.,TMath::Max((jet2.rap()+box2[0])-(jet1.rap()+box1[1]),(jet1.rap()+box1[0])-(jet2.rap()+box2[1])));
+    Double_t offset=jet2.phi()-jet1.phi();
+    Double_t dphi=std::numeric_limits<Double_t>::max();
+    for (Int_t iwrap=-1; iwrap<=1; iwrap++){
+      Double_t offset_wrap=offset+iwrap*TMath::TwoPi();
+      dphi=TMath::Min(dphi,TMath::Max(0.,TMath::Max((offset_wrap+box2[2])-box1[3],box1[2]-(offset_wrap+box2[3]))));
+    }
+    return dy*dy+dphi*dphi;
+  }
+}
+
+
+//________________________________________________________________
+//Replace the daughters by the candidate and recluster only the affected event jets. The reclustered region
+//starts from the jets containing the daughters and the jets within R of the candidate, and is extended
+//until no reclustered jet is within R of a jet outside of it: the result is then the same as for the
+//reclustering of the full event. Returns the index in fLocalJets of the jet with the candidate
+Int_t AliHFJetFinder::ReclusterWithCandidate(Double_t px, Double_t py, Double_t pz, Double_t e, const std::vector<Int_t>& daughter_vec) {
+
+  fNJetsReclustered=0;
+  if (!fEventClustered) ClusterEvent();
+
+  fastjet::PseudoJet candidate(px,py,pz,e);
+  candidate.set_user_index(0);
+  const Double_t zero_box[4]={0.,0.,0.,0.};
+  const Double_t r2=fJetRadius*fJetRadius;
+  const UInt_t njets=fEventJets.size();
+
+  fJetInRegion.assign(njets,0);
+  fInputRemoved.assign(fEventInputs.size(),0);
+  for (UInt_t i=0; i<daughter_vec.size(); i++){
+    std::vector<std::pair<Int_t,Int_t> >::const_iterator it=std::lower_bound(fEventInputIDs.begin(),fEventInputIDs.end(),std::make_pair(daughter_vec[i],-1));
+    for (; it!=fEventInputIDs.end() && it->first==daughter_vec[i]; ++it){
+      fInputRemoved[it->second]=1;
+      fJetInRegion[fEventJetOfInput[it->second]]=1;
+    }
+  }
+  for (UInt_t i=0; i<njets; i++){
+    if (!fJetInRegion[i] && ExtentDistance2(candidate,zero_box,fEventJets[i],&fEventJetBoxes[4*i]) <= r2) fJetInRegion[i]=1;
+  }
+
+  fastjet::JetDefinition jet_definition(JetAlgorithm(fJetAlgorithm), fJetRadius, RecombinationScheme(fJetRecombScheme), fastjet::Best);
+  while (true){
+    fLocalInputs.clear();
+    fLocalInputs.push_back(candidate);
+    fNJetsReclustered=0;
+    for (UInt_t i=0; i<njets; i++){
+      if (!fJetInRegion[i]) continue;
+      fNJetsReclustered++;
+      for (Int_t j=fEventJetFirstInput[i]; j<fEventJetFirstInput[i+1]; j++){
+        if (!fInputRemoved[fEventJetInputs[j]]) fLocalInputs.push_back(fEventInputs[fEventJetInputs[j]]);
+      }
+    }
+
+    fastjet::ClusterSequence cluster_sequence(fLocalInputs, jet_definition);
+    fLocalJets=cluster_sequence.inclusive_jets(0.0);
+
+    Bool_t extended=kFALSE;
+    Int_t candidate_jet=-1;
+    for (UInt_t i=0; i<fLocalJets.size(); i++){
+      std::vector<fastjet::PseudoJet> constituents(cluster_sequence.constituents(fLocalJets[i]));
+      Double_t box[4]={0.,0.,0.,0.};
+      Bool_t has_candidate=kFALSE;
+      for (UInt_t j=0; j<constituents.size(); j++){
+        if (constituents[j].user_index()==0) has_candidate=kTRUE;
+        Double_t dy=constituents[j].rap()-fLocalJets[i].rap();
+        Double_t dphi=fLocalJets[i].delta_phi_to(constituents[j]);
+        box[0]=TMath::Min(box[0],dy);
+        box[1]=TMath::Max(box[1],dy);
+        box[2]=TMath::Min(box[2],dphi);
+        box[3]=TMath::Max(box[3],dphi);
+      }
+      if (has_candidate){
+        candidate_jet=i;
+        fConstituents.swap(constituents);
+      }
+      for (UInt_t k=0; k<njets; k++){
+        if (fJetInRegion[k]) continue;
+        if (ExtentDistance2(fLocalJets[i],box,fEventJets[k],&fEventJetBoxes[4*k]) <= r2){
+          fJetInRegion[k]=1;
+          extended=kTRUE;
+        }
+      }
+    }
+    if (!extended) return candidate_jet;
+  }
+}
+
+
+//________________________________________________________________
+//returns the jet clustered with the heavy flavour candidate, obtained from the event clustered once (streaming mode)
+const AliHFJet& AliHFJetFinder::GetHFJetFromEvent(AliAODRecoDecayHF *cand, Double_t invmass) {
+
+  fHFJet.Reset();
+  if (!cand || !fEventArray || fEventIsMC) return fHFJet;
+
+  std::vector<Int_t> daughter_vec;
+  for (Int_t i = 0; i < cand->GetNDaughters(); i++) {
+    AliVTrack *daughter = dynamic_cast<AliVTrack *>(cand->GetDaughter(i));
+    if (!daughter) continue;
+    daughter_vec.push_back(daughter->GetID());
+  }
+  AliTLorentzVector cand_lvec(0,0,0,0);
+  cand_lvec.SetPtEtaPhiM(cand->Pt(), cand->Eta(), cand->Phi(), invmass);
+
+  Int_t jet_index=ReclusterWithCandidate(cand_lvec.Px(), cand_lvec.Py(), cand_lvec.Pz(), cand_lvec.E(), daughter_vec);
+  if (jet_index==-1) return fHFJet;
+  const fastjet::PseudoJet& jet = fLocalJets[jet_index];
+  if (jet.perp() < fMinJetPt) return fHFJet;
+
+  SetJetVariables(fHFJet, fConstituents, jet, 0, cand);
+  return fHFJet;
+}
+
+
+//________________________________________________________________
+//returns the jet clustered with the heavy flavour particle, obtained from the event clustered once (streaming mode, MC)
+const AliHFJet& AliHFJetFinder::GetHFMCJetFromEvent(AliAODMCParticle *mcpart) {
+
+  fHFJet.Reset();
+  if (!mcpart || !fEventArray || !fEventIsMC) return fHFJet;
+
+  std::vector<Int_t> daughter_vec;
+  for (Int_t i = 0; i < mcpart->GetNDaughters(); i++) {
+    AliAODMCParticle *daughter = dynamic_cast<AliAODMCParticle *>(fEventArray->At(mcpart->GetDaughterLabel(i)));
+    if (!daughter) continue;
+    daughter_vec.push_back(daughter->GetLabel());
+  }
+
+  Int_t jet_index=ReclusterWithCandidate(mcpart->Px(), mcpart->Py(), mcpart->Pz(), mcpart->E(), daughter_vec);
+  if (jet_index==-1) return fHFJet;
+  const fastjet::PseudoJet& jet = fLocalJets[jet_index];
+  if (jet.perp() < fMinJetPt) return fHFJet;
+
+  SetMCJetVariables(fHFJet, fConstituents, jet, 0, mcpart);
+  return fHFJet;
+}
+
+
+//________________________________________________________________
+//returns the jets of the event clustered once (streaming mode)
+const std::vector<AliHFJet>& AliHFJetFinder::GetJetsFromEvent() {
+
+  fHFJets.clear();
+  if (!fEventClustered) ClusterEvent();
+
+  for (UInt_t i=0; i<fEventJets.size(); i++){
+    const fastjet::PseudoJet& jet = fEventJets[i];
+    if (jet.perp() < fMinJetPt) continue;
+    fConstituents.clear();
+    for (Int_t j=fEventJetFirstInput[i]; j<fEventJetFirstInput[i+1]; j++) fConstituents.push_back(fEventInputs[fEventJetInputs[j]]);
+
+    fHFJets.push_back(AliHFJet());
+    if (fEventIsMC) SetMCJetVariables(fHFJets.back(), fConstituents, jet, i, nullptr);
+    else SetJetVariables(fHFJets.back(), fConstituents, jet, i, nullptr);
+  }
+  return fHFJets;
+}
+
+
 //________________________________________________________________
 //Set the jet parameters in the AliHFJet object
 void AliHFJetFinder::SetJetVariables(AliHFJet& hfjet, const std::vector<fastjet::PseudoJet>& constituents, const fastjet::PseudoJet& jet, Int_t jetID, AliAODRecoDecayHF *cand) {
@@ -541,11 +823,7 @@ void AliHFJetFinder::SetJetSubstructureVariables(AliHFJet& hfjet, const std::vec
 Bool_t AliHFJetFinder::CheckTrack(AliAODTrack *track) { 
   if(!track) return false;
 
-  TRandom3 Random;
-  Random.SetSeed(0);
-  Double_t Random_Number;
-  Random_Number=Random.Rndm();
-  if(Random_Number > fTrackingEfficiency) return false;
+  if(fTrackingEfficiency < 1.0 && fRandom.Rndm() > fTrackingEfficiency) return false;
 
   AliTLorentzVector track_lvec(0,0,0,0);
   track_lvec.SetPtEtaPhiM(track->Pt(), track->Eta(), track->Phi(), 0.139); //set to mass of Pion
@@ -13,7 +13,9 @@
 // N. Zardoshti, nima.zardoshti@cern.ch
 /////////////////////////////////////////////////////////////
 
+#include <vector>
 #include "TObject.h"
+#include "TRandom3.h"
 #include "AliAODTrack.h"
 #include "AliAODRecoDecayHF.h"
 #include "AliAODMCParticle.h"
@@ -62,6 +64,15 @@ class AliHFJetFinder : public TObject
   std::vector<AliHFJet> GetMCJets(TClonesArray *array);
   void FindJets(TClonesArray *array, AliAODRecoDecayHF *cand=nullptr, Double_t invmass=0);
   void FindMCJets(TClonesArray *array, AliAODMCParticle *mcpart=nullptr);
+
+  //streaming mode: the event is clustered once (lazily, at the first request), the jet of each candidate
+  //is obtained by reclustering only the event jets close to the candidate. Jet areas are not computed
+  void SetEvent(TClonesArray *array);
+  void SetMCEvent(TClonesArray *array);
+  const AliHFJet& GetHFJetFromEvent(AliAODRecoDecayHF *cand, Double_t invmass=0);
+  const AliHFJet& GetHFMCJetFromEvent(AliAODMCParticle *mcpart);
+  const std::vector<AliHFJet>& GetJetsFromEvent();
+  Int_t GetNJetsReclustered() const        {return fNJetsReclustered;}
   #if !defined(__CINT__) && !defined(__MAKECINT__)
   void SetJetVariables(AliHFJet& hfjet, const std::vector<fastjet::PseudoJet>& constituents, const fastjet::PseudoJet& jet, Int_t jetID, AliAODRecoDecayHF *cand=nullptr);
   void SetMCJetVariables(AliHFJet& hfjet, const std::vector<fastjet::PseudoJet>& constituents, const fastjet::PseudoJet& jet, Int_t jetID, AliAODMCParticle *mcpart=nullptr);
@@ -70,6 +81,8 @@ class AliHFJetFinder : public TObject
   fastjet::RecombinationScheme RecombinationScheme(Int_t recombscheme);
   fastjet::AreaType AreaType(Int_t area);
   #endif
+  void ClusterEvent();
+  Int_t ReclusterWithCandidate(Double_t px, Double_t py, Double_t pz, Double_t e, const std::vector<Int_t>& daughter_vec);
   Bool_t CheckTrack(AliAODTrack *track);
   Bool_t CheckFilterBits(AliAODTrack *track);
   Bool_t CheckParticle(AliAODMCParticle *particle);
@@ -130,11 +143,31 @@ class AliHFJetFinder : public TObject
   Bool_t                   fDoJetSubstructure;
   AliFJWrapper            *fFastJetWrapper;
 
+  TRandom3                 fRandom;              //! generator for the tracking efficiency
+  TClonesArray            *fEventArray;          //! tracks (particles) of the event in streaming mode
+  Bool_t                   fEventIsMC;           //! the event array contains MC particles
+  Bool_t                   fEventClustered;      //! the event array was clustered
+  Int_t                    fNJetsReclustered;    //! number of event jets reclustered for the last candidate
+  std::vector<fastjet::PseudoJet> fEventInputs;  //! selected tracks (particles) of the event
+  std::vector<fastjet::PseudoJet> fEventJets;    //! jets of the event
+  std::vector<fastjet::PseudoJet> fLocalInputs;  //! input of the local reclustering
+  std::vector<fastjet::PseudoJet> fLocalJets;    //! jets of the local reclustering
+  std::vector<fastjet::PseudoJet> fConstituents; //! constituents of the candidate jet
+  std::vector<std::pair<Int_t,Int_t> > fEventInputIDs; //! (track ID or label, input index) sorted by ID
+  std::vector<Int_t>       fEventJetOfInput;     //! event jet of each input
+  std::vector<Int_t>       fEventJetFirstInput;  //! offset of the inputs of each event jet in fEventJetInputs
+  std::vector<Int_t>       fEventJetInputs;      //! inputs grouped by event jet
+  std::vector<Double_t>    fEventJetBoxes;       //! rapidity and phi extent of each event jet (ymin,ymax,phimin,phimax, relative to the axis)
+  std::vector<Char_t>      fJetInRegion;         //! event jet included in the local reclustering
+  std::vector<Char_t>      fInputRemoved;        //! input replaced by the candidate
+  AliHFJet                 fHFJet;               //! output jet in streaming mode
+  std::vector<AliHFJet>    fHFJets;              //! output jets in streaming mode
+
 
 
 
   /// \cond CLASSIMP
-  ClassDef(AliHFJetFinder,1); ///
+  ClassDef(AliHFJetFinder,2); ///
   /// \endcond
 };
 #endif
@@ -20,10 +20,15 @@
 /////////////////////////////////////////////////////////////
 
 #include <cmath>
+#include <cstring>
 #include <limits>
 
 #include "TMath.h"
 #include "TFile.h"
+#include "TRandom.h"
+#include "TRegexp.h"
+#include "TLeaf.h"
+#include "TObjArray.h"
 
 #include "AliHFTreeHandler.h"
 #include "AliPID.h"
@@ -138,7 +143,22 @@ AliHFTreeHandler::AliHFTreeHandler():
   fMinJetPt(0.0),
   fSoftDropZCut(0.1),
   fSoftDropBeta(0.0),
-  fTrackingEfficiency(1.0)
+  fTrackingEfficiency(1.0),
+  fOutputLayout(kStandardLayout),
+  fEntriesPerCluster(50000),
+  fCompressionSettings(-1),
+  fTruncationPatterns(),
+  fTruncationBits(),
+  fDownsamplingPtLims(),
+  fDownsamplingFracToKeep(),
+  fDownsampleOnlyBkg(true),
+  fLayoutTree(nullptr),
+  fTruncatedVars(),
+  fTruncatedVarBits(),
+  fTruncatedVarValues(),
+  fNCandDownsampled(0),
+  fJetFinder(nullptr),
+  fGenJetFinder(nullptr)
 {
   //
   // Default constructor
@@ -280,7 +300,22 @@ AliHFTreeHandler::AliHFTreeHandler(int PIDopt):
   fMinJetPt(0.0),
   fSoftDropZCut(0.1),
   fSoftDropBeta(0.0),
-  fTrackingEfficiency(1.0)
+  fTrackingEfficiency(1.0),
+  fOutputLayout(kStandardLayout),
+  fEntriesPerCluster(50000),
+  fCompressionSettings(-1),
+  fTruncationPatterns(),
+  fTruncationBits(),
+  fDownsamplingPtLims(),
+  fDownsamplingFracToKeep(),
+  fDownsampleOnlyBkg(true),
+  fLayoutTree(nullptr),
+  fTruncatedVars(),
+  fTruncatedVarBits(),
+  fTruncatedVarValues(),
+  fNCandDownsampled(0),
+  fJetFinder(nullptr),
+  fGenJetFinder(nullptr)
 {
   //
   // Standard constructor
@@ -672,6 +707,14 @@ bool AliHFTreeHandler::SetSingleTrackVars(AliAODTrack* prongtracks[]) {
 //________________________________________________________________
 void AliHFTreeHandler::SetJetVars(TClonesArray *array, AliAODRecoDecayHF* cand, Double_t invmass, TClonesArray *mcarray, AliAODMCParticle* mcPart) {
 #ifdef HAVE_FASTJET
+  if (fJetFinder){ //event clustered once, only the jets close to the candidate are reclustered
+    SetJetTreeVars(fJetFinder->GetHFJetFromEvent(cand,invmass));
+    AliHFJet hfgenjet;
+    if (fGenJetFinder && mcarray && mcPart) hfgenjet=fGenJetFinder->GetHFMCJetFromEvent(mcPart);
+    SetGenJetTreeVars(hfgenjet);
+    return;
+  }
+
   AliHFJetFinder hfjetfinder;
   SetJetParameters(hfjetfinder); 
   AliHFJet hfjet(hfjetfinder.GetHFJet(array,cand,invmass));
@@ -693,15 +736,22 @@ void AliHFTreeHandler::SetJetVars(TClonesArray *array, AliAODRecoDecayHF* cand,
 //________________________________________________________________
 void AliHFTreeHandler::SetAndFillInclusiveJetVars(TClonesArray *array, TClonesArray *mcarray) {
 #ifdef HAVE_FASTJET
-  AliHFJetFinder hfjetfinder;
-  SetJetParameters(hfjetfinder); 
-  std::vector<AliHFJet> jets(hfjetfinder.GetJets(array));
-
+  std::vector<AliHFJet> jets;
   std::vector<AliHFJet> genjets;
-  if (mcarray){
-    AliHFJetFinder hfgenjetfinder;
-    SetJetParameters(hfgenjetfinder); 
-    genjets=hfgenjetfinder.GetMCJets(mcarray);
+  if (fJetFinder){
+    jets=fJetFinder->GetJetsFromEvent();
+    if (mcarray && fGenJetFinder) genjets=fGenJetFinder->GetJetsFromEvent();
+  }
+  else{
+    AliHFJetFinder hfjetfinder;
+    SetJetParameters(hfjetfinder); 
+    jets=hfjetfinder.GetJets(array);
+
+    if (mcarray){
+      AliHFJetFinder hfgenjetfinder;
+      SetJetParameters(hfgenjetfinder); 
+      genjets=hfgenjetfinder.GetMCJets(mcarray);
+    }
   }
     
   AliHFJet jet;
@@ -728,6 +778,11 @@ void AliHFTreeHandler::SetAndFillInclusiveJetVars(TClonesArray *array, TClonesAr
 //________________________________________________________________
 void AliHFTreeHandler::SetGenJetVars(TClonesArray *array, AliAODMCParticle* mcPart) {
 #ifdef HAVE_FASTJET
+  if (fGenJetFinder){
+    SetGenJetTreeVars(fGenJetFinder->GetHFMCJetFromEvent(mcPart));
+    return;
+  }
+
   AliHFJetFinder hfjetfinder;
   SetJetParameters(hfjetfinder);
   AliHFJet hfjet(hfjetfinder.GetHFMCJet(array,mcPart));
@@ -742,9 +797,13 @@ void AliHFTreeHandler::SetGenJetVars(TClonesArray *array, AliAODMCParticle* mcPa
 //________________________________________________________________
 void AliHFTreeHandler::SetAndFillInclusiveGenJetVars(TClonesArray *array) {
 #ifdef HAVE_FASTJET
-  AliHFJetFinder hfjetfinder;
-  SetJetParameters(hfjetfinder);
-  std::vector<AliHFJet> jets(hfjetfinder.GetMCJets(array));
+  std::vector<AliHFJet> jets;
+  if (fGenJetFinder) jets=fGenJetFinder->GetJetsFromEvent();
+  else{
+    AliHFJetFinder hfjetfinder;
+    SetJetParameters(hfjetfinder);
+    jets=hfjetfinder.GetMCJets(array);
+  }
   AliHFJet jet;
   for (Int_t i=0; i<jets.size(); i++){
     jet=jets[i];
@@ -1155,3 +1214,159 @@ void AliHFTreeHandler::GetNsigmaTPCMeanSigmaData(float &mean, float &sigma, AliP
     }
   }
 }
+
+//________________________________________________________________
+void AliHFTreeHandler::SetFloatTruncation(TString branchpattern, int nMantissaBits)
+{
+  //
+  // Keep only nMantissaBits (out of 23) of the mantissa of the float branches matching the
+  // wildcard pattern (e.g. "nsig*" or "*"), the first matching pattern is used for each branch.
+  // Rounding to nearest, the relative precision is 2^-(nMantissaBits+1).
+  // Zeroed low-order bits make the baskets much more compressible
+  //
+
+  if(nMantissaBits<0 || nMantissaBits>=23) {
+    AliWarning(Form("Invalid number of mantissa bits %d for %s, truncation not applied",nMantissaBits,branchpattern.Data()));
+    return;
+  }
+  fTruncationPatterns.push_back(branchpattern);
+  fTruncationBits.push_back(nMantissaBits);
+  fLayoutTree = nullptr;
+}
+
+//________________________________________________________________
+void AliHFTreeHandler::SetCandidateDownsampling(int nPtBins, const float* ptlims, const float* fractokeep, bool onlybkg)
+{
+  //
+  // Keep only a pt-dependent fraction of the candidates (by default only of those not flagged as
+  // signal or reflection, i.e. all the candidates in data). Candidates outside the pt limits are kept
+  //
+
+  fDownsamplingPtLims.clear();
+  fDownsamplingFracToKeep.clear();
+  if(nPtBins<=0) return;
+  fDownsamplingPtLims.assign(ptlims,ptlims+nPtBins+1);
+  fDownsamplingFracToKeep.assign(fractokeep,fractokeep+nPtBins);
+  fDownsampleOnlyBkg = onlybkg;
+}
+
+//________________________________________________________________
+bool AliHFTreeHandler::IsKeptByDownsampling() const
+{
+  //
+  // Candidate-level downsampling decision, gRandom is used as for the event downsampling of the task
+  //
+
+  if(fIsMCGenTree) return true;
+  if(fDownsampleOnlyBkg && ((fCandType&kSignal) || (fCandType&kRefl))) return true;
+  if(fPt<fDownsamplingPtLims.front() || fPt>=fDownsamplingPtLims.back()) return true;
+
+  unsigned int iPt = TMath::BinarySearch(fDownsamplingPtLims.size(),fDownsamplingPtLims.data(),fPt);
+  if(fDownsamplingFracToKeep[iPt]>=1.) return true;
+  return gRandom->Rndm()<fDownsamplingFracToKeep[iPt];
+}
+
+//________________________________________________________________
+void AliHFTreeHandler::ApplyOutputLayout()
+{
+  //
+  // Apply the output layout and resolve the truncated float variables for the current tree
+  //
+
+  fLayoutTree = fTreeVar;
+  fTruncatedVars.clear();
+  fTruncatedVarBits.clear();
+  if(!fTreeVar) return;
+
+  if(fOutputLayout==kColumnChunkedLayout) SetColumnChunkedLayout(fTreeVar,fEntriesPerCluster,fCompressionSettings);
+
+  if(fTruncationPatterns.empty()) return;
+  TObjArray* leaves = fTreeVar->GetListOfLeaves();
+  for(int iLeaf=0; iLeaf<leaves->GetEntriesFast(); iLeaf++) {
+    TLeaf* leaf = (TLeaf*)leaves->UncheckedAt(iLeaf);
+    if(TString(leaf->GetTypeName())!="Float_t") continue;
+    TString branchname = leaf->GetBranch()->GetName();
+    for(size_t iPattern=0; iPattern<fTruncationPatterns.size(); iPattern++) {
+      TRegexp regexp(fTruncationPatterns[iPattern],kTRUE);
+      Ssiz_t len = 0;
+      if(regexp.Index(branchname,&len)!=0 || len!=branchname.Length()) continue;
+      float* values = (float*)leaf->GetValuePointer();
+      for(int iVal=0; iVal<leaf->GetLen(); iVal++) {
+        fTruncatedVars.push_back(values+iVal);
+        fTruncatedVarBits.push_back(fTruncationBits[iPattern]);
+      }
+      break;
+    }
+  }
+  fTruncatedVarValues.resize(fTruncatedVars.size());
+}
+
+//________________________________________________________________
+void AliHFTreeHandler::TruncateFloatVars()
+{
+  //
+  // Truncate the float variables before the fill, the original values are kept
+  //
+
+  for(size_t iVar=0; iVar<fTruncatedVars.size(); iVar++) {
+    fTruncatedVarValues[iVar] = *fTruncatedVars[iVar];
+    *fTruncatedVars[iVar] = TruncateMantissa(fTruncatedVarValues[iVar],fTruncatedVarBits[iVar]);
+  }
+}
+
+//________________________________________________________________
+void AliHFTreeHandler::RestoreFloatVars()
+{
+  //
+  // Restore the float variables after the fill
+  //
+
+  for(size_t iVar=0; iVar<fTruncatedVars.size(); iVar++)
+    *fTruncatedVars[iVar] = fTruncatedVarValues[iVar];
+}
+
+//________________________________________________________________
+void AliHFTreeHandler::SetColumnChunkedLayout(TTree* tree, Long64_t entriesPerCluster, int compression)
+{
+  //
+  // Flush all the baskets every entriesPerCluster entries and size the basket of each branch to
+  // hold exactly one cluster, each branch is then written as one contiguous column chunk per
+  // cluster. Fewer and larger baskets make the columnar reading (e.g. uproot) much faster
+  //
+
+  if(!tree || entriesPerCluster<=0) return;
+
+  tree->SetAutoFlush(entriesPerCluster);
+  TObjArray* branches = tree->GetListOfBranches();
+  for(int iBranch=0; iBranch<branches->GetEntriesFast(); iBranch++) {
+    TBranch* branch = (TBranch*)branches->UncheckedAt(iBranch);
+    Long64_t entrysize = 0;
+    TObjArray* leaves = branch->GetListOfLeaves();
+    for(int iLeaf=0; iLeaf<leaves->GetEntriesFast(); iLeaf++) {
+      TLeaf* leaf = (TLeaf*)leaves->UncheckedAt(iLeaf);
+      entrysize += leaf->GetLenType()*leaf->GetLen();
+    }
+    if(entrysize<=0) continue;
+    Long64_t basketsize = entrysize*entriesPerCluster+1024; //headroom for the basket key
+    branch->SetBasketSize(basketsize<kMaxInt ? (Int_t)basketsize : kMaxInt);
+    if(compression>=0) branch->SetCompressionSettings(compression);
+  }
+}
+
+//________________________________________________________________
+float AliHFTreeHandler::TruncateMantissa(float value, int nMantissaBits)
+{
+  //
+  // Round the mantissa to nMantissaBits bits, NaN and infinities are not changed
+  //
+
+  if(nMantissaBits<0 || nMantissaBits>=23) return value;
+  unsigned int bits = 0;
+  memcpy(&bits,&value,sizeof(float));
+  if((bits&0x7f800000u)==0x7f800000u) return value;
+  const unsigned int ndropped = 23-nMantissaBits;
+  bits += 1u<<(ndropped-1);
+  bits &= ~((1u<<ndropped)-1);
+  memcpy(&value,&bits,sizeof(float));
+  return value;
+}
@@ -22,7 +22,9 @@
 // N. Zardoshti, nima.zardoshti@cern.ch
 /////////////////////////////////////////////////////////////
 
+#include <vector>
 #include <TTree.h>
+#include <TString.h>
 #include "AliAODTrack.h"
 #include "AliPIDResponse.h"
 #include "AliAODRecoDecayHF.h"
@@ -34,6 +36,8 @@
 #include "AliHFJetFinder.h"
 #endif
 
+class AliHFJetFinder;
+
 class AliHFTreeHandler : public TObject
 {
   public:
@@ -78,6 +82,11 @@ class AliHFTreeHandler : public TObject
       kAllSingleTrackVars // all single-track vars
     };
 
+    enum optlayout {
+      kStandardLayout, // ROOT default basket sizes and auto flush
+      kColumnChunkedLayout // fixed entries per cluster, one basket per branch and cluster
+    };
+
     AliHFTreeHandler();
     AliHFTreeHandler(int PIDopt);
 
@@ -98,6 +107,8 @@ class AliHFTreeHandler : public TObject
     void SetJetParameters(AliHFJetFinder& hfjetfinder);
 #endif
     void SetJetTreeVars(AliHFJet hfjet);
+    //jet finders shared between handlers, the event is clustered once (see AliHFJetFinder::SetEvent)
+    void SetJetFinders(AliHFJetFinder* jetfinder, AliHFJetFinder* genjetfinder) {fJetFinder=jetfinder; fGenJetFinder=genjetfinder;}
     void SetGenJetTreeVars(AliHFJet hfjet);
 
 
@@ -105,8 +116,18 @@ class AliHFTreeHandler : public TObject
       if(fFillOnlySignal && !(fCandType&kSignal) && !(fCandType&kRefl)) { //if fill only signal and not signal/reflection candidate, do not store
         fCandType=0;
       }
-      else {      
-        fTreeVar->Fill(); 
+      else if(!fDownsamplingPtLims.empty() && !IsKeptByDownsampling()) { //candidate rejected by downsampling policy
+        fCandType=0;
+        fNCandDownsampled++;
+      }
+      else {
+        if(fLayoutTree!=fTreeVar) ApplyOutputLayout(); //first fill of the current tree
+        if(!fTruncatedVars.empty()) {
+          TruncateFloatVars();
+          fTreeVar->Fill();
+          RestoreFloatVars();
+        }
+        else fTreeVar->Fill();
         fCandType=0;
         fRunNumberPrevCand = fRunNumber;
       }
@@ -123,6 +144,19 @@ class AliHFTreeHandler : public TObject
     void SetFillOnlySignal(bool fillopt=true) {fFillOnlySignal=fillopt;}
     void SetUpCombinedPid(); 
 
+    //output layout, applied to the tree at the first fill
+    void SetOutputLayout(int layout, Long64_t entriesPerCluster=50000, int compression=-1) {
+      fOutputLayout=layout;
+      fEntriesPerCluster=entriesPerCluster;
+      fCompressionSettings=compression;
+    }
+    void SetFloatTruncation(TString branchpattern, int nMantissaBits);
+    void SetCandidateDownsampling(int nPtBins, const float* ptlims, const float* fractokeep, bool onlybkg=true);
+    unsigned int GetNCandidatesDownsampled() const {return fNCandDownsampled;}
+
+    static void SetColumnChunkedLayout(TTree* tree, Long64_t entriesPerCluster, int compression=-1);
+    static float TruncateMantissa(float value, int nMantissaBits);
+
     void SetCandidateType(bool issignal, bool isbkg, bool isprompt, bool isFD, bool isreflected);
     void SetIsSelectedStd(bool isselected, bool isselectedTopo, bool isselectedPID, bool isselectedTracks) {
       if(isselected) fCandType |= kSelected;
@@ -204,6 +238,12 @@ class AliHFTreeHandler : public TObject
   
     void GetNsigmaTPCMeanSigmaData(float &mean, float &sigma, AliPID::EParticleType species, float pTPC, float eta);
 
+    //output layout methods
+    void ApplyOutputLayout();
+    bool IsKeptByDownsampling() const;
+    void TruncateFloatVars();
+    void RestoreFloatVars();
+
     TTree* fTreeVar; /// tree with variables
     AliPIDCombined* fPidCombined; /// bayesian PID object
     unsigned int fNProngs; /// number of prongs
@@ -325,8 +365,24 @@ class AliHFTreeHandler : public TObject
     Double_t fSoftDropBeta; //soft drop beta  parameter
     Double_t fTrackingEfficiency;
 
+    int fOutputLayout; /// output layout (optlayout)
+    Long64_t fEntriesPerCluster; /// entries per cluster for the column-chunked layout
+    int fCompressionSettings; /// compression settings of the branches (-1: keep those of the output file)
+    vector<TString> fTruncationPatterns; /// wildcard patterns of the float branches to be truncated
+    vector<int> fTruncationBits; /// mantissa bits kept for each pattern
+    vector<float> fDownsamplingPtLims; /// pt limits of the candidate downsampling
+    vector<float> fDownsamplingFracToKeep; /// fraction of candidates kept in each pt bin
+    bool fDownsampleOnlyBkg; /// flag to downsample only candidates that are not signal or reflections
+    TTree* fLayoutTree; //! tree to which the output layout was applied
+    vector<float*> fTruncatedVars; //! addresses of the truncated float variables
+    vector<int> fTruncatedVarBits; //! mantissa bits kept for each truncated variable
+    vector<float> fTruncatedVarValues; //! values before truncation, restored after the fill
+    unsigned int fNCandDownsampled; //! number of candidates rejected by the downsampling
+    AliHFJetFinder* fJetFinder; //! jet finder in streaming mode (not owned)
+    AliHFJetFinder* fGenJetFinder; //! jet finder for generated jets in streaming mode (not owned)
+
   /// \cond CLASSIMP
-  ClassDef(AliHFTreeHandler,9); ///
+  ClassDef(AliHFTreeHandler,11); ///
   /// \endcond
 };
 #endif
@@ -23,6 +23,7 @@
 #include <AliVCluster.h>
 #include <AliVParticle.h>
 #include <AliLog.h>
+#include <AliESDEvent.h>
 
 #include "AliTLorentzVector.h"
 #include "AliEmcalJet.h"
@@ -534,6 +535,28 @@ void AliAnalysisTaskEmcalJetSample::Terminate(Option_t *)
 {
 }
 
+/**
+ * Set the event processed by the next call of UserExec,
+ * when the task runs in AliAnalysisThreadedEventLoop.
+ * @param[in] event Input event
+ * @param[in] mcEvent MC event, null if not available
+ */
+void AliAnalysisTaskEmcalJetSample::SetThreadInput(AliVEvent *event, AliMCEvent *mcEvent)
+{
+  if (!fUseBuiltinEventSelection) {
+    // AliEventCuts takes the trigger from the input handler, which is not fed in the threaded event loop
+    AliWarning(Form("%s: AliEventCuts cannot run in the threaded event loop, using the built-in event selection", GetName()));
+    fUseBuiltinEventSelection = kTRUE;
+  }
+  if (fOffTrigger != AliVEvent::kAny && event && event->IsA() == AliESDEvent::Class()) {
+    AliFatal(Form("%s: the offline trigger cannot be selected on ESD events in the threaded event loop", GetName()));
+  }
+  // Without analysis manager the input type is not known from the input handler
+  if (event) fIsEsd = event->InheritsFrom(AliESDEvent::Class());
+  fInputEvent = event;
+  fMCEvent = mcEvent;
+}
+
 /**
  * This function adds the task to the analysis manager. Often, this function is called
  * by an AddTask C macro. However, by compiling the code, it ensures that we do not
@@ -17,6 +17,7 @@
  * See cxx source for full Copyright notice                               */
 
 #include "AliAnalysisTaskEmcalJet.h"
+#include "AliAnalysisReentrantTask.h"
 #include "THistManager.h"
 
 /**
@@ -30,8 +31,18 @@
  * Note: if jets are not used this class can be simplified by deriving
  * from AliAnalysisTaskEmcal and removing the functions DoJetLoop()
  * and AllocateJetHistograms().
+ *
+ * The task is re-entrant and can run in AliAnalysisThreadedEventLoop,
+ * with the jets and the other objects it uses already in the input
+ * events (no jet finder runs in the threaded event loop). The default
+ * event selection (AliEventCuts) takes the trigger from the input handler
+ * of the analysis manager, which the threaded event loop does not use:
+ * the task must be configured with SetUseBuiltinEventSelection(kTRUE),
+ * otherwise the clones switch to it at their first event. On ESD input
+ * the offline trigger (SetOffTrigger) must stay kAny, the built-in
+ * selection also takes it from the input handler for ESD events.
  */
-class AliAnalysisTaskEmcalJetSample : public AliAnalysisTaskEmcalJet {
+class AliAnalysisTaskEmcalJetSample : public AliAnalysisTaskEmcalJet, public AliAnalysisReentrantTask {
  public:
 
   AliAnalysisTaskEmcalJetSample()                                               ;
@@ -40,6 +51,7 @@ class AliAnalysisTaskEmcalJetSample : public AliAnalysisTaskEmcalJet {
 
   void                        UserCreateOutputObjects()                         ;
   void                        Terminate(Option_t *option)                       ;
+  void                        SetThreadInput(AliVEvent *event, AliMCEvent *mcEvent);
 
   static AliAnalysisTaskEmcalJetSample* AddTaskEmcalJetSample(
       const char *ntracks            = "usedefault",
@@ -69,7 +81,7 @@ class AliAnalysisTaskEmcalJetSample : public AliAnalysisTaskEmcalJet {
   AliAnalysisTaskEmcalJetSample &operator=(const AliAnalysisTaskEmcalJetSample&); // not implemented
 
   /// \cond CLASSIMP
-  ClassDef(AliAnalysisTaskEmcalJetSample, 7);
+  ClassDef(AliAnalysisTaskEmcalJetSample, 8);
   /// \endcond
 };
 #endif
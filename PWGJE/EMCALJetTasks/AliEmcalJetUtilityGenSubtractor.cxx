@@ -13,6 +13,7 @@ AliEmcalJetUtility(),
   fDoGenericSubtractionExtraJetShapes(kFALSE),
   fDoGenericSubtractionNsubjettiness(kFALSE),  
   fUseExternalBkg(kFALSE),
+  fNsubjettinessThreads(1),
   fRhoName(""),
   fRhomName(""),
   fRho(0),
@@ -35,6 +36,7 @@ AliEmcalJetUtilityGenSubtractor::AliEmcalJetUtilityGenSubtractor(const char* nam
   fDoGenericSubtractionExtraJetShapes(kFALSE),
   fDoGenericSubtractionNsubjettiness(kFALSE), 
   fUseExternalBkg(kFALSE),
+  fNsubjettinessThreads(1),
   fRhoName(""),
   fRhomName(""),
   fRho(0),
@@ -56,6 +58,7 @@ AliEmcalJetUtilityGenSubtractor::AliEmcalJetUtilityGenSubtractor(const AliEmcalJ
   fDoGenericSubtractionExtraJetShapes(other.fDoGenericSubtractionExtraJetShapes),
   fDoGenericSubtractionNsubjettiness(other.fDoGenericSubtractionNsubjettiness), 
   fUseExternalBkg(other.fUseExternalBkg),
+  fNsubjettinessThreads(other.fNsubjettinessThreads),
   fRhoName(other.fRhoName),
   fRhomName(other.fRhomName),
   fRho(other.fRho),
@@ -81,6 +84,7 @@ AliEmcalJetUtilityGenSubtractor& AliEmcalJetUtilityGenSubtractor::operator=(cons
   fDoGenericSubtractionExtraJetShapes = other.fDoGenericSubtractionExtraJetShapes;
   fDoGenericSubtractionNsubjettiness = other.fDoGenericSubtractionNsubjettiness;
   fUseExternalBkg = other.fUseExternalBkg;
+  fNsubjettinessThreads = other.fNsubjettinessThreads;
   fRhoName = other.fRhoName;
   fRhomName = other.fRhomName;
   fRho = other.fRho;
@@ -153,20 +157,10 @@ void AliEmcalJetUtilityGenSubtractor::Prepare(AliFJWrapper& fjw)
  }
  
  if  (fDoGenericSubtractionNsubjettiness) {
+   // all the n-subjettiness shapes in one pass, each jet is reclustered once per axes algorithm
    fjw.SetUseExternalBkg(fUseExternalBkg,fRho,fRhom);
-   fjw.DoGenericSubtractionJet1subjettiness_kt();
-   fjw.DoGenericSubtractionJet2subjettiness_kt();
-   fjw.DoGenericSubtractionJet3subjettiness_kt();
-   fjw.DoGenericSubtractionJetOpeningAngle_kt();
-   fjw.DoGenericSubtractionJet1subjettiness_ca();
-   fjw.DoGenericSubtractionJet2subjettiness_ca();
-   fjw.DoGenericSubtractionJetOpeningAngle_ca();
-   fjw.DoGenericSubtractionJet1subjettiness_akt02();
-   fjw.DoGenericSubtractionJet2subjettiness_akt02();
-   fjw.DoGenericSubtractionJetOpeningAngle_akt02();
-   fjw.DoGenericSubtractionJet1subjettiness_onepassca();
-   fjw.DoGenericSubtractionJet2subjettiness_onepassca();
-   fjw.DoGenericSubtractionJetOpeningAngle_onepassca();
+   fjw.SetNSubstructureThreads(fNsubjettinessThreads);
+   fjw.DoGenericSubtractionNsubjettiness();
  }
 }
 
@@ -35,6 +35,7 @@ class AliEmcalJetUtilityGenSubtractor : public AliEmcalJetUtility
                                                  Double_t dr = 0.04, Double_t ptmin = 0.) { fDoGenericSubtractionGR             = b; fRMax = rmax; fDRStep = dr; fPtMinGR = ptmin;}
   void                   SetGenericSubtractionExtraJetShapes(Bool_t b)                    { fDoGenericSubtractionExtraJetShapes = b; }
   void                   SetGenericSubtractionNsubjettiness(Bool_t b)                     { fDoGenericSubtractionNsubjettiness = b; }
+  void                   SetNsubjettinessThreads(Int_t n)                                 { fNsubjettinessThreads = n; }
   void                   SetUseExternalBkg(Bool_t b)                                      { fUseExternalBkg                     = b; }
 
  protected:
@@ -44,6 +45,7 @@ class AliEmcalJetUtilityGenSubtractor : public AliEmcalJetUtility
   Bool_t                 fDoGenericSubtractionExtraJetShapes; // calculate generic subtraction for other jet shapes like radialmoment,pTD etc
   Bool_t                 fDoGenericSubtractionNsubjettiness; // calculate generic subtraction for 1subjettiness, 2subjettiness and the opening Angle between subjets
   Bool_t                 fUseExternalBkg;                     // use external background for generic subtractor
+  Int_t                  fNsubjettinessThreads;               // threads sharing the jets for the n-subjettiness shapes (needs external background)
   TString                fRhoName;                            // name of rho
   TString                fRhomName;                           // name of rhom
   Double_t               fRho;                                // pT background density
@@ -55,6 +57,6 @@ class AliEmcalJetUtilityGenSubtractor : public AliEmcalJetUtility
   AliRhoParameter       *fRhoParam;                           //!event rho
   AliRhoParameter       *fRhomParam;                          //!event rhom
 
-  ClassDef(AliEmcalJetUtilityGenSubtractor, 1) // Emcal jet utility that implements generic subtractors form the fastjet contrib
+  ClassDef(AliEmcalJetUtilityGenSubtractor, 2) // Emcal jet utility that implements generic subtractors form the fastjet contrib
 };
 #endif
@@ -9,6 +9,7 @@
 #include "AliLog.h"
 #include "FJ_includes.h"
 #include "AliJetShape.h"
+#include "AliJetSubstructureEngine.h"
 
 class AliFJWrapper
 {
@@ -111,6 +112,8 @@ class AliFJWrapper
   virtual Int_t DoGenericSubtractionJet1subjettiness_onepassca();
   virtual Int_t DoGenericSubtractionJet2subjettiness_onepassca();
   virtual Int_t DoGenericSubtractionJetOpeningAngle_onepassca();
+  virtual void  DoGenericSubtractionSubstructure(Int_t axes, Int_t observable, std::vector<fastjet::contrib::GenericSubtractorInfo>& output);
+  virtual Int_t DoGenericSubtractionNsubjettiness();
   virtual Int_t DoConstituentSubtraction();
   virtual Int_t DoEventConstituentSubtraction();
   virtual Int_t DoSoftDrop();
@@ -143,6 +146,7 @@ class AliFJWrapper
   void SetEventSub(Bool_t b) {fEventSub = b;}
   void SetMaxDelR(Double_t r)  {fMaxDelR = r;}
   void SetAlpha(Double_t a)  {fAlpha = a;}
+  void SetNSubstructureThreads(Int_t n) { fNSubstructureThreads = (n > 0 ? n : 1); }
 
 
  protected:
@@ -224,6 +228,7 @@ class AliFJWrapper
   std::vector<fastjet::contrib::GenericSubtractorInfo> fGenSubtractorInfoJet1subjettiness_onepassca;       //!
   std::vector<fastjet::contrib::GenericSubtractorInfo> fGenSubtractorInfoJet2subjettiness_onepassca;       //!
   std::vector<fastjet::contrib::GenericSubtractorInfo> fGenSubtractorInfoJetOpeningAngle_onepassca;       //!
+  std::vector<AliJetSubstructureEngine*>               fSubstructureEngines;       //! reclustering caches of the n-subjettiness shapes, one per thread
 #endif
   Bool_t                                   fDoFilterArea;         //!
   Bool_t                                   fLegacyMode;           //!
@@ -232,6 +237,7 @@ class AliFJWrapper
   Double_t                                 fRhom;                 //  mT background density
   Double_t                                 fRMax;             //!
   Double_t                                 fDRStep;           //!
+  Int_t                                    fNSubstructureThreads; //! threads used by DoGenericSubtractionNsubjettiness
   std::vector<double>                      fGRNumerator;      //!
   std::vector<double>                      fGRDenominator;    //!
   std::vector<double>                      fGRNumeratorSub;   //!
@@ -254,6 +260,9 @@ class AliFJWrapper
 #pragma GCC system_header
 #endif
 
+#include <atomic>
+#include <thread>
+
 namespace fj = fastjet;
 
 //_________________________________________________________________________________________________
@@ -327,7 +336,7 @@ AliFJWrapper::AliFJWrapper(const char *name, const char *title)
   , fGenSubtractorInfoJet1subjettiness_onepassca ( )
   , fGenSubtractorInfoJet2subjettiness_onepassca ( )
   , fGenSubtractorInfoJetOpeningAngle_onepassca ( )
-      
+  , fSubstructureEngines ( )
 #endif
   , fDoFilterArea      (false)
   , fLegacyMode        (false)
@@ -336,6 +345,7 @@ AliFJWrapper::AliFJWrapper(const char *name, const char *title)
   , fRhom              (0)
   , fRMax(2.)
   , fDRStep(0.04)
+  , fNSubstructureThreads(1)
   , fGRNumerator()
   , fGRDenominator()
   , fGRNumeratorSub()
@@ -349,6 +359,9 @@ AliFJWrapper::~AliFJWrapper()
 {
   // Destructor.
   ClearMemory();
+#ifdef FASTJET_VERSION
+  for (UInt_t i = 0; i < fSubstructureEngines.size(); i++) delete fSubstructureEngines[i];
+#endif
 }
 
 //_________________________________________________________________________________________________
@@ -399,6 +412,7 @@ void AliFJWrapper::CopySettingsFrom(const AliFJWrapper& wrapper)
   fUseExternalBkg   = wrapper.fUseExternalBkg;
   fRho              = wrapper.fRho;
   fRhom             = wrapper.fRhom;
+  fNSubstructureThreads = wrapper.fNSubstructureThreads;
 }
 
 //_________________________________________________________________________________________________
@@ -412,6 +426,9 @@ void AliFJWrapper::Clear(const Option_t */*opt*/)
   fEventSubInputVectors.clear();
   fInputGhosts.clear();
   fMedUsedForBgSub = 0;
+#ifdef FASTJET_VERSION
+  for (UInt_t i = 0; i < fSubstructureEngines.size(); i++) fSubstructureEngines[i]->Clear();
+#endif
 
   // for the moment brute force delete everything
   ClearMemory();
@@ -1087,9 +1104,7 @@ Int_t AliFJWrapper::DoGenericSubtractionJetLeSub() {
 Int_t AliFJWrapper::DoGenericSubtractionJet1subjettiness_kt() {
   //Do generic subtraction for 1subjettiness
 #ifdef FASTJET_VERSION
-  // Define jet shape
-  AliJetShape1subjettiness_kt shape1subjettiness_kt;
-  DoGenericSubtraction(shape1subjettiness_kt, fGenSubtractorInfoJet1subjettiness_kt);
+  DoGenericSubtractionSubstructure(AliJetSubstructureEngine::kKtAxes, AliJetSubstructureEngine::kTau1, fGenSubtractorInfoJet1subjettiness_kt);
 #endif
   return 0;
 }
@@ -1098,9 +1113,7 @@ Int_t AliFJWrapper::DoGenericSubtractionJet1subjettiness_kt() {
 Int_t AliFJWrapper::DoGenericSubtractionJet2subjettiness_kt() {
   //Do generic subtraction for 2subjettiness
 #ifdef FASTJET_VERSION
-  // Define jet shape
-  AliJetShape2subjettiness_kt shape2subjettiness_kt;
-  DoGenericSubtraction(shape2subjettiness_kt, fGenSubtractorInfoJet2subjettiness_kt);
+  DoGenericSubtractionSubstructure(AliJetSubstructureEngine::kKtAxes, AliJetSubstructureEngine::kTau2, fGenSubtractorInfoJet2subjettiness_kt);
 #endif
   return 0;
 }
@@ -1109,9 +1122,7 @@ Int_t AliFJWrapper::DoGenericSubtractionJet2subjettiness_kt() {
 Int_t AliFJWrapper::DoGenericSubtractionJet3subjettiness_kt() {
   //Do generic subtraction for 3subjettiness
 #ifdef FASTJET_VERSION
-  // Define jet shape
-  AliJetShape3subjettiness_kt shape3subjettiness_kt;
-  DoGenericSubtraction(shape3subjettiness_kt, fGenSubtractorInfoJet3subjettiness_kt);
+  DoGenericSubtractionSubstructure(AliJetSubstructureEngine::kKtAxes, AliJetSubstructureEngine::kTau3, fGenSubtractorInfoJet3subjettiness_kt);
 #endif
   return 0;
 }
@@ -1120,9 +1131,7 @@ Int_t AliFJWrapper::DoGenericSubtractionJet3subjettiness_kt() {
 Int_t AliFJWrapper::DoGenericSubtractionJetOpeningAngle_kt() {
   //Do generic subtraction for 2subjettiness axes opening angle
 #ifdef FASTJET_VERSION
-  // Define jet shape
-  AliJetShapeOpeningAngle_kt shapeOpeningAngle_kt;
-  DoGenericSubtraction(shapeOpeningAngle_kt, fGenSubtractorInfoJetOpeningAngle_kt);
+  DoGenericSubtractionSubstructure(AliJetSubstructureEngine::kKtAxes, AliJetSubstructureEngine::kOpeningAngle, fGenSubtractorInfoJetOpeningAngle_kt);
 #endif
   return 0;
 }
@@ -1131,9 +1140,7 @@ Int_t AliFJWrapper::DoGenericSubtractionJetOpeningAngle_kt() {
 Int_t AliFJWrapper::DoGenericSubtractionJet1subjettiness_ca() {
   //Do generic subtraction for 1subjettiness
 #ifdef FASTJET_VERSION
-  // Define jet shape
-  AliJetShape1subjettiness_ca shape1subjettiness_ca;
-  DoGenericSubtraction(shape1subjettiness_ca, fGenSubtractorInfoJet1subjettiness_ca);
+  DoGenericSubtractionSubstructure(AliJetSubstructureEngine::kCAAxes, AliJetSubstructureEngine::kTau1, fGenSubtractorInfoJet1subjettiness_ca);
 #endif
   return 0;
 }
@@ -1142,9 +1149,7 @@ Int_t AliFJWrapper::DoGenericSubtractionJet1subjettiness_ca() {
 Int_t AliFJWrapper::DoGenericSubtractionJet2subjettiness_ca() {
   //Do generic subtraction for 2subjettiness
 #ifdef FASTJET_VERSION
-  // Define jet shape
-  AliJetShape2subjettiness_ca shape2subjettiness_ca;
-  DoGenericSubtraction(shape2subjettiness_ca, fGenSubtractorInfoJet2subjettiness_ca);
+  DoGenericSubtractionSubstructure(AliJetSubstructureEngine::kCAAxes, AliJetSubstructureEngine::kTau2, fGenSubtractorInfoJet2subjettiness_ca);
 #endif
   return 0;
 }
@@ -1153,9 +1158,7 @@ Int_t AliFJWrapper::DoGenericSubtractionJet2subjettiness_ca() {
 Int_t AliFJWrapper::DoGenericSubtractionJetOpeningAngle_ca() {
   //Do generic subtraction for 2subjettiness axes opening angle
 #ifdef FASTJET_VERSION
-  // Define jet shape
-  AliJetShapeOpeningAngle_ca shapeOpeningAngle_ca;
-  DoGenericSubtraction(shapeOpeningAngle_ca, fGenSubtractorInfoJetOpeningAngle_ca);
+  DoGenericSubtractionSubstructure(AliJetSubstructureEngine::kCAAxes, AliJetSubstructureEngine::kOpeningAngle, fGenSubtractorInfoJetOpeningAngle_ca);
 #endif
   return 0;
 }
@@ -1164,9 +1167,7 @@ Int_t AliFJWrapper::DoGenericSubtractionJetOpeningAngle_ca() {
 Int_t AliFJWrapper::DoGenericSubtractionJet1subjettiness_akt02() {
   //Do generic subtraction for 1subjettiness
 #ifdef FASTJET_VERSION
-  // Define jet shape
-  AliJetShape1subjettiness_akt02 shape1subjettiness_akt02;
-  DoGenericSubtraction(shape1subjettiness_akt02, fGenSubtractorInfoJet1subjettiness_akt02);
+  DoGenericSubtractionSubstructure(AliJetSubstructureEngine::kAntiKt02Axes, AliJetSubstructureEngine::kTau1, fGenSubtractorInfoJet1subjettiness_akt02);
 #endif
   return 0;
 }
@@ -1175,9 +1176,7 @@ Int_t AliFJWrapper::DoGenericSubtractionJet1subjettiness_akt02() {
 Int_t AliFJWrapper::DoGenericSubtractionJet2subjettiness_akt02() {
   //Do generic subtraction for 2subjettiness
 #ifdef FASTJET_VERSION
-  // Define jet shape
-  AliJetShape2subjettiness_akt02 shape2subjettiness_akt02;
-  DoGenericSubtraction(shape2subjettiness_akt02, fGenSubtractorInfoJet2subjettiness_akt02);
+  DoGenericSubtractionSubstructure(AliJetSubstructureEngine::kAntiKt02Axes, AliJetSubstructureEngine::kTau2, fGenSubtractorInfoJet2subjettiness_akt02);
 #endif
   return 0;
 }
@@ -1186,9 +1185,7 @@ Int_t AliFJWrapper::DoGenericSubtractionJet2subjettiness_akt02() {
 Int_t AliFJWrapper::DoGenericSubtractionJetOpeningAngle_akt02() {
   //Do generic subtraction for 2subjettiness axes opening angle
 #ifdef FASTJET_VERSION
-  // Define jet shape
-  AliJetShapeOpeningAngle_akt02 shapeOpeningAngle_akt02;
-  DoGenericSubtraction(shapeOpeningAngle_akt02, fGenSubtractorInfoJetOpeningAngle_akt02);
+  DoGenericSubtractionSubstructure(AliJetSubstructureEngine::kAntiKt02Axes, AliJetSubstructureEngine::kOpeningAngle, fGenSubtractorInfoJetOpeningAngle_akt02);
 #endif
   return 0;
 }
@@ -1197,9 +1194,7 @@ Int_t AliFJWrapper::DoGenericSubtractionJetOpeningAngle_akt02() {
 Int_t AliFJWrapper::DoGenericSubtractionJet1subjettiness_onepassca() {
   //Do generic subtraction for 1subjettiness
 #ifdef FASTJET_VERSION
-  // Define jet shape
-  AliJetShape1subjettiness_onepassca shape1subjettiness_onepassca;
-  DoGenericSubtraction(shape1subjettiness_onepassca, fGenSubtractorInfoJet1subjettiness_onepassca);
+  DoGenericSubtractionSubstructure(AliJetSubstructureEngine::kOnePassCAAxes, AliJetSubstructureEngine::kTau1, fGenSubtractorInfoJet1subjettiness_onepassca);
 #endif
   return 0;
 }
@@ -1208,9 +1203,7 @@ Int_t AliFJWrapper::DoGenericSubtractionJet1subjettiness_onepassca() {
 Int_t AliFJWrapper::DoGenericSubtractionJet2subjettiness_onepassca() {
   //Do generic subtraction for 2subjettiness
 #ifdef FASTJET_VERSION
-  // Define jet shape
-  AliJetShape2subjettiness_onepassca shape2subjettiness_onepassca;
-  DoGenericSubtraction(shape2subjettiness_onepassca, fGenSubtractorInfoJet2subjettiness_onepassca);
+  DoGenericSubtractionSubstructure(AliJetSubstructureEngine::kOnePassCAAxes, AliJetSubstructureEngine::kTau2, fGenSubtractorInfoJet2subjettiness_onepassca);
 #endif
   return 0;
 }
@@ -1220,9 +1213,88 @@ Int_t AliFJWrapper::DoGenericSubtractionJet2subjettiness_onepassca() {
 Int_t AliFJWrapper::DoGenericSubtractionJetOpeningAngle_onepassca() {
   //Do generic subtraction for 2subjettiness axes opening angle
 #ifdef FASTJET_VERSION
-  // Define jet shape
-  AliJetShapeOpeningAngle_onepassca shapeOpeningAngle_onepassca;
-  DoGenericSubtraction(shapeOpeningAngle_onepassca, fGenSubtractorInfoJetOpeningAngle_onepassca);
+  DoGenericSubtractionSubstructure(AliJetSubstructureEngine::kOnePassCAAxes, AliJetSubstructureEngine::kOpeningAngle, fGenSubtractorInfoJetOpeningAngle_onepassca);
+#endif
+  return 0;
+}
+
+//_________________________________________________________________________________________________
+void AliFJWrapper::DoGenericSubtractionSubstructure(Int_t axes, Int_t observable, std::vector<fastjet::contrib::GenericSubtractorInfo>& output) {
+  //Do generic subtraction for a n-subjettiness or opening angle shape (see AliJetSubstructureEngine),
+  //the reclustering of each jet is shared by all these shapes until the next Clear()
+#ifdef FASTJET_VERSION
+  if (fSubstructureEngines.empty()) fSubstructureEngines.push_back(new AliJetSubstructureEngine());
+  AliJetShapeSubstructure shape(fSubstructureEngines[0], axes, observable);
+  DoGenericSubtraction(shape, output);
+#endif
+}
+
+//_________________________________________________________________________________________________
+Int_t AliFJWrapper::DoGenericSubtractionNsubjettiness() {
+  //Do generic subtraction for all the n-subjettiness and opening angle shapes (kt, ca, akt02 and
+  //onepassca axes) in one pass over the jets: each jet is reclustered once per axes algorithm.
+  //The jets are shared among fNSubstructureThreads threads. This needs an external background
+  //(the generic subtractor is then stateless) and FastJet built with limited thread safety,
+  //otherwise a single thread is used.
+#ifdef FASTJET_VERSION
+  CreateGenSub();
+
+  const Int_t nShapes = 13;
+  std::vector<fastjet::contrib::GenericSubtractorInfo>* outputs[nShapes] = {
+    &fGenSubtractorInfoJet1subjettiness_kt, &fGenSubtractorInfoJet2subjettiness_kt, &fGenSubtractorInfoJet3subjettiness_kt, &fGenSubtractorInfoJetOpeningAngle_kt,
+    &fGenSubtractorInfoJet1subjettiness_ca, &fGenSubtractorInfoJet2subjettiness_ca, &fGenSubtractorInfoJetOpeningAngle_ca,
+    &fGenSubtractorInfoJet1subjettiness_akt02, &fGenSubtractorInfoJet2subjettiness_akt02, &fGenSubtractorInfoJetOpeningAngle_akt02,
+    &fGenSubtractorInfoJet1subjettiness_onepassca, &fGenSubtractorInfoJet2subjettiness_onepassca, &fGenSubtractorInfoJetOpeningAngle_onepassca
+  };
+  const Int_t axes[nShapes] = {
+    AliJetSubstructureEngine::kKtAxes, AliJetSubstructureEngine::kKtAxes, AliJetSubstructureEngine::kKtAxes, AliJetSubstructureEngine::kKtAxes,
+    AliJetSubstructureEngine::kCAAxes, AliJetSubstructureEngine::kCAAxes, AliJetSubstructureEngine::kCAAxes,
+    AliJetSubstructureEngine::kAntiKt02Axes, AliJetSubstructureEngine::kAntiKt02Axes, AliJetSubstructureEngine::kAntiKt02Axes,
+    AliJetSubstructureEngine::kOnePassCAAxes, AliJetSubstructureEngine::kOnePassCAAxes, AliJetSubstructureEngine::kOnePassCAAxes
+  };
+  const Int_t observables[nShapes] = {
+    AliJetSubstructureEngine::kTau1, AliJetSubstructureEngine::kTau2, AliJetSubstructureEngine::kTau3, AliJetSubstructureEngine::kOpeningAngle,
+    AliJetSubstructureEngine::kTau1, AliJetSubstructureEngine::kTau2, AliJetSubstructureEngine::kOpeningAngle,
+    AliJetSubstructureEngine::kTau1, AliJetSubstructureEngine::kTau2, AliJetSubstructureEngine::kOpeningAngle,
+    AliJetSubstructureEngine::kTau1, AliJetSubstructureEngine::kTau2, AliJetSubstructureEngine::kOpeningAngle
+  };
+
+  // same content as the one shape at a time methods, each output is filled by jet index
+  const UInt_t nJets = fInclusiveJets.size();
+  for (Int_t is = 0; is < nShapes; is++) outputs[is]->assign(nJets, fj::contrib::GenericSubtractorInfo());
+
+  Int_t nThreads = fUseExternalBkg ? fNSubstructureThreads : 1;
+#ifndef FASTJET_HAVE_LIMITED_THREAD_SAFETY
+  nThreads = 1;
+#endif
+  if (nThreads > (Int_t)nJets) nThreads = nJets;
+  if (nThreads < 1) nThreads = 1;
+  while ((Int_t)fSubstructureEngines.size() < nThreads) fSubstructureEngines.push_back(new AliJetSubstructureEngine());
+
+  // the cache of an engine only holds the jet in process (and its ghost rescaled copies)
+  std::atomic<UInt_t> nextJet(0);
+  auto processJets = [&](Int_t ithread) {
+    AliJetSubstructureEngine *engine = fSubstructureEngines[ithread];
+    UInt_t ijet;
+    while ((ijet = nextJet++) < nJets) {
+      if (fInclusiveJets[ijet].perp() <= 1.e-4) continue;
+      engine->Clear();
+      for (Int_t is = 0; is < nShapes; is++) {
+        AliJetShapeSubstructure shape(engine, axes[is], observables[is]);
+        (*fGenSubtractor)(shape, fInclusiveJets[ijet], (*outputs[is])[ijet]);
+      }
+    }
+    engine->Clear();
+  };
+
+  if (nThreads > 1) {
+    std::vector<std::thread> threads;
+    for (Int_t it = 0; it < nThreads; it++) threads.push_back(std::thread(processJets, it));
+    for (Int_t it = 0; it < nThreads; it++) threads[it].join();
+  }
+  else {
+    processJets(0);
+  }
 #endif
   return 0;
 }
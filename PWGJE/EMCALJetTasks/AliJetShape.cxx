@@ -7,6 +7,7 @@
 #include "TVector3.h"
 #include "TVector2.h"
 #include "AliFJWrapper.h"
+#include "AliJetSubstructureEngine.h"
 using namespace std;
 
 #ifdef FASTJET_VERSION
@@ -355,6 +356,12 @@ Double32_t AliJetShapeOpeningAngle_onepassca::result(const fastjet::PseudoJet &j
   return Result;
 }
 
+Double32_t AliJetShapeSubstructure::result(const fastjet::PseudoJet &jet) const {
+  if (!jet.has_constituents() || !fEngine)
+    return 0;
+  return fEngine->GetValue(jet, fAxes, fObservable);
+}
+
 
 #endif
 
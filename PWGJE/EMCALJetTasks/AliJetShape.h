@@ -19,6 +19,8 @@
 #include "TVector2.h"
 using namespace std;
 
+class AliJetSubstructureEngine;
+
 #ifdef FASTJET_VERSION
 //________________________________________________________________________
 class AliJetShapeMass : public fastjet::FunctionOfPseudoJet<Double32_t>
@@ -192,6 +194,22 @@ class AliJetShapeOpeningAngle_onepassca : public fastjet::FunctionOfPseudoJet<Do
   Double32_t result(const fastjet::PseudoJet &jet) const;
 };
 
+//__________________________________________________________________________
+// n-subjettiness or opening angle taken from an AliJetSubstructureEngine, which reclusters
+// each jet once per axes algorithm for all the observables (see AliJetSubstructureEngine::EAxes_t
+// and AliJetSubstructureEngine::EObservable_t)
+class AliJetShapeSubstructure : public fastjet::FunctionOfPseudoJet<Double32_t>{
+ public:
+  AliJetShapeSubstructure(AliJetSubstructureEngine *engine, Int_t axes, Int_t observable) : fEngine(engine), fAxes(axes), fObservable(observable) {}
+  virtual std::string description() const{return "nsubjettiness or opening angle of subjet axes, cached reclustering";}
+  Double32_t result(const fastjet::PseudoJet &jet) const;
+
+ protected:
+  AliJetSubstructureEngine *fEngine;
+  Int_t fAxes;
+  Int_t fObservable;
+};
+
 
 
 
@@ -0,0 +1,189 @@
+// $Id$
+//
+// Per-jet cache of the reclustering histories used by the n-subjettiness shapes.
+//
+
+#include "AliJetSubstructureEngine.h"
+
+#include <cstring>
+#include "TMath.h"
+
+#ifdef FASTJET_VERSION
+
+namespace {
+  // measure and anti-kt radius used by AliFJWrapper::NSubjettinessDerivativeSub
+  const Double_t kBeta    = 1.0;
+  const Double_t kR0      = 0.4;
+  const Double_t kAntiKtR = 0.2;
+
+  inline ULong64_t HashValue(ULong64_t hash, Double_t value)
+  {
+    ULong64_t bits = 0;
+    memcpy(&bits, &value, sizeof(bits));
+    hash ^= bits;
+    hash *= 1099511628211ULL;
+    return hash ^ (hash >> 29);
+  }
+}
+
+//_________________________________________________________________________________________________
+AliJetSubstructureEngine::AliJetSubstructureEngine() :
+  fEntries(),
+  fEntryIndex(),
+  fNReclustered(0),
+  fNReused(0)
+{
+  // Constructor.
+}
+
+//_________________________________________________________________________________________________
+void AliJetSubstructureEngine::Clear()
+{
+  // Forget the cached jets, to be called when the input jets change.
+
+  fEntries.clear();
+  fEntryIndex.clear();
+}
+
+//_________________________________________________________________________________________________
+Double32_t AliJetSubstructureEngine::GetValue(const fastjet::PseudoJet& jet, Int_t axes, Int_t observable)
+{
+  // Observable of the jet for the given axes type. Each reclustering of a jet is done once,
+  // each observable is computed once (tau_2 and the opening angle together).
+
+  if (axes < 0 || axes >= kNAxes || observable < 0 || observable >= kNObservables) return -2;
+
+  std::vector<fastjet::PseudoJet> constits = jet.constituents();
+  Entry& entry = FindEntry(jet, constits);
+  if (entry.fDone[axes] & (1u << observable)) {
+    ++fNReused;
+    return entry.fValue[axes][observable];
+  }
+
+  Int_t n = (observable == kOpeningAngle) ? 2 : observable + 1;
+  ComputeNsubjettiness(entry, axes, n, jet, constits);
+  return entry.fValue[axes][observable];
+}
+
+//_________________________________________________________________________________________________
+AliJetSubstructureEngine::Entry& AliJetSubstructureEngine::FindEntry(const fastjet::PseudoJet& jet, const std::vector<fastjet::PseudoJet>& constits)
+{
+  // Cache entry of the jet. The generic subtractor gives a new jet object for each shape,
+  // jets are identified by their constituents.
+
+  ULong64_t key = 14695981039346656037ULL;
+  for (UInt_t i = 0; i < constits.size(); i++) {
+    key = HashValue(key, constits[i].px());
+    key = HashValue(key, constits[i].py());
+    key = HashValue(key, constits[i].pz());
+    key = HashValue(key, constits[i].E());
+  }
+
+  typedef std::multimap<ULong64_t,UInt_t>::const_iterator Iter_t;
+  std::pair<Iter_t,Iter_t> range = fEntryIndex.equal_range(key);
+  for (Iter_t it = range.first; it != range.second; ++it) {
+    Entry& entry = fEntries[it->second];
+    if (entry.fNConstituents != constits.size()) continue;
+    if (entry.fP[0] != jet.px() || entry.fP[1] != jet.py() || entry.fP[2] != jet.pz() || entry.fP[3] != jet.E()) continue;
+    return entry;
+  }
+
+  fEntryIndex.insert(std::make_pair(key, (UInt_t)fEntries.size()));
+  fEntries.push_back(Entry());
+  Entry& entry = fEntries.back();
+  entry.fKey = key;
+  entry.fNConstituents = constits.size();
+  entry.fP[0] = jet.px();
+  entry.fP[1] = jet.py();
+  entry.fP[2] = jet.pz();
+  entry.fP[3] = jet.E();
+  entry.fReclustered = 0;
+  for (Int_t i = 0; i < kNAxes; i++) {
+    entry.fDone[i] = 0;
+    for (Int_t j = 0; j < kNObservables; j++) entry.fValue[i][j] = 0;
+  }
+  return entry;
+}
+
+//_________________________________________________________________________________________________
+void AliJetSubstructureEngine::Recluster(Entry& entry, Int_t reclustering, const std::vector<fastjet::PseudoJet>& constits)
+{
+  // Recluster the constituents and keep the seed axes for N=1..kMaxN, defined as for the
+  // KT_Axes, CA_Axes and AntiKT_Axes of the Nsubjettiness contrib.
+
+  if (entry.fReclustered & (1u << reclustering)) return;
+
+  fastjet::JetDefinition jetDef;
+  if (reclustering == kKt)      jetDef = fastjet::JetDefinition(fastjet::kt_algorithm, fastjet::JetDefinition::max_allowable_R, fastjet::E_scheme, fastjet::Best);
+  else if (reclustering == kCA) jetDef = fastjet::JetDefinition(fastjet::cambridge_algorithm, fastjet::JetDefinition::max_allowable_R, fastjet::E_scheme, fastjet::Best);
+  else                          jetDef = fastjet::JetDefinition(fastjet::antikt_algorithm, kAntiKtR, fastjet::E_scheme, fastjet::Best);
+
+  fastjet::ClusterSequence clustSeq(constits, jetDef);
+  std::vector<fastjet::PseudoJet> hardest;
+  if (reclustering == kAntiKt02) hardest = fastjet::sorted_by_pt(clustSeq.inclusive_jets());
+
+  for (Int_t n = 1; n <= kMaxN; n++) {
+    std::vector<fastjet::PseudoJet> seeds = (reclustering == kAntiKt02) ? hardest : clustSeq.exclusive_jets_up_to(n);
+    seeds.resize(n);
+    // the axes are kept as plain four-vectors, the cluster sequence does not outlive this call
+    std::vector<fastjet::PseudoJet>& axes = entry.fAxes[reclustering][n-1];
+    axes.clear();
+    for (UInt_t i = 0; i < seeds.size(); i++) axes.push_back(fastjet::PseudoJet(seeds[i].px(), seeds[i].py(), seeds[i].pz(), seeds[i].E()));
+  }
+
+  entry.fReclustered |= (1u << reclustering);
+  ++fNReclustered;
+}
+
+//_________________________________________________________________________________________________
+void AliJetSubstructureEngine::ComputeNsubjettiness(Entry& entry, Int_t axes, Int_t n, const fastjet::PseudoJet& jet, const std::vector<fastjet::PseudoJet>& constits)
+{
+  // tau_n of the jet (and the opening angle for n=2) from the cached seed axes.
+
+  Int_t reclustering = kCA;
+  if (axes == kKtAxes) reclustering = kKt;
+  else if (axes == kAntiKt02Axes) reclustering = kAntiKt02;
+
+  Recluster(entry, reclustering, constits);
+
+  fastjet::contrib::NormalizedMeasure measure(kBeta, kR0);
+  Double_t tau = 0;
+  std::vector<fastjet::PseudoJet> currentAxes;
+  if (axes == kOnePassCAAxes) {
+    fastjet::contrib::Nsubjettiness nSub(n, fastjet::contrib::OnePass_Manual_Axes(), measure);
+    nSub.setAxes(entry.fAxes[reclustering][n-1]);
+    tau = nSub.result(jet);
+    currentAxes = nSub.currentAxes();
+  }
+  else {
+    fastjet::contrib::Nsubjettiness nSub(n, fastjet::contrib::Manual_Axes(), measure);
+    nSub.setAxes(entry.fAxes[reclustering][n-1]);
+    tau = nSub.result(jet);
+    currentAxes = nSub.currentAxes();
+  }
+
+  entry.fValue[axes][n-1] = tau;
+  entry.fDone[axes] |= (1u << (n-1));
+
+  if (n != 2) return;
+
+  Double_t openingAngle = -2;
+  if (currentAxes.size() > 1) {
+    Double_t eta1 = currentAxes[0].pseudorapidity();
+    Double_t phi1 = currentAxes[0].phi();
+    if (phi1 < -1*TMath::Pi()) phi1 += (2*TMath::Pi());
+    else if (phi1 > TMath::Pi()) phi1 -= (2*TMath::Pi());
+    Double_t eta2 = currentAxes[1].pseudorapidity();
+    Double_t phi2 = currentAxes[1].phi();
+    if (phi2 < -1*TMath::Pi()) phi2 += (2*TMath::Pi());
+    else if (phi2 > TMath::Pi()) phi2 -= (2*TMath::Pi());
+    Double_t deltaPhi = phi1 - phi2;
+    if (deltaPhi < -1*TMath::Pi()) deltaPhi += (2*TMath::Pi());
+    else if (deltaPhi > TMath::Pi()) deltaPhi -= (2*TMath::Pi());
+    openingAngle = TMath::Sqrt(TMath::Power(eta1-eta2,2)+TMath::Power(deltaPhi,2));
+  }
+  entry.fValue[axes][kOpeningAngle] = openingAngle;
+  entry.fDone[axes] |= (1u << kOpeningAngle);
+}
+
+#endif
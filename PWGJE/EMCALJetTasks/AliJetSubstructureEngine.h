@@ -0,0 +1,80 @@
+#ifndef AliJetSubstructureEngine_H
+#define AliJetSubstructureEngine_H
+
+// Per-jet cache of the reclustering histories used by the n-subjettiness shapes.
+//
+// The generic subtractor evaluates each shape on the same jet (and on the same
+// ghost-rescaled copies of it) once per shape. The n-subjettiness and opening
+// angle shapes of AliJetShape all recluster the jet constituents to find their
+// axes: the engine reclusters each jet once per algorithm (kt, CA, anti-kt 0.2),
+// keeps the axes for N=1,2,3 from that history and derives tau_N and the opening
+// angle of every axes type from them (one-pass CA starts from the CA axes).
+// Results are identical to the ones of AliFJWrapper::NSubjettinessDerivativeSub.
+//
+// An engine is not thread safe, use one per thread.
+
+#include <vector>
+#include <map>
+#include <Rtypes.h>
+
+#if !defined(__CINT__)
+#include "FJ_includes.h"
+
+class AliJetSubstructureEngine
+{
+ public:
+  enum EAxes_t {
+    kKtAxes = 0,       // exclusive kt axes
+    kCAAxes,           // exclusive CA axes
+    kAntiKt02Axes,     // hardest anti-kt R=0.2 jets
+    kOnePassCAAxes,    // CA axes with one-pass minimization
+    kNAxes
+  };
+
+  enum EObservable_t {
+    kTau1 = 0,
+    kTau2,
+    kTau3,
+    kOpeningAngle,     // distance in eta-phi between the two tau_2 axes
+    kNObservables
+  };
+
+  AliJetSubstructureEngine();
+  virtual ~AliJetSubstructureEngine() {;}
+
+  void       Clear();
+  Double32_t GetValue(const fastjet::PseudoJet& jet, Int_t axes, Int_t observable);
+
+  ULong64_t  GetNReclustered() const { return fNReclustered; }
+  ULong64_t  GetNReused()      const { return fNReused;      }
+
+ protected:
+  enum EReclustering_t { kKt = 0, kCA, kAntiKt02, kNReclusterings };
+  static const Int_t kMaxN = 3;      // highest N for which the axes are kept
+
+  struct Entry {
+    ULong64_t                        fKey;                                    // hash of the constituents
+    UInt_t                           fNConstituents;                          // number of constituents
+    Double_t                         fP[4];                                   // jet four-momentum
+    UInt_t                           fReclustered;                            // bit mask of the done reclusterings
+    std::vector<fastjet::PseudoJet>  fAxes[kNReclusterings][kMaxN];           // seed axes for N=1..kMaxN
+    UInt_t                           fDone[kNAxes];                           // bit mask of the computed observables
+    Double32_t                       fValue[kNAxes][kNObservables];           // observables
+  };
+
+  Entry&     FindEntry(const fastjet::PseudoJet& jet, const std::vector<fastjet::PseudoJet>& constits);
+  void       Recluster(Entry& entry, Int_t reclustering, const std::vector<fastjet::PseudoJet>& constits);
+  void       ComputeNsubjettiness(Entry& entry, Int_t axes, Int_t n, const fastjet::PseudoJet& jet,
+                                  const std::vector<fastjet::PseudoJet>& constits);
+
+  std::vector<Entry>                 fEntries;                                // jets seen since the last Clear()
+  std::multimap<ULong64_t,UInt_t>    fEntryIndex;                             // entry index per constituent hash
+  ULong64_t                          fNReclustered;                           // number of reclusterings done
+  ULong64_t                          fNReused;                                // number of observables taken from the cache
+
+ private:
+  AliJetSubstructureEngine(const AliJetSubstructureEngine&);
+  AliJetSubstructureEngine& operator=(const AliJetSubstructureEngine&);
+};
+#endif /*__CINT__*/
+#endif /*AliJetSubstructureEngine_H*/
@@ -60,7 +60,19 @@ AliFMDDensityCalculator::AliFMDDensityCalculator()
     fDoTiming(false),
     fHTiming(0), 
     fMaxOutliers(0.05),
-    fOutlierCut(0.50)
+    fOutlierCut(0.50),
+    fUseTabulated(false),
+    fTabSteps(512),
+    fTabMax(10),
+    fTabTolerance(1e-3),
+    fTabValidate(false),
+    fFMD1iTab(0),
+    fFMD2iTab(0),
+    fFMD2oTab(0),
+    fFMD3iTab(0),
+    fFMD3oTab(0),
+    fTabDeviation(0),
+    fTabNchDiff(0)
 {
   // 
   // Constructor 
@@ -98,7 +110,19 @@ AliFMDDensityCalculator::AliFMDDensityCalculator(const char* title)
     fDoTiming(false),
     fHTiming(0), 
     fMaxOutliers(0.05),
-    fOutlierCut(0.50)
+    fOutlierCut(0.50),
+    fUseTabulated(false),
+    fTabSteps(512),
+    fTabMax(10),
+    fTabTolerance(1e-3),
+    fTabValidate(false),
+    fFMD1iTab(0),
+    fFMD2iTab(0),
+    fFMD2oTab(0),
+    fFMD3iTab(0),
+    fFMD3oTab(0),
+    fTabDeviation(0),
+    fTabNchDiff(0)
 {
   // 
   // Constructor 
@@ -134,6 +158,18 @@ AliFMDDensityCalculator::AliFMDDensityCalculator(const char* title)
   fLowCuts->SetXTitle("#eta");
   fLowCuts->SetDirectory(0);
 
+  fTabDeviation = new TH2D("tabDeviation", 
+			   "Largest relative deviation of tabulated f_{W}",
+			   1, 0, 1, 1, 0, 1);
+  fTabDeviation->SetXTitle("#eta");
+  fTabDeviation->SetDirectory(0);
+
+  fTabNchDiff = new TH2D("tabNchDiff", 
+			 "Relative difference of tabulated and exact N_{ch}",
+			 1, 0, 1, 1, 0, 1);
+  fTabNchDiff->SetYTitle("(N_{ch}^{tab}-N_{ch}^{exact})/N_{ch}^{exact}");
+  fTabNchDiff->SetDirectory(0);
+
 }
 
 //____________________________________________________________________
@@ -167,7 +203,19 @@ AliFMDDensityCalculator::AliFMDDensityCalculator(const
     fDoTiming(o.fDoTiming),
     fHTiming(o.fHTiming), 
   fMaxOutliers(o.fMaxOutliers),
-  fOutlierCut(o.fOutlierCut)
+  fOutlierCut(o.fOutlierCut),
+  fUseTabulated(o.fUseTabulated),
+  fTabSteps(o.fTabSteps),
+  fTabMax(o.fTabMax),
+  fTabTolerance(o.fTabTolerance),
+  fTabValidate(o.fTabValidate),
+  fFMD1iTab(o.fFMD1iTab),
+  fFMD2iTab(o.fFMD2iTab),
+  fFMD2oTab(o.fFMD2oTab),
+  fFMD3iTab(o.fFMD3iTab),
+  fFMD3oTab(o.fFMD3oTab),
+  fTabDeviation(o.fTabDeviation),
+  fTabNchDiff(o.fTabNchDiff)
 {
   // 
   // Copy constructor 
@@ -232,6 +280,18 @@ AliFMDDensityCalculator::operator=(const AliFMDDensityCalculator& o)
   fHTiming            = o.fHTiming;
   fMaxOutliers        = o.fMaxOutliers;
   fOutlierCut         = o.fOutlierCut;
+  fUseTabulated       = o.fUseTabulated;
+  fTabSteps           = o.fTabSteps;
+  fTabMax             = o.fTabMax;
+  fTabTolerance       = o.fTabTolerance;
+  fTabValidate        = o.fTabValidate;
+  fFMD1iTab           = o.fFMD1iTab;
+  fFMD2iTab           = o.fFMD2iTab;
+  fFMD2oTab           = o.fFMD2oTab;
+  fFMD3iTab           = o.fFMD3iTab;
+  fFMD3oTab           = o.fFMD3oTab;
+  fTabDeviation       = o.fTabDeviation;
+  fTabNchDiff         = o.fTabNchDiff;
 
   fRingHistos.Delete();
   TIter    next(&o.fRingHistos);
@@ -430,6 +490,12 @@ AliFMDDensityCalculator::Calculate(const AliESDFMD&        fmd,
       // etaCache.Reset(AliESDFMD::kInvalidEta);
       // phiCache.Reset(AliESDFMD::kInvalidEta);
 
+      // --- Sums for validation of tabulated response ---------------
+      Bool_t   validate = (fUseTabulated && fTabValidate && !lowFlux);
+      Int_t    nEtaBins = h->GetNbinsX()+2;
+      TArrayD  sumTab(validate ? nEtaBins : 0);
+      TArrayD  sumExact(validate ? nEtaBins : 0);
+
       // --- Loop over sectors and strips ----------------------------
       for (UShort_t s=0; s<ns; s++) { 
 	for (UShort_t t=0; t<nt; t++) {
@@ -497,6 +563,19 @@ AliFMDDensityCalculator::Calculate(const AliESDFMD&        fmd,
 	  START_TIMER(timer);
 	  Double_t n   = 0;
 	  if (cut > 0 && mult > cut) n = NParticles(mult,d,r,eta,lowFlux);
+	  if (validate && cut > 0 && mult > cut) {
+	    // Signals not in the tables were evaluated exactly by
+	    // NParticles already, so do not evaluate them again
+	    AliForwardCorrectionManager& fcm  = 
+	      AliForwardCorrectionManager::Instance();
+	    Int_t    iEta  = fcm.GetELossFit()->FindEtaBin(eta)-1;
+	    Double_t exact = n;
+	    if (TabulatedNParticles(mult,d,r,iEta) >= 0) 
+	      exact = ExactNParticles(mult,d,r,eta);
+	    Int_t b = h->GetXaxis()->FindBin(eta);
+	    sumTab[b]   += n;
+	    sumExact[b] += exact;
+	  }
 	  rh->fELoss->Fill(mult);
 	  // rh->fEvsN->Fill(mult,n);
 	  // rh->fEtaVsN->Fill(eta, n);
@@ -536,6 +615,21 @@ AliFMDDensityCalculator::Calculate(const AliESDFMD&        fmd,
 	} // for t
       } // for s 
 
+      // --- Compare tabulated to exact dN/deta ----------------------
+      if (validate) {
+	Int_t    iring  = (d == 1 ? 1 : (d-1)*2 + q);
+	Double_t maxRel = 0;
+	for (Int_t b = 1; b < nEtaBins-1; b++) {
+	  if (sumExact[b] <= 0) continue;
+	  Double_t rel = (sumTab[b] - sumExact[b]) / sumExact[b];
+	  fTabNchDiff->Fill(iring, rel);
+	  maxRel = TMath::Max(maxRel, TMath::Abs(rel));
+	}
+	if (maxRel > fTabTolerance) 
+	  AliWarningF("Tabulated dN/deta of FMD%d%c deviates by %g > %g",
+		      d, r, maxRel, fTabTolerance);
+      }
+
       // --- Automatic acceptance - Calculate as an efficiency -------
       // This is very fast, so we do not bother to time it 
       rh->fGood->Divide(rh->fGood, rh->fTotal, 1, 1, "B");
@@ -771,6 +865,119 @@ AliFMDDensityCalculator::CacheMaxWeights(const TAxis& axis)
 
   // Cache cuts in histogram
   fCuts.FillHistogram(fLowCuts);
+
+  // Tabulate the response if requested 
+  if (fUseTabulated) CacheTables(cor);
+}
+
+//_____________________________________________________________________
+void
+AliFMDDensityCalculator::CacheTables(const AliFMDCorrELossFit* cor)
+{
+  // 
+  // Make tables of f_W(Delta) for each ring and eta bin from the
+  // energy loss fits, and check them against the exact evaluation
+  // half-way between the nodes.  Bins that do not meet the tolerance
+  // are flagged (first node negative) and evaluated exactly.
+  // 
+  DGUARD(fDebug, 2, "Cache tabulated response in FMD density calculator");
+  if (!cor) return;
+
+  const TAxis& eta  = *(fMaxWeights->GetXaxis());
+  Int_t        nEta = eta.GetNbins();
+  Double_t     dx   = fTabMax / (fTabSteps - 1);
+
+  fTabDeviation->SetBins(nEta, eta.GetXmin(), eta.GetXmax(), 5, .5, 5.5);
+  fTabNchDiff->SetBins(5, .5, 5.5, 100, -10*fTabTolerance, 10*fTabTolerance);
+  TArrayF* tabs[] = { &fFMD1iTab, &fFMD2iTab, &fFMD2oTab, 
+		      &fFMD3iTab, &fFMD3oTab };
+  const UShort_t dets[]  = { 1,   2,   2,   3,   3   };
+  const Char_t   rings[] = { 'I', 'I', 'O', 'I', 'O' };
+  for (Int_t j = 0; j < 5; j++) {
+    fTabDeviation->GetYaxis()->SetBinLabel(j+1, 
+					   fMaxWeights->GetYaxis()
+					   ->GetBinLabel(j+1));
+    fTabNchDiff->GetXaxis()->SetBinLabel(j+1, 
+					 fMaxWeights->GetYaxis()
+					 ->GetBinLabel(j+1));
+  }
+
+  Int_t nExact = 0;
+  Int_t nTab   = 0;
+  for (Int_t j = 0; j < 5; j++) { 
+    TArrayF& tab = *(tabs[j]);
+    tab.Set(nEta * fTabSteps);
+    tab.Reset(-1);
+    for (Int_t i = 0; i < nEta; i++) { 
+      Float_t* row  = tab.GetArray() + i * fTabSteps;
+      Double_t leta = eta.GetBinCenter(i+1);
+      Int_t    m    = GetMaxWeight(dets[j], rings[j], i);
+      if (m < 1) continue;
+      AliFMDCorrELossFit::ELossFit* fit = 
+	cor->FindFit(dets[j], rings[j], leta, -1);
+      if (!fit) continue;
+      UShort_t n = TMath::Min(fMaxParticles, UShort_t(m));
+      for (Int_t k = 0; k < fTabSteps; k++) 
+	row[k] = fit->EvaluateWeighted(k * dx, n);
+
+      // Check against exact evaluation between nodes 
+      Double_t maxDev = 0;
+      for (Int_t k = 0; k < fTabSteps-1; k++) { 
+	Double_t exact = fit->EvaluateWeighted((k + .5) * dx, n);
+	Double_t inter = .5 * (row[k] + row[k+1]);
+	if (exact <= 0) continue;
+	maxDev = TMath::Max(maxDev, TMath::Abs(inter - exact) / exact);
+      }
+      fTabDeviation->SetBinContent(i+1, j+1, maxDev);
+      if (maxDev > fTabTolerance) {
+	row[0] = -1;
+	nExact++;
+	continue;
+      }
+      nTab++;
+    }
+  }
+  AliInfoF("Tabulated response in %d bins, %d bins exceed tolerance %g",
+	   nTab, nExact, fTabTolerance);
+}
+
+//_____________________________________________________________________
+const TArrayF*
+AliFMDDensityCalculator::GetTable(UShort_t d, Char_t r) const
+{
+  // 
+  // Get the table array for FMD<i>dr</i>
+  // 
+  switch (d) { 
+  case 1:  return &fFMD1iTab;
+  case 2:  return (r == 'I' || r == 'i' ? &fFMD2iTab : &fFMD2oTab);
+  case 3:  return (r == 'I' || r == 'i' ? &fFMD3iTab : &fFMD3oTab);
+  }
+  return 0;
+}
+
+//_____________________________________________________________________
+Double_t
+AliFMDDensityCalculator::TabulatedNParticles(Float_t  mult, 
+					     UShort_t d, 
+					     Char_t   r, 
+					     Int_t    iEta) const
+{
+  // 
+  // Look up the number of particles in the tables.  Returns a
+  // negative number if the signal or bin is not tabulated.
+  // 
+  const TArrayF* tab = GetTable(d, r);
+  if (!tab || iEta < 0 || (iEta+1) * fTabSteps > tab->fN) return -1;
+
+  const Float_t* row = tab->GetArray() + iEta * fTabSteps;
+  if (row[0] < 0) return -1;
+
+  Double_t u = mult / fTabMax * (fTabSteps - 1);
+  if (u < 0 || u >= fTabSteps - 1) return -1;
+  Int_t    k = Int_t(u);
+  Double_t f = u - k;
+  return (1 - f) * row[k] + f * row[k+1];
 }
 
 //_____________________________________________________________________
@@ -862,32 +1069,54 @@ AliFMDDensityCalculator::NParticles(Float_t  mult,
   // if (mult <= GetMultCut()) return 0;
   DGUARD(fDebug, 3, "Calculate Nch in FMD density calculator");
   if (lowFlux) return 1;
+
+  Double_t ret = -1;
+  if (fUseTabulated) {
+    AliForwardCorrectionManager& fcm  = AliForwardCorrectionManager::Instance();
+    Int_t                        iEta = fcm.GetELossFit()->FindEtaBin(eta)-1;
+    ret = TabulatedNParticles(mult, d, r, iEta);
+  }
+  if (ret < 0) ret = ExactNParticles(mult, d, r, eta);
+  if (ret < 0) return 0;
+  
+  if (fDebug > 10) {
+    AliInfo(Form("FMD%d%c, eta=%7.4f, %8.5f -> %8.5f", d, r, eta, mult, ret));
+  }
+    
+  fWeightedSum->Fill(ret);
+  fSumOfWeights->Fill(ret);
   
+  return ret;
+}
+
+//_____________________________________________________________________
+Double_t
+AliFMDDensityCalculator::ExactNParticles(Float_t  mult, 
+					 UShort_t d, 
+					 Char_t   r, 
+					 Float_t  eta) const
+{
+  // 
+  // Evaluate the number of particles corresponding to the signal
+  // mult from the energy loss fits.  Returns a negative number if
+  // there is no usable fit.
+  // 
   AliForwardCorrectionManager&  fcm = AliForwardCorrectionManager::Instance();
   AliFMDCorrELossFit::ELossFit* fit = fcm.GetELossFit()->FindFit(d,r,eta, -1);
   if (!fit) { 
     AliWarning(Form("No energy loss fit for FMD%d%c at eta=%f qual=%d", 
 		    d, r, eta, fMinQuality));
-    return 0;
+    return -1;
   }
   
   Int_t    m   = GetMaxWeight(d,r,eta); // fit->FindMaxWeight();
   if (m < 1) { 
     AliWarning(Form("No good fits for FMD%d%c at eta=%f", d, r, eta));
-    return 0;
+    return -1;
   }
   
   UShort_t n   = TMath::Min(fMaxParticles, UShort_t(m));
-  Double_t ret = fit->EvaluateWeighted(mult, n);
-  
-  if (fDebug > 10) {
-    AliInfo(Form("FMD%d%c, eta=%7.4f, %8.5f -> %8.5f", d, r, eta, mult, ret));
-  }
-    
-  fWeightedSum->Fill(ret);
-  fSumOfWeights->Fill(ret);
-  
-  return ret;
+  return fit->EvaluateWeighted(mult, n);
 }
 
 //_____________________________________________________________________
@@ -1105,6 +1334,10 @@ AliFMDDensityCalculator::CreateOutputObjects(TList* dir)
   d->Add(fAccO);
   d->Add(fMaxWeights);
   d->Add(fLowCuts);
+  if (fUseTabulated) { 
+    d->Add(fTabDeviation);
+    d->Add(fTabNchDiff);
+  }
 
   TParameter<int>* nFiles = new TParameter<int>("nFiles", 1);
   nFiles->SetMergeMode('+');
@@ -1120,6 +1353,10 @@ AliFMDDensityCalculator::CreateOutputObjects(TList* dir)
   d->Add(AliForwardUtil::MakeParameter("maxOutliers",  fMaxOutliers));
   d->Add(AliForwardUtil::MakeParameter("outlierCut",   fOutlierCut));
   d->Add(AliForwardUtil::MakeParameter("hitThreshold", fHitThreshold));
+  d->Add(AliForwardUtil::MakeParameter("tabulated",    fUseTabulated));
+  d->Add(AliForwardUtil::MakeParameter("tabSteps",     fTabSteps));
+  d->Add(AliForwardUtil::MakeParameter("tabMax",       fTabMax));
+  d->Add(AliForwardUtil::MakeParameter("tabTolerance", fTabTolerance));
   d->Add(nFiles);
   // d->Add(nxi);
   fCuts.Output(d,"lCuts");
@@ -1201,6 +1438,13 @@ AliFMDDensityCalculator::Print(Option_t* option) const
   PFV("Threshold(hit)",         fHitThreshold);
   PFV("Max(outliers)",          fMaxOutliers);
   PFV("Cut(outlier)",           fOutlierCut);
+  PFB("Tabulated response",     fUseTabulated);
+  if (fUseTabulated) { 
+    PFV("Table nodes",          fTabSteps);
+    PFV("Table max(Delta)",     fTabMax);
+    PFV("Table tolerance",      fTabTolerance);
+    PFB("Table validation",     fTabValidate);
+  }
   PFV("Lower cut", "");
   fCuts.Print();
 
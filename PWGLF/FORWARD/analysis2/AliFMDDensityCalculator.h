@@ -16,6 +16,7 @@
 #include <TNamed.h>
 #include <TList.h>
 #include <TArrayI.h>
+#include <TArrayF.h>
 #include <TVector3.h>
 #include "AliForwardUtil.h"
 #include "AliFMDMultCuts.h"
@@ -211,6 +212,43 @@ public:
    * @param cut Cut value 
    */
   void SetHitThreshold(Double_t cut=0.9) { fHitThreshold = cut; }
+  /** 
+   * Use tabulated values of the weighted number of particles 
+   * @f$ f_W(\Delta)@f$ instead of evaluating the Landau-Gauss
+   * convolutions for each strip.  The tables are made from the
+   * energy loss fits at the start of the run (see SetupForData) for
+   * each ring and @f$\eta@f$ bin, and are linearly interpolated in
+   * @f$\Delta@f$.  Bins where the interpolation deviates from the
+   * exact evaluation by more than the tolerance (see
+   * SetTabulatedTolerance) use the exact evaluation.  Signals above
+   * @a maxDelta are always evaluated exactly.
+   * 
+   * @param use      If true, use tables 
+   * @param nSteps   Number of nodes in each table 
+   * @param maxDelta Largest tabulated signal (in units of MIP)
+   */
+  void SetUseTabulated(Bool_t use=true, Int_t nSteps=512, 
+		       Double_t maxDelta=10) 
+  { 
+    fUseTabulated = use; 
+    fTabSteps     = (nSteps < 2 ? 2 : nSteps);
+    fTabMax       = (maxDelta > 0 ? maxDelta : 10);
+  }
+  /** 
+   * Set the largest relative deviation of the tabulated response
+   * from the exact evaluation.  If @a validate is true, then both
+   * are evaluated for every strip and the relative difference in
+   * @f$ dN_{ch}/d\eta@f$ is histogrammed for each ring.  Deviations
+   * larger than @a tol are reported.
+   * 
+   * @param tol      Relative tolerance 
+   * @param validate If true, compare to exact evaluation per event
+   */
+  void SetTabulatedTolerance(Double_t tol=1e-3, Bool_t validate=false) 
+  { 
+    fTabTolerance = tol; 
+    fTabValidate  = validate;
+  }
   /** 
    * Get the multiplicity cut.  If the user has set fMultCut (via
    * SetMultCut) then that value is used.  If not, then the lower
@@ -319,6 +357,53 @@ protected:
    * @return max weight or <= 0 in case of problems 
    */
   Int_t GetMaxWeight(UShort_t d, Char_t r, Float_t eta) const;
+  /** 
+   * Make tables of @f$ f_W(\Delta)@f$ for all rings and @f$\eta@f$
+   * bins, and check them against the exact evaluation.  Must be
+   * called after CacheMaxWeights.
+   * 
+   * @param cor Energy loss fits 
+   */
+  void CacheTables(const AliFMDCorrELossFit* cor);
+  /** 
+   * Get the table array for FMD<i>dr</i>
+   * 
+   * @param d Detector
+   * @param r Ring 
+   * 
+   * @return Pointer to table or null
+   */
+  const TArrayF* GetTable(UShort_t d, Char_t r) const;
+  /** 
+   * Look up the number of particles corresponding to the signal @a
+   * mult in the tables.
+   * 
+   * @param mult  Signal
+   * @param d     Detector
+   * @param r     Ring 
+   * @param iEta  Eta bin (0-based)
+   * 
+   * @return Number of particles or negative if not tabulated 
+   */
+  Double_t TabulatedNParticles(Float_t  mult, 
+			       UShort_t d, 
+			       Char_t   r, 
+			       Int_t    iEta) const;
+  /** 
+   * Evaluate the number of particles corresponding to the signal @a
+   * mult from the energy loss fits.
+   * 
+   * @param mult  Signal
+   * @param d     Detector
+   * @param r     Ring 
+   * @param eta   Pseudo-rapidity
+   * 
+   * @return Number of particles or negative if there is no usable fit
+   */
+  Double_t ExactNParticles(Float_t  mult, 
+			   UShort_t d, 
+			   Char_t   r, 
+			   Float_t  eta) const;
 
   /** 
    * Get the number of particles corresponding to the signal mult
@@ -504,8 +589,20 @@ protected:
   TProfile*              fHTiming;
   Double_t               fMaxOutliers; // Maximum ratio of outlier bins 
   Double_t               fOutlierCut;  // Maximum relative diviation 
+  Bool_t                 fUseTabulated; // Use tabulated f_W
+  Int_t                  fTabSteps;     // Number of nodes per table
+  Double_t               fTabMax;       // Largest tabulated signal
+  Double_t               fTabTolerance; // Largest relative deviation
+  Bool_t                 fTabValidate;  // Compare to exact per event
+  TArrayF                fFMD1iTab;     //! Tables of f_W
+  TArrayF                fFMD2iTab;     //! Tables of f_W
+  TArrayF                fFMD2oTab;     //! Tables of f_W
+  TArrayF                fFMD3iTab;     //! Tables of f_W
+  TArrayF                fFMD3oTab;     //! Tables of f_W
+  TH2D*                  fTabDeviation; // Table deviation vs eta
+  TH2D*                  fTabNchDiff;   // Relative dN/deta difference
 
-  ClassDef(AliFMDDensityCalculator,16); // Calculate Nch density 
+  ClassDef(AliFMDDensityCalculator,17); // Calculate Nch density 
 };
 
 #endif
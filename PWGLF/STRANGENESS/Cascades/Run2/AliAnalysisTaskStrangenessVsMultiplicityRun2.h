@@ -44,6 +44,8 @@ class AliPIDResponse;
 class AliCFContainer;
 class AliV0Result;
 class AliCascadeResult;
+class AliV0CutTable;
+class AliCascadeCutTable;
 class AliExternalTrackParam;
 
 //#include "TString.h"
@@ -265,6 +267,8 @@ private:
     AliEventCuts fEventCutsStrictAntipileup; /// Event cuts class
 
     TRandom3 *fRand; //!
+    AliV0CutTable      *fV0CutTable;      //! V0 selections of all configurations
+    AliCascadeCutTable *fCascadeCutTable; //! cascade selections of all configurations
 
     //Objects Controlling Task Behaviour
     Bool_t fkSaveEventTree;           //if true, save Event TTree
@@ -678,7 +682,7 @@ private:
     AliAnalysisTaskStrangenessVsMultiplicityRun2(const AliAnalysisTaskStrangenessVsMultiplicityRun2&);            // not implemented
     AliAnalysisTaskStrangenessVsMultiplicityRun2& operator=(const AliAnalysisTaskStrangenessVsMultiplicityRun2&); // not implemented
 
-    ClassDef(AliAnalysisTaskStrangenessVsMultiplicityRun2, 4);
+    ClassDef(AliAnalysisTaskStrangenessVsMultiplicityRun2, 5);
     //1: first implementation
 };
 
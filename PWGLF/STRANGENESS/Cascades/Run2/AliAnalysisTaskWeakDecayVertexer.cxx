@@ -104,9 +104,83 @@ class AliAODv0;
 #include "AliTrackerBase.h"
 #include "AliV0HypSel.h"
 
+//threaded V0 pair evaluation
+#include <thread>
+#include <mutex>
+#include <algorithm>
+#include "TROOT.h"
+#include "TDatabasePDG.h"
+
 using std::cout;
 using std::endl;
 
+namespace {
+    //Outcome of ProcessV0Pair, booked afterwards by FillV0PairStatistics
+    const Int_t kV0PairStepMask  = 0x0F; //number of fHistV0Statistics bins passed (0.5...7.5)
+    const Int_t kV0PairOTFShift  = 4;    //fHistV0OptimalTrackParamUse bin + 1, 0 if no lookup
+    const Int_t kV0PairOTFMask   = 0x30;
+    const Int_t kV0PairUsedOTF   = 0x40; //good V0 with OTF track parameters (bin 8.5)
+    const Int_t kV0PairAccepted  = 0x80; //V0 returned to the caller
+    const Int_t kV0PairSkipped   = 0x100;//track not available, no book-keeping
+    
+    //Transverse plane grid for the binned V0 pre-pairing
+    struct V0PairingGrid {
+        Double_t fMin;  //lower edge in x and y
+        Double_t fCell; //cell size
+        Int_t    fN;    //cells per side
+        Double_t fRmin; //radial window in which circle points are kept
+        Double_t fRmax;
+        Double_t fStep; //sampling step along the circle
+    };
+    
+    //Cells crossed by the circle (xc, yc, rho) within the radial window
+    void GetV0PairingCells(const V0PairingGrid &lGrid, Double_t xc, Double_t yc, Double_t rho, std::vector<Int_t> &lCells)
+    {
+        lCells.clear();
+        //Arc inside r < fRmax: |P|^2 = D^2 + rho^2 + 2 D rho cos(t - phiC)
+        Double_t lD = TMath::Sqrt(xc*xc + yc*yc);
+        Double_t lPhiC = TMath::ATan2(yc, xc);
+        Double_t lT0 = 0, lT1 = TMath::TwoPi();
+        if( lD*rho > 1e-12 ){
+            Double_t lKappa = (lGrid.fRmax*lGrid.fRmax - lD*lD - rho*rho)/(2*lD*rho);
+            if( lKappa < -1 ) return;
+            if( lKappa < 1 ){
+                Double_t lAlpha = TMath::ACos(lKappa);
+                lT0 = lPhiC + lAlpha;
+                lT1 = lPhiC + TMath::TwoPi() - lAlpha;
+            }
+        }else if( rho > lGrid.fRmax ) return;
+        
+        Long_t lNSteps = (Long_t)TMath::Ceil( (lT1-lT0)*rho/lGrid.fStep );
+        if( lNSteps < 1 ) lNSteps = 1;
+        Double_t lDT = (lT1-lT0)/lNSteps;
+        Double_t lRmin2 = lGrid.fRmin*lGrid.fRmin;
+        for(Long_t is=0; is<=lNSteps; is++){
+            Double_t t = lT0 + is*lDT;
+            Double_t x = xc + rho*TMath::Cos(t);
+            Double_t y = yc + rho*TMath::Sin(t);
+            if( x*x + y*y < lRmin2 ) continue;
+            Int_t ix = (Int_t)((x - lGrid.fMin)/lGrid.fCell);
+            Int_t iy = (Int_t)((y - lGrid.fMin)/lGrid.fCell);
+            if( ix < 0 || iy < 0 || ix >= lGrid.fN || iy >= lGrid.fN ) continue;
+            Int_t lCell = iy*lGrid.fN + ix;
+            if( lCells.empty() || lCells.back() != lCell ) lCells.push_back(lCell);
+        }
+        std::sort(lCells.begin(), lCells.end());
+        lCells.erase(std::unique(lCells.begin(), lCells.end()), lCells.end());
+    }
+    
+    //Global state touched by the V0 pair evaluation: set up once, serially
+    void EnableV0PairThreads()
+    {
+        static std::once_flag lFlag;
+        std::call_once(lFlag, [](){
+            ROOT::EnableThreadSafety();
+            TDatabasePDG::Instance()->GetParticle(kK0Short);
+        });
+    }
+}
+
 ClassImp(AliAnalysisTaskWeakDecayVertexer)
 
 AliAnalysisTaskWeakDecayVertexer::AliAnalysisTaskWeakDecayVertexer()
@@ -165,6 +239,9 @@ fV0HypSelArray(NULL),
 fMassWindowAroundCascade(0.060),
 fMinXforXYtest( -3.0 ),
 fOnlyCount(kFALSE), 
+fkUseBinnedPrePairing(kFALSE),
+fPrePairingMargin(0.5),
+fNV0Threads(1),
 //________________________________________________
 //Histos
 fHistEventCounter(0),
@@ -237,6 +314,9 @@ fV0HypSelArray(NULL),
 fMassWindowAroundCascade(0.060),
 fMinXforXYtest( -3.0 ),
 fOnlyCount(kFALSE),
+fkUseBinnedPrePairing(kFALSE),
+fPrePairingMargin(0.5),
+fNV0Threads(1),
 //________________________________________________
 //Histos
 fHistEventCounter(0),
@@ -672,7 +752,6 @@ Long_t AliAnalysisTaskWeakDecayVertexer::Tracks2V0vertices(AliESDEvent *event) {
     
     Double_t xPrimaryVertex=vtxT3D->GetX();
     Double_t yPrimaryVertex=vtxT3D->GetY();
-    Double_t zPrimaryVertex=vtxT3D->GetZ();
     
     Long_t nentr=event->GetNumberOfTracks();
     Double_t b=event->GetMagneticField();
@@ -722,161 +801,374 @@ Long_t AliAnalysisTaskWeakDecayVertexer::Tracks2V0vertices(AliESDEvent *event) {
   
     if( fOnlyCount ) return 0 ; 
   
-    for (i=0; i<nneg; i++) {
-        Long_t nidx=neg[i];
-        AliESDtrack *ntrk=event->GetTrack(nidx);
-        if(!ntrk) continue;
-        
-        for (Int_t k=0; k<npos; k++) {
-            Int_t pidx=pos[k];
-            AliESDtrack *ptrk=event->GetTrack(pidx);
-            if(!ptrk) continue;
-            
-            fHistV0Statistics->Fill(0.5); //number of considered pairs
-            
-            Double_t lNegMassForTracking = ntrk->GetMassForTracking();
-            Double_t lPosMassForTracking = ptrk->GetMassForTracking();
-            
-            fHistV0Statistics->Fill(1.5); //pass distance to PV
-            
-            AliExternalTrackParam nt(*ntrk), pt(*ptrk);
-            Bool_t lUsedOptimalParams = kFALSE;
+    //Candidate pairs: pos entries [lStart[i], lStart[i+1]) for neg track i,
+    //either all of them or only the ones surviving the binned pre-pairing
+    std::vector<Long64_t> lStart;
+    std::vector<Int_t> lList;
+    Bool_t lPrePaired = fkUseBinnedPrePairing && BuildV0PairList(event, neg, nneg, pos, npos, b, lStart, lList);
+    if( !lPrePaired ){
+        lStart.resize(nneg+1);
+        for (i=0; i<=nneg; i++) lStart[i] = (Long64_t)i*npos;
+    }
+    
+    //Material corrections go through TGeo: serial only
+    Long_t lNThreads = fkDoMaterialCorrection ? 1 : TMath::Min((Long_t)fNV0Threads, nneg);
+    
+    if( lNThreads <= 1 ){
+        for (i=0; i<nneg; i++) {
+            Long_t nidx=neg[i];
+            AliESDtrack *ntrk=event->GetTrack(nidx);
+            if(!ntrk) continue;
+            
+            for (Long64_t ip=lStart[i]; ip<lStart[i+1]; ip++) {
+                Int_t pidx=pos[ lPrePaired ? lList[ip] : (Int_t)(ip-lStart[i]) ];
+                AliESDv0 *lV0 = 0x0;
+                Int_t lCode = ProcessV0Pair(event, ntrk, nidx, event->GetTrack(pidx), pidx, b, nHypSel, lV0);
+                FillV0PairStatistics(nidx, pidx, lCode);
+                if( !lV0 ) continue;
+                event->AddV0(lV0);
+                delete lV0;
+                nvtx++;
+            }
+        }
+    }else{
+        //Parallel: rows of neg tracks are taken in batches of bounded size,
+        //each thread evaluates a contiguous block of rows of the batch, then
+        //outcomes are booked and V0s added in the serial pair order
+        std::vector<AliESDtrack*> lNegTrk(nneg), lPosTrk(npos);
+        for (i=0; i<nneg; i++) lNegTrk[i] = event->GetTrack(neg[i]);
+        for (i=0; i<npos; i++) lPosTrk[i] = event->GetTrack(pos[i]);
+        
+        const Long64_t lMaxPairsPerBatch = 1<<22;
+        std::vector<UShort_t> lCode;
+        std::vector< std::vector<AliESDv0*> > lFound(lNThreads);
+        std::vector<Long_t> lBlock(lNThreads+1);
+        EnableV0PairThreads();
+        
+        for (Long_t i0=0, i1=0; i0<nneg; i0=i1) {
+            i1 = i0+1;
+            while( i1<nneg && lStart[i1+1]-lStart[i0] <= lMaxPairsPerBatch ) i1++;
+            const Long64_t lNPairs = lStart[i1]-lStart[i0];
+            lCode.resize(lNPairs);
+            
+            //blocks with similar number of pairs
+            lBlock[0] = i0;
+            for (Long_t it=1, ib=i0; it<=lNThreads; it++) {
+                while( ib<i1 && lStart[ib]-lStart[i0] < lNPairs*it/lNThreads ) ib++;
+                lBlock[it] = it<lNThreads ? ib : i1;
+            }
             
-            if( fkUseOptimalTrackParams ){
-                //reroute to pointers obtained with on-the-fly finding, please
-                map<pair<int,int>, int>::iterator iter = fOTFMap.find(make_pair(nidx,pidx));
-                if(iter != fOTFMap.end())
-                {
-                    Int_t lEquivalentOTFV0 = (*iter).second; // or iter->second;
-                    AliESDv0 *v0_otf = ((AliESDEvent*)event)->GetV0(lEquivalentOTFV0);
-                    if(!v0_otf){
-                        AliWarning(Form("Invalid V0 at position %i!", lEquivalentOTFV0));
-                        fHistV0OptimalTrackParamUse->Fill(2.5);
-                    }else{
-                        AliExternalTrackParam ptimproved(*(v0_otf->GetParamP()));
-                        AliExternalTrackParam ntimproved(*(v0_otf->GetParamN()));
-                        if( v0_otf->GetParamP()->Charge() > 0 && v0_otf->GetParamN()->Charge() < 0 ) {
-                            //V0 daughter track swapping is required! Note: everything is swapped here... P->N, N->P
-                            pt = ptimproved;
-                            nt = ntimproved;
-                        }else{
-                            //swap charges if charges are swapped
-                            pt = ntimproved;
-                            nt = ptimproved;
+            std::vector<std::thread> lThreads;
+            for (Long_t it=0; it<lNThreads; it++) {
+                lThreads.push_back( std::thread( [&, it]() {
+                    for (Long_t ii=lBlock[it]; ii<lBlock[it+1]; ii++) {
+                        for (Long64_t ip=lStart[ii]; ip<lStart[ii+1]; ip++) {
+                            Int_t k = lPrePaired ? lList[ip] : (Int_t)(ip-lStart[ii]);
+                            AliESDv0 *lV0 = 0x0;
+                            lCode[ip-lStart[i0]] = ProcessV0Pair(event, lNegTrk[ii], neg[ii], lPosTrk[k], pos[k], b, nHypSel, lV0);
+                            if( lV0 ) lFound[it].push_back(lV0);
                         }
-                        fHistV0OptimalTrackParamUse->Fill(1.5);
-                        lUsedOptimalParams=kTRUE;
                     }
-                }else{
-                    //OTF not available for this pair
-                    fHistV0OptimalTrackParamUse->Fill(0.5);
-                }
+                } ) );
             }
-            AliExternalTrackParam *ntp=&nt, *ptp=&pt;
-            Double_t xn, xp, dca;
-            
-            //Improved call: use own function, including XY-pre-opt stage
-            
-            //Re-propagate to closest position to the primary vertex if asked to do so
-            if (fkResetInitialPositions){
-                Double_t dztemp[2], covartemp[3];
-                //Safety margin: 250 -> exceedingly large... not sure this makes sense, but ok
-                ntp->PropagateToDCA( vtxT3D , b , 250, dztemp, covartemp );
-                ptp->PropagateToDCA( vtxT3D , b , 250, dztemp, covartemp );
+            for (Long_t it=0; it<lNThreads; it++) lThreads[it].join();
+            
+            for (Long_t it=0; it<lNThreads; it++) {
+                size_t iv = 0;
+                for (Long_t ii=lBlock[it]; ii<lBlock[it+1]; ii++) {
+                    for (Long64_t ip=lStart[ii]; ip<lStart[ii+1]; ip++) {
+                        Int_t k = lPrePaired ? lList[ip] : (Int_t)(ip-lStart[ii]);
+                        Int_t lPairCode = lCode[ip-lStart[i0]];
+                        FillV0PairStatistics(neg[ii], pos[k], lPairCode);
+                        if( !(lPairCode & kV0PairAccepted) ) continue;
+                        AliESDv0 *lV0 = lFound[it][iv++];
+                        event->AddV0(lV0);
+                        delete lV0;
+                        nvtx++;
+                    }
+                }
+                lFound[it].clear();
             }
-            
-            if( fkDoImprovedDCAV0DauPropagation ){
-                //Improved: use own call
-                dca=GetDCAV0Dau(ptp, ntp, xp, xn, b, lNegMassForTracking, lPosMassForTracking);
+        }
+    }
+    AliWarning(Form("Tracks2V0vertices","Number of reconstructed V0 vertices: %ld",nvtx));
+    return nvtx;
+}
+
+//________________________________________________________________________
+Int_t AliAnalysisTaskWeakDecayVertexer::ProcessV0Pair(AliESDEvent *event, AliESDtrack *ntrk, Int_t nidx, AliESDtrack *ptrk, Int_t pidx,
+                                                      Double_t b, Int_t nHypSel, AliESDv0 *&lV0) {
+    //--------------------------------------------------------------------
+    //Try to build a V0 out of one (negative, positive) track pair
+    //Neither histograms nor the event are modified here, so that pairs can
+    //be evaluated concurrently: the outcome is returned as a code to be
+    //booked with FillV0PairStatistics and an accepted V0 is returned in
+    //lV0 (to be deleted by the caller)
+    //--------------------------------------------------------------------
+    lV0 = 0x0;
+    if(!ntrk || !ptrk) return kV0PairSkipped;
+    
+    const AliESDVertex *vtxT3D=event->GetPrimaryVertex();
+    
+    Double_t xPrimaryVertex=vtxT3D->GetX();
+    Double_t yPrimaryVertex=vtxT3D->GetY();
+    Double_t zPrimaryVertex=vtxT3D->GetZ();
+    
+    Int_t lCode = 2; //considered pair, pass distance to PV
+    
+    Double_t lNegMassForTracking = ntrk->GetMassForTracking();
+    Double_t lPosMassForTracking = ptrk->GetMassForTracking();
+    
+    AliExternalTrackParam nt(*ntrk), pt(*ptrk);
+    Bool_t lUsedOptimalParams = kFALSE;
+    
+    if( fkUseOptimalTrackParams ){
+        //reroute to pointers obtained with on-the-fly finding, please
+        map<pair<int,int>, int>::const_iterator iter = fOTFMap.find(make_pair(nidx,pidx));
+        if(iter != fOTFMap.end())
+        {
+            Int_t lEquivalentOTFV0 = (*iter).second; // or iter->second;
+            AliESDv0 *v0_otf = ((AliESDEvent*)event)->GetV0(lEquivalentOTFV0);
+            if(!v0_otf){
+                lCode |= 3 << kV0PairOTFShift;
             }else{
-                //Old: use old call
-                dca=nt.GetDCA(&pt,b,xn,xp);
+                AliExternalTrackParam ptimproved(*(v0_otf->GetParamP()));
+                AliExternalTrackParam ntimproved(*(v0_otf->GetParamN()));
+                if( v0_otf->GetParamP()->Charge() > 0 && v0_otf->GetParamN()->Charge() < 0 ) {
+                    //V0 daughter track swapping is required! Note: everything is swapped here... P->N, N->P
+                    pt = ptimproved;
+                    nt = ntimproved;
+                }else{
+                    //swap charges if charges are swapped
+                    pt = ntimproved;
+                    nt = ptimproved;
+                }
+                lCode |= 2 << kV0PairOTFShift;
+                lUsedOptimalParams=kTRUE;
             }
-            
-            if (dca > fV0VertexerSels[3]) continue;
-            
-            fHistV0Statistics->Fill(2.5); //pass dca
-            
-            if ((xn+xp) > 2*fV0VertexerSels[6] && fkPreselectX) continue;
-            if ((xn+xp) < 2*fV0VertexerSels[5] && fkPreselectX) continue;
-            
-            fHistV0Statistics->Fill(3.5); //pass X within R2D cut
-            
-            if(!fkDoMaterialCorrection){
-                nt.PropagateTo(xn,b);
-                pt.PropagateTo(xp,b);
-            }else{
-                AliExternalTrackParam *ntp=&nt, *ptp=&pt;
-                AliTrackerBase::PropagateTrackTo(ntp, xn, lNegMassForTracking, 3, kFALSE, 0.75, kFALSE, kTRUE );
-                AliTrackerBase::PropagateTrackTo(ptp, xp, lPosMassForTracking, 3, kFALSE, 0.75, kFALSE, kTRUE );
+        }else{
+            //OTF not available for this pair
+            lCode |= 1 << kV0PairOTFShift;
+        }
+    }
+    AliExternalTrackParam *ntp=&nt, *ptp=&pt;
+    Double_t xn, xp, dca;
+    
+    //Improved call: use own function, including XY-pre-opt stage
+    
+    //Re-propagate to closest position to the primary vertex if asked to do so
+    if (fkResetInitialPositions){
+        Double_t dztemp[2], covartemp[3];
+        //Safety margin: 250 -> exceedingly large... not sure this makes sense, but ok
+        ntp->PropagateToDCA( vtxT3D , b , 250, dztemp, covartemp );
+        ptp->PropagateToDCA( vtxT3D , b , 250, dztemp, covartemp );
+    }
+    
+    if( fkDoImprovedDCAV0DauPropagation ){
+        //Improved: use own call
+        dca=GetDCAV0Dau(ptp, ntp, xp, xn, b, lNegMassForTracking, lPosMassForTracking);
+    }else{
+        //Old: use old call
+        dca=nt.GetDCA(&pt,b,xn,xp);
+    }
+    
+    if (dca > fV0VertexerSels[3]) return lCode;
+    
+    lCode = (lCode & ~kV0PairStepMask) | 3; //pass dca
+    
+    if ((xn+xp) > 2*fV0VertexerSels[6] && fkPreselectX) return lCode;
+    if ((xn+xp) < 2*fV0VertexerSels[5] && fkPreselectX) return lCode;
+    
+    lCode = (lCode & ~kV0PairStepMask) | 4; //pass X within R2D cut
+    
+    if(!fkDoMaterialCorrection){
+        nt.PropagateTo(xn,b);
+        pt.PropagateTo(xp,b);
+    }else{
+        AliExternalTrackParam *ntp=&nt, *ptp=&pt;
+        AliTrackerBase::PropagateTrackTo(ntp, xn, lNegMassForTracking, 3, kFALSE, 0.75, kFALSE, kTRUE );
+        AliTrackerBase::PropagateTrackTo(ptp, xp, lPosMassForTracking, 3, kFALSE, 0.75, kFALSE, kTRUE );
+    }
+    
+    //select maximum eta range (after propagation)
+    if (TMath::Abs(nt.Eta())>0.8&&fkExtraCleanup) return lCode;
+    if (TMath::Abs(pt.Eta())>0.8&&fkExtraCleanup) return lCode;
+    
+    lCode = (lCode & ~kV0PairStepMask) | 5; //pass eta cut
+    
+    AliESDv0 vertex(nt,nidx,pt,pidx);
+    
+    //Experimental: refit V0 if asked to do so
+    if( fkDoV0Refit ) vertex.Refit();
+    
+    //No selection: it was not previously applied, don't  apply now.
+    //if (vertex.GetChi2V0() > fChi2max) continue;
+    
+    Double_t x=vertex.Xv(), y=vertex.Yv();
+    Double_t r2=x*x + y*y;
+    if (r2 < fV0VertexerSels[5]*fV0VertexerSels[5]) return lCode;
+    if (r2 > fV0VertexerSels[6]*fV0VertexerSels[6]) return lCode;
+    
+    lCode = (lCode & ~kV0PairStepMask) | 6; //pass radius cut
+    
+    Float_t cpa=vertex.GetV0CosineOfPointingAngle(xPrimaryVertex,yPrimaryVertex,zPrimaryVertex);
+    
+    //Simple cosine cut (no pt dependence for now)
+    if (cpa < fV0VertexerSels[4]) return lCode;
+    
+    lCode = (lCode & ~kV0PairStepMask) | 7; //pass cosPA
+    
+    vertex.SetDcaV0Daughters(dca);
+    vertex.SetV0CosineOfPointingAngle(cpa);
+    vertex.ChangeMassHypothesis(kK0Short);
+    
+    //pre-select on pT
+    Double_t lMomX       = 0. , lMomY = 0., lMomZ = 0.;
+    Double_t lTransvMom  = 0. ;
+    vertex.GetPxPyPz( lMomX, lMomY, lMomZ );
+    lTransvMom      = TMath::Sqrt( lMomX*lMomX   + lMomY*lMomY );
+    if(lTransvMom<fMinPtV0) return lCode;
+    if(lTransvMom>fMaxPtV0) return lCode;
+    
+    lCode = (lCode & ~kV0PairStepMask) | 8; //within pT range
+    if (lUsedOptimalParams) lCode |= kV0PairUsedOTF; //good V0, used OTF params
+    
+    if (nHypSel) { // do we select particular hypthesis? - i.e. does object exist
+        Bool_t reject = kTRUE;
+        float pt = vertex.Pt();
+        for (int ih=0;ih<nHypSel;ih++) {
+            const AliV0HypSel* hyp = (const AliV0HypSel*)(*fV0HypSelArray)[ih];
+            double m = vertex.GetEffMassExplicit(hyp->GetM0(),hyp->GetM1());
+            if (TMath::Abs(m - hyp->GetMass())<hyp->GetMassMargin(pt)) {
+                reject = kFALSE;
+                break;
             }
-            
-            //select maximum eta range (after propagation)
-            if (TMath::Abs(nt.Eta())>0.8&&fkExtraCleanup) continue;
-            if (TMath::Abs(pt.Eta())>0.8&&fkExtraCleanup) continue;
-            
-            fHistV0Statistics->Fill(4.5); //pass eta cut
-            
-            AliESDv0 vertex(nt,nidx,pt,pidx);
-            
-            //Experimental: refit V0 if asked to do so
-            if( fkDoV0Refit ) vertex.Refit();
-            
-            //No selection: it was not previously applied, don't  apply now.
-            //if (vertex.GetChi2V0() > fChi2max) continue;
-            
-            Double_t x=vertex.Xv(), y=vertex.Yv();
-            Double_t r2=x*x + y*y;
-            if (r2 < fV0VertexerSels[5]*fV0VertexerSels[5]) continue;
-            if (r2 > fV0VertexerSels[6]*fV0VertexerSels[6]) continue;
-            
-            fHistV0Statistics->Fill(5.5); //pass radius cut
-            
-            Float_t cpa=vertex.GetV0CosineOfPointingAngle(xPrimaryVertex,yPrimaryVertex,zPrimaryVertex);
-            
-            //Simple cosine cut (no pt dependence for now)
-            if (cpa < fV0VertexerSels[4]) continue;
-            
-            fHistV0Statistics->Fill(6.5); //pass cosPA
-            
-            vertex.SetDcaV0Daughters(dca);
-            vertex.SetV0CosineOfPointingAngle(cpa);
-            vertex.ChangeMassHypothesis(kK0Short);
-            
-            //pre-select on pT
-            Double_t lMomX       = 0. , lMomY = 0., lMomZ = 0.;
-            Double_t lTransvMom  = 0. ;
-            vertex.GetPxPyPz( lMomX, lMomY, lMomZ );
-            lTransvMom      = TMath::Sqrt( lMomX*lMomX   + lMomY*lMomY );
-            if(lTransvMom<fMinPtV0) continue;
-            if(lTransvMom>fMaxPtV0) continue;
-            
-            fHistV0Statistics->Fill(7.5); //within pT range
-            if (lUsedOptimalParams) fHistV0Statistics->Fill(8.5); //good V0, used OTF params
+        }
+        if (reject) return lCode;
+    }
+    
+    lV0 = new AliESDv0(vertex);
+    return lCode | kV0PairAccepted;
+}
+
+//________________________________________________________________________
+void AliAnalysisTaskWeakDecayVertexer::FillV0PairStatistics(Int_t nidx, Int_t pidx, Int_t lCode) {
+    //Book-keeping of one ProcessV0Pair outcome
+    if( lCode & kV0PairSkipped ) return;
+    
+    Int_t lNSteps = lCode & kV0PairStepMask;
+    for(Int_t is=0; is<lNSteps; is++) fHistV0Statistics->Fill(is+0.5);
+    if( lCode & kV0PairUsedOTF ) fHistV0Statistics->Fill(8.5);
+    
+    Int_t lOTF = (lCode & kV0PairOTFMask) >> kV0PairOTFShift;
+    if( lOTF == 3 ){
+        map<pair<int,int>, int>::iterator iter = fOTFMap.find(make_pair(nidx,pidx));
+        AliWarning(Form("Invalid V0 at position %i!", iter != fOTFMap.end() ? iter->second : -1));
+    }
+    if( lOTF > 0 ) fHistV0OptimalTrackParamUse->Fill(lOTF-0.5);
+}
 
-            if (nHypSel) { // do we select particular hypthesis? - i.e. does object exist
-                Bool_t reject = kTRUE;
-                float pt = vertex.Pt();
-                for (int ih=0;ih<nHypSel;ih++) {
-                    const AliV0HypSel* hyp = (const AliV0HypSel*)(*fV0HypSelArray)[ih];
-                    double m = vertex.GetEffMassExplicit(hyp->GetM0(),hyp->GetM1());
-                    if (TMath::Abs(m - hyp->GetMass())<hyp->GetMassMargin(pt)) {
-                        reject = kFALSE;
-                        break;
+//________________________________________________________________________
+Bool_t AliAnalysisTaskWeakDecayVertexer::BuildV0PairList(AliESDEvent *event, const TArrayI &neg, Long_t nneg, const TArrayI &pos, Long_t npos, Double_t b,
+                                                         std::vector<Long64_t> &lStart, std::vector<Int_t> &lList) {
+    //--------------------------------------------------------------------
+    //Binned pre-pairing of the V0 daughter candidates
+    //
+    //Each track circle in the transverse plane is sampled once inside the
+    //V0 radius window (widened by the allowed daughter separation) and the
+    //cells of a cartesian xy grid it crosses are recorded. Only (neg, pos)
+    //pairs sharing neighbouring cells are kept, ordered as in the full loop.
+    //
+    //The DCA between daughters is weighted: the transverse separation can
+    //exceed it by (sigmaY2/sigmaZ2)^(1/4), which enters the allowed
+    //separation together with the margin, the latter absorbing the
+    //difference due to refit or on-the-fly track parameters. Projection on
+    //the transverse plane keeps every helix turn, hence no binning in z.
+    //
+    //Returns kFALSE if no pre-pairing could be done (no field)
+    //--------------------------------------------------------------------
+    if( TMath::Abs(b) < 1e-3 ) return kFALSE;
+    
+    //Allowed transverse separation of the two daughters
+    Double_t lSigmaFactor = 1.;
+    for (Long_t it=0; it<nneg+npos; it++) {
+        AliESDtrack *lTrack = event->GetTrack( it<nneg ? neg[it] : pos[it-nneg] );
+        if( !lTrack || lTrack->GetSigmaZ2() <= 0 ) continue;
+        Double_t lFactor = TMath::Power( lTrack->GetSigmaY2()/lTrack->GetSigmaZ2(), 0.25 );
+        if( lFactor > lSigmaFactor ) lSigmaFactor = lFactor;
+    }
+    Double_t lSeparation = fV0VertexerSels[3]*lSigmaFactor + fPrePairingMargin;
+    if( lSeparation <= 0 ) return kFALSE;
+    
+    //Sampling step = separation: the closest samples of two compatible tracks
+    //are then less than two separations apart, i.e. in neighbouring cells
+    V0PairingGrid lGrid;
+    lGrid.fStep = lSeparation;
+    lGrid.fRmin = TMath::Max(0., fV0VertexerSels[5] - 1.5*lSeparation);
+    lGrid.fRmax = fV0VertexerSels[6] + 1.5*lSeparation;
+    lGrid.fCell = 2*lSeparation;
+    lGrid.fN = (Int_t)TMath::Ceil( 2*lGrid.fRmax/lGrid.fCell ) + 2;
+    if( lGrid.fN > 1024 ){
+        lGrid.fN = 1024;
+        lGrid.fCell = 2*lGrid.fRmax/(lGrid.fN - 2);
+    }
+    lGrid.fMin = -lGrid.fRmax - lGrid.fCell;
+    const Int_t lNCells = lGrid.fN*lGrid.fN;
+    
+    //Positive tracks in each cell (compressed rows)
+    std::vector<Int_t> lCells, lCellEntry;
+    std::vector<Int_t> lCellStart(lNCells+1, 0);
+    std::vector<Int_t> lPosCells, lPosCellsStart(npos+1, 0);
+    for (Long_t k=0; k<npos; k++) {
+        AliESDtrack *lTrack = event->GetTrack(pos[k]);
+        if( lTrack ){
+            Double_t lCenter[2];
+            GetHelixCenter(lTrack, lCenter, b);
+            GetV0PairingCells(lGrid, lCenter[0], lCenter[1], TMath::Abs(1./lTrack->GetC(b)), lCells);
+            for (size_t ic=0; ic<lCells.size(); ic++) {
+                lPosCells.push_back(lCells[ic]);
+                lCellStart[lCells[ic]+1]++;
+            }
+        }
+        lPosCellsStart[k+1] = lPosCells.size();
+    }
+    for (Int_t ic=0; ic<lNCells; ic++) lCellStart[ic+1] += lCellStart[ic];
+    lCellEntry.resize(lPosCells.size());
+    std::vector<Int_t> lFill(lCellStart.begin(), lCellStart.end()-1);
+    for (Long_t k=0; k<npos; k++)
+        for (Int_t ic=lPosCellsStart[k]; ic<lPosCellsStart[k+1]; ic++)
+            lCellEntry[ lFill[lPosCells[ic]]++ ] = k;
+    
+    //Compatible positive tracks for each negative track
+    lStart.assign(nneg+1, 0);
+    lList.clear();
+    std::vector<Long_t> lSeen(npos, -1);
+    for (Long_t i=0; i<nneg; i++) {
+        AliESDtrack *lTrack = event->GetTrack(neg[i]);
+        size_t lFirst = lList.size();
+        if( lTrack ){
+            Double_t lCenter[2];
+            GetHelixCenter(lTrack, lCenter, b);
+            GetV0PairingCells(lGrid, lCenter[0], lCenter[1], TMath::Abs(1./lTrack->GetC(b)), lCells);
+            for (size_t ic=0; ic<lCells.size(); ic++) {
+                Int_t ix = lCells[ic]%lGrid.fN, iy = lCells[ic]/lGrid.fN;
+                for (Int_t jy=TMath::Max(iy-1,0); jy<=TMath::Min(iy+1,lGrid.fN-1); jy++) {
+                    for (Int_t jx=TMath::Max(ix-1,0); jx<=TMath::Min(ix+1,lGrid.fN-1); jx++) {
+                        Int_t lCell = jy*lGrid.fN + jx;
+                        for (Int_t ie=lCellStart[lCell]; ie<lCellStart[lCell+1]; ie++) {
+                            Int_t k = lCellEntry[ie];
+                            if( lSeen[k] == i ) continue;
+                            lSeen[k] = i;
+                            lList.push_back(k);
+                        }
                     }
                 }
-                if (reject) continue;
             }
-            
-            event->AddV0(&vertex);
-            
-            nvtx++;
-            
-            //if ( nvtx % 10000 ) gObjectTable->Print(); //debug, REMOVE ME PLEASE
+            std::sort(lList.begin()+lFirst, lList.end());
         }
+        lStart[i+1] = lList.size();
     }
-    AliWarning(Form("Tracks2V0vertices","Number of reconstructed V0 vertices: %ld",nvtx));
-    return nvtx;
+    return kTRUE;
 }
 
 
@@ -3032,6 +3324,9 @@ void AliAnalysisTaskWeakDecayVertexer::Print()
     cout<<" Master Niterations value...: "<<fMaxIterationsWhenMinimizing<<endl;
     cout<<" Skip large DCAXY in opt....: "<<fkSkipLargeXYDCA<<endl;
     cout<<" MC associated only (MCflag): "<<fkMonteCarlo<<endl;
+    cout<<" V0 binned pre-pairing......: "<<fkUseBinnedPrePairing<<endl;
+    cout<<" Pre-pairing margin (cm)....: "<<fPrePairingMargin<<endl;
+    cout<<" V0 pair threads............: "<<fNV0Threads<<endl;
     cout<<" --> Experimental flags: "<<endl;
     cout<<" Run casc. find. with OTFV0.: "<<fkUseOnTheFlyV0Cascading<<endl;
     cout<<" Combine all chg. in casc...: "<<fkUseUncheckedChargeCascadeVertexer<<endl;
@@ -35,10 +35,14 @@ class AliV0HypSel;
 class AliESDpid;
 class AliESDEvent;
 class AliPhysicsSelection;
+class TArrayI;
+class AliESDtrack;
+class AliESDv0;
 
 #include "AliEventCuts.h"
 //For mapping functionality
 #include <map>
+#include <vector>
 
 using namespace std;
 
@@ -256,6 +260,19 @@ public:
     void SetUseMonteCarloAssociation( Bool_t lOpt = kTRUE) {
         fkMonteCarlo=lOpt;
     }
+    void SetUseBinnedPrePairing( Bool_t lOpt = kTRUE, Double_t lMargin = 0.5 ) {
+        //Only try (neg, pos) pairs whose circles in the transverse plane
+        //come closer than the DCA V0 daughters cut (+ lMargin, in cm)
+        //inside the V0 radius window. V0 statistics then count only the
+        //pairs surviving this stage
+        fkUseBinnedPrePairing = lOpt;
+        fPrePairingMargin = lMargin;
+    }
+    void SetNumberOfV0Threads( Int_t lNThreads = 1 ) {
+        //Evaluate V0 pairs in parallel; V0s are still added in pair order
+        //Ignored if material corrections are enabled
+        fNV0Threads = lNThreads;
+    }
 //---------------------------------------------------------------------------------------
     void SetUseImprovedFinding(){
         fkRunV0Vertexer = kTRUE;
@@ -319,6 +336,13 @@ public:
     Double_t GetDCAV0Dau ( AliExternalTrackParam *pt, AliExternalTrackParam *nt, Double_t &xp, Double_t &xn, Double_t b, Double_t lNegMassForTracking=0.139, Double_t lPosMassForTracking=0.139);
     void GetHelixCenter(const AliExternalTrackParam *track,Double_t center[2], Double_t b);
     //---------------------------------------------------------------------------------------
+    //V0 finding: binned pre-pairing and single pair evaluation
+    Bool_t BuildV0PairList(AliESDEvent *event, const TArrayI &neg, Long_t nneg, const TArrayI &pos, Long_t npos, Double_t b,
+                           std::vector<Long64_t> &lStart, std::vector<Int_t> &lList);
+    Int_t ProcessV0Pair(AliESDEvent *event, AliESDtrack *ntrk, Int_t nidx, AliESDtrack *ptrk, Int_t pidx,
+                        Double_t b, Int_t nHypSel, AliESDv0 *&lV0);
+    void FillV0PairStatistics(Int_t nidx, Int_t pidx, Int_t lCode);
+    //---------------------------------------------------------------------------------------
     
     //---------------------------------------------------------------------------------------
     // changes to enable AliExternalTrackParam inheritance from on-the-fly finder
@@ -410,6 +434,9 @@ private:
     
     Double_t fMinXforXYtest; //min X allowed for XY-plane preopt test
     Bool_t   fOnlyCount; //if true, don't minimize anything (fast, count tracks only) 
+    Bool_t   fkUseBinnedPrePairing; //if true, only pair tracks close in the transverse plane
+    Double_t fPrePairingMargin; //safety margin (cm) added to the DCA cut in the pre-pairing
+    Int_t    fNV0Threads; //number of threads evaluating V0 pairs
     
     Double_t  fV0VertexerSels[7];        // Array to store the 7 values for the different selections V0 related
     Double_t  fCascadeVertexerSels[8];   // Array to store the 8 values for the different selections Casc. related
@@ -438,8 +465,9 @@ private:
     AliAnalysisTaskWeakDecayVertexer(const AliAnalysisTaskWeakDecayVertexer&);            // not implemented
     AliAnalysisTaskWeakDecayVertexer& operator=(const AliAnalysisTaskWeakDecayVertexer&); // not implemented
 
-    ClassDef(AliAnalysisTaskWeakDecayVertexer, 1);
+    ClassDef(AliAnalysisTaskWeakDecayVertexer, 2);
     //1: first implementation
+    //2: binned pre-pairing and threaded V0 pair evaluation
 };
 
 #endif
@@ -0,0 +1,342 @@
+//+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+// Table of cascade selections, one column per cut and one row per
+// AliCascadeResult configuration (see header)
+//+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+
+#include "TList.h"
+#include "TH3F.h"
+#include "TMath.h"
+#include "AliCascadeResult.h"
+#include "AliCascadeCutTable.h"
+
+ClassImp(AliCascadeCutTable);
+//________________________________________________________________
+AliCascadeCutTable::AliCascadeCutTable() :
+TObject()
+{
+    // Dummy Constructor - not to be used!
+}
+//________________________________________________________________
+void AliCascadeCutTable::Clear(Option_t*)
+{
+    //Remove all configurations
+    fResult.clear();
+    fHisto.clear();
+    fMassHypo.clear();
+    fCharge.clear();
+    fPDGMass.clear();
+    fXiRejection.clear();
+    fXiRejectionWindow.clear();
+    fMinEtaTracks.clear();
+    fMaxEtaTracks.clear();
+    fMinRapidity.clear();
+    fMaxRapidity.clear();
+    fDCANegToPV.clear();
+    fDCAPosToPV.clear();
+    fDCAV0Daughters.clear();
+    fV0CosPA.clear();
+    fV0Radius.clear();
+    fDCAV0ToPV.clear();
+    fV0Mass.clear();
+    fDCABachToPV.clear();
+    fDCACascDaughters.clear();
+    fCascCosPA.clear();
+    fCascRadius.clear();
+    fV0MassSigma.clear();
+    fProperLifetime.clear();
+    fLeastNbrClusters.clear();
+    fTPCdEdx.clear();
+    fUseTOFUnchecked.clear();
+    fDCABachToBaryon.clear();
+    fBBCosPA.clear();
+    fMinV0Lifetime.clear();
+    fMaxV0Lifetime.clear();
+    fUseITSRefitTracks.clear();
+    fMaxChi2PerCluster.clear();
+    fMinTrackLength.clear();
+    fUseParametricLength.clear();
+    fUse276TeVV0CosPA.clear();
+    fDCACascadeToPV.clear();
+    fAtLeastOneTOF.clear();
+    fUseITSRefitNegative.clear();
+    fUseITSRefitPositive.clear();
+    fUseITSRefitBachelor.clear();
+    fIsCowboy.clear();
+    fIsCascadeCowboy.clear();
+    fMinCrossedRowsOverLength.clear();
+    fLeastNbrCrossedRows.clear();
+    fITSorTOF.clear();
+    fVarCascCosPA.clear();
+    fVarV0CosPA.clear();
+    fVarBBCosPA.clear();
+    fVarDCACascDau.clear();
+    fCascCosPACut.clear();
+    fV0CosPACut.clear();
+    fBBCosPACut.clear();
+    fDCACascDauCut.clear();
+    fPass.clear();
+}
+//________________________________________________________________
+Int_t AliCascadeCutTable::Compile(TList *lList)
+{
+    //Append all AliCascadeResult configurations of lList to the table
+    //Histograms must have been initialized beforehand
+    if( !lList ) return 0;
+    Int_t lNbrConfigs = lList->GetEntries();
+    for(Int_t icfg=0; icfg<lNbrConfigs; icfg++){
+        AliCascadeResult *lCascadeResult = (AliCascadeResult*) lList->At(icfg);
+        Int_t lHypo = lCascadeResult->GetMassHypothesis();
+        Bool_t lIsOmega = ( lHypo == AliCascadeResult::kOmegaMinus || lHypo == AliCascadeResult::kOmegaPlus );
+        Int_t lCharge = ( lHypo == AliCascadeResult::kXiMinus || lHypo == AliCascadeResult::kOmegaMinus ) ? -1 : +1;
+        if ( lCascadeResult->GetSwapBachelorCharge() ) lCharge *= -1;
+
+        fResult.push_back( lCascadeResult );
+        fHisto.push_back( lCascadeResult->GetHistogram() );
+        fMassHypo.push_back( lHypo );
+        fCharge.push_back( lCharge );
+        fPDGMass.push_back( lIsOmega ? 1.67245 : 1.32171 );
+        fXiRejection.push_back( lIsOmega );
+        fXiRejectionWindow.push_back( lCascadeResult->GetCutXiRejection() );
+        fMinEtaTracks.push_back( lCascadeResult->GetCutMinEtaTracks() );
+        fMaxEtaTracks.push_back( lCascadeResult->GetCutMaxEtaTracks() );
+        fMinRapidity.push_back( lCascadeResult->GetCutMinRapidity() );
+        fMaxRapidity.push_back( lCascadeResult->GetCutMaxRapidity() );
+        fDCANegToPV.push_back( lCascadeResult->GetCutDCANegToPV() );
+        fDCAPosToPV.push_back( lCascadeResult->GetCutDCAPosToPV() );
+        fDCAV0Daughters.push_back( lCascadeResult->GetCutDCAV0Daughters() );
+        fV0CosPA.push_back( lCascadeResult->GetCutV0CosPA() );
+        fV0Radius.push_back( lCascadeResult->GetCutV0Radius() );
+        fDCAV0ToPV.push_back( lCascadeResult->GetCutDCAV0ToPV() );
+        fV0Mass.push_back( lCascadeResult->GetCutV0Mass() );
+        fDCABachToPV.push_back( lCascadeResult->GetCutDCABachToPV() );
+        fDCACascDaughters.push_back( lCascadeResult->GetCutDCACascDaughters() );
+        fCascCosPA.push_back( lCascadeResult->GetCutCascCosPA() );
+        fCascRadius.push_back( lCascadeResult->GetCutCascRadius() );
+        fV0MassSigma.push_back( lCascadeResult->GetCutV0MassSigma() );
+        fProperLifetime.push_back( lCascadeResult->GetCutProperLifetime() );
+        fLeastNbrClusters.push_back( lCascadeResult->GetCutLeastNumberOfClusters() );
+        fTPCdEdx.push_back( lCascadeResult->GetCutTPCdEdx() );
+        fUseTOFUnchecked.push_back( lCascadeResult->GetCutUseTOFUnchecked() );
+        fDCABachToBaryon.push_back( lCascadeResult->GetCutDCABachToBaryon() );
+        fBBCosPA.push_back( lCascadeResult->GetCutBachBaryonCosPA() );
+        fMinV0Lifetime.push_back( lCascadeResult->GetCutMinV0Lifetime() );
+        fMaxV0Lifetime.push_back( lCascadeResult->GetCutMaxV0Lifetime() );
+        fUseITSRefitTracks.push_back( lCascadeResult->GetCutUseITSRefitTracks() );
+        fMaxChi2PerCluster.push_back( lCascadeResult->GetCutMaxChi2PerCluster() );
+        fMinTrackLength.push_back( lCascadeResult->GetCutMinTrackLength() );
+        fUseParametricLength.push_back( lCascadeResult->GetCutUseParametricLength() );
+        fUse276TeVV0CosPA.push_back( lCascadeResult->GetCutUse276TeVV0CosPA() );
+        fDCACascadeToPV.push_back( lCascadeResult->GetCutDCACascadeToPV() );
+        fAtLeastOneTOF.push_back( lCascadeResult->GetCutAtLeastOneTOF() );
+        fUseITSRefitNegative.push_back( lCascadeResult->GetCutUseITSRefitNegative() );
+        fUseITSRefitPositive.push_back( lCascadeResult->GetCutUseITSRefitPositive() );
+        fUseITSRefitBachelor.push_back( lCascadeResult->GetCutUseITSRefitBachelor() );
+        fIsCowboy.push_back( lCascadeResult->GetCutIsCowboy() );
+        fIsCascadeCowboy.push_back( lCascadeResult->GetCutIsCascadeCowboy() );
+        fMinCrossedRowsOverLength.push_back( lCascadeResult->GetCutMinCrossedRowsOverLength() );
+        fLeastNbrCrossedRows.push_back( lCascadeResult->GetCutLeastNumberOfCrossedRows() );
+        fITSorTOF.push_back( lCascadeResult->GetCutITSorTOF() );
+
+        //Variable cuts: parameters kept in single precision as in the task
+        VarCut lVar;
+        lVar.fIndex = fResult.size()-1;
+        if( lCascadeResult->GetCutUseVarCascCosPA() ){
+            lVar.fPar[0] = lCascadeResult->GetCutVarCascCosPAExp0Const();
+            lVar.fPar[1] = lCascadeResult->GetCutVarCascCosPAExp0Slope();
+            lVar.fPar[2] = lCascadeResult->GetCutVarCascCosPAExp1Const();
+            lVar.fPar[3] = lCascadeResult->GetCutVarCascCosPAExp1Slope();
+            lVar.fPar[4] = lCascadeResult->GetCutVarCascCosPAConst();
+            fVarCascCosPA.push_back( lVar );
+        }
+        if( lCascadeResult->GetCutUseVarV0CosPA() ){
+            lVar.fPar[0] = lCascadeResult->GetCutVarV0CosPAExp0Const();
+            lVar.fPar[1] = lCascadeResult->GetCutVarV0CosPAExp0Slope();
+            lVar.fPar[2] = lCascadeResult->GetCutVarV0CosPAExp1Const();
+            lVar.fPar[3] = lCascadeResult->GetCutVarV0CosPAExp1Slope();
+            lVar.fPar[4] = lCascadeResult->GetCutVarV0CosPAConst();
+            fVarV0CosPA.push_back( lVar );
+        }
+        if( lCascadeResult->GetCutUseVarBBCosPA() ){
+            lVar.fPar[0] = lCascadeResult->GetCutVarBBCosPAExp0Const();
+            lVar.fPar[1] = lCascadeResult->GetCutVarBBCosPAExp0Slope();
+            lVar.fPar[2] = lCascadeResult->GetCutVarBBCosPAExp1Const();
+            lVar.fPar[3] = lCascadeResult->GetCutVarBBCosPAExp1Slope();
+            lVar.fPar[4] = lCascadeResult->GetCutVarBBCosPAConst();
+            fVarBBCosPA.push_back( lVar );
+        }
+        if( lCascadeResult->GetCutUseVarDCACascDau() ){
+            lVar.fPar[0] = lCascadeResult->GetCutVarDCACascDauExp0Const();
+            lVar.fPar[1] = lCascadeResult->GetCutVarDCACascDauExp0Slope();
+            lVar.fPar[2] = lCascadeResult->GetCutVarDCACascDauExp1Const();
+            lVar.fPar[3] = lCascadeResult->GetCutVarDCACascDauExp1Slope();
+            lVar.fPar[4] = lCascadeResult->GetCutVarDCACascDauConst();
+            fVarDCACascDau.push_back( lVar );
+        }
+    }
+    fCascCosPACut.resize( fResult.size() );
+    fV0CosPACut.resize( fResult.size() );
+    fBBCosPACut.resize( fResult.size() );
+    fDCACascDauCut.resize( fResult.size() );
+    fPass.resize( fResult.size() );
+    return lNbrConfigs;
+}
+//________________________________________________________________
+void AliCascadeCutTable::ApplyVarCosPA(const std::vector<VarCut> &lVar, std::vector<Float_t> &lCut, Float_t lPt) const
+{
+    //Variable CosPA cut only used if tighter than the non-variable cut
+    for(size_t ivar=0; ivar<lVar.size(); ivar++){
+        const Float_t *lPar = lVar[ivar].fPar;
+        Float_t lVarCosPA = TMath::Cos(
+                                       lPar[0]*TMath::Exp(lPar[1]*lPt) +
+                                       lPar[2]*TMath::Exp(lPar[3]*lPt) +
+                                       lPar[4]);
+        Int_t icfg = lVar[ivar].fIndex;
+        if( lVarCosPA > lCut[icfg] ) lCut[icfg] = lVarCosPA;
+    }
+}
+//________________________________________________________________
+Int_t AliCascadeCutTable::Evaluate(const AliCascadeCutTable::Candidate &lCand)
+{
+    //Test lCand against all configurations, fill the pass flags
+    //and return the number of configurations passed
+    const Int_t lNbrConfigs = GetNConfigurations();
+    if( lNbrConfigs == 0 ) return 0;
+
+    //Effective cuts including the variable ones
+    for(Int_t icfg=0; icfg<lNbrConfigs; icfg++){
+        fCascCosPACut [icfg] = fCascCosPA[icfg];
+        fV0CosPACut   [icfg] = fV0CosPA[icfg];
+        fBBCosPACut   [icfg] = fBBCosPA[icfg];
+        fDCACascDauCut[icfg] = fDCACascDaughters[icfg];
+    }
+    ApplyVarCosPA( fVarCascCosPA, fCascCosPACut, lCand.fPt );
+    ApplyVarCosPA( fVarV0CosPA,   fV0CosPACut,   lCand.fPt );
+    ApplyVarCosPA( fVarBBCosPA,   fBBCosPACut,   lCand.fPt );
+    for(size_t ivar=0; ivar<fVarDCACascDau.size(); ivar++){
+        //Loosest: default cut, parametric can go tighter
+        const Float_t *lPar = fVarDCACascDau[ivar].fPar;
+        Float_t lVarDCACascDau = lPar[0]*TMath::Exp(lPar[1]*lCand.fPt) +
+        lPar[2]*TMath::Exp(lPar[3]*lCand.fPt) +
+        lPar[4];
+        Int_t icfg = fVarDCACascDau[ivar].fIndex;
+        if( lVarDCACascDau < fDCACascDauCut[icfg] ) fDCACascDauCut[icfg] = lVarDCACascDau;
+    }
+
+    //Quantities that depend on the mass hypothesis only
+    Double_t lV0MassWindow[4];
+    Float_t  lV0MassNSigma[4];
+    UChar_t  lTOFOK[4];
+    for(Int_t ih=0; ih<4; ih++){
+        lV0MassWindow[ih] = TMath::Abs(lCand.fV0Mass[ih]-1.116);
+        lV0MassNSigma[ih] = TMath::Abs( (lCand.fV0Mass[ih]-lCand.fExpV0Mass) / lCand.fExpV0Sigma );
+        lTOFOK[ih] = ( TMath::Abs(lCand.fNegTOFsigma[ih]) < 4 &&
+                      TMath::Abs(lCand.fPosTOFsigma[ih]) < 4 &&
+                      TMath::Abs(lCand.fBachTOFsigma[ih])< 4 );
+    }
+    const Double_t lXiMassWindow = TMath::Abs( lCand.fMassAsXi - 1.32171 );
+    const Double_t lDCACascadeToPV = TMath::Sqrt(lCand.fCascDCAtoPVz*lCand.fCascDCAtoPVz + lCand.fCascDCAtoPVxy*lCand.fCascDCAtoPVxy);
+
+    Int_t lNPassed = 0;
+    for(Int_t icfg=0; icfg<lNbrConfigs; icfg++){
+        const Int_t ih = fMassHypo[icfg];
+        const Float_t lRap = lCand.fRap[ih];
+        const Double_t lMinLength = fMinTrackLength[icfg];
+        const Int_t lCowboy = fIsCowboy[icfg];
+        const Int_t lCascadeCowboy = fIsCascadeCowboy[icfg];
+
+        UChar_t lPass =
+        lCand.fValid[ih] &
+
+        //Charge consistent with expectations
+        ( lCand.fCharge == fCharge[icfg] ) &
+
+        //Basic Acceptance cuts
+        ( fMinEtaTracks[icfg] < lCand.fPosEta ) & ( lCand.fPosEta < fMaxEtaTracks[icfg] ) &
+        ( fMinEtaTracks[icfg] < lCand.fNegEta ) & ( lCand.fNegEta < fMaxEtaTracks[icfg] ) &
+        ( fMinEtaTracks[icfg] < lCand.fBachEta ) & ( lCand.fBachEta < fMaxEtaTracks[icfg] ) &
+        ( lRap > fMinRapidity[icfg] ) &
+        ( lRap < fMaxRapidity[icfg] ) &
+
+        //Topological Variables: V0
+        ( lCand.fDCANegToPV > fDCANegToPV[icfg] ) &
+        ( lCand.fDCAPosToPV > fDCAPosToPV[icfg] ) &
+        ( lCand.fDCAV0Daughters < fDCAV0Daughters[icfg] ) &
+        ( lCand.fV0CosPA > fV0CosPACut[icfg] ) &
+        ( lCand.fV0Radius > fV0Radius[icfg] ) &
+        //Topological Variables: cascade
+        ( lCand.fDCAV0ToPV > fDCAV0ToPV[icfg] ) &
+        ( lV0MassWindow[ih] < fV0Mass[icfg] ) &
+        ( lCand.fDCABachToPV > fDCABachToPV[icfg] ) &
+        ( lCand.fDCACascDaughters < fDCACascDauCut[icfg] ) &
+        ( lCand.fCascCosPA > fCascCosPACut[icfg] ) &
+        ( lCand.fCascRadius > fCascRadius[icfg] ) &
+
+        //Parametric V0 Mass cut if requested
+        ( fV0MassSigma[icfg] > 50 || lV0MassNSigma[ih] < fV0MassSigma[icfg] ) &
+
+        //Miscellaneous
+        ( lCand.fDistOverTotMom*fPDGMass[icfg] < fProperLifetime[icfg] ) &
+        ( lCand.fLeastNbrClusters > fLeastNbrClusters[icfg] ) &
+
+        //TPC dEdx selections
+        ( TMath::Abs(lCand.fNegdEdx[ih] ) < fTPCdEdx[icfg] ) &
+        ( TMath::Abs(lCand.fPosdEdx[ih] ) < fTPCdEdx[icfg] ) &
+        ( TMath::Abs(lCand.fBachdEdx[ih]) < fTPCdEdx[icfg] ) &
+
+        //TOF selections (experimental)
+        ( !fUseTOFUnchecked[icfg] || lTOFOK[ih] ) &
+
+        //Xi rejection for Omega analysis
+        ( !fXiRejection[icfg] || lXiMassWindow > fXiRejectionWindow[icfg] ) &
+
+        //Experimental DCA Bachelor to Baryon cut
+        ( lCand.fDCABachToBaryon > fDCABachToBaryon[icfg] ) &
+
+        //Experimental Bach Baryon CosPA
+        ( lCand.fWrongCosPA < fBBCosPACut[icfg] ) &
+
+        //Min/Max V0 Lifetime cut
+        ( lCand.fV0Lifetime > fMinV0Lifetime[icfg] ) &
+        ( lCand.fV0Lifetime < fMaxV0Lifetime[icfg] || fMaxV0Lifetime[icfg] > 1e+3 ) &
+
+        //kITSrefit track selection if requested
+        ( lCand.fITSRefit || !fUseITSRefitTracks[icfg] ) &
+
+        //Max Chi2/Clusters if not absurd
+        ( fMaxChi2PerCluster[icfg] > 1e+3 || lCand.fMaxChi2PerCluster < fMaxChi2PerCluster[icfg] ) &
+
+        //Min Track Length if positive, [min - (1/pt)^1.5] if parametric requested
+        ( lMinLength < 0 ||
+         ( lCand.fMinTrackLength > lMinLength && !fUseParametricLength[icfg] ) ||
+         ( lCand.fMinTrackLength > lMinLength - lCand.fLengthTermPt - lCand.fLengthTermRadius && fUseParametricLength[icfg] ) ) &
+
+        //Special V0 CosPA cut
+        ( !fUse276TeVV0CosPA[icfg] || lCand.fV0CosPA > lCand.f276TeVV0CosPA ) &
+
+        //3D Cascade DCA to PV
+        ( fDCACascadeToPV[icfg] > 999 || lDCACascadeToPV < fDCACascadeToPV[icfg] ) &
+
+        //At least one track with some TOF info
+        ( !fAtLeastOneTOF[icfg] || lCand.fAtLeastOneTOF ) &
+
+        //ITS refit for each prong
+        ( !fUseITSRefitNegative[icfg] || lCand.fNegITSRefit ) &
+        ( !fUseITSRefitPositive[icfg] || lCand.fPosITSRefit ) &
+        ( !fUseITSRefitBachelor[icfg] || lCand.fBachITSRefit ) &
+
+        //cowboy/sailor for V0 and for cascade
+        ( lCowboy == 0 || ( lCowboy == 1 && lCand.fIsCowboy ) || ( lCowboy == -1 && !lCand.fIsCowboy ) ) &
+        ( lCascadeCowboy == 0 || ( lCascadeCowboy == 1 && lCand.fIsCascadeCowboy ) || ( lCascadeCowboy == -1 && !lCand.fIsCascadeCowboy ) ) &
+
+        //modern track quality selections
+        ( fMinCrossedRowsOverLength[icfg] < 0 || lCand.fLeastNcrOverLength > fMinCrossedRowsOverLength[icfg] ) &
+        ( fLeastNbrCrossedRows[icfg] < 0 || lCand.fLeastNbrCrossedRows > fLeastNbrCrossedRows[icfg] ) &
+
+        //ITS or TOF required
+        ( !fITSorTOF[icfg] || lCand.fITSorTOF );
+
+        fPass[icfg] = lPass;
+        lNPassed += lPass;
+    }
+    return lNPassed;
+}
@@ -0,0 +1,167 @@
+#ifndef AliCascadeCutTable_H
+#define AliCascadeCutTable_H
+#include <TObject.h>
+#include <vector>
+
+class TList;
+class TH3F;
+class AliCascadeResult;
+
+//+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+// Table of cascade selections, one column per cut and one row per
+// AliCascadeResult configuration. Built once from the output lists
+// with Compile(), then each candidate is tested against all
+// configurations in one pass with Evaluate(), which fills one pass
+// flag per row. Same selections as the superlight adaptive output
+// mode of AliAnalysisTaskStrangenessVsMultiplicityRun2.
+//+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+
+class AliCascadeCutTable : public TObject {
+
+public:
+    //Candidate properties used in the selection
+    //Arrays are indexed by AliCascadeResult::EMassHypo
+    struct Candidate {
+        Int_t    fCharge;
+        Float_t  fPt;
+        Float_t  fNegEta;
+        Float_t  fPosEta;
+        Float_t  fBachEta;
+        Float_t  fDCANegToPV;
+        Float_t  fDCAPosToPV;
+        Float_t  fDCAV0Daughters;
+        Float_t  fV0CosPA;
+        Float_t  fV0Radius;
+        Float_t  fDCAV0ToPV;
+        Float_t  fDCABachToPV;
+        Float_t  fDCACascDaughters;
+        Float_t  fCascCosPA;
+        Float_t  fCascRadius;
+        Float_t  fExpV0Mass;         //parametric V0 mass mean
+        Float_t  fExpV0Sigma;        //parametric V0 mass width
+        Float_t  f276TeVV0CosPA;     //2.76TeV-like V0 CosPA cut
+        Float_t  fDistOverTotMom;
+        Int_t    fLeastNbrClusters;
+        Float_t  fMassAsXi;
+        Float_t  fDCABachToBaryon;
+        Float_t  fWrongCosPA;
+        Float_t  fV0Lifetime;
+        Bool_t   fITSRefit;          //all three prongs have kITSrefit
+        Bool_t   fNegITSRefit;
+        Bool_t   fPosITSRefit;
+        Bool_t   fBachITSRefit;
+        Float_t  fMaxChi2PerCluster;
+        Float_t  fMinTrackLength;
+        Double_t fLengthTermPt;      //(1/pt)^1.5 term of the parametric length cut
+        Double_t fLengthTermRadius;  //radius term of the parametric length cut
+        Float_t  fCascDCAtoPVxy;
+        Float_t  fCascDCAtoPVz;
+        Bool_t   fAtLeastOneTOF;
+        Bool_t   fIsCowboy;
+        Bool_t   fIsCascadeCowboy;
+        Float_t  fLeastNcrOverLength;
+        Int_t    fLeastNbrCrossedRows;
+        Bool_t   fITSorTOF;
+
+        Bool_t   fValid[4];          //hypothesis to be tested at all
+        Float_t  fMass[4];
+        Float_t  fV0Mass[4];
+        Float_t  fRap[4];
+        Float_t  fNegdEdx[4];
+        Float_t  fPosdEdx[4];
+        Float_t  fBachdEdx[4];
+        Float_t  fNegTOFsigma[4];
+        Float_t  fPosTOFsigma[4];
+        Float_t  fBachTOFsigma[4];
+    };
+
+    AliCascadeCutTable();
+    virtual ~AliCascadeCutTable() {}
+
+    void  Clear(Option_t* = "");
+    Int_t Compile(TList *lList);
+    Int_t Evaluate(const AliCascadeCutTable::Candidate &lCand);
+
+    Int_t             GetNConfigurations() const { return (Int_t)fResult.size(); }
+    AliCascadeResult* GetResult        (Int_t i) const { return fResult[i];   }
+    TH3F*             GetHistogram     (Int_t i) const { return fHisto[i];    }
+    Int_t             GetMassHypothesis(Int_t i) const { return fMassHypo[i]; }
+    Bool_t            IsPassed         (Int_t i) const { return fPass[i];     }
+    const UChar_t*    GetPassMask      ()        const { return fPass.empty() ? 0x0 : &fPass[0]; }
+
+private:
+    AliCascadeCutTable(const AliCascadeCutTable&);            // not implemented
+    AliCascadeCutTable& operator=(const AliCascadeCutTable&); // not implemented
+
+    //Variable cut of the form p0*exp(p1*pt)+p2*exp(p3*pt)+p4, cos() of it for CosPA
+    struct VarCut {
+        Int_t   fIndex;
+        Float_t fPar[5];
+    };
+    void ApplyVarCosPA(const std::vector<VarCut> &lVar, std::vector<Float_t> &lCut, Float_t lPt) const;
+
+    std::vector<AliCascadeResult*> fResult; //! configuration
+    std::vector<TH3F*>             fHisto;  //! its output histogram
+
+    //Per-configuration cuts (type as returned by the AliCascadeResult getters)
+    std::vector<Int_t>    fMassHypo;                 //!
+    std::vector<Int_t>    fCharge;                   //! expected charge, bachelor swap included
+    std::vector<Float_t>  fPDGMass;                  //!
+    std::vector<UChar_t>  fXiRejection;              //! Xi rejection active (Omega only)
+    std::vector<Double_t> fXiRejectionWindow;        //!
+    std::vector<Double_t> fMinEtaTracks;             //!
+    std::vector<Double_t> fMaxEtaTracks;             //!
+    std::vector<Double_t> fMinRapidity;              //!
+    std::vector<Double_t> fMaxRapidity;              //!
+    std::vector<Double_t> fDCANegToPV;               //!
+    std::vector<Double_t> fDCAPosToPV;               //!
+    std::vector<Double_t> fDCAV0Daughters;           //!
+    std::vector<Float_t>  fV0CosPA;                  //! fixed cut
+    std::vector<Double_t> fV0Radius;                 //!
+    std::vector<Double_t> fDCAV0ToPV;                //!
+    std::vector<Double_t> fV0Mass;                   //!
+    std::vector<Double_t> fDCABachToPV;              //!
+    std::vector<Float_t>  fDCACascDaughters;         //! fixed cut
+    std::vector<Float_t>  fCascCosPA;                //! fixed cut
+    std::vector<Double_t> fCascRadius;               //!
+    std::vector<Double_t> fV0MassSigma;              //!
+    std::vector<Double_t> fProperLifetime;           //!
+    std::vector<Double_t> fLeastNbrClusters;         //!
+    std::vector<Double_t> fTPCdEdx;                  //!
+    std::vector<UChar_t>  fUseTOFUnchecked;          //!
+    std::vector<Double_t> fDCABachToBaryon;          //!
+    std::vector<Float_t>  fBBCosPA;                  //! fixed cut
+    std::vector<Double_t> fMinV0Lifetime;            //!
+    std::vector<Double_t> fMaxV0Lifetime;            //!
+    std::vector<UChar_t>  fUseITSRefitTracks;        //!
+    std::vector<Double_t> fMaxChi2PerCluster;        //!
+    std::vector<Double_t> fMinTrackLength;           //!
+    std::vector<UChar_t>  fUseParametricLength;      //!
+    std::vector<UChar_t>  fUse276TeVV0CosPA;         //!
+    std::vector<Double_t> fDCACascadeToPV;           //!
+    std::vector<UChar_t>  fAtLeastOneTOF;            //!
+    std::vector<UChar_t>  fUseITSRefitNegative;      //!
+    std::vector<UChar_t>  fUseITSRefitPositive;      //!
+    std::vector<UChar_t>  fUseITSRefitBachelor;      //!
+    std::vector<Int_t>    fIsCowboy;                 //!
+    std::vector<Int_t>    fIsCascadeCowboy;          //!
+    std::vector<Double_t> fMinCrossedRowsOverLength; //!
+    std::vector<Double_t> fLeastNbrCrossedRows;      //!
+    std::vector<UChar_t>  fITSorTOF;                 //!
+
+    //Variable cuts, only for the configurations that use them
+    std::vector<VarCut>   fVarCascCosPA;             //!
+    std::vector<VarCut>   fVarV0CosPA;               //!
+    std::vector<VarCut>   fVarBBCosPA;               //!
+    std::vector<VarCut>   fVarDCACascDau;            //!
+
+    //Work space
+    std::vector<Float_t>  fCascCosPACut;             //! effective cuts
+    std::vector<Float_t>  fV0CosPACut;               //!
+    std::vector<Float_t>  fBBCosPACut;               //!
+    std::vector<Float_t>  fDCACascDauCut;            //!
+    std::vector<UChar_t>  fPass;                     //! pass flags
+
+    ClassDef(AliCascadeCutTable, 1)
+};
+#endif
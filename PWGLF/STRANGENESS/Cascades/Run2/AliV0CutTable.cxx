@@ -0,0 +1,211 @@
+//+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+// Table of V0 selections, one column per cut and one row per
+// AliV0Result configuration (see header)
+//+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+
+#include "TList.h"
+#include "TH3F.h"
+#include "TMath.h"
+#include "AliV0Result.h"
+#include "AliV0CutTable.h"
+
+ClassImp(AliV0CutTable);
+//________________________________________________________________
+AliV0CutTable::AliV0CutTable() :
+TObject()
+{
+    // Dummy Constructor - not to be used!
+}
+//________________________________________________________________
+void AliV0CutTable::Clear(Option_t*)
+{
+    //Remove all configurations
+    fResult.clear();
+    fHisto.clear();
+    fMassHypo.clear();
+    fPDGMass.clear();
+    fUseOnTheFly.clear();
+    fMinEtaTracks.clear();
+    fMaxEtaTracks.clear();
+    fMinRapidity.clear();
+    fMaxRapidity.clear();
+    fV0Radius.clear();
+    fMaxV0Radius.clear();
+    fDCANegToPV.clear();
+    fDCAPosToPV.clear();
+    fDCAV0Daughters.clear();
+    fV0CosPA.clear();
+    fProperLifetime.clear();
+    fLeastNbrCrossedRows.clear();
+    fLeastRatioCrossedRows.clear();
+    fMinBaryonMomentum.clear();
+    fTPCdEdx.clear();
+    fArmenteros.clear();
+    fArmenterosParameter.clear();
+    fUseITSRefitTracks.clear();
+    fMaxChi2PerCluster.clear();
+    fMinTrackLength.clear();
+    fUseParametricLength.clear();
+    f276TeVLikedEdx.clear();
+    fAtLeastOneTOF.clear();
+    fIsCowboy.clear();
+    fMinCrossedRowsOverLength.clear();
+    fITSorTOF.clear();
+    fVarV0CosPAIndex.clear();
+    fVarV0CosPAPar.clear();
+    fV0CosPACut.clear();
+    fPass.clear();
+}
+//________________________________________________________________
+Int_t AliV0CutTable::Compile(TList *lList)
+{
+    //Append all AliV0Result configurations of lList to the table
+    //Histograms must have been initialized beforehand
+    if( !lList ) return 0;
+    Int_t lNbrConfigs = lList->GetEntries();
+    for(Int_t icfg=0; icfg<lNbrConfigs; icfg++){
+        AliV0Result *lV0Result = (AliV0Result*) lList->At(icfg);
+        Int_t lHypo = lV0Result->GetMassHypothesis();
+
+        fResult.push_back( lV0Result );
+        fHisto.push_back( lV0Result->GetHistogram() );
+        fMassHypo.push_back( lHypo );
+        fPDGMass.push_back( lHypo == AliV0Result::kK0Short ? 0.497 : 1.115683 );
+        fUseOnTheFly.push_back( lV0Result->GetUseOnTheFly() );
+        fMinEtaTracks.push_back( lV0Result->GetCutMinEtaTracks() );
+        fMaxEtaTracks.push_back( lV0Result->GetCutMaxEtaTracks() );
+        fMinRapidity.push_back( lV0Result->GetCutMinRapidity() );
+        fMaxRapidity.push_back( lV0Result->GetCutMaxRapidity() );
+        fV0Radius.push_back( lV0Result->GetCutV0Radius() );
+        fMaxV0Radius.push_back( lV0Result->GetCutMaxV0Radius() );
+        fDCANegToPV.push_back( lV0Result->GetCutDCANegToPV() );
+        fDCAPosToPV.push_back( lV0Result->GetCutDCAPosToPV() );
+        fDCAV0Daughters.push_back( lV0Result->GetCutDCAV0Daughters() );
+        fV0CosPA.push_back( lV0Result->GetCutV0CosPA() );
+        fProperLifetime.push_back( lV0Result->GetCutProperLifetime() );
+        fLeastNbrCrossedRows.push_back( lV0Result->GetCutLeastNumberOfCrossedRows() );
+        fLeastRatioCrossedRows.push_back( lV0Result->GetCutLeastNumberOfCrossedRowsOverFindable() );
+        fMinBaryonMomentum.push_back( lV0Result->GetCutMinBaryonMomentum() );
+        fTPCdEdx.push_back( lV0Result->GetCutTPCdEdx() );
+        fArmenteros.push_back( lV0Result->GetCutArmenteros() && lHypo == AliV0Result::kK0Short );
+        fArmenterosParameter.push_back( lV0Result->GetCutArmenterosParameter() );
+        fUseITSRefitTracks.push_back( lV0Result->GetCutUseITSRefitTracks() );
+        fMaxChi2PerCluster.push_back( lV0Result->GetCutMaxChi2PerCluster() );
+        fMinTrackLength.push_back( lV0Result->GetCutMinTrackLength() );
+        fUseParametricLength.push_back( lV0Result->GetCutUseParametricLength() );
+        f276TeVLikedEdx.push_back( lV0Result->GetCut276TeVLikedEdx() );
+        fAtLeastOneTOF.push_back( lV0Result->GetCutAtLeastOneTOF() );
+        fIsCowboy.push_back( lV0Result->GetCutIsCowboy() );
+        fMinCrossedRowsOverLength.push_back( lV0Result->GetCutMinCrossedRowsOverLength() );
+        fITSorTOF.push_back( lV0Result->GetCutITSorTOF() );
+
+        //Variable V0 CosPA: parameters kept in single precision as in the task
+        if( lV0Result->GetCutUseVarV0CosPA() ){
+            fVarV0CosPAIndex.push_back( fResult.size()-1 );
+            fVarV0CosPAPar.push_back( lV0Result->GetCutVarV0CosPAExp0Const() );
+            fVarV0CosPAPar.push_back( lV0Result->GetCutVarV0CosPAExp0Slope() );
+            fVarV0CosPAPar.push_back( lV0Result->GetCutVarV0CosPAExp1Const() );
+            fVarV0CosPAPar.push_back( lV0Result->GetCutVarV0CosPAExp1Slope() );
+            fVarV0CosPAPar.push_back( lV0Result->GetCutVarV0CosPAConst() );
+        }
+    }
+    fV0CosPACut.resize( fResult.size() );
+    fPass.resize( fResult.size() );
+    return lNbrConfigs;
+}
+//________________________________________________________________
+Int_t AliV0CutTable::Evaluate(const AliV0CutTable::Candidate &lCand)
+{
+    //Test lCand against all configurations, fill the pass flags
+    //and return the number of configurations passed
+    const Int_t lNbrConfigs = GetNConfigurations();
+    if( lNbrConfigs == 0 ) return 0;
+
+    //Effective V0 CosPA cut: variable cut only used if tighter
+    for(Int_t icfg=0; icfg<lNbrConfigs; icfg++) fV0CosPACut[icfg] = fV0CosPA[icfg];
+    for(size_t ivar=0; ivar<fVarV0CosPAIndex.size(); ivar++){
+        const Float_t *lPar = &fVarV0CosPAPar[5*ivar];
+        Float_t lVarV0CosPA = TMath::Cos(
+                                         lPar[0]*TMath::Exp(lPar[1]*lCand.fPt) +
+                                         lPar[2]*TMath::Exp(lPar[3]*lCand.fPt) +
+                                         lPar[4]);
+        Int_t icfg = fVarV0CosPAIndex[ivar];
+        if( lVarV0CosPA > fV0CosPACut[icfg] ) fV0CosPACut[icfg] = lVarV0CosPA;
+    }
+
+    //Special 2.76TeV-like dE/dx, per mass hypothesis
+    UChar_t l276TeVdEdx[3];
+    for(Int_t ih=0; ih<3; ih++)
+        l276TeVdEdx[ih] = ( ih == AliV0Result::kK0Short ||
+                           ( lCand.fBaryonPt[ih] > 1.0 || TMath::Abs(lCand.fBaryondEdxFromProton[ih])<3.0 ) );
+
+    const Float_t lAbsAlpha = TMath::Abs(lCand.fAlpha);
+    Int_t lNPassed = 0;
+    for(Int_t icfg=0; icfg<lNbrConfigs; icfg++){
+        const Int_t ih = fMassHypo[icfg];
+        const Float_t lRap = lCand.fRap[ih];
+        const Double_t lMinLength = fMinTrackLength[icfg];
+        const Int_t lCowboy = fIsCowboy[icfg];
+
+        UChar_t lPass =
+        //Offline Vertexer
+        ( lCand.fOnFlyStatus == fUseOnTheFly[icfg] ) &
+
+        //Basic Acceptance cuts
+        ( fMinEtaTracks[icfg] < lCand.fNegEta ) & ( lCand.fNegEta < fMaxEtaTracks[icfg] ) &
+        ( fMinEtaTracks[icfg] < lCand.fPosEta ) & ( lCand.fPosEta < fMaxEtaTracks[icfg] ) &
+        ( lRap > fMinRapidity[icfg] ) &
+        ( lRap < fMaxRapidity[icfg] ) &
+
+        //Topological Variables
+        ( lCand.fV0Radius > fV0Radius[icfg] ) &
+        ( lCand.fV0Radius < fMaxV0Radius[icfg] ) &
+        ( lCand.fDcaNegToPV > fDCANegToPV[icfg] ) &
+        ( lCand.fDcaPosToPV > fDCAPosToPV[icfg] ) &
+        ( lCand.fDcaV0Daughters < fDCAV0Daughters[icfg] ) &
+        ( lCand.fV0CosPA > fV0CosPACut[icfg] ) &
+        ( lCand.fDistOverTotMom*fPDGMass[icfg] < fProperLifetime[icfg] ) &
+        ( lCand.fLeastNbrCrossedRows > fLeastNbrCrossedRows[icfg] ) &
+        ( lCand.fLeastRatioCrossedRowsOverFindable > fLeastRatioCrossedRows[icfg] ) &
+
+        //Minimum momentum of baryon daughter
+        ( ih == AliV0Result::kK0Short || lCand.fBaryonMomentum[ih] > fMinBaryonMomentum[icfg] ) &
+
+        //TPC dEdx selections
+        ( TMath::Abs(lCand.fNegdEdx[ih]) < fTPCdEdx[icfg] ) &
+        ( TMath::Abs(lCand.fPosdEdx[ih]) < fTPCdEdx[icfg] ) &
+
+        //Armenteros-Podolanski space cut (for K0Short analysis)
+        ( !fArmenteros[icfg] || lCand.fPtArm > fArmenterosParameter[icfg]*lAbsAlpha ) &
+
+        //kITSrefit track selection if requested
+        ( lCand.fITSRefit || !fUseITSRefitTracks[icfg] ) &
+
+        //Max Chi2/Clusters if not absurd
+        ( fMaxChi2PerCluster[icfg] > 1e+3 || lCand.fMaxChi2PerCluster < fMaxChi2PerCluster[icfg] ) &
+
+        //Min Track Length if positive
+        ( lMinLength < 0 ||
+         ( lCand.fMinTrackLength > lMinLength && !fUseParametricLength[icfg] ) ||
+         ( lCand.fMinTrackLength > lMinLength - lCand.fLengthTermPt - lCand.fLengthTermRadius && fUseParametricLength[icfg] ) ) &
+
+        //Special 2.76TeV-like dedx
+        ( !f276TeVLikedEdx[icfg] || l276TeVdEdx[ih] ) &
+
+        //At least one track with some TOF info
+        ( !fAtLeastOneTOF[icfg] || lCand.fAtLeastOneTOF ) &
+
+        //cowboy/sailor for V0
+        ( lCowboy == 0 || ( lCowboy == 1 && lCand.fIsCowboy ) || ( lCowboy == -1 && !lCand.fIsCowboy ) ) &
+
+        //modern track quality selections
+        ( fMinCrossedRowsOverLength[icfg] < 0 || lCand.fLeastNcrOverLength > fMinCrossedRowsOverLength[icfg] ) &
+
+        //ITS or TOF required
+        ( !fITSorTOF[icfg] || lCand.fITSorTOF );
+
+        fPass[icfg] = lPass;
+        lNPassed += lPass;
+    }
+    return lNPassed;
+}
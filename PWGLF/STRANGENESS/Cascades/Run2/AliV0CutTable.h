@@ -0,0 +1,122 @@
+#ifndef AliV0CutTable_H
+#define AliV0CutTable_H
+#include <TObject.h>
+#include <vector>
+
+class TList;
+class TH3F;
+class AliV0Result;
+
+//+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+// Table of V0 selections, one column per cut and one row per
+// AliV0Result configuration. Built once from the output lists with
+// Compile(), then each candidate is tested against all configurations
+// in one pass with Evaluate(), which fills one pass flag per row.
+//
+// Selections are the ones of the superlight adaptive output mode of
+// AliAnalysisTaskStrangenessVsMultiplicityRun2, with identical
+// numerical types so that the outcome is bit-for-bit the same.
+//+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+
+class AliV0CutTable : public TObject {
+
+public:
+    //Candidate properties used in the selection
+    //Arrays are indexed by AliV0Result::EMassHypo
+    struct Candidate {
+        Int_t    fOnFlyStatus;
+        Float_t  fPt;
+        Float_t  fNegEta;
+        Float_t  fPosEta;
+        Float_t  fV0Radius;
+        Float_t  fDcaNegToPV;
+        Float_t  fDcaPosToPV;
+        Float_t  fDcaV0Daughters;
+        Float_t  fV0CosPA;
+        Float_t  fDistOverTotMom;
+        Int_t    fLeastNbrCrossedRows;
+        Float_t  fLeastRatioCrossedRowsOverFindable;
+        Float_t  fPtArm;
+        Float_t  fAlpha;
+        Bool_t   fITSRefit;          //both daughters have kITSrefit
+        Float_t  fMaxChi2PerCluster;
+        Float_t  fMinTrackLength;
+        Double_t fLengthTermPt;      //(1/pt)^1.5 term of the parametric length cut
+        Double_t fLengthTermRadius;  //radius term of the parametric length cut
+        Bool_t   fAtLeastOneTOF;
+        Bool_t   fIsCowboy;
+        Float_t  fLeastNcrOverLength;
+        Bool_t   fITSorTOF;
+
+        Float_t  fMass[3];
+        Float_t  fRap[3];
+        Float_t  fNegdEdx[3];
+        Float_t  fPosdEdx[3];
+        Float_t  fBaryonMomentum[3];
+        Float_t  fBaryonPt[3];
+        Float_t  fBaryondEdxFromProton[3];
+    };
+
+    AliV0CutTable();
+    virtual ~AliV0CutTable() {}
+
+    void  Clear(Option_t* = "");
+    Int_t Compile(TList *lList);
+    Int_t Evaluate(const AliV0CutTable::Candidate &lCand);
+
+    Int_t        GetNConfigurations  ()        const { return (Int_t)fResult.size(); }
+    AliV0Result* GetResult           (Int_t i) const { return fResult[i];    }
+    TH3F*        GetHistogram        (Int_t i) const { return fHisto[i];     }
+    Int_t        GetMassHypothesis   (Int_t i) const { return fMassHypo[i];  }
+    Bool_t       IsPassed            (Int_t i) const { return fPass[i];      }
+    const UChar_t* GetPassMask       ()        const { return fPass.empty() ? 0x0 : &fPass[0]; }
+
+private:
+    AliV0CutTable(const AliV0CutTable&);            // not implemented
+    AliV0CutTable& operator=(const AliV0CutTable&); // not implemented
+
+    std::vector<AliV0Result*> fResult; //! configuration
+    std::vector<TH3F*>        fHisto;  //! its output histogram
+
+    //Per-configuration cuts (type as returned by the AliV0Result getters)
+    std::vector<Int_t>    fMassHypo;                    //!
+    std::vector<Float_t>  fPDGMass;                     //!
+    std::vector<UChar_t>  fUseOnTheFly;                 //!
+    std::vector<Double_t> fMinEtaTracks;                //!
+    std::vector<Double_t> fMaxEtaTracks;                //!
+    std::vector<Double_t> fMinRapidity;                 //!
+    std::vector<Double_t> fMaxRapidity;                 //!
+    std::vector<Double_t> fV0Radius;                    //!
+    std::vector<Double_t> fMaxV0Radius;                 //!
+    std::vector<Double_t> fDCANegToPV;                  //!
+    std::vector<Double_t> fDCAPosToPV;                  //!
+    std::vector<Double_t> fDCAV0Daughters;              //!
+    std::vector<Float_t>  fV0CosPA;                     //! fixed cut
+    std::vector<Double_t> fProperLifetime;              //!
+    std::vector<Double_t> fLeastNbrCrossedRows;         //!
+    std::vector<Double_t> fLeastRatioCrossedRows;       //!
+    std::vector<Double_t> fMinBaryonMomentum;           //!
+    std::vector<Double_t> fTPCdEdx;                     //!
+    std::vector<UChar_t>  fArmenteros;                  //! Armenteros cut active (K0Short only)
+    std::vector<Double_t> fArmenterosParameter;         //!
+    std::vector<UChar_t>  fUseITSRefitTracks;           //!
+    std::vector<Double_t> fMaxChi2PerCluster;           //!
+    std::vector<Double_t> fMinTrackLength;              //!
+    std::vector<UChar_t>  fUseParametricLength;         //!
+    std::vector<UChar_t>  f276TeVLikedEdx;              //!
+    std::vector<UChar_t>  fAtLeastOneTOF;               //!
+    std::vector<Int_t>    fIsCowboy;                    //!
+    std::vector<Double_t> fMinCrossedRowsOverLength;    //!
+    std::vector<UChar_t>  fITSorTOF;                    //!
+
+    //Variable V0 CosPA, only for the configurations that use it
+    std::vector<Int_t>    fVarV0CosPAIndex;             //!
+    std::vector<Float_t>  fVarV0CosPAPar;               //! 5 parameters per entry
+
+    //Work space
+    std::vector<Float_t>  fV0CosPACut;                  //! effective CosPA cut
+    std::vector<UChar_t>  fPass;                        //! pass flags
+
+    ClassDef(AliV0CutTable, 1)
+};
+#endif
@@ -90,10 +90,17 @@
 #include "AliESDtools.h"
 #include "TVectorF.h"
 #include "AliTPCROC.h"
+#include "AliFilteredTreeFlatWriter.h"
+#include "TParticle.h"
 using namespace std;
 
 ClassImp(AliAnalysisTaskFilteredTree)
 
+namespace {
+  /// names of the streams, in the order of AliAnalysisTaskFilteredTree::EFlatStream
+  const char *kFlatStreamNames[AliAnalysisTaskFilteredTree::kNFlatStreams] = {"V0s","highPt","dEdx","Laser","MCEffTree","CosmicPairs"};
+}
+
   //_____________________________________________________________________________
   AliAnalysisTaskFilteredTree::AliAnalysisTaskFilteredTree(const char *name) 
   : AliAnalysisTaskSE(name)
@@ -114,6 +121,7 @@ ClassImp(AliAnalysisTaskFilteredTree)
   , fTrigger(AliTriggerAnalysis::kMB1) 
   , fAnalysisMode(kTPCAnalysisMode) 
   , fTreeSRedirector(0)
+  , fFlatSchema()
   , fCentralityEstimator(0)
   , fLowPtTrackDownscaligF(0)
   , fLowPtV0DownscaligF(0)
@@ -146,6 +154,7 @@ ClassImp(AliAnalysisTaskFilteredTree)
   , fDummyTrack(0)
 {
   // Constructor
+  for (Int_t i=0; i<kNFlatStreams; i++) fFlatWriter[i]=NULL;
 
   // Define input and output slots here
   DefineOutput(1, TTree::Class());
@@ -170,6 +179,7 @@ AliAnalysisTaskFilteredTree::~AliAnalysisTaskFilteredTree()
   delete fFilteredTreeAcceptanceCuts;
   delete fFilteredTreeRecAcceptanceCuts;
   delete fEsdTrackCuts;
+  for (Int_t i=0; i<kNFlatStreams; i++) delete fFlatWriter[i];
 }
 
 //____________________________________________________________________________
@@ -209,16 +219,24 @@ void AliAnalysisTaskFilteredTree::UserCreateOutputObjects()
   //
   //get the output file to make sure the trees will be associated to it
   OpenFile(1);
+  // flat writers replace the object streaming for the streams with a schema
+  for (Int_t i=0; i<kNFlatStreams; i++) {
+    if (!fFlatSchema[i].IsNull()) fFlatWriter[i] = new AliFilteredTreeFlatWriter(kFlatStreamNames[i], fFlatSchema[i]);
+  }
   fTreeSRedirector = new TTreeSRedirector();
 
   //
   // Create trees
-  fV0Tree = ((*fTreeSRedirector)<<"V0s").GetTree();
-  fHighPtTree = ((*fTreeSRedirector)<<"highPt").GetTree();
-  fdEdxTree = ((*fTreeSRedirector)<<"dEdx").GetTree();
-  fLaserTree = ((*fTreeSRedirector)<<"Laser").GetTree();
-  fMCEffTree = ((*fTreeSRedirector)<<"MCEffTree").GetTree();
-  fCosmicPairsTree = ((*fTreeSRedirector)<<"CosmicPairs").GetTree();
+  TTree *trees[kNFlatStreams];
+  for (Int_t i=0; i<kNFlatStreams; i++) {
+    trees[i] = (fFlatWriter[i]) ? fFlatWriter[i]->GetTree() : ((*fTreeSRedirector)<<kFlatStreamNames[i]).GetTree();
+  }
+  fV0Tree = trees[kFlatV0s];
+  fHighPtTree = trees[kFlatHighPt];
+  fdEdxTree = trees[kFlatdEdx];
+  fLaserTree = trees[kFlatLaser];
+  fMCEffTree = trees[kFlatMCEff];
+  fCosmicPairsTree = trees[kFlatCosmicPairs];
 
   if (!fDummyTrack)  {
     fDummyTrack=new AliESDtrack();
@@ -525,7 +543,7 @@ void AliAnalysisTaskFilteredTree::ProcessCosmics(AliESDEvent *const event, AliES
 	  friendTrackStore1 = 0;
 	}
       }
-      if (fFriendDownscaling<=0){
+      if (fFriendDownscaling<=0 && !fFlatWriter[kFlatCosmicPairs]){
 	if (((*fTreeSRedirector)<<"CosmicPairs").GetTree()){
 	  TTree * tree = ((*fTreeSRedirector)<<"CosmicPairs").GetTree();
 	  if (tree){
@@ -542,6 +560,24 @@ void AliAnalysisTaskFilteredTree::ProcessCosmics(AliESDEvent *const event, AliES
 	}
       }
       if(!fFillTree) return;
+      if (AliFilteredTreeFlatWriter *writer=fFlatWriter[kFlatCosmicPairs]){
+        // flat columns, friend tracks are not supported
+        writer->SetValue("gid",gid);
+        writer->SetValue("runNumber",runNumber);
+        writer->SetValue("evtTimeStamp",evtTimeStamp);
+        writer->SetValue("timeStamp",timeStamp);
+        writer->SetValue("evtNumberInFile",eventNumber);
+        writer->SetValue("trigger",triggerMask);
+        writer->SetValue("Bz",magField);
+        writer->SetValue("multSPD",ntracksSPD);
+        writer->SetValue("multTPC",ntracksTPC);
+        writer->SetObject("vertSPD",vertexSPD,AliESDVertex::Class());
+        writer->SetObject("vertTPC",vertexTPC,AliESDVertex::Class());
+        writer->SetObject("t0",track0,AliESDtrack::Class());
+        writer->SetObject("t1",track1,AliESDtrack::Class());
+        writer->Fill();
+        continue;
+      }
       if(!fTreeSRedirector) return;
       (*fTreeSRedirector)<<"CosmicPairs"<<
         "gid="<<gid<<                         // global id of track
@@ -754,6 +790,26 @@ void AliAnalysisTaskFilteredTree::Process(AliESDEvent *const esdEvent, AliMCEven
       if(!fFillTree) return;
       if(!fTreeSRedirector) return;
       downscaleCounter++;
+      if (AliFilteredTreeFlatWriter *writer=fFlatWriter[kFlatHighPt]){
+        writer->SetValue("gid",gid);
+        writer->SetValue("selectionPtMask",selectionPtMask);
+        writer->SetValue("runNumber",runNumber);
+        writer->SetValue("evtTimeStamp",evtTimeStamp);
+        writer->SetValue("timeStamp",timeStamp);
+        writer->SetValue("evtNumberInFile",evtNumberInFile);
+        writer->SetValue("Bz",bz);
+        writer->SetObject("vtxESD",vtxESD,AliESDVertex::Class());
+        writer->SetValue("ntracksESD",ntracks);
+        writer->SetValue("IRtot",ir1);
+        writer->SetValue("IRint2",ir2);
+        writer->SetValue("mult",mult);
+        writer->SetValue("multSPD",multSPD);
+        writer->SetValue("multTPC",multTPC);
+        writer->SetObject("esdTrack",track,AliESDtrack::Class());
+        writer->SetValue("centralityF",centralityF);
+        writer->Fill();
+        continue;
+      }
       (*fTreeSRedirector)<<"highPt"<<
         "gid="<<gid<<
         "selectionPtMask="<<selectionPtMask<<
@@ -812,6 +868,18 @@ void AliAnalysisTaskFilteredTree::ProcessLaser(AliESDEvent *const esdEvent, AliM
       if (track->GetInnerParam()->Pt()<kMinPt) continue;
       Bool_t skipTrack=gRandom->Rndm()>1/(1+TMath::Abs(fFriendDownscaling));
       if (skipTrack) continue;
+      if (AliFilteredTreeFlatWriter *writer=fFlatWriter[kFlatLaser]){
+        // flat columns, friend track is not supported
+        writer->SetValue("gid",gid);
+        writer->SetValue("runNumber",runNumber);
+        writer->SetValue("evtTimeStamp",evtTimeStamp);
+        writer->SetValue("evtNumberInFile",evtNumberInFile);
+        writer->SetValue("Bz",bz);
+        writer->SetValue("multTPCtracks",countLaserTracks);
+        writer->SetObject("track",track,AliESDtrack::Class());
+        writer->Fill();
+        continue;
+      }
       if (esdFriend) {if (!esdFriend->TestSkipBit()) friendTrack = (AliESDfriendTrack*)track->GetFriendTrack();} //this guy can be NULL      
       (*fTreeSRedirector)<<"Laser"<<
         "gid="<<gid<<                          // global identifier of event
@@ -1455,7 +1523,7 @@ void AliAnalysisTaskFilteredTree::ProcessAll(AliESDEvent *const esdEvent, AliMCE
 	if (fFriendDownscaling>=1){  // downscaling number of friend tracks
 	  friendTrackStore = (gRandom->Rndm()<1./fFriendDownscaling)? friendTrack:0;
 	}
-	if (fFriendDownscaling<=0){
+	if (fFriendDownscaling<=0 && !fFlatWriter[kFlatHighPt]){
 	  if (((*fTreeSRedirector)<<"highPt").GetTree()){
 	    TTree * tree = ((*fTreeSRedirector)<<"highPt").GetTree();
 	    if (tree){
@@ -1516,7 +1584,78 @@ void AliAnalysisTaskFilteredTree::ProcessAll(AliESDEvent *const esdEvent, AliMCE
 	  pidResponse->ComputePIDProbability(AliPIDResponse::kTPC, track, nSpecies, tpcPID.GetMatrixArray());
 	  pidResponse->ComputePIDProbability(AliPIDResponse::kTOF, track, nSpecies, tofPID.GetMatrixArray());	    
 	}
-        if(fTreeSRedirector && dumpToTree && fFillTree) {
+        AliFilteredTreeFlatWriter *flatWriter=fFlatWriter[kFlatHighPt];
+        if (flatWriter && dumpToTree && fFillTree) {
+          // flat columns - same names as in the object streaming, friend track is not supported
+	  downscaleCounter++;
+          flatWriter->SetValue("downscaleCounter",downscaleCounter);
+          flatWriter->SetValue("weight",weight);
+          flatWriter->SetValue("selectionPtMask",selectionPtMask);
+          flatWriter->SetValue("selectionPtMaskMC",selectionPtMaskMC);
+          flatWriter->SetValue("selectionPIDMask",selectionPIDMask);
+          flatWriter->SetValue("gid",gid);
+          flatWriter->SetValue("runNumber",runNumber);
+          flatWriter->SetValue("evtTimeStamp",evtTimeStamp);
+          flatWriter->SetValue("timeStamp",timeStamp);
+          flatWriter->SetValue("evtNumberInFile",evtNumberInFile);
+          flatWriter->SetValue("Bz",bz);
+          flatWriter->SetObject("vtxESD",vtxESD,AliESDVertex::Class());
+          flatWriter->SetValue("IRtot",ir1);
+          flatWriter->SetValue("IRint2",ir2);
+          flatWriter->SetValue("mult",mult);
+          flatWriter->SetValue("ntracks",ntracks);
+          flatWriter->SetValue("contTPC",contTPC);
+          flatWriter->SetValue("contSPD",contSPD);
+          flatWriter->SetArray("vertexPosTPC",vertexPosTPC.GetMatrixArray(),vertexPosTPC.GetNrows());
+          flatWriter->SetArray("vertexPosSPD",vertexPosSPD.GetMatrixArray(),vertexPosSPD.GetNrows());
+          flatWriter->SetValue("ntracksTPC",ntracksTPC);
+          flatWriter->SetValue("ntracksITS",ntracksITS);
+          flatWriter->SetObject("esdTrack",track,AliESDtrack::Class());
+          flatWriter->SetArray("tofClInfo",tofClInfo.GetMatrixArray(),tofClInfo.GetNrows());
+          flatWriter->SetArray("tofNsigma",tofNsigma.GetMatrixArray(),tofNsigma.GetNrows());
+          flatWriter->SetArray("tpcNsigma",tpcNsigma.GetMatrixArray(),tpcNsigma.GetNrows());
+          flatWriter->SetArray("itsNsigma",itsNsigma.GetMatrixArray(),itsNsigma.GetNrows());
+          flatWriter->SetArray("tofTime",tofTime.GetMatrixArray(),tofTime.GetNrows());
+          flatWriter->SetArray("tofPID",tofPID.GetMatrixArray(),tofPID.GetNrows());
+          flatWriter->SetArray("tpcPID",tpcPID.GetMatrixArray(),tpcPID.GetNrows());
+          flatWriter->SetObject("extTPCInnerC",tpcInnerC,AliExternalTrackParam::Class());
+          flatWriter->SetObject("extInnerParamV",trackInnerV,AliExternalTrackParam::Class());
+          flatWriter->SetObject("extInnerParamC",trackInnerC,AliExternalTrackParam::Class());
+          flatWriter->SetObject("extInnerParam",trackInnerC2,AliExternalTrackParam::Class());
+          flatWriter->SetObject("extOuterITS",outerITSc,AliExternalTrackParam::Class());
+          flatWriter->SetObject("extInnerParamRef",trackInnerC3,AliExternalTrackParam::Class());
+          flatWriter->SetValue("chi2TPCInnerC",chi2(0,0));
+          flatWriter->SetValue("chi2InnerC",chi2trackC(0,0));
+          flatWriter->SetValue("chi2OuterITS",chi2OuterITS(0,0));
+          flatWriter->SetValue("centralityF",centralityF);
+          flatWriter->SetObject("paramITS",&paramITS,AliExternalTrackParam::Class());
+          flatWriter->SetObject("paramITSC",&paramITSC,AliExternalTrackParam::Class());
+          flatWriter->SetObject("paramComb",&paramComb,AliExternalTrackParam::Class());
+          flatWriter->SetValue("indexNearestITS",indexNearestITS);
+          flatWriter->SetValue("indexNearestITSC",indexNearestITSC);
+          flatWriter->SetValue("indexNearestComb",indexNearestComb);
+          if (mcEvent){
+            flatWriter->SetValue("weightMC",weightMC);
+            flatWriter->SetValue("multMCTrueTracks",multMCTrueTracks);
+            flatWriter->SetValue("mcStackSize",mcStackSize);
+            flatWriter->SetValue("nrefITS",nrefITS);
+            flatWriter->SetValue("nrefTPC",nrefTPC);
+            flatWriter->SetValue("nrefTRD",nrefTRD);
+            flatWriter->SetValue("nrefTOF",nrefTOF);
+            flatWriter->SetObject("refTPCIn",refTPCIn,AliTrackReference::Class());
+            flatWriter->SetObject("refTPCOut",refTPCOut,AliTrackReference::Class());
+            flatWriter->SetObject("particle",particle,TParticle::Class());
+            flatWriter->SetObject("particleMother",particleMother,TParticle::Class());
+            flatWriter->SetValue("mech",mech);
+            flatWriter->SetValue("isPrim",isPrim);
+            flatWriter->SetValue("isFromStrangess",isFromStrangess);
+            flatWriter->SetValue("isFromConversion",isFromConversion);
+            flatWriter->SetValue("isFromMaterial",isFromMaterial);
+            flatWriter->SetValue("isPileUpMC",isPileUpMC);
+          }
+          flatWriter->Fill();
+        }
+        if(fTreeSRedirector && dumpToTree && fFillTree && !flatWriter) {
 	  downscaleCounter++;
           (*fTreeSRedirector)<<"highPt"<<
 	    "downscaleCounter="<<downscaleCounter<<
@@ -1887,7 +2026,40 @@ void AliAnalysisTaskFilteredTree::ProcessMCEff(AliESDEvent *const esdEvent, AliM
       Int_t gid = fileName.Hash();
 
       //
-      if(fTreeSRedirector && fFillTree) {
+      if (AliFilteredTreeFlatWriter *writer=fFlatWriter[kFlatMCEff]){
+        if (!fFillTree) continue;
+	downscaleCounter++;
+        writer->SetValue("gid",gid);
+        writer->SetValue("weight",weight);
+        writer->SetValue("isPhysicalPrim",isPrim);
+        writer->SetValue("selectionPtMaskMC",selectionPtMaskMC);
+        writer->SetValue("runNumber",runNumber);
+        writer->SetValue("evtTimeStamp",evtTimeStamp);
+        writer->SetValue("timeStamp",timeStamp);
+        writer->SetValue("evtNumberInFile",evtNumberInFile);
+        writer->SetValue("Bz",bz);
+        writer->SetObject("vtxESD",vtxESD,AliESDVertex::Class());
+        writer->SetValue("isPileUpMC",isPileUpMC);
+        writer->SetValue("mult",mult);
+        writer->SetValue("multMCTrueTracks",multMCTrueTracks);
+        writer->SetValue("contTPC",contTPC);
+        writer->SetValue("contSPD",contSPD);
+        writer->SetArray("vertexPosTPC",vertexPosTPC.GetMatrixArray(),vertexPosTPC.GetNrows());
+        writer->SetArray("vertexPosSPD",vertexPosSPD.GetMatrixArray(),vertexPosSPD.GetNrows());
+        writer->SetValue("ntracksTPC",ntracksTPC);
+        writer->SetValue("ntracksITS",ntracksITS);
+        writer->SetValue("isAcc0",isESDtrackCut);
+        writer->SetValue("isAcc1",isAccCuts);
+        writer->SetObject("esdTrack",recTrack,AliESDtrack::Class());
+        writer->SetValue("isRec",isRec);
+        writer->SetValue("tpcTrackLength",tpcTrackLength);
+        writer->SetObject("particle",particle,TParticle::Class());
+        writer->SetObject("particleMother",particleMother,TParticle::Class());
+        writer->SetValue("mech",mech);
+        writer->SetValue("nRec",nRec);
+        writer->SetValue("nFakes",nFakes);
+        writer->Fill();
+      } else if(fTreeSRedirector && fFillTree) {
 	downscaleCounter++;
         (*fTreeSRedirector)<<"MCEffTree"<<
           "fileName.="<<&fCurrentFileName<<
@@ -2103,7 +2275,7 @@ void AliAnalysisTaskFilteredTree::ProcessV0(AliESDEvent *const esdEvent, AliMCEv
           friendTrackStore1 = 0;
         }
       }
-      if (fFriendDownscaling<=0){
+      if (fFriendDownscaling<=0 && !fFlatWriter[kFlatV0s]){
         if (((*fTreeSRedirector)<<"V0s").GetTree()){
           TTree * tree = ((*fTreeSRedirector)<<"V0s").GetTree();
           if (tree){
@@ -2177,6 +2349,33 @@ void AliAnalysisTaskFilteredTree::ProcessV0(AliESDEvent *const esdEvent, AliMCEv
         if (fESDtool->IsPileup(track0->GetLabel())) isPileUpMC+=1;
         if (fESDtool->IsPileup(track1->GetLabel())) isPileUpMC+=2;
       }
+      if (AliFilteredTreeFlatWriter *writer=fFlatWriter[kFlatV0s]){
+        // flat columns, friend tracks are not supported
+        writer->SetValue("gid",gid);
+        writer->SetValue("weight",weight);
+        writer->SetValue("selectionPtMask",selectionPtMask);
+        writer->SetValue("downscaleCounter",downscaleCounter);
+        writer->SetValue("Bz",bz);
+        writer->SetValue("runNumber",run);
+        writer->SetValue("evtTimeStamp",time);
+        writer->SetValue("evtNumberInFile",evNr);
+        writer->SetValue("type",type);
+        writer->SetValue("ntracks",ntracks);
+        writer->SetObject("v0",v0,AliESDv0::Class());
+        writer->SetObject("kf",&kfparticle,AliKFParticle::Class());
+        writer->SetObject("track0",track0,AliESDtrack::Class());
+        writer->SetObject("track1",track1,AliESDtrack::Class());
+        writer->SetArray("tofClInfo0",tofClInfo0.GetMatrixArray(),tofClInfo0.GetNrows());
+        writer->SetArray("tofClInfo1",tofClInfo1.GetMatrixArray(),tofClInfo1.GetNrows());
+        writer->SetArray("tofNsigma0",tofNsigma0.GetMatrixArray(),tofNsigma0.GetNrows());
+        writer->SetArray("tofNsigma1",tofNsigma1.GetMatrixArray(),tofNsigma1.GetNrows());
+        writer->SetArray("tpcNsigma0",tpcNsigma0.GetMatrixArray(),tpcNsigma0.GetNrows());
+        writer->SetArray("tpcNsigma1",tpcNsigma1.GetMatrixArray(),tpcNsigma1.GetNrows());
+        writer->SetValue("centralityF",centralityF);
+        writer->SetValue("isPileUpMC",isPileUpMC);
+        writer->Fill();
+        continue;
+      }
       (*fTreeSRedirector)<<"V0s"<<
                          "gid="<<gid<<                         //  global id of event
                          "fLowPtV0DownscaligF="<<fLowPtV0DownscaligF<<
@@ -2336,6 +2535,22 @@ void AliAnalysisTaskFilteredTree::ProcessdEdx(AliESDEvent *const esdEvent, AliMC
       }
 	
       downscaleCounter++;
+      if (AliFilteredTreeFlatWriter *writer=fFlatWriter[kFlatdEdx]){
+        // flat columns, friend track is not supported
+        writer->SetValue("gid",gid);
+        writer->SetValue("runNumber",runNumber);
+        writer->SetValue("evtTimeStamp",evtTimeStamp);
+        writer->SetValue("timeStamp",timeStamp);
+        writer->SetValue("evtNumberInFile",evtNumberInFile);
+        writer->SetValue("Bz",bz);
+        writer->SetObject("vtxESD",vtxESD,AliESDVertex::Class());
+        writer->SetValue("mult",mult);
+        writer->SetObject("esdTrack",track,AliESDtrack::Class());
+        writer->SetArray("tofNsigma",tofNsigma.GetMatrixArray(),tofNsigma.GetNrows());
+        writer->SetArray("tpcNsigma",tpcNsigma.GetMatrixArray(),tpcNsigma.GetNrows());
+        writer->Fill();
+        continue;
+      }
       (*fTreeSRedirector)<<"dEdx"<<           // high dEdx tree
         "gid="<<gid<<                         // global id
         "fileName.="<<&fCurrentFileName<<     // file name
@@ -2782,10 +2997,51 @@ void AliAnalysisTaskFilteredTree::FinishTaskOutput()
         AliAnalysisManager::kProofAnalysis)
       deleteTrees=kFALSE;
   }
+  for (Int_t i=0; i<kNFlatStreams; i++) {
+    if (!fFlatWriter[i]) continue;
+    // write the flat trees as the redirector does for its trees, the sizes
+    // of the report only include the baskets already written
+    if (TTree *tree=fFlatWriter[i]->GetTree()) {
+      if (deleteTrees) tree->Write(0,TObject::kOverwrite);
+      else tree->FlushBaskets();
+    }
+    fFlatWriter[i]->PrintSizeReport();
+    delete fFlatWriter[i];
+    fFlatWriter[i]=NULL;
+  }
   if (deleteTrees) delete fTreeSRedirector;
   fTreeSRedirector=NULL;
 }
 
+//_____________________________________________________________________________
+Int_t AliAnalysisTaskFilteredTree::GetFlatStreamIndex(const char *stream)
+{
+  //
+  // index of the output stream (EFlatStream), -1 if not known
+  //
+  for (Int_t i=0; i<kNFlatStreams; i++) if (TString(stream)==kFlatStreamNames[i]) return i;
+  return -1;
+}
+
+//_____________________________________________________________________________
+void AliAnalysisTaskFilteredTree::SetFlatOutputSchema(const char *stream, const char *schema)
+{
+  //
+  // Write stream as flat tree containing only the columns of the schema (see AliFilteredTreeFlatWriter)
+  // Columns available per stream are the variables and objects of the corresponding TTreeSRedirector stream
+  // with their members, e.g.:
+  //   task->SetFlatOutputSchema("highPt","gid;runNumber;Bz;centralityF;esdTrack.fP;esdTrack.fAlpha;esdTrack.fTPCsignal:505;tpcNsigma");
+  //   task->SetFlatOutputSchema("V0s","gid;type;v0.fPos;v0.fNmom;v0.fPmom;track0.fTPCsignal;track1.fTPCsignal");
+  // Empty schema restores the full object streaming
+  //
+  Int_t index=GetFlatStreamIndex(stream);
+  if (index<0) {
+    AliError(Form("Unknown stream %s",stream));
+    return;
+  }
+  fFlatSchema[index]=schema;
+}
+
 //_____________________________________________________________________________
 void AliAnalysisTaskFilteredTree::Terminate(Option_t *) 
 {
@@ -45,6 +45,7 @@ class TTreeSRedirector;
 class TParticle;
 class TH3D;
 class AliESDtools;
+class AliFilteredTreeFlatWriter;
 #include <string>
 
 #include "AliTriggerAnalysis.h"
@@ -57,6 +58,8 @@ class AliAnalysisTaskFilteredTree : public AliAnalysisTaskSE {
   enum EAnalysisMode { kInvalidAnalysisMode=-1,
                       kTPCITSAnalysisMode=0,
                       kTPCAnalysisMode=1 };
+  /// output streams which can be written by the schema driven flat writer (order of the output slots)
+  enum EFlatStream { kFlatV0s=0, kFlatHighPt=1, kFlatdEdx=2, kFlatLaser=3, kFlatMCEff=4, kFlatCosmicPairs=5, kNFlatStreams=6 };
 
   AliAnalysisTaskFilteredTree(const char *name = "AliAnalysisTaskFilteredTree");
   virtual ~AliAnalysisTaskFilteredTree();
@@ -118,6 +121,10 @@ class AliAnalysisTaskFilteredTree : public AliAnalysisTaskSE {
   void SetLowPtTrackDownscaligF(Double_t fact) { fLowPtTrackDownscaligF = fact; }
   void SetLowPtV0DownscaligF(Double_t fact)    { fLowPtV0DownscaligF = fact; }
   void SetFriendDownscaling(Double_t fact)    { fFriendDownscaling = fact; }
+  /// flat output: write only the columns of the schema instead of the full objects (see AliFilteredTreeFlatWriter)
+  void SetFlatOutputSchema(const char *stream, const char *schema);
+  const TString &GetFlatOutputSchema(Int_t stream) const { return fFlatSchema[stream]; }
+  static Int_t GetFlatStreamIndex(const char *stream);
   
   void   SetProcessCosmics(Bool_t flag) { fProcessCosmics = flag; }
   Bool_t GetProcessCosmics() { return fProcessCosmics; }
@@ -165,6 +172,8 @@ class AliAnalysisTaskFilteredTree : public AliAnalysisTaskSE {
   EAnalysisMode fAnalysisMode;   // analysis mode TPC only, TPC + ITS
 
   TTreeSRedirector* fTreeSRedirector;      //! temp tree to dump output
+  TString fFlatSchema[kNFlatStreams];      // flat output schema per stream - empty: full object streaming
+  AliFilteredTreeFlatWriter* fFlatWriter[kNFlatStreams]; //! flat writers per stream
 
   TString fCentralityEstimator;     // use centrality can be "VOM" (default), "FMD", "TRK", "TKL", "CL0", "CL1", "V0MvsFMD", "TKLvsV0M", "ZEMvsZDC"
 
@@ -205,7 +214,7 @@ class AliAnalysisTaskFilteredTree : public AliAnalysisTaskSE {
 
   AliAnalysisTaskFilteredTree(const AliAnalysisTaskFilteredTree&); // not implemented
   AliAnalysisTaskFilteredTree& operator=(const AliAnalysisTaskFilteredTree&); // not implemented
-  ClassDef(AliAnalysisTaskFilteredTree, 1); // example of analysis
+  ClassDef(AliAnalysisTaskFilteredTree, 2); // example of analysis
 };
 
 #endif
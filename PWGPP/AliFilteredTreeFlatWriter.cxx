@@ -0,0 +1,320 @@
+/**************************************************************************
+ * Copyright(c) 1998-1999, ALICE Experiment at CERN, All rights reserved. *
+ *                                                                        *
+ * Author: The ALICE Off-line Project.                                    *
+ * Contributors are mentioned in the code where appropriate.              *
+ *                                                                        *
+ * Permission to use, copy, modify and distribute this software and its   *
+ * documentation strictly for non-commercial purposes is hereby granted   *
+ * without fee, provided that the above copyright notice appears in all   *
+ * copies and that both the copyright notice and this permission notice   *
+ * appear in the supporting documentation. The authors make no claims     *
+ * about the suitability of this software for any purpose. It is          *
+ * provided "as is" without express or implied warranty.                  *
+ **************************************************************************/
+///////////////////////////////////////////////////////////////////////////
+/// \file AliFilteredTreeFlatWriter.cxx
+/// \class AliFilteredTreeFlatWriter
+/// \brief Schema driven writer of flat, column typed trees
+///
+/// Example usage (see AliAnalysisTaskFilteredTree::SetFlatOutputSchema):
+/*
+  AliFilteredTreeFlatWriter writer("highPt","gid;runNumber;Bz;esdTrack.fP:505;esdTrack.fAlpha;esdTrack.fTPCsignal;tpcNsigma");
+  // per entry
+  writer.SetValue("gid",gid);
+  writer.SetValue("runNumber",runNumber);
+  writer.SetValue("Bz",bz);
+  writer.SetObject("esdTrack",track,AliESDtrack::Class());
+  writer.SetArray("tpcNsigma",tpcNsigma.GetMatrixArray(),tpcNsigma.GetNrows());
+  writer.Fill();
+  // at the end
+  writer.PrintSizeReport();
+*/
+/// Columns are resolved at the first Fill():
+///   * members of object sources are located with TClass::GetRealData (base classes and embedded objects included),
+///     only basic types and fixed size arrays of them can be written, pointers are rejected
+///   * the length of an array source is fixed by its first binding, shorter arrays are padded with 0
+/// Sources not known at the first Fill() are reported and their columns dropped.
+
+#include "TMath.h"
+#include "TTree.h"
+#include "TBranch.h"
+#include "TClass.h"
+#include "TRealData.h"
+#include "TDataMember.h"
+#include "TObjArray.h"
+#include "TObjString.h"
+#include "AliLog.h"
+#include "AliFilteredTreeFlatWriter.h"
+#include <cstring>
+
+ClassImp(AliFilteredTreeFlatWriter)
+
+//_____________________________________________________________________________
+AliFilteredTreeFlatWriter::AliFilteredTreeFlatWriter():
+  TNamed(),
+  fSchema(),
+  fTree(NULL),
+  fIsBuilt(kFALSE),
+  fSources(),
+  fColumns(),
+  fRow()
+{
+  /// Default constructor (I/O)
+}
+
+//_____________________________________________________________________________
+AliFilteredTreeFlatWriter::AliFilteredTreeFlatWriter(const char *name, const char *schema):
+  TNamed(name,name),
+  fSchema(schema),
+  fTree(NULL),
+  fIsBuilt(kFALSE),
+  fSources(),
+  fColumns(),
+  fRow()
+{
+  /// Constructor - the tree is created in the current directory, branches are created at the first Fill()
+  fTree = new TTree(name,name);
+}
+
+//_____________________________________________________________________________
+AliFilteredTreeFlatWriter::~AliFilteredTreeFlatWriter()
+{
+  /// Destructor - the tree is owned by its directory/output container
+}
+
+//_____________________________________________________________________________
+Int_t AliFilteredTreeFlatWriter::GetTypeSize(EDataType type)
+{
+  /// size in memory of the basic type (0 if not supported)
+  switch (type) {
+    case kChar_t: case kUChar_t: case kBool_t: return 1;
+    case kShort_t: case kUShort_t: return 2;
+    case kInt_t: case kUInt_t: case kFloat_t: case kFloat16_t: return 4;
+    case kDouble_t: case kDouble32_t: case kLong64_t: case kULong64_t: return 8;
+    case kLong_t: case kULong_t: return sizeof(Long_t);
+    default: return 0;
+  }
+}
+
+//_____________________________________________________________________________
+Char_t AliFilteredTreeFlatWriter::GetLeafType(EDataType type)
+{
+  /// leaf list type code of the basic type (0 if not supported)
+  /// Double32_t and Float16_t are stored with their in-memory precision
+  switch (type) {
+    case kChar_t: return 'B';
+    case kUChar_t: return 'b';
+    case kBool_t: return 'O';
+    case kShort_t: return 'S';
+    case kUShort_t: return 's';
+    case kInt_t: return 'I';
+    case kUInt_t: return 'i';
+    case kFloat_t: case kFloat16_t: return 'F';
+    case kDouble_t: case kDouble32_t: return 'D';
+    case kLong64_t: return 'L';
+    case kULong64_t: return 'l';
+    case kLong_t: return (sizeof(Long_t)==8) ? 'L':'I';
+    case kULong_t: return (sizeof(Long_t)==8) ? 'l':'i';
+    default: return 0;
+  }
+}
+
+//_____________________________________________________________________________
+AliFilteredTreeFlatWriter::Source *AliFilteredTreeFlatWriter::FindSource(const char *source, Int_t kind)
+{
+  /// Find source by name, register it if not yet known
+  /// Sources can only be registered before the columns are built
+  for (size_t i=0; i<fSources.size(); i++) {
+    if (fSources[i].fName==source) return (fSources[i].fKind==kind) ? &fSources[i] : NULL;
+  }
+  if (fIsBuilt) return NULL;
+  Source src;
+  src.fName = source;
+  src.fKind = kind;
+  src.fClass = NULL;
+  src.fObject = NULL;
+  src.fType = kNoType_t;
+  src.fValue = 0;
+  src.fNArray = 0;
+  fSources.push_back(src);
+  return &fSources.back();
+}
+
+//_____________________________________________________________________________
+void AliFilteredTreeFlatWriter::SetObject(const char *source, const void *object, TClass *cl)
+{
+  /// Bind object for the current entry, object can be NULL (columns filled with 0)
+  Source *src = FindSource(source, kObject);
+  if (!src) return;
+  if (!src->fClass) src->fClass = cl;
+  src->fObject = (cl==src->fClass) ? object : NULL;
+}
+
+//_____________________________________________________________________________
+void AliFilteredTreeFlatWriter::SetValue(const char *source, const void *value, EDataType type)
+{
+  /// Bind scalar value for the current entry
+  Source *src = FindSource(source, kValue);
+  if (!src) return;
+  if (src->fType==kNoType_t) src->fType = type;
+  if (src->fType!=type) {
+    AliErrorF("Source %s: type changed (%d -> %d)", source, src->fType, type);
+    return;
+  }
+  memcpy(&src->fValue, value, GetTypeSize(type));
+}
+
+//_____________________________________________________________________________
+void AliFilteredTreeFlatWriter::SetArray(const char *source, const Double_t *values, Int_t n)
+{
+  /// Bind array for the current entry - array length fixed by the first call
+  Source *src = FindSource(source, kArray);
+  if (!src) return;
+  if (src->fType==kNoType_t) {
+    src->fType = kDouble_t;
+    src->fArray.resize(n);
+  }
+  src->fNArray = TMath::Min(n, (Int_t)src->fArray.size());
+  for (Int_t i=0; i<src->fNArray; i++) src->fArray[i] = values[i];
+}
+
+//_____________________________________________________________________________
+void AliFilteredTreeFlatWriter::SetArray(const char *source, const Float_t *values, Int_t n)
+{
+  /// Bind array for the current entry - array length fixed by the first call
+  Source *src = FindSource(source, kArray);
+  if (!src) return;
+  if (src->fType==kNoType_t) {
+    src->fType = kFloat_t;
+    src->fArray.resize(n);
+  }
+  src->fNArray = TMath::Min(n, (Int_t)src->fArray.size());
+  for (Int_t i=0; i<src->fNArray; i++) src->fArray[i] = values[i];
+}
+
+//_____________________________________________________________________________
+Bool_t AliFilteredTreeFlatWriter::BuildColumns()
+{
+  /// Resolve the schema against the sources bound so far, allocate the row buffer and create the branches
+  fIsBuilt = kTRUE;
+  TObjArray *tokens = fSchema.Tokenize("; \n\t");
+  Int_t rowSize = 0;
+  for (Int_t itoken=0; itoken<tokens->GetEntriesFast(); itoken++) {
+    TString token = ((TObjString*)tokens->At(itoken))->String();
+    Column col;
+    col.fCompression = -1;
+    Int_t index = token.Index(":");
+    if (index>=0) {
+      col.fCompression = TString(token(index+1, token.Length())).Atoi();
+      token.Remove(index);
+    }
+    col.fName = token;
+    index = token.Index(".");
+    TString sourceName = (index>=0) ? TString(token(0,index)) : token;
+    TString memberName = (index>=0) ? TString(token(index+1, token.Length())) : TString("");
+    col.fSource = -1;
+    for (size_t i=0; i<fSources.size(); i++) if (fSources[i].fName==sourceName) col.fSource = i;
+    if (col.fSource<0) {
+      AliErrorF("%s: source %s of column %s not bound - column skipped", GetName(), sourceName.Data(), token.Data());
+      continue;
+    }
+    const Source &src = fSources[col.fSource];
+    col.fOffset = 0;
+    if (src.fKind==kObject) {
+      TRealData *rd = (src.fClass && !memberName.IsNull()) ? src.fClass->GetRealData(memberName) : NULL;
+      TDataMember *dm = rd ? rd->GetDataMember() : NULL;
+      if (!dm || dm->IsaPointer() || !(dm->IsBasic() || dm->IsEnum())) {
+        AliErrorF("%s: column %s is not a basic data member - column skipped", GetName(), token.Data());
+        continue;
+      }
+      col.fOffset = rd->GetThisOffset();
+      col.fType = (dm->IsEnum() || !dm->GetDataType()) ? kInt_t : (EDataType)dm->GetDataType()->GetType();
+      col.fLength = 1;
+      for (Int_t idim=0; idim<dm->GetArrayDim(); idim++) col.fLength *= dm->GetMaxIndex(idim);
+    } else {
+      if (!memberName.IsNull()) {
+        AliErrorF("%s: source %s has no members - column %s skipped", GetName(), sourceName.Data(), token.Data());
+        continue;
+      }
+      col.fType = src.fType;
+      col.fLength = (src.fKind==kArray) ? src.fArray.size() : 1;
+    }
+    Int_t size = GetTypeSize(col.fType);
+    if (size==0 || col.fLength<1) {
+      AliErrorF("%s: unsupported type of column %s - column skipped", GetName(), token.Data());
+      continue;
+    }
+    col.fRowOffset = rowSize;
+    rowSize += ((size*col.fLength+7)/8)*8;  // 8 byte alignment of the columns
+    col.fBranch = NULL;
+    fColumns.push_back(col);
+  }
+  delete tokens;
+  //
+  fRow.assign(rowSize, 0);
+  for (size_t icol=0; icol<fColumns.size(); icol++) {
+    Column &col = fColumns[icol];
+    TString leaf = col.fName;
+    if (col.fLength>1) leaf += TString::Format("[%d]", col.fLength);
+    leaf += TString::Format("/%c", GetLeafType(col.fType));
+    col.fBranch = fTree->Branch(col.fName, &fRow[col.fRowOffset], leaf);
+    if (col.fBranch && col.fCompression>=0) col.fBranch->SetCompressionSettings(col.fCompression);
+  }
+  return fColumns.size()>0;
+}
+
+//_____________________________________________________________________________
+Int_t AliFilteredTreeFlatWriter::Fill()
+{
+  /// Copy the bound sources to the row buffer and fill the tree
+  /// All sources are reset afterwards
+  if (!fTree) return 0;
+  if (!fIsBuilt) BuildColumns();
+  for (size_t icol=0; icol<fColumns.size(); icol++) {
+    const Column &col = fColumns[icol];
+    const Source &src = fSources[col.fSource];
+    Char_t *dest = &fRow[col.fRowOffset];
+    const Int_t size = GetTypeSize(col.fType);
+    switch (src.fKind) {
+      case kObject:
+        if (src.fObject) memcpy(dest, (const Char_t*)src.fObject+col.fOffset, size*col.fLength);
+        else memset(dest, 0, size*col.fLength);
+        break;
+      case kValue:
+        memcpy(dest, &src.fValue, size);
+        break;
+      case kArray:
+        for (Int_t i=0; i<col.fLength; i++) {
+          Double_t value = (i<src.fNArray) ? src.fArray[i] : 0;
+          if (col.fType==kFloat_t) ((Float_t*)dest)[i] = value;
+          else ((Double_t*)dest)[i] = value;
+        }
+        break;
+    }
+  }
+  Int_t nbytes = fTree->Fill();
+  for (size_t i=0; i<fSources.size(); i++) {
+    fSources[i].fObject = NULL;
+    fSources[i].fValue = 0;
+    fSources[i].fNArray = 0;
+  }
+  return nbytes;
+}
+
+//_____________________________________________________________________________
+void AliFilteredTreeFlatWriter::PrintSizeReport(Option_t *) const
+{
+  /// Print size per column: uncompressed and compressed bytes, compression factor and fraction of the tree size
+  if (!fTree) return;
+  Double_t zipAll = fTree->GetZipBytes();
+  printf("AliFilteredTreeFlatWriter::PrintSizeReport: %s - %lld entries, %d columns, %.0f bytes (zip)\n", GetName(), fTree->GetEntries(), (Int_t)fColumns.size(), zipAll);
+  printf("%-40s%8s%14s%14s%8s%8s\n", "column", "length", "totBytes", "zipBytes", "factor", "frac");
+  for (size_t icol=0; icol<fColumns.size(); icol++) {
+    const Column &col = fColumns[icol];
+    if (!col.fBranch) continue;
+    Double_t tot = col.fBranch->GetTotBytes();
+    Double_t zip = col.fBranch->GetZipBytes();
+    printf("%-40s%8d%14.0f%14.0f%8.2f%8.4f\n", col.fName.Data(), col.fLength, tot, zip, (zip>0) ? tot/zip:0., (zipAll>0) ? zip/zipAll:0.);
+  }
+}
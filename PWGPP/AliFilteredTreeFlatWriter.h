@@ -0,0 +1,87 @@
+#ifndef ALIFILTEREDTREEFLATWRITER_H
+#define ALIFILTEREDTREEFLATWRITER_H
+
+/// \class AliFilteredTreeFlatWriter
+/// \brief Schema driven writer of flat, column typed trees (alternative to the TTreeSRedirector object streaming)
+///
+/// The schema is a list of columns "source.member[:compression]" or "source[:compression]" separated by ';'
+///   * source.member - data member (scalar or fixed size array of basic type) of an object source, e.g. esdTrack.fP
+///   * source        - scalar value or array source
+///   * compression   - ROOT compression settings of the column branch (e.g. 505), default of the file if not set
+/// Each column is written into its own branch from a preallocated row buffer. Sources are bound per entry
+/// by the producer with SetObject/SetValue/SetArray; after Fill() all sources are reset, unset sources give zeros.
+
+class TTree;
+class TBranch;
+class TClass;
+#include "TNamed.h"
+#include "TDataType.h"
+#include <vector>
+
+class AliFilteredTreeFlatWriter : public TNamed {
+public:
+  AliFilteredTreeFlatWriter();
+  AliFilteredTreeFlatWriter(const char *name, const char *schema);
+  virtual ~AliFilteredTreeFlatWriter();
+  //
+  TTree *GetTree() const { return fTree; }
+  const TString &GetSchema() const { return fSchema; }
+  Int_t  GetNColumns() const { return fColumns.size(); }
+  /// source binding - to be called for each entry before Fill()
+  void SetObject(const char *source, const void *object, TClass *cl);
+  void SetArray(const char *source, const Double_t *values, Int_t n);
+  void SetArray(const char *source, const Float_t *values, Int_t n);
+  void SetValue(const char *source, Double_t value)  { SetValue(source, &value, kDouble_t); }
+  void SetValue(const char *source, Float_t value)   { SetValue(source, &value, kFloat_t); }
+  void SetValue(const char *source, Int_t value)     { SetValue(source, &value, kInt_t); }
+  void SetValue(const char *source, UInt_t value)    { SetValue(source, &value, kUInt_t); }
+  void SetValue(const char *source, Long64_t value)  { SetValue(source, &value, kLong64_t); }
+  void SetValue(const char *source, ULong64_t value) { SetValue(source, &value, kULong64_t); }
+  void SetValue(const char *source, Short_t value)   { SetValue(source, &value, kShort_t); }
+  void SetValue(const char *source, UShort_t value)  { SetValue(source, &value, kUShort_t); }
+  void SetValue(const char *source, Char_t value)    { SetValue(source, &value, kChar_t); }
+  void SetValue(const char *source, UChar_t value)   { SetValue(source, &value, kUChar_t); }
+  void SetValue(const char *source, Bool_t value)    { SetValue(source, &value, kBool_t); }
+  Int_t Fill();
+  void  PrintSizeReport(Option_t *option="") const;
+  static Int_t GetTypeSize(EDataType type);
+  static Char_t GetLeafType(EDataType type);
+
+private:
+  AliFilteredTreeFlatWriter(const AliFilteredTreeFlatWriter&);            // not implemented
+  AliFilteredTreeFlatWriter& operator=(const AliFilteredTreeFlatWriter&); // not implemented
+  enum ESourceKind { kObject=0, kValue=1, kArray=2 };
+  struct Source {
+    TString     fName;      // name used in the schema
+    Int_t       fKind;      // ESourceKind
+    TClass     *fClass;     // class of the object source
+    const void *fObject;    // object bound for the current entry
+    EDataType   fType;      // type of the value/array source
+    Long64_t    fValue;     // storage of the value source (any basic type)
+    std::vector<Double_t> fArray; // storage of the array source
+    Int_t       fNArray;    // filled elements of the array source for the current entry
+  };
+  struct Column {
+    TString   fName;        // column (branch) name
+    Int_t     fSource;      // index of the source
+    Long_t    fOffset;      // offset of the member in the object source
+    EDataType fType;        // storage type
+    Int_t     fLength;      // number of elements
+    Int_t     fRowOffset;   // offset in the row buffer
+    Int_t     fCompression; // compression settings (-1: default)
+    TBranch  *fBranch;      // output branch
+  };
+  Source *FindSource(const char *source, Int_t kind);
+  void    SetValue(const char *source, const void *value, EDataType type);
+  Bool_t  BuildColumns();
+  //
+  TString fSchema;                  // column schema
+  TTree  *fTree;                    //! output tree - not owner (posted to the output)
+  Bool_t  fIsBuilt;                 //! columns resolved and branches created
+  std::vector<Source> fSources;     //! sources bound by the producer
+  std::vector<Column> fColumns;     //! resolved columns
+  std::vector<Char_t> fRow;         //! preallocated row buffer
+  ClassDef(AliFilteredTreeFlatWriter, 1);
+};
+
+#endif
@@ -21,6 +21,11 @@
 /// #### Example 3: Draw Expected dEdx
 /// AliPIDtools::SetFilteredTreeV0(treeV0)
 /// treeV0->Draw("log(track0.fTPCsignal/(AliPIDtools::GetExpectedTPCSignalV0(pidHash,0,0x1,0)))","type==1&&abs(log(track1.fTPCsignal/(AliPIDtools::GetExpectedTPCSignalV0(pidHash,0,0x1,1))))<0.1","colz",20000)
+/// #### Example 4: Compiled evaluation (RDataFrame, batch evaluation, βγ tables) - see AliPIDtoolsFunctor
+/// \code
+/// AliPIDtoolsFunctor tpcExpected(hash,AliPIDtoolsFunctor::kTPCExpectedSignal);
+/// tpcExpected.Eval(n, p, particle, dEdxExpected);
+/// \endcode
 
 #include "map"
 #include  "AliESDtrack.h"
@@ -0,0 +1,238 @@
+/// \class AliPIDtoolsFunctor
+/// Compiled functor for the expected PID signals - see header for the description and examples
+
+#include "TMath.h"
+#include "TRandom.h"
+#include "AliPID.h"
+#include "AliESDtrack.h"
+#include "AliITSPIDResponse.h"
+#include "AliTPCPIDResponse.h"
+#include "AliTOFPIDResponse.h"
+#include "AliPIDResponse.h"
+#include "AliPIDtools.h"
+#include "AliPIDtoolsFunctor.h"
+
+AliPIDtoolsFunctor::AliPIDtoolsFunctor():
+  fHash(0),
+  fFunction(kTPCExpectedSignal),
+  fPID(NULL),
+  fNTablePoints(0),
+  fTableLogBGMin(0),
+  fTableLogBGMax(0),
+  fTableInvStep(0),
+  fTable()
+{
+  for (Int_t i=0; i<AliPID::kSPECIESC; i++) fMass[i]=AliPID::ParticleMass(i);
+}
+
+/// Bind PID response registered in AliPIDtools
+/// \param hash       - PID hash as returned by AliPIDtools::LoadPID
+/// \param function   - EFunction
+AliPIDtoolsFunctor::AliPIDtoolsFunctor(Int_t hash, Int_t function):
+  fHash(hash),
+  fFunction(function),
+  fPID(NULL),
+  fNTablePoints(0),
+  fTableLogBGMin(0),
+  fTableLogBGMax(0),
+  fTableInvStep(0),
+  fTable()
+{
+  for (Int_t i=0; i<AliPID::kSPECIESC; i++) fMass[i]=AliPID::ParticleMass(i);
+  if (function<0 || function>=kNFunctions){
+    ::Error("AliPIDtoolsFunctor::AliPIDtoolsFunctor","Invalid function %d",function);
+    return;
+  }
+  std::map<Int_t, AliPIDResponse *>::const_iterator it=AliPIDtools::pidAll.find(hash);
+  if (it==AliPIDtools::pidAll.end() || it->second==NULL){
+    ::Error("AliPIDtoolsFunctor::AliPIDtoolsFunctor","PID hash %d not registered - use AliPIDtools::LoadPID",hash);
+    return;
+  }
+  fPID=it->second;
+}
+
+/// Direct evaluation of the function
+/// \param p          - momentum
+/// \param particle   - particle type (AliPID::EParticleType)
+/// \return           - function value, 0 if not valid
+Double_t AliPIDtoolsFunctor::EvalDirect(Double_t p, Int_t particle) const {
+  if (fPID==NULL || particle<0 || particle>=AliPID::kSPECIESC) return 0;
+  switch (fFunction){
+    case kTPCExpectedSignal: {
+      // dummy track as in AliPIDtools::GetExpectedTPCSignal - one per thread to keep the functor reentrant
+      static thread_local AliESDtrack dummyTrack;
+      Double_t xyz[3] = {0., 0., 0.};
+      Double_t pxyz[3] = {p, 0., 0.};
+      Double_t cv[21] = {0.};
+      dummyTrack.Set(xyz, pxyz, cv, 1);
+      return fPID->GetTPCResponse().GetExpectedSignal(&dummyTrack, (AliPID::EParticleType)particle, AliTPCPIDResponse::kdEdxDefault, kFALSE, kTRUE);
+    }
+    case kITSExpectedSignal:
+      return fPID->GetITSResponse().Bethe(p, (AliPID::EParticleType)particle);
+    case kTOFExpectedSigma: {
+      Double_t dummyTime=0;
+      return fPID->GetTOFResponse().GetExpectedSigma(p, dummyTime, (AliPID::EParticleType)particle);
+    }
+    case kTPCBetheBloch:
+      return fPID->GetTPCResponse().Bethe(Float_t(p/fMass[particle]));
+    case kITSBetheBloch:
+      return fPID->GetITSResponse().Bethe(p, fMass[particle]);
+  }
+  return 0;
+}
+
+/// Linear interpolation in the βγ table
+Double_t AliPIDtoolsFunctor::EvalTable(Double_t logBG, Int_t row) const {
+  Double_t x = (logBG-fTableLogBGMin)*fTableInvStep;
+  Int_t    bin = TMath::Min(Int_t(x), fNTablePoints-2);
+  Double_t dx = x-bin;
+  const Double_t *value = &fTable[row*fNTablePoints+bin];
+  return value[0]+(value[1]-value[0])*dx;
+}
+
+/// Evaluate function
+/// \param p          - momentum
+/// \param particle   - particle type (AliPID::EParticleType)
+/// \return           - function value (table interpolation if available)
+Double_t AliPIDtoolsFunctor::Eval(Double_t p, Int_t particle) const {
+  if (fNTablePoints>0 && particle>=0 && particle<AliPID::kSPECIESC && p>0) {
+    Double_t logBG=TMath::Log(p/fMass[particle]);
+    if (logBG>=fTableLogBGMin && logBG<=fTableLogBGMax) return EvalTable(logBG, GetTableRow(particle));
+  }
+  return EvalDirect(p, particle);
+}
+
+/// Evaluate Bethe-Bloch parametrisation as function of βγ
+/// \param bg         - βγ
+/// \param particle   - particle type - relevant only for the mass dependent kITSBetheBloch
+/// \return           - function value, 0 for not Bethe-Bloch functions
+Double_t AliPIDtoolsFunctor::EvalBetaGamma(Double_t bg, Int_t particle) const {
+  if (!IsBetheBloch() || particle<0 || particle>=AliPID::kSPECIESC) return 0;
+  return Eval(bg*fMass[particle], particle);
+}
+
+/// Batch evaluation
+/// \param n          - number of entries
+/// \param p          - momenta
+/// \param particle   - particle types
+/// \param result     - output array of size n
+void AliPIDtoolsFunctor::Eval(Int_t n, const Double_t *p, const Int_t *particle, Double_t *result) const {
+  if (fNTablePoints==0){
+    for (Int_t i=0; i<n; i++) result[i]=EvalDirect(p[i], particle[i]);
+    return;
+  }
+  for (Int_t i=0; i<n; i++) result[i]=Eval(p[i], particle[i]);
+}
+
+/// Batch evaluation for one particle type
+/// \param n          - number of entries
+/// \param p          - momenta
+/// \param particle   - particle type
+/// \param result     - output array of size n
+void AliPIDtoolsFunctor::Eval(Int_t n, const Double_t *p, Int_t particle, Double_t *result) const {
+  if (fNTablePoints==0 || particle<0 || particle>=AliPID::kSPECIESC){
+    for (Int_t i=0; i<n; i++) result[i]=EvalDirect(p[i], particle);
+    return;
+  }
+  // table lookup - log(βγ) computed in a separate loop to keep the interpolation loop simple
+  const Double_t invMass=1./fMass[particle];
+  const Int_t row=GetTableRow(particle);
+  for (Int_t i=0; i<n; i++) result[i]=(p[i]>0) ? TMath::Log(p[i]*invMass):fTableLogBGMin-1;
+  for (Int_t i=0; i<n; i++) {
+    if (result[i]>=fTableLogBGMin && result[i]<=fTableLogBGMax) result[i]=EvalTable(result[i], row);
+    else result[i]=EvalDirect(p[i], particle);
+  }
+}
+
+/// Batch evaluation - std::vector interface
+void AliPIDtoolsFunctor::Eval(const std::vector<Double_t> &p, const std::vector<Int_t> &particle, std::vector<Double_t> &result) const {
+  const Int_t n=TMath::Min(p.size(), particle.size());
+  result.resize(n);
+  if (n>0) Eval(n, &p[0], &particle[0], &result[0]);
+}
+
+/// Precompute table of the Bethe-Bloch parametrisation in log(βγ)
+/// \param nPoints    - number of points (equidistant in log(βγ))
+/// \param bgMin      - minimal βγ
+/// \param bgMax      - maximal βγ
+/// \return           - kFALSE for invalid functor, not Bethe-Bloch function or invalid range
+Bool_t AliPIDtoolsFunctor::MakeBetaGammaTable(Int_t nPoints, Double_t bgMin, Double_t bgMax){
+  ClearBetaGammaTable();
+  if (fPID==NULL) return kFALSE;
+  if (!IsBetheBloch()){
+    ::Error("AliPIDtoolsFunctor::MakeBetaGammaTable","Table supported only for the Bethe-Bloch parametrisations");
+    return kFALSE;
+  }
+  if (nPoints<2 || bgMin<=0 || bgMax<=bgMin){
+    ::Error("AliPIDtoolsFunctor::MakeBetaGammaTable","Invalid table definition %d (%f,%f)",nPoints,bgMin,bgMax);
+    return kFALSE;
+  }
+  const Int_t nRows=(fFunction==kITSBetheBloch) ? AliPID::kSPECIESC:1;
+  fTableLogBGMin=TMath::Log(bgMin);
+  fTableLogBGMax=TMath::Log(bgMax);
+  const Double_t step=(fTableLogBGMax-fTableLogBGMin)/(nPoints-1);
+  fTableInvStep=1./step;
+  fTable.resize(nRows*nPoints);
+  for (Int_t iRow=0; iRow<nRows; iRow++){
+    const Int_t particle=(nRows==1) ? AliPID::kPion:iRow;
+    for (Int_t i=0; i<nPoints; i++){
+      fTable[iRow*nPoints+i]=EvalDirect(TMath::Exp(fTableLogBGMin+i*step)*fMass[particle], particle);
+    }
+  }
+  fNTablePoints=nPoints;
+  return kTRUE;
+}
+
+/// Maximal relative deviation of the table interpolation from the direct evaluation
+/// \param nTest      - number of random test points in the table range
+/// \return           - maximal relative deviation, -1 if no table
+Double_t AliPIDtoolsFunctor::GetBetaGammaTableMaxDeviation(Int_t nTest) const {
+  if (fNTablePoints==0) return -1;
+  Double_t maxDeviation=0;
+  for (Int_t i=0; i<nTest; i++){
+    const Int_t particle=(fFunction==kITSBetheBloch) ? i%AliPID::kSPECIESC:AliPID::kPion;
+    const Double_t p=TMath::Exp(gRandom->Uniform(fTableLogBGMin, fTableLogBGMax))*fMass[particle];
+    const Double_t direct=EvalDirect(p, particle);
+    if (direct==0) continue;
+    maxDeviation=TMath::Max(maxDeviation, TMath::Abs(Eval(p, particle)/direct-1.));
+  }
+  return maxDeviation;
+}
+
+/// Consistency of the functors with the AliPIDtools interpreter interface
+/// \param hash       - PID hash as returned by AliPIDtools::LoadPID
+/// \return           - status
+Bool_t AliPIDtoolsFunctor::UnitTest(Int_t hash){
+  const Float_t kEpsilon=0.00001;
+  const Float_t kEpsilonTable=0.001;
+  const Int_t   kNTest=1000;
+  Bool_t status=kTRUE;
+  for (Int_t iFunction=0; iFunction<kNFunctions; iFunction++){
+    AliPIDtoolsFunctor functor(hash, iFunction);
+    if (!functor.IsValid()) return kFALSE;
+    Double_t maxDelta=0;
+    for (Int_t i=0; i<kNTest; i++){
+      const Int_t particle=i%AliPID::kSPECIESC;
+      const Double_t p=0.1+gRandom->Rndm()*10.;
+      Double_t value=0;
+      switch (iFunction){
+        case kTPCExpectedSignal: value=AliPIDtools::GetExpectedTPCSignal(hash, p, particle); break;
+        case kITSExpectedSignal: value=AliPIDtools::GetExpectedITSSignal(hash, p, particle); break;
+        case kTOFExpectedSigma:  value=AliPIDtools::GetExpectedTOFSigma(hash, p, particle); break;
+        case kTPCBetheBloch:     value=AliPIDtools::BetheBlochAleph(hash, p, particle); break;
+        case kITSBetheBloch:     value=AliPIDtools::BetheBlochITS(hash, p, AliPID::ParticleMass(particle)); break;
+      }
+      if (value!=0) maxDelta=TMath::Max(maxDelta, TMath::Abs(functor(p, particle)/value-1.));
+    }
+    Bool_t statusF=maxDelta<kEpsilon;
+    ::Info("AliPIDtoolsFunctor::UnitTest","Function %d: max. relative deviation to AliPIDtools=%g\tStatus=%d",iFunction,maxDelta,statusF);
+    status&=statusF;
+    if (!functor.IsBetheBloch()) continue;
+    functor.MakeBetaGammaTable(20000, 0.1, 1e5);
+    maxDelta=functor.GetBetaGammaTableMaxDeviation(kNTest);
+    statusF=maxDelta<kEpsilonTable;
+    ::Info("AliPIDtoolsFunctor::UnitTest","Function %d: max. relative deviation of the βγ table=%g\tStatus=%d",iFunction,maxDelta,statusF);
+    status&=statusF;
+  }
+  return status;
+}
@@ -0,0 +1,86 @@
+#ifndef ALIPIDTOOLSFUNCTOR_H
+#define ALIPIDTOOLSFUNCTOR_H
+
+/// \ingroup PWGPP
+/// \class AliPIDtoolsFunctor
+/// \brief Compiled functor for the expected PID signals of AliPIDtools
+///
+/// The PID response registered with AliPIDtools::LoadPID is bound once at construction, evaluation does not go
+/// through the interpreter nor the hash map lookup. The functor can be used as a column in RDataFrame, for batch
+/// evaluation over arrays of (p, particle) and in TF1. Evaluation is reentrant - one functor can be shared by threads.
+///
+/// Functions (EFunction) - same meaning as in AliPIDtools:
+///   * kTPCExpectedSignal - AliPIDtools::GetExpectedTPCSignal(hash,p,particle)
+///   * kITSExpectedSignal - AliPIDtools::GetExpectedITSSignal(hash,p,particle)
+///   * kTOFExpectedSigma  - AliPIDtools::GetExpectedTOFSigma(hash,p,particle)
+///   * kTPCBetheBloch     - AliPIDtools::BetheBlochAleph(hash,p,particle)
+///   * kITSBetheBloch     - AliPIDtools::BetheBlochITS(hash,p,mass(particle))
+/// For the Bethe-Bloch parametrisations a lookup table in log(βγ) can be precomputed (MakeBetaGammaTable),
+/// the value is then linearly interpolated. Outside of the table range the parametrisation is evaluated directly.
+///
+/// #### Example 1: RDataFrame column
+/// \code
+/// Int_t hash= AliPIDtools::LoadPID(246751,1,"pass1",0);
+/// AliPIDtoolsFunctor tpcBB(hash,AliPIDtoolsFunctor::kTPCBetheBloch);
+/// tpcBB.MakeBetaGammaTable(20000,0.1,1e5);
+/// ROOT::RDataFrame df("V0s",fileName);
+/// auto dfPID=df.Define("p0","track0.fIp.P()").Define("type0","AliPID::kPion+0").Define("bbPion0",tpcBB,{"p0","type0"});
+/// \endcode
+/// #### Example 2: Batch evaluation
+/// \code
+/// AliPIDtoolsFunctor tpc(hash);   // default kTPCExpectedSignal
+/// tpc.Eval(n, p, particle, dEdxExpected);
+/// \endcode
+/// #### Example 3: TF1
+/// \code
+/// TF1 *fbb = new TF1("fbb",[&tpcBB](Double_t *x, Double_t *){return tpcBB.EvalBetaGamma(x[0]);},1,100,0);
+/// \endcode
+
+#include "Rtypes.h"
+#include "AliPID.h"
+#include <vector>
+class AliPIDResponse;
+
+class AliPIDtoolsFunctor {
+public:
+  enum EFunction { kTPCExpectedSignal=0, kITSExpectedSignal=1, kTOFExpectedSigma=2, kTPCBetheBloch=3, kITSBetheBloch=4, kNFunctions=5 };
+  AliPIDtoolsFunctor();
+  AliPIDtoolsFunctor(Int_t hash, Int_t function=kTPCExpectedSignal);
+  ~AliPIDtoolsFunctor() {}
+  //
+  Bool_t   IsValid() const { return fPID!=NULL; }
+  Int_t    GetHash() const { return fHash; }
+  Int_t    GetFunction() const { return fFunction; }
+  Bool_t   IsBetheBloch() const { return fFunction==kTPCBetheBloch || fFunction==kITSBetheBloch; }
+  /// single value - signature usable as RDataFrame Define column
+  Double_t operator()(Double_t p, Int_t particle) const { return Eval(p, particle); }
+  Double_t Eval(Double_t p, Int_t particle) const;
+  Double_t EvalBetaGamma(Double_t bg, Int_t particle=2) const;
+  /// batch evaluation
+  void     Eval(Int_t n, const Double_t *p, const Int_t *particle, Double_t *result) const;
+  void     Eval(Int_t n, const Double_t *p, Int_t particle, Double_t *result) const;
+  void     Eval(const std::vector<Double_t> &p, const std::vector<Int_t> &particle, std::vector<Double_t> &result) const;
+  /// βγ lookup table (Bethe-Bloch parametrisations only)
+  Bool_t   MakeBetaGammaTable(Int_t nPoints=10000, Double_t bgMin=0.1, Double_t bgMax=1e5);
+  void     ClearBetaGammaTable() { fTable.clear(); fNTablePoints=0; }
+  Bool_t   HasBetaGammaTable() const { return fNTablePoints>0; }
+  Double_t GetBetaGammaTableMaxDeviation(Int_t nTest=100000) const;
+  static Bool_t UnitTest(Int_t hash);
+
+private:
+  Double_t EvalDirect(Double_t p, Int_t particle) const;
+  Double_t EvalTable(Double_t logBG, Int_t row) const;
+  Int_t    GetTableRow(Int_t particle) const { return (fFunction==kITSBetheBloch) ? particle : 0; }
+  //
+  Int_t          fHash;             ///< PID hash as registered in AliPIDtools
+  Int_t          fFunction;         ///< EFunction
+  AliPIDResponse *fPID;             ///<! bound PID response - not owner (owned by AliPIDtools)
+  Double_t       fMass[AliPID::kSPECIESC]; ///< particle masses
+  Int_t          fNTablePoints;     ///< number of points of the βγ table (0 - no table)
+  Double_t       fTableLogBGMin;    ///< log(βγ) of the first point
+  Double_t       fTableLogBGMax;    ///< log(βγ) of the last point
+  Double_t       fTableInvStep;     ///< inverse step in log(βγ)
+  std::vector<Double_t> fTable;     ///< table values, one row per particle for kITSBetheBloch (mass dependent), one row otherwise
+};
+
+#endif //ALIPIDTOOLSFUNCTOR_H
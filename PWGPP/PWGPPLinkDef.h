@@ -56,6 +56,7 @@
 #pragma link C++ class AliAnalysisNoiseTPC+;
 #pragma link C++ class AliMCTreeTools+;
 #pragma link C++ class AliPIDtools+;
+#pragma link C++ class AliPIDtoolsFunctor+;
 #pragma link C++ class std::map<int,AliTPCPIDResponse *>+;
 #pragma link C++ class std::map<int,AliPIDResponse *>+;
 #pragma link C++ class AliESDtools+;
@@ -96,6 +97,7 @@
 #pragma link C++ class AliAnalysisTaskFilteredTree+;
 #pragma link C++ class AliFilteredTreeEventCuts+;
 #pragma link C++ class AliFilteredTreeAcceptanceCuts+;
+#pragma link C++ class AliFilteredTreeFlatWriter+;
 
 #pragma link C++ class AliTaskConfigOCDB+;
 
@@ -22,13 +22,15 @@
 ClassImp(AliAnalysisTaskHistogram)
 
 AliAnalysisTaskHistogram::AliAnalysisTaskHistogram() 
-   :AliAnalysisTaskSE()
+   :AliAnalysisTaskSE(),
+    fPtHist(0)
 {
   // constructor
 }
 
 AliAnalysisTaskHistogram::AliAnalysisTaskHistogram(const char *name)
-   :AliAnalysisTaskSE(name)
+   :AliAnalysisTaskSE(name),
+    fPtHist(0)
 {
   /// constructor
 
@@ -42,7 +44,7 @@ AliAnalysisTaskHistogram::~AliAnalysisTaskHistogram()
 
 }
 
-void AliAnalysisTaskHistogram::CreateOutputObjects()
+void AliAnalysisTaskHistogram::UserCreateOutputObjects()
 {
   fPtHist = new TH1F("fPtHist", "fPtHist", 100, 0, 20);
   PostData(1, fPtHist);
@@ -3,21 +3,24 @@
 
 /// \class AliAnalysisTaskHistogram
 ///
-/// This empty task is used for the analysis train to estimate the memory and CPU consumption without any user code
+/// This empty task is used for the analysis train to estimate the memory and CPU consumption without any user code.
+/// It is re-entrant and can run in AliAnalysisThreadedEventLoop (see runThreadScaling.C)
 
 #ifndef ALIANALYSISTASKBASELINE_H
 #define ALIANALYSISTASKBASELINE_H
 
 #include "AliAnalysisTaskSE.h"
+#include "AliAnalysisReentrantTask.h"
 
-class AliAnalysisTaskHistogram : public AliAnalysisTaskSE {
+class AliAnalysisTaskHistogram : public AliAnalysisTaskSE, public AliAnalysisReentrantTask {
  public:
     AliAnalysisTaskHistogram();
     AliAnalysisTaskHistogram(const char *name);
     virtual ~AliAnalysisTaskHistogram();
-    void CreateOutputObjects();
+    virtual void     UserCreateOutputObjects();
     
     virtual void     UserExec(Option_t *option);
+    virtual void     SetThreadInput(AliVEvent *event, AliMCEvent *mcEvent) { fInputEvent = event; fMCEvent = mcEvent; }
     
     static AliAnalysisTaskHistogram* AddTask(TString suffix);
     
@@ -27,7 +30,7 @@ class AliAnalysisTaskHistogram : public AliAnalysisTaskSE {
     
     TH1F* fPtHist; //!
     
-    ClassDef(AliAnalysisTaskHistogram, 1); // empty analysis
+    ClassDef(AliAnalysisTaskHistogram, 2); // empty analysis
 };
 
 #endif